@@ -0,0 +1,535 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * samtrader_bench: stage timings for the backtest pipeline on synthetic data.
+ *
+ * Generates deterministic random-walk universes with SamRng, runs the
+ * example strategies over each one and prints a JSON document with the
+ * wall time per stage (indicators, timeline, compile, rules, backtest,
+ * metrics), ns per bar and the arena bytes each run used.
+ *
+ * Every stage runs on one thread so numbers are comparable between
+ * machines with different core counts. Each code's bars depend only on
+ * the seed and the code's index, so code 0 is identical in every universe.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <getopt.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <samdata/samrng.h>
+#include <samrena.h>
+#include <samvector.h>
+
+#include <samtrader/adapters/file_config_adapter.h>
+#include <samtrader/domain/backtest.h>
+#include <samtrader/domain/code_data.h>
+#include <samtrader/domain/metrics.h>
+#include <samtrader/domain/ohlcv.h>
+#include <samtrader/domain/portfolio.h>
+#include <samtrader/domain/rule.h>
+#include <samtrader/domain/rule_program.h>
+#include <samtrader/domain/strategy.h>
+#include <samtrader/ports/config_port.h>
+
+#ifndef SAMTRADER_EXAMPLES_DIR
+#define SAMTRADER_EXAMPLES_DIR "examples"
+#endif
+
+#define BENCH_MAX_SIZES 16
+#define BENCH_DEFAULT_BARS 5000
+#define BENCH_DEFAULT_REPEAT 3
+#define BENCH_DEFAULT_SEED 20250101u
+#define BENCH_PATH_MAX 4096
+
+/* First synthetic bar: Monday 2000-01-03 UTC */
+#define BENCH_FIRST_DATE ((time_t)946857600)
+#define SECONDS_PER_DAY 86400
+
+/* Listing dates are staggered over a trading year so the timeline is ragged */
+#define BENCH_LISTING_SPREAD 250
+
+/* Strategy files from examples/ that the benchmark runs, in report order */
+static const char *const BENCH_STRATEGIES[] = {
+    "sma_crossover",   "rsi_mean_reversion", "bollinger_bands",
+    "momentum",        "golden_cross_filtered",
+};
+#define BENCH_STRATEGY_COUNT (sizeof(BENCH_STRATEGIES) / sizeof(BENCH_STRATEGIES[0]))
+
+typedef enum {
+  STAGE_INDICATORS,
+  STAGE_TIMELINE,
+  STAGE_COMPILE,
+  STAGE_RULES,
+  STAGE_BACKTEST,
+  STAGE_METRICS,
+  STAGE_COUNT
+} BenchStage;
+
+static const char *const STAGE_NAMES[STAGE_COUNT] = {"indicators", "timeline", "compile",
+                                                     "rules",      "backtest", "metrics"};
+
+typedef struct {
+  size_t sizes[BENCH_MAX_SIZES]; /* -n / --codes */
+  size_t size_count;
+  size_t bars;                   /* -b / --bars */
+  int repeat;                    /* -r / --repeat */
+  uint64_t seed;                 /* -S / --seed */
+  const char *examples_dir;      /* -e / --examples */
+  const char *output_path;       /* -o / --output (stdout when NULL) */
+} BenchArgs;
+
+typedef struct {
+  const char *name;
+  SamtraderStrategy strategy;
+} BenchStrategy;
+
+/* Best-of-N result for one strategy over one universe */
+typedef struct {
+  uint64_t stage_ns[STAGE_COUNT];
+  uint64_t peak_arena_bytes;
+  size_t signals;
+  int trades;
+  double total_return;
+} BenchResult;
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void print_usage(const char *prog) {
+  fprintf(stderr,
+          "Usage: %s [options]\n"
+          "\n"
+          "Options:\n"
+          "  -n, --codes <list>     Universe sizes to run, comma-separated (default 1,100,2000)\n"
+          "  -b, --bars <n>         Bars per code (default %d)\n"
+          "  -r, --repeat <n>       Runs per strategy; the fastest time per stage is kept "
+          "(default %d)\n"
+          "  -S, --seed <n>         Random walk seed (default %u)\n"
+          "  -e, --examples <dir>   Directory holding the example strategies\n"
+          "  -o, --output <path>    Write JSON here instead of stdout\n"
+          "  -h, --help             Show this help\n",
+          prog, BENCH_DEFAULT_BARS, BENCH_DEFAULT_REPEAT, BENCH_DEFAULT_SEED);
+}
+
+static int parse_size(const char *text, size_t *out) {
+  char *end = NULL;
+  unsigned long long value = strtoull(text, &end, 10);
+  if (end == text || value == 0 || (*end != '\0' && *end != ','))
+    return -1;
+  *out = (size_t)value;
+  return (int)(end - text);
+}
+
+static int parse_size_list(const char *text, BenchArgs *args) {
+  args->size_count = 0;
+  const char *p = text;
+  while (*p) {
+    if (args->size_count >= BENCH_MAX_SIZES)
+      return -1;
+    int used = parse_size(p, &args->sizes[args->size_count]);
+    if (used < 0)
+      return -1;
+    args->size_count++;
+    p += used;
+    if (*p == ',')
+      p++;
+  }
+  return args->size_count > 0 ? 0 : -1;
+}
+
+static int parse_args(int argc, char *argv[], BenchArgs *args) {
+  static const struct option long_options[] = {{"codes", required_argument, NULL, 'n'},
+                                               {"bars", required_argument, NULL, 'b'},
+                                               {"repeat", required_argument, NULL, 'r'},
+                                               {"seed", required_argument, NULL, 'S'},
+                                               {"examples", required_argument, NULL, 'e'},
+                                               {"output", required_argument, NULL, 'o'},
+                                               {"help", no_argument, NULL, 'h'},
+                                               {NULL, 0, NULL, 0}};
+
+  memset(args, 0, sizeof(*args));
+  args->sizes[0] = 1;
+  args->sizes[1] = 100;
+  args->sizes[2] = 2000;
+  args->size_count = 3;
+  args->bars = BENCH_DEFAULT_BARS;
+  args->repeat = BENCH_DEFAULT_REPEAT;
+  args->seed = BENCH_DEFAULT_SEED;
+  args->examples_dir = SAMTRADER_EXAMPLES_DIR;
+
+  int opt;
+  size_t value;
+  while ((opt = getopt_long(argc, argv, "n:b:r:S:e:o:h", long_options, NULL)) != -1) {
+    switch (opt) {
+      case 'n':
+        if (parse_size_list(optarg, args) < 0) {
+          fprintf(stderr, "Error: --codes expects up to %d comma-separated positive counts\n",
+                  BENCH_MAX_SIZES);
+          return 1;
+        }
+        break;
+      case 'b':
+        if (parse_size(optarg, &value) < 0 || optarg[strcspn(optarg, ",")] != '\0') {
+          fprintf(stderr, "Error: --bars must be a positive integer\n");
+          return 1;
+        }
+        args->bars = value;
+        break;
+      case 'r':
+        if (parse_size(optarg, &value) < 0 || value > 1000) {
+          fprintf(stderr, "Error: --repeat must be between 1 and 1000\n");
+          return 1;
+        }
+        args->repeat = (int)value;
+        break;
+      case 'S': {
+        char *end = NULL;
+        args->seed = strtoull(optarg, &end, 10);
+        if (end == optarg || *end != '\0') {
+          fprintf(stderr, "Error: --seed must be an unsigned integer\n");
+          return 1;
+        }
+        break;
+      }
+      case 'e':
+        args->examples_dir = optarg;
+        break;
+      case 'o':
+        args->output_path = optarg;
+        break;
+      case 'h':
+        print_usage(argv[0]);
+        return -1;
+      default:
+        print_usage(argv[0]);
+        return 1;
+    }
+  }
+  return 0;
+}
+
+/* --- Strategies --- */
+
+static SamtraderRule *parse_rule(Samrena *arena, SamtraderConfigPort *config, const char *key,
+                                 const char *path) {
+  const char *text = config->get_string(config, "strategy", key);
+  if (!text || text[0] == '\0')
+    return NULL;
+  SamtraderRule *rule = samtrader_rule_parse(arena, text);
+  if (!rule)
+    fprintf(stderr, "Error: failed to parse %s in %s: %s\n", key, path, text);
+  return rule;
+}
+
+static int load_strategy(Samrena *arena, const char *dir, const char *name,
+                         SamtraderStrategy *strategy) {
+  char path[BENCH_PATH_MAX];
+  if (snprintf(path, sizeof(path), "%s/%s.ini", dir, name) >= (int)sizeof(path))
+    return -1;
+
+  SamtraderConfigPort *config = samtrader_file_config_adapter_create(arena, path);
+  if (!config) {
+    fprintf(stderr, "Error: failed to load strategy file: %s\n", path);
+    return -1;
+  }
+
+  memset(strategy, 0, sizeof(*strategy));
+  strategy->name = name;
+  strategy->description = "";
+  strategy->entry_long = parse_rule(arena, config, "entry_long", path);
+  strategy->exit_long = parse_rule(arena, config, "exit_long", path);
+  strategy->entry_short = parse_rule(arena, config, "entry_short", path);
+  strategy->exit_short = parse_rule(arena, config, "exit_short", path);
+  strategy->position_size = config->get_double(config, "strategy", "position_size", 0.25);
+  strategy->stop_loss_pct = config->get_double(config, "strategy", "stop_loss", 0.0);
+  strategy->take_profit_pct = config->get_double(config, "strategy", "take_profit", 0.0);
+  strategy->max_positions = config->get_int(config, "strategy", "max_positions", 1);
+  config->close(config);
+
+  if (!strategy->entry_long || !strategy->exit_long) {
+    fprintf(stderr, "Error: %s needs entry_long and exit_long rules\n", path);
+    return -1;
+  }
+  return 0;
+}
+
+/* --- Synthetic universe --- */
+
+/* Next weekday after t (bars are daily, markets are closed at weekends) */
+static time_t next_weekday(time_t t) {
+  do {
+    t += SECONDS_PER_DAY;
+  } while (((t / SECONDS_PER_DAY) + 4) % 7 >= 5); /* 1970-01-01 was a Thursday */
+  return t;
+}
+
+/* One code's random walk: geometric daily returns with intraday noise */
+static SamtraderCodeData *generate_code(Samrena *arena, SamRng *rng, uint64_t seed, size_t index,
+                                        size_t bars) {
+  samrng_seed(rng, seed + index * 0x9E3779B97F4A7C15ull);
+
+  char code[16];
+  snprintf(code, sizeof(code), "SYN%05zu", index);
+  SamtraderCodeData *cd = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderCodeData);
+  SamtraderBarColumns *columns = samtrader_bar_columns_create(arena, code, "SYN", bars);
+  if (!cd || !columns)
+    return NULL;
+
+  time_t date = BENCH_FIRST_DATE;
+  for (size_t skip = index % BENCH_LISTING_SPREAD; skip > 0; skip--)
+    date = next_weekday(date);
+
+  double close = samrng_uniform_double(rng, 5.0, 200.0);
+  double drift = samrng_normal_double(rng, 0.0002, 0.0003);
+  double volatility = samrng_uniform_double(rng, 0.008, 0.03);
+  for (size_t i = 0; i < bars; i++) {
+    double open = close * (1.0 + samrng_normal_double(rng, 0.0, volatility * 0.25));
+    close = open * exp(samrng_normal_double(rng, drift, volatility));
+    double top = open > close ? open : close;
+    double bottom = open < close ? open : close;
+    columns->date[i] = date;
+    columns->open[i] = open;
+    columns->high[i] = top * (1.0 + fabs(samrng_normal_double(rng, 0.0, volatility * 0.5)));
+    columns->low[i] = bottom * (1.0 - fabs(samrng_normal_double(rng, 0.0, volatility * 0.5)));
+    columns->close[i] = close;
+    columns->volume[i] = (int64_t)samrng_uniform_double(rng, 1e5, 5e6);
+    date = next_weekday(date);
+  }
+
+  cd->bars = columns;
+  cd->code = columns->code;
+  cd->exchange = columns->exchange;
+  cd->bar_count = bars;
+  return cd;
+}
+
+static SamtraderCodeData **generate_universe(Samrena *arena, uint64_t seed, size_t code_count,
+                                             size_t bars) {
+  SamRng *rng = samrng_create(arena, seed);
+  SamtraderCodeData **code_data = SAMRENA_PUSH_ARRAY_ZERO(arena, SamtraderCodeData *, code_count);
+  if (!rng || !code_data)
+    return NULL;
+  for (size_t c = 0; c < code_count; c++) {
+    code_data[c] = generate_code(arena, rng, seed, c, bars);
+    if (!code_data[c])
+      return NULL;
+  }
+  return code_data;
+}
+
+/* --- Pipeline --- */
+
+/* Signals raised by the entry and exit rules, read bar by bar as the backtest reads them
+ * (compiling evaluates every rule over the whole series) */
+static size_t evaluate_rules(const SamtraderStrategyProgram *programs,
+                             SamtraderCodeData *const *code_data, size_t code_count) {
+  size_t signals = 0;
+  for (size_t c = 0; c < code_count; c++) {
+    const SamtraderStrategyProgram *p = &programs[c];
+    for (size_t i = 0; i < code_data[c]->bar_count; i++) {
+      signals += samtrader_rule_signals_test(&p->entry_long_signals, i);
+      signals += samtrader_rule_signals_test(&p->exit_long_signals, i);
+      signals += samtrader_rule_signals_test(&p->entry_short_signals, i);
+      signals += samtrader_rule_signals_test(&p->exit_short_signals, i);
+    }
+  }
+  return signals;
+}
+
+/* One timed pass of the whole pipeline on a fresh arena */
+static int run_once(const SamtraderStrategy *strategy, SamtraderCodeData **code_data,
+                    size_t code_count, const SamtraderBacktestConfig *config, BenchResult *out) {
+  Samrena *arena = samrena_create_session();
+  if (!arena)
+    return -1;
+
+  int rc = -1;
+  uint64_t t[STAGE_COUNT + 1];
+
+  t[STAGE_INDICATORS] = now_ns();
+  for (size_t c = 0; c < code_count; c++) {
+    if (samtrader_code_data_compute_indicators(arena, code_data[c], strategy) < 0)
+      goto done;
+  }
+
+  t[STAGE_TIMELINE] = now_ns();
+  SamtraderTimeline *timeline = samtrader_timeline_build(arena, code_data, code_count);
+  if (!timeline)
+    goto done;
+
+  t[STAGE_COMPILE] = now_ns();
+  SamtraderStrategyProgram *programs =
+      SAMRENA_PUSH_ARRAY_ZERO(arena, SamtraderStrategyProgram, code_count);
+  if (!programs)
+    goto done;
+  for (size_t c = 0; c < code_count; c++) {
+    if (samtrader_strategy_compile(arena, strategy, code_data[c], &programs[c]) < 0)
+      goto done;
+  }
+
+  t[STAGE_RULES] = now_ns();
+  out->signals = evaluate_rules(programs, code_data, code_count);
+
+  t[STAGE_BACKTEST] = now_ns();
+  SamtraderPortfolio *portfolio =
+      samtrader_backtest_run(arena, config, strategy, code_data, programs, timeline);
+  if (!portfolio)
+    goto done;
+
+  t[STAGE_METRICS] = now_ns();
+  SamtraderMetrics *metrics =
+      samtrader_metrics_calculate(arena, portfolio->closed_trades, portfolio->equity_curve, 0.05);
+  if (!metrics)
+    goto done;
+  t[STAGE_COUNT] = now_ns();
+
+  for (int s = 0; s < STAGE_COUNT; s++) {
+    uint64_t ns = t[s + 1] - t[s];
+    if (out->stage_ns[s] == 0 || ns < out->stage_ns[s])
+      out->stage_ns[s] = ns;
+  }
+  uint64_t bytes = samrena_allocated(arena);
+  if (bytes > out->peak_arena_bytes)
+    out->peak_arena_bytes = bytes;
+  out->trades = metrics->total_trades;
+  out->total_return = metrics->total_return;
+  rc = 0;
+
+done:
+  samrena_destroy(arena);
+  return rc;
+}
+
+/* --- Report --- */
+
+static void write_result(FILE *fp, const BenchStrategy *strategy, size_t code_count,
+                         size_t total_bars, uint64_t data_arena_bytes, const BenchResult *r,
+                         bool last) {
+  uint64_t total_ns = 0;
+  for (int s = 0; s < STAGE_COUNT; s++)
+    total_ns += r->stage_ns[s];
+
+  fprintf(fp,
+          "    {\"strategy\": \"%s\", \"codes\": %zu, \"bars\": %zu, "
+          "\"data_arena_bytes\": %llu, \"peak_arena_bytes\": %llu, "
+          "\"signals\": %zu, \"trades\": %d, \"total_return\": %.10g,\n"
+          "     \"stages\": {",
+          strategy->name, code_count, total_bars, (unsigned long long)data_arena_bytes,
+          (unsigned long long)r->peak_arena_bytes, r->signals, r->trades, r->total_return);
+  for (int s = 0; s < STAGE_COUNT; s++) {
+    fprintf(fp, "%s\n       \"%s\": {\"ns\": %llu, \"ns_per_bar\": %.3f}", s ? "," : "",
+            STAGE_NAMES[s], (unsigned long long)r->stage_ns[s],
+            (double)r->stage_ns[s] / (double)total_bars);
+  }
+  fprintf(fp, "},\n     \"total\": {\"ns\": %llu, \"ns_per_bar\": %.3f}}%s\n",
+          (unsigned long long)total_ns, (double)total_ns / (double)total_bars, last ? "" : ",");
+}
+
+int main(int argc, char *argv[]) {
+  BenchArgs args;
+  int rc = parse_args(argc, argv, &args);
+  if (rc != 0)
+    return rc < 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  Samrena *arena = samrena_create_default();
+  if (!arena) {
+    fprintf(stderr, "Error: failed to create memory arena\n");
+    return EXIT_FAILURE;
+  }
+
+  FILE *fp = stdout;
+  BenchStrategy strategies[BENCH_STRATEGY_COUNT];
+  rc = EXIT_FAILURE;
+  for (size_t s = 0; s < BENCH_STRATEGY_COUNT; s++) {
+    strategies[s].name = BENCH_STRATEGIES[s];
+    if (load_strategy(arena, args.examples_dir, BENCH_STRATEGIES[s], &strategies[s].strategy) < 0)
+      goto cleanup;
+  }
+
+  if (args.output_path) {
+    fp = fopen(args.output_path, "w");
+    if (!fp) {
+      fprintf(stderr, "Error: cannot open %s for writing\n", args.output_path);
+      fp = stdout;
+      goto cleanup;
+    }
+  }
+
+  SamtraderBacktestConfig config = {.initial_capital = 100000.0,
+                                    .commission_per_trade = 9.95,
+                                    .commission_pct = 0.0,
+                                    .slippage_pct = 0.001,
+                                    .allow_shorting = false};
+
+  fprintf(fp,
+          "{\n  \"benchmark\": \"samtrader\",\n  \"seed\": %llu,\n  \"bars_per_code\": %zu,\n"
+          "  \"repeat\": %d,\n  \"results\": [\n",
+          (unsigned long long)args.seed, args.bars, args.repeat);
+
+  for (size_t n = 0; n < args.size_count; n++) {
+    size_t code_count = args.sizes[n];
+    Samrena *data_arena = samrena_create_session();
+    if (!data_arena) {
+      fprintf(stderr, "Error: failed to create memory arena\n");
+      goto cleanup;
+    }
+    SamtraderCodeData **code_data =
+        generate_universe(data_arena, args.seed, code_count, args.bars);
+    if (!code_data) {
+      fprintf(stderr, "Error: failed to generate %zu codes x %zu bars\n", code_count, args.bars);
+      samrena_destroy(data_arena);
+      goto cleanup;
+    }
+    uint64_t data_bytes = samrena_allocated(data_arena);
+
+    for (size_t s = 0; s < BENCH_STRATEGY_COUNT; s++) {
+      BenchResult result;
+      memset(&result, 0, sizeof(result));
+      for (int r = 0; r < args.repeat; r++) {
+        if (run_once(&strategies[s].strategy, code_data, code_count, &config, &result) < 0) {
+          fprintf(stderr, "Error: %s failed on %zu codes\n", strategies[s].name, code_count);
+          samrena_destroy(data_arena);
+          goto cleanup;
+        }
+      }
+      bool last = n + 1 == args.size_count && s + 1 == BENCH_STRATEGY_COUNT;
+      write_result(fp, &strategies[s], code_count, code_count * args.bars, data_bytes, &result,
+                   last);
+      fflush(fp);
+    }
+    samrena_destroy(data_arena);
+  }
+
+  fprintf(fp, "  ]\n}\n");
+  rc = EXIT_SUCCESS;
+
+cleanup:
+  if (fp != stdout && fclose(fp) != 0)
+    rc = EXIT_FAILURE;
+  samrena_destroy(arena);
+  return rc;
+}
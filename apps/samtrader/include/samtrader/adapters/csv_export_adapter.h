@@ -0,0 +1,37 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SAMTRADER_ADAPTERS_CSV_EXPORT_ADAPTER_H
+#define SAMTRADER_ADAPTERS_CSV_EXPORT_ADAPTER_H
+
+#include <samrena.h>
+
+#include <samtrader/ports/export_port.h>
+
+/**
+ * @brief Create a CSV export adapter.
+ *
+ * Writes a header row of column names followed by one comma-separated
+ * row per record. Parameter values use "%.15g" so they round-trip the
+ * sweep grid; metrics use "%.10g". Each file is written through a
+ * SamtraderWriter whose buffer lives in a scratch frame of the arena.
+ *
+ * @param arena Memory arena for all allocations
+ * @return Export port instance, or NULL on failure
+ */
+SamtraderExportPort *samtrader_csv_export_adapter_create(Samrena *arena);
+
+#endif /* SAMTRADER_ADAPTERS_CSV_EXPORT_ADAPTER_H */
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SAMTRADER_ADAPTERS_INDICATOR_CACHE_ADAPTER_H
+#define SAMTRADER_ADAPTERS_INDICATOR_CACHE_ADAPTER_H
+
+#include <stddef.h>
+
+#include <samrena.h>
+
+#include "samtrader/ports/indicator_cache_port.h"
+
+/** @brief File magic at offset 0 of every cached series file. */
+#define SAMTRADER_INDICATOR_CACHE_MAGIC "SAMTRDI1"
+
+/** @brief Current cached series file format version. */
+#define SAMTRADER_INDICATOR_CACHE_VERSION 2
+
+/**
+ * @brief Counters of one cache port's activity.
+ */
+typedef struct {
+  size_t hits;      /**< Lookups answered from the cache */
+  size_t misses;    /**< Lookups with no valid entry */
+  size_t stores;    /**< Series written */
+  size_t evictions; /**< Files removed to honour the size cap */
+  size_t bytes;     /**< Bytes of cached series on disk, as last counted */
+} SamtraderIndicatorCacheStats;
+
+/**
+ * @brief Create an indicator cache backed by a directory of mapped files.
+ *
+ * Each series is one file named by a hash of its key, holding a 128-byte
+ * header (magic, version, byte-order marker, column count, indicator type
+ * and parameters, valid start index, bar count and bar content hash), the
+ * full key text, and then the series columns one after another as double
+ * arrays from a 64-byte boundary.
+ *
+ * lookup maps the file read-only and returns a series whose columns point
+ * straight into the mapping and whose dates are the key's; validating a
+ * hit only compares the header's bar hash, bar count and key, so a warm
+ * run never recomputes or copies a series. Files are written to a temporary name and renamed into place,
+ * so concurrent processes never read a partial file.
+ *
+ * Recency is the file's modification time, refreshed on every hit. When a
+ * store takes the directory over max_bytes, the least recently used files
+ * are removed until it is back under three quarters of the cap, so the
+ * directory is rescanned rarely rather than on every store.
+ *
+ * @param arena Memory arena for the port
+ * @param directory Cache directory (created if missing)
+ * @param max_bytes Size cap in bytes (0 for no cap)
+ * @return Pointer to the created cache port, or NULL on error
+ */
+SamtraderIndicatorCachePort *samtrader_indicator_cache_adapter_create(Samrena *arena,
+                                                                      const char *directory,
+                                                                      size_t max_bytes);
+
+/**
+ * @brief Read the activity counters of an indicator cache port.
+ *
+ * @param port A port created by samtrader_indicator_cache_adapter_create()
+ * @param out Receives the counters
+ * @return 0 on success, -1 on invalid arguments
+ */
+int samtrader_indicator_cache_stats(SamtraderIndicatorCachePort *port,
+                                    SamtraderIndicatorCacheStats *out);
+
+#endif /* SAMTRADER_ADAPTERS_INDICATOR_CACHE_ADAPTER_H */
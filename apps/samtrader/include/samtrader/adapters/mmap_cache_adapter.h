@@ -0,0 +1,110 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SAMTRADER_ADAPTERS_MMAP_CACHE_ADAPTER_H
+#define SAMTRADER_ADAPTERS_MMAP_CACHE_ADAPTER_H
+
+#include <stddef.h>
+#include <time.h>
+
+#include <samrena.h>
+
+#include "samtrader/domain/ohlcv.h"
+#include "samtrader/ports/data_port.h"
+
+/** @brief File magic at offset 0 of every cache file. */
+#define SAMTRADER_MMAP_CACHE_MAGIC "SAMTRDC1"
+
+/** @brief Current cache file format version. */
+#define SAMTRADER_MMAP_CACHE_VERSION 1
+
+/** @brief Maximum code length (excluding terminator) stored in a cache file. */
+#define SAMTRADER_MMAP_CACHE_CODE_MAX 23
+
+/** @brief Maximum exchange length (excluding terminator) stored in a cache file. */
+#define SAMTRADER_MMAP_CACHE_EXCHANGE_MAX 15
+
+/**
+ * @brief Write an OHLCV snapshot of several symbols to a cache file.
+ *
+ * Fetches every code's bars from the source port (in one request when it
+ * provides fetch_ohlcv_batch) and writes them in the columnar cache format:
+ *
+ * - a 64-byte header: magic, version, byte-order marker, symbol count and
+ *   the offset of the symbol directory;
+ * - a symbol directory of fixed 64-byte entries (code, exchange, bar count,
+ *   offset of the column block), sorted by exchange then code;
+ * - one 64-byte-aligned column block per symbol holding bar_count int64
+ *   dates, then open, high, low and close as doubles, then int64 volumes.
+ *
+ * Values are stored in host byte order; readers reject files written with
+ * a different byte order. The file is written to a temporary path and
+ * renamed into place, so readers never observe a partial file.
+ *
+ * @param path Output cache file path
+ * @param source Data port to snapshot from
+ * @param codes Array of unique stock symbols
+ * @param code_count Number of symbols
+ * @param exchange Exchange identifier
+ * @param start_date Start of date range (inclusive)
+ * @param end_date End of date range (inclusive)
+ * @return 0 on success, -1 on error
+ */
+int samtrader_mmap_cache_build(const char *path, SamtraderDataPort *source,
+                               const char *const *codes, size_t code_count, const char *exchange,
+                               time_t start_date, time_t end_date);
+
+/**
+ * @brief Create a data adapter that reads a memory-mapped cache file.
+ *
+ * The file is mapped read-only and shared, so concurrent processes reading
+ * the same cache share one copy in the page cache. fetch_ohlcv locates the
+ * symbol by binary search over the directory and the date range by binary
+ * search over the date column, then copies only the bars in range.
+ * fetch_bars is samtrader_mmap_cache_view(), so loading code data through
+ * this port uses the mapped columns in place instead of copying them.
+ *
+ * @param arena Memory arena for allocations (adapter and returned data)
+ * @param path Cache file path
+ * @return Pointer to the created data port, or NULL if the file cannot be
+ *         opened or is not a valid cache file
+ *
+ * @note The mapping is released by port->close(port). Data returned by
+ *       fetch_ohlcv and list_symbols is arena-allocated and stays valid;
+ *       views from fetch_bars and samtrader_mmap_cache_view() do not.
+ */
+SamtraderDataPort *samtrader_mmap_cache_adapter_create(Samrena *arena, const char *path);
+
+/**
+ * @brief Get a zero-copy columnar view of one symbol's bars in a date range.
+ *
+ * The column pointers in out point directly into the mapping and are only
+ * valid until the port is closed. out->code and out->exchange point at the
+ * directory entry.
+ *
+ * @param port A port created by samtrader_mmap_cache_adapter_create()
+ * @param code Stock symbol
+ * @param exchange Exchange identifier
+ * @param start_date Start of date range (inclusive)
+ * @param end_date End of date range (inclusive)
+ * @param out Output view (count is 0 and arrays NULL when no bars match)
+ * @return 0 on success (including an empty range), -1 if the symbol is
+ *         not in the cache or on invalid arguments
+ */
+int samtrader_mmap_cache_view(SamtraderDataPort *port, const char *code, const char *exchange,
+                              time_t start_date, time_t end_date, SamtraderBarColumns *out);
+
+#endif /* SAMTRADER_ADAPTERS_MMAP_CACHE_ADAPTER_H */
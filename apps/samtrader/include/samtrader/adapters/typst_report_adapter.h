@@ -17,6 +17,8 @@
 #ifndef SAMTRADER_ADAPTERS_TYPST_REPORT_ADAPTER_H
 #define SAMTRADER_ADAPTERS_TYPST_REPORT_ADAPTER_H
 
+#include <stddef.h>
+
 #include <samrena.h>
 
 #include <samtrader/ports/report_port.h>
@@ -39,6 +41,8 @@
  *   - {{EQUITY_CURVE_CHART}}: Inline SVG equity curve (multi-KB, writes directly)
  *   - {{DRAWDOWN_CHART}}: Inline SVG drawdown visualization (multi-KB, writes directly)
  *   - {{TRADE_LOG}}: Typst table of all closed trades (multi-KB, writes directly)
+ *   - {{MONTHLY_RETURNS}}: Monthly returns table (writes directly)
+ *   - {{MONTE_CARLO}}: Monte Carlo percentile table, empty if not run
  *   - {{UNIVERSE_SUMMARY}}: Multi-code summary table (write_multi only)
  *   - {{PER_CODE_DETAILS}}: Per-code detail sections (write_multi only)
  *   - {{FULL_TRADE_LOG}}: Full trade log across all codes (write_multi only)
@@ -53,4 +57,17 @@
  */
 SamtraderReportPort *samtrader_typst_adapter_create(Samrena *arena, const char *template_path);
 
+/**
+ * @brief Set the maximum number of vertices per chart curve.
+ *
+ * Longer equity and drawdown curves are decimated with
+ * Largest-Triangle-Three-Buckets, which keeps the peaks and troughs that
+ * plain stride sampling drops. Defaults to 200; values below 3 are raised
+ * to 3.
+ *
+ * @param port Report port from samtrader_typst_adapter_create()
+ * @param chart_points Maximum vertices per curve
+ */
+void samtrader_typst_adapter_set_chart_points(SamtraderReportPort *port, size_t chart_points);
+
 #endif /* SAMTRADER_ADAPTERS_TYPST_REPORT_ADAPTER_H */
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SAMTRADER_ADAPTERS_WRITER_H
+#define SAMTRADER_ADAPTERS_WRITER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <samrena.h>
+
+/** Buffer size samtrader_writer_open() allocates; a full buffer is written as one chunk */
+#define SAMTRADER_WRITER_CHUNK (64 * 1024)
+
+/**
+ * @brief Buffered text output to a file descriptor.
+ *
+ * Text accumulates in a caller-owned buffer and reaches the descriptor in
+ * capacity-sized write() calls, so a whole report usually costs one or
+ * two system calls. Numbers can be appended without printf: integers and
+ * fixed-precision decimals are converted directly into the buffer.
+ *
+ * Errors are sticky. After the first failed write further output is
+ * dropped, and samtrader_writer_flush() and samtrader_writer_close()
+ * report the failure, so callers need not check every append.
+ */
+typedef struct {
+  int fd;          /**< Destination descriptor, or -1 when closed */
+  char *buffer;    /**< Pending output */
+  size_t length;   /**< Bytes pending in buffer */
+  size_t capacity; /**< Buffer size in bytes (> 0) */
+  bool failed;     /**< Set once any write has failed */
+} SamtraderWriter;
+
+/**
+ * @brief Attach a writer to a descriptor and a buffer.
+ *
+ * @param writer Writer to initialise
+ * @param fd Open descriptor; the writer closes it in samtrader_writer_close()
+ * @param buffer Buffer of at least capacity bytes, kept for the writer's lifetime
+ * @param capacity Buffer size in bytes (> 0)
+ */
+void samtrader_writer_init(SamtraderWriter *writer, int fd, char *buffer, size_t capacity);
+
+/**
+ * @brief Create or truncate a file and attach a writer to it.
+ *
+ * The SAMTRADER_WRITER_CHUNK buffer is pushed onto the arena, so callers
+ * writing from a scratch frame get it back when the frame ends.
+ *
+ * @param writer Writer to initialise
+ * @param arena Memory arena for the buffer
+ * @param path Output file path
+ * @return true on success, false if the file cannot be opened or the
+ *         buffer cannot be allocated
+ */
+bool samtrader_writer_open(SamtraderWriter *writer, Samrena *arena, const char *path);
+
+/**
+ * @brief Append raw bytes.
+ *
+ * @param writer The writer
+ * @param data Bytes to append
+ * @param length Number of bytes
+ */
+void samtrader_writer_write(SamtraderWriter *writer, const char *data, size_t length);
+
+/**
+ * @brief Append a NUL-terminated string.
+ *
+ * @param writer The writer
+ * @param text String to append
+ */
+void samtrader_writer_puts(SamtraderWriter *writer, const char *text);
+
+/**
+ * @brief Append printf-formatted text, formatted straight into the buffer.
+ *
+ * @param writer The writer
+ * @param format printf format string
+ */
+void samtrader_writer_printf(SamtraderWriter *writer, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Append a decimal integer.
+ *
+ * @param writer The writer
+ * @param value Integer to append
+ */
+void samtrader_writer_int(SamtraderWriter *writer, long long value);
+
+/**
+ * @brief Append a decimal with a fixed number of fraction digits.
+ *
+ * Equivalent to "%.*f", including its rounding of exact halfway cases to
+ * the even digit, except that negative values that round to zero print
+ * without a sign. Values too large to scale exactly and non-finite values
+ * fall back to printf.
+ *
+ * @param writer The writer
+ * @param value Number to append
+ * @param decimals Fraction digits (0-9)
+ */
+void samtrader_writer_fixed(SamtraderWriter *writer, double value, int decimals);
+
+/**
+ * @brief Write all pending output to the descriptor.
+ *
+ * @param writer The writer
+ * @return true if every write so far succeeded, false otherwise
+ */
+bool samtrader_writer_flush(SamtraderWriter *writer);
+
+/**
+ * @brief Flush pending output and close the descriptor.
+ *
+ * @param writer The writer
+ * @return true if every write and the close succeeded, false otherwise
+ */
+bool samtrader_writer_close(SamtraderWriter *writer);
+
+#endif /* SAMTRADER_ADAPTERS_WRITER_H */
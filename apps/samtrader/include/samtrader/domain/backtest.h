@@ -23,6 +23,16 @@
 #include <samrena.h>
 #include <samvector.h>
 
+#include "samtrader/domain/code_data.h"
+#include "samtrader/domain/execution.h"
+#include "samtrader/domain/montecarlo.h"
+#include "samtrader/domain/portfolio.h"
+#include "samtrader/domain/rule_program.h"
+#include "samtrader/domain/strategy.h"
+
+/* Defined in samtrader/domain/metrics.h, which includes this header */
+typedef struct SamtraderMetricsAccumulator SamtraderMetricsAccumulator;
+
 /**
  * @brief Backtest configuration parameters.
  */
@@ -34,6 +44,9 @@ typedef struct {
   double commission_pct;       /**< Percentage of trade value */
   double slippage_pct;         /**< Price slippage simulation */
   bool allow_shorting;         /**< Whether short selling is allowed */
+  SamtraderFillPolicy fill_policy;       /**< When rule signals fill (default: same bar close) */
+  SamtraderTriggerPolicy trigger_policy; /**< How stops/targets are checked (default: close) */
+  bool close_at_end;                     /**< Exit open positions on the last date */
 } SamtraderBacktestConfig;
 
 /**
@@ -45,11 +58,11 @@ typedef struct {
  */
 typedef struct {
   double total_return;           /**< (final - initial) / initial */
-  double annualized_return;      /**< (1 + total_return)^(252/trading_days) - 1 */
-  double sharpe_ratio;           /**< mean(daily_returns) / stddev(daily_returns) * sqrt(252) */
-  double sortino_ratio;          /**< mean(daily_returns) / downside_dev * sqrt(252) */
+  double annualized_return;      /**< (1 + total_return)^(bars_per_year/bars) - 1 */
+  double sharpe_ratio;           /**< mean(bar_returns) / stddev * sqrt(bars_per_year) */
+  double sortino_ratio;          /**< mean(bar_returns) / downside_dev * sqrt(bars_per_year) */
   double max_drawdown;           /**< Largest peak-to-trough decline (fraction) */
-  double max_drawdown_duration;  /**< Days of longest drawdown period */
+  double max_drawdown_duration;  /**< Trading days of longest drawdown period */
   double win_rate;               /**< winning_trades / total_trades */
   double profit_factor;          /**< sum(winning_pnl) / abs(sum(losing_pnl)) */
   int total_trades;              /**< Total number of closed trades */
@@ -62,6 +75,7 @@ typedef struct {
   double average_trade_duration; /**< Mean days between entry and exit */
   SamrenaVector *equity_curve;   /**< Vector of SamtraderEquityPoint */
   SamrenaVector *trades;         /**< Vector of SamtraderClosedTrade */
+  const SamtraderMonteCarloResult *montecarlo; /**< Resampling percentiles, or NULL if not run */
 } SamtraderBacktestResult;
 
 /**
@@ -94,4 +108,65 @@ typedef struct {
   size_t code_count;                 /**< Number of entries in code_results */
 } SamtraderMultiCodeResult;
 
+/**
+ * @brief Run the simulation loop over a prepared universe.
+ *
+ * Walks the aligned timeline once. On each date it fills orders left
+ * pending from a code's previous bar (SAMTRADER_FILL_NEXT_BAR_OPEN, exits
+ * before entries, at the open), checks stop loss / take profit triggers
+ * (per config->trigger_policy), evaluates exit then entry programs for
+ * every code with a bar on that date (in universe order), and records
+ * portfolio equity at the close. Orders still pending after a code's last
+ * bar are never filled. With config->close_at_end, positions still open
+ * on the last date are exited at their code's latest close before that
+ * date's equity is recorded, so the run ends flat. Only
+ * config->initial_capital, the commission and slippage fields,
+ * allow_shorting, close_at_end and the two policies are used; the date
+ * range is already applied to the loaded data.
+ *
+ * Inputs are read-only, so several runs over the same code data and
+ * timeline may proceed concurrently on separate arenas.
+ *
+ * @param arena Memory arena for the portfolio, trades and equity curve
+ * @param config Backtest configuration
+ * @param strategy Strategy supplying position sizing and exit levels
+ * @param code_data Array of code data pointers (with bars loaded)
+ * @param programs Compiled strategy programs, one per code
+ * @param timeline Aligned timeline built from code_data
+ * @return The final portfolio, or NULL on error
+ */
+SamtraderPortfolio *samtrader_backtest_run(Samrena *arena, const SamtraderBacktestConfig *config,
+                                           const SamtraderStrategy *strategy,
+                                           SamtraderCodeData *const *code_data,
+                                           const SamtraderStrategyProgram *programs,
+                                           const SamtraderTimeline *timeline);
+
+/**
+ * @brief Run the simulation loop, streaming its results into metrics.
+ *
+ * Simulates exactly as samtrader_backtest_run(), but hands each closed
+ * trade and each date's equity to the accumulator as they are produced
+ * instead of recording an equity curve (the returned portfolio's
+ * equity_curve stays empty). Callers that keep only metrics, such as
+ * sweeps, skip the curve and the scans over it. Initialise metrics with
+ * samtrader_metrics_bars_per_year_of_dates() over the timeline's dates to
+ * match samtrader_metrics_calculate() on a full run.
+ *
+ * @param arena Memory arena for the portfolio and trades
+ * @param config Backtest configuration
+ * @param strategy Strategy supplying position sizing and exit levels
+ * @param code_data Array of code data pointers (with bars loaded)
+ * @param programs Compiled strategy programs, one per code
+ * @param timeline Aligned timeline built from code_data
+ * @param metrics Initialised accumulator to feed
+ * @return The final portfolio, or NULL on error
+ */
+SamtraderPortfolio *samtrader_backtest_run_streaming(Samrena *arena,
+                                                     const SamtraderBacktestConfig *config,
+                                                     const SamtraderStrategy *strategy,
+                                                     SamtraderCodeData *const *code_data,
+                                                     const SamtraderStrategyProgram *programs,
+                                                     const SamtraderTimeline *timeline,
+                                                     SamtraderMetricsAccumulator *metrics);
+
 #endif /* SAMTRADER_DOMAIN_BACKTEST_H */
@@ -18,37 +18,63 @@
 #define SAMTRADER_DOMAIN_CODE_DATA_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include <time.h>
 
 #include <samdata/samhashmap.h>
 #include <samrena.h>
 #include <samvector.h>
 
+#include "samtrader/domain/ohlcv.h"
 #include "samtrader/domain/strategy.h"
+#include "samtrader/domain/universe.h"
+#include "samtrader/domain/worker_pool.h"
 
-/* Forward declaration to avoid including full port header */
+/* Forward declarations to avoid including full port headers */
 typedef struct SamtraderDataPort SamtraderDataPort;
+typedef struct SamtraderIndicatorCachePort SamtraderIndicatorCachePort;
 
 /**
  * @brief Per-code data container for multi-code backtesting.
  *
  * Holds OHLCV data, pre-computed indicators, and metadata for a single
- * instrument in a multi-code backtest universe.
+ * instrument in a multi-code backtest universe. The bars are stored only
+ * in columnar form; code and exchange are the bars' own strings, so they
+ * are held once per code rather than once per bar. Row-oriented bars can
+ * be rebuilt on demand with samtrader_ohlcv_from_bar_columns().
  */
 typedef struct {
-  const char *code;       /**< Stock symbol (arena-allocated) */
-  const char *exchange;   /**< Exchange identifier (arena-allocated) */
-  SamrenaVector *ohlcv;   /**< Vector of SamtraderOhlcv bars */
-  SamHashMap *indicators; /**< indicator_key -> SamtraderIndicatorSeries* */
-  size_t bar_count;       /**< Number of OHLCV bars */
+  const char *code;          /**< Stock symbol (arena-allocated) */
+  const char *exchange;      /**< Exchange identifier (arena-allocated) */
+  SamHashMap *indicators;    /**< indicator_key -> SamtraderIndicatorSeries* */
+  size_t bar_count;          /**< Number of OHLCV bars */
+  SamtraderBarColumns *bars; /**< OHLCV bars, one array per field */
 } SamtraderCodeData;
 
+/**
+ * @brief Unified date timeline aligned to every code's bars.
+ *
+ * bar_index is a dense date_count x code_count matrix stored row-major by
+ * timeline position, so all codes for one date are adjacent in memory:
+ * bar_index[t * code_count + c] is the index of code c's bar on dates[t],
+ * or -1 if code c has no bar on that date.
+ */
+typedef struct {
+  SamrenaVector *dates; /**< Vector of time_t (sorted ascending, no duplicates) */
+  size_t date_count;    /**< Number of timeline dates */
+  size_t code_count;    /**< Number of codes (matrix columns) */
+  int32_t *bar_index;   /**< Per-date, per-code bar index (-1 = no bar) */
+} SamtraderTimeline;
+
 /**
  * @brief Load OHLCV data for a single code via the data port.
  *
- * Fetches OHLCV data for the specified code and wraps it in a
- * SamtraderCodeData container. The indicators field is set to NULL
- * and must be populated separately via samtrader_code_data_compute_indicators.
+ * Fetches OHLCV data for the specified code and stores it in the
+ * columnar bars of a new SamtraderCodeData container. When the port
+ * provides fetch_bars the bars are borrowed from it rather than copied,
+ * and stay valid only until the port is closed.
+ * The indicators field is set to NULL and must be populated separately
+ * via samtrader_code_data_compute_indicators.
  *
  * @param arena Memory arena for allocation
  * @param data_port Data source to fetch from
@@ -62,12 +88,71 @@ SamtraderCodeData *samtrader_load_code_data(Samrena *arena, SamtraderDataPort *d
                                             const char *code, const char *exchange,
                                             time_t start_date, time_t end_date);
 
+/**
+ * @brief Load OHLCV data for many codes via the data port.
+ *
+ * Borrows each code's bars through fetch_bars when the port provides it.
+ * Otherwise uses the port's fetch_ohlcv_batch when it provides one, so the
+ * whole universe arrives in a single request, and falls back to one
+ * fetch_ohlcv per code. Each entry is built as by samtrader_load_code_data.
+ *
+ * @param arena Memory arena for allocation
+ * @param data_port Data source to fetch from
+ * @param codes Array of unique stock symbols
+ * @param code_count Number of symbols
+ * @param exchange Exchange identifier
+ * @param start_date Start of date range (inclusive)
+ * @param end_date End of date range (inclusive)
+ * @return Arena-allocated array of code_count code data pointers parallel
+ *         to codes, or NULL on error
+ */
+SamtraderCodeData **samtrader_load_code_data_batch(Samrena *arena, SamtraderDataPort *data_port,
+                                                   const char *const *codes, size_t code_count,
+                                                   const char *exchange, time_t start_date,
+                                                   time_t end_date);
+
+/**
+ * @brief Validate a universe and load its codes' data in a single pass.
+ *
+ * Fetches every code once (borrowing the bars through fetch_bars, or in one
+ * request when the port provides fetch_ohlcv_batch) and keeps the codes with at least
+ * SAMTRADER_MIN_OHLCV_BARS bars. Skipped codes are reported on stderr and
+ * removed from the universe in place, so universe->codes stays parallel to
+ * the returned array. Each entry is built as by samtrader_load_code_data.
+ *
+ * @param arena Memory arena for allocation
+ * @param data_port Data source to fetch from
+ * @param universe The universe to validate and load (modified in-place)
+ * @param start_date Start of date range (inclusive)
+ * @param end_date End of date range (inclusive)
+ * @param out Receives the arena-allocated array of loaded code data
+ * @return Number of codes loaded, 0 if no code has enough data, or -1 on
+ *         error (in which case out is left untouched)
+ */
+int samtrader_load_universe_data(Samrena *arena, SamtraderDataPort *data_port,
+                                 SamtraderUniverse *universe, time_t start_date, time_t end_date,
+                                 SamtraderCodeData ***out);
+
+/**
+ * @brief Replace a code's bars with coarser bars of the given interval.
+ *
+ * Resamples code_data->bars (see samtrader_bar_columns_resample()) and
+ * replaces bars and bar_count with the result. Must run before indicators are
+ * computed, which then see only the resampled bars.
+ *
+ * @param arena Memory arena for the resampled bars
+ * @param code_data The code data to resample
+ * @param period Bar interval in seconds (see samtrader_bar_interval_parse())
+ * @return 0 on success, -1 on error
+ */
+int samtrader_code_data_resample(Samrena *arena, SamtraderCodeData *code_data, int64_t period);
+
 /**
  * @brief Pre-compute indicators for a single code from strategy rules.
  *
  * Traverses all strategy rules, collects unique indicator operands,
- * calculates each indicator series from the code's OHLCV data, and
- * stores results in code_data->indicators.
+ * calculates each indicator series from the code's columnar OHLCV data,
+ * and stores results in code_data->indicators.
  *
  * @param arena Memory arena for allocation
  * @param code_data The code data to compute indicators for
@@ -77,11 +162,64 @@ SamtraderCodeData *samtrader_load_code_data(Samrena *arena, SamtraderDataPort *d
 int samtrader_code_data_compute_indicators(Samrena *arena, SamtraderCodeData *code_data,
                                            const SamtraderStrategy *strategy);
 
+/**
+ * @brief Pre-compute the union of several strategies' indicators for one code.
+ *
+ * Like samtrader_code_data_compute_indicators(), but collects indicator
+ * operands from every strategy. Operands with the same indicator key
+ * (see samtrader_operand_indicator_key()) are computed once and shared, so
+ * strategy variants that differ only in a few parameters reuse the
+ * series they have in common.
+ *
+ * With a cache, each series is first looked up by the code, exchange,
+ * indicator key and a content hash of the bars (hashed once per code);
+ * only misses are computed, and they are stored back for later runs.
+ * Code data without a code or exchange bypasses the cache. A failed
+ * store is not an error.
+ *
+ * @param arena Memory arena for allocation
+ * @param code_data The code data to compute indicators for
+ * @param strategies Array of strategies
+ * @param strategy_count Number of strategies (must be at least 1)
+ * @param cache Persistent indicator cache (NULL to always compute)
+ * @return 0 on success, -1 on error
+ */
+int samtrader_code_data_compute_indicators_multi(Samrena *arena, SamtraderCodeData *code_data,
+                                                 const SamtraderStrategy *strategies,
+                                                 size_t strategy_count,
+                                                 SamtraderIndicatorCachePort *cache);
+
+/**
+ * @brief Pre-compute indicators for many codes across a worker pool.
+ *
+ * Runs samtrader_code_data_compute_indicators_multi() once per code, each
+ * on the private arena of whichever worker picks it up. The resulting
+ * indicator series live in the worker arenas, so the pool must outlive
+ * every use of code_data[i]->indicators. Results are identical to the
+ * serial path regardless of the number of workers. Series taken from the
+ * cache stay valid until it is closed.
+ *
+ * @param pool Worker pool to run on
+ * @param code_data Array of code data pointers (each with bars set)
+ * @param code_count Number of codes
+ * @param strategies Array of strategies whose indicators are computed
+ * @param strategy_count Number of strategies (must be at least 1)
+ * @param cache Persistent indicator cache shared by the workers (may be NULL)
+ * @return 0 on success, -1 if any code failed
+ */
+int samtrader_code_data_compute_indicators_parallel(SamtraderWorkerPool *pool,
+                                                    SamtraderCodeData **code_data,
+                                                    size_t code_count,
+                                                    const SamtraderStrategy *strategies,
+                                                    size_t strategy_count,
+                                                    SamtraderIndicatorCachePort *cache);
+
 /**
  * @brief Build a sorted, deduplicated date timeline across all codes.
  *
- * Iterates all codes' OHLCV data, collects unique dates, and returns
- * a sorted vector of time_t values in ascending order.
+ * K-way merges the codes' OHLCV dates and returns a sorted vector of
+ * time_t values in ascending order. Each code's bars must already be in
+ * ascending date order, as returned by the data port.
  *
  * @param arena Memory arena for allocation
  * @param code_data Array of code data pointers
@@ -91,6 +229,38 @@ int samtrader_code_data_compute_indicators(Samrena *arena, SamtraderCodeData *co
 SamrenaVector *samtrader_build_date_timeline(Samrena *arena, SamtraderCodeData **code_data,
                                              size_t code_count);
 
+/**
+ * @brief Build the unified timeline together with its per-code bar index.
+ *
+ * Same merge as samtrader_build_date_timeline(), but also records which bar
+ * of each code falls on each timeline date, so the backtest loop can find a
+ * code's bar for a date with a single array read.
+ *
+ * @param arena Memory arena for allocation
+ * @param code_data Array of code data pointers (NULL entries have no bars)
+ * @param code_count Number of codes
+ * @return Aligned timeline, or NULL on error (including unsorted input)
+ */
+SamtraderTimeline *samtrader_timeline_build(Samrena *arena, SamtraderCodeData **code_data,
+                                            size_t code_count);
+
+/**
+ * @brief View a range of timeline dates without copying them.
+ *
+ * The view's dates and bar_index point into the parent timeline, whose
+ * bar indices still address each code's full history, so indicators
+ * computed over that history keep their lookback before begin. The view
+ * is read-only and lives as long as the parent.
+ *
+ * @param arena Memory arena for the view header
+ * @param timeline The parent timeline
+ * @param begin First date position in the view
+ * @param end One past the last date position (begin <= end <= date_count)
+ * @return The view, or NULL on error
+ */
+SamtraderTimeline *samtrader_timeline_window(Samrena *arena, const SamtraderTimeline *timeline,
+                                             size_t begin, size_t end);
+
 /**
  * @brief Build a date-to-bar-index mapping for one code's OHLCV data.
  *
@@ -98,9 +268,9 @@ SamrenaVector *samtrader_build_date_timeline(Samrena *arena, SamtraderCodeData *
  * The date key format matches that used by samtrader_build_date_timeline.
  *
  * @param arena Memory arena for allocation
- * @param ohlcv Vector of SamtraderOhlcv bars
+ * @param bars Columnar OHLCV bars
  * @return SamHashMap mapping date string -> size_t* index, or NULL on error
  */
-SamHashMap *samtrader_build_date_index(Samrena *arena, SamrenaVector *ohlcv);
+SamHashMap *samtrader_build_date_index(Samrena *arena, const SamtraderBarColumns *bars);
 
 #endif /* SAMTRADER_DOMAIN_CODE_DATA_H */
@@ -26,6 +26,40 @@
 
 #include "samtrader/domain/portfolio.h"
 
+/**
+ * @brief When entries and exits signalled by strategy rules are filled.
+ */
+typedef enum {
+  SAMTRADER_FILL_SAME_BAR_CLOSE = 0, /**< At the close of the signal bar (default) */
+  SAMTRADER_FILL_NEXT_BAR_OPEN       /**< At the open of the code's next bar */
+} SamtraderFillPolicy;
+
+/**
+ * @brief How stop loss / take profit levels are checked against a bar.
+ */
+typedef enum {
+  SAMTRADER_TRIGGER_CLOSE = 0, /**< Against the close, filling at the close (default) */
+  SAMTRADER_TRIGGER_WORST_CASE /**< Against the open/high/low path, worst case first */
+} SamtraderTriggerPolicy;
+
+/**
+ * @brief Parse a fill policy name ("same_bar_close" or "next_bar_open").
+ *
+ * @param name Policy name
+ * @param out Receives the policy on success
+ * @return true if name is a known policy, false otherwise
+ */
+bool samtrader_fill_policy_parse(const char *name, SamtraderFillPolicy *out);
+
+/**
+ * @brief Parse a trigger policy name ("close" or "worst_case").
+ *
+ * @param name Policy name
+ * @param out Receives the policy on success
+ * @return true if name is a known policy, false otherwise
+ */
+bool samtrader_trigger_policy_parse(const char *name, SamtraderTriggerPolicy *out);
+
 /**
  * @brief Calculate commission for a trade.
  *
@@ -142,8 +176,10 @@ bool samtrader_execution_exit_position(SamtraderPortfolio *portfolio, Samrena *a
 /**
  * @brief Check all positions for stop loss / take profit triggers and exit triggered positions.
  *
- * Two-pass approach: first collects triggered position codes (can't modify hashmap during
- * iteration), then exits each triggered position.
+ * Two-pass approach: first gathers each open position's price and compares it
+ * against the portfolio's exit levels (samtrader_portfolio_find_triggers()),
+ * then exits the triggered positions in open-position order (exiting
+ * reorders the open positions).
  *
  * @param portfolio Target portfolio
  * @param arena Memory arena for allocation
@@ -159,4 +195,50 @@ int samtrader_execution_check_triggers(SamtraderPortfolio *portfolio, Samrena *a
                                        double commission_flat, double commission_pct,
                                        double slippage_pct);
 
+/**
+ * @brief Check stop loss / take profit triggers against a price table.
+ *
+ * Same as samtrader_execution_check_triggers(), but reads prices from a
+ * dense table indexed by the portfolio's symbol ids and keeps the list of
+ * triggered positions on a scratch arena that is rewound before
+ * returning, so repeated calls do not grow arena.
+ *
+ * @param portfolio Target portfolio
+ * @param arena Memory arena for trade records
+ * @param scratch Arena for transient data; must not be arena itself
+ * @param prices Current prices over portfolio->symbols
+ * @param date Trade date
+ * @param commission_flat Flat commission fee
+ * @param commission_pct Commission percentage
+ * @param slippage_pct Slippage percentage
+ * @return Number of positions exited, or -1 on error
+ */
+int samtrader_execution_check_triggers_at(SamtraderPortfolio *portfolio, Samrena *arena,
+                                          Samrena *scratch, const SamtraderPriceTable *prices,
+                                          time_t date, double commission_flat,
+                                          double commission_pct, double slippage_pct);
+
+/**
+ * @brief Check stop loss / take profit triggers against each bar's range.
+ *
+ * Same as samtrader_execution_check_triggers_at(), but checks each open
+ * position against its bar's open, high and low under
+ * SAMTRADER_TRIGGER_WORST_CASE (see samtrader_portfolio_find_triggers_ohlc())
+ * and fills at the open on a gap or at the level otherwise, before slippage.
+ *
+ * @param portfolio Target portfolio
+ * @param arena Memory arena for trade records
+ * @param scratch Arena for transient data; must not be arena itself
+ * @param prices Current bars over portfolio->symbols (from samtrader_price_table_create_ohlc())
+ * @param date Trade date
+ * @param commission_flat Flat commission fee
+ * @param commission_pct Commission percentage
+ * @param slippage_pct Slippage percentage
+ * @return Number of positions exited, or -1 on error
+ */
+int samtrader_execution_check_triggers_ohlc(SamtraderPortfolio *portfolio, Samrena *arena,
+                                            Samrena *scratch, const SamtraderPriceTable *prices,
+                                            time_t date, double commission_flat,
+                                            double commission_pct, double slippage_pct);
+
 #endif /* SAMTRADER_DOMAIN_EXECUTION_H */
@@ -24,6 +24,8 @@
 #include <samrena.h>
 #include <samvector.h>
 
+#include "samtrader/domain/ohlcv.h"
+
 /**
  * @brief Enumeration of supported technical indicator types.
  *
@@ -121,6 +123,9 @@ typedef struct {
 /**
  * @brief A single indicator value at a specific point in time.
  *
+ * This is the per-bar form produced by the streaming state and by
+ * samtrader_indicator_series_at(); series themselves store columns.
+ *
  * Uses a tagged union to store type-specific data. Access the appropriate
  * union member based on the type field:
  *
@@ -170,13 +175,57 @@ typedef struct {
   double param_double; /**< Double param (Bollinger stddev multiplier) */
 } SamtraderIndicatorParams;
 
+/** Most output columns of any indicator type (Pivot). */
+#define SAMTRADER_INDICATOR_MAX_COLUMNS 7
+
 /**
- * @brief A time series of indicator values.
+ * @brief Output column of an indicator series.
+ *
+ * Columns follow the field order of the type's value struct, so column c
+ * holds the c-th double of SamtraderIndicatorValue.data.
+ */
+typedef enum {
+  SAMTRADER_COLUMN_VALUE = 0,            /**< Single-value indicators */
+  SAMTRADER_COLUMN_MACD_LINE = 0,        /**< MACD line */
+  SAMTRADER_COLUMN_MACD_SIGNAL = 1,      /**< MACD signal line */
+  SAMTRADER_COLUMN_MACD_HISTOGRAM = 2,   /**< MACD histogram */
+  SAMTRADER_COLUMN_STOCHASTIC_K = 0,     /**< Stochastic %K */
+  SAMTRADER_COLUMN_STOCHASTIC_D = 1,     /**< Stochastic %D */
+  SAMTRADER_COLUMN_BOLLINGER_UPPER = 0,  /**< Bollinger upper band */
+  SAMTRADER_COLUMN_BOLLINGER_MIDDLE = 1, /**< Bollinger middle band */
+  SAMTRADER_COLUMN_BOLLINGER_LOWER = 2,  /**< Bollinger lower band */
+  SAMTRADER_COLUMN_PIVOT = 0,            /**< Pivot point */
+  SAMTRADER_COLUMN_PIVOT_R1 = 1,         /**< Resistance 1 */
+  SAMTRADER_COLUMN_PIVOT_R2 = 2,         /**< Resistance 2 */
+  SAMTRADER_COLUMN_PIVOT_R3 = 3,         /**< Resistance 3 */
+  SAMTRADER_COLUMN_PIVOT_S1 = 4,         /**< Support 1 */
+  SAMTRADER_COLUMN_PIVOT_S2 = 5,         /**< Support 2 */
+  SAMTRADER_COLUMN_PIVOT_S3 = 6          /**< Support 3 */
+} SamtraderIndicatorColumn;
+
+/**
+ * @brief A time series of indicator values, stored as columns.
+ *
+ * Each output of the indicator is its own double array (see
+ * SamtraderIndicatorColumn), and validity is a single start index: every
+ * indicator is invalid through its warmup and valid from then on. A series
+ * computed from bars shares their date column rather than copying it, so
+ * a simple indicator costs 8 bytes per bar.
+ *
+ * Columns hold whatever the calculation produced during warmup too (e.g.
+ * the MACD line before the signal line is seeded).
  */
 typedef struct {
   SamtraderIndicatorType type;     /**< Type of indicator */
   SamtraderIndicatorParams params; /**< Calculation parameters */
-  SamrenaVector *values;           /**< Vector of SamtraderIndicatorValue */
+  size_t size;                     /**< Number of values */
+  size_t capacity;                 /**< Values each column has room for */
+  size_t valid_from;               /**< Index of the first valid value (>= size if none) */
+  size_t column_count;             /**< Output columns used by the type */
+  /** Output columns; only the first column_count are allocated */
+  double *columns[SAMTRADER_INDICATOR_MAX_COLUMNS];
+  const time_t *dates; /**< Date of each value; shared with the bars when computed */
+  Samrena *arena;      /**< Arena that grows a series built by samtrader_indicator_add_*() */
 } SamtraderIndicatorSeries;
 
 /*============================================================================
@@ -188,6 +237,32 @@ typedef struct {
  */
 const char *samtrader_indicator_type_name(SamtraderIndicatorType type);
 
+/**
+ * @brief Get the number of output columns of an indicator type.
+ *
+ * @param type Indicator type
+ * @return Column count (1 for single-value indicators)
+ */
+size_t samtrader_indicator_column_count(SamtraderIndicatorType type);
+
+/**
+ * @brief Create a series holding one value per bar of a columnar store.
+ *
+ * The series shares the bars' date column and has its output columns
+ * allocated for bars->count values, all of them initially invalid.
+ * Calculators write the columns in place and then set valid_from.
+ *
+ * @param arena Memory arena for allocation
+ * @param type Indicator type
+ * @param params Calculation parameters recorded on the series
+ * @param bars Columnar OHLCV data the series is computed from
+ * @return Pointer to the created series, or NULL on failure
+ */
+SamtraderIndicatorSeries *
+samtrader_indicator_series_for_bars(Samrena *arena, SamtraderIndicatorType type,
+                                    const SamtraderIndicatorParams *params,
+                                    const SamtraderBarColumns *bars);
+
 /**
  * @brief Create an indicator series for simple single-value indicators.
  *
@@ -196,7 +271,7 @@ const char *samtrader_indicator_type_name(SamtraderIndicatorType type);
  * @param arena Memory arena for allocation
  * @param type Indicator type
  * @param period Primary period parameter
- * @param initial_capacity Initial capacity for the values vector
+ * @param initial_capacity Initial capacity of each column
  * @return Pointer to the created series, or NULL on failure
  */
 SamtraderIndicatorSeries *samtrader_indicator_series_create(Samrena *arena,
@@ -210,7 +285,7 @@ SamtraderIndicatorSeries *samtrader_indicator_series_create(Samrena *arena,
  * @param fast_period Fast EMA period (typically 12)
  * @param slow_period Slow EMA period (typically 26)
  * @param signal_period Signal line period (typically 9)
- * @param initial_capacity Initial capacity for the values vector
+ * @param initial_capacity Initial capacity of each column
  * @return Pointer to the created series, or NULL on failure
  */
 SamtraderIndicatorSeries *samtrader_macd_series_create(Samrena *arena, int fast_period,
@@ -223,7 +298,7 @@ SamtraderIndicatorSeries *samtrader_macd_series_create(Samrena *arena, int fast_
  * @param arena Memory arena for allocation
  * @param k_period %K period (typically 14)
  * @param d_period %D period (typically 3)
- * @param initial_capacity Initial capacity for the values vector
+ * @param initial_capacity Initial capacity of each column
  * @return Pointer to the created series, or NULL on failure
  */
 SamtraderIndicatorSeries *samtrader_stochastic_series_create(Samrena *arena, int k_period,
@@ -236,7 +311,7 @@ SamtraderIndicatorSeries *samtrader_stochastic_series_create(Samrena *arena, int
  * @param arena Memory arena for allocation
  * @param period Moving average period (typically 20)
  * @param stddev_multiplier Standard deviation multiplier (typically 2.0)
- * @param initial_capacity Initial capacity for the values vector
+ * @param initial_capacity Initial capacity of each column
  * @return Pointer to the created series, or NULL on failure
  */
 SamtraderIndicatorSeries *samtrader_bollinger_series_create(Samrena *arena, int period,
@@ -247,7 +322,7 @@ SamtraderIndicatorSeries *samtrader_bollinger_series_create(Samrena *arena, int
  * @brief Create a Pivot Points indicator series.
  *
  * @param arena Memory arena for allocation
- * @param initial_capacity Initial capacity for the values vector
+ * @param initial_capacity Initial capacity of each column
  * @return Pointer to the created series, or NULL on failure
  */
 SamtraderIndicatorSeries *samtrader_pivot_series_create(Samrena *arena, uint64_t initial_capacity);
@@ -261,10 +336,11 @@ SamtraderIndicatorSeries *samtrader_pivot_series_create(Samrena *arena, uint64_t
  * @param date Timestamp for the value
  * @param value The indicator value
  * @param valid Whether the value is valid (false during warmup)
- * @return Pointer to the added value, or NULL on failure
+ * @return 0 on success, -1 on failure (including an invalid value after a
+ *         valid one, which a validity start index cannot represent)
  */
-SamtraderIndicatorValue *samtrader_indicator_add_simple(SamtraderIndicatorSeries *series,
-                                                        time_t date, double value, bool valid);
+int samtrader_indicator_add_simple(SamtraderIndicatorSeries *series, time_t date, double value,
+                                   bool valid);
 
 /**
  * @brief Add a MACD value to a series.
@@ -275,11 +351,10 @@ SamtraderIndicatorValue *samtrader_indicator_add_simple(SamtraderIndicatorSeries
  * @param signal Signal line value
  * @param histogram Histogram value
  * @param valid Whether the value is valid (false during warmup)
- * @return Pointer to the added value, or NULL on failure
+ * @return 0 on success, -1 on failure
  */
-SamtraderIndicatorValue *samtrader_indicator_add_macd(SamtraderIndicatorSeries *series, time_t date,
-                                                      double line, double signal, double histogram,
-                                                      bool valid);
+int samtrader_indicator_add_macd(SamtraderIndicatorSeries *series, time_t date, double line,
+                                 double signal, double histogram, bool valid);
 
 /**
  * @brief Add a Stochastic value to a series.
@@ -289,11 +364,10 @@ SamtraderIndicatorValue *samtrader_indicator_add_macd(SamtraderIndicatorSeries *
  * @param k %K value
  * @param d %D value
  * @param valid Whether the value is valid (false during warmup)
- * @return Pointer to the added value, or NULL on failure
+ * @return 0 on success, -1 on failure
  */
-SamtraderIndicatorValue *samtrader_indicator_add_stochastic(SamtraderIndicatorSeries *series,
-                                                            time_t date, double k, double d,
-                                                            bool valid);
+int samtrader_indicator_add_stochastic(SamtraderIndicatorSeries *series, time_t date, double k,
+                                       double d, bool valid);
 
 /**
  * @brief Add a Bollinger Bands value to a series.
@@ -304,11 +378,10 @@ SamtraderIndicatorValue *samtrader_indicator_add_stochastic(SamtraderIndicatorSe
  * @param middle Middle band value
  * @param lower Lower band value
  * @param valid Whether the value is valid (false during warmup)
- * @return Pointer to the added value, or NULL on failure
+ * @return 0 on success, -1 on failure
  */
-SamtraderIndicatorValue *samtrader_indicator_add_bollinger(SamtraderIndicatorSeries *series,
-                                                           time_t date, double upper, double middle,
-                                                           double lower, bool valid);
+int samtrader_indicator_add_bollinger(SamtraderIndicatorSeries *series, time_t date, double upper,
+                                      double middle, double lower, bool valid);
 
 /**
  * @brief Add a Pivot Points value to a series.
@@ -323,22 +396,25 @@ SamtraderIndicatorValue *samtrader_indicator_add_bollinger(SamtraderIndicatorSer
  * @param s2 Support 2 value
  * @param s3 Support 3 value
  * @param valid Whether the value is valid
- * @return Pointer to the added value, or NULL on failure
+ * @return 0 on success, -1 on failure
  */
-SamtraderIndicatorValue *samtrader_indicator_add_pivot(SamtraderIndicatorSeries *series,
-                                                       time_t date, double pivot, double r1,
-                                                       double r2, double r3, double s1, double s2,
-                                                       double s3, bool valid);
+int samtrader_indicator_add_pivot(SamtraderIndicatorSeries *series, time_t date, double pivot,
+                                  double r1, double r2, double r3, double s1, double s2, double s3,
+                                  bool valid);
 
 /**
  * @brief Get an indicator value at a specific index.
  *
+ * Gathers the value's columns into one SamtraderIndicatorValue. Hot loops
+ * should read series->columns directly instead.
+ *
  * @param series The indicator series
  * @param index Index into the series (0 = oldest)
- * @return Pointer to the value, or NULL if index out of bounds
+ * @param out Receives the value
+ * @return true if the index is in bounds, false otherwise
  */
-const SamtraderIndicatorValue *samtrader_indicator_series_at(const SamtraderIndicatorSeries *series,
-                                                             size_t index);
+bool samtrader_indicator_series_at(const SamtraderIndicatorSeries *series, size_t index,
+                                   SamtraderIndicatorValue *out);
 
 /**
  * @brief Get the number of values in an indicator series.
@@ -587,4 +663,152 @@ SamtraderIndicatorSeries *samtrader_calculate_atr(Samrena *arena, SamrenaVector
  */
 SamtraderIndicatorSeries *samtrader_calculate_pivot(Samrena *arena, SamrenaVector *ohlcv);
 
+/*============================================================================
+ * Columnar Indicator Calculation Functions
+ *============================================================================*/
+
+/*
+ * Each function below computes the same series as its SamrenaVector
+ * counterpart above, reading directly from the per-field arrays of a
+ * SamtraderBarColumns store. The vector variants convert to columns and
+ * delegate here.
+ */
+
+/**
+ * @brief Calculate an indicator series from columnar OHLCV data.
+ *
+ * Columnar counterpart of samtrader_indicator_calculate().
+ *
+ * @param arena Memory arena for allocation
+ * @param type Indicator type to calculate
+ * @param bars Columnar OHLCV data
+ * @param period Period parameter for the indicator
+ * @return Pointer to the calculated series, or NULL on failure
+ */
+SamtraderIndicatorSeries *samtrader_indicator_calculate_columns(Samrena *arena,
+                                                                SamtraderIndicatorType type,
+                                                                const SamtraderBarColumns *bars,
+                                                                int period);
+
+/** @brief Columnar counterpart of samtrader_calculate_sma(). */
+SamtraderIndicatorSeries *samtrader_calculate_sma_columns(Samrena *arena,
+                                                          const SamtraderBarColumns *bars,
+                                                          int period);
+
+/** @brief Columnar counterpart of samtrader_calculate_ema(). */
+SamtraderIndicatorSeries *samtrader_calculate_ema_columns(Samrena *arena,
+                                                          const SamtraderBarColumns *bars,
+                                                          int period);
+
+/** @brief Columnar counterpart of samtrader_calculate_wma(). */
+SamtraderIndicatorSeries *samtrader_calculate_wma_columns(Samrena *arena,
+                                                          const SamtraderBarColumns *bars,
+                                                          int period);
+
+/** @brief Columnar counterpart of samtrader_calculate_rsi(). */
+SamtraderIndicatorSeries *samtrader_calculate_rsi_columns(Samrena *arena,
+                                                          const SamtraderBarColumns *bars,
+                                                          int period);
+
+/** @brief Columnar counterpart of samtrader_calculate_bollinger(). */
+SamtraderIndicatorSeries *samtrader_calculate_bollinger_columns(Samrena *arena,
+                                                                const SamtraderBarColumns *bars,
+                                                                int period,
+                                                                double stddev_multiplier);
+
+/** @brief Columnar counterpart of samtrader_calculate_macd(). */
+SamtraderIndicatorSeries *samtrader_calculate_macd_columns(Samrena *arena,
+                                                           const SamtraderBarColumns *bars,
+                                                           int fast_period, int slow_period,
+                                                           int signal_period);
+
+/** @brief Columnar counterpart of samtrader_calculate_stochastic(). */
+SamtraderIndicatorSeries *samtrader_calculate_stochastic_columns(Samrena *arena,
+                                                                 const SamtraderBarColumns *bars,
+                                                                 int k_period, int d_period);
+
+/** @brief Columnar counterpart of samtrader_calculate_atr(). */
+SamtraderIndicatorSeries *samtrader_calculate_atr_columns(Samrena *arena,
+                                                          const SamtraderBarColumns *bars,
+                                                          int period);
+
+/** @brief Columnar counterpart of samtrader_calculate_pivot(). */
+SamtraderIndicatorSeries *samtrader_calculate_pivot_columns(Samrena *arena,
+                                                            const SamtraderBarColumns *bars);
+
+/*============================================================================
+ * Multi-Period Calculation Functions
+ *============================================================================*/
+
+/*
+ * Each function below computes one series per requested period in a single
+ * pass over the bars, carrying the per-period running state side by side.
+ * Every returned series is bit-identical to the one the single-period
+ * function computes for the same period.
+ */
+
+/**
+ * @brief Calculate Simple Moving Averages for several periods at once.
+ *
+ * @param arena Memory arena for allocation
+ * @param ohlcv Vector of SamtraderOhlcv data
+ * @param periods Array of SMA periods (each >= 1)
+ * @param count Number of periods
+ * @return Arena array of count series in the order of periods, or NULL on
+ *         failure
+ */
+SamtraderIndicatorSeries **samtrader_calculate_sma_multi(Samrena *arena, SamrenaVector *ohlcv,
+                                                         const int *periods, size_t count);
+
+/**
+ * @brief Calculate Exponential Moving Averages for several periods at once.
+ *
+ * @param arena Memory arena for allocation
+ * @param ohlcv Vector of SamtraderOhlcv data
+ * @param periods Array of EMA periods (each >= 1)
+ * @param count Number of periods
+ * @return Arena array of count series in the order of periods, or NULL on
+ *         failure
+ */
+SamtraderIndicatorSeries **samtrader_calculate_ema_multi(Samrena *arena, SamrenaVector *ohlcv,
+                                                         const int *periods, size_t count);
+
+/**
+ * @brief Calculate Stochastic Oscillators for several parameter pairs at once.
+ *
+ * The sliding highest high and lowest low are kept once, for the longest
+ * %K period, and every shorter window reads its extremes from them.
+ *
+ * @param arena Memory arena for allocation
+ * @param ohlcv Vector of SamtraderOhlcv data
+ * @param k_periods Array of %K periods (each >= 1)
+ * @param d_periods Array of %D periods (each >= 1), paired with k_periods
+ * @param count Number of parameter pairs
+ * @return Arena array of count series in the order of the pairs, or NULL
+ *         on failure
+ */
+SamtraderIndicatorSeries **samtrader_calculate_stochastic_multi(Samrena *arena,
+                                                                SamrenaVector *ohlcv,
+                                                                const int *k_periods,
+                                                                const int *d_periods,
+                                                                size_t count);
+
+/** @brief Columnar counterpart of samtrader_calculate_sma_multi(). */
+SamtraderIndicatorSeries **samtrader_calculate_sma_multi_columns(Samrena *arena,
+                                                                 const SamtraderBarColumns *bars,
+                                                                 const int *periods,
+                                                                 size_t count);
+
+/** @brief Columnar counterpart of samtrader_calculate_ema_multi(). */
+SamtraderIndicatorSeries **samtrader_calculate_ema_multi_columns(Samrena *arena,
+                                                                 const SamtraderBarColumns *bars,
+                                                                 const int *periods,
+                                                                 size_t count);
+
+/** @brief Columnar counterpart of samtrader_calculate_stochastic_multi(). */
+SamtraderIndicatorSeries **
+samtrader_calculate_stochastic_multi_columns(Samrena *arena, const SamtraderBarColumns *bars,
+                                             const int *k_periods, const int *d_periods,
+                                             size_t count);
+
 #endif /* SAMTRADER_DOMAIN_INDICATOR_H */
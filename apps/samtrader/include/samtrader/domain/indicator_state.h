@@ -0,0 +1,137 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SAMTRADER_DOMAIN_INDICATOR_STATE_H
+#define SAMTRADER_DOMAIN_INDICATOR_STATE_H
+
+#include <stddef.h>
+
+#include <samrena.h>
+
+#include "samtrader/domain/indicator.h"
+#include "samtrader/domain/ohlcv.h"
+
+/**
+ * @brief Incremental calculation state for one indicator.
+ *
+ * Holds everything needed to produce the next value from the next bar:
+ * running sums, smoothed averages and fixed-size ring buffers sized from
+ * the indicator's periods. Pushing a bar costs O(1) for every supported
+ * type except Bollinger Bands, whose deviation is taken over the window
+ * held in its ring buffer (O(period)) to match the batch result exactly.
+ *
+ * The batch calculators (samtrader_calculate_*) are built on this state,
+ * so pushing a series of bars one at a time yields bit-identical values.
+ *
+ * Usage:
+ * @code
+ * SamtraderIndicatorParams params = {.period = 14};
+ * SamtraderIndicatorState *rsi =
+ *     samtrader_indicator_state_create(arena, SAMTRADER_IND_RSI, &params);
+ *
+ * // For each new bar (live or replayed)
+ * SamtraderIndicatorValue value = samtrader_indicator_state_push(rsi, &bar);
+ * if (value.valid)
+ *   use(value.data.simple.value);
+ * @endcode
+ */
+typedef struct SamtraderIndicatorState SamtraderIndicatorState;
+
+/**
+ * @brief Create a streaming state for an indicator.
+ *
+ * Parameters follow SamtraderIndicatorParams: period for every type
+ * except Pivot, param2/param3 for the MACD slow/signal periods, param2
+ * for the Stochastic %D period and param_double for the Bollinger
+ * standard deviation multiplier.
+ *
+ * Supported types: SMA, EMA, WMA, RSI, MACD, Stochastic, Bollinger, ATR,
+ * Pivot.
+ *
+ * @param arena Memory arena for the state and its ring buffers
+ * @param type Indicator type
+ * @param params Calculation parameters
+ * @return Pointer to the created state, or NULL for an unsupported type,
+ *         an invalid period or on allocation failure
+ */
+SamtraderIndicatorState *samtrader_indicator_state_create(Samrena *arena,
+                                                          SamtraderIndicatorType type,
+                                                          const SamtraderIndicatorParams *params);
+
+/**
+ * @brief Feed the next bar and get the indicator value for it.
+ *
+ * Bars must be pushed in date order. Values during the warmup period have
+ * valid set to false and carry the same partial data as the batch series
+ * (e.g. the MACD line before the signal line is seeded).
+ *
+ * @param state The indicator state
+ * @param bar The next bar
+ * @return Indicator value for the bar (valid is false if state or bar is NULL)
+ */
+SamtraderIndicatorValue samtrader_indicator_state_push(SamtraderIndicatorState *state,
+                                                       const SamtraderOhlcv *bar);
+
+/**
+ * @brief Discard all pushed bars, returning the state to its initial warmup.
+ *
+ * @param state The indicator state
+ */
+void samtrader_indicator_state_reset(SamtraderIndicatorState *state);
+
+/**
+ * @brief Get the number of bars pushed since creation or the last reset.
+ *
+ * @param state The indicator state
+ * @return Number of bars, or 0 if state is NULL
+ */
+size_t samtrader_indicator_state_count(const SamtraderIndicatorState *state);
+
+/**
+ * @brief Push every bar of a columnar store and write the values to a series.
+ *
+ * This is the loop behind the batch calculators. Validity is recorded as
+ * the series' valid_from, the first bar the state reported valid.
+ *
+ * @param series Series from samtrader_indicator_series_for_bars() over the
+ *               same bars (its type should match the state's)
+ * @param state Streaming state for the series' indicator
+ * @param bars Columnar OHLCV data
+ * @return 0 on success, -1 on error
+ */
+int samtrader_indicator_state_fill(SamtraderIndicatorSeries *series,
+                                   SamtraderIndicatorState *state,
+                                   const SamtraderBarColumns *bars);
+
+/**
+ * @brief Stream a vector of OHLCV rows through a fresh state into a series.
+ *
+ * The row-oriented counterpart of samtrader_indicator_state_fill(): the
+ * rows are read in place and the series owns its dates, so no columnar
+ * copy of the input is built.
+ *
+ * @param arena Memory arena for the series and state
+ * @param type Indicator type
+ * @param params Calculation parameters
+ * @param ohlcv Vector of SamtraderOhlcv in ascending date order
+ * @return Filled series, or NULL on error or empty input
+ */
+SamtraderIndicatorSeries *
+samtrader_indicator_series_from_ohlcv(Samrena *arena, SamtraderIndicatorType type,
+                                      const SamtraderIndicatorParams *params,
+                                      const SamrenaVector *ohlcv);
+
+#endif /* SAMTRADER_DOMAIN_INDICATOR_STATE_H */
@@ -17,6 +17,10 @@
 #ifndef SAMTRADER_DOMAIN_METRICS_H
 #define SAMTRADER_DOMAIN_METRICS_H
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+
 #include <samrena.h>
 #include <samvector.h>
 
@@ -30,11 +34,11 @@
  */
 typedef struct {
   double total_return;           /**< (final - initial) / initial */
-  double annualized_return;      /**< (1 + total_return)^(252/trading_days) - 1 */
-  double sharpe_ratio;           /**< mean(daily_returns) / stddev(daily_returns) * sqrt(252) */
-  double sortino_ratio;          /**< mean(daily_returns) / downside_dev * sqrt(252) */
+  double annualized_return;      /**< (1 + total_return)^(bars_per_year/bars) - 1 */
+  double sharpe_ratio;           /**< mean(bar_returns) / stddev * sqrt(bars_per_year) */
+  double sortino_ratio;          /**< mean(bar_returns) / downside_dev * sqrt(bars_per_year) */
   double max_drawdown;           /**< Largest peak-to-trough decline (fraction) */
-  double max_drawdown_duration;  /**< Days of longest drawdown period */
+  double max_drawdown_duration;  /**< Trading days of longest drawdown period */
   double win_rate;               /**< winning_trades / total_trades */
   double profit_factor;          /**< sum(winning_pnl) / abs(sum(losing_pnl)) */
   int total_trades;              /**< Total number of closed trades */
@@ -47,11 +51,51 @@ typedef struct {
   double average_trade_duration; /**< Mean days between entry and exit */
 } SamtraderMetrics;
 
+/**
+ * @brief Running metrics state, fed one equity point or closed trade at a time.
+ *
+ * Keeps Welford mean/variance of the per-bar returns, the downside sum
+ * against the per-bar risk-free rate, the running peak and drawdown span,
+ * and trade totals, so no returns buffer is needed and finishing is O(1).
+ * Equity points must arrive in date order; trades may arrive in any order
+ * relative to them. Fields are internal; use the functions below.
+ */
+typedef struct SamtraderMetricsAccumulator {
+  double bars_per_year;     /**< Annualisation factor given at init */
+  double risk_free_per_bar; /**< Annual risk-free rate / bars_per_year */
+  size_t points;            /**< Equity points fed so far */
+  double first_equity;      /**< Equity of the first point */
+  double last_equity;       /**< Equity of the latest point */
+  double return_mean;       /**< Running mean of per-bar returns */
+  double return_m2;         /**< Welford sum of squared deviations from return_mean */
+  double downside_sq;       /**< Sum of squared returns below risk_free_per_bar */
+  double peak;              /**< Highest equity so far */
+  double max_drawdown;      /**< Largest peak-to-trough decline so far (fraction) */
+  size_t drawdown_start;    /**< Point index of the last peak or current drawdown start */
+  size_t max_drawdown_bars; /**< Longest finished drawdown, in points */
+  bool in_drawdown;         /**< Whether equity is below peak */
+  int total_trades;         /**< Trades fed so far */
+  int winning_trades;       /**< Trades with positive PnL */
+  int losing_trades;        /**< Trades with non-positive PnL */
+  double sum_wins;          /**< Sum of winning PnL */
+  double sum_losses;        /**< Sum of losing PnL */
+  double total_duration;    /**< Sum of trade durations in days */
+  double largest_win;       /**< Largest single trade PnL */
+  double largest_loss;      /**< Most negative single trade PnL */
+} SamtraderMetricsAccumulator;
+
 /**
  * @brief Calculate performance metrics from backtest results.
  *
  * Computes all performance statistics from closed trade history
- * and equity curve data. All memory is allocated from the provided arena.
+ * and equity curve data in one pass over each, through a
+ * SamtraderMetricsAccumulator. All memory is allocated from the provided
+ * arena.
+ *
+ * Ratios are annualised from the equity curve's own bar frequency:
+ * bars_per_year is 252 trading days times the bars per trading day,
+ * estimated as the number of points over the distinct (UTC) days they
+ * fall on. Daily curves therefore use 252.
  *
  * @param arena Memory arena for allocation
  * @param closed_trades Vector of SamtraderClosedTrade
@@ -63,6 +107,71 @@ SamtraderMetrics *samtrader_metrics_calculate(Samrena *arena, const SamrenaVecto
                                               const SamrenaVector *equity_curve,
                                               double risk_free_rate);
 
+/**
+ * @brief Bars per year used to annualise ratios for an equity curve.
+ *
+ * 252 trading days times the bars per trading day, estimated as in
+ * samtrader_metrics_calculate().
+ *
+ * @param equity_curve Vector of SamtraderEquityPoint
+ * @return Bars per year (252 for daily or empty curves)
+ */
+double samtrader_metrics_bars_per_year(const SamrenaVector *equity_curve);
+
+/**
+ * @brief Bars per year for a run over the given dates.
+ *
+ * The same estimate as samtrader_metrics_bars_per_year(), taken from the
+ * dates the equity points will carry (e.g. a timeline's) before the run.
+ *
+ * @param dates Ascending bar dates
+ * @param count Number of dates
+ * @return Bars per year (252 for daily or empty date lists)
+ */
+double samtrader_metrics_bars_per_year_of_dates(const time_t *dates, size_t count);
+
+/**
+ * @brief Start an empty accumulator.
+ *
+ * bars_per_year fixes the annualisation and the per-bar risk-free rate up
+ * front, which lets the downside deviation be accumulated exactly.
+ *
+ * @param acc Accumulator to initialise
+ * @param bars_per_year Bars per year of the equity points to come (> 0)
+ * @param risk_free_rate Annual risk-free rate (e.g. 0.05 for 5%)
+ */
+void samtrader_metrics_accumulator_init(SamtraderMetricsAccumulator *acc, double bars_per_year,
+                                        double risk_free_rate);
+
+/**
+ * @brief Feed the next equity point.
+ *
+ * @param acc Accumulator
+ * @param equity Portfolio equity at the point's date
+ */
+void samtrader_metrics_accumulator_add_equity(SamtraderMetricsAccumulator *acc, double equity);
+
+/**
+ * @brief Feed a closed trade.
+ *
+ * @param acc Accumulator
+ * @param trade Closed trade
+ */
+void samtrader_metrics_accumulator_add_trade(SamtraderMetricsAccumulator *acc,
+                                             const SamtraderClosedTrade *trade);
+
+/**
+ * @brief Compute the metrics for everything fed so far.
+ *
+ * Gives the same result as samtrader_metrics_calculate() over the same
+ * trades and equity points. The accumulator is left unchanged.
+ *
+ * @param acc Accumulator
+ * @param out Receives the metrics
+ */
+void samtrader_metrics_accumulator_finish(const SamtraderMetricsAccumulator *acc,
+                                          SamtraderMetrics *out);
+
 /**
  * @brief Print metrics to stdout for debugging.
  *
@@ -74,8 +183,11 @@ void samtrader_metrics_print(const SamtraderMetrics *metrics);
  * @brief Compute per-code trade statistics from closed trades.
  *
  * Iterates all closed trades once and accumulates statistics for each
- * code in the universe. Returns an arena-allocated array of code_count
- * SamtraderCodeResult structs (zero-initialized, then populated).
+ * code in the universe. Trades recorded by a backtest carry the symbol id
+ * their code was interned under, which (codes being interned in universe
+ * order) indexes codes directly; other trades are matched by code string.
+ * Returns an arena-allocated array of code_count SamtraderCodeResult
+ * structs (zero-initialized, then populated).
  *
  * @param arena Memory arena for allocation
  * @param closed_trades Vector of SamtraderClosedTrade
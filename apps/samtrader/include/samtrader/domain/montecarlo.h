@@ -0,0 +1,121 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SAMTRADER_DOMAIN_MONTECARLO_H
+#define SAMTRADER_DOMAIN_MONTECARLO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <samrena.h>
+#include <samvector.h>
+
+#include "samtrader/domain/worker_pool.h"
+
+/** Number of percentile levels reported by a Monte Carlo run */
+#define SAMTRADER_MONTECARLO_LEVELS 7
+
+/**
+ * @brief How a backtest is resampled.
+ */
+typedef enum {
+  SAMTRADER_MONTECARLO_TRADES = 0, /**< Closed-trade PnLs drawn with replacement (default) */
+  SAMTRADER_MONTECARLO_RETURNS     /**< Circular block bootstrap of per-bar returns */
+} SamtraderMonteCarloMethod;
+
+/**
+ * @brief Monte Carlo robustness settings.
+ */
+typedef struct {
+  SamtraderMonteCarloMethod method; /**< Resampling method */
+  size_t samples;                   /**< Number of resampled paths (> 0) */
+  size_t block_length;              /**< Bars per bootstrap block (0 = cube root of the bars) */
+  uint64_t seed;                    /**< RNG seed; equal seeds give equal results */
+  double risk_free_rate;            /**< Annual risk-free rate used for the Sharpe ratio */
+} SamtraderMonteCarloConfig;
+
+/**
+ * @brief Percentiles of the resampled statistics.
+ *
+ * Entry i of each statistic array is its levels[i]-th percentile across
+ * all samples (linear interpolation between order statistics).
+ */
+typedef struct {
+  SamtraderMonteCarloMethod method;                 /**< Resampling method used */
+  size_t samples;                                   /**< Number of resampled paths */
+  size_t sample_length;                             /**< Trades or bars per path */
+  size_t block_length;                              /**< Effective block length (returns) */
+  double levels[SAMTRADER_MONTECARLO_LEVELS];       /**< Percentile levels, ascending */
+  double total_return[SAMTRADER_MONTECARLO_LEVELS]; /**< Total return percentiles */
+  double sharpe_ratio[SAMTRADER_MONTECARLO_LEVELS]; /**< Annualised Sharpe percentiles */
+  double max_drawdown[SAMTRADER_MONTECARLO_LEVELS]; /**< Max drawdown percentiles */
+  double probability_of_loss;                       /**< Fraction of paths ending below start */
+} SamtraderMonteCarloResult;
+
+/**
+ * @brief Parse a resampling method name ("trades" or "returns").
+ *
+ * @param name Method name
+ * @param out Receives the method on success
+ * @return true if name is a known method, false otherwise
+ */
+bool samtrader_montecarlo_method_parse(const char *name, SamtraderMonteCarloMethod *out);
+
+/**
+ * @brief Get the config name of a resampling method.
+ *
+ * @param method Resampling method
+ * @return Static method name
+ */
+const char *samtrader_montecarlo_method_name(SamtraderMonteCarloMethod method);
+
+/**
+ * @brief Resample a backtest and collect percentiles of its statistics.
+ *
+ * The trades method rebuilds each path from the starting equity by adding
+ * closed-trade PnLs drawn with replacement, annualising by the backtest's
+ * trades per year. The returns method compounds per-bar equity returns
+ * drawn in circular blocks, annualising as samtrader_metrics_calculate()
+ * does. A path whose equity reaches zero stops there with a 100% drawdown.
+ *
+ * Samples are split into fixed-size chunks run across the pool; chunk k
+ * draws from the seed's xoshiro stream jumped k times, so results depend
+ * only on the config, not on the worker count. Each sample is reduced to
+ * its statistics in one streaming pass without allocating. Worker arenas
+ * are only used inside scratch frames, so the pool may hold live data.
+ *
+ * @param arena Memory arena for the result
+ * @param pool Worker pool to run the samples on
+ * @param config Monte Carlo settings
+ * @param closed_trades Vector of SamtraderClosedTrade from the backtest
+ * @param equity_curve Vector of SamtraderEquityPoint from the backtest
+ * @return Pointer to the result, or NULL on invalid input (no trades for
+ *         the trades method, fewer than two equity points) or failure
+ */
+SamtraderMonteCarloResult *samtrader_montecarlo_run(Samrena *arena, SamtraderWorkerPool *pool,
+                                                    const SamtraderMonteCarloConfig *config,
+                                                    const SamrenaVector *closed_trades,
+                                                    const SamrenaVector *equity_curve);
+
+/**
+ * @brief Print a Monte Carlo percentile table to stdout.
+ *
+ * @param result Monte Carlo result
+ */
+void samtrader_montecarlo_print(const SamtraderMonteCarloResult *result);
+
+#endif /* SAMTRADER_DOMAIN_MONTECARLO_H */
@@ -17,6 +17,7 @@
 #ifndef SAMTRADER_DOMAIN_OHLCV_H
 #define SAMTRADER_DOMAIN_OHLCV_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <time.h>
 
@@ -26,13 +27,13 @@
 /**
  * @brief OHLCV (Open, High, Low, Close, Volume) price data structure.
  *
- * Represents a single daily price bar for a financial instrument.
+ * Represents a single price bar for a financial instrument.
  * All strings are arena-allocated and owned by the arena.
  */
 typedef struct {
   const char *code;     /**< Stock symbol (e.g., "AAPL", "BHP") */
   const char *exchange; /**< Exchange identifier ("US", "AU") */
-  time_t date;          /**< Unix timestamp (daily resolution) */
+  time_t date;          /**< Bar start time, UTC; midnight for daily bars */
   double open;          /**< Opening price */
   double high;          /**< Highest price during the period */
   double low;           /**< Lowest price during the period */
@@ -40,6 +41,30 @@ typedef struct {
   int64_t volume;       /**< Trading volume */
 } SamtraderOhlcv;
 
+/** Byte alignment of each SamtraderBarColumns array (one cache line). */
+#define SAMTRADER_BAR_COLUMN_ALIGNMENT 64
+
+/**
+ * @brief Struct-of-arrays OHLCV store for a single instrument.
+ *
+ * Holds the same data as a vector of SamtraderOhlcv, but as one contiguous
+ * array per field so that kernels touching a single field (e.g. close)
+ * stream through memory. Code and exchange are stored once rather than per
+ * bar. Each array is aligned to SAMTRADER_BAR_COLUMN_ALIGNMENT bytes.
+ * All memory is arena-allocated.
+ */
+typedef struct {
+  const char *code;     /**< Stock symbol (arena-allocated, may be NULL) */
+  const char *exchange; /**< Exchange identifier (arena-allocated, may be NULL) */
+  size_t count;         /**< Number of bars */
+  time_t *date;         /**< Unix timestamps, ascending */
+  double *open;         /**< Opening prices */
+  double *high;         /**< Highest prices */
+  double *low;          /**< Lowest prices */
+  double *close;        /**< Closing prices */
+  int64_t *volume;      /**< Trading volumes */
+} SamtraderBarColumns;
+
 /**
  * @brief Create an OHLCV record with arena-allocated strings.
  *
@@ -86,4 +111,52 @@ double samtrader_ohlcv_typical_price(const SamtraderOhlcv *ohlcv);
  */
 double samtrader_ohlcv_true_range(const SamtraderOhlcv *ohlcv, double prev_close);
 
+/**
+ * @brief Allocate an uninitialised columnar store for count bars.
+ *
+ * @param arena Memory arena for allocation
+ * @param code Stock symbol (copied to arena, may be NULL)
+ * @param exchange Exchange identifier (copied to arena, may be NULL)
+ * @param count Number of bars (arrays are NULL when 0)
+ * @return Pointer to the columnar store, or NULL on failure
+ */
+SamtraderBarColumns *samtrader_bar_columns_create(Samrena *arena, const char *code,
+                                                  const char *exchange, size_t count);
+
+/**
+ * @brief Build a columnar store from a vector of SamtraderOhlcv records.
+ *
+ * Code and exchange are taken from the first bar.
+ *
+ * @param arena Memory arena for allocation
+ * @param ohlcv Vector of SamtraderOhlcv records
+ * @return Pointer to the columnar store, or NULL on failure
+ */
+SamtraderBarColumns *samtrader_bar_columns_from_ohlcv(Samrena *arena, const SamrenaVector *ohlcv);
+
+/**
+ * @brief Build a vector of SamtraderOhlcv records from a columnar store.
+ *
+ * For callers that want row-oriented bars on demand; every record
+ * references the store's code and exchange strings.
+ *
+ * @param arena Memory arena for allocation
+ * @param bars Columnar store
+ * @return Vector of SamtraderOhlcv, or NULL on failure
+ */
+SamrenaVector *samtrader_ohlcv_from_bar_columns(Samrena *arena, const SamtraderBarColumns *bars);
+
+/**
+ * @brief Hash the contents of a columnar store.
+ *
+ * Mixes the bar count and every date, price and volume word, so any
+ * change to the bars (a revised close, an extra day) changes the hash
+ * with overwhelming probability. Code and exchange are not included.
+ * Stable across processes on the same platform.
+ *
+ * @param bars Columnar store to hash (NULL hashes as empty)
+ * @return 64-bit content hash
+ */
+uint64_t samtrader_bar_columns_hash(const SamtraderBarColumns *bars);
+
 #endif /* SAMTRADER_DOMAIN_OHLCV_H */
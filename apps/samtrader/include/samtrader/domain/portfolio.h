@@ -26,22 +26,24 @@
 #include <samvector.h>
 
 #include "samtrader/domain/position.h"
+#include "samtrader/domain/symbol_table.h"
 
 /**
  * @brief A closed (realized) trade record.
  *
- * Created when a position is fully or partially closed.
- * All strings are arena-allocated and owned by the arena.
+ * Created when a position is fully or partially closed. Code and exchange
+ * point at the portfolio's interned strings.
  */
 typedef struct {
-  const char *code;     /**< Stock symbol */
-  const char *exchange; /**< Exchange identifier */
-  int64_t quantity;     /**< Trade quantity (positive = long, negative = short) */
-  double entry_price;   /**< Entry price */
-  double exit_price;    /**< Exit price */
-  time_t entry_date;    /**< Date position was opened */
-  time_t exit_date;     /**< Date position was closed */
-  double pnl;           /**< Realized profit/loss */
+  const char *code;         /**< Stock symbol */
+  const char *exchange;     /**< Exchange identifier */
+  int64_t quantity;         /**< Trade quantity (positive = long, negative = short) */
+  double entry_price;       /**< Entry price */
+  double exit_price;        /**< Exit price */
+  time_t entry_date;        /**< Date position was opened */
+  time_t exit_date;         /**< Date position was closed */
+  double pnl;               /**< Realized profit/loss */
+  SamtraderSymbolId symbol; /**< Code's id in the recording portfolio */
 } SamtraderClosedTrade;
 
 /**
@@ -59,15 +61,54 @@ typedef struct {
  *
  * Holds cash balance, open positions, closed trade history,
  * and the equity curve. All data is arena-allocated.
+ *
+ * Every code the portfolio sees is interned once in symbols, and positions
+ * live in per-symbol storage that is reused from trade to trade, so opening
+ * and closing positions allocates nothing after a code's first trade. The
+ * string-keyed functions resolve the code to its id; hot loops can intern
+ * their codes up front and use the id-keyed functions directly.
+ *
+ * Alongside open_symbols the portfolio keeps each open position's stop loss
+ * and take profit as a pair of exit levels (plus which of them is the stop)
+ * in contiguous arrays, so trigger checks are a straight comparison pass
+ * without touching the positions. The levels are captured when a position
+ * is added.
  */
 typedef struct {
-  double cash;                  /**< Available cash balance */
-  double initial_capital;       /**< Starting capital */
-  SamHashMap *positions;        /**< Open positions keyed by code (SamtraderPosition*) */
-  SamrenaVector *closed_trades; /**< Vector of SamtraderClosedTrade */
-  SamrenaVector *equity_curve;  /**< Vector of SamtraderEquityPoint */
+  double cash;                     /**< Available cash balance */
+  double initial_capital;          /**< Starting capital */
+  Samrena *arena;                  /**< Arena for interned symbols and position storage */
+  SamtraderSymbolTable *symbols;   /**< Codes seen by this portfolio (position keys) */
+  SamtraderSymbolTable *exchanges; /**< Exchanges of those positions and trades */
+  SamrenaVector *slots;            /**< Position storage by symbol id (internal) */
+  SamrenaVector *open_symbols;     /**< SamtraderSymbolId of each open position */
+  SamrenaVector *exit_below;       /**< Per open position: exits at price <= this (-INF: never) */
+  SamrenaVector *exit_above;       /**< Per open position: exits at price >= this (INF: never) */
+  SamrenaVector *exit_stop;        /**< Per open position: the stop loss level (+-INF: none) */
+  SamrenaVector *closed_trades;    /**< Vector of SamtraderClosedTrade */
+  SamrenaVector *equity_curve;     /**< Vector of SamtraderEquityPoint */
 } SamtraderPortfolio;
 
+/**
+ * @brief Dense current prices indexed by symbol id.
+ *
+ * An alternative to a per-step code -> double* hash map: ids come from a
+ * symbol table (normally the portfolio's) and each step only rewrites the
+ * prices array. A NAN price means the code has no price at the current
+ * step.
+ *
+ * Tables created with samtrader_price_table_create_ohlc() also carry the
+ * current bar's open, high and low for intrabar trigger checks.
+ */
+typedef struct {
+  const SamtraderSymbolTable *symbols; /**< Table the ids belong to */
+  double *prices;                      /**< Current price by symbol id (NAN = no price) */
+  double *open;                        /**< Current bar open by symbol id, or NULL */
+  double *high;                        /**< Current bar high by symbol id, or NULL */
+  double *low;                         /**< Current bar low by symbol id, or NULL */
+  size_t count;                        /**< Number of entries (highest id + 1) */
+} SamtraderPriceTable;
+
 /**
  * @brief Create a new portfolio with initial capital.
  *
@@ -80,12 +121,12 @@ SamtraderPortfolio *samtrader_portfolio_create(Samrena *arena, double initial_ca
 /**
  * @brief Add a position to the portfolio.
  *
- * The position is keyed by its code field. If a position with the same
- * code already exists, it will be replaced.
+ * The position is keyed by its code field, which is interned. If a
+ * position with the same code already exists, it will be replaced.
  *
  * @param portfolio Target portfolio
- * @param arena Memory arena for string allocation
- * @param position Position to add (will be copied into the hashmap)
+ * @param arena Memory arena (storage comes from the portfolio's arena)
+ * @param position Position to add (copied; code and exchange are interned)
  * @return true on success, false on failure
  */
 bool samtrader_portfolio_add_position(SamtraderPortfolio *portfolio, Samrena *arena,
@@ -130,8 +171,12 @@ size_t samtrader_portfolio_position_count(const SamtraderPortfolio *portfolio);
 /**
  * @brief Record a closed trade in the portfolio history.
  *
+ * Code and exchange are interned rather than copied, and the symbol field
+ * is set to the code's id; a trade that already carries this portfolio's
+ * symbol id skips the lookup.
+ *
  * @param portfolio Target portfolio
- * @param arena Memory arena for string allocation
+ * @param arena Memory arena (storage comes from the portfolio's arena)
  * @param trade Closed trade to record (will be copied)
  * @return true on success, false on failure
  */
@@ -160,4 +205,134 @@ bool samtrader_portfolio_record_equity(SamtraderPortfolio *portfolio, Samrena *a
 double samtrader_portfolio_total_equity(const SamtraderPortfolio *portfolio,
                                         const SamHashMap *price_map);
 
+/**
+ * @brief Intern a code in the portfolio without opening a position.
+ *
+ * Codes interned in order before any other use get ids 1, 2, ... in that
+ * order.
+ *
+ * @param portfolio Target portfolio
+ * @param code Stock symbol
+ * @return The code's id, or SAMTRADER_SYMBOL_NONE on failure
+ */
+SamtraderSymbolId samtrader_portfolio_intern(SamtraderPortfolio *portfolio, const char *code);
+
+/**
+ * @brief Get the open position for a symbol id.
+ *
+ * @param portfolio Portfolio to search
+ * @param symbol Id from samtrader_portfolio_intern()
+ * @return Pointer to the position, or NULL if none is open
+ */
+SamtraderPosition *samtrader_portfolio_position_at(const SamtraderPortfolio *portfolio,
+                                                   SamtraderSymbolId symbol);
+
+/**
+ * @brief Close (remove) the open position for a symbol id.
+ *
+ * @param portfolio Portfolio to modify
+ * @param symbol Id from samtrader_portfolio_intern()
+ * @return true if a position was removed, false if none was open
+ */
+bool samtrader_portfolio_close_position(SamtraderPortfolio *portfolio, SamtraderSymbolId symbol);
+
+/**
+ * @brief Find the open positions whose stop loss or take profit fires.
+ *
+ * Compares each open position's price against its exit levels. A NAN
+ * price never fires, so unpriced positions can be passed as NAN.
+ *
+ * @param portfolio Portfolio to check
+ * @param open_prices Current price of each open position, in open_symbols order
+ * @param hits Receives the open_symbols indices that fire, in ascending order;
+ *             must hold samtrader_portfolio_position_count() entries
+ * @return Number of indices written to hits
+ */
+size_t samtrader_portfolio_find_triggers(const SamtraderPortfolio *portfolio,
+                                         const double *open_prices, size_t *hits);
+
+/**
+ * @brief Find the open positions whose exit levels trade within a bar.
+ *
+ * Walks each open position's bar as open, then high and low, then close,
+ * and assumes the worst order between the extremes:
+ * - a bar opening at or through a level gaps, filling at the open;
+ * - otherwise a level the high or low reaches fills at the level;
+ * - if the high and low reach both levels, the stop loss fills.
+ * A NAN price never fires.
+ *
+ * @param portfolio Portfolio to check
+ * @param open Bar open of each open position, in open_symbols order
+ * @param high Bar high of each open position, in open_symbols order
+ * @param low Bar low of each open position, in open_symbols order
+ * @param hits Receives the open_symbols indices that fire, in ascending order;
+ *             must hold samtrader_portfolio_position_count() entries
+ * @param fills Receives the fill price of each hit (same capacity as hits)
+ * @return Number of entries written to hits and fills
+ */
+size_t samtrader_portfolio_find_triggers_ohlc(const SamtraderPortfolio *portfolio,
+                                              const double *open, const double *high,
+                                              const double *low, size_t *hits, double *fills);
+
+/**
+ * @brief Create a price table over a symbol table's current ids, every price unset.
+ *
+ * Callers write prices[id] directly. Symbols interned after creation have
+ * no entry and read as unpriced.
+ *
+ * @param arena Memory arena for allocation
+ * @param symbols Symbol table the ids come from
+ * @return Pointer to the price table, or NULL on failure
+ */
+SamtraderPriceTable *samtrader_price_table_create(Samrena *arena,
+                                                  const SamtraderSymbolTable *symbols);
+
+/**
+ * @brief Create a price table that also holds each bar's open, high and low.
+ *
+ * Same as samtrader_price_table_create(), with the open, high and low
+ * arrays allocated and unset as well.
+ *
+ * @param arena Memory arena for allocation
+ * @param symbols Symbol table the ids come from
+ * @return Pointer to the price table, or NULL on failure
+ */
+SamtraderPriceTable *samtrader_price_table_create_ohlc(Samrena *arena,
+                                                       const SamtraderSymbolTable *symbols);
+
+/**
+ * @brief Look up a symbol id's current price.
+ *
+ * @param table Price table
+ * @param symbol Symbol id
+ * @param out Receives the price when one is set
+ * @return true if the symbol has a price, false otherwise
+ */
+bool samtrader_price_table_get_symbol(const SamtraderPriceTable *table, SamtraderSymbolId symbol,
+                                      double *out);
+
+/**
+ * @brief Look up a code's current price.
+ *
+ * @param table Price table
+ * @param code Stock symbol
+ * @param out Receives the price when one is set
+ * @return true if the code has a price, false otherwise
+ */
+bool samtrader_price_table_get(const SamtraderPriceTable *table, const char *code, double *out);
+
+/**
+ * @brief Calculate total portfolio equity from a price table.
+ *
+ * Same as samtrader_portfolio_total_equity(), with positions whose code
+ * has no price contributing nothing. The table must be indexed by the
+ * portfolio's own symbol ids.
+ *
+ * @param portfolio Portfolio to evaluate
+ * @param prices Current prices over portfolio->symbols
+ * @return Total equity, or -1.0 on error (including a foreign table)
+ */
+double samtrader_portfolio_total_equity_at(const SamtraderPortfolio *portfolio,
+                                           const SamtraderPriceTable *prices);
+
 #endif /* SAMTRADER_DOMAIN_PORTFOLIO_H */
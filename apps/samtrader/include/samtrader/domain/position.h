@@ -23,6 +23,8 @@
 
 #include <samrena.h>
 
+#include "samtrader/domain/symbol_table.h"
+
 /**
  * @brief Represents an open position in the portfolio.
  *
@@ -31,13 +33,14 @@
  * All strings are arena-allocated and owned by the arena.
  */
 typedef struct {
-  const char *code;     /**< Stock symbol (e.g., "AAPL", "BHP") */
-  const char *exchange; /**< Exchange identifier ("US", "AU") */
-  int64_t quantity;     /**< Position size (positive = long, negative = short) */
-  double entry_price;   /**< Average entry price */
-  time_t entry_date;    /**< Date position was opened */
-  double stop_loss;     /**< Stop loss price (0 if not set) */
-  double take_profit;   /**< Take profit price (0 if not set) */
+  const char *code;         /**< Stock symbol (e.g., "AAPL", "BHP") */
+  const char *exchange;     /**< Exchange identifier ("US", "AU") */
+  int64_t quantity;         /**< Position size (positive = long, negative = short) */
+  double entry_price;       /**< Average entry price */
+  time_t entry_date;        /**< Date position was opened */
+  double stop_loss;         /**< Stop loss price (0 if not set) */
+  double take_profit;       /**< Take profit price (0 if not set) */
+  SamtraderSymbolId symbol; /**< Code's id in the holding portfolio (NONE if not held) */
 } SamtraderPosition;
 
 /**
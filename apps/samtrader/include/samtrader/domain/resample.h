@@ -0,0 +1,132 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SAMTRADER_DOMAIN_RESAMPLE_H
+#define SAMTRADER_DOMAIN_RESAMPLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <samrena.h>
+#include <samvector.h>
+
+#include "samtrader/domain/ohlcv.h"
+
+/** Seconds in one daily bar interval. */
+#define SAMTRADER_SECONDS_PER_DAY 86400
+
+/**
+ * @brief Streaming aggregation of finer bars into coarser ones.
+ *
+ * Bars are grouped into buckets of period seconds aligned to the Unix
+ * epoch (UTC), so "1h" buckets start on the hour and "1d" buckets at UTC
+ * midnight. Each output bar is stamped with its bucket's start and takes
+ * the first open, the highest high, the lowest low, the last close and
+ * the summed volume of the bars in the bucket. Empty buckets produce no
+ * bar. The state is a plain value, so it can live on the stack and only
+ * the emitted bars are ever stored.
+ *
+ * Usage:
+ * @code
+ * SamtraderResampler hourly;
+ * samtrader_resampler_init(&hourly, 3600);
+ *
+ * SamtraderOhlcv bar;
+ * for (each minute bar m, in date order)
+ *   if (samtrader_resampler_push(&hourly, &m, &bar))
+ *     use(&bar); // the previous hour is complete
+ * if (samtrader_resampler_flush(&hourly, &bar))
+ *   use(&bar);   // the last, possibly partial, hour
+ * @endcode
+ */
+typedef struct {
+  int64_t period;     /**< Bucket width in seconds */
+  bool pending;       /**< Whether bar holds a bucket in progress */
+  SamtraderOhlcv bar; /**< Aggregate of the bucket in progress */
+} SamtraderResampler;
+
+/**
+ * @brief Parse a bar interval such as "1m", "5m", "1h" or "1d".
+ *
+ * Accepts a positive count followed by m (minutes), h (hours) or d (days).
+ *
+ * @param text Interval text
+ * @param seconds Receives the interval in seconds
+ * @return true on success, false if text is not a valid interval
+ */
+bool samtrader_bar_interval_parse(const char *text, int64_t *seconds);
+
+/**
+ * @brief Start an empty resampler.
+ *
+ * @param resampler State to initialise
+ * @param period Bucket width in seconds (must be positive)
+ */
+void samtrader_resampler_init(SamtraderResampler *resampler, int64_t period);
+
+/**
+ * @brief Feed the next finer bar.
+ *
+ * Bars must arrive in ascending date order.
+ *
+ * @param resampler Resampler state
+ * @param bar The next bar
+ * @param out Receives the completed bucket when bar starts a new one
+ * @return true if out was written, false otherwise
+ */
+bool samtrader_resampler_push(SamtraderResampler *resampler, const SamtraderOhlcv *bar,
+                              SamtraderOhlcv *out);
+
+/**
+ * @brief Emit the bucket in progress, leaving the resampler empty.
+ *
+ * @param resampler Resampler state
+ * @param out Receives the bucket in progress, if any
+ * @return true if out was written, false if no bucket was in progress
+ */
+bool samtrader_resampler_flush(SamtraderResampler *resampler, SamtraderOhlcv *out);
+
+/**
+ * @brief Resample a vector of bars into coarser bars.
+ *
+ * Streams ohlcv through a SamtraderResampler in one pass, writing only
+ * the output vector. Bars already at least as coarse as period and
+ * aligned to it come out unchanged.
+ *
+ * @param arena Memory arena for the output vector
+ * @param ohlcv Vector of SamtraderOhlcv in ascending date order
+ * @param period Bucket width in seconds (must be positive)
+ * @return New vector of SamtraderOhlcv, or NULL on error
+ */
+SamrenaVector *samtrader_ohlcv_resample(Samrena *arena, const SamrenaVector *ohlcv,
+                                        int64_t period);
+
+/**
+ * @brief Resample a columnar store into coarser bars.
+ *
+ * The columnar counterpart of samtrader_ohlcv_resample(): counts the
+ * buckets first so every output column is allocated at its final size.
+ * Code and exchange are carried over.
+ *
+ * @param arena Memory arena for the output store
+ * @param bars Columnar bars in ascending date order
+ * @param period Bucket width in seconds (must be positive)
+ * @return New columnar store, or NULL on error
+ */
+SamtraderBarColumns *samtrader_bar_columns_resample(Samrena *arena, const SamtraderBarColumns *bars,
+                                                    int64_t period);
+
+#endif /* SAMTRADER_DOMAIN_RESAMPLE_H */
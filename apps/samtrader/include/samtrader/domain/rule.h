@@ -356,6 +356,18 @@ bool samtrader_rule_evaluate(const SamtraderRule *rule, const SamrenaVector *ohl
  */
 int samtrader_operand_indicator_key(char *buf, size_t buf_size, const SamtraderOperand *operand);
 
+/**
+ * @brief Get the series column an indicator operand reads.
+ *
+ * Selects the band of a Bollinger operand, the level of a Pivot operand,
+ * the line of MACD, %K of Stochastic and the value of every other type.
+ *
+ * @param operand The indicator operand
+ * @return Column index into SamtraderIndicatorSeries.columns, or -1 for a
+ *         non-indicator operand or an unknown band/level selector
+ */
+int samtrader_operand_indicator_column(const SamtraderOperand *operand);
+
 /*============================================================================
  * Rule Parsing API
  *============================================================================*/
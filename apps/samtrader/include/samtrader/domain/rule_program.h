@@ -0,0 +1,164 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SAMTRADER_DOMAIN_RULE_PROGRAM_H
+#define SAMTRADER_DOMAIN_RULE_PROGRAM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <samrena.h>
+
+#include "samtrader/domain/code_data.h"
+#include "samtrader/domain/rule.h"
+#include "samtrader/domain/strategy.h"
+
+/**
+ * @brief A rule tree compiled against one code's data.
+ *
+ * Compilation resolves every operand once to a typed slot (a constant, a
+ * price field of the OHLCV rows, or a field of a pre-computed indicator
+ * series) and flattens the rule tree into a contiguous instruction array.
+ * Evaluating a program performs no string formatting or hashing.
+ *
+ * Identical subrules and operands are compiled once, so the instruction
+ * array is a DAG rather than a tree: CROSS_ABOVE(SMA(20), SMA(50)) used
+ * twice is one instruction with two parents.
+ *
+ * A program is bound to the OHLCV vector and indicator series it was
+ * compiled against; it must be recompiled if either is replaced.
+ * All memory is arena-allocated.
+ */
+typedef struct SamtraderRuleProgram SamtraderRuleProgram;
+
+/**
+ * @brief A rule's result at every bar of a code, packed one bit per bar.
+ *
+ * Bit (index % 64) of bits[index / 64] holds the rule at bar index. Bars at
+ * or past bar_count read as false.
+ */
+typedef struct {
+  const uint64_t *bits; /**< Packed results, (bar_count + 63) / 64 words */
+  size_t bar_count;     /**< Number of bars covered */
+} SamtraderRuleSignals;
+
+/**
+ * @brief Compiled entry/exit programs for one code.
+ *
+ * The programs share one set of instruction and operand tables, each
+ * rooted at its own rule, so a subrule repeated across entry and exit
+ * rules is compiled and evaluated once. Programs for rules that are NULL
+ * in the strategy are left NULL, and their signals are empty (false at
+ * every bar).
+ */
+typedef struct {
+  SamtraderRuleProgram *entry_long;         /**< Compiled entry_long rule */
+  SamtraderRuleProgram *exit_long;          /**< Compiled exit_long rule */
+  SamtraderRuleProgram *entry_short;        /**< Compiled entry_short rule (NULL if not set) */
+  SamtraderRuleProgram *exit_short;         /**< Compiled exit_short rule (NULL if not set) */
+  SamtraderRuleSignals entry_long_signals;  /**< entry_long at every bar */
+  SamtraderRuleSignals exit_long_signals;   /**< exit_long at every bar */
+  SamtraderRuleSignals entry_short_signals; /**< entry_short at every bar */
+  SamtraderRuleSignals exit_short_signals;  /**< exit_short at every bar */
+} SamtraderStrategyProgram;
+
+/**
+ * @brief Compile a rule tree against a code's OHLCV data and indicators.
+ *
+ * Indicator operands are looked up in code_data->indicators once, at
+ * compile time. Operands whose series is missing compile to a slot that
+ * never resolves, matching samtrader_rule_evaluate().
+ *
+ * @param arena Memory arena for allocation
+ * @param rule The rule tree to compile (may be NULL; evaluates false)
+ * @param code_data Code data with OHLCV bars and computed indicators
+ * @return Pointer to the compiled program, or NULL on allocation failure
+ */
+SamtraderRuleProgram *samtrader_rule_compile(Samrena *arena, const SamtraderRule *rule,
+                                             const SamtraderCodeData *code_data);
+
+/**
+ * @brief Evaluate a compiled rule program at a specific bar index.
+ *
+ * Produces exactly the same result as samtrader_rule_evaluate() on the
+ * source rule with the code's OHLCV vector and indicator map.
+ *
+ * @param program The compiled program
+ * @param index Bar index to evaluate at (0 = oldest bar)
+ * @return true if the rule condition is satisfied, false otherwise
+ */
+bool samtrader_rule_program_evaluate(const SamtraderRuleProgram *program, size_t index);
+
+/**
+ * @brief Get the number of distinct instructions in a program's tables.
+ *
+ * Programs from samtrader_strategy_compile() share their tables, so each
+ * reports the size of the combined program.
+ *
+ * @param program The compiled program
+ * @return Instruction count, or 0 if program is NULL
+ */
+size_t samtrader_rule_program_size(const SamtraderRuleProgram *program);
+
+/**
+ * @brief Evaluate a compiled rule program at every bar of its code.
+ *
+ * Works a column at a time instead of a bar at a time: each comparison
+ * packs its results for all bars into a bitset in one pass over the
+ * operand columns, AND/OR/NOT combine whole words, and CONSECUTIVE and
+ * ANY_OF make one run-length pass whatever their lookback. Bit i equals
+ * samtrader_rule_program_evaluate(program, i).
+ *
+ * Only the bitset stays on the arena; intermediate columns live in a
+ * scratch frame.
+ *
+ * @param arena Memory arena for the bitset
+ * @param program The compiled program
+ * @param out Receives the signals
+ * @return 0 on success, -1 on error
+ */
+int samtrader_rule_program_signals(Samrena *arena, const SamtraderRuleProgram *program,
+                                   SamtraderRuleSignals *out);
+
+/**
+ * @brief Read one bar from a signal bitset.
+ *
+ * @param signals Signals from samtrader_rule_program_signals()
+ * @param index Bar index
+ * @return The rule's value at index, false past the last bar
+ */
+static inline bool samtrader_rule_signals_test(const SamtraderRuleSignals *signals, size_t index) {
+  return index < signals->bar_count && ((signals->bits[index / 64] >> (index % 64)) & 1u) != 0;
+}
+
+/**
+ * @brief Compile all of a strategy's rules against one code.
+ *
+ * The rules are compiled together, sharing common subrules, and
+ * evaluated over every bar in one pass that computes each shared node
+ * once, so the simulation loop only tests bits.
+ *
+ * @param arena Memory arena for allocation
+ * @param strategy Strategy whose rules are compiled
+ * @param code_data Code data with OHLCV bars and computed indicators
+ * @param out Output programs (rules absent from the strategy stay NULL)
+ * @return 0 on success, -1 on error
+ */
+int samtrader_strategy_compile(Samrena *arena, const SamtraderStrategy *strategy,
+                               const SamtraderCodeData *code_data, SamtraderStrategyProgram *out);
+
+#endif /* SAMTRADER_DOMAIN_RULE_PROGRAM_H */
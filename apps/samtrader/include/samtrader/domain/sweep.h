@@ -0,0 +1,155 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SAMTRADER_DOMAIN_SWEEP_H
+#define SAMTRADER_DOMAIN_SWEEP_H
+
+#include <stddef.h>
+
+#include <samrena.h>
+
+#include "samtrader/domain/backtest.h"
+#include "samtrader/domain/code_data.h"
+#include "samtrader/domain/metrics.h"
+#include "samtrader/domain/strategy.h"
+#include "samtrader/domain/worker_pool.h"
+
+/** @brief Maximum number of distinct parameters in a sweep grid. */
+#define SAMTRADER_SWEEP_MAX_PARAMS 16
+
+/** @brief Maximum number of variants a sweep grid may expand to. */
+#define SAMTRADER_SWEEP_MAX_VARIANTS 1000000
+
+/** @brief Maximum length of a sweep parameter name. */
+#define SAMTRADER_SWEEP_NAME_MAX 32
+
+/**
+ * @brief One swept parameter: an inclusive arithmetic range.
+ *
+ * Defined in rule text as ${name=start..end:step} (":step" defaults to 1)
+ * and referenced elsewhere as ${name}.
+ */
+typedef struct {
+  char name[SAMTRADER_SWEEP_NAME_MAX]; /**< Parameter name */
+  double start;                        /**< First value */
+  double end;                          /**< Last value (inclusive bound) */
+  double step;                         /**< Increment (> 0) */
+  size_t count;                        /**< Number of values in the range */
+} SamtraderSweepParam;
+
+/**
+ * @brief Cartesian grid of all parameters found in a strategy template.
+ *
+ * Variant indices enumerate the grid with the last-defined parameter
+ * varying fastest.
+ */
+typedef struct {
+  SamtraderSweepParam params[SAMTRADER_SWEEP_MAX_PARAMS]; /**< In definition order */
+  size_t param_count;                                     /**< Number of parameters */
+  size_t variant_count;                                   /**< Product of counts (1 if none) */
+} SamtraderSweepGrid;
+
+/**
+ * @brief Initialize an empty grid (a single variant with no parameters).
+ *
+ * @param grid Grid to initialize
+ */
+void samtrader_sweep_grid_init(SamtraderSweepGrid *grid);
+
+/**
+ * @brief Collect parameter definitions from one template string.
+ *
+ * May be called for several strings (e.g. every rule of a strategy); a
+ * parameter defined more than once must use the same range each time.
+ * References (${name}) are checked when the text is expanded.
+ *
+ * @param grid Grid to add parameters to
+ * @param text Template text (may be NULL)
+ * @return 0 on success, -1 on a malformed or conflicting definition or
+ *         when the grid would exceed its parameter or variant limits
+ */
+int samtrader_sweep_grid_scan(SamtraderSweepGrid *grid, const char *text);
+
+/**
+ * @brief Get a parameter's value at a position in its range.
+ *
+ * @param param The parameter
+ * @param i Position in [0, param->count)
+ * @return param->start + i * param->step
+ */
+double samtrader_sweep_param_value(const SamtraderSweepParam *param, size_t i);
+
+/**
+ * @brief Get every parameter's value for one variant.
+ *
+ * @param grid The grid
+ * @param variant Variant index in [0, grid->variant_count)
+ * @param values Output array of grid->param_count values
+ * @return 0 on success, -1 if the variant is out of range
+ */
+int samtrader_sweep_variant_values(const SamtraderSweepGrid *grid, size_t variant,
+                                   double *values);
+
+/**
+ * @brief Substitute one variant's values into a template string.
+ *
+ * Every ${...} placeholder is replaced by the parameter's value, so
+ * "SMA(${fast=5..50:5})" becomes "SMA(15)" for a variant with fast = 15.
+ *
+ * @param arena Memory arena for the result
+ * @param grid The grid the text was scanned into
+ * @param text Template text
+ * @param variant Variant index in [0, grid->variant_count)
+ * @return Arena-allocated expanded string, or NULL on error (unknown
+ *         parameter, unterminated placeholder, variant out of range)
+ */
+char *samtrader_sweep_expand(Samrena *arena, const SamtraderSweepGrid *grid, const char *text,
+                             size_t variant);
+
+/**
+ * @brief Shared inputs for running every variant of a sweep.
+ *
+ * The code data must already carry indicators for all strategies (see
+ * samtrader_code_data_compute_indicators_multi()). Nothing here is
+ * modified while the sweep runs.
+ */
+typedef struct {
+  const SamtraderStrategy *strategies;   /**< One strategy per variant */
+  size_t strategy_count;                 /**< Number of variants */
+  SamtraderCodeData *const *code_data;   /**< Loaded universe */
+  const SamtraderTimeline *timeline;     /**< Timeline aligned to code_data */
+  const SamtraderBacktestConfig *config; /**< Shared backtest configuration */
+  double risk_free_rate;                 /**< Annual risk-free rate for metrics */
+} SamtraderSweepRun;
+
+/**
+ * @brief Backtest every variant in parallel and collect its metrics.
+ *
+ * Each task compiles its strategy, runs samtrader_backtest_run() and
+ * stores the metrics in results[variant]. Each task allocates in a
+ * scratch frame of its worker arena that ends with the task, so the pages
+ * are reused by the next variant and anything already on the arena is
+ * left alone.
+ *
+ * @param pool Worker pool to run on
+ * @param run Shared sweep inputs
+ * @param results Output array of run->strategy_count metrics
+ * @return 0 on success, -1 if any variant failed
+ */
+int samtrader_sweep_run(SamtraderWorkerPool *pool, const SamtraderSweepRun *run,
+                        SamtraderMetrics *results);
+
+#endif /* SAMTRADER_DOMAIN_SWEEP_H */
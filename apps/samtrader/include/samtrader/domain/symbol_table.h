@@ -0,0 +1,88 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SAMTRADER_DOMAIN_SYMBOL_TABLE_H
+#define SAMTRADER_DOMAIN_SYMBOL_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <samrena.h>
+
+/** @brief Dense id of an interned symbol (1, 2, ... in interning order). */
+typedef uint32_t SamtraderSymbolId;
+
+/** @brief Id that no symbol receives; zero-initialised records carry it. */
+#define SAMTRADER_SYMBOL_NONE ((SamtraderSymbolId)0)
+
+/**
+ * @brief Interning table mapping symbol strings to dense ids.
+ *
+ * Each distinct string is copied into the arena once and given the next
+ * id, so per-symbol state can live in plain arrays indexed by id and
+ * records can share the interned string instead of copying it. Ids start
+ * at 1 (SAMTRADER_SYMBOL_NONE is 0), so an array indexed by id needs
+ * samtrader_symbol_table_count() + 1 entries.
+ *
+ * Lookups may run concurrently; interning may not.
+ */
+typedef struct SamtraderSymbolTable SamtraderSymbolTable;
+
+/**
+ * @brief Create an empty symbol table.
+ *
+ * @param arena Memory arena for the table and interned strings
+ * @param capacity Expected number of symbols (the table grows past it)
+ * @return Pointer to the table, or NULL on failure
+ */
+SamtraderSymbolTable *samtrader_symbol_table_create(Samrena *arena, size_t capacity);
+
+/**
+ * @brief Get a symbol's id, interning it on first sight.
+ *
+ * @param table Symbol table
+ * @param name Symbol string (copied on first sight)
+ * @return The symbol's id, or SAMTRADER_SYMBOL_NONE on failure
+ */
+SamtraderSymbolId samtrader_symbol_intern(SamtraderSymbolTable *table, const char *name);
+
+/**
+ * @brief Look up a symbol's id without interning it.
+ *
+ * @param table Symbol table
+ * @param name Symbol string
+ * @return The symbol's id, or SAMTRADER_SYMBOL_NONE if it was never interned
+ */
+SamtraderSymbolId samtrader_symbol_find(const SamtraderSymbolTable *table, const char *name);
+
+/**
+ * @brief Get the interned string for an id.
+ *
+ * @param table Symbol table
+ * @param id Symbol id
+ * @return The interned string (owned by the table), or NULL for an unknown id
+ */
+const char *samtrader_symbol_name(const SamtraderSymbolTable *table, SamtraderSymbolId id);
+
+/**
+ * @brief Get the number of interned symbols (also the highest id).
+ *
+ * @param table Symbol table
+ * @return Number of symbols, or 0 if table is NULL
+ */
+size_t samtrader_symbol_table_count(const SamtraderSymbolTable *table);
+
+#endif /* SAMTRADER_DOMAIN_SYMBOL_TABLE_H */
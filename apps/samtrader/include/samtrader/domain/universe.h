@@ -58,7 +58,10 @@ SamtraderUniverse *samtrader_universe_parse(Samrena *arena, const char *codes_st
  * @brief Validate universe codes against a data source.
  *
  * Checks each code has at least SAMTRADER_MIN_OHLCV_BARS of data in the
- * given date range. Codes with insufficient data are removed in-place.
+ * given date range, using the port's count-only fetch_summary when it has
+ * one. Codes with insufficient data are removed in-place. Callers that go
+ * on to load the bars should use samtrader_load_universe_data instead,
+ * which validates and loads with a single fetch.
  *
  * @param universe The universe to validate (modified in-place)
  * @param data_port Data source to check against
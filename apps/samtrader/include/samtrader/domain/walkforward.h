@@ -0,0 +1,109 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SAMTRADER_DOMAIN_WALKFORWARD_H
+#define SAMTRADER_DOMAIN_WALKFORWARD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <samrena.h>
+#include <samvector.h>
+
+#include "samtrader/domain/metrics.h"
+#include "samtrader/domain/sweep.h"
+#include "samtrader/domain/worker_pool.h"
+
+/**
+ * @brief Window sizes for a walk-forward analysis, in timeline dates.
+ *
+ * Out-of-sample windows tile the timeline back to back after the first
+ * in_sample dates; each is preceded by the in_sample dates it is
+ * optimised on (or, when anchored, by every date from the start).
+ */
+typedef struct {
+  size_t in_sample;     /**< Dates each optimisation window spans (> 0) */
+  size_t out_of_sample; /**< Dates each evaluation window spans (> 0) */
+  bool anchored;        /**< Grow in-sample windows from the first date instead of rolling */
+} SamtraderWalkForwardConfig;
+
+/**
+ * @brief One in-sample / out-of-sample step of a walk-forward analysis.
+ *
+ * Ranges are half-open positions on the timeline the analysis ran over.
+ */
+typedef struct {
+  size_t in_sample_begin;         /**< First in-sample date */
+  size_t in_sample_end;           /**< One past the last in-sample date */
+  size_t out_of_sample_begin;     /**< First out-of-sample date (== in_sample_end) */
+  size_t out_of_sample_end;       /**< One past the last out-of-sample date */
+  size_t best_variant;            /**< Variant with the highest in-sample Sharpe ratio */
+  SamtraderMetrics in_sample;     /**< best_variant's metrics in-sample */
+  SamtraderMetrics out_of_sample; /**< best_variant's metrics out-of-sample */
+} SamtraderWalkForwardWindow;
+
+/**
+ * @brief Result of a walk-forward analysis.
+ *
+ * The out-of-sample runs are chained: each starts with the equity the
+ * previous one ended on, so equity_curve and trades read as a single
+ * out-of-sample backtest.
+ */
+typedef struct {
+  SamtraderWalkForwardWindow *windows; /**< Arena-allocated, in timeline order */
+  size_t window_count;                 /**< Number of windows */
+  SamrenaVector *equity_curve;         /**< Stitched SamtraderEquityPoint curve */
+  SamrenaVector *trades;               /**< Every out-of-sample SamtraderClosedTrade */
+} SamtraderWalkForwardResult;
+
+/**
+ * @brief Count the windows a timeline of date_count dates holds.
+ *
+ * The last out-of-sample window is shortened to end with the timeline.
+ *
+ * @param config Window sizes
+ * @param date_count Number of timeline dates
+ * @return Number of windows, 0 if config is invalid or the timeline is
+ *         no longer than one in-sample window
+ */
+size_t samtrader_walkforward_window_count(const SamtraderWalkForwardConfig *config,
+                                          size_t date_count);
+
+/**
+ * @brief Run a walk-forward analysis over a prepared sweep.
+ *
+ * For every window, all of run->strategies are backtested in parallel on
+ * the in-sample slice of run->timeline (see samtrader_sweep_run()), then
+ * the variant with the highest in-sample Sharpe ratio is backtested on
+ * the out-of-sample slice. Slices are views of run->timeline; bar indices
+ * still address the full history, so indicators computed once over it
+ * are reused by every window and already warmed up by the bars before
+ * the window starts. Positions still open at the end of an out-of-sample
+ * window are exited at its last close (see close_at_end in
+ * SamtraderBacktestConfig), paying the usual commission and slippage, so
+ * the stitched trades account for every change in the stitched equity.
+ *
+ * @param arena Memory arena for the result
+ * @param pool Worker pool for the in-sample sweeps
+ * @param run Shared sweep inputs over the full timeline
+ * @param config Window sizes
+ * @return The result, or NULL on error or when the timeline holds no window
+ */
+SamtraderWalkForwardResult *samtrader_walkforward_run(Samrena *arena, SamtraderWorkerPool *pool,
+                                                      const SamtraderSweepRun *run,
+                                                      const SamtraderWalkForwardConfig *config);
+
+#endif /* SAMTRADER_DOMAIN_WALKFORWARD_H */
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SAMTRADER_DOMAIN_WORKER_POOL_H
+#define SAMTRADER_DOMAIN_WORKER_POOL_H
+
+#include <stddef.h>
+
+#include <samrena.h>
+
+/** @brief Upper bound on the number of workers a pool will run. */
+#define SAMTRADER_MAX_WORKERS 256
+
+/**
+ * @brief A fixed set of worker threads, each owning a private arena.
+ *
+ * Samrena arenas are not thread-safe, so every worker allocates only from
+ * its own arena. Anything a task allocates stays valid until the pool is
+ * destroyed, which lets callers hand task results straight to the
+ * single-threaded code that runs afterwards.
+ */
+typedef struct SamtraderWorkerPool SamtraderWorkerPool;
+
+/**
+ * @brief Task callback run once per task index.
+ *
+ * @param ctx Caller context shared by all tasks (treat as read-only unless
+ *            each task writes a disjoint slot)
+ * @param index Task index in [0, task_count)
+ * @param arena The running worker's private arena
+ * @return 0 on success, -1 on error
+ */
+typedef int (*SamtraderWorkerTaskFn)(void *ctx, size_t index, Samrena *arena);
+
+/**
+ * @brief Create a worker pool.
+ *
+ * @param jobs Number of workers (values below 1 are treated as 1, values
+ *             above SAMTRADER_MAX_WORKERS are clamped)
+ * @return Pointer to the pool, or NULL on allocation failure
+ */
+SamtraderWorkerPool *samtrader_worker_pool_create(int jobs);
+
+/**
+ * @brief Get the number of workers in the pool.
+ *
+ * @param pool The worker pool
+ * @return Worker count, or 0 if pool is NULL
+ */
+size_t samtrader_worker_pool_size(const SamtraderWorkerPool *pool);
+
+/**
+ * @brief Run task_count tasks across the pool's workers and wait for them.
+ *
+ * Workers pull task indices from a shared counter, so uneven tasks balance
+ * themselves. With a single worker the tasks run inline on the calling
+ * thread, in index order. After the first failing task no further tasks
+ * are started.
+ *
+ * @param pool The worker pool
+ * @param task_count Number of tasks
+ * @param fn Task callback
+ * @param ctx Caller context passed to every task
+ * @return 0 if every task succeeded, -1 otherwise
+ */
+int samtrader_worker_pool_run(SamtraderWorkerPool *pool, size_t task_count,
+                              SamtraderWorkerTaskFn fn, void *ctx);
+
+/**
+ * @brief Destroy the pool and every worker arena.
+ *
+ * @param pool The worker pool (may be NULL)
+ */
+void samtrader_worker_pool_destroy(SamtraderWorkerPool *pool);
+
+#endif /* SAMTRADER_DOMAIN_WORKER_POOL_H */
@@ -17,11 +17,14 @@
 #ifndef SAMTRADER_PORTS_DATA_PORT_H
 #define SAMTRADER_PORTS_DATA_PORT_H
 
+#include <stddef.h>
 #include <time.h>
 
 #include <samrena.h>
 #include <samvector.h>
 
+#include "samtrader/domain/ohlcv.h"
+
 /**
  * @brief Forward declaration of the data port structure.
  *
@@ -48,6 +51,77 @@ typedef SamrenaVector *(*SamtraderDataFetchFn)(SamtraderDataPort *port, const ch
                                                const char *exchange, time_t start_date,
                                                time_t end_date);
 
+/**
+ * @brief Function type for fetching OHLCV data for many symbols at once.
+ *
+ * Fetches the same date range for every code in one round trip and splits
+ * the rows per code. Codes must be unique. A code with no data in the
+ * range gets an empty vector.
+ *
+ * @param port The data port instance
+ * @param codes Array of stock symbols
+ * @param code_count Number of symbols
+ * @param exchange Exchange identifier (e.g., "US", "AU")
+ * @param start_date Start of date range (inclusive)
+ * @param end_date End of date range (inclusive)
+ * @return Arena-allocated array of code_count vectors of SamtraderOhlcv,
+ *         parallel to codes, or NULL on failure
+ */
+typedef SamrenaVector **(*SamtraderDataFetchBatchFn)(SamtraderDataPort *port,
+                                                     const char *const *codes, size_t code_count,
+                                                     const char *exchange, time_t start_date,
+                                                     time_t end_date);
+
+/**
+ * @brief Function type for borrowing OHLCV data as columns.
+ *
+ * Fills out with one symbol's bars in a date range without copying them.
+ * The arrays and strings belong to the adapter, stay valid until the port
+ * is closed, and must not be written to.
+ *
+ * @param port The data port instance
+ * @param code Stock symbol
+ * @param exchange Exchange identifier
+ * @param start_date Start of date range (inclusive)
+ * @param end_date End of date range (inclusive)
+ * @param out Receives the bars (count 0 when no bars match)
+ * @return 0 on success, -1 for an unknown symbol or on failure
+ */
+typedef int (*SamtraderDataFetchBarsFn)(SamtraderDataPort *port, const char *code,
+                                        const char *exchange, time_t start_date, time_t end_date,
+                                        SamtraderBarColumns *out);
+
+/**
+ * @brief Bar count and endpoints of one symbol's data in a date range.
+ *
+ * When bar_count is 0 the remaining fields are zero.
+ */
+typedef struct {
+  size_t bar_count;   /**< Number of bars in the range */
+  time_t first_date;  /**< Date of the earliest bar */
+  time_t last_date;   /**< Date of the latest bar */
+  double first_close; /**< Close of the earliest bar */
+  double last_close;  /**< Close of the latest bar */
+} SamtraderOhlcvSummary;
+
+/**
+ * @brief Function type for summarising OHLCV data without fetching bars.
+ *
+ * Counts a symbol's bars in a date range and reads its first and last bar,
+ * for callers that only need to know how much data exists.
+ *
+ * @param port The data port instance
+ * @param code Stock symbol
+ * @param exchange Exchange identifier
+ * @param start_date Start of date range (inclusive)
+ * @param end_date End of date range (inclusive)
+ * @param out Receives the summary (bar_count 0 for an unknown symbol)
+ * @return 0 on success, -1 on failure
+ */
+typedef int (*SamtraderDataSummaryFn)(SamtraderDataPort *port, const char *code,
+                                      const char *exchange, time_t start_date, time_t end_date,
+                                      SamtraderOhlcvSummary *out);
+
 /**
  * @brief Function type for listing available symbols.
  *
@@ -85,6 +159,19 @@ typedef void (*SamtraderDataCloseFn)(SamtraderDataPort *port);
  * SamrenaVector *ohlcv = data->fetch_ohlcv(data, "AAPL", "US",
  *                                           start_date, end_date);
  *
+ * // Fetch several symbols in one request (when the adapter supports it)
+ * const char *codes[] = {"AAPL", "MSFT"};
+ * SamrenaVector **per_code = data->fetch_ohlcv_batch(data, codes, 2, "US",
+ *                                                    start_date, end_date);
+ *
+ * // Borrow bars without copying them (when the adapter supports it)
+ * SamtraderBarColumns bars;
+ * data->fetch_bars(data, "AAPL", "US", start_date, end_date, &bars);
+ *
+ * // Count bars without fetching them (when the adapter supports it)
+ * SamtraderOhlcvSummary summary;
+ * data->fetch_summary(data, "AAPL", "US", start_date, end_date, &summary);
+ *
  * // List symbols
  * SamrenaVector *symbols = data->list_symbols(data, "US");
  *
@@ -93,11 +180,14 @@ typedef void (*SamtraderDataCloseFn)(SamtraderDataPort *port);
  * @endcode
  */
 struct SamtraderDataPort {
-  void *impl;                              /**< Adapter-specific implementation */
-  Samrena *arena;                          /**< Memory arena for allocations */
-  SamtraderDataFetchFn fetch_ohlcv;        /**< Fetch OHLCV data function */
-  SamtraderDataListSymbolsFn list_symbols; /**< List symbols function */
-  SamtraderDataCloseFn close;              /**< Close/cleanup function */
+  void *impl;                                  /**< Adapter-specific implementation */
+  Samrena *arena;                              /**< Memory arena for allocations */
+  SamtraderDataFetchFn fetch_ohlcv;            /**< Fetch OHLCV data function */
+  SamtraderDataFetchBatchFn fetch_ohlcv_batch; /**< Multi-symbol fetch (NULL if unsupported) */
+  SamtraderDataFetchBarsFn fetch_bars;         /**< Zero-copy columns (NULL if unsupported) */
+  SamtraderDataSummaryFn fetch_summary;        /**< Count-only query (NULL if unsupported) */
+  SamtraderDataListSymbolsFn list_symbols;     /**< List symbols function */
+  SamtraderDataCloseFn close;                  /**< Close/cleanup function */
 };
 
 #endif /* SAMTRADER_PORTS_DATA_PORT_H */
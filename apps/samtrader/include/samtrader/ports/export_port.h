@@ -0,0 +1,110 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SAMTRADER_PORTS_EXPORT_PORT_H
+#define SAMTRADER_PORTS_EXPORT_PORT_H
+
+#include <stdbool.h>
+
+#include <samrena.h>
+
+#include "samtrader/domain/metrics.h"
+#include "samtrader/domain/sweep.h"
+#include "samtrader/domain/walkforward.h"
+
+/**
+ * @brief Forward declaration of the export port structure.
+ *
+ * The SamtraderExportPort is an interface (port) for exporting tabular
+ * analysis results in the hexagonal architecture. Concrete
+ * implementations (adapters) provide the file format.
+ */
+typedef struct SamtraderExportPort SamtraderExportPort;
+
+/**
+ * @brief Function type for writing parameter sweep results.
+ *
+ * Writes one row per variant: the variant index, each parameter value,
+ * then every SamtraderMetrics field.
+ *
+ * @param port The export port instance
+ * @param output_path File path to write to
+ * @param grid The grid that produced the variants
+ * @param results Metrics for each of grid->variant_count variants
+ * @return true on success, false on failure
+ */
+typedef bool (*SamtraderExportWriteSweepFn)(SamtraderExportPort *port, const char *output_path,
+                                            const SamtraderSweepGrid *grid,
+                                            const SamtraderMetrics *results);
+
+/**
+ * @brief Function type for writing walk-forward results.
+ *
+ * Writes one row per window: the window index, the in-sample and
+ * out-of-sample date ranges, the chosen variant and its parameter values,
+ * then the in-sample and out-of-sample return and Sharpe ratio and the
+ * out-of-sample trades.
+ *
+ * @param port The export port instance
+ * @param output_path File path to write to
+ * @param grid The grid that produced the variants
+ * @param timeline Timeline the analysis ran over (for window dates)
+ * @param result The walk-forward result
+ * @return true on success, false on failure
+ */
+typedef bool (*SamtraderExportWriteWalkForwardFn)(SamtraderExportPort *port,
+                                                  const char *output_path,
+                                                  const SamtraderSweepGrid *grid,
+                                                  const SamtraderTimeline *timeline,
+                                                  const SamtraderWalkForwardResult *result);
+
+/**
+ * @brief Function type for closing the export port.
+ *
+ * Releases any resources held by the adapter.
+ * Memory allocated through the arena is not freed here.
+ *
+ * @param port The export port instance to close
+ */
+typedef void (*SamtraderExportCloseFn)(SamtraderExportPort *port);
+
+/**
+ * @brief Export port interface for sweep and walk-forward results.
+ *
+ * This is the port (interface) in the hexagonal architecture pattern.
+ * Adapters implement this interface to write results in a given format.
+ *
+ * Usage:
+ * @code
+ * // Create adapter (e.g., CSV)
+ * SamtraderExportPort *export = samtrader_csv_export_adapter_create(arena);
+ *
+ * // Write results
+ * export->write_sweep(export, "sweep_results.csv", grid, results);
+ *
+ * // Clean up
+ * export->close(export);
+ * @endcode
+ */
+struct SamtraderExportPort {
+  void *impl;                                          /**< Adapter-specific implementation */
+  Samrena *arena;                                      /**< Memory arena for allocations */
+  SamtraderExportWriteSweepFn write_sweep;             /**< Write sweep results function */
+  SamtraderExportWriteWalkForwardFn write_walkforward; /**< Write walk-forward results */
+  SamtraderExportCloseFn close;                        /**< Close/cleanup function */
+};
+
+#endif /* SAMTRADER_PORTS_EXPORT_PORT_H */
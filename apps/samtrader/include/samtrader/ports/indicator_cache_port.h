@@ -0,0 +1,99 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SAMTRADER_PORTS_INDICATOR_CACHE_PORT_H
+#define SAMTRADER_PORTS_INDICATOR_CACHE_PORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <samrena.h>
+
+#include "samtrader/domain/indicator.h"
+
+/**
+ * @brief Forward declaration of the indicator cache port structure.
+ *
+ * The SamtraderIndicatorCachePort is an interface (port) for stores that
+ * keep computed indicator series between runs, so a series is only ever
+ * computed once for the same bars.
+ */
+typedef struct SamtraderIndicatorCachePort SamtraderIndicatorCachePort;
+
+/**
+ * @brief Identity of one cached indicator series.
+ *
+ * A series is reusable only for exactly the bars it was computed from, so
+ * the key pairs the symbol and indicator with a content hash of the bars.
+ */
+typedef struct {
+  const char *code;          /**< Stock symbol */
+  const char *exchange;      /**< Exchange identifier */
+  const char *indicator_key; /**< samtrader_operand_indicator_key() of the operand */
+  uint64_t data_hash;        /**< samtrader_bar_columns_hash() of the bars */
+  size_t bar_count;          /**< Number of bars the series was computed from */
+  const time_t *dates;       /**< Bar dates, shared by series returned from lookup */
+} SamtraderIndicatorCacheKey;
+
+/**
+ * @brief Function type for looking up a cached series.
+ *
+ * @param port The cache port instance
+ * @param arena Memory arena for the returned series header
+ * @param key Series identity
+ * @return The cached series, or NULL on a miss. Its columns may live in
+ *         storage owned by the port and stay valid until the port is
+ *         closed.
+ */
+typedef SamtraderIndicatorSeries *(*SamtraderIndicatorCacheLookupFn)(
+    SamtraderIndicatorCachePort *port, Samrena *arena, const SamtraderIndicatorCacheKey *key);
+
+/**
+ * @brief Function type for storing a computed series.
+ *
+ * @param port The cache port instance
+ * @param key Series identity
+ * @param series The series computed from the key's bars, one row per bar
+ * @return 0 on success, -1 on failure (the cache is left unchanged)
+ */
+typedef int (*SamtraderIndicatorCacheStoreFn)(SamtraderIndicatorCachePort *port,
+                                              const SamtraderIndicatorCacheKey *key,
+                                              const SamtraderIndicatorSeries *series);
+
+/**
+ * @brief Function type for closing the cache port.
+ *
+ * Releases the adapter's resources. Series returned by lookup are no
+ * longer valid afterwards.
+ *
+ * @param port The cache port instance to close
+ */
+typedef void (*SamtraderIndicatorCacheCloseFn)(SamtraderIndicatorCachePort *port);
+
+/**
+ * @brief Indicator cache port interface.
+ *
+ * lookup and store may be called concurrently from worker threads; the
+ * adapter does its own locking.
+ */
+struct SamtraderIndicatorCachePort {
+  void *impl;                             /**< Adapter-specific implementation */
+  SamtraderIndicatorCacheLookupFn lookup; /**< Find a cached series */
+  SamtraderIndicatorCacheStoreFn store;   /**< Save a computed series */
+  SamtraderIndicatorCacheCloseFn close;   /**< Close/cleanup function */
+};
+
+#endif /* SAMTRADER_PORTS_INDICATOR_CACHE_PORT_H */
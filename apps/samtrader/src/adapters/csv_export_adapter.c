@@ -0,0 +1,162 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <samtrader/adapters/csv_export_adapter.h>
+
+#include <stddef.h>
+#include <time.h>
+
+#include <samtrader/adapters/writer.h>
+#include <samtrader/domain/sweep.h>
+#include <samtrader/domain/walkforward.h>
+
+/* Enough for "%Y-%m-%d %H:%M" */
+#define CSV_DATE_BUF_SIZE 32
+
+/* Append ",name" for each grid parameter */
+static void write_param_names(SamtraderWriter *out, const SamtraderSweepGrid *grid) {
+  for (size_t i = 0; i < grid->param_count; i++) {
+    samtrader_writer_puts(out, ",");
+    samtrader_writer_puts(out, grid->params[i].name);
+  }
+}
+
+/* Append ",value" for each parameter of a variant */
+static void write_param_values(SamtraderWriter *out, const SamtraderSweepGrid *grid,
+                               size_t variant) {
+  double values[SAMTRADER_SWEEP_MAX_PARAMS];
+  samtrader_sweep_variant_values(grid, variant, values);
+  for (size_t i = 0; i < grid->param_count; i++)
+    samtrader_writer_printf(out, ",%.15g", values[i]);
+}
+
+static bool csv_write_sweep(SamtraderExportPort *port, const char *output_path,
+                            const SamtraderSweepGrid *grid, const SamtraderMetrics *results) {
+  if (port == NULL || output_path == NULL || grid == NULL || results == NULL) {
+    return false;
+  }
+
+  /* The output buffer lives in a scratch frame of the arena */
+  SamrenaScratch scratch = samrena_scratch_begin(port->arena);
+  SamtraderWriter writer;
+  if (!samtrader_writer_open(&writer, port->arena, output_path)) {
+    samrena_scratch_end(scratch);
+    return false;
+  }
+  SamtraderWriter *out = &writer;
+
+  samtrader_writer_puts(out, "variant");
+  write_param_names(out, grid);
+  samtrader_writer_puts(out, ",total_return,annualized_return,sharpe_ratio,sortino_ratio,"
+                             "max_drawdown,max_drawdown_duration,win_rate,profit_factor,"
+                             "total_trades,winning_trades,losing_trades,average_win,average_loss,"
+                             "largest_win,largest_loss,average_trade_duration\n");
+
+  for (size_t v = 0; v < grid->variant_count; v++) {
+    const SamtraderMetrics *m = &results[v];
+    samtrader_writer_int(out, (long long)v);
+    write_param_values(out, grid, v);
+    samtrader_writer_printf(out,
+                            ",%.10g,%.10g,%.10g,%.10g,%.10g,%.10g,%.10g,%.10g"
+                            ",%d,%d,%d,%.10g,%.10g,%.10g,%.10g,%.10g\n",
+                            m->total_return, m->annualized_return, m->sharpe_ratio,
+                            m->sortino_ratio, m->max_drawdown, m->max_drawdown_duration,
+                            m->win_rate, m->profit_factor, m->total_trades, m->winning_trades,
+                            m->losing_trades, m->average_win, m->average_loss, m->largest_win,
+                            m->largest_loss, m->average_trade_duration);
+  }
+
+  bool ok = samtrader_writer_close(out);
+  samrena_scratch_end(scratch);
+  return ok;
+}
+
+/* Append ",YYYY-MM-DD HH:MM" for the timeline date at index */
+static void write_date(SamtraderWriter *out, const SamtraderTimeline *timeline, size_t index) {
+  time_t date = *(const time_t *)samrena_vector_at_const(timeline->dates, index);
+  char buf[CSV_DATE_BUF_SIZE];
+  strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M", gmtime(&date));
+  samtrader_writer_puts(out, ",");
+  samtrader_writer_puts(out, buf);
+}
+
+static bool csv_write_walkforward(SamtraderExportPort *port, const char *output_path,
+                                  const SamtraderSweepGrid *grid,
+                                  const SamtraderTimeline *timeline,
+                                  const SamtraderWalkForwardResult *result) {
+  if (port == NULL || output_path == NULL || grid == NULL || timeline == NULL ||
+      result == NULL) {
+    return false;
+  }
+
+  /* The output buffer lives in a scratch frame of the arena */
+  SamrenaScratch scratch = samrena_scratch_begin(port->arena);
+  SamtraderWriter writer;
+  if (!samtrader_writer_open(&writer, port->arena, output_path)) {
+    samrena_scratch_end(scratch);
+    return false;
+  }
+  SamtraderWriter *out = &writer;
+
+  samtrader_writer_puts(out, "window,in_sample_start,in_sample_end,out_of_sample_start,"
+                             "out_of_sample_end,variant");
+  write_param_names(out, grid);
+  samtrader_writer_puts(out, ",in_sample_return,in_sample_sharpe,out_of_sample_return,"
+                             "out_of_sample_sharpe,out_of_sample_trades\n");
+
+  for (size_t w = 0; w < result->window_count; w++) {
+    const SamtraderWalkForwardWindow *win = &result->windows[w];
+    samtrader_writer_int(out, (long long)w);
+    write_date(out, timeline, win->in_sample_begin);
+    write_date(out, timeline, win->in_sample_end - 1);
+    write_date(out, timeline, win->out_of_sample_begin);
+    write_date(out, timeline, win->out_of_sample_end - 1);
+    samtrader_writer_puts(out, ",");
+    samtrader_writer_int(out, (long long)win->best_variant);
+    write_param_values(out, grid, win->best_variant);
+    samtrader_writer_printf(out, ",%.10g,%.10g,%.10g,%.10g,%d\n", win->in_sample.total_return,
+                            win->in_sample.sharpe_ratio, win->out_of_sample.total_return,
+                            win->out_of_sample.sharpe_ratio, win->out_of_sample.total_trades);
+  }
+
+  bool ok = samtrader_writer_close(out);
+  samrena_scratch_end(scratch);
+  return ok;
+}
+
+static void csv_export_close(SamtraderExportPort *port) {
+  /* All memory is arena-allocated, nothing to free manually */
+  (void)port;
+}
+
+SamtraderExportPort *samtrader_csv_export_adapter_create(Samrena *arena) {
+  if (arena == NULL) {
+    return NULL;
+  }
+
+  SamtraderExportPort *port = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderExportPort);
+  if (port == NULL) {
+    return NULL;
+  }
+
+  port->impl = NULL;
+  port->arena = arena;
+  port->write_sweep = csv_write_sweep;
+  port->write_walkforward = csv_write_walkforward;
+  port->close = csv_export_close;
+
+  return port;
+}
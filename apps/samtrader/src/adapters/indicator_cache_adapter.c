@@ -0,0 +1,439 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "samtrader/adapters/indicator_cache_adapter.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <samvector.h>
+
+#define CACHE_BYTE_ORDER_MARK 0x01020304u
+#define CACHE_VALUE_ALIGNMENT 64
+#define CACHE_FILE_SUFFIX ".ind"
+#define CACHE_NAME_LENGTH 20 /* 16 hex digits + suffix */
+#define CACHE_PATH_MAX 4096
+#define CACHE_IDENTITY_MAX 256
+
+/* On-disk header (128 bytes) */
+typedef struct {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t column_count;
+  int32_t indicator_type;
+  uint64_t data_hash;
+  uint64_t bar_count;
+  uint64_t value_count; /* Rows in each column */
+  uint64_t identity_length; /* Key text that follows the header, including its terminator */
+  uint64_t values_offset; /* First column; the others follow it back to back */
+  uint64_t file_size;
+  int32_t period;
+  int32_t param2;
+  int32_t param3;
+  uint32_t reserved0;
+  double param_double;
+  uint64_t valid_from;
+  uint8_t reserved[24];
+} CacheFileHeader;
+
+_Static_assert(sizeof(CacheFileHeader) == 128, "indicator cache header must be 128 bytes");
+
+/* A mapped file whose values are handed out by lookup */
+typedef struct CacheMapping {
+  void *base;
+  size_t size;
+  struct CacheMapping *next;
+} CacheMapping;
+
+/**
+ * @brief Internal structure holding the cache directory state.
+ *
+ * lock guards everything below it; workers look up and store concurrently.
+ */
+typedef struct {
+  char *directory;
+  size_t max_bytes;
+  pthread_mutex_t lock;
+  Samrena *records; /* Mapping records and eviction scratch, used under lock */
+  CacheMapping *mappings;
+  size_t total_bytes;
+  SamtraderIndicatorCacheStats stats;
+} IndicatorCacheImpl;
+
+static SamtraderIndicatorSeries *indicator_cache_lookup(SamtraderIndicatorCachePort *port,
+                                                        Samrena *arena,
+                                                        const SamtraderIndicatorCacheKey *key);
+static int indicator_cache_store(SamtraderIndicatorCachePort *port,
+                                 const SamtraderIndicatorCacheKey *key,
+                                 const SamtraderIndicatorSeries *series);
+static void indicator_cache_close(SamtraderIndicatorCachePort *port);
+
+static uint64_t align_up(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+/*============================================================================
+ * Keys
+ *============================================================================*/
+
+/* The full key text stored in each file: exchange, code and indicator key */
+static int format_identity(char *buf, size_t size, const SamtraderIndicatorCacheKey *key) {
+  int len = snprintf(buf, size, "%s\n%s\n%s", key->exchange, key->code, key->indicator_key);
+  return len < 0 || (size_t)len >= size ? -1 : len;
+}
+
+/* "<directory>/<16 hex digits>.ind", from an FNV-1a hash of the identity and bar hash */
+static int entry_path(char *buf, size_t size, const IndicatorCacheImpl *impl,
+                      const char *identity, uint64_t data_hash) {
+  uint64_t h = 0xcbf29ce484222325ULL ^ data_hash;
+  for (const unsigned char *p = (const unsigned char *)identity; *p; p++) {
+    h ^= *p;
+    h *= 0x100000001b3ULL;
+  }
+  int len = snprintf(buf, size, "%s/%016llx" CACHE_FILE_SUFFIX, impl->directory,
+                     (unsigned long long)h);
+  return len < 0 || (size_t)len >= size ? -1 : len;
+}
+
+static bool key_valid(const SamtraderIndicatorCacheKey *key) {
+  return key && key->code && key->exchange && key->indicator_key;
+}
+
+/*============================================================================
+ * Size Cap
+ *============================================================================*/
+
+typedef struct {
+  char name[CACHE_NAME_LENGTH + 1];
+  struct timespec used;
+  size_t size;
+} CacheFileInfo;
+
+static int compare_recency(const void *a, const void *b) {
+  const struct timespec *x = &((const CacheFileInfo *)a)->used;
+  const struct timespec *y = &((const CacheFileInfo *)b)->used;
+  if (x->tv_sec != y->tv_sec)
+    return x->tv_sec < y->tv_sec ? -1 : 1;
+  return (x->tv_nsec > y->tv_nsec) - (x->tv_nsec < y->tv_nsec);
+}
+
+static bool is_cache_file(const char *name) {
+  size_t len = strlen(name);
+  size_t suffix = sizeof(CACHE_FILE_SUFFIX) - 1;
+  return len == CACHE_NAME_LENGTH && strcmp(name + len - suffix, CACHE_FILE_SUFFIX) == 0;
+}
+
+/*
+ * Count the cached files and remove the least recently used ones until at
+ * most limit bytes remain (SIZE_MAX only counts). Caller holds the lock.
+ */
+static void shrink_locked(IndicatorCacheImpl *impl, size_t limit) {
+  DIR *dir = opendir(impl->directory);
+  if (!dir)
+    return;
+
+  SamrenaScratch scratch = samrena_scratch_begin(impl->records);
+  SamrenaVector *files = samrena_vector_init(impl->records, sizeof(CacheFileInfo), 64);
+  char path[CACHE_PATH_MAX];
+  size_t total = 0;
+  struct dirent *ent;
+  while (files && (ent = readdir(dir)) != NULL) {
+    if (!is_cache_file(ent->d_name))
+      continue;
+    snprintf(path, sizeof(path), "%s/%s", impl->directory, ent->d_name);
+    struct stat st;
+    if (stat(path, &st) != 0 || !S_ISREG(st.st_mode))
+      continue;
+    CacheFileInfo info = {.used = st.st_mtim, .size = (size_t)st.st_size};
+    memcpy(info.name, ent->d_name, CACHE_NAME_LENGTH + 1);
+    if (!samrena_vector_push(files, &info))
+      break;
+    total += info.size;
+  }
+  closedir(dir);
+
+  if (files && total > limit) {
+    size_t count = samrena_vector_size(files);
+    CacheFileInfo *infos = (CacheFileInfo *)files->data;
+    qsort(infos, count, sizeof(CacheFileInfo), compare_recency);
+    for (size_t i = 0; i < count && total > limit; i++) {
+      snprintf(path, sizeof(path), "%s/%s", impl->directory, infos[i].name);
+      if (unlink(path) == 0) {
+        total -= infos[i].size;
+        impl->stats.evictions++;
+      }
+    }
+  }
+  samrena_scratch_end(scratch);
+
+  impl->total_bytes = total;
+  impl->stats.bytes = total;
+}
+
+/*============================================================================
+ * Port Functions
+ *============================================================================*/
+
+SamtraderIndicatorCachePort *samtrader_indicator_cache_adapter_create(Samrena *arena,
+                                                                      const char *directory,
+                                                                      size_t max_bytes) {
+  /* Leave room for "/<name>" in every entry path */
+  if (!arena || !directory || directory[0] == '\0' ||
+      strlen(directory) + 1 + CACHE_NAME_LENGTH >= CACHE_PATH_MAX)
+    return NULL;
+
+  if (mkdir(directory, 0777) != 0 && errno != EEXIST)
+    return NULL;
+  struct stat st;
+  if (stat(directory, &st) != 0 || !S_ISDIR(st.st_mode))
+    return NULL;
+
+  IndicatorCacheImpl *impl = SAMRENA_PUSH_TYPE_ZERO(arena, IndicatorCacheImpl);
+  SamtraderIndicatorCachePort *port = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderIndicatorCachePort);
+  size_t dir_len = strlen(directory) + 1;
+  char *dir_copy = (char *)samrena_push(arena, dir_len);
+  if (!impl || !port || !dir_copy)
+    return NULL;
+  memcpy(dir_copy, directory, dir_len);
+
+  impl->records = samrena_create_default();
+  if (!impl->records)
+    return NULL;
+  if (pthread_mutex_init(&impl->lock, NULL) != 0) {
+    samrena_destroy(impl->records);
+    return NULL;
+  }
+  impl->directory = dir_copy;
+  impl->max_bytes = max_bytes;
+  shrink_locked(impl, max_bytes > 0 ? max_bytes : SIZE_MAX);
+
+  port->impl = impl;
+  port->lookup = indicator_cache_lookup;
+  port->store = indicator_cache_store;
+  port->close = indicator_cache_close;
+  return port;
+}
+
+static bool validate_file(const uint8_t *base, size_t size, const char *identity,
+                          const SamtraderIndicatorCacheKey *key) {
+  if (size < sizeof(CacheFileHeader))
+    return false;
+  const CacheFileHeader *h = (const CacheFileHeader *)base;
+  if (memcmp(h->magic, SAMTRADER_INDICATOR_CACHE_MAGIC, sizeof(h->magic)) != 0 ||
+      h->version != SAMTRADER_INDICATOR_CACHE_VERSION || h->byte_order != CACHE_BYTE_ORDER_MARK ||
+      h->file_size != size)
+    return false;
+  if (h->indicator_type < 0 || h->indicator_type > SAMTRADER_IND_PIVOT ||
+      h->column_count !=
+          samtrader_indicator_column_count((SamtraderIndicatorType)h->indicator_type))
+    return false;
+  /* The cheap checks that make a stale entry a miss: same bars, same count */
+  if (h->data_hash != key->data_hash || h->bar_count != key->bar_count)
+    return false;
+  size_t identity_length = strlen(identity) + 1;
+  if (h->identity_length != identity_length ||
+      identity_length > size - sizeof(CacheFileHeader) ||
+      memcmp(base + sizeof(CacheFileHeader), identity, identity_length) != 0)
+    return false;
+  /* One row per bar, and the warm-up prefix cannot outrun the rows */
+  return h->values_offset % CACHE_VALUE_ALIGNMENT == 0 && h->values_offset <= size &&
+         h->value_count == key->bar_count && h->valid_from <= h->value_count &&
+         h->value_count <= (size - h->values_offset) / sizeof(double) / h->column_count;
+}
+
+static SamtraderIndicatorSeries *indicator_cache_lookup(SamtraderIndicatorCachePort *port,
+                                                        Samrena *arena,
+                                                        const SamtraderIndicatorCacheKey *key) {
+  if (!port || !port->impl || !arena || !key_valid(key))
+    return NULL;
+  IndicatorCacheImpl *impl = (IndicatorCacheImpl *)port->impl;
+
+  char identity[CACHE_IDENTITY_MAX];
+  char path[CACHE_PATH_MAX];
+  int fd = -1;
+  if (format_identity(identity, sizeof(identity), key) >= 0 &&
+      entry_path(path, sizeof(path), impl, identity, key->data_hash) >= 0)
+    fd = open(path, O_RDONLY);
+
+  void *base = MAP_FAILED;
+  size_t size = 0;
+  struct stat st;
+  if (fd >= 0 && fstat(fd, &st) == 0 && st.st_size > 0) {
+    size = (size_t)st.st_size;
+    base = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  if (base != MAP_FAILED && !validate_file((const uint8_t *)base, size, identity, key)) {
+    munmap(base, size);
+    base = MAP_FAILED;
+  }
+  if (base != MAP_FAILED)
+    futimens(fd, NULL); /* mark as recently used */
+  if (fd >= 0)
+    close(fd); /* the mapping keeps the file referenced */
+
+  SamtraderIndicatorSeries *series = NULL;
+  if (base != MAP_FAILED) {
+    const CacheFileHeader *h = (const CacheFileHeader *)base;
+    series = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderIndicatorSeries);
+    if (series) {
+      /* Columns over the read-only mapping; capacity == size, so never written */
+      const double *column = (const double *)((const uint8_t *)base + h->values_offset);
+      series->type = (SamtraderIndicatorType)h->indicator_type;
+      series->params.period = h->period;
+      series->params.param2 = h->param2;
+      series->params.param3 = h->param3;
+      series->params.param_double = h->param_double;
+      series->size = h->value_count;
+      series->capacity = h->value_count;
+      series->valid_from = h->valid_from;
+      series->column_count = h->column_count;
+      for (size_t c = 0; c < series->column_count; c++)
+        series->columns[c] = (double *)(uintptr_t)(column + c * h->value_count);
+      series->dates = key->dates;
+      series->arena = arena;
+    }
+  }
+
+  pthread_mutex_lock(&impl->lock);
+  CacheMapping *record = series ? SAMRENA_PUSH_TYPE(impl->records, CacheMapping) : NULL;
+  if (record) {
+    record->base = base;
+    record->size = size;
+    record->next = impl->mappings;
+    impl->mappings = record;
+    impl->stats.hits++;
+  } else {
+    if (base != MAP_FAILED)
+      munmap(base, size);
+    series = NULL;
+    impl->stats.misses++;
+  }
+  pthread_mutex_unlock(&impl->lock);
+  return series;
+}
+
+static bool write_all(FILE *fp, const void *data, size_t size) {
+  return size == 0 || fwrite(data, 1, size, fp) == size;
+}
+
+static int indicator_cache_store(SamtraderIndicatorCachePort *port,
+                                 const SamtraderIndicatorCacheKey *key,
+                                 const SamtraderIndicatorSeries *series) {
+  if (!port || !port->impl || !key_valid(key) || !series || series->column_count == 0 ||
+      series->column_count > SAMTRADER_INDICATOR_MAX_COLUMNS || series->size != key->bar_count)
+    return -1;
+  IndicatorCacheImpl *impl = (IndicatorCacheImpl *)port->impl;
+
+  char identity[CACHE_IDENTITY_MAX];
+  char path[CACHE_PATH_MAX];
+  char tmp_path[CACHE_PATH_MAX];
+  int identity_len = format_identity(identity, sizeof(identity), key);
+  if (identity_len < 0 || entry_path(path, sizeof(path), impl, identity, key->data_hash) < 0)
+    return -1;
+  snprintf(tmp_path, sizeof(tmp_path), "%s/.tmp-XXXXXX", impl->directory);
+
+  size_t value_count = series->size;
+  size_t column_bytes = value_count * sizeof(double);
+  CacheFileHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, SAMTRADER_INDICATOR_CACHE_MAGIC, sizeof(header.magic));
+  header.version = SAMTRADER_INDICATOR_CACHE_VERSION;
+  header.byte_order = CACHE_BYTE_ORDER_MARK;
+  header.column_count = (uint32_t)series->column_count;
+  header.indicator_type = (int32_t)series->type;
+  header.data_hash = key->data_hash;
+  header.bar_count = key->bar_count;
+  header.value_count = value_count;
+  header.identity_length = (uint64_t)identity_len + 1;
+  header.values_offset =
+      align_up(sizeof(CacheFileHeader) + header.identity_length, CACHE_VALUE_ALIGNMENT);
+  header.file_size = header.values_offset + series->column_count * column_bytes;
+  header.period = series->params.period;
+  header.param2 = series->params.param2;
+  header.param3 = series->params.param3;
+  header.param_double = series->params.param_double;
+  header.valid_from = series->valid_from < value_count ? series->valid_from : value_count;
+
+  /* Write beside the target and rename, so readers never see a partial file */
+  static const uint8_t zeros[CACHE_VALUE_ALIGNMENT] = {0};
+  int fd = mkstemp(tmp_path);
+  FILE *fp = fd >= 0 ? fdopen(fd, "wb") : NULL;
+  bool ok = fp != NULL;
+  if (!fp && fd >= 0)
+    close(fd);
+  ok = ok && write_all(fp, &header, sizeof(header)) &&
+       write_all(fp, identity, (size_t)header.identity_length) &&
+       write_all(fp, zeros,
+                 (size_t)(header.values_offset - sizeof(header) - header.identity_length));
+  for (size_t c = 0; ok && c < series->column_count; c++)
+    ok = write_all(fp, series->columns[c], column_bytes);
+  if (fp && fclose(fp) != 0)
+    ok = false;
+  if (fd >= 0 && (!ok || rename(tmp_path, path) != 0)) {
+    remove(tmp_path);
+    ok = false;
+  }
+  if (!ok)
+    return -1;
+
+  pthread_mutex_lock(&impl->lock);
+  impl->stats.stores++;
+  impl->total_bytes += (size_t)header.file_size;
+  impl->stats.bytes = impl->total_bytes;
+  if (impl->max_bytes > 0 && impl->total_bytes > impl->max_bytes)
+    shrink_locked(impl, impl->max_bytes / 4 * 3);
+  pthread_mutex_unlock(&impl->lock);
+  return 0;
+}
+
+int samtrader_indicator_cache_stats(SamtraderIndicatorCachePort *port,
+                                    SamtraderIndicatorCacheStats *out) {
+  if (!port || !port->impl || port->close != indicator_cache_close || !out)
+    return -1;
+  IndicatorCacheImpl *impl = (IndicatorCacheImpl *)port->impl;
+  pthread_mutex_lock(&impl->lock);
+  *out = impl->stats;
+  pthread_mutex_unlock(&impl->lock);
+  return 0;
+}
+
+static void indicator_cache_close(SamtraderIndicatorCachePort *port) {
+  if (!port || !port->impl)
+    return;
+
+  IndicatorCacheImpl *impl = (IndicatorCacheImpl *)port->impl;
+  if (!impl->records)
+    return;
+  for (CacheMapping *m = impl->mappings; m; m = m->next)
+    munmap(m->base, m->size);
+  impl->mappings = NULL;
+  pthread_mutex_destroy(&impl->lock);
+  samrena_destroy(impl->records);
+  impl->records = NULL;
+}
@@ -0,0 +1,515 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "samtrader/adapters/mmap_cache_adapter.h"
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <samvector.h>
+
+#define CACHE_BYTE_ORDER_MARK 0x01020304u
+#define CACHE_BLOCK_ALIGNMENT 64
+#define CACHE_COLUMN_COUNT 6
+
+_Static_assert(sizeof(time_t) == sizeof(int64_t), "cache dates are stored as int64");
+
+/* On-disk header (64 bytes) */
+typedef struct {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint64_t symbol_count;
+  uint64_t directory_offset;
+  uint64_t file_size;
+  uint8_t reserved[24];
+} CacheHeader;
+
+/* On-disk symbol directory entry (64 bytes) */
+typedef struct {
+  char code[SAMTRADER_MMAP_CACHE_CODE_MAX + 1];
+  char exchange[SAMTRADER_MMAP_CACHE_EXCHANGE_MAX + 1];
+  uint64_t bar_count;
+  uint64_t data_offset;
+  uint8_t reserved[8];
+} CacheEntry;
+
+_Static_assert(sizeof(CacheHeader) == 64, "cache header must be 64 bytes");
+_Static_assert(sizeof(CacheEntry) == 64, "cache directory entry must be 64 bytes");
+
+/**
+ * @brief Internal structure holding the mapped cache file.
+ */
+typedef struct {
+  const uint8_t *base;
+  size_t size;
+  const CacheEntry *entries;
+  size_t entry_count;
+} MmapCacheImpl;
+
+static SamrenaVector *mmap_cache_fetch_ohlcv(SamtraderDataPort *port, const char *code,
+                                             const char *exchange, time_t start_date,
+                                             time_t end_date);
+static SamrenaVector **mmap_cache_fetch_ohlcv_batch(SamtraderDataPort *port,
+                                                    const char *const *codes, size_t code_count,
+                                                    const char *exchange, time_t start_date,
+                                                    time_t end_date);
+static int mmap_cache_fetch_summary(SamtraderDataPort *port, const char *code,
+                                    const char *exchange, time_t start_date, time_t end_date,
+                                    SamtraderOhlcvSummary *out);
+static SamrenaVector *mmap_cache_list_symbols(SamtraderDataPort *port, const char *exchange);
+static void mmap_cache_close(SamtraderDataPort *port);
+
+static uint64_t align_up(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+/* Directory order: exchange, then code */
+static int compare_key(const char *exchange_a, const char *code_a, const char *exchange_b,
+                       const char *code_b) {
+  int cmp = strcmp(exchange_a, exchange_b);
+  return cmp != 0 ? cmp : strcmp(code_a, code_b);
+}
+
+static int compare_entries(const void *a, const void *b) {
+  const CacheEntry *ea = (const CacheEntry *)a;
+  const CacheEntry *eb = (const CacheEntry *)b;
+  return compare_key(ea->exchange, ea->code, eb->exchange, eb->code);
+}
+
+/*============================================================================
+ * Writer
+ *============================================================================*/
+
+static bool write_all(FILE *fp, const void *data, size_t size) {
+  return size == 0 || fwrite(data, 1, size, fp) == size;
+}
+
+static bool write_padding(FILE *fp, uint64_t from, uint64_t to) {
+  static const uint8_t zeros[CACHE_BLOCK_ALIGNMENT] = {0};
+  return to >= from && write_all(fp, zeros, (size_t)(to - from));
+}
+
+/* Write one symbol's bars column by column */
+static bool write_columns(FILE *fp, const SamrenaVector *ohlcv) {
+  size_t n = samrena_vector_size(ohlcv);
+  for (int column = 0; column < CACHE_COLUMN_COUNT; column++) {
+    for (size_t i = 0; i < n; i++) {
+      const SamtraderOhlcv *bar = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i);
+      union {
+        int64_t i64;
+        double f64;
+      } value;
+      switch (column) {
+        case 0:
+          value.i64 = (int64_t)bar->date;
+          break;
+        case 1:
+          value.f64 = bar->open;
+          break;
+        case 2:
+          value.f64 = bar->high;
+          break;
+        case 3:
+          value.f64 = bar->low;
+          break;
+        case 4:
+          value.f64 = bar->close;
+          break;
+        default:
+          value.i64 = bar->volume;
+          break;
+      }
+      if (!write_all(fp, &value, sizeof(value)))
+        return false;
+    }
+  }
+  return true;
+}
+
+/* A symbol queued for writing, paired with its fetched bars */
+typedef struct {
+  CacheEntry entry;
+  const SamrenaVector *ohlcv;
+} CacheSymbol;
+
+static int compare_symbols(const void *a, const void *b) {
+  return compare_entries(&((const CacheSymbol *)a)->entry, &((const CacheSymbol *)b)->entry);
+}
+
+/* Write header, directory and column blocks for symbols sorted in directory order */
+static bool write_cache_file(FILE *fp, CacheSymbol *symbols, size_t count) {
+  uint64_t directory_offset = sizeof(CacheHeader);
+  uint64_t directory_end = directory_offset + count * sizeof(CacheEntry);
+  uint64_t offset = align_up(directory_end, CACHE_BLOCK_ALIGNMENT);
+  for (size_t i = 0; i < count; i++) {
+    symbols[i].entry.data_offset = offset;
+    offset = align_up(offset + symbols[i].entry.bar_count * CACHE_COLUMN_COUNT * sizeof(int64_t),
+                      CACHE_BLOCK_ALIGNMENT);
+  }
+
+  CacheHeader header = {0};
+  memcpy(header.magic, SAMTRADER_MMAP_CACHE_MAGIC, sizeof(header.magic));
+  header.version = SAMTRADER_MMAP_CACHE_VERSION;
+  header.byte_order = CACHE_BYTE_ORDER_MARK;
+  header.symbol_count = count;
+  header.directory_offset = directory_offset;
+  header.file_size = offset;
+
+  bool ok = write_all(fp, &header, sizeof(header));
+  for (size_t i = 0; ok && i < count; i++)
+    ok = write_all(fp, &symbols[i].entry, sizeof(CacheEntry));
+
+  uint64_t pos = directory_end;
+  for (size_t i = 0; ok && i < count; i++) {
+    const CacheEntry *e = &symbols[i].entry;
+    ok = write_padding(fp, pos, e->data_offset) && write_columns(fp, symbols[i].ohlcv);
+    pos = e->data_offset + e->bar_count * CACHE_COLUMN_COUNT * sizeof(int64_t);
+  }
+  return ok && write_padding(fp, pos, offset);
+}
+
+int samtrader_mmap_cache_build(const char *path, SamtraderDataPort *source,
+                               const char *const *codes, size_t code_count, const char *exchange,
+                               time_t start_date, time_t end_date) {
+  if (!path || !source || !source->arena || !codes || code_count == 0 || !exchange)
+    return -1;
+  if (strlen(exchange) > SAMTRADER_MMAP_CACHE_EXCHANGE_MAX)
+    return -1;
+  for (size_t i = 0; i < code_count; i++) {
+    if (!codes[i] || strlen(codes[i]) > SAMTRADER_MMAP_CACHE_CODE_MAX)
+      return -1;
+  }
+
+  Samrena *arena = source->arena;
+  SamrenaVector **ohlcv = NULL;
+  if (source->fetch_ohlcv_batch) {
+    ohlcv = source->fetch_ohlcv_batch(source, codes, code_count, exchange, start_date, end_date);
+  } else {
+    ohlcv = SAMRENA_PUSH_ARRAY_ZERO(arena, SamrenaVector *, code_count);
+    for (size_t i = 0; ohlcv && i < code_count; i++) {
+      ohlcv[i] = source->fetch_ohlcv(source, codes[i], exchange, start_date, end_date);
+      if (!ohlcv[i])
+        ohlcv = NULL;
+    }
+  }
+  if (!ohlcv)
+    return -1;
+
+  CacheSymbol *symbols = SAMRENA_PUSH_ARRAY_ZERO(arena, CacheSymbol, code_count);
+  if (!symbols)
+    return -1;
+  for (size_t i = 0; i < code_count; i++) {
+    if (!ohlcv[i])
+      return -1;
+    strcpy(symbols[i].entry.code, codes[i]);
+    strcpy(symbols[i].entry.exchange, exchange);
+    symbols[i].entry.bar_count = samrena_vector_size(ohlcv[i]);
+    symbols[i].ohlcv = ohlcv[i];
+  }
+  qsort(symbols, code_count, sizeof(CacheSymbol), compare_symbols);
+  for (size_t i = 1; i < code_count; i++) {
+    if (compare_entries(&symbols[i - 1].entry, &symbols[i].entry) == 0)
+      return -1; /* duplicate code */
+  }
+
+  /* Write beside the target and rename, so readers never see a partial file */
+  size_t tmp_len = strlen(path) + 5;
+  char *tmp_path = (char *)samrena_push(arena, tmp_len);
+  if (!tmp_path)
+    return -1;
+  snprintf(tmp_path, tmp_len, "%s.tmp", path);
+
+  FILE *fp = fopen(tmp_path, "wb");
+  if (!fp)
+    return -1;
+  bool ok = write_cache_file(fp, symbols, code_count);
+  if (fclose(fp) != 0)
+    ok = false;
+  if (!ok || rename(tmp_path, path) != 0) {
+    remove(tmp_path);
+    return -1;
+  }
+  return 0;
+}
+
+/*============================================================================
+ * Reader
+ *============================================================================*/
+
+static bool validate_mapping(const uint8_t *base, size_t size) {
+  if (size < sizeof(CacheHeader))
+    return false;
+  const CacheHeader *header = (const CacheHeader *)base;
+  if (memcmp(header->magic, SAMTRADER_MMAP_CACHE_MAGIC, sizeof(header->magic)) != 0 ||
+      header->version != SAMTRADER_MMAP_CACHE_VERSION ||
+      header->byte_order != CACHE_BYTE_ORDER_MARK || header->file_size != size)
+    return false;
+  if (header->directory_offset != sizeof(CacheHeader) ||
+      header->symbol_count > (size - sizeof(CacheHeader)) / sizeof(CacheEntry))
+    return false;
+
+  const CacheEntry *entries = (const CacheEntry *)(base + header->directory_offset);
+  for (uint64_t i = 0; i < header->symbol_count; i++) {
+    const CacheEntry *e = &entries[i];
+    if (memchr(e->code, '\0', sizeof(e->code)) == NULL ||
+        memchr(e->exchange, '\0', sizeof(e->exchange)) == NULL)
+      return false;
+    if (e->data_offset % CACHE_BLOCK_ALIGNMENT != 0 || e->data_offset > size ||
+        e->bar_count > (size - e->data_offset) / (CACHE_COLUMN_COUNT * sizeof(int64_t)))
+      return false;
+    if (i > 0 && compare_entries(&entries[i - 1], e) >= 0)
+      return false;
+  }
+  return true;
+}
+
+SamtraderDataPort *samtrader_mmap_cache_adapter_create(Samrena *arena, const char *path) {
+  if (!arena || !path)
+    return NULL;
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return NULL;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return NULL;
+  }
+  size_t size = (size_t)st.st_size;
+  void *base = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd); /* the mapping keeps the file referenced */
+  if (base == MAP_FAILED)
+    return NULL;
+
+  if (!validate_mapping((const uint8_t *)base, size)) {
+    munmap(base, size);
+    return NULL;
+  }
+
+  MmapCacheImpl *impl = SAMRENA_PUSH_TYPE_ZERO(arena, MmapCacheImpl);
+  SamtraderDataPort *port = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderDataPort);
+  if (!impl || !port) {
+    munmap(base, size);
+    return NULL;
+  }
+  const CacheHeader *header = (const CacheHeader *)base;
+  impl->base = (const uint8_t *)base;
+  impl->size = size;
+  impl->entries = (const CacheEntry *)(impl->base + header->directory_offset);
+  impl->entry_count = (size_t)header->symbol_count;
+
+  port->impl = impl;
+  port->arena = arena;
+  port->fetch_ohlcv = mmap_cache_fetch_ohlcv;
+  port->fetch_ohlcv_batch = mmap_cache_fetch_ohlcv_batch;
+  port->fetch_bars = samtrader_mmap_cache_view;
+  port->fetch_summary = mmap_cache_fetch_summary;
+  port->list_symbols = mmap_cache_list_symbols;
+  port->close = mmap_cache_close;
+  return port;
+}
+
+static const CacheEntry *find_entry(const MmapCacheImpl *impl, const char *code,
+                                    const char *exchange) {
+  size_t lo = 0;
+  size_t hi = impl->entry_count;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    const CacheEntry *e = &impl->entries[mid];
+    int cmp = compare_key(e->exchange, e->code, exchange, code);
+    if (cmp == 0)
+      return e;
+    if (cmp < 0)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return NULL;
+}
+
+/* First index in dates[0, n) whose date is >= target (or > target when after is set) */
+static size_t date_bound(const int64_t *dates, size_t n, int64_t target, bool after) {
+  size_t lo = 0;
+  size_t hi = n;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (dates[mid] < target || (after && dates[mid] == target))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+int samtrader_mmap_cache_view(SamtraderDataPort *port, const char *code, const char *exchange,
+                              time_t start_date, time_t end_date, SamtraderBarColumns *out) {
+  if (!port || !port->impl || port->close != mmap_cache_close || !code || !exchange || !out)
+    return -1;
+
+  const MmapCacheImpl *impl = (const MmapCacheImpl *)port->impl;
+  if (!impl->base)
+    return -1;
+  const CacheEntry *e = find_entry(impl, code, exchange);
+  if (!e)
+    return -1;
+
+  size_t n = (size_t)e->bar_count;
+  const int64_t *block = (const int64_t *)(impl->base + e->data_offset);
+  size_t begin = date_bound(block, n, (int64_t)start_date, false);
+  size_t end = date_bound(block, n, (int64_t)end_date, true);
+
+  memset(out, 0, sizeof(*out));
+  out->code = e->code;
+  out->exchange = e->exchange;
+  if (end <= begin)
+    return 0;
+
+  /* The mapping is read-only; the view is exposed through the mutable struct type */
+  out->count = end - begin;
+  out->date = (time_t *)(uintptr_t)(block + begin);
+  out->open = (double *)(uintptr_t)(block + n + begin);
+  out->high = (double *)(uintptr_t)(block + 2 * n + begin);
+  out->low = (double *)(uintptr_t)(block + 3 * n + begin);
+  out->close = (double *)(uintptr_t)(block + 4 * n + begin);
+  out->volume = (int64_t *)(uintptr_t)(block + 5 * n + begin);
+  return 0;
+}
+
+static SamrenaVector *mmap_cache_fetch_ohlcv(SamtraderDataPort *port, const char *code,
+                                             const char *exchange, time_t start_date,
+                                             time_t end_date) {
+  if (!port || !port->impl || !code || !exchange)
+    return NULL;
+
+  SamtraderBarColumns view;
+  if (samtrader_mmap_cache_view(port, code, exchange, start_date, end_date, &view) < 0) {
+    /* Unknown symbols have no rows, as with the database adapter */
+    return samtrader_ohlcv_vector_create(port->arena, 0);
+  }
+
+  /* Bars must outlive the mapping, so they reference arena copies of the names */
+  size_t code_len = strlen(view.code) + 1;
+  size_t exchange_len = strlen(view.exchange) + 1;
+  char *code_copy = (char *)samrena_push(port->arena, code_len + exchange_len);
+  if (!code_copy)
+    return NULL;
+  char *exchange_copy = code_copy + code_len;
+  memcpy(code_copy, view.code, code_len);
+  memcpy(exchange_copy, view.exchange, exchange_len);
+
+  SamrenaVector *ohlcv_vec = samtrader_ohlcv_vector_create(port->arena, view.count);
+  if (!ohlcv_vec)
+    return NULL;
+  for (size_t i = 0; i < view.count; i++) {
+    SamtraderOhlcv bar = {.code = code_copy,
+                          .exchange = exchange_copy,
+                          .date = view.date[i],
+                          .open = view.open[i],
+                          .high = view.high[i],
+                          .low = view.low[i],
+                          .close = view.close[i],
+                          .volume = view.volume[i]};
+    if (!samrena_vector_push(ohlcv_vec, &bar))
+      return NULL;
+  }
+  return ohlcv_vec;
+}
+
+static SamrenaVector **mmap_cache_fetch_ohlcv_batch(SamtraderDataPort *port,
+                                                    const char *const *codes, size_t code_count,
+                                                    const char *exchange, time_t start_date,
+                                                    time_t end_date) {
+  if (!port || !port->impl || !codes || code_count == 0 || !exchange)
+    return NULL;
+
+  SamrenaVector **out = SAMRENA_PUSH_ARRAY_ZERO(port->arena, SamrenaVector *, code_count);
+  if (!out)
+    return NULL;
+  for (size_t i = 0; i < code_count; i++) {
+    out[i] = mmap_cache_fetch_ohlcv(port, codes[i], exchange, start_date, end_date);
+    if (!out[i])
+      return NULL;
+  }
+  return out;
+}
+
+static int mmap_cache_fetch_summary(SamtraderDataPort *port, const char *code,
+                                    const char *exchange, time_t start_date, time_t end_date,
+                                    SamtraderOhlcvSummary *out) {
+  if (!port || !port->impl || !code || !exchange || !out)
+    return -1;
+
+  memset(out, 0, sizeof(*out));
+  SamtraderBarColumns view;
+  if (samtrader_mmap_cache_view(port, code, exchange, start_date, end_date, &view) < 0 ||
+      view.count == 0)
+    return 0; /* unknown symbols have no bars */
+
+  out->bar_count = view.count;
+  out->first_date = view.date[0];
+  out->last_date = view.date[view.count - 1];
+  out->first_close = view.close[0];
+  out->last_close = view.close[view.count - 1];
+  return 0;
+}
+
+static SamrenaVector *mmap_cache_list_symbols(SamtraderDataPort *port, const char *exchange) {
+  if (!port || !port->impl)
+    return NULL;
+
+  const MmapCacheImpl *impl = (const MmapCacheImpl *)port->impl;
+  SamrenaVector *symbols_vec =
+      samrena_vector_init(port->arena, sizeof(const char *), impl->entry_count + 1);
+  if (!symbols_vec)
+    return NULL;
+
+  for (size_t i = 0; impl->base && i < impl->entry_count; i++) {
+    const CacheEntry *e = &impl->entries[i];
+    if (exchange && strcmp(e->exchange, exchange) != 0)
+      continue;
+    size_t len = strlen(e->code) + 1;
+    char *code_copy = (char *)samrena_push(port->arena, len);
+    if (!code_copy)
+      return NULL;
+    memcpy(code_copy, e->code, len);
+    if (!samrena_vector_push(symbols_vec, &code_copy))
+      return NULL;
+  }
+  return symbols_vec;
+}
+
+static void mmap_cache_close(SamtraderDataPort *port) {
+  if (!port || !port->impl)
+    return;
+
+  MmapCacheImpl *impl = (MmapCacheImpl *)port->impl;
+  if (impl->base) {
+    munmap((void *)(uintptr_t)impl->base, impl->size);
+    impl->base = NULL;
+    impl->entries = NULL;
+    impl->entry_count = 0;
+  }
+}
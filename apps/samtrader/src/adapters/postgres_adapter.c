@@ -14,54 +14,197 @@
  * limitations under the License.
  */
 
-#define _GNU_SOURCE /* For timegm */
-
 #include "samtrader/adapters/postgres_adapter.h"
 
 #include <libpq-fe.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <samdata/samhashmap.h>
+
 #include "samtrader/domain/ohlcv.h"
 #include "samtrader/samtrader.h"
 
+/* Days from the Unix epoch to the PostgreSQL epoch (2000-01-01) */
+#define PG_EPOCH_UNIX_DAYS 10957
+#define SECONDS_PER_DAY 86400
+
+#define FETCH_STMT "samtrader_fetch_ohlcv"
+#define FETCH_BATCH_STMT "samtrader_fetch_ohlcv_batch"
+#define SUMMARY_STMT "samtrader_ohlcv_summary"
+
+/*
+ * Prices are numeric in the table; casting to float8/int8/timestamptz lets
+ * the rows come back in binary and be decoded without any text parsing.
+ * The timestamptz cast keeps intraday bar times; a DATE column becomes
+ * midnight UTC because the session time zone is pinned to UTC.
+ */
+#define OHLCV_COLUMNS                                                                              \
+  "date::timestamptz, open::float8, high::float8, low::float8, close::float8, volume::int8"
+
+static const char *const fetch_query = "SELECT " OHLCV_COLUMNS " FROM ohlcv "
+                                       "WHERE code = $1 AND exchange = $2 "
+                                       "AND date >= $3 AND date <= $4 "
+                                       "ORDER BY date ASC";
+
+static const char *const fetch_batch_query = "SELECT code, " OHLCV_COLUMNS " FROM ohlcv "
+                                             "WHERE code = ANY($1) AND exchange = $2 "
+                                             "AND date >= $3 AND date <= $4 "
+                                             "ORDER BY code, date ASC";
+
+#define SUMMARY_RANGE "WHERE code = $1 AND exchange = $2 AND date >= $3 AND date <= $4"
+
+/* Endpoint closes come from index-ordered LIMIT 1 lookups, not from the rows themselves */
+static const char *const summary_query =
+    "SELECT count(*)::int8, min(date)::timestamptz, max(date)::timestamptz, "
+    "(SELECT close::float8 FROM ohlcv " SUMMARY_RANGE " ORDER BY date ASC LIMIT 1), "
+    "(SELECT close::float8 FROM ohlcv " SUMMARY_RANGE " ORDER BY date DESC LIMIT 1) "
+    "FROM ohlcv " SUMMARY_RANGE;
+
 /**
  * @brief Internal structure holding PostgreSQL adapter state.
  */
 typedef struct {
   PGconn *conn;
+  bool fetch_prepared;       /* FETCH_STMT prepared on this connection */
+  bool fetch_batch_prepared; /* FETCH_BATCH_STMT prepared on this connection */
+  bool summary_prepared;     /* SUMMARY_STMT prepared on this connection */
 } PostgresAdapterImpl;
 
 /* Forward declarations of interface functions */
 static SamrenaVector *postgres_fetch_ohlcv(SamtraderDataPort *port, const char *code,
                                            const char *exchange, time_t start_date,
                                            time_t end_date);
+static SamrenaVector **postgres_fetch_ohlcv_batch(SamtraderDataPort *port,
+                                                  const char *const *codes, size_t code_count,
+                                                  const char *exchange, time_t start_date,
+                                                  time_t end_date);
+static int postgres_fetch_summary(SamtraderDataPort *port, const char *code,
+                                  const char *exchange, time_t start_date, time_t end_date,
+                                  SamtraderOhlcvSummary *out);
 static SamrenaVector *postgres_list_symbols(SamtraderDataPort *port, const char *exchange);
 static void postgres_close(SamtraderDataPort *port);
 
-/* Helper to convert time_t to ISO 8601 string */
+/*
+ * Helper to convert time_t to an ISO 8601 UTC timestamp. A DATE column
+ * compared against it drops the time part, so daily tables still match.
+ */
 static void time_to_iso8601(time_t t, char *buf, size_t buf_size) {
   struct tm *tm_info = gmtime(&t);
-  strftime(buf, buf_size, "%Y-%m-%d", tm_info);
+  strftime(buf, buf_size, "%Y-%m-%d %H:%M:%S+00", tm_info);
 }
 
-/* Helper to parse timestamp from PostgreSQL to time_t */
-static time_t parse_pg_timestamp(const char *str) {
-  struct tm tm_info = {0};
-  int year, month, day;
-
-  if (sscanf(str, "%d-%d-%d", &year, &month, &day) == 3) {
-    tm_info.tm_year = year - 1900;
-    tm_info.tm_mon = month - 1;
-    tm_info.tm_mday = day;
-    tm_info.tm_hour = 0;
-    tm_info.tm_min = 0;
-    tm_info.tm_sec = 0;
-    return timegm(&tm_info);
+/* Helper to copy a string into the arena */
+static const char *arena_strdup(Samrena *arena, const char *src) {
+  size_t len = strlen(src) + 1;
+  char *copy = (char *)samrena_push(arena, len);
+  if (copy)
+    memcpy(copy, src, len);
+  return copy;
+}
+
+/* --- Binary result decoding (network byte order) --- */
+
+static uint64_t read_be64(const char *p) {
+  const unsigned char *b = (const unsigned char *)p;
+  return ((uint64_t)b[0] << 56) | ((uint64_t)b[1] << 48) | ((uint64_t)b[2] << 40) |
+         ((uint64_t)b[3] << 32) | ((uint64_t)b[4] << 24) | ((uint64_t)b[5] << 16) |
+         ((uint64_t)b[6] << 8) | (uint64_t)b[7];
+}
+
+static double pg_float8(const PGresult *result, int row, int col) {
+  uint64_t bits = read_be64(PQgetvalue(result, row, col));
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+static int64_t pg_int8(const PGresult *result, int row, int col) {
+  return (int64_t)read_be64(PQgetvalue(result, row, col));
+}
+
+/* timestamptz is int64 microseconds since the PostgreSQL epoch, in UTC */
+static time_t pg_timestamp(const PGresult *result, int row, int col) {
+  int64_t usecs = pg_int8(result, row, col);
+  int64_t secs = usecs / 1000000;
+  if (usecs % 1000000 < 0)
+    secs--;
+  return (time_t)(secs + (int64_t)PG_EPOCH_UNIX_DAYS * SECONDS_PER_DAY);
+}
+
+/* Check the six OHLCV columns starting at col have their binary widths */
+static bool row_has_binary_widths(const PGresult *result, int row, int col) {
+  return PQgetlength(result, row, col) == 8 && PQgetlength(result, row, col + 1) == 8 &&
+         PQgetlength(result, row, col + 2) == 8 && PQgetlength(result, row, col + 3) == 8 &&
+         PQgetlength(result, row, col + 4) == 8 && PQgetlength(result, row, col + 5) == 8;
+}
+
+/*
+ * Decode rows [row_begin, row_end) into a new vector. The OHLCV columns
+ * start at col; every bar shares the given code and exchange strings.
+ */
+static SamrenaVector *decode_rows(Samrena *arena, const PGresult *result, int row_begin,
+                                  int row_end, int col, const char *code, const char *exchange) {
+  SamrenaVector *ohlcv_vec = samtrader_ohlcv_vector_create(arena, (uint64_t)(row_end - row_begin));
+  if (!ohlcv_vec)
+    return NULL;
+
+  for (int i = row_begin; i < row_end; i++) {
+    if (!row_has_binary_widths(result, i, col))
+      return NULL;
+    SamtraderOhlcv bar = {.code = code,
+                          .exchange = exchange,
+                          .date = pg_timestamp(result, i, col),
+                          .open = pg_float8(result, i, col + 1),
+                          .high = pg_float8(result, i, col + 2),
+                          .low = pg_float8(result, i, col + 3),
+                          .close = pg_float8(result, i, col + 4),
+                          .volume = pg_int8(result, i, col + 5)};
+    if (!samrena_vector_push(ohlcv_vec, &bar))
+      return NULL;
   }
+  return ohlcv_vec;
+}
 
-  return 0;
+/* Prepare a statement once per connection */
+static bool ensure_prepared(PostgresAdapterImpl *impl, bool *prepared, const char *name,
+                            const char *query, int param_count) {
+  if (*prepared)
+    return true;
+  PGresult *result = PQprepare(impl->conn, name, query, param_count, NULL);
+  *prepared = PQresultStatus(result) == PGRES_COMMAND_OK;
+  PQclear(result);
+  return *prepared;
+}
+
+/* Build a text[] literal such as {"CBA","BHP"}, escaping quotes and backslashes */
+static char *build_text_array(Samrena *arena, const char *const *items, size_t count) {
+  size_t cap = 3;
+  for (size_t i = 0; i < count; i++)
+    cap += strlen(items[i]) * 2 + 3;
+  char *out = (char *)samrena_push(arena, cap);
+  if (!out)
+    return NULL;
+
+  size_t len = 0;
+  out[len++] = '{';
+  for (size_t i = 0; i < count; i++) {
+    if (i > 0)
+      out[len++] = ',';
+    out[len++] = '"';
+    for (const char *p = items[i]; *p; p++) {
+      if (*p == '"' || *p == '\\')
+        out[len++] = '\\';
+      out[len++] = *p;
+    }
+    out[len++] = '"';
+  }
+  out[len++] = '}';
+  out[len] = '\0';
+  return out;
 }
 
 SamtraderDataPort *samtrader_postgres_adapter_create(Samrena *arena, const char *conninfo) {
@@ -84,6 +227,15 @@ SamtraderDataPort *samtrader_postgres_adapter_create(Samrena *arena, const char
   }
   impl->conn = conn;
 
+  /* Timestamps are decoded and formatted as UTC */
+  PGresult *tz = PQexec(conn, "SET TIME ZONE 'UTC'");
+  bool tz_ok = PQresultStatus(tz) == PGRES_COMMAND_OK;
+  PQclear(tz);
+  if (!tz_ok) {
+    PQfinish(conn);
+    return NULL;
+  }
+
   /* Allocate the data port */
   SamtraderDataPort *port = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderDataPort);
   if (!port) {
@@ -94,6 +246,8 @@ SamtraderDataPort *samtrader_postgres_adapter_create(Samrena *arena, const char
   port->impl = impl;
   port->arena = arena;
   port->fetch_ohlcv = postgres_fetch_ohlcv;
+  port->fetch_ohlcv_batch = postgres_fetch_ohlcv_batch;
+  port->fetch_summary = postgres_fetch_summary;
   port->list_symbols = postgres_list_symbols;
   port->close = postgres_close;
 
@@ -110,87 +264,162 @@ static SamrenaVector *postgres_fetch_ohlcv(SamtraderDataPort *port, const char *
   PostgresAdapterImpl *impl = (PostgresAdapterImpl *)port->impl;
   Samrena *arena = port->arena;
 
+  if (!ensure_prepared(impl, &impl->fetch_prepared, FETCH_STMT, fetch_query, 4)) {
+    return NULL;
+  }
+
   /* Convert dates to ISO 8601 strings */
   char start_str[32];
   char end_str[32];
   time_to_iso8601(start_date, start_str, sizeof(start_str));
   time_to_iso8601(end_date, end_str, sizeof(end_str));
 
-  /* Build query with parameters for SQL injection prevention */
-  const char *query = "SELECT code, exchange, date, open, high, low, close, volume "
-                      "FROM ohlcv "
-                      "WHERE code = $1 AND exchange = $2 AND date >= $3 AND date <= $4 "
-                      "ORDER BY date ASC";
-
+  /* Text parameters, binary results */
   const char *param_values[4] = {code, exchange, start_str, end_str};
-
-  PGresult *result = PQexecParams(impl->conn, query, 4, NULL, param_values, NULL, NULL, 0);
+  PGresult *result = PQexecPrepared(impl->conn, FETCH_STMT, 4, param_values, NULL, NULL, 1);
 
   if (PQresultStatus(result) != PGRES_TUPLES_OK) {
     PQclear(result);
     return NULL;
   }
 
-  int num_rows = PQntuples(result);
-  if (num_rows == 0) {
-    PQclear(result);
-    /* Return empty vector, not NULL (no error, just no data) */
-    return samtrader_ohlcv_vector_create(arena, 0);
+  /* Every bar shares one copy of the code and exchange strings */
+  const char *code_copy = arena_strdup(arena, code);
+  const char *exchange_copy = arena_strdup(arena, exchange);
+  SamrenaVector *ohlcv_vec = NULL;
+  if (code_copy && exchange_copy) {
+    ohlcv_vec = decode_rows(arena, result, 0, PQntuples(result), 0, code_copy, exchange_copy);
   }
 
-  /* Create vector to hold OHLCV records */
-  SamrenaVector *ohlcv_vec = samtrader_ohlcv_vector_create(arena, (uint64_t)num_rows);
-  if (!ohlcv_vec) {
-    PQclear(result);
+  PQclear(result);
+  return ohlcv_vec;
+}
+
+static SamrenaVector **postgres_fetch_ohlcv_batch(SamtraderDataPort *port,
+                                                  const char *const *codes, size_t code_count,
+                                                  const char *exchange, time_t start_date,
+                                                  time_t end_date) {
+  if (!port || !port->impl || !codes || code_count == 0 || !exchange) {
     return NULL;
   }
 
-  /* Get column indices */
-  int col_code = PQfnumber(result, "code");
-  int col_exchange = PQfnumber(result, "exchange");
-  int col_date = PQfnumber(result, "date");
-  int col_open = PQfnumber(result, "open");
-  int col_high = PQfnumber(result, "high");
-  int col_low = PQfnumber(result, "low");
-  int col_close = PQfnumber(result, "close");
-  int col_volume = PQfnumber(result, "volume");
-
-  /* Parse each row */
-  for (int i = 0; i < num_rows; i++) {
-    const char *row_code = PQgetvalue(result, i, col_code);
-    const char *row_exchange = PQgetvalue(result, i, col_exchange);
-    const char *row_date = PQgetvalue(result, i, col_date);
-    const char *row_open = PQgetvalue(result, i, col_open);
-    const char *row_high = PQgetvalue(result, i, col_high);
-    const char *row_low = PQgetvalue(result, i, col_low);
-    const char *row_close = PQgetvalue(result, i, col_close);
-    const char *row_volume = PQgetvalue(result, i, col_volume);
-
-    time_t date = parse_pg_timestamp(row_date);
-    double open = strtod(row_open, NULL);
-    double high = strtod(row_high, NULL);
-    double low = strtod(row_low, NULL);
-    double close = strtod(row_close, NULL);
-    int64_t volume = strtoll(row_volume, NULL, 10);
-
-    /* Create OHLCV record and add to vector */
-    SamtraderOhlcv *ohlcv =
-        samtrader_ohlcv_create(arena, row_code, row_exchange, date, open, high, low, close, volume);
-
-    if (!ohlcv) {
-      PQclear(result);
+  PostgresAdapterImpl *impl = (PostgresAdapterImpl *)port->impl;
+  Samrena *arena = port->arena;
+
+  if (!ensure_prepared(impl, &impl->fetch_batch_prepared, FETCH_BATCH_STMT, fetch_batch_query,
+                       4)) {
+    return NULL;
+  }
+
+  /* Map each code to its output slot; codes are also copied once here */
+  SamHashMap *slots = samhashmap_create(code_count * 2, arena);
+  SamrenaVector **out = SAMRENA_PUSH_ARRAY_ZERO(arena, SamrenaVector *, code_count);
+  size_t *slot_ids = SAMRENA_PUSH_ARRAY(arena, size_t, code_count);
+  const char **code_copies = SAMRENA_PUSH_ARRAY(arena, const char *, code_count);
+  const char *exchange_copy = arena_strdup(arena, exchange);
+  char *code_array = build_text_array(arena, codes, code_count);
+  if (!slots || !out || !slot_ids || !code_copies || !exchange_copy || !code_array) {
+    return NULL;
+  }
+  for (size_t i = 0; i < code_count; i++) {
+    if (!codes[i])
       return NULL;
+    code_copies[i] = arena_strdup(arena, codes[i]);
+    if (!code_copies[i])
+      return NULL;
+    slot_ids[i] = i;
+    samhashmap_put(slots, codes[i], &slot_ids[i]);
+  }
+
+  char start_str[32];
+  char end_str[32];
+  time_to_iso8601(start_date, start_str, sizeof(start_str));
+  time_to_iso8601(end_date, end_str, sizeof(end_str));
+
+  const char *param_values[4] = {code_array, exchange, start_str, end_str};
+  PGresult *result = PQexecPrepared(impl->conn, FETCH_BATCH_STMT, 4, param_values, NULL, NULL, 1);
+
+  if (PQresultStatus(result) != PGRES_TUPLES_OK) {
+    PQclear(result);
+    return NULL;
+  }
+
+  /* Rows are grouped by code; decode each run into its code's vector */
+  int num_rows = PQntuples(result);
+  int run_begin = 0;
+  while (run_begin < num_rows) {
+    const char *run_code = PQgetvalue(result, run_begin, 0);
+    int run_end = run_begin + 1;
+    while (run_end < num_rows && strcmp(PQgetvalue(result, run_end, 0), run_code) == 0)
+      run_end++;
+
+    const size_t *slot = (const size_t *)samhashmap_get(slots, run_code);
+    if (slot) {
+      out[*slot] = decode_rows(arena, result, run_begin, run_end, 1, code_copies[*slot],
+                               exchange_copy);
+      if (!out[*slot]) {
+        PQclear(result);
+        return NULL;
+      }
+    }
+    run_begin = run_end;
+  }
+  PQclear(result);
+
+  /* Codes without rows get an empty vector, as fetch_ohlcv returns */
+  for (size_t i = 0; i < code_count; i++) {
+    if (!out[i]) {
+      out[i] = samtrader_ohlcv_vector_create(arena, 0);
+      if (!out[i])
+        return NULL;
     }
+  }
+  return out;
+}
 
-    /* Add the struct to the vector */
-    if (!samrena_vector_push(ohlcv_vec, ohlcv)) {
+static int postgres_fetch_summary(SamtraderDataPort *port, const char *code,
+                                  const char *exchange, time_t start_date, time_t end_date,
+                                  SamtraderOhlcvSummary *out) {
+  if (!port || !port->impl || !code || !exchange || !out) {
+    return -1;
+  }
+
+  PostgresAdapterImpl *impl = (PostgresAdapterImpl *)port->impl;
+  if (!ensure_prepared(impl, &impl->summary_prepared, SUMMARY_STMT, summary_query, 4)) {
+    return -1;
+  }
+
+  char start_str[32];
+  char end_str[32];
+  time_to_iso8601(start_date, start_str, sizeof(start_str));
+  time_to_iso8601(end_date, end_str, sizeof(end_str));
+
+  const char *param_values[4] = {code, exchange, start_str, end_str};
+  PGresult *result = PQexecPrepared(impl->conn, SUMMARY_STMT, 4, param_values, NULL, NULL, 1);
+  if (PQresultStatus(result) != PGRES_TUPLES_OK || PQntuples(result) != 1 ||
+      PQgetlength(result, 0, 0) != 8) {
+    PQclear(result);
+    return -1;
+  }
+
+  memset(out, 0, sizeof(*out));
+  int64_t count = pg_int8(result, 0, 0);
+  if (count > 0) {
+    /* Columns 1..4 are only NULL when no row matched */
+    if (PQgetlength(result, 0, 1) != 8 || PQgetlength(result, 0, 2) != 8 ||
+        PQgetlength(result, 0, 3) != 8 || PQgetlength(result, 0, 4) != 8) {
       PQclear(result);
-      return NULL;
+      return -1;
     }
+    out->bar_count = (size_t)count;
+    out->first_date = pg_timestamp(result, 0, 1);
+    out->last_date = pg_timestamp(result, 0, 2);
+    out->first_close = pg_float8(result, 0, 3);
+    out->last_close = pg_float8(result, 0, 4);
   }
 
   PQclear(result);
-  return ohlcv_vec;
+  return 0;
 }
 
 static SamrenaVector *postgres_list_symbols(SamtraderDataPort *port, const char *exchange) {
@@ -22,6 +22,7 @@
 #include <string.h>
 #include <time.h>
 
+#include <samtrader/adapters/writer.h>
 #include <samtrader/domain/portfolio.h>
 
 /* Maximum template file size (1MB) */
@@ -43,13 +44,15 @@
 #define CHART_MARGIN_RIGHT 20
 #define CHART_MARGIN_TOP 15
 #define CHART_MARGIN_BOTTOM 40
-#define MAX_CHART_POINTS 200
+#define DEFAULT_CHART_POINTS 200
+#define MIN_CHART_POINTS 3
 
 /**
  * @brief Internal implementation data for Typst report adapter.
  */
 typedef struct {
   const char *template_path; /**< Path to custom template, or NULL */
+  size_t chart_points;       /**< Maximum vertices per chart curve */
 } TypstReportImpl;
 
 /* Forward declarations */
@@ -59,14 +62,18 @@ static bool typst_report_write_multi(SamtraderReportPort *port,
                                      SamtraderMultiCodeResult *multi_result,
                                      SamtraderStrategy *strategy, const char *output_path);
 static void typst_report_close(SamtraderReportPort *port);
-static void write_monthly_returns_table(FILE *out, SamrenaVector *equity_curve);
-static void write_equity_curve_chart(FILE *out, SamrenaVector *equity_curve);
-static void write_drawdown_chart(FILE *out, SamrenaVector *equity_curve);
-static void write_trade_log(FILE *out, SamrenaVector *trades);
-static void write_universe_summary_table(FILE *out, SamtraderCodeResult *results, size_t count);
-static void write_per_code_detail_section(FILE *out, SamtraderCodeResult *cr,
+static void write_monthly_returns_table(SamtraderWriter *out, SamrenaVector *equity_curve);
+static void write_equity_curve_chart(SamtraderWriter *out, SamrenaVector *equity_curve,
+                                     size_t max_points);
+static void write_drawdown_chart(SamtraderWriter *out, SamrenaVector *equity_curve,
+                                 size_t max_points);
+static void write_trade_log(SamtraderWriter *out, SamrenaVector *trades);
+static void write_montecarlo_section(SamtraderWriter *out, const SamtraderMonteCarloResult *mc);
+static void write_universe_summary_table(SamtraderWriter *out, SamtraderCodeResult *results,
+                                         size_t count);
+static void write_per_code_detail_section(SamtraderWriter *out, SamtraderCodeResult *cr,
                                           SamrenaVector *all_trades);
-static void write_full_trade_log(FILE *out, SamrenaVector *trades);
+static void write_full_trade_log(SamtraderWriter *out, SamrenaVector *trades);
 
 /* ============================================================================
  * Template Placeholder Resolution
@@ -192,14 +199,17 @@ static bool resolve_placeholder(const char *key, SamtraderBacktestResult *result
  * Reads the template file, replaces {{PLACEHOLDER}} markers with actual values,
  * and writes the result to the output file.
  *
+ * @param arena Memory arena for the output buffer (released before returning)
  * @param template_path Path to the template file
+ * @param chart_points Maximum vertices per chart curve
  * @param result Backtest results
  * @param strategy Strategy definition
  * @param output_path Output file path
  * @return true on success, false on failure
  */
-static bool write_template_report(const char *template_path, SamtraderBacktestResult *result,
-                                  SamtraderStrategy *strategy, const char *output_path) {
+static bool write_template_report(Samrena *arena, const char *template_path, size_t chart_points,
+                                  SamtraderBacktestResult *result, SamtraderStrategy *strategy,
+                                  const char *output_path) {
   /* Read template file */
   FILE *tmpl_file = fopen(template_path, "r");
   if (tmpl_file == NULL) {
@@ -225,12 +235,15 @@ static bool write_template_report(const char *template_path, SamtraderBacktestRe
   fclose(tmpl_file);
   template_buf[bytes_read] = '\0';
 
-  /* Open output file */
-  FILE *out = fopen(output_path, "w");
-  if (out == NULL) {
+  /* Open output file (its buffer lives in a scratch frame of the arena) */
+  SamrenaScratch scratch = samrena_scratch_begin(arena);
+  SamtraderWriter writer;
+  if (!samtrader_writer_open(&writer, arena, output_path)) {
+    samrena_scratch_end(scratch);
     free(template_buf);
     return false;
   }
+  SamtraderWriter *out = &writer;
 
   /* Process template: scan for {{ }} placeholders */
   const char *pos = template_buf;
@@ -238,18 +251,18 @@ static bool write_template_report(const char *template_path, SamtraderBacktestRe
     const char *open = strstr(pos, "{{");
     if (open == NULL) {
       /* No more placeholders, write remaining text */
-      fputs(pos, out);
+      samtrader_writer_puts(out, pos);
       break;
     }
 
     /* Write text before the placeholder */
-    fwrite(pos, 1, (size_t)(open - pos), out);
+    samtrader_writer_write(out, pos, (size_t)(open - pos));
 
     const char *key_start = open + 2;
     const char *close_marker = strstr(key_start, "}}");
     if (close_marker == NULL) {
       /* Unterminated placeholder, write it literally */
-      fputs(open, out);
+      samtrader_writer_puts(out, open);
       break;
     }
 
@@ -257,7 +270,7 @@ static bool write_template_report(const char *template_path, SamtraderBacktestRe
     size_t key_len = (size_t)(close_marker - key_start);
     if (key_len >= MAX_KEY_LENGTH) {
       /* Key too long, write literally */
-      fwrite(open, 1, (size_t)(close_marker + 2 - open), out);
+      samtrader_writer_write(out, open, (size_t)(close_marker + 2 - open));
       pos = close_marker + 2;
       continue;
     }
@@ -273,12 +286,12 @@ static bool write_template_report(const char *template_path, SamtraderBacktestRe
       continue;
     }
     if (strcmp(key, "EQUITY_CURVE_CHART") == 0) {
-      write_equity_curve_chart(out, result->equity_curve);
+      write_equity_curve_chart(out, result->equity_curve, chart_points);
       pos = close_marker + 2;
       continue;
     }
     if (strcmp(key, "DRAWDOWN_CHART") == 0) {
-      write_drawdown_chart(out, result->equity_curve);
+      write_drawdown_chart(out, result->equity_curve, chart_points);
       pos = close_marker + 2;
       continue;
     }
@@ -287,22 +300,28 @@ static bool write_template_report(const char *template_path, SamtraderBacktestRe
       pos = close_marker + 2;
       continue;
     }
+    if (strcmp(key, "MONTE_CARLO") == 0) {
+      write_montecarlo_section(out, result->montecarlo);
+      pos = close_marker + 2;
+      continue;
+    }
 
     /* Resolve placeholder */
     char value[MAX_VALUE_LENGTH];
     if (resolve_placeholder(key, result, strategy, value, sizeof(value))) {
-      fputs(value, out);
+      samtrader_writer_puts(out, value);
     } else {
       /* Unknown placeholder, write it literally */
-      fwrite(open, 1, (size_t)(close_marker + 2 - open), out);
+      samtrader_writer_write(out, open, (size_t)(close_marker + 2 - open));
     }
 
     pos = close_marker + 2;
   }
 
   free(template_buf);
-  fclose(out);
-  return true;
+  bool ok = samtrader_writer_close(out);
+  samrena_scratch_end(scratch);
+  return ok;
 }
 
 /* ============================================================================
@@ -319,7 +338,7 @@ static bool write_template_report(const char *template_path, SamtraderBacktestRe
  * @param out Output file stream
  * @param equity_curve Vector of SamtraderEquityPoint
  */
-static void write_monthly_returns_table(FILE *out, SamrenaVector *equity_curve) {
+static void write_monthly_returns_table(SamtraderWriter *out, SamrenaVector *equity_curve) {
   if (equity_curve == NULL || samrena_vector_size(equity_curve) < 2) {
     return;
   }
@@ -354,13 +373,24 @@ static void write_monthly_returns_table(FILE *out, SamrenaVector *equity_curve)
   bool year_has_data[MAX_YEARS];
   memset(year_has_data, 0, sizeof(year_has_data));
 
+  time_t month_start = 0;
+  time_t month_end = 0;
+  int yr = min_year;
+  int mo = 0;
   for (size_t i = 0; i < n; i++) {
     const SamtraderEquityPoint *pt =
         (const SamtraderEquityPoint *)samrena_vector_at_unchecked_const(equity_curve, i);
 
-    tm_info = localtime(&pt->date);
-    int yr = tm_info->tm_year + 1900;
-    int mo = tm_info->tm_mon; /* 0-11 */
+    /* Points arrive in date order, so only convert on entering a new month */
+    if (pt->date < month_start || pt->date >= month_end) {
+      tm_info = localtime(&pt->date);
+      yr = tm_info->tm_year + 1900;
+      mo = tm_info->tm_mon; /* 0-11 */
+      struct tm bound = {.tm_year = yr - 1900, .tm_mon = mo, .tm_mday = 1, .tm_isdst = -1};
+      month_start = mktime(&bound);
+      bound = (struct tm){.tm_year = yr - 1900, .tm_mon = mo + 1, .tm_mday = 1, .tm_isdst = -1};
+      month_end = mktime(&bound);
+    }
     int yr_idx = yr - min_year;
 
     if (yr_idx < 0 || yr_idx >= MAX_YEARS) {
@@ -381,51 +411,51 @@ static void write_monthly_returns_table(FILE *out, SamrenaVector *equity_curve)
   }
 
   /* Write the table */
-  fprintf(out, "== Monthly Returns (%%)\n");
-  fprintf(out, "\n");
-  fprintf(out, "#table(\n");
-  fprintf(out, "  columns: (auto, auto, auto, auto, auto, auto, auto, "
-               "auto, auto, auto, auto, auto, auto, auto),\n");
-  fprintf(out, "  inset: 6pt,\n");
-  fprintf(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
-  fprintf(out, "  [*Year*], [*Jan*], [*Feb*], [*Mar*], [*Apr*], [*May*], [*Jun*], "
-               "[*Jul*], [*Aug*], [*Sep*], [*Oct*], [*Nov*], [*Dec*], [*YTD*],\n");
+  samtrader_writer_puts(out, "== Monthly Returns (%)\n");
+  samtrader_writer_puts(out, "\n");
+  samtrader_writer_puts(out, "#table(\n");
+  samtrader_writer_puts(out, "  columns: (auto, auto, auto, auto, auto, auto, auto, "
+                             "auto, auto, auto, auto, auto, auto, auto),\n");
+  samtrader_writer_puts(out, "  inset: 6pt,\n");
+  samtrader_writer_puts(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
+  samtrader_writer_puts(out, "  [*Year*], [*Jan*], [*Feb*], [*Mar*], [*Apr*], [*May*], [*Jun*], "
+                             "[*Jul*], [*Aug*], [*Sep*], [*Oct*], [*Nov*], [*Dec*], [*YTD*],\n");
 
   for (int yr_idx = 0; yr_idx < num_years; yr_idx++) {
     int year = min_year + yr_idx;
-    fprintf(out, "  [%d],", year);
+    samtrader_writer_printf(out, "  [%d],", year);
 
     /* Monthly cells */
     for (int mo = 0; mo < 12; mo++) {
       if (!has_data[yr_idx][mo] || first_equity[yr_idx][mo] == 0.0) {
-        fprintf(out, " [\\u{2014}],");
+        samtrader_writer_puts(out, " [\\u{2014}],");
       } else {
         double ret =
             (last_equity[yr_idx][mo] - first_equity[yr_idx][mo]) / first_equity[yr_idx][mo] * 100.0;
         if (ret >= 0.0) {
-          fprintf(out, " [#text(fill: rgb(\"#16a34a\"))[%.2f]],", ret);
+          samtrader_writer_printf(out, " [#text(fill: rgb(\"#16a34a\"))[%.2f]],", ret);
         } else {
-          fprintf(out, " [#text(fill: rgb(\"#dc2626\"))[%.2f]],", ret);
+          samtrader_writer_printf(out, " [#text(fill: rgb(\"#dc2626\"))[%.2f]],", ret);
         }
       }
     }
 
     /* YTD cell */
     if (!year_has_data[yr_idx] || year_first_equity[yr_idx] == 0.0) {
-      fprintf(out, " [\\u{2014}],\n");
+      samtrader_writer_puts(out, " [\\u{2014}],\n");
     } else {
       double ytd = (year_last_equity[yr_idx] - year_first_equity[yr_idx]) /
                    year_first_equity[yr_idx] * 100.0;
       if (ytd >= 0.0) {
-        fprintf(out, " [#text(fill: rgb(\"#16a34a\"))[%.2f]],\n", ytd);
+        samtrader_writer_printf(out, " [#text(fill: rgb(\"#16a34a\"))[%.2f]],\n", ytd);
       } else {
-        fprintf(out, " [#text(fill: rgb(\"#dc2626\"))[%.2f]],\n", ytd);
+        samtrader_writer_printf(out, " [#text(fill: rgb(\"#dc2626\"))[%.2f]],\n", ytd);
       }
     }
   }
 
-  fprintf(out, ")\n");
-  fprintf(out, "\n");
+  samtrader_writer_puts(out, ")\n");
+  samtrader_writer_puts(out, "\n");
 }
 
 /* ============================================================================
@@ -448,31 +478,144 @@ static void format_dollar_label(double value, char *buf, size_t buf_size) {
   }
 }
 
+/* One plotted vertex in SVG user units */
+typedef struct {
+  int x;
+  int y;
+} ChartPixel;
+
+/* Y value of point i: the override series if given, else the equity */
+static double chart_value(const SamtraderEquityPoint *points, const double *values, size_t i) {
+  return values ? values[i] : points[i].equity;
+}
+
+/**
+ * @brief Pick the curve points worth plotting (Largest-Triangle-Three-Buckets).
+ *
+ * The first and last points are always kept. The interior is split into
+ * budget - 2 equal buckets, and each bucket keeps the point that forms the
+ * largest triangle with the previously kept point and the next bucket's
+ * average. Peaks and troughs therefore survive, where stride sampling
+ * would skip them.
+ *
+ * @param points Curve points (dates give the x coordinates)
+ * @param values Y value per point, or NULL to use each point's equity
+ * @param n Number of points (>= 2)
+ * @param budget Maximum number of points to keep (>= 3)
+ * @param out Receives the kept indices in ascending order (budget entries)
+ * @return Number of indices written
+ */
+static size_t select_chart_points(const SamtraderEquityPoint *points, const double *values,
+                                  size_t n, size_t budget, size_t *out) {
+  if (n <= budget) {
+    for (size_t i = 0; i < n; i++) {
+      out[i] = i;
+    }
+    return n;
+  }
+
+  double bucket = (double)(n - 2) / (double)(budget - 2);
+  size_t count = 0;
+  size_t kept = 0;
+  out[count++] = 0;
+
+  for (size_t b = 0; b < budget - 2; b++) {
+    size_t start = (size_t)((double)b * bucket) + 1;
+    size_t end = (size_t)((double)(b + 1) * bucket) + 1;
+
+    /* Average of the next bucket (the last point for the final bucket) */
+    size_t next_start = end;
+    size_t next_end = (size_t)((double)(b + 2) * bucket) + 1;
+    if (next_end > n) {
+      next_end = n;
+    }
+    if (next_start >= next_end) {
+      next_start = n - 1;
+      next_end = n;
+    }
+    double avg_x = 0.0;
+    double avg_y = 0.0;
+    for (size_t i = next_start; i < next_end; i++) {
+      avg_x += (double)points[i].date;
+      avg_y += chart_value(points, values, i);
+    }
+    avg_x /= (double)(next_end - next_start);
+    avg_y /= (double)(next_end - next_start);
+
+    double kept_x = (double)points[kept].date;
+    double kept_y = chart_value(points, values, kept);
+    size_t best = start;
+    double best_area = -1.0;
+    for (size_t i = start; i < end; i++) {
+      double area = fabs((kept_x - avg_x) * (chart_value(points, values, i) - kept_y) -
+                         (kept_x - (double)points[i].date) * (avg_y - kept_y));
+      if (area > best_area) {
+        best_area = area;
+        best = i;
+      }
+    }
+    out[count++] = best;
+    kept = best;
+  }
+
+  out[count++] = n - 1;
+  return count;
+}
+
+/* Write "x,y " for each vertex of a polygon or polyline */
+static void write_chart_pixels(SamtraderWriter *out, const ChartPixel *pixels, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    samtrader_writer_int(out, pixels[i].x);
+    samtrader_writer_write(out, ",", 1);
+    samtrader_writer_int(out, pixels[i].y);
+    samtrader_writer_write(out, " ", 1);
+  }
+}
+
+/* Write the X-axis date labels shared by both charts */
+static void write_chart_date_labels(SamtraderWriter *out, double date_min, double date_max,
+                                    int plot_w, int plot_h) {
+  int num_x_labels = 5;
+  for (int i = 0; i <= num_x_labels; i++) {
+    double frac = (double)i / (double)num_x_labels;
+    int x = CHART_MARGIN_LEFT + (int)(frac * plot_w);
+    time_t t = (time_t)(date_min + frac * (date_max - date_min));
+    struct tm *tm_info = localtime(&t);
+    char date_label[16];
+    strftime(date_label, sizeof(date_label), "%Y-%m", tm_info);
+
+    samtrader_writer_printf(out,
+                            "<text x='%d' y='%d' text-anchor='middle' font-size='10' "
+                            "fill='#6b7280' font-family='sans-serif'>%s</text>\n",
+                            x, CHART_MARGIN_TOP + plot_h + 20, date_label);
+  }
+}
+
 /**
  * @brief Write an equity curve chart as inline SVG in Typst.
+ *
+ * The curve is decimated to at most max_points vertices before plotting.
  */
-static void write_equity_curve_chart(FILE *out, SamrenaVector *equity_curve) {
+static void write_equity_curve_chart(SamtraderWriter *out, SamrenaVector *equity_curve,
+                                     size_t max_points) {
   if (equity_curve == NULL || samrena_vector_size(equity_curve) < 2) {
     return;
   }
 
   size_t n = samrena_vector_size(equity_curve);
+  const SamtraderEquityPoint *points = (const SamtraderEquityPoint *)equity_curve->data;
 
   /* Find min/max equity and date range */
-  const SamtraderEquityPoint *first =
-      (const SamtraderEquityPoint *)samrena_vector_at_unchecked_const(equity_curve, 0);
-  const SamtraderEquityPoint *last =
-      (const SamtraderEquityPoint *)samrena_vector_at_unchecked_const(equity_curve, n - 1);
+  const SamtraderEquityPoint *first = &points[0];
+  const SamtraderEquityPoint *last = &points[n - 1];
 
   double min_equity = first->equity;
   double max_equity = first->equity;
   for (size_t i = 1; i < n; i++) {
-    const SamtraderEquityPoint *pt =
-        (const SamtraderEquityPoint *)samrena_vector_at_unchecked_const(equity_curve, i);
-    if (pt->equity < min_equity)
-      min_equity = pt->equity;
-    if (pt->equity > max_equity)
-      max_equity = pt->equity;
+    if (points[i].equity < min_equity)
+      min_equity = points[i].equity;
+    if (points[i].equity > max_equity)
+      max_equity = points[i].equity;
   }
 
   /* Pad if flat */
@@ -490,20 +633,34 @@ static void write_equity_curve_chart(FILE *out, SamrenaVector *equity_curve) {
   int plot_w = CHART_SVG_WIDTH - CHART_MARGIN_LEFT - CHART_MARGIN_RIGHT;
   int plot_h = CHART_SVG_HEIGHT - CHART_MARGIN_TOP - CHART_MARGIN_BOTTOM;
 
-  /* Determine sample indices for downsampling */
-  size_t num_points = n;
-  if (num_points > MAX_CHART_POINTS) {
-    num_points = MAX_CHART_POINTS;
+  /* Decimate once; the area fill and the line share the vertices */
+  size_t budget = n < max_points ? n : max_points;
+  size_t *indices = malloc(budget * sizeof(size_t));
+  ChartPixel *pixels = malloc(budget * sizeof(ChartPixel));
+  if (indices == NULL || pixels == NULL) {
+    free(indices);
+    free(pixels);
+    return;
+  }
+  size_t count = select_chart_points(points, NULL, n, budget, indices);
+  for (size_t i = 0; i < count; i++) {
+    const SamtraderEquityPoint *pt = &points[indices[i]];
+    double x_frac = ((double)pt->date - date_min) / (date_max - date_min);
+    double y_frac = (pt->equity - min_equity) / (max_equity - min_equity);
+    pixels[i].x = CHART_MARGIN_LEFT + (int)(x_frac * plot_w);
+    pixels[i].y = CHART_MARGIN_TOP + plot_h - (int)(y_frac * plot_h);
   }
+  free(indices);
 
-  fprintf(out, "== Equity Curve\n\n");
-  fprintf(out, "#image.decode(\n");
-  fprintf(out, "  width: 100%%,\n");
-  fprintf(out, "  \"<svg xmlns='http://www.w3.org/2000/svg' ");
-  fprintf(out, "viewBox='0 0 %d %d'>\n", CHART_SVG_WIDTH, CHART_SVG_HEIGHT);
+  samtrader_writer_puts(out, "== Equity Curve\n\n");
+  samtrader_writer_puts(out, "#image.decode(\n");
+  samtrader_writer_puts(out, "  width: 100%,\n");
+  samtrader_writer_puts(out, "  \"<svg xmlns='http://www.w3.org/2000/svg' ");
+  samtrader_writer_printf(out, "viewBox='0 0 %d %d'>\n", CHART_SVG_WIDTH, CHART_SVG_HEIGHT);
 
   /* Background */
-  fprintf(out, "<rect width='%d' height='%d' fill='white'/>\n", CHART_SVG_WIDTH, CHART_SVG_HEIGHT);
+  samtrader_writer_printf(out, "<rect width='%d' height='%d' fill='white'/>\n", CHART_SVG_WIDTH,
+                          CHART_SVG_HEIGHT);
 
   /* Horizontal grid lines and Y-axis labels (5 lines) */
   int num_grid = 5;
@@ -514,96 +671,77 @@ static void write_equity_curve_chart(FILE *out, SamrenaVector *equity_curve) {
     char label[32];
     format_dollar_label(val, label, sizeof(label));
 
-    fprintf(out, "<line x1='%d' y1='%d' x2='%d' y2='%d' stroke='#e5e7eb' stroke-width='1'/>\n",
-            CHART_MARGIN_LEFT, y, CHART_MARGIN_LEFT + plot_w, y);
-    fprintf(out,
-            "<text x='%d' y='%d' text-anchor='end' font-size='10' "
-            "fill='#6b7280' font-family='sans-serif'>%s</text>\n",
-            CHART_MARGIN_LEFT - 8, y + 4, label);
-  }
-
-  /* Build polyline points and polygon points */
-  fprintf(out, "<polygon points='%d,%d ", CHART_MARGIN_LEFT, CHART_MARGIN_TOP + plot_h);
-
-  for (size_t i = 0; i < num_points; i++) {
-    size_t idx = (n > MAX_CHART_POINTS) ? (i * (n - 1)) / (num_points - 1) : i;
-    const SamtraderEquityPoint *pt =
-        (const SamtraderEquityPoint *)samrena_vector_at_unchecked_const(equity_curve, idx);
-
-    double x_frac = ((double)pt->date - date_min) / (date_max - date_min);
-    double y_frac = (pt->equity - min_equity) / (max_equity - min_equity);
-    int px = CHART_MARGIN_LEFT + (int)(x_frac * plot_w);
-    int py = CHART_MARGIN_TOP + plot_h - (int)(y_frac * plot_h);
-    fprintf(out, "%d,%d ", px, py);
+    samtrader_writer_printf(
+        out, "<line x1='%d' y1='%d' x2='%d' y2='%d' stroke='#e5e7eb' stroke-width='1'/>\n",
+        CHART_MARGIN_LEFT, y, CHART_MARGIN_LEFT + plot_w, y);
+    samtrader_writer_printf(out,
+                            "<text x='%d' y='%d' text-anchor='end' font-size='10' "
+                            "fill='#6b7280' font-family='sans-serif'>%s</text>\n",
+                            CHART_MARGIN_LEFT - 8, y + 4, label);
   }
 
-  fprintf(out, "%d,%d' fill='rgba(37,99,235,0.15)' stroke='none'/>\n", CHART_MARGIN_LEFT + plot_w,
-          CHART_MARGIN_TOP + plot_h);
+  /* Area under the curve */
+  samtrader_writer_printf(out, "<polygon points='%d,%d ", CHART_MARGIN_LEFT,
+                          CHART_MARGIN_TOP + plot_h);
+  write_chart_pixels(out, pixels, count);
+  samtrader_writer_printf(out, "%d,%d' fill='rgba(37,99,235,0.15)' stroke='none'/>\n",
+                          CHART_MARGIN_LEFT + plot_w, CHART_MARGIN_TOP + plot_h);
 
   /* Polyline for the curve */
-  fprintf(out, "<polyline points='");
-  for (size_t i = 0; i < num_points; i++) {
-    size_t idx = (n > MAX_CHART_POINTS) ? (i * (n - 1)) / (num_points - 1) : i;
-    const SamtraderEquityPoint *pt =
-        (const SamtraderEquityPoint *)samrena_vector_at_unchecked_const(equity_curve, idx);
+  samtrader_writer_puts(out, "<polyline points='");
+  write_chart_pixels(out, pixels, count);
+  samtrader_writer_puts(out, "' fill='none' stroke='#2563eb' stroke-width='1.5'/>\n");
+  free(pixels);
 
-    double x_frac = ((double)pt->date - date_min) / (date_max - date_min);
-    double y_frac = (pt->equity - min_equity) / (max_equity - min_equity);
-    int px = CHART_MARGIN_LEFT + (int)(x_frac * plot_w);
-    int py = CHART_MARGIN_TOP + plot_h - (int)(y_frac * plot_h);
-    fprintf(out, "%d,%d ", px, py);
-  }
-  fprintf(out, "' fill='none' stroke='#2563eb' stroke-width='1.5'/>\n");
-
-  /* X-axis date labels */
-  int num_x_labels = 5;
-  for (int i = 0; i <= num_x_labels; i++) {
-    double frac = (double)i / (double)num_x_labels;
-    int x = CHART_MARGIN_LEFT + (int)(frac * plot_w);
-    time_t t = (time_t)(date_min + frac * (date_max - date_min));
-    struct tm *tm_info = localtime(&t);
-    char date_label[16];
-    strftime(date_label, sizeof(date_label), "%Y-%m", tm_info);
-
-    fprintf(out,
-            "<text x='%d' y='%d' text-anchor='middle' font-size='10' "
-            "fill='#6b7280' font-family='sans-serif'>%s</text>\n",
-            x, CHART_MARGIN_TOP + plot_h + 20, date_label);
-  }
+  write_chart_date_labels(out, date_min, date_max, plot_w, plot_h);
 
   /* Axis border lines */
-  fprintf(out, "<line x1='%d' y1='%d' x2='%d' y2='%d' stroke='#d1d5db' stroke-width='1'/>\n",
-          CHART_MARGIN_LEFT, CHART_MARGIN_TOP, CHART_MARGIN_LEFT, CHART_MARGIN_TOP + plot_h);
-  fprintf(out, "<line x1='%d' y1='%d' x2='%d' y2='%d' stroke='#d1d5db' stroke-width='1'/>\n",
-          CHART_MARGIN_LEFT, CHART_MARGIN_TOP + plot_h, CHART_MARGIN_LEFT + plot_w,
-          CHART_MARGIN_TOP + plot_h);
-
-  fprintf(out, "</svg>\",\n)\n\n");
+  samtrader_writer_printf(
+      out, "<line x1='%d' y1='%d' x2='%d' y2='%d' stroke='#d1d5db' stroke-width='1'/>\n",
+      CHART_MARGIN_LEFT, CHART_MARGIN_TOP, CHART_MARGIN_LEFT, CHART_MARGIN_TOP + plot_h);
+  samtrader_writer_printf(
+      out, "<line x1='%d' y1='%d' x2='%d' y2='%d' stroke='#d1d5db' stroke-width='1'/>\n",
+      CHART_MARGIN_LEFT, CHART_MARGIN_TOP + plot_h, CHART_MARGIN_LEFT + plot_w,
+      CHART_MARGIN_TOP + plot_h);
+
+  samtrader_writer_puts(out, "</svg>\",\n)\n\n");
 }
 
 /**
  * @brief Write a drawdown chart as inline SVG in Typst.
+ *
+ * Drawdown is measured against the running peak of the full curve, then
+ * decimated to at most max_points vertices.
  */
-static void write_drawdown_chart(FILE *out, SamrenaVector *equity_curve) {
+static void write_drawdown_chart(SamtraderWriter *out, SamrenaVector *equity_curve,
+                                 size_t max_points) {
   if (equity_curve == NULL || samrena_vector_size(equity_curve) < 2) {
     return;
   }
 
   size_t n = samrena_vector_size(equity_curve);
+  const SamtraderEquityPoint *points = (const SamtraderEquityPoint *)equity_curve->data;
+
+  size_t budget = n < max_points ? n : max_points;
+  double *drawdown = malloc(n * sizeof(double));
+  size_t *indices = malloc(budget * sizeof(size_t));
+  ChartPixel *pixels = malloc(budget * sizeof(ChartPixel));
+  if (drawdown == NULL || indices == NULL || pixels == NULL) {
+    free(drawdown);
+    free(indices);
+    free(pixels);
+    return;
+  }
 
-  /* Compute drawdown at each point */
+  /* Compute drawdown at each point and the maximum for scaling */
   double peak = 0.0;
   double max_dd = 0.0;
-
-  /* First pass: find max drawdown for scaling */
   for (size_t i = 0; i < n; i++) {
-    const SamtraderEquityPoint *pt =
-        (const SamtraderEquityPoint *)samrena_vector_at_unchecked_const(equity_curve, i);
-    if (pt->equity > peak)
-      peak = pt->equity;
-    double dd = (peak > 0.0) ? (peak - pt->equity) / peak : 0.0;
-    if (dd > max_dd)
-      max_dd = dd;
+    if (points[i].equity > peak)
+      peak = points[i].equity;
+    drawdown[i] = (peak > 0.0) ? (peak - points[i].equity) / peak : 0.0;
+    if (drawdown[i] > max_dd)
+      max_dd = drawdown[i];
   }
 
   /* If no drawdown, show minimal scale */
@@ -611,13 +749,8 @@ static void write_drawdown_chart(FILE *out, SamrenaVector *equity_curve) {
     max_dd = 0.01;
   }
 
-  const SamtraderEquityPoint *first =
-      (const SamtraderEquityPoint *)samrena_vector_at_unchecked_const(equity_curve, 0);
-  const SamtraderEquityPoint *last =
-      (const SamtraderEquityPoint *)samrena_vector_at_unchecked_const(equity_curve, n - 1);
-
-  double date_min = (double)first->date;
-  double date_max = (double)last->date;
+  double date_min = (double)points[0].date;
+  double date_max = (double)points[n - 1].date;
   if (date_max - date_min < 1.0) {
     date_max = date_min + 86400.0;
   }
@@ -625,19 +758,26 @@ static void write_drawdown_chart(FILE *out, SamrenaVector *equity_curve) {
   int plot_w = CHART_SVG_WIDTH - CHART_MARGIN_LEFT - CHART_MARGIN_RIGHT;
   int plot_h = CHART_SVG_HEIGHT - CHART_MARGIN_TOP - CHART_MARGIN_BOTTOM;
 
-  size_t num_points = n;
-  if (num_points > MAX_CHART_POINTS) {
-    num_points = MAX_CHART_POINTS;
+  size_t count = select_chart_points(points, drawdown, n, budget, indices);
+  for (size_t i = 0; i < count; i++) {
+    size_t idx = indices[i];
+    double x_frac = ((double)points[idx].date - date_min) / (date_max - date_min);
+    double y_frac = drawdown[idx] / max_dd;
+    pixels[i].x = CHART_MARGIN_LEFT + (int)(x_frac * plot_w);
+    pixels[i].y = CHART_MARGIN_TOP + (int)(y_frac * plot_h);
   }
+  free(drawdown);
+  free(indices);
 
-  fprintf(out, "=== Drawdown\n\n");
-  fprintf(out, "#image.decode(\n");
-  fprintf(out, "  width: 100%%,\n");
-  fprintf(out, "  \"<svg xmlns='http://www.w3.org/2000/svg' ");
-  fprintf(out, "viewBox='0 0 %d %d'>\n", CHART_SVG_WIDTH, CHART_SVG_HEIGHT);
+  samtrader_writer_puts(out, "=== Drawdown\n\n");
+  samtrader_writer_puts(out, "#image.decode(\n");
+  samtrader_writer_puts(out, "  width: 100%,\n");
+  samtrader_writer_puts(out, "  \"<svg xmlns='http://www.w3.org/2000/svg' ");
+  samtrader_writer_printf(out, "viewBox='0 0 %d %d'>\n", CHART_SVG_WIDTH, CHART_SVG_HEIGHT);
 
   /* Background */
-  fprintf(out, "<rect width='%d' height='%d' fill='white'/>\n", CHART_SVG_WIDTH, CHART_SVG_HEIGHT);
+  samtrader_writer_printf(out, "<rect width='%d' height='%d' fill='white'/>\n", CHART_SVG_WIDTH,
+                          CHART_SVG_HEIGHT);
 
   /* Horizontal grid lines and Y-axis labels */
   int num_grid = 4;
@@ -646,81 +786,39 @@ static void write_drawdown_chart(FILE *out, SamrenaVector *equity_curve) {
     int y = CHART_MARGIN_TOP + (int)(frac * plot_h);
     double dd_val = frac * max_dd * 100.0;
 
-    fprintf(out, "<line x1='%d' y1='%d' x2='%d' y2='%d' stroke='#e5e7eb' stroke-width='1'/>\n",
-            CHART_MARGIN_LEFT, y, CHART_MARGIN_LEFT + plot_w, y);
-    fprintf(out,
-            "<text x='%d' y='%d' text-anchor='end' font-size='10' "
-            "fill='#6b7280' font-family='sans-serif'>-%.1f%%</text>\n",
-            CHART_MARGIN_LEFT - 8, y + 4, dd_val);
+    samtrader_writer_printf(
+        out, "<line x1='%d' y1='%d' x2='%d' y2='%d' stroke='#e5e7eb' stroke-width='1'/>\n",
+        CHART_MARGIN_LEFT, y, CHART_MARGIN_LEFT + plot_w, y);
+    samtrader_writer_printf(out,
+                            "<text x='%d' y='%d' text-anchor='end' font-size='10' "
+                            "fill='#6b7280' font-family='sans-serif'>-%.1f%%</text>\n",
+                            CHART_MARGIN_LEFT - 8, y + 4, dd_val);
   }
 
   /* Build polygon for drawdown area (top edge = 0% line) */
-  fprintf(out, "<polygon points='%d,%d ", CHART_MARGIN_LEFT, CHART_MARGIN_TOP);
-
-  peak = 0.0;
-  for (size_t i = 0; i < num_points; i++) {
-    size_t idx = (n > MAX_CHART_POINTS) ? (i * (n - 1)) / (num_points - 1) : i;
-    const SamtraderEquityPoint *pt =
-        (const SamtraderEquityPoint *)samrena_vector_at_unchecked_const(equity_curve, idx);
-
-    if (pt->equity > peak)
-      peak = pt->equity;
-    double dd = (peak > 0.0) ? (peak - pt->equity) / peak : 0.0;
-
-    double x_frac = ((double)pt->date - date_min) / (date_max - date_min);
-    double y_frac = dd / max_dd;
-    int px = CHART_MARGIN_LEFT + (int)(x_frac * plot_w);
-    int py = CHART_MARGIN_TOP + (int)(y_frac * plot_h);
-    fprintf(out, "%d,%d ", px, py);
-  }
-
-  fprintf(out, "%d,%d' fill='rgba(220,38,38,0.2)' stroke='none'/>\n", CHART_MARGIN_LEFT + plot_w,
-          CHART_MARGIN_TOP);
+  samtrader_writer_printf(out, "<polygon points='%d,%d ", CHART_MARGIN_LEFT, CHART_MARGIN_TOP);
+  write_chart_pixels(out, pixels, count);
+  samtrader_writer_printf(out, "%d,%d' fill='rgba(220,38,38,0.2)' stroke='none'/>\n",
+                          CHART_MARGIN_LEFT + plot_w, CHART_MARGIN_TOP);
 
   /* Polyline for drawdown curve */
-  fprintf(out, "<polyline points='");
-  peak = 0.0;
-  for (size_t i = 0; i < num_points; i++) {
-    size_t idx = (n > MAX_CHART_POINTS) ? (i * (n - 1)) / (num_points - 1) : i;
-    const SamtraderEquityPoint *pt =
-        (const SamtraderEquityPoint *)samrena_vector_at_unchecked_const(equity_curve, idx);
+  samtrader_writer_puts(out, "<polyline points='");
+  write_chart_pixels(out, pixels, count);
+  samtrader_writer_puts(out, "' fill='none' stroke='#dc2626' stroke-width='1.5'/>\n");
+  free(pixels);
 
-    if (pt->equity > peak)
-      peak = pt->equity;
-    double dd = (peak > 0.0) ? (peak - pt->equity) / peak : 0.0;
-
-    double x_frac = ((double)pt->date - date_min) / (date_max - date_min);
-    double y_frac = dd / max_dd;
-    int px = CHART_MARGIN_LEFT + (int)(x_frac * plot_w);
-    int py = CHART_MARGIN_TOP + (int)(y_frac * plot_h);
-    fprintf(out, "%d,%d ", px, py);
-  }
-  fprintf(out, "' fill='none' stroke='#dc2626' stroke-width='1.5'/>\n");
-
-  /* X-axis date labels */
-  int num_x_labels = 5;
-  for (int i = 0; i <= num_x_labels; i++) {
-    double frac = (double)i / (double)num_x_labels;
-    int x = CHART_MARGIN_LEFT + (int)(frac * plot_w);
-    time_t t = (time_t)(date_min + frac * (date_max - date_min));
-    struct tm *tm_info = localtime(&t);
-    char date_label[16];
-    strftime(date_label, sizeof(date_label), "%Y-%m", tm_info);
-
-    fprintf(out,
-            "<text x='%d' y='%d' text-anchor='middle' font-size='10' "
-            "fill='#6b7280' font-family='sans-serif'>%s</text>\n",
-            x, CHART_MARGIN_TOP + plot_h + 20, date_label);
-  }
+  write_chart_date_labels(out, date_min, date_max, plot_w, plot_h);
 
   /* Axis border lines */
-  fprintf(out, "<line x1='%d' y1='%d' x2='%d' y2='%d' stroke='#d1d5db' stroke-width='1'/>\n",
-          CHART_MARGIN_LEFT, CHART_MARGIN_TOP, CHART_MARGIN_LEFT, CHART_MARGIN_TOP + plot_h);
-  fprintf(out, "<line x1='%d' y1='%d' x2='%d' y2='%d' stroke='#d1d5db' stroke-width='1'/>\n",
-          CHART_MARGIN_LEFT, CHART_MARGIN_TOP + plot_h, CHART_MARGIN_LEFT + plot_w,
-          CHART_MARGIN_TOP + plot_h);
-
-  fprintf(out, "</svg>\",\n)\n\n");
+  samtrader_writer_printf(
+      out, "<line x1='%d' y1='%d' x2='%d' y2='%d' stroke='#d1d5db' stroke-width='1'/>\n",
+      CHART_MARGIN_LEFT, CHART_MARGIN_TOP, CHART_MARGIN_LEFT, CHART_MARGIN_TOP + plot_h);
+  samtrader_writer_printf(
+      out, "<line x1='%d' y1='%d' x2='%d' y2='%d' stroke='#d1d5db' stroke-width='1'/>\n",
+      CHART_MARGIN_LEFT, CHART_MARGIN_TOP + plot_h, CHART_MARGIN_LEFT + plot_w,
+      CHART_MARGIN_TOP + plot_h);
+
+  samtrader_writer_puts(out, "</svg>\",\n)\n\n");
 }
 
 /* ============================================================================
@@ -730,190 +828,250 @@ static void write_drawdown_chart(FILE *out, SamrenaVector *equity_curve) {
 /**
  * @brief Write the Typst document preamble.
  */
-static void write_preamble(FILE *out, const char *strategy_name) {
-  fprintf(out, "#set document(title: \"Backtest Report: %s\")\n", strategy_name);
-  fprintf(out, "#set page(paper: \"a4\", margin: 2cm)\n");
-  fprintf(out, "#set text(font: \"New Computer Modern\", size: 11pt)\n");
-  fprintf(out, "\n");
+static void write_preamble(SamtraderWriter *out, const char *strategy_name) {
+  samtrader_writer_printf(out, "#set document(title: \"Backtest Report: %s\")\n", strategy_name);
+  samtrader_writer_puts(out, "#set page(paper: \"a4\", margin: 2cm)\n");
+  samtrader_writer_puts(out, "#set text(font: \"New Computer Modern\", size: 11pt)\n");
+  samtrader_writer_puts(out, "\n");
 }
 
 /**
  * @brief Write the report title and generation date.
  */
-static void write_title(FILE *out, const char *strategy_name) {
+static void write_title(SamtraderWriter *out, const char *strategy_name) {
   time_t now = time(NULL);
   struct tm *tm_info = localtime(&now);
   char date_buf[32];
   strftime(date_buf, sizeof(date_buf), "%Y-%m-%d", tm_info);
 
-  fprintf(out, "= Backtest Report: %s\n", strategy_name);
-  fprintf(out, "\n");
-  fprintf(out, "_Generated on %s_\n", date_buf);
-  fprintf(out, "\n");
+  samtrader_writer_printf(out, "= Backtest Report: %s\n", strategy_name);
+  samtrader_writer_puts(out, "\n");
+  samtrader_writer_printf(out, "_Generated on %s_\n", date_buf);
+  samtrader_writer_puts(out, "\n");
 }
 
 /**
  * @brief Write the strategy summary section.
  */
-static void write_strategy_summary(FILE *out, SamtraderStrategy *strategy) {
+static void write_strategy_summary(SamtraderWriter *out, SamtraderStrategy *strategy) {
   const char *name = strategy->name ? strategy->name : "Unnamed Strategy";
   const char *desc = strategy->description ? strategy->description : "No description provided.";
 
-  fprintf(out, "== Strategy Summary\n");
-  fprintf(out, "\n");
-  fprintf(out, "#table(\n");
-  fprintf(out, "  columns: (auto, 1fr),\n");
-  fprintf(out, "  stroke: none,\n");
-  fprintf(out, "  inset: 6pt,\n");
-  fprintf(out, "  [*Name*], [%s],\n", name);
-  fprintf(out, "  [*Description*], [%s],\n", desc);
-  fprintf(out, ")\n");
-  fprintf(out, "\n");
+  samtrader_writer_puts(out, "== Strategy Summary\n");
+  samtrader_writer_puts(out, "\n");
+  samtrader_writer_puts(out, "#table(\n");
+  samtrader_writer_puts(out, "  columns: (auto, 1fr),\n");
+  samtrader_writer_puts(out, "  stroke: none,\n");
+  samtrader_writer_puts(out, "  inset: 6pt,\n");
+  samtrader_writer_printf(out, "  [*Name*], [%s],\n", name);
+  samtrader_writer_printf(out, "  [*Description*], [%s],\n", desc);
+  samtrader_writer_puts(out, ")\n");
+  samtrader_writer_puts(out, "\n");
 }
 
 /**
  * @brief Write the strategy parameters section.
  */
-static void write_strategy_parameters(FILE *out, SamtraderStrategy *strategy) {
-  fprintf(out, "== Strategy Parameters\n");
-  fprintf(out, "\n");
-  fprintf(out, "#table(\n");
-  fprintf(out, "  columns: (1fr, 1fr),\n");
-  fprintf(out, "  inset: 8pt,\n");
-  fprintf(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
-  fprintf(out, "  [*Parameter*], [*Value*],\n");
-  fprintf(out, "  [Position Size], [%.1f%%],\n", strategy->position_size * 100.0);
+static void write_strategy_parameters(SamtraderWriter *out, SamtraderStrategy *strategy) {
+  samtrader_writer_puts(out, "== Strategy Parameters\n");
+  samtrader_writer_puts(out, "\n");
+  samtrader_writer_puts(out, "#table(\n");
+  samtrader_writer_puts(out, "  columns: (1fr, 1fr),\n");
+  samtrader_writer_puts(out, "  inset: 8pt,\n");
+  samtrader_writer_puts(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
+  samtrader_writer_puts(out, "  [*Parameter*], [*Value*],\n");
+  samtrader_writer_printf(out, "  [Position Size], [%.1f%%],\n", strategy->position_size * 100.0);
 
   if (strategy->stop_loss_pct > 0.0) {
-    fprintf(out, "  [Stop Loss], [%.1f%%],\n", strategy->stop_loss_pct);
+    samtrader_writer_printf(out, "  [Stop Loss], [%.1f%%],\n", strategy->stop_loss_pct);
   } else {
-    fprintf(out, "  [Stop Loss], [None],\n");
+    samtrader_writer_puts(out, "  [Stop Loss], [None],\n");
   }
 
   if (strategy->take_profit_pct > 0.0) {
-    fprintf(out, "  [Take Profit], [%.1f%%],\n", strategy->take_profit_pct);
+    samtrader_writer_printf(out, "  [Take Profit], [%.1f%%],\n", strategy->take_profit_pct);
   } else {
-    fprintf(out, "  [Take Profit], [None],\n");
-  }
-
-  fprintf(out, "  [Max Positions], [%d],\n", strategy->max_positions);
-  fprintf(out, "  [Long Entry], [%s],\n", strategy->entry_long ? "Defined" : "None");
-  fprintf(out, "  [Long Exit], [%s],\n", strategy->exit_long ? "Defined" : "None");
-  fprintf(out, "  [Short Entry], [%s],\n", strategy->entry_short ? "Defined" : "None");
-  fprintf(out, "  [Short Exit], [%s],\n", strategy->exit_short ? "Defined" : "None");
-  fprintf(out, ")\n");
-  fprintf(out, "\n");
+    samtrader_writer_puts(out, "  [Take Profit], [None],\n");
+  }
+
+  samtrader_writer_printf(out, "  [Max Positions], [%d],\n", strategy->max_positions);
+  samtrader_writer_printf(out, "  [Long Entry], [%s],\n",
+                          strategy->entry_long ? "Defined" : "None");
+  samtrader_writer_printf(out, "  [Long Exit], [%s],\n", strategy->exit_long ? "Defined" : "None");
+  samtrader_writer_printf(out, "  [Short Entry], [%s],\n",
+                          strategy->entry_short ? "Defined" : "None");
+  samtrader_writer_printf(out, "  [Short Exit], [%s],\n",
+                          strategy->exit_short ? "Defined" : "None");
+  samtrader_writer_puts(out, ")\n");
+  samtrader_writer_puts(out, "\n");
 }
 
 /**
  * @brief Write the performance metrics section.
  */
-static void write_performance_metrics(FILE *out, SamtraderBacktestResult *result) {
-  fprintf(out, "== Performance Metrics\n");
-  fprintf(out, "\n");
-  fprintf(out, "=== Return Metrics\n");
-  fprintf(out, "\n");
-  fprintf(out, "#table(\n");
-  fprintf(out, "  columns: (1fr, 1fr),\n");
-  fprintf(out, "  inset: 8pt,\n");
-  fprintf(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
-  fprintf(out, "  [*Metric*], [*Value*],\n");
-  fprintf(out, "  [Total Return], [%.2f%%],\n", result->total_return * 100.0);
-  fprintf(out, "  [Annualized Return], [%.2f%%],\n", result->annualized_return * 100.0);
-  fprintf(out, "  [Sharpe Ratio], [%.3f],\n", result->sharpe_ratio);
-  fprintf(out, "  [Sortino Ratio], [%.3f],\n", result->sortino_ratio);
-  fprintf(out, ")\n");
-  fprintf(out, "\n");
-
-  fprintf(out, "=== Risk Metrics\n");
-  fprintf(out, "\n");
-  fprintf(out, "#table(\n");
-  fprintf(out, "  columns: (1fr, 1fr),\n");
-  fprintf(out, "  inset: 8pt,\n");
-  fprintf(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
-  fprintf(out, "  [*Metric*], [*Value*],\n");
-  fprintf(out, "  [Max Drawdown], [%.2f%%],\n", result->max_drawdown * 100.0);
-  fprintf(out, "  [Max Drawdown Duration], [%.0f days],\n", result->max_drawdown_duration);
-  fprintf(out, "  [Profit Factor], [%.2f],\n", result->profit_factor);
-  fprintf(out, ")\n");
-  fprintf(out, "\n");
-
-  fprintf(out, "=== Trade Statistics\n");
-  fprintf(out, "\n");
-  fprintf(out, "#table(\n");
-  fprintf(out, "  columns: (1fr, 1fr),\n");
-  fprintf(out, "  inset: 8pt,\n");
-  fprintf(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
-  fprintf(out, "  [*Metric*], [*Value*],\n");
-  fprintf(out, "  [Total Trades], [%d],\n", result->total_trades);
-  fprintf(out, "  [Winning Trades], [%d],\n", result->winning_trades);
-  fprintf(out, "  [Losing Trades], [%d],\n", result->losing_trades);
-  fprintf(out, "  [Win Rate], [%.1f%%],\n", result->win_rate * 100.0);
-  fprintf(out, "  [Average Win], [\\$%.2f],\n", result->average_win);
-  fprintf(out, "  [Average Loss], [\\$%.2f],\n", result->average_loss);
-  fprintf(out, "  [Largest Win], [\\$%.2f],\n", result->largest_win);
-  fprintf(out, "  [Largest Loss], [\\$%.2f],\n", result->largest_loss);
-  fprintf(out, "  [Avg Trade Duration], [%.1f days],\n", result->average_trade_duration);
-  fprintf(out, ")\n");
-  fprintf(out, "\n");
+static void write_performance_metrics(SamtraderWriter *out, SamtraderBacktestResult *result) {
+  samtrader_writer_puts(out, "== Performance Metrics\n");
+  samtrader_writer_puts(out, "\n");
+  samtrader_writer_puts(out, "=== Return Metrics\n");
+  samtrader_writer_puts(out, "\n");
+  samtrader_writer_puts(out, "#table(\n");
+  samtrader_writer_puts(out, "  columns: (1fr, 1fr),\n");
+  samtrader_writer_puts(out, "  inset: 8pt,\n");
+  samtrader_writer_puts(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
+  samtrader_writer_puts(out, "  [*Metric*], [*Value*],\n");
+  samtrader_writer_printf(out, "  [Total Return], [%.2f%%],\n", result->total_return * 100.0);
+  samtrader_writer_printf(out, "  [Annualized Return], [%.2f%%],\n",
+                          result->annualized_return * 100.0);
+  samtrader_writer_printf(out, "  [Sharpe Ratio], [%.3f],\n", result->sharpe_ratio);
+  samtrader_writer_printf(out, "  [Sortino Ratio], [%.3f],\n", result->sortino_ratio);
+  samtrader_writer_puts(out, ")\n");
+  samtrader_writer_puts(out, "\n");
+
+  samtrader_writer_puts(out, "=== Risk Metrics\n");
+  samtrader_writer_puts(out, "\n");
+  samtrader_writer_puts(out, "#table(\n");
+  samtrader_writer_puts(out, "  columns: (1fr, 1fr),\n");
+  samtrader_writer_puts(out, "  inset: 8pt,\n");
+  samtrader_writer_puts(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
+  samtrader_writer_puts(out, "  [*Metric*], [*Value*],\n");
+  samtrader_writer_printf(out, "  [Max Drawdown], [%.2f%%],\n", result->max_drawdown * 100.0);
+  samtrader_writer_printf(out, "  [Max Drawdown Duration], [%.0f days],\n",
+                          result->max_drawdown_duration);
+  samtrader_writer_printf(out, "  [Profit Factor], [%.2f],\n", result->profit_factor);
+  samtrader_writer_puts(out, ")\n");
+  samtrader_writer_puts(out, "\n");
+
+  samtrader_writer_puts(out, "=== Trade Statistics\n");
+  samtrader_writer_puts(out, "\n");
+  samtrader_writer_puts(out, "#table(\n");
+  samtrader_writer_puts(out, "  columns: (1fr, 1fr),\n");
+  samtrader_writer_puts(out, "  inset: 8pt,\n");
+  samtrader_writer_puts(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
+  samtrader_writer_puts(out, "  [*Metric*], [*Value*],\n");
+  samtrader_writer_printf(out, "  [Total Trades], [%d],\n", result->total_trades);
+  samtrader_writer_printf(out, "  [Winning Trades], [%d],\n", result->winning_trades);
+  samtrader_writer_printf(out, "  [Losing Trades], [%d],\n", result->losing_trades);
+  samtrader_writer_printf(out, "  [Win Rate], [%.1f%%],\n", result->win_rate * 100.0);
+  samtrader_writer_printf(out, "  [Average Win], [\\$%.2f],\n", result->average_win);
+  samtrader_writer_printf(out, "  [Average Loss], [\\$%.2f],\n", result->average_loss);
+  samtrader_writer_printf(out, "  [Largest Win], [\\$%.2f],\n", result->largest_win);
+  samtrader_writer_printf(out, "  [Largest Loss], [\\$%.2f],\n", result->largest_loss);
+  samtrader_writer_printf(out, "  [Avg Trade Duration], [%.1f days],\n",
+                          result->average_trade_duration);
+  samtrader_writer_puts(out, ")\n");
+  samtrader_writer_puts(out, "\n");
+}
+
+/* Write a date as YYYY-MM-DD */
+static void write_trade_date(SamtraderWriter *out, time_t date) {
+  char label[16];
+  struct tm *tm_info = localtime(&date);
+  size_t len = strftime(label, sizeof(label), "%Y-%m-%d", tm_info);
+  samtrader_writer_write(out, label, len);
+}
+
+/**
+ * @brief Write one trade log row, optionally led by the symbol column.
+ *
+ * Rows are assembled with direct number conversion instead of printf, as
+ * multi-code trade logs run to tens of thousands of rows.
+ */
+static void write_trade_row(SamtraderWriter *out, const SamtraderClosedTrade *trade,
+                            bool with_symbol) {
+  int64_t qty = (trade->quantity >= 0) ? trade->quantity : -trade->quantity;
+  double duration_days = difftime(trade->exit_date, trade->entry_date) / 86400.0;
+
+  samtrader_writer_puts(out, "  [");
+  if (with_symbol) {
+    samtrader_writer_puts(out, trade->code ? trade->code : "N/A");
+    samtrader_writer_puts(out, "], [");
+  }
+  samtrader_writer_puts(out, (trade->quantity > 0) ? "Long" : "Short");
+  samtrader_writer_puts(out, "], [");
+  samtrader_writer_int(out, (long long)qty);
+  samtrader_writer_puts(out, "], [\\$");
+  samtrader_writer_fixed(out, trade->entry_price, 2);
+  samtrader_writer_puts(out, "], [\\$");
+  samtrader_writer_fixed(out, trade->exit_price, 2);
+  samtrader_writer_puts(out, "], [");
+  write_trade_date(out, trade->entry_date);
+  samtrader_writer_puts(out, "], [");
+  write_trade_date(out, trade->exit_date);
+  samtrader_writer_puts(out, "], [");
+  samtrader_writer_fixed(out, duration_days, 1);
+  if (trade->pnl >= 0.0) {
+    samtrader_writer_puts(out, " days], [#text(fill: rgb(\"#16a34a\"))[\\$");
+  } else {
+    samtrader_writer_puts(out, " days], [#text(fill: rgb(\"#dc2626\"))[\\$");
+  }
+  samtrader_writer_fixed(out, trade->pnl, 2);
+  samtrader_writer_puts(out, "]],\n");
 }
 
 /**
  * @brief Write the trade log section as a Typst table.
  */
-static void write_trade_log(FILE *out, SamrenaVector *trades) {
+static void write_trade_log(SamtraderWriter *out, SamrenaVector *trades) {
   if (trades == NULL || samrena_vector_size(trades) == 0) {
     return;
   }
 
   size_t n = samrena_vector_size(trades);
 
-  fprintf(out, "== Trade Log\n");
-  fprintf(out, "\n");
-  fprintf(out, "#table(\n");
-  fprintf(out, "  columns: (auto, auto, auto, auto, auto, auto, auto, auto, auto),\n");
-  fprintf(out, "  inset: 8pt,\n");
-  fprintf(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
-  fprintf(out, "  [*Symbol*], [*Side*], [*Qty*], [*Entry Price*], [*Exit Price*], "
-               "[*Entry Date*], [*Exit Date*], [*Duration*], [*P&L*],\n");
+  samtrader_writer_puts(out, "== Trade Log\n");
+  samtrader_writer_puts(out, "\n");
+  samtrader_writer_puts(out, "#table(\n");
+  samtrader_writer_puts(out,
+                        "  columns: (auto, auto, auto, auto, auto, auto, auto, auto, auto),\n");
+  samtrader_writer_puts(out, "  inset: 8pt,\n");
+  samtrader_writer_puts(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
+  samtrader_writer_puts(out, "  [*Symbol*], [*Side*], [*Qty*], [*Entry Price*], [*Exit Price*], "
+                             "[*Entry Date*], [*Exit Date*], [*Duration*], [*P&L*],\n");
 
   for (size_t i = 0; i < n; i++) {
     const SamtraderClosedTrade *trade =
         (const SamtraderClosedTrade *)samrena_vector_at_unchecked_const(trades, i);
+    write_trade_row(out, trade, true);
+  }
 
-    const char *symbol = trade->code ? trade->code : "N/A";
-    const char *side = (trade->quantity > 0) ? "Long" : "Short";
-    int64_t qty = (trade->quantity >= 0) ? trade->quantity : -trade->quantity;
-
-    char entry_date[16];
-    char exit_date[16];
-    struct tm *tm_info;
-
-    tm_info = localtime(&trade->entry_date);
-    strftime(entry_date, sizeof(entry_date), "%Y-%m-%d", tm_info);
-
-    tm_info = localtime(&trade->exit_date);
-    strftime(exit_date, sizeof(exit_date), "%Y-%m-%d", tm_info);
-
-    double duration_days = difftime(trade->exit_date, trade->entry_date) / 86400.0;
+  samtrader_writer_puts(out, ")\n");
+  samtrader_writer_puts(out, "\n");
+}
 
-    if (trade->pnl >= 0.0) {
-      fprintf(out,
-              "  [%s], [%s], [%lld], [\\$%.2f], [\\$%.2f], [%s], [%s], [%.1f days], "
-              "[#text(fill: rgb(\"#16a34a\"))[\\$%.2f]],\n",
-              symbol, side, (long long)qty, trade->entry_price, trade->exit_price, entry_date,
-              exit_date, duration_days, trade->pnl);
-    } else {
-      fprintf(out,
-              "  [%s], [%s], [%lld], [\\$%.2f], [\\$%.2f], [%s], [%s], [%.1f days], "
-              "[#text(fill: rgb(\"#dc2626\"))[\\$%.2f]],\n",
-              symbol, side, (long long)qty, trade->entry_price, trade->exit_price, entry_date,
-              exit_date, duration_days, trade->pnl);
-    }
+/**
+ * @brief Write the Monte Carlo robustness section as a percentile table.
+ */
+static void write_montecarlo_section(SamtraderWriter *out, const SamtraderMonteCarloResult *mc) {
+  if (mc == NULL) {
+    return;
   }
 
-  fprintf(out, ")\n");
-  fprintf(out, "\n");
+  samtrader_writer_puts(out, "== Monte Carlo Robustness\n");
+  samtrader_writer_puts(out, "\n");
+  if (mc->method == SAMTRADER_MONTECARLO_RETURNS) {
+    samtrader_writer_printf(
+        out, "%zu paths of %zu bar returns, block bootstrapped in blocks of %zu bars.\n",
+        mc->samples, mc->sample_length, mc->block_length);
+  } else {
+    samtrader_writer_printf(out, "%zu paths of %zu closed trades, resampled with replacement.\n",
+                            mc->samples, mc->sample_length);
+  }
+  samtrader_writer_puts(out, "\n");
+  samtrader_writer_puts(out, "#table(\n");
+  samtrader_writer_puts(out, "  columns: (1fr, 1fr, 1fr, 1fr),\n");
+  samtrader_writer_puts(out, "  inset: 8pt,\n");
+  samtrader_writer_puts(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
+  samtrader_writer_puts(
+      out, "  [*Percentile*], [*Total Return*], [*Sharpe Ratio*], [*Max Drawdown*],\n");
+  for (size_t i = 0; i < SAMTRADER_MONTECARLO_LEVELS; i++) {
+    samtrader_writer_printf(out, "  [%.0f%%], [%.2f%%], [%.3f], [%.2f%%],\n", mc->levels[i],
+                            mc->total_return[i] * 100.0, mc->sharpe_ratio[i],
+                            mc->max_drawdown[i] * 100.0);
+  }
+  samtrader_writer_puts(out, ")\n");
+  samtrader_writer_puts(out, "\n");
+  samtrader_writer_printf(out, "Probability of loss: %.2f%%\n", mc->probability_of_loss * 100.0);
+  samtrader_writer_puts(out, "\n");
 }
 
 /* ============================================================================
@@ -923,62 +1081,63 @@ static void write_trade_log(FILE *out, SamrenaVector *trades) {
 /**
  * @brief Write a universe summary table with per-code overview.
  */
-static void write_universe_summary_table(FILE *out, SamtraderCodeResult *results, size_t count) {
+static void write_universe_summary_table(SamtraderWriter *out, SamtraderCodeResult *results,
+                                         size_t count) {
   if (results == NULL || count == 0) {
     return;
   }
 
-  fprintf(out, "== Universe Summary\n");
-  fprintf(out, "\n");
-  fprintf(out, "#table(\n");
-  fprintf(out, "  columns: (auto, auto, auto, auto, auto, auto),\n");
-  fprintf(out, "  inset: 8pt,\n");
-  fprintf(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
-  fprintf(out, "  [*Code*], [*Trades*], [*Win Rate*], [*Total PnL*], "
-               "[*Largest Win*], [*Largest Loss*],\n");
+  samtrader_writer_puts(out, "== Universe Summary\n");
+  samtrader_writer_puts(out, "\n");
+  samtrader_writer_puts(out, "#table(\n");
+  samtrader_writer_puts(out, "  columns: (auto, auto, auto, auto, auto, auto),\n");
+  samtrader_writer_puts(out, "  inset: 8pt,\n");
+  samtrader_writer_puts(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
+  samtrader_writer_puts(out, "  [*Code*], [*Trades*], [*Win Rate*], [*Total PnL*], "
+                             "[*Largest Win*], [*Largest Loss*],\n");
 
   for (size_t i = 0; i < count; i++) {
     SamtraderCodeResult *cr = &results[i];
     const char *pnl_color = (cr->total_pnl >= 0.0) ? "#16a34a" : "#dc2626";
-    fprintf(out,
-            "  [%s], [%d], [%.1f%%], "
-            "[#text(fill: rgb(\"%s\"))[\\$%.2f]], "
-            "[\\$%.2f], [\\$%.2f],\n",
-            cr->code, cr->total_trades, cr->win_rate * 100.0, pnl_color, cr->total_pnl,
-            cr->largest_win, cr->largest_loss);
+    samtrader_writer_printf(out,
+                            "  [%s], [%d], [%.1f%%], "
+                            "[#text(fill: rgb(\"%s\"))[\\$%.2f]], "
+                            "[\\$%.2f], [\\$%.2f],\n",
+                            cr->code, cr->total_trades, cr->win_rate * 100.0, pnl_color,
+                            cr->total_pnl, cr->largest_win, cr->largest_loss);
   }
 
-  fprintf(out, ")\n");
-  fprintf(out, "\n");
+  samtrader_writer_puts(out, ")\n");
+  samtrader_writer_puts(out, "\n");
 }
 
 /**
  * @brief Write a detail section for a single code.
  */
-static void write_per_code_detail_section(FILE *out, SamtraderCodeResult *cr,
+static void write_per_code_detail_section(SamtraderWriter *out, SamtraderCodeResult *cr,
                                           SamrenaVector *all_trades) {
   if (cr == NULL) {
     return;
   }
 
-  fprintf(out, "== %s Detail\n", cr->code);
-  fprintf(out, "\n");
+  samtrader_writer_printf(out, "== %s Detail\n", cr->code);
+  samtrader_writer_puts(out, "\n");
 
   /* Metrics table */
-  fprintf(out, "#table(\n");
-  fprintf(out, "  columns: (1fr, 1fr),\n");
-  fprintf(out, "  inset: 8pt,\n");
-  fprintf(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
-  fprintf(out, "  [*Metric*], [*Value*],\n");
-  fprintf(out, "  [Total Trades], [%d],\n", cr->total_trades);
-  fprintf(out, "  [Winning Trades], [%d],\n", cr->winning_trades);
-  fprintf(out, "  [Losing Trades], [%d],\n", cr->losing_trades);
-  fprintf(out, "  [Win Rate], [%.1f%%],\n", cr->win_rate * 100.0);
-  fprintf(out, "  [Total PnL], [\\$%.2f],\n", cr->total_pnl);
-  fprintf(out, "  [Largest Win], [\\$%.2f],\n", cr->largest_win);
-  fprintf(out, "  [Largest Loss], [\\$%.2f],\n", cr->largest_loss);
-  fprintf(out, ")\n");
-  fprintf(out, "\n");
+  samtrader_writer_puts(out, "#table(\n");
+  samtrader_writer_puts(out, "  columns: (1fr, 1fr),\n");
+  samtrader_writer_puts(out, "  inset: 8pt,\n");
+  samtrader_writer_puts(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
+  samtrader_writer_puts(out, "  [*Metric*], [*Value*],\n");
+  samtrader_writer_printf(out, "  [Total Trades], [%d],\n", cr->total_trades);
+  samtrader_writer_printf(out, "  [Winning Trades], [%d],\n", cr->winning_trades);
+  samtrader_writer_printf(out, "  [Losing Trades], [%d],\n", cr->losing_trades);
+  samtrader_writer_printf(out, "  [Win Rate], [%.1f%%],\n", cr->win_rate * 100.0);
+  samtrader_writer_printf(out, "  [Total PnL], [\\$%.2f],\n", cr->total_pnl);
+  samtrader_writer_printf(out, "  [Largest Win], [\\$%.2f],\n", cr->largest_win);
+  samtrader_writer_printf(out, "  [Largest Loss], [\\$%.2f],\n", cr->largest_loss);
+  samtrader_writer_puts(out, ")\n");
+  samtrader_writer_puts(out, "\n");
 
   /* Filtered trade log */
   if (all_trades == NULL || samrena_vector_size(all_trades) == 0) {
@@ -1002,14 +1161,14 @@ static void write_per_code_detail_section(FILE *out, SamtraderCodeResult *cr,
     return;
   }
 
-  fprintf(out, "=== Trades\n");
-  fprintf(out, "\n");
-  fprintf(out, "#table(\n");
-  fprintf(out, "  columns: (auto, auto, auto, auto, auto, auto, auto, auto),\n");
-  fprintf(out, "  inset: 8pt,\n");
-  fprintf(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
-  fprintf(out, "  [*Side*], [*Qty*], [*Entry Price*], [*Exit Price*], "
-               "[*Entry Date*], [*Exit Date*], [*Duration*], [*P&L*],\n");
+  samtrader_writer_puts(out, "=== Trades\n");
+  samtrader_writer_puts(out, "\n");
+  samtrader_writer_puts(out, "#table(\n");
+  samtrader_writer_puts(out, "  columns: (auto, auto, auto, auto, auto, auto, auto, auto),\n");
+  samtrader_writer_puts(out, "  inset: 8pt,\n");
+  samtrader_writer_puts(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
+  samtrader_writer_puts(out, "  [*Side*], [*Qty*], [*Entry Price*], [*Exit Price*], "
+                             "[*Entry Date*], [*Exit Date*], [*Duration*], [*P&L*],\n");
 
   for (size_t i = 0; i < n; i++) {
     const SamtraderClosedTrade *trade =
@@ -1017,108 +1176,56 @@ static void write_per_code_detail_section(FILE *out, SamtraderCodeResult *cr,
     if (!trade->code || strcmp(trade->code, cr->code) != 0) {
       continue;
     }
-
-    const char *side = (trade->quantity > 0) ? "Long" : "Short";
-    int64_t qty = (trade->quantity >= 0) ? trade->quantity : -trade->quantity;
-
-    char entry_date[16];
-    char exit_date[16];
-    struct tm *tm_info;
-
-    tm_info = localtime(&trade->entry_date);
-    strftime(entry_date, sizeof(entry_date), "%Y-%m-%d", tm_info);
-
-    tm_info = localtime(&trade->exit_date);
-    strftime(exit_date, sizeof(exit_date), "%Y-%m-%d", tm_info);
-
-    double duration_days = difftime(trade->exit_date, trade->entry_date) / 86400.0;
-
-    if (trade->pnl >= 0.0) {
-      fprintf(out,
-              "  [%s], [%lld], [\\$%.2f], [\\$%.2f], [%s], [%s], [%.1f days], "
-              "[#text(fill: rgb(\"#16a34a\"))[\\$%.2f]],\n",
-              side, (long long)qty, trade->entry_price, trade->exit_price, entry_date, exit_date,
-              duration_days, trade->pnl);
-    } else {
-      fprintf(out,
-              "  [%s], [%lld], [\\$%.2f], [\\$%.2f], [%s], [%s], [%.1f days], "
-              "[#text(fill: rgb(\"#dc2626\"))[\\$%.2f]],\n",
-              side, (long long)qty, trade->entry_price, trade->exit_price, entry_date, exit_date,
-              duration_days, trade->pnl);
-    }
+    write_trade_row(out, trade, false);
   }
 
-  fprintf(out, ")\n");
-  fprintf(out, "\n");
+  samtrader_writer_puts(out, ")\n");
+  samtrader_writer_puts(out, "\n");
 }
 
 /**
  * @brief Write the full trade log across all codes.
  */
-static void write_full_trade_log(FILE *out, SamrenaVector *trades) {
+static void write_full_trade_log(SamtraderWriter *out, SamrenaVector *trades) {
   if (trades == NULL || samrena_vector_size(trades) == 0) {
     return;
   }
 
   size_t n = samrena_vector_size(trades);
 
-  fprintf(out, "== Full Trade Log\n");
-  fprintf(out, "\n");
-  fprintf(out, "#table(\n");
-  fprintf(out, "  columns: (auto, auto, auto, auto, auto, auto, auto, auto, auto),\n");
-  fprintf(out, "  inset: 8pt,\n");
-  fprintf(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
-  fprintf(out, "  [*Symbol*], [*Side*], [*Qty*], [*Entry Price*], [*Exit Price*], "
-               "[*Entry Date*], [*Exit Date*], [*Duration*], [*P&L*],\n");
+  samtrader_writer_puts(out, "== Full Trade Log\n");
+  samtrader_writer_puts(out, "\n");
+  samtrader_writer_puts(out, "#table(\n");
+  samtrader_writer_puts(out,
+                        "  columns: (auto, auto, auto, auto, auto, auto, auto, auto, auto),\n");
+  samtrader_writer_puts(out, "  inset: 8pt,\n");
+  samtrader_writer_puts(out, "  fill: (x, y) => if y == 0 { luma(230) },\n");
+  samtrader_writer_puts(out, "  [*Symbol*], [*Side*], [*Qty*], [*Entry Price*], [*Exit Price*], "
+                             "[*Entry Date*], [*Exit Date*], [*Duration*], [*P&L*],\n");
 
   for (size_t i = 0; i < n; i++) {
     const SamtraderClosedTrade *trade =
         (const SamtraderClosedTrade *)samrena_vector_at_unchecked_const(trades, i);
-
-    const char *symbol = trade->code ? trade->code : "N/A";
-    const char *side = (trade->quantity > 0) ? "Long" : "Short";
-    int64_t qty = (trade->quantity >= 0) ? trade->quantity : -trade->quantity;
-
-    char entry_date[16];
-    char exit_date[16];
-    struct tm *tm_info;
-
-    tm_info = localtime(&trade->entry_date);
-    strftime(entry_date, sizeof(entry_date), "%Y-%m-%d", tm_info);
-
-    tm_info = localtime(&trade->exit_date);
-    strftime(exit_date, sizeof(exit_date), "%Y-%m-%d", tm_info);
-
-    double duration_days = difftime(trade->exit_date, trade->entry_date) / 86400.0;
-
-    if (trade->pnl >= 0.0) {
-      fprintf(out,
-              "  [%s], [%s], [%lld], [\\$%.2f], [\\$%.2f], [%s], [%s], [%.1f days], "
-              "[#text(fill: rgb(\"#16a34a\"))[\\$%.2f]],\n",
-              symbol, side, (long long)qty, trade->entry_price, trade->exit_price, entry_date,
-              exit_date, duration_days, trade->pnl);
-    } else {
-      fprintf(out,
-              "  [%s], [%s], [%lld], [\\$%.2f], [\\$%.2f], [%s], [%s], [%.1f days], "
-              "[#text(fill: rgb(\"#dc2626\"))[\\$%.2f]],\n",
-              symbol, side, (long long)qty, trade->entry_price, trade->exit_price, entry_date,
-              exit_date, duration_days, trade->pnl);
-    }
+    write_trade_row(out, trade, true);
   }
 
-  fprintf(out, ")\n");
-  fprintf(out, "\n");
+  samtrader_writer_puts(out, ")\n");
+  samtrader_writer_puts(out, "\n");
 }
 
 /**
  * @brief Write the default multi-code report (no custom template).
  */
-static bool write_default_multi_report(SamtraderMultiCodeResult *multi, SamtraderStrategy *strategy,
+static bool write_default_multi_report(Samrena *arena, size_t chart_points,
+                                       SamtraderMultiCodeResult *multi, SamtraderStrategy *strategy,
                                        const char *output_path) {
-  FILE *out = fopen(output_path, "w");
-  if (out == NULL) {
+  SamrenaScratch scratch = samrena_scratch_begin(arena);
+  SamtraderWriter writer;
+  if (!samtrader_writer_open(&writer, arena, output_path)) {
+    samrena_scratch_end(scratch);
     return false;
   }
+  SamtraderWriter *out = &writer;
 
   const char *name = strategy->name ? strategy->name : "Unnamed Strategy";
 
@@ -1129,8 +1236,9 @@ static bool write_default_multi_report(SamtraderMultiCodeResult *multi, Samtrade
   write_universe_summary_table(out, multi->code_results, multi->code_count);
   write_performance_metrics(out, &multi->aggregate);
   write_monthly_returns_table(out, multi->aggregate.equity_curve);
-  write_equity_curve_chart(out, multi->aggregate.equity_curve);
-  write_drawdown_chart(out, multi->aggregate.equity_curve);
+  write_equity_curve_chart(out, multi->aggregate.equity_curve, chart_points);
+  write_drawdown_chart(out, multi->aggregate.equity_curve, chart_points);
+  write_montecarlo_section(out, multi->aggregate.montecarlo);
 
   for (size_t i = 0; i < multi->code_count; i++) {
     write_per_code_detail_section(out, &multi->code_results[i], multi->aggregate.trades);
@@ -1138,14 +1246,16 @@ static bool write_default_multi_report(SamtraderMultiCodeResult *multi, Samtrade
 
   write_full_trade_log(out, multi->aggregate.trades);
 
-  fclose(out);
-  return true;
+  bool ok = samtrader_writer_close(out);
+  samrena_scratch_end(scratch);
+  return ok;
 }
 
 /**
  * @brief Write a multi-code report using a custom Typst template.
  */
-static bool write_template_multi_report(const char *template_path, SamtraderMultiCodeResult *multi,
+static bool write_template_multi_report(Samrena *arena, const char *template_path,
+                                        size_t chart_points, SamtraderMultiCodeResult *multi,
                                         SamtraderStrategy *strategy, const char *output_path) {
   /* Read template file */
   FILE *tmpl_file = fopen(template_path, "r");
@@ -1172,12 +1282,15 @@ static bool write_template_multi_report(const char *template_path, SamtraderMult
   fclose(tmpl_file);
   template_buf[bytes_read] = '\0';
 
-  /* Open output file */
-  FILE *out = fopen(output_path, "w");
-  if (out == NULL) {
+  /* Open output file (its buffer lives in a scratch frame of the arena) */
+  SamrenaScratch scratch = samrena_scratch_begin(arena);
+  SamtraderWriter writer;
+  if (!samtrader_writer_open(&writer, arena, output_path)) {
+    samrena_scratch_end(scratch);
     free(template_buf);
     return false;
   }
+  SamtraderWriter *out = &writer;
 
   SamtraderBacktestResult *result = &multi->aggregate;
 
@@ -1186,22 +1299,22 @@ static bool write_template_multi_report(const char *template_path, SamtraderMult
   while (*pos != '\0') {
     const char *open = strstr(pos, "{{");
     if (open == NULL) {
-      fputs(pos, out);
+      samtrader_writer_puts(out, pos);
       break;
     }
 
-    fwrite(pos, 1, (size_t)(open - pos), out);
+    samtrader_writer_write(out, pos, (size_t)(open - pos));
 
     const char *key_start = open + 2;
     const char *close_marker = strstr(key_start, "}}");
     if (close_marker == NULL) {
-      fputs(open, out);
+      samtrader_writer_puts(out, open);
       break;
     }
 
     size_t key_len = (size_t)(close_marker - key_start);
     if (key_len >= MAX_KEY_LENGTH) {
-      fwrite(open, 1, (size_t)(close_marker + 2 - open), out);
+      samtrader_writer_write(out, open, (size_t)(close_marker + 2 - open));
       pos = close_marker + 2;
       continue;
     }
@@ -1217,12 +1330,12 @@ static bool write_template_multi_report(const char *template_path, SamtraderMult
       continue;
     }
     if (strcmp(key, "EQUITY_CURVE_CHART") == 0) {
-      write_equity_curve_chart(out, result->equity_curve);
+      write_equity_curve_chart(out, result->equity_curve, chart_points);
       pos = close_marker + 2;
       continue;
     }
     if (strcmp(key, "DRAWDOWN_CHART") == 0) {
-      write_drawdown_chart(out, result->equity_curve);
+      write_drawdown_chart(out, result->equity_curve, chart_points);
       pos = close_marker + 2;
       continue;
     }
@@ -1231,6 +1344,11 @@ static bool write_template_multi_report(const char *template_path, SamtraderMult
       pos = close_marker + 2;
       continue;
     }
+    if (strcmp(key, "MONTE_CARLO") == 0) {
+      write_montecarlo_section(out, result->montecarlo);
+      pos = close_marker + 2;
+      continue;
+    }
     if (strcmp(key, "UNIVERSE_SUMMARY") == 0) {
       write_universe_summary_table(out, multi->code_results, multi->code_count);
       pos = close_marker + 2;
@@ -1252,28 +1370,33 @@ static bool write_template_multi_report(const char *template_path, SamtraderMult
     /* Resolve scalar placeholder */
     char value[MAX_VALUE_LENGTH];
     if (resolve_placeholder(key, result, strategy, value, sizeof(value))) {
-      fputs(value, out);
+      samtrader_writer_puts(out, value);
     } else {
-      fwrite(open, 1, (size_t)(close_marker + 2 - open), out);
+      samtrader_writer_write(out, open, (size_t)(close_marker + 2 - open));
     }
 
     pos = close_marker + 2;
   }
 
   free(template_buf);
-  fclose(out);
-  return true;
+  bool ok = samtrader_writer_close(out);
+  samrena_scratch_end(scratch);
+  return ok;
 }
 
 /**
  * @brief Write the default report (no custom template).
  */
-static bool write_default_report(SamtraderBacktestResult *result, SamtraderStrategy *strategy,
+static bool write_default_report(Samrena *arena, size_t chart_points,
+                                 SamtraderBacktestResult *result, SamtraderStrategy *strategy,
                                  const char *output_path) {
-  FILE *out = fopen(output_path, "w");
-  if (out == NULL) {
+  SamrenaScratch scratch = samrena_scratch_begin(arena);
+  SamtraderWriter writer;
+  if (!samtrader_writer_open(&writer, arena, output_path)) {
+    samrena_scratch_end(scratch);
     return false;
   }
+  SamtraderWriter *out = &writer;
 
   const char *name = strategy->name ? strategy->name : "Unnamed Strategy";
 
@@ -1283,12 +1406,14 @@ static bool write_default_report(SamtraderBacktestResult *result, SamtraderStrat
   write_strategy_parameters(out, strategy);
   write_performance_metrics(out, result);
   write_monthly_returns_table(out, result->equity_curve);
-  write_equity_curve_chart(out, result->equity_curve);
-  write_drawdown_chart(out, result->equity_curve);
+  write_equity_curve_chart(out, result->equity_curve, chart_points);
+  write_drawdown_chart(out, result->equity_curve, chart_points);
+  write_montecarlo_section(out, result->montecarlo);
   write_trade_log(out, result->trades);
 
-  fclose(out);
-  return true;
+  bool ok = samtrader_writer_close(out);
+  samrena_scratch_end(scratch);
+  return ok;
 }
 
 /* ============================================================================
@@ -1305,10 +1430,11 @@ static bool typst_report_write(SamtraderReportPort *port, SamtraderBacktestResul
   TypstReportImpl *impl = (TypstReportImpl *)port->impl;
 
   if (impl->template_path != NULL) {
-    return write_template_report(impl->template_path, result, strategy, output_path);
+    return write_template_report(port->arena, impl->template_path, impl->chart_points, result,
+                                 strategy, output_path);
   }
 
-  return write_default_report(result, strategy, output_path);
+  return write_default_report(port->arena, impl->chart_points, result, strategy, output_path);
 }
 
 static bool typst_report_write_multi(SamtraderReportPort *port,
@@ -1322,10 +1448,12 @@ static bool typst_report_write_multi(SamtraderReportPort *port,
   TypstReportImpl *impl = (TypstReportImpl *)port->impl;
 
   if (impl->template_path != NULL) {
-    return write_template_multi_report(impl->template_path, multi_result, strategy, output_path);
+    return write_template_multi_report(port->arena, impl->template_path, impl->chart_points,
+                                       multi_result, strategy, output_path);
   }
 
-  return write_default_multi_report(multi_result, strategy, output_path);
+  return write_default_multi_report(port->arena, impl->chart_points, multi_result, strategy,
+                                    output_path);
 }
 
 static void typst_report_close(SamtraderReportPort *port) {
@@ -1370,6 +1498,7 @@ SamtraderReportPort *samtrader_typst_adapter_create(Samrena *arena, const char *
   } else {
     impl->template_path = NULL;
   }
+  impl->chart_points = DEFAULT_CHART_POINTS;
 
   /* Initialize port structure */
   port->impl = impl;
@@ -1380,3 +1509,11 @@ SamtraderReportPort *samtrader_typst_adapter_create(Samrena *arena, const char *
 
   return port;
 }
+
+void samtrader_typst_adapter_set_chart_points(SamtraderReportPort *port, size_t chart_points) {
+  if (port == NULL || port->impl == NULL) {
+    return;
+  }
+  TypstReportImpl *impl = (TypstReportImpl *)port->impl;
+  impl->chart_points = chart_points < MIN_CHART_POINTS ? MIN_CHART_POINTS : chart_points;
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "samtrader/adapters/writer.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Digits needed for any long long plus sign */
+#define INT_DIGITS 24
+
+static const double POW10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+
+/* Write length bytes to the descriptor, retrying partial and interrupted writes */
+static void write_all(SamtraderWriter *writer, const char *data, size_t length) {
+  while (length > 0 && !writer->failed) {
+    ssize_t written = write(writer->fd, data, length);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      writer->failed = true;
+      return;
+    }
+    data += written;
+    length -= (size_t)written;
+  }
+}
+
+/* Make room for need bytes, flushing if the buffer cannot hold them */
+static bool reserve(SamtraderWriter *writer, size_t need) {
+  if (writer->failed) {
+    return false;
+  }
+  if (writer->capacity - writer->length < need) {
+    samtrader_writer_flush(writer);
+  }
+  return !writer->failed && writer->capacity - writer->length >= need;
+}
+
+void samtrader_writer_init(SamtraderWriter *writer, int fd, char *buffer, size_t capacity) {
+  writer->fd = fd;
+  writer->buffer = buffer;
+  writer->length = 0;
+  writer->capacity = capacity;
+  writer->failed = fd < 0 || buffer == NULL || capacity == 0;
+}
+
+bool samtrader_writer_open(SamtraderWriter *writer, Samrena *arena, const char *path) {
+  if (writer == NULL || arena == NULL || path == NULL) {
+    return false;
+  }
+  char *buffer = samrena_push(arena, SAMTRADER_WRITER_CHUNK);
+  if (buffer == NULL) {
+    return false;
+  }
+  int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  samtrader_writer_init(writer, fd, buffer, SAMTRADER_WRITER_CHUNK);
+  return true;
+}
+
+void samtrader_writer_write(SamtraderWriter *writer, const char *data, size_t length) {
+  if (length > writer->capacity) {
+    /* Larger than the whole buffer: pass it straight through */
+    samtrader_writer_flush(writer);
+    write_all(writer, data, length);
+    return;
+  }
+  if (!reserve(writer, length)) {
+    return;
+  }
+  memcpy(writer->buffer + writer->length, data, length);
+  writer->length += length;
+}
+
+void samtrader_writer_puts(SamtraderWriter *writer, const char *text) {
+  samtrader_writer_write(writer, text, strlen(text));
+}
+
+void samtrader_writer_printf(SamtraderWriter *writer, const char *format, ...) {
+  if (writer->failed) {
+    return;
+  }
+  va_list args;
+  va_start(args, format);
+  size_t room = writer->capacity - writer->length;
+  int needed = vsnprintf(writer->buffer + writer->length, room, format, args);
+  va_end(args);
+  if (needed < 0) {
+    writer->failed = true;
+    return;
+  }
+  if ((size_t)needed < room) {
+    writer->length += (size_t)needed;
+    return;
+  }
+
+  /* Did not fit: flush and format again, into a temporary if still too long */
+  va_start(args, format);
+  if (reserve(writer, (size_t)needed + 1)) {
+    vsnprintf(writer->buffer + writer->length, (size_t)needed + 1, format, args);
+    writer->length += (size_t)needed;
+  } else if (!writer->failed) {
+    char *text = malloc((size_t)needed + 1);
+    if (text == NULL) {
+      writer->failed = true;
+    } else {
+      vsnprintf(text, (size_t)needed + 1, format, args);
+      samtrader_writer_write(writer, text, (size_t)needed);
+      free(text);
+    }
+  }
+  va_end(args);
+}
+
+/* Convert value's digits backwards ending at end; returns the first digit */
+static char *format_digits(char *end, uint64_t value) {
+  do {
+    *--end = (char)('0' + value % 10);
+    value /= 10;
+  } while (value > 0);
+  return end;
+}
+
+void samtrader_writer_int(SamtraderWriter *writer, long long value) {
+  char digits[INT_DIGITS];
+  char *end = digits + sizeof(digits);
+  uint64_t magnitude = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+  char *start = format_digits(end, magnitude);
+  if (value < 0) {
+    *--start = '-';
+  }
+  samtrader_writer_write(writer, start, (size_t)(end - start));
+}
+
+void samtrader_writer_fixed(SamtraderWriter *writer, double value, int decimals) {
+  if (decimals < 0 || decimals > 9 || !isfinite(value) ||
+      fabs(value) * POW10[decimals] >= 9007199254740992.0) {
+    samtrader_writer_printf(writer, "%.*f", decimals < 0 ? 0 : decimals, value);
+    return;
+  }
+
+  double magnitude = fabs(value) * POW10[decimals];
+  double scaled = round(magnitude);
+  if (scaled - magnitude == 0.5) {
+    /*
+     * round() takes halves away from zero, but printf rounds the exact
+     * value: the product's rounding error says which side of the half it
+     * lies on, and a true tie goes to the even unit.
+     */
+    double error = fma(fabs(value), POW10[decimals], -magnitude);
+    if (error < 0.0 || (error == 0.0 && fmod(scaled, 2.0) != 0.0)) {
+      scaled -= 1.0;
+    }
+  }
+  uint64_t units = (uint64_t)scaled;
+
+  char digits[INT_DIGITS + 2];
+  char *end = digits + sizeof(digits);
+  char *start = end;
+  for (int i = 0; i < decimals; i++) {
+    *--start = (char)('0' + units % 10);
+    units /= 10;
+  }
+  if (decimals > 0) {
+    *--start = '.';
+  }
+  start = format_digits(start, units);
+  if (value < 0.0 && scaled > 0.0) {
+    *--start = '-';
+  }
+  samtrader_writer_write(writer, start, (size_t)(end - start));
+}
+
+bool samtrader_writer_flush(SamtraderWriter *writer) {
+  if (writer->length > 0) {
+    write_all(writer, writer->buffer, writer->length);
+    writer->length = 0;
+  }
+  return !writer->failed;
+}
+
+bool samtrader_writer_close(SamtraderWriter *writer) {
+  bool ok = samtrader_writer_flush(writer);
+  if (writer->fd >= 0) {
+    if (close(writer->fd) != 0) {
+      ok = false;
+    }
+    writer->fd = -1;
+  }
+  return ok;
+}
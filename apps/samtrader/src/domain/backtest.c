@@ -0,0 +1,269 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "samtrader/domain/backtest.h"
+
+#include <math.h>
+#include <stdint.h>
+
+#include "samtrader/domain/execution.h"
+#include "samtrader/domain/metrics.h"
+#include "samtrader/domain/position.h"
+
+/* A code's rule signals waiting for its next bar (SAMTRADER_FILL_NEXT_BAR_OPEN) */
+typedef struct {
+  bool exit;    /* close the open position */
+  int8_t entry; /* +1 enter long, -1 enter short, 0 none */
+} PendingOrder;
+
+static void enter(SamtraderPortfolio *portfolio, Samrena *arena,
+                  const SamtraderBacktestConfig *config, const SamtraderStrategy *strategy,
+                  const SamtraderCodeData *cd, int8_t side, double price, time_t date) {
+  if (side > 0) {
+    samtrader_execution_enter_long(portfolio, arena, cd->code, cd->exchange, price, date,
+                                   strategy->position_size, strategy->stop_loss_pct,
+                                   strategy->take_profit_pct, strategy->max_positions,
+                                   config->commission_per_trade, config->commission_pct,
+                                   config->slippage_pct);
+  } else if (side < 0) {
+    samtrader_execution_enter_short(portfolio, arena, cd->code, cd->exchange, price, date,
+                                    strategy->position_size, strategy->stop_loss_pct,
+                                    strategy->take_profit_pct, strategy->max_positions,
+                                    config->commission_per_trade, config->commission_pct,
+                                    config->slippage_pct);
+  }
+}
+
+/* Fill a code's pending order at the open of its bar bar_idx */
+static void fill_pending(SamtraderPortfolio *portfolio, Samrena *arena,
+                         const SamtraderBacktestConfig *config, const SamtraderStrategy *strategy,
+                         const SamtraderCodeData *cd, SamtraderSymbolId symbol,
+                         PendingOrder *order, size_t bar_idx, time_t date) {
+  double open = cd->bars->open[bar_idx];
+  if (order->exit && samtrader_portfolio_position_at(portfolio, symbol)) {
+    samtrader_execution_exit_position(portfolio, arena, cd->code, open, date,
+                                      config->commission_per_trade, config->commission_pct,
+                                      config->slippage_pct);
+  }
+  if (order->entry && !samtrader_portfolio_position_at(portfolio, symbol)) {
+    enter(portfolio, arena, config, strategy, cd, order->entry, open, date);
+  }
+  *order = (PendingOrder){0};
+}
+
+/* Read a code's precomputed rule signals at its bar bar_idx; signals fill at the
+ * close, or are left in pending for the next bar's open when pending is non-NULL */
+static void step_code(SamtraderPortfolio *portfolio, Samrena *arena,
+                      const SamtraderBacktestConfig *config, const SamtraderStrategy *strategy,
+                      const SamtraderCodeData *cd, const SamtraderStrategyProgram *program,
+                      SamtraderSymbolId symbol, size_t bar_idx, time_t date,
+                      PendingOrder *pending) {
+  double close = cd->bars->close[bar_idx];
+
+  /* Evaluate exit rules for existing positions */
+  SamtraderPosition *pos = samtrader_portfolio_position_at(portfolio, symbol);
+  bool should_exit = false;
+  if (pos) {
+    if (samtrader_position_is_long(pos)) {
+      should_exit = samtrader_rule_signals_test(&program->exit_long_signals, bar_idx);
+    } else if (samtrader_position_is_short(pos) && program->exit_short) {
+      should_exit = samtrader_rule_signals_test(&program->exit_short_signals, bar_idx);
+    }
+    if (should_exit && pending) {
+      pending->exit = true;
+    } else if (should_exit) {
+      samtrader_execution_exit_position(portfolio, arena, cd->code, close, date,
+                                        config->commission_per_trade, config->commission_pct,
+                                        config->slippage_pct);
+    }
+  }
+
+  /* Evaluate entry rules (max_positions enforced globally); a pending exit
+   * counts as flat, as a filled one would */
+  bool flat = pending ? !pos || should_exit : !samtrader_portfolio_position_at(portfolio, symbol);
+  if (flat) {
+    bool enter_long = samtrader_rule_signals_test(&program->entry_long_signals, bar_idx);
+    bool enter_short = config->allow_shorting && program->entry_short
+                           ? samtrader_rule_signals_test(&program->entry_short_signals, bar_idx)
+                           : false;
+    int8_t side = enter_long ? 1 : enter_short ? -1 : 0;
+
+    if (pending) {
+      pending->entry = side;
+    } else {
+      enter(portfolio, arena, config, strategy, cd, side, close, date);
+    }
+  }
+}
+
+/* Exit every open position at its code's latest close on or before timeline date t, so the
+ * run ends flat with the exits recorded as trades and charged like any other */
+static void close_all(SamtraderPortfolio *portfolio, Samrena *arena,
+                      const SamtraderBacktestConfig *config, SamtraderCodeData *const *code_data,
+                      const SamtraderSymbolId *symbols, const SamtraderTimeline *timeline,
+                      size_t t, time_t date) {
+  size_t code_count = timeline->code_count;
+  for (size_t c = 0; c < code_count; c++) {
+    if (!samtrader_portfolio_position_at(portfolio, symbols[c]))
+      continue;
+    size_t row = t + 1;
+    while (row > 0 && timeline->bar_index[(row - 1) * code_count + c] < 0)
+      row--;
+    if (row == 0)
+      continue; /* no bar in the timeline to price it at */
+    size_t bar_idx = (size_t)timeline->bar_index[(row - 1) * code_count + c];
+    samtrader_execution_exit_position(portfolio, arena, code_data[c]->code,
+                                      code_data[c]->bars->close[bar_idx], date,
+                                      config->commission_per_trade, config->commission_pct,
+                                      config->slippage_pct);
+  }
+}
+
+/* The simulation loop; with metrics set, results stream into it instead of the equity curve */
+static SamtraderPortfolio *simulate(Samrena *arena, const SamtraderBacktestConfig *config,
+                                    const SamtraderStrategy *strategy,
+                                    SamtraderCodeData *const *code_data,
+                                    const SamtraderStrategyProgram *programs,
+                                    const SamtraderTimeline *timeline,
+                                    SamtraderMetricsAccumulator *metrics) {
+
+  size_t code_count = timeline->code_count;
+  for (size_t c = 0; c < code_count; c++) {
+    if (!code_data[c] || !code_data[c]->bars)
+      return NULL;
+  }
+
+  SamtraderPortfolio *portfolio = samtrader_portfolio_create(arena, config->initial_capital);
+  SamtraderSymbolId *symbols =
+      SAMRENA_PUSH_ARRAY(arena, SamtraderSymbolId, code_count > 0 ? code_count : 1);
+  if (!portfolio || !symbols)
+    return NULL;
+
+  /* Intern every code up front; the loop below only deals in symbol ids */
+  for (size_t c = 0; c < code_count; c++) {
+    symbols[c] = samtrader_portfolio_intern(portfolio, code_data[c]->code);
+    if (symbols[c] == SAMTRADER_SYMBOL_NONE)
+      return NULL;
+  }
+
+  /* prices[symbols[c]] holds code c's close on the current date; intrabar
+   * triggers also need the open, high and low of that bar */
+  bool intrabar = config->trigger_policy == SAMTRADER_TRIGGER_WORST_CASE;
+  SamtraderPriceTable *prices = intrabar
+                                    ? samtrader_price_table_create_ohlc(arena, portfolio->symbols)
+                                    : samtrader_price_table_create(arena, portfolio->symbols);
+  if (!prices)
+    return NULL;
+
+  PendingOrder *pending = NULL;
+  if (config->fill_policy == SAMTRADER_FILL_NEXT_BAR_OPEN) {
+    pending = SAMRENA_PUSH_ARRAY_ZERO(arena, PendingOrder, code_count > 0 ? code_count : 1);
+    if (!pending)
+      return NULL;
+  }
+
+  size_t trades_fed = 0; /* Closed trades already handed to metrics */
+
+  /* Per-step transient data lives here so the run arena only grows with results */
+  Samrena *scratch = samrena_create_default();
+  if (!scratch)
+    return NULL;
+
+  for (size_t t = 0; t < timeline->date_count; t++) {
+    time_t date = *(const time_t *)samrena_vector_at_const(timeline->dates, t);
+    const int32_t *bar_row = timeline->bar_index + t * code_count;
+
+    for (size_t c = 0; c < code_count; c++)
+      prices->prices[symbols[c]] = bar_row[c] >= 0 ? code_data[c]->bars->close[bar_row[c]] : NAN;
+    if (intrabar) {
+      for (size_t c = 0; c < code_count; c++) {
+        const SamtraderBarColumns *bars = code_data[c]->bars;
+        bool has_bar = bar_row[c] >= 0;
+        prices->open[symbols[c]] = has_bar ? bars->open[bar_row[c]] : NAN;
+        prices->high[symbols[c]] = has_bar ? bars->high[bar_row[c]] : NAN;
+        prices->low[symbols[c]] = has_bar ? bars->low[bar_row[c]] : NAN;
+      }
+    }
+
+    /* Fill orders signalled on each code's previous bar at this bar's open */
+    if (pending) {
+      for (size_t c = 0; c < code_count; c++) {
+        if (bar_row[c] >= 0 && (pending[c].exit || pending[c].entry))
+          fill_pending(portfolio, arena, config, strategy, code_data[c], symbols[c], &pending[c],
+                       (size_t)bar_row[c], date);
+      }
+    }
+
+    /* Check stop loss / take profit triggers across all positions */
+    if (intrabar)
+      samtrader_execution_check_triggers_ohlc(portfolio, arena, scratch, prices, date,
+                                              config->commission_per_trade,
+                                              config->commission_pct, config->slippage_pct);
+    else
+      samtrader_execution_check_triggers_at(portfolio, arena, scratch, prices, date,
+                                            config->commission_per_trade, config->commission_pct,
+                                            config->slippage_pct);
+
+    /* For each code with data on this date */
+    for (size_t c = 0; c < code_count; c++) {
+      if (bar_row[c] < 0)
+        continue;
+      step_code(portfolio, arena, config, strategy, code_data[c], &programs[c], symbols[c],
+                (size_t)bar_row[c], date, pending ? &pending[c] : NULL);
+    }
+
+    if (config->close_at_end && t + 1 == timeline->date_count)
+      close_all(portfolio, arena, config, code_data, symbols, timeline, t, date);
+
+    /* Record equity (cash + all position market values) */
+    double equity = samtrader_portfolio_total_equity_at(portfolio, prices);
+    if (metrics) {
+      size_t trade_count = samrena_vector_size(portfolio->closed_trades);
+      const SamtraderClosedTrade *trades =
+          (const SamtraderClosedTrade *)portfolio->closed_trades->data;
+      for (; trades_fed < trade_count; trades_fed++)
+        samtrader_metrics_accumulator_add_trade(metrics, &trades[trades_fed]);
+      samtrader_metrics_accumulator_add_equity(metrics, equity);
+    } else {
+      samtrader_portfolio_record_equity(portfolio, arena, date, equity);
+    }
+  }
+
+  samrena_destroy(scratch);
+  return portfolio;
+}
+
+SamtraderPortfolio *samtrader_backtest_run(Samrena *arena, const SamtraderBacktestConfig *config,
+                                           const SamtraderStrategy *strategy,
+                                           SamtraderCodeData *const *code_data,
+                                           const SamtraderStrategyProgram *programs,
+                                           const SamtraderTimeline *timeline) {
+  if (!arena || !config || !strategy || !code_data || !programs || !timeline)
+    return NULL;
+  return simulate(arena, config, strategy, code_data, programs, timeline, NULL);
+}
+
+SamtraderPortfolio *samtrader_backtest_run_streaming(Samrena *arena,
+                                                     const SamtraderBacktestConfig *config,
+                                                     const SamtraderStrategy *strategy,
+                                                     SamtraderCodeData *const *code_data,
+                                                     const SamtraderStrategyProgram *programs,
+                                                     const SamtraderTimeline *timeline,
+                                                     SamtraderMetricsAccumulator *metrics) {
+  if (!arena || !config || !strategy || !code_data || !programs || !timeline || !metrics)
+    return NULL;
+  return simulate(arena, config, strategy, code_data, programs, timeline, metrics);
+}
@@ -16,29 +16,21 @@
 
 #include "samtrader/domain/code_data.h"
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "samtrader/domain/indicator.h"
 #include "samtrader/domain/ohlcv.h"
+#include "samtrader/domain/resample.h"
 #include "samtrader/domain/rule.h"
 #include "samtrader/ports/data_port.h"
+#include "samtrader/ports/indicator_cache_port.h"
 
 #define INDICATOR_KEY_BUF_SIZE 64
 #define DATE_KEY_BUF_SIZE 32
 
-/* --- Arena string helper --- */
-
-static const char *arena_strdup(Samrena *arena, const char *src) {
-  size_t len = strlen(src);
-  char *copy = (char *)samrena_push(arena, len + 1);
-  if (!copy)
-    return NULL;
-  memcpy(copy, src, len + 1);
-  return copy;
-}
-
 /* --- Date key helper --- */
 
 static void date_to_key(char *buf, size_t buf_size, time_t date) {
@@ -90,68 +82,379 @@ static void collect_indicator_operands(const SamtraderRule *rule, SamHashMap *se
 }
 
 static SamtraderIndicatorSeries *
-calculate_indicator_for_operand(Samrena *arena, const SamtraderOperand *op, SamrenaVector *ohlcv) {
+calculate_indicator_for_operand(Samrena *arena, const SamtraderOperand *op,
+                                const SamtraderBarColumns *bars) {
   switch (op->indicator.indicator_type) {
     case SAMTRADER_IND_MACD:
-      return samtrader_calculate_macd(arena, ohlcv, op->indicator.period, op->indicator.param2,
-                                      op->indicator.param3);
+      return samtrader_calculate_macd_columns(arena, bars, op->indicator.period,
+                                              op->indicator.param2, op->indicator.param3);
     case SAMTRADER_IND_BOLLINGER:
-      return samtrader_calculate_bollinger(arena, ohlcv, op->indicator.period,
-                                           op->indicator.param2 / 100.0);
+      return samtrader_calculate_bollinger_columns(arena, bars, op->indicator.period,
+                                                   op->indicator.param2 / 100.0);
     case SAMTRADER_IND_STOCHASTIC:
-      return samtrader_calculate_stochastic(arena, ohlcv, op->indicator.period,
-                                            op->indicator.param2);
+      return samtrader_calculate_stochastic_columns(arena, bars, op->indicator.period,
+                                                    op->indicator.param2);
     case SAMTRADER_IND_PIVOT:
-      return samtrader_calculate_pivot(arena, ohlcv);
+      return samtrader_calculate_pivot_columns(arena, bars);
     default:
-      return samtrader_indicator_calculate(arena, op->indicator.indicator_type, ohlcv,
-                                           op->indicator.period);
+      return samtrader_indicator_calculate_columns(arena, op->indicator.indicator_type, bars,
+                                                   op->indicator.period);
   }
 }
 
-/* --- qsort comparator for time_t --- */
-
-static int compare_time(const void *a, const void *b) {
-  time_t ta = *(const time_t *)a;
-  time_t tb = *(const time_t *)b;
-  if (ta < tb)
+/*
+ * Fill every NULL entry of series (parallel to operands). SMA, EMA and
+ * Stochastic operands are grouped by type and each group is computed in
+ * one fused pass over the bars; the rest are computed one at a time.
+ */
+static int calculate_missing_indicators(Samrena *arena, const SamrenaVector *operands,
+                                        SamtraderIndicatorSeries **series,
+                                        const SamtraderBarColumns *bars) {
+  static const SamtraderIndicatorType fused_types[] = {
+      SAMTRADER_IND_SMA, SAMTRADER_IND_EMA, SAMTRADER_IND_STOCHASTIC};
+
+  size_t count = samrena_vector_size(operands);
+  if (count == 0)
+    return 0;
+
+  size_t *lanes = SAMRENA_PUSH_ARRAY(arena, size_t, count);
+  int *periods = SAMRENA_PUSH_ARRAY(arena, int, count);
+  int *param2s = SAMRENA_PUSH_ARRAY(arena, int, count);
+  if (!lanes || !periods || !param2s)
     return -1;
-  if (ta > tb)
-    return 1;
+
+  for (size_t t = 0; t < sizeof(fused_types) / sizeof(fused_types[0]); t++) {
+    size_t lane_count = 0;
+    for (size_t i = 0; i < count; i++) {
+      const SamtraderOperand *op = (const SamtraderOperand *)samrena_vector_at_const(operands, i);
+      if (series[i] || op->indicator.indicator_type != fused_types[t])
+        continue;
+      lanes[lane_count] = i;
+      periods[lane_count] = op->indicator.period;
+      param2s[lane_count] = op->indicator.param2;
+      lane_count++;
+    }
+    if (lane_count == 0)
+      continue;
+
+    SamtraderIndicatorSeries **batch;
+    switch (fused_types[t]) {
+      case SAMTRADER_IND_SMA:
+        batch = samtrader_calculate_sma_multi_columns(arena, bars, periods, lane_count);
+        break;
+      case SAMTRADER_IND_EMA:
+        batch = samtrader_calculate_ema_multi_columns(arena, bars, periods, lane_count);
+        break;
+      default:
+        batch = samtrader_calculate_stochastic_multi_columns(arena, bars, periods, param2s,
+                                                             lane_count);
+        break;
+    }
+    if (!batch)
+      return -1;
+    for (size_t l = 0; l < lane_count; l++)
+      series[lanes[l]] = batch[l];
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    if (series[i])
+      continue;
+    const SamtraderOperand *op = (const SamtraderOperand *)samrena_vector_at_const(operands, i);
+    series[i] = calculate_indicator_for_operand(arena, op, bars);
+    if (!series[i])
+      return -1;
+  }
   return 0;
 }
 
+/* --- K-way date merge --- */
+
+typedef struct {
+  time_t date; /* Date of the code's next unmerged bar */
+  size_t code; /* Index into the code_data array */
+} MergeCursor;
+
+static void heap_sift_down(MergeCursor *heap, size_t count, size_t i) {
+  for (;;) {
+    size_t smallest = i;
+    size_t left = 2 * i + 1;
+    size_t right = left + 1;
+    if (left < count && heap[left].date < heap[smallest].date)
+      smallest = left;
+    if (right < count && heap[right].date < heap[smallest].date)
+      smallest = right;
+    if (smallest == i)
+      return;
+    MergeCursor tmp = heap[i];
+    heap[i] = heap[smallest];
+    heap[smallest] = tmp;
+    i = smallest;
+  }
+}
+
+static time_t bar_date(const SamtraderCodeData *cd, size_t i) {
+  return cd->bars->date[i];
+}
+
+/*
+ * Merge the per-code date sequences (each sorted ascending) into a single
+ * deduplicated timeline using a min-heap of per-code cursors: O(N log K)
+ * for N bars across K codes, with no hashing.
+ *
+ * If positions is non-NULL, positions[c] receives an arena array mapping
+ * each of code c's bars to its index in the timeline.
+ *
+ * Returns NULL if any code's bars are not in ascending date order.
+ */
+static SamrenaVector *merge_timeline(Samrena *arena, SamtraderCodeData **code_data,
+                                     size_t code_count, int32_t **positions) {
+  size_t total_bars = 0;
+  for (size_t c = 0; c < code_count; c++) {
+    if (code_data[c] && code_data[c]->bars)
+      total_bars += code_data[c]->bar_count;
+  }
+
+  SamrenaVector *dates =
+      samrena_vector_init(arena, sizeof(time_t), total_bars > 0 ? total_bars : 1);
+  MergeCursor *heap = SAMRENA_PUSH_ARRAY(arena, MergeCursor, code_count);
+  size_t *next = SAMRENA_PUSH_ARRAY_ZERO(arena, size_t, code_count);
+  if (!dates || !heap || !next)
+    return NULL;
+
+  size_t heap_count = 0;
+  for (size_t c = 0; c < code_count; c++) {
+    const SamtraderCodeData *cd = code_data[c];
+    if (positions)
+      positions[c] = NULL;
+    if (!cd || !cd->bars || cd->bar_count == 0)
+      continue;
+    if (cd->bar_count > INT32_MAX)
+      return NULL;
+    if (positions) {
+      positions[c] = SAMRENA_PUSH_ARRAY(arena, int32_t, cd->bar_count);
+      if (!positions[c])
+        return NULL;
+    }
+    heap[heap_count].date = bar_date(cd, 0);
+    heap[heap_count].code = c;
+    heap_count++;
+  }
+  for (size_t i = heap_count / 2; i-- > 0;)
+    heap_sift_down(heap, heap_count, i);
+
+  time_t *out = (time_t *)dates->data;
+  size_t date_count = 0;
+
+  while (heap_count > 0) {
+    MergeCursor *top = &heap[0];
+    const SamtraderCodeData *cd = code_data[top->code];
+
+    if (date_count == 0 || out[date_count - 1] != top->date) {
+      if (date_count > 0 && top->date < out[date_count - 1])
+        return NULL;
+      out[date_count++] = top->date;
+    }
+    if (positions)
+      positions[top->code][next[top->code]] = (int32_t)(date_count - 1);
+
+    size_t i = ++next[top->code];
+    if (i < cd->bar_count) {
+      top->date = bar_date(cd, i);
+    } else {
+      heap[0] = heap[--heap_count];
+    }
+    heap_sift_down(heap, heap_count, 0);
+  }
+
+  dates->size = date_count;
+  return dates;
+}
+
 /* --- Public API --- */
 
+/* Code data owning a columnar copy of fetched rows; the rows are not kept */
+static SamtraderCodeData *wrap_code_data(Samrena *arena, const char *code, const char *exchange,
+                                         const SamrenaVector *ohlcv) {
+  SamtraderCodeData *cd = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderCodeData);
+  size_t count = samrena_vector_size(ohlcv);
+  SamtraderBarColumns *bars = samtrader_bar_columns_create(arena, code, exchange, count);
+  if (!cd || !bars)
+    return NULL;
+
+  const SamtraderOhlcv *rows = (const SamtraderOhlcv *)ohlcv->data;
+  for (size_t i = 0; i < count; i++) {
+    bars->date[i] = rows[i].date;
+    bars->open[i] = rows[i].open;
+    bars->high[i] = rows[i].high;
+    bars->low[i] = rows[i].low;
+    bars->close[i] = rows[i].close;
+    bars->volume[i] = rows[i].volume;
+  }
+
+  cd->code = bars->code;
+  cd->exchange = bars->exchange;
+  cd->bar_count = count;
+  cd->indicators = NULL;
+  cd->bars = bars;
+  return cd;
+}
+
+/* Wrap bars borrowed from the port; they stay valid until it is closed */
+static SamtraderCodeData *borrow_code_data(Samrena *arena, SamtraderDataPort *data_port,
+                                           const char *code, const char *exchange,
+                                           time_t start_date, time_t end_date) {
+  SamtraderCodeData *cd = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderCodeData);
+  SamtraderBarColumns *bars = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderBarColumns);
+  if (!cd || !bars ||
+      data_port->fetch_bars(data_port, code, exchange, start_date, end_date, bars) < 0)
+    return NULL;
+
+  cd->code = bars->code ? bars->code : code;
+  cd->exchange = bars->exchange ? bars->exchange : exchange;
+  cd->bar_count = bars->count;
+  cd->indicators = NULL;
+  cd->bars = bars;
+  return cd;
+}
+
 SamtraderCodeData *samtrader_load_code_data(Samrena *arena, SamtraderDataPort *data_port,
                                             const char *code, const char *exchange,
                                             time_t start_date, time_t end_date) {
   if (!arena || !data_port || !code || !exchange)
     return NULL;
 
+  if (data_port->fetch_bars)
+    return borrow_code_data(arena, data_port, code, exchange, start_date, end_date);
+
   SamrenaVector *ohlcv = data_port->fetch_ohlcv(data_port, code, exchange, start_date, end_date);
   if (!ohlcv)
     return NULL;
 
-  SamtraderCodeData *cd = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderCodeData);
-  if (!cd)
+  return wrap_code_data(arena, code, exchange, ohlcv);
+}
+
+SamtraderCodeData **samtrader_load_code_data_batch(Samrena *arena, SamtraderDataPort *data_port,
+                                                   const char *const *codes, size_t code_count,
+                                                   const char *exchange, time_t start_date,
+                                                   time_t end_date) {
+  if (!arena || !data_port || !codes || code_count == 0 || !exchange)
     return NULL;
 
-  cd->code = arena_strdup(arena, code);
-  cd->exchange = arena_strdup(arena, exchange);
-  if (!cd->code || !cd->exchange)
+  SamtraderCodeData **out = SAMRENA_PUSH_ARRAY_ZERO(arena, SamtraderCodeData *, code_count);
+  if (!out)
     return NULL;
 
-  cd->ohlcv = ohlcv;
-  cd->bar_count = samrena_vector_size(ohlcv);
-  cd->indicators = NULL;
+  if (data_port->fetch_bars || !data_port->fetch_ohlcv_batch) {
+    for (size_t i = 0; i < code_count; i++) {
+      out[i] = samtrader_load_code_data(arena, data_port, codes[i], exchange, start_date,
+                                        end_date);
+      if (!out[i])
+        return NULL;
+    }
+    return out;
+  }
 
-  return cd;
+  SamrenaVector **ohlcv = data_port->fetch_ohlcv_batch(data_port, codes, code_count, exchange,
+                                                       start_date, end_date);
+  if (!ohlcv)
+    return NULL;
+
+  for (size_t i = 0; i < code_count; i++) {
+    if (!codes[i] || !ohlcv[i])
+      return NULL;
+    out[i] = wrap_code_data(arena, codes[i], exchange, ohlcv[i]);
+    if (!out[i])
+      return NULL;
+  }
+  return out;
+}
+
+int samtrader_load_universe_data(Samrena *arena, SamtraderDataPort *data_port,
+                                 SamtraderUniverse *universe, time_t start_date, time_t end_date,
+                                 SamtraderCodeData ***out) {
+  if (!arena || !data_port || !universe || !universe->codes || universe->count == 0 ||
+      !universe->exchange || !out)
+    return -1;
+
+  /* One fetch per code feeds both the bar-count check and the loaded data */
+  SamrenaVector **ohlcv = NULL;
+  if (data_port->fetch_bars) {
+    /* Borrowed bars are fetched in the loop below without a copy */
+  } else if (data_port->fetch_ohlcv_batch) {
+    ohlcv = data_port->fetch_ohlcv_batch(data_port, universe->codes, universe->count,
+                                         universe->exchange, start_date, end_date);
+    if (!ohlcv)
+      return -1;
+  } else {
+    /* A failed single fetch counts as no data, as in samtrader_universe_validate */
+    ohlcv = SAMRENA_PUSH_ARRAY_ZERO(arena, SamrenaVector *, universe->count);
+    if (!ohlcv)
+      return -1;
+    for (size_t i = 0; i < universe->count; i++)
+      ohlcv[i] = data_port->fetch_ohlcv(data_port, universe->codes[i], universe->exchange,
+                                        start_date, end_date);
+  }
+
+  SamtraderCodeData **loaded = SAMRENA_PUSH_ARRAY_ZERO(arena, SamtraderCodeData *, universe->count);
+  if (!loaded)
+    return -1;
+
+  size_t write_idx = 0;
+  for (size_t read_idx = 0; read_idx < universe->count; read_idx++) {
+    const char *code = universe->codes[read_idx];
+    SamtraderCodeData *borrowed = NULL;
+    size_t bars;
+    if (ohlcv) {
+      bars = ohlcv[read_idx] ? samrena_vector_size(ohlcv[read_idx]) : 0;
+    } else {
+      /* A symbol the port does not know counts as no data */
+      borrowed = borrow_code_data(arena, data_port, code, universe->exchange, start_date,
+                                  end_date);
+      bars = borrowed ? borrowed->bar_count : 0;
+    }
+    if (bars < SAMTRADER_MIN_OHLCV_BARS) {
+      fprintf(stderr, "Warning: skipping %s.%s (%zu bars, minimum %d required)\n", code,
+              universe->exchange, bars, SAMTRADER_MIN_OHLCV_BARS);
+      continue;
+    }
+    loaded[write_idx] =
+        borrowed ? borrowed : wrap_code_data(arena, code, universe->exchange, ohlcv[read_idx]);
+    if (!loaded[write_idx])
+      return -1;
+    universe->codes[write_idx++] = code;
+  }
+
+  universe->count = write_idx;
+  *out = loaded;
+  return (int)write_idx;
+}
+
+int samtrader_code_data_resample(Samrena *arena, SamtraderCodeData *code_data, int64_t period) {
+  if (!arena || !code_data || !code_data->bars || period <= 0)
+    return -1;
+
+  SamtraderBarColumns *bars = samtrader_bar_columns_resample(arena, code_data->bars, period);
+  if (!bars)
+    return -1;
+
+  code_data->bars = bars;
+  code_data->bar_count = bars->count;
+  return 0;
 }
 
 int samtrader_code_data_compute_indicators(Samrena *arena, SamtraderCodeData *code_data,
                                            const SamtraderStrategy *strategy) {
-  if (!arena || !code_data || !strategy)
+  return samtrader_code_data_compute_indicators_multi(arena, code_data, strategy, 1, NULL);
+}
+
+int samtrader_code_data_compute_indicators_multi(Samrena *arena, SamtraderCodeData *code_data,
+                                                 const SamtraderStrategy *strategies,
+                                                 size_t strategy_count,
+                                                 SamtraderIndicatorCachePort *cache) {
+  if (!arena || !code_data || !strategies || strategy_count == 0)
+    return -1;
+
+  if (!code_data->bars)
     return -1;
 
   SamHashMap *seen_keys = samhashmap_create(32, arena);
@@ -159,77 +462,180 @@ int samtrader_code_data_compute_indicators(Samrena *arena, SamtraderCodeData *co
   if (!seen_keys || !operands)
     return -1;
 
-  collect_indicator_operands(strategy->entry_long, seen_keys, operands);
-  collect_indicator_operands(strategy->exit_long, seen_keys, operands);
-  if (strategy->entry_short)
-    collect_indicator_operands(strategy->entry_short, seen_keys, operands);
-  if (strategy->exit_short)
-    collect_indicator_operands(strategy->exit_short, seen_keys, operands);
+  /* Operands shared between strategies are keyed once, so each series is computed once */
+  for (size_t s = 0; s < strategy_count; s++) {
+    const SamtraderStrategy *strategy = &strategies[s];
+    collect_indicator_operands(strategy->entry_long, seen_keys, operands);
+    collect_indicator_operands(strategy->exit_long, seen_keys, operands);
+    if (strategy->entry_short)
+      collect_indicator_operands(strategy->entry_short, seen_keys, operands);
+    if (strategy->exit_short)
+      collect_indicator_operands(strategy->exit_short, seen_keys, operands);
+  }
 
   SamHashMap *indicators = samhashmap_create(32, arena);
   if (!indicators)
     return -1;
 
-  for (size_t i = 0; i < samrena_vector_size(operands); i++) {
+  /* The bars are hashed once; every series of this code shares the hash */
+  SamtraderIndicatorCacheKey cache_key = {0};
+  if (cache && code_data->code && code_data->exchange && samrena_vector_size(operands) > 0) {
+    cache_key.code = code_data->code;
+    cache_key.exchange = code_data->exchange;
+    cache_key.data_hash = samtrader_bar_columns_hash(code_data->bars);
+    cache_key.bar_count = code_data->bars->count;
+    cache_key.dates = code_data->bars->date;
+  } else {
+    cache = NULL;
+  }
+
+  size_t operand_count = samrena_vector_size(operands);
+  SamtraderIndicatorSeries **series =
+      SAMRENA_PUSH_ARRAY_ZERO(arena, SamtraderIndicatorSeries *, operand_count + 1);
+  bool *cached = SAMRENA_PUSH_ARRAY_ZERO(arena, bool, operand_count + 1);
+  if (!series || !cached)
+    return -1;
+
+  /* Cached series first, so only the misses are grouped for computation */
+  char key_buf[INDICATOR_KEY_BUF_SIZE];
+  for (size_t i = 0; cache && i < operand_count; i++) {
+    const SamtraderOperand *op = (const SamtraderOperand *)samrena_vector_at_const(operands, i);
+    samtrader_operand_indicator_key(key_buf, sizeof(key_buf), op);
+    cache_key.indicator_key = key_buf;
+    series[i] = cache->lookup(cache, arena, &cache_key);
+    cached[i] = series[i] != NULL;
+  }
+
+  if (calculate_missing_indicators(arena, operands, series, code_data->bars) < 0)
+    return -1;
+
+  for (size_t i = 0; i < operand_count; i++) {
     const SamtraderOperand *op = (const SamtraderOperand *)samrena_vector_at_const(operands, i);
-    SamtraderIndicatorSeries *series = calculate_indicator_for_operand(arena, op, code_data->ohlcv);
-    if (!series)
-      return -1;
-    char key_buf[INDICATOR_KEY_BUF_SIZE];
     samtrader_operand_indicator_key(key_buf, sizeof(key_buf), op);
-    samhashmap_put(indicators, key_buf, series);
+    if (cache && !cached[i]) {
+      cache_key.indicator_key = key_buf;
+      cache->store(cache, &cache_key, series[i]);
+    }
+    samhashmap_put(indicators, key_buf, series[i]);
   }
 
   code_data->indicators = indicators;
   return 0;
 }
 
+typedef struct {
+  SamtraderCodeData **code_data;
+  const SamtraderStrategy *strategies;
+  size_t strategy_count;
+  SamtraderIndicatorCachePort *cache;
+} IndicatorTaskCtx;
+
+static int compute_indicators_task(void *ctx, size_t index, Samrena *arena) {
+  const IndicatorTaskCtx *task = (const IndicatorTaskCtx *)ctx;
+  return samtrader_code_data_compute_indicators_multi(
+      arena, task->code_data[index], task->strategies, task->strategy_count, task->cache);
+}
+
+int samtrader_code_data_compute_indicators_parallel(SamtraderWorkerPool *pool,
+                                                    SamtraderCodeData **code_data,
+                                                    size_t code_count,
+                                                    const SamtraderStrategy *strategies,
+                                                    size_t strategy_count,
+                                                    SamtraderIndicatorCachePort *cache) {
+  if (!pool || !code_data || !strategies || strategy_count == 0)
+    return -1;
+  for (size_t i = 0; i < code_count; i++) {
+    if (!code_data[i])
+      return -1;
+  }
+
+  IndicatorTaskCtx ctx = {.code_data = code_data,
+                          .strategies = strategies,
+                          .strategy_count = strategy_count,
+                          .cache = cache};
+  return samtrader_worker_pool_run(pool, code_count, compute_indicators_task, &ctx);
+}
+
 SamrenaVector *samtrader_build_date_timeline(Samrena *arena, SamtraderCodeData **code_data,
                                              size_t code_count) {
   if (!arena || !code_data || code_count == 0)
     return NULL;
 
-  SamHashMap *seen = samhashmap_create(256, arena);
-  SamrenaVector *dates = samrena_vector_init(arena, sizeof(time_t), 256);
-  if (!seen || !dates)
+  return merge_timeline(arena, code_data, code_count, NULL);
+}
+
+SamtraderTimeline *samtrader_timeline_build(Samrena *arena, SamtraderCodeData **code_data,
+                                            size_t code_count) {
+  if (!arena || !code_data || code_count == 0)
+    return NULL;
+
+  int32_t **positions = SAMRENA_PUSH_ARRAY(arena, int32_t *, code_count);
+  if (!positions)
+    return NULL;
+
+  SamrenaVector *dates = merge_timeline(arena, code_data, code_count, positions);
+  if (!dates)
     return NULL;
 
+  size_t date_count = samrena_vector_size(dates);
+  SamtraderTimeline *timeline = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderTimeline);
+  int32_t *bar_index = SAMRENA_PUSH_ARRAY(arena, int32_t, date_count * code_count);
+  if (!timeline || (date_count > 0 && !bar_index))
+    return NULL;
+
+  for (size_t i = 0; i < date_count * code_count; i++)
+    bar_index[i] = -1;
+
   for (size_t c = 0; c < code_count; c++) {
-    if (!code_data[c] || !code_data[c]->ohlcv)
+    if (!positions[c])
       continue;
-    for (size_t i = 0; i < code_data[c]->bar_count; i++) {
-      const SamtraderOhlcv *bar =
-          (const SamtraderOhlcv *)samrena_vector_at_const(code_data[c]->ohlcv, i);
-      char key[DATE_KEY_BUF_SIZE];
-      date_to_key(key, sizeof(key), bar->date);
-      if (!samhashmap_contains(seen, key)) {
-        samhashmap_put(seen, key, (void *)1);
-        samrena_vector_push(dates, &bar->date);
-      }
-    }
+    for (size_t i = 0; i < code_data[c]->bar_count; i++)
+      bar_index[(size_t)positions[c][i] * code_count + c] = (int32_t)i;
   }
 
-  size_t count = samrena_vector_size(dates);
-  if (count > 1) {
-    qsort(dates->data, count, sizeof(time_t), compare_time);
-  }
+  timeline->dates = dates;
+  timeline->date_count = date_count;
+  timeline->code_count = code_count;
+  timeline->bar_index = bar_index;
+  return timeline;
+}
 
-  return dates;
+SamtraderTimeline *samtrader_timeline_window(Samrena *arena, const SamtraderTimeline *timeline,
+                                             size_t begin, size_t end) {
+  if (!arena || !timeline || begin > end || end > timeline->date_count)
+    return NULL;
+
+  SamtraderTimeline *view = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderTimeline);
+  SamrenaVector *dates = SAMRENA_PUSH_TYPE_ZERO(arena, SamrenaVector);
+  if (!view || !dates)
+    return NULL;
+
+  /* A fixed-size vector header over the parent's storage; never pushed to */
+  const SamrenaVector *parent = timeline->dates;
+  dates->element_size = parent->element_size;
+  dates->size = end - begin;
+  dates->capacity = end - begin;
+  dates->data = (uint8_t *)parent->data + begin * parent->element_size;
+
+  view->dates = dates;
+  view->date_count = end - begin;
+  view->code_count = timeline->code_count;
+  view->bar_index = timeline->bar_index + begin * timeline->code_count;
+  return view;
 }
 
-SamHashMap *samtrader_build_date_index(Samrena *arena, SamrenaVector *ohlcv) {
-  if (!arena || !ohlcv)
+SamHashMap *samtrader_build_date_index(Samrena *arena, const SamtraderBarColumns *bars) {
+  if (!arena || !bars)
     return NULL;
 
-  size_t count = samrena_vector_size(ohlcv);
+  size_t count = bars->count;
   SamHashMap *index = samhashmap_create(count > 0 ? count * 2 : 4, arena);
   if (!index)
     return NULL;
 
   for (size_t i = 0; i < count; i++) {
-    const SamtraderOhlcv *bar = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i);
     char key[DATE_KEY_BUF_SIZE];
-    date_to_key(key, sizeof(key), bar->date);
+    date_to_key(key, sizeof(key), bars->date[i]);
 
     size_t *idx = SAMRENA_PUSH_TYPE(arena, size_t);
     if (!idx)
@@ -82,13 +82,15 @@ bool samtrader_execution_enter_long(SamtraderPortfolio *portfolio, Samrena *aren
     take_profit = exec_price * (1.0 + take_profit_pct / 100.0);
   }
 
-  SamtraderPosition *pos = samtrader_position_create(arena, code, exchange, qty, exec_price, date,
-                                                     stop_loss, take_profit);
-  if (!pos) {
-    return false;
-  }
-
-  if (!samtrader_portfolio_add_position(portfolio, arena, pos)) {
+  /* Copied into the portfolio's per-code storage; nothing is allocated per trade */
+  SamtraderPosition pos = {.code = code,
+                           .exchange = exchange,
+                           .quantity = qty,
+                           .entry_price = exec_price,
+                           .entry_date = date,
+                           .stop_loss = stop_loss,
+                           .take_profit = take_profit};
+  if (!samtrader_portfolio_add_position(portfolio, arena, &pos)) {
     return false;
   }
 
@@ -139,13 +141,15 @@ bool samtrader_execution_enter_short(SamtraderPortfolio *portfolio, Samrena *are
     take_profit = exec_price * (1.0 - take_profit_pct / 100.0);
   }
 
-  SamtraderPosition *pos = samtrader_position_create(arena, code, exchange, -qty, exec_price, date,
-                                                     stop_loss, take_profit);
-  if (!pos) {
-    return false;
-  }
-
-  if (!samtrader_portfolio_add_position(portfolio, arena, pos)) {
+  /* Copied into the portfolio's per-code storage; nothing is allocated per trade */
+  SamtraderPosition pos = {.code = code,
+                           .exchange = exchange,
+                           .quantity = -qty,
+                           .entry_price = exec_price,
+                           .entry_date = date,
+                           .stop_loss = stop_loss,
+                           .take_profit = take_profit};
+  if (!samtrader_portfolio_add_position(portfolio, arena, &pos)) {
     return false;
   }
 
@@ -198,36 +202,123 @@ bool samtrader_execution_exit_position(SamtraderPortfolio *portfolio, Samrena *a
                                 .exit_price = exec_price,
                                 .entry_date = pos->entry_date,
                                 .exit_date = date,
-                                .pnl = pnl};
+                                .pnl = pnl,
+                                .symbol = pos->symbol};
 
   if (!samtrader_portfolio_record_trade(portfolio, arena, &trade)) {
     return false;
   }
 
-  return samtrader_portfolio_remove_position(portfolio, code);
+  return samtrader_portfolio_close_position(portfolio, trade.symbol);
 }
 
-typedef struct {
-  const SamHashMap *price_map;
-  SamrenaVector *triggered_codes;
-} TriggerCheckCtx;
+bool samtrader_fill_policy_parse(const char *name, SamtraderFillPolicy *out) {
+  if (!name || !out) {
+    return false;
+  }
+  if (strcmp(name, "same_bar_close") == 0) {
+    *out = SAMTRADER_FILL_SAME_BAR_CLOSE;
+  } else if (strcmp(name, "next_bar_open") == 0) {
+    *out = SAMTRADER_FILL_NEXT_BAR_OPEN;
+  } else {
+    return false;
+  }
+  return true;
+}
 
-static void trigger_check_iterator(const char *key, void *value, void *user_data) {
-  (void)key;
-  TriggerCheckCtx *ctx = (TriggerCheckCtx *)user_data;
-  SamtraderPosition *pos = (SamtraderPosition *)value;
+bool samtrader_trigger_policy_parse(const char *name, SamtraderTriggerPolicy *out) {
+  if (!name || !out) {
+    return false;
+  }
+  if (strcmp(name, "close") == 0) {
+    *out = SAMTRADER_TRIGGER_CLOSE;
+  } else if (strcmp(name, "worst_case") == 0) {
+    *out = SAMTRADER_TRIGGER_WORST_CASE;
+  } else {
+    return false;
+  }
+  return true;
+}
 
-  double *price = (double *)samhashmap_get(ctx->price_map, pos->code);
-  if (!price) {
-    return;
+/* Fills out[i] with the price of the i-th open position, NAN if it has none */
+typedef void (*GatherPricesFn)(const void *prices, const SamtraderPortfolio *portfolio,
+                               double *out);
+
+static void gather_from_map(const void *prices, const SamtraderPortfolio *portfolio,
+                            double *out) {
+  size_t open_count = samrena_vector_size(portfolio->open_symbols);
+  const SamtraderSymbolId *open = (const SamtraderSymbolId *)portfolio->open_symbols->data;
+  for (size_t i = 0; i < open_count; i++) {
+    const SamtraderPosition *pos = samtrader_portfolio_position_at(portfolio, open[i]);
+    const double *price = (const double *)samhashmap_get((const SamHashMap *)prices, pos->code);
+    out[i] = price ? *price : NAN;
   }
+}
 
-  if (samtrader_position_should_stop_loss(pos, *price) ||
-      samtrader_position_should_take_profit(pos, *price)) {
-    samrena_vector_push(ctx->triggered_codes, &pos->code);
+static void gather_column(const SamtraderPriceTable *table, const double *column,
+                          const SamtraderPortfolio *portfolio, double *out) {
+  size_t open_count = samrena_vector_size(portfolio->open_symbols);
+  const SamtraderSymbolId *open = (const SamtraderSymbolId *)portfolio->open_symbols->data;
+  for (size_t i = 0; i < open_count; i++) {
+    out[i] = open[i] < table->count ? column[open[i]] : NAN;
   }
 }
 
+static void gather_from_table(const void *prices, const SamtraderPortfolio *portfolio,
+                              double *out) {
+  const SamtraderPriceTable *table = (const SamtraderPriceTable *)prices;
+  gather_column(table, table->prices, portfolio, out);
+}
+
+/* Exit each triggered symbol at its fill price, in the order given */
+static int exit_at(SamtraderPortfolio *portfolio, Samrena *arena,
+                   const SamtraderSymbolId *triggered, const double *fills, size_t triggered_count,
+                   time_t date, double commission_flat, double commission_pct,
+                   double slippage_pct) {
+  int exit_count = 0;
+  for (size_t i = 0; i < triggered_count; i++) {
+    const SamtraderPosition *pos = samtrader_portfolio_position_at(portfolio, triggered[i]);
+    if (!pos) {
+      continue;
+    }
+
+    if (samtrader_execution_exit_position(portfolio, arena, pos->code, fills[i], date,
+                                          commission_flat, commission_pct, slippage_pct)) {
+      exit_count++;
+    }
+  }
+
+  return exit_count;
+}
+
+/* Exit every open position whose trigger fires at its current price. The
+ * triggered ids and prices are collected on work first because exiting
+ * reorders open_symbols; exits happen in open_symbols order. */
+static int exit_triggered(SamtraderPortfolio *portfolio, Samrena *arena, Samrena *work,
+                          GatherPricesFn gather, const void *prices, time_t date,
+                          double commission_flat, double commission_pct, double slippage_pct) {
+  size_t open_count = samtrader_portfolio_position_count(portfolio);
+  double *open_prices = SAMRENA_PUSH_ARRAY(work, double, open_count);
+  size_t *hits = SAMRENA_PUSH_ARRAY(work, size_t, open_count);
+  SamtraderSymbolId *triggered = SAMRENA_PUSH_ARRAY(work, SamtraderSymbolId, open_count);
+  if (!open_prices || !hits || !triggered) {
+    return -1;
+  }
+
+  gather(prices, portfolio, open_prices);
+  size_t triggered_count = samtrader_portfolio_find_triggers(portfolio, open_prices, hits);
+
+  /* hits ascend, so compacting the prices in place never overwrites one still needed */
+  const SamtraderSymbolId *open = (const SamtraderSymbolId *)portfolio->open_symbols->data;
+  for (size_t i = 0; i < triggered_count; i++) {
+    triggered[i] = open[hits[i]];
+    open_prices[i] = open_prices[hits[i]];
+  }
+
+  return exit_at(portfolio, arena, triggered, open_prices, triggered_count, date, commission_flat,
+                 commission_pct, slippage_pct);
+}
+
 int samtrader_execution_check_triggers(SamtraderPortfolio *portfolio, Samrena *arena,
                                        const SamHashMap *price_map, time_t date,
                                        double commission_flat, double commission_pct,
@@ -236,32 +327,71 @@ int samtrader_execution_check_triggers(SamtraderPortfolio *portfolio, Samrena *a
     return -1;
   }
 
-  SamrenaVector *triggered = samrena_vector_init(arena, sizeof(const char *), 8);
-  if (!triggered) {
+  if (samtrader_portfolio_position_count(portfolio) == 0) {
+    return 0;
+  }
+
+  return exit_triggered(portfolio, arena, arena, gather_from_map, price_map, date,
+                        commission_flat, commission_pct, slippage_pct);
+}
+
+int samtrader_execution_check_triggers_at(SamtraderPortfolio *portfolio, Samrena *arena,
+                                          Samrena *scratch, const SamtraderPriceTable *prices,
+                                          time_t date, double commission_flat,
+                                          double commission_pct, double slippage_pct) {
+  if (!portfolio || !arena || !scratch || scratch == arena || !prices ||
+      prices->symbols != portfolio->symbols) {
     return -1;
   }
 
-  TriggerCheckCtx ctx = {.price_map = price_map, .triggered_codes = triggered};
-  samhashmap_foreach(portfolio->positions, trigger_check_iterator, &ctx);
+  if (samtrader_portfolio_position_count(portfolio) == 0) {
+    return 0;
+  }
 
-  int exit_count = 0;
-  size_t num_triggered = samrena_vector_size(triggered);
-  for (size_t i = 0; i < num_triggered; i++) {
-    const char **code_ptr = (const char **)samrena_vector_at(triggered, i);
-    if (!code_ptr) {
-      continue;
-    }
+  /* Exits only allocate on arena, so the working arrays can live on scratch */
+  SamrenaScratch frame = samrena_scratch_begin(scratch);
+  int exit_count = exit_triggered(portfolio, arena, scratch, gather_from_table, prices, date,
+                                  commission_flat, commission_pct, slippage_pct);
+  samrena_scratch_end(frame);
+  return exit_count;
+}
 
-    double *price = (double *)samhashmap_get(price_map, *code_ptr);
-    if (!price) {
-      continue;
-    }
+int samtrader_execution_check_triggers_ohlc(SamtraderPortfolio *portfolio, Samrena *arena,
+                                            Samrena *scratch, const SamtraderPriceTable *prices,
+                                            time_t date, double commission_flat,
+                                            double commission_pct, double slippage_pct) {
+  if (!portfolio || !arena || !scratch || scratch == arena || !prices || !prices->open ||
+      !prices->high || !prices->low || prices->symbols != portfolio->symbols) {
+    return -1;
+  }
 
-    if (samtrader_execution_exit_position(portfolio, arena, *code_ptr, *price, date,
-                                          commission_flat, commission_pct, slippage_pct)) {
-      exit_count++;
-    }
+  size_t open_count = samtrader_portfolio_position_count(portfolio);
+  if (open_count == 0) {
+    return 0;
   }
 
+  SamrenaScratch frame = samrena_scratch_begin(scratch);
+  double *open = SAMRENA_PUSH_ARRAY(scratch, double, open_count);
+  double *high = SAMRENA_PUSH_ARRAY(scratch, double, open_count);
+  double *low = SAMRENA_PUSH_ARRAY(scratch, double, open_count);
+  size_t *hits = SAMRENA_PUSH_ARRAY(scratch, size_t, open_count);
+  double *fills = SAMRENA_PUSH_ARRAY(scratch, double, open_count);
+  SamtraderSymbolId *triggered = SAMRENA_PUSH_ARRAY(scratch, SamtraderSymbolId, open_count);
+  int exit_count = -1;
+  if (open && high && low && hits && fills && triggered) {
+    gather_column(prices, prices->open, portfolio, open);
+    gather_column(prices, prices->high, portfolio, high);
+    gather_column(prices, prices->low, portfolio, low);
+    size_t triggered_count =
+        samtrader_portfolio_find_triggers_ohlc(portfolio, open, high, low, hits, fills);
+
+    const SamtraderSymbolId *ids = (const SamtraderSymbolId *)portfolio->open_symbols->data;
+    for (size_t i = 0; i < triggered_count; i++) {
+      triggered[i] = ids[hits[i]];
+    }
+    exit_count = exit_at(portfolio, arena, triggered, fills, triggered_count, date,
+                         commission_flat, commission_pct, slippage_pct);
+  }
+  samrena_scratch_end(frame);
   return exit_count;
 }
@@ -16,6 +16,8 @@
 
 #include "samtrader/domain/indicator.h"
 
+#include <string.h>
+
 const char *samtrader_indicator_type_name(SamtraderIndicatorType type) {
   switch (type) {
     case SAMTRADER_IND_SMA:
@@ -49,32 +51,91 @@ const char *samtrader_indicator_type_name(SamtraderIndicatorType type) {
   }
 }
 
+size_t samtrader_indicator_column_count(SamtraderIndicatorType type) {
+  switch (type) {
+    case SAMTRADER_IND_MACD:
+    case SAMTRADER_IND_BOLLINGER:
+      return 3;
+    case SAMTRADER_IND_STOCHASTIC:
+      return 2;
+    case SAMTRADER_IND_PIVOT:
+      return SAMTRADER_INDICATOR_MAX_COLUMNS;
+    default:
+      return 1;
+  }
+}
+
+/* Allocate a series and its output columns (none when capacity is 0) */
+static SamtraderIndicatorSeries *series_alloc(Samrena *arena, SamtraderIndicatorType type,
+                                              const SamtraderIndicatorParams *params,
+                                              uint64_t capacity) {
+  if (!arena) {
+    return NULL;
+  }
+
+  SamtraderIndicatorSeries *series = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderIndicatorSeries);
+  if (!series) {
+    return NULL;
+  }
+
+  series->type = type;
+  series->params = *params;
+  series->column_count = samtrader_indicator_column_count(type);
+  series->arena = arena;
+  if (capacity > 0) {
+    for (size_t c = 0; c < series->column_count; c++) {
+      series->columns[c] = SAMRENA_PUSH_ARRAY_ZERO(arena, double, capacity);
+      if (!series->columns[c]) {
+        return NULL;
+      }
+    }
+    series->capacity = capacity;
+  }
+
+  return series;
+}
+
 /* Internal helper to create a series with full parameters */
 static SamtraderIndicatorSeries *indicator_series_create_internal(Samrena *arena,
                                                                   SamtraderIndicatorType type,
                                                                   int period, int param2,
                                                                   int param3, double param_double,
                                                                   uint64_t initial_capacity) {
-  if (!arena) {
+  SamtraderIndicatorParams params = {
+      .period = period, .param2 = param2, .param3 = param3, .param_double = param_double};
+  SamtraderIndicatorSeries *series = series_alloc(arena, type, &params, initial_capacity);
+  if (!series) {
     return NULL;
   }
 
-  SamtraderIndicatorSeries *series = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderIndicatorSeries);
-  if (!series) {
-    return NULL;
+  /* Values added one at a time carry their own dates */
+  if (initial_capacity > 0) {
+    time_t *dates = SAMRENA_PUSH_ARRAY_ZERO(arena, time_t, initial_capacity);
+    if (!dates) {
+      return NULL;
+    }
+    series->dates = dates;
   }
 
-  series->values = samrena_vector_init(arena, sizeof(SamtraderIndicatorValue), initial_capacity);
-  if (!series->values) {
+  return series;
+}
+
+SamtraderIndicatorSeries *
+samtrader_indicator_series_for_bars(Samrena *arena, SamtraderIndicatorType type,
+                                    const SamtraderIndicatorParams *params,
+                                    const SamtraderBarColumns *bars) {
+  if (!arena || !params || !bars || bars->count == 0) {
     return NULL;
   }
 
-  series->type = type;
-  series->params.period = period;
-  series->params.param2 = param2;
-  series->params.param3 = param3;
-  series->params.param_double = param_double;
+  SamtraderIndicatorSeries *series = series_alloc(arena, type, params, bars->count);
+  if (!series) {
+    return NULL;
+  }
 
+  series->dates = bars->date;
+  series->size = bars->count;
+  series->valid_from = bars->count;
   return series;
 }
 
@@ -110,231 +171,214 @@ SamtraderIndicatorSeries *samtrader_pivot_series_create(Samrena *arena, uint64_t
                                           initial_capacity);
 }
 
-SamtraderIndicatorValue *samtrader_indicator_add_simple(SamtraderIndicatorSeries *series,
-                                                        time_t date, double value, bool valid) {
-  if (!series || !series->values) {
-    return NULL;
+/*
+ * Grow the columns and dates to hold at least `needed` values. The dates
+ * are always copied, so a series that shared its bars' dates owns them
+ * once it grows.
+ */
+static bool series_reserve(SamtraderIndicatorSeries *series, size_t needed) {
+  if (needed <= series->capacity) {
+    return true;
+  }
+  if (!series->arena) {
+    return false;
   }
 
-  SamtraderIndicatorValue val = {
-      .date = date,
-      .valid = valid,
-      .type = series->type,
-      .data.simple.value = value,
-  };
+  size_t capacity = series->capacity > 0 ? series->capacity : 16;
+  while (capacity < needed) {
+    capacity *= 2;
+  }
 
-  return (SamtraderIndicatorValue *)samrena_vector_push(series->values, &val);
+  time_t *dates = SAMRENA_PUSH_ARRAY(series->arena, time_t, capacity);
+  if (!dates) {
+    return false;
+  }
+  if (series->size > 0) {
+    memcpy(dates, series->dates, series->size * sizeof(time_t));
+  }
+  for (size_t c = 0; c < series->column_count; c++) {
+    double *column = SAMRENA_PUSH_ARRAY(series->arena, double, capacity);
+    if (!column) {
+      return false;
+    }
+    if (series->size > 0) {
+      memcpy(column, series->columns[c], series->size * sizeof(double));
+    }
+    series->columns[c] = column;
+  }
+  series->dates = dates;
+  series->capacity = capacity;
+  return true;
 }
 
-SamtraderIndicatorValue *samtrader_indicator_add_macd(SamtraderIndicatorSeries *series, time_t date,
-                                                      double line, double signal, double histogram,
-                                                      bool valid) {
-  if (!series || !series->values || series->type != SAMTRADER_IND_MACD) {
-    return NULL;
-  }
+/* Append one value; fields holds the series' column_count outputs */
+static int series_append(SamtraderIndicatorSeries *series, time_t date, const double *fields,
+                         bool valid) {
+  size_t index = series->size;
 
-  SamtraderIndicatorValue val = {
-      .date = date,
-      .valid = valid,
-      .type = SAMTRADER_IND_MACD,
-      .data.macd.line = line,
-      .data.macd.signal = signal,
-      .data.macd.histogram = histogram,
-  };
+  /* Warmup values must all precede the valid ones */
+  if (!valid && series->valid_from < index) {
+    return -1;
+  }
+  if (!series_reserve(series, index + 1)) {
+    return -1;
+  }
 
-  return (SamtraderIndicatorValue *)samrena_vector_push(series->values, &val);
+  /* Past the old size the dates are always the series' own */
+  ((time_t *)series->dates)[index] = date;
+  for (size_t c = 0; c < series->column_count; c++) {
+    series->columns[c][index] = fields[c];
+  }
+  if (!valid) {
+    series->valid_from = index + 1;
+  }
+  series->size = index + 1;
+  return 0;
 }
 
-SamtraderIndicatorValue *samtrader_indicator_add_stochastic(SamtraderIndicatorSeries *series,
-                                                            time_t date, double k, double d,
-                                                            bool valid) {
-  if (!series || !series->values || series->type != SAMTRADER_IND_STOCHASTIC) {
-    return NULL;
+int samtrader_indicator_add_simple(SamtraderIndicatorSeries *series, time_t date, double value,
+                                   bool valid) {
+  if (!series) {
+    return -1;
   }
 
-  SamtraderIndicatorValue val = {
-      .date = date,
-      .valid = valid,
-      .type = SAMTRADER_IND_STOCHASTIC,
-      .data.stochastic.k = k,
-      .data.stochastic.d = d,
-  };
-
-  return (SamtraderIndicatorValue *)samrena_vector_push(series->values, &val);
+  double fields[SAMTRADER_INDICATOR_MAX_COLUMNS] = {value};
+  return series_append(series, date, fields, valid);
 }
 
-SamtraderIndicatorValue *samtrader_indicator_add_bollinger(SamtraderIndicatorSeries *series,
-                                                           time_t date, double upper, double middle,
-                                                           double lower, bool valid) {
-  if (!series || !series->values || series->type != SAMTRADER_IND_BOLLINGER) {
-    return NULL;
+int samtrader_indicator_add_macd(SamtraderIndicatorSeries *series, time_t date, double line,
+                                 double signal, double histogram, bool valid) {
+  if (!series || series->type != SAMTRADER_IND_MACD) {
+    return -1;
   }
 
-  SamtraderIndicatorValue val = {
-      .date = date,
-      .valid = valid,
-      .type = SAMTRADER_IND_BOLLINGER,
-      .data.bollinger.upper = upper,
-      .data.bollinger.middle = middle,
-      .data.bollinger.lower = lower,
-  };
-
-  return (SamtraderIndicatorValue *)samrena_vector_push(series->values, &val);
+  double fields[] = {line, signal, histogram};
+  return series_append(series, date, fields, valid);
 }
 
-SamtraderIndicatorValue *samtrader_indicator_add_pivot(SamtraderIndicatorSeries *series,
-                                                       time_t date, double pivot, double r1,
-                                                       double r2, double r3, double s1, double s2,
-                                                       double s3, bool valid) {
-  if (!series || !series->values || series->type != SAMTRADER_IND_PIVOT) {
-    return NULL;
+int samtrader_indicator_add_stochastic(SamtraderIndicatorSeries *series, time_t date, double k,
+                                       double d, bool valid) {
+  if (!series || series->type != SAMTRADER_IND_STOCHASTIC) {
+    return -1;
   }
 
-  SamtraderIndicatorValue val = {
-      .date = date,
-      .valid = valid,
-      .type = SAMTRADER_IND_PIVOT,
-      .data.pivot.pivot = pivot,
-      .data.pivot.r1 = r1,
-      .data.pivot.r2 = r2,
-      .data.pivot.r3 = r3,
-      .data.pivot.s1 = s1,
-      .data.pivot.s2 = s2,
-      .data.pivot.s3 = s3,
-  };
-
-  return (SamtraderIndicatorValue *)samrena_vector_push(series->values, &val);
+  double fields[] = {k, d};
+  return series_append(series, date, fields, valid);
 }
 
-const SamtraderIndicatorValue *samtrader_indicator_series_at(const SamtraderIndicatorSeries *series,
-                                                             size_t index) {
-  if (!series || !series->values) {
-    return NULL;
+int samtrader_indicator_add_bollinger(SamtraderIndicatorSeries *series, time_t date, double upper,
+                                      double middle, double lower, bool valid) {
+  if (!series || series->type != SAMTRADER_IND_BOLLINGER) {
+    return -1;
   }
 
-  return (const SamtraderIndicatorValue *)samrena_vector_at_const(series->values, index);
+  double fields[] = {upper, middle, lower};
+  return series_append(series, date, fields, valid);
 }
 
-size_t samtrader_indicator_series_size(const SamtraderIndicatorSeries *series) {
-  if (!series || !series->values) {
-    return 0;
+int samtrader_indicator_add_pivot(SamtraderIndicatorSeries *series, time_t date, double pivot,
+                                  double r1, double r2, double r3, double s1, double s2, double s3,
+                                  bool valid) {
+  if (!series || series->type != SAMTRADER_IND_PIVOT) {
+    return -1;
   }
 
-  return samrena_vector_size(series->values);
+  double fields[] = {pivot, r1, r2, r3, s1, s2, s3};
+  return series_append(series, date, fields, valid);
 }
 
-bool samtrader_indicator_latest_simple(const SamtraderIndicatorSeries *series, double *out_value) {
-  if (!series || !series->values || !out_value) {
+bool samtrader_indicator_series_at(const SamtraderIndicatorSeries *series, size_t index,
+                                   SamtraderIndicatorValue *out) {
+  if (!series || !out || index >= series->size) {
     return false;
   }
 
-  size_t size = samrena_vector_size(series->values);
-  if (size == 0) {
-    return false;
-  }
+  SamtraderIndicatorValue value = {
+      .date = series->dates ? series->dates[index] : 0,
+      .valid = index >= series->valid_from,
+      .type = series->type,
+  };
 
-  for (size_t i = size; i > 0; i--) {
-    const SamtraderIndicatorValue *val =
-        (const SamtraderIndicatorValue *)samrena_vector_at_const(series->values, i - 1);
-    if (val && val->valid) {
-      *out_value = val->data.simple.value;
-      return true;
-    }
+  /* Every value struct is its columns' doubles in column order */
+  double fields[SAMTRADER_INDICATOR_MAX_COLUMNS];
+  for (size_t c = 0; c < series->column_count; c++) {
+    fields[c] = series->columns[c][index];
   }
+  memcpy(&value.data, fields, series->column_count * sizeof(double));
 
-  return false;
+  *out = value;
+  return true;
 }
 
-bool samtrader_indicator_latest_macd(const SamtraderIndicatorSeries *series,
-                                     SamtraderMacdValue *out_value) {
-  if (!series || !series->values || !out_value || series->type != SAMTRADER_IND_MACD) {
+size_t samtrader_indicator_series_size(const SamtraderIndicatorSeries *series) {
+  return series ? series->size : 0;
+}
+
+/* Read the last value if it is valid (validity never ends once it starts) */
+static bool latest_value(const SamtraderIndicatorSeries *series, SamtraderIndicatorValue *out) {
+  if (!series || series->size == 0 || series->valid_from >= series->size) {
     return false;
   }
 
-  size_t size = samrena_vector_size(series->values);
-  if (size == 0) {
+  return samtrader_indicator_series_at(series, series->size - 1, out);
+}
+
+bool samtrader_indicator_latest_simple(const SamtraderIndicatorSeries *series, double *out_value) {
+  SamtraderIndicatorValue value;
+  if (!out_value || !latest_value(series, &value)) {
     return false;
   }
 
-  for (size_t i = size; i > 0; i--) {
-    const SamtraderIndicatorValue *val =
-        (const SamtraderIndicatorValue *)samrena_vector_at_const(series->values, i - 1);
-    if (val && val->valid) {
-      *out_value = val->data.macd;
-      return true;
-    }
+  *out_value = value.data.simple.value;
+  return true;
+}
+
+bool samtrader_indicator_latest_macd(const SamtraderIndicatorSeries *series,
+                                     SamtraderMacdValue *out_value) {
+  SamtraderIndicatorValue value;
+  if (!out_value || !series || series->type != SAMTRADER_IND_MACD ||
+      !latest_value(series, &value)) {
+    return false;
   }
 
-  return false;
+  *out_value = value.data.macd;
+  return true;
 }
 
 bool samtrader_indicator_latest_stochastic(const SamtraderIndicatorSeries *series,
                                            SamtraderStochasticValue *out_value) {
-  if (!series || !series->values || !out_value || series->type != SAMTRADER_IND_STOCHASTIC) {
-    return false;
-  }
-
-  size_t size = samrena_vector_size(series->values);
-  if (size == 0) {
+  SamtraderIndicatorValue value;
+  if (!out_value || !series || series->type != SAMTRADER_IND_STOCHASTIC ||
+      !latest_value(series, &value)) {
     return false;
   }
 
-  for (size_t i = size; i > 0; i--) {
-    const SamtraderIndicatorValue *val =
-        (const SamtraderIndicatorValue *)samrena_vector_at_const(series->values, i - 1);
-    if (val && val->valid) {
-      *out_value = val->data.stochastic;
-      return true;
-    }
-  }
-
-  return false;
+  *out_value = value.data.stochastic;
+  return true;
 }
 
 bool samtrader_indicator_latest_bollinger(const SamtraderIndicatorSeries *series,
                                           SamtraderBollingerValue *out_value) {
-  if (!series || !series->values || !out_value || series->type != SAMTRADER_IND_BOLLINGER) {
-    return false;
-  }
-
-  size_t size = samrena_vector_size(series->values);
-  if (size == 0) {
+  SamtraderIndicatorValue value;
+  if (!out_value || !series || series->type != SAMTRADER_IND_BOLLINGER ||
+      !latest_value(series, &value)) {
     return false;
   }
 
-  for (size_t i = size; i > 0; i--) {
-    const SamtraderIndicatorValue *val =
-        (const SamtraderIndicatorValue *)samrena_vector_at_const(series->values, i - 1);
-    if (val && val->valid) {
-      *out_value = val->data.bollinger;
-      return true;
-    }
-  }
-
-  return false;
+  *out_value = value.data.bollinger;
+  return true;
 }
 
 bool samtrader_indicator_latest_pivot(const SamtraderIndicatorSeries *series,
                                       SamtraderPivotValue *out_value) {
-  if (!series || !series->values || !out_value || series->type != SAMTRADER_IND_PIVOT) {
-    return false;
-  }
-
-  size_t size = samrena_vector_size(series->values);
-  if (size == 0) {
+  SamtraderIndicatorValue value;
+  if (!out_value || !series || series->type != SAMTRADER_IND_PIVOT ||
+      !latest_value(series, &value)) {
     return false;
   }
 
-  for (size_t i = size; i > 0; i--) {
-    const SamtraderIndicatorValue *val =
-        (const SamtraderIndicatorValue *)samrena_vector_at_const(series->values, i - 1);
-    if (val && val->valid) {
-      *out_value = val->data.pivot;
-      return true;
-    }
-  }
-
-  return false;
+  *out_value = value.data.pivot;
+  return true;
 }
 
 /*============================================================================
@@ -371,3 +415,36 @@ SamtraderIndicatorSeries *samtrader_indicator_calculate(Samrena *arena, Samtrade
       return NULL;
   }
 }
+
+SamtraderIndicatorSeries *samtrader_indicator_calculate_columns(Samrena *arena,
+                                                                SamtraderIndicatorType type,
+                                                                const SamtraderBarColumns *bars,
+                                                                int period) {
+  if (!arena || !bars) {
+    return NULL;
+  }
+
+  switch (type) {
+    case SAMTRADER_IND_SMA:
+      return samtrader_calculate_sma_columns(arena, bars, period);
+    case SAMTRADER_IND_EMA:
+      return samtrader_calculate_ema_columns(arena, bars, period);
+    case SAMTRADER_IND_WMA:
+      return samtrader_calculate_wma_columns(arena, bars, period);
+    case SAMTRADER_IND_RSI:
+      return samtrader_calculate_rsi_columns(arena, bars, period);
+    case SAMTRADER_IND_MACD:
+      return samtrader_calculate_macd_columns(arena, bars, 12, 26, 9);
+    case SAMTRADER_IND_STOCHASTIC:
+      return samtrader_calculate_stochastic_columns(arena, bars, period, 3);
+    case SAMTRADER_IND_BOLLINGER:
+      return samtrader_calculate_bollinger_columns(arena, bars, period, 2.0);
+    case SAMTRADER_IND_ATR:
+      return samtrader_calculate_atr_columns(arena, bars, period);
+    case SAMTRADER_IND_PIVOT:
+      return samtrader_calculate_pivot_columns(arena, bars);
+    default:
+      /* Unsupported indicator type */
+      return NULL;
+  }
+}
@@ -15,65 +15,43 @@
  */
 
 #include "samtrader/domain/indicator.h"
+#include "samtrader/domain/indicator_state.h"
 #include "samtrader/domain/ohlcv.h"
 
-SamtraderIndicatorSeries *samtrader_calculate_atr(Samrena *arena, SamrenaVector *ohlcv,
-                                                  int period) {
-  if (!arena || !ohlcv || period < 1) {
+SamtraderIndicatorSeries *samtrader_calculate_atr_columns(Samrena *arena,
+                                                          const SamtraderBarColumns *bars,
+                                                          int period) {
+  if (!arena || !bars || period < 1) {
     return NULL;
   }
 
-  size_t data_size = samrena_vector_size(ohlcv);
+  size_t data_size = bars->count;
   if (data_size == 0) {
     return NULL;
   }
 
+  SamtraderIndicatorParams params = {.period = period};
   SamtraderIndicatorSeries *series =
-      samtrader_indicator_series_create(arena, SAMTRADER_IND_ATR, period, data_size);
+      samtrader_indicator_series_for_bars(arena, SAMTRADER_IND_ATR, &params, bars);
   if (!series) {
     return NULL;
   }
 
-  double tr_sum = 0.0;
-  double atr = 0.0;
-  double prev_close = 0.0;
-
-  for (size_t i = 0; i < data_size; i++) {
-    const SamtraderOhlcv *bar = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i);
-    if (!bar) {
-      return NULL;
-    }
+  SamtraderIndicatorState *state =
+      samtrader_indicator_state_create(arena, series->type, &series->params);
+  if (!state || samtrader_indicator_state_fill(series, state, bars) < 0) {
+    return NULL;
+  }
 
-    /* First bar: TR = high - low (no previous close available) */
-    double tr;
-    if (i == 0) {
-      tr = bar->high - bar->low;
-    } else {
-      tr = samtrader_ohlcv_true_range(bar, prev_close);
-    }
-    prev_close = bar->close;
+  return series;
+}
 
-    if (i < (size_t)(period - 1)) {
-      /* Warmup: accumulate true range values */
-      tr_sum += tr;
-      if (!samtrader_indicator_add_simple(series, bar->date, 0.0, false)) {
-        return NULL;
-      }
-    } else if (i == (size_t)(period - 1)) {
-      /* First valid ATR: simple average of first `period` true ranges */
-      tr_sum += tr;
-      atr = tr_sum / (double)period;
-      if (!samtrader_indicator_add_simple(series, bar->date, atr, true)) {
-        return NULL;
-      }
-    } else {
-      /* Subsequent values: Wilder's smoothing */
-      atr = ((atr * (double)(period - 1)) + tr) / (double)period;
-      if (!samtrader_indicator_add_simple(series, bar->date, atr, true)) {
-        return NULL;
-      }
-    }
+SamtraderIndicatorSeries *samtrader_calculate_atr(Samrena *arena, SamrenaVector *ohlcv,
+                                                  int period) {
+  if (!arena || !ohlcv || period < 1) {
+    return NULL;
   }
 
-  return series;
+  SamtraderIndicatorParams params = {.period = period};
+  return samtrader_indicator_series_from_ohlcv(arena, SAMTRADER_IND_ATR, &params, ohlcv);
 }
@@ -14,81 +14,45 @@
  * limitations under the License.
  */
 
-#include <math.h>
-
 #include "samtrader/domain/indicator.h"
+#include "samtrader/domain/indicator_state.h"
 #include "samtrader/domain/ohlcv.h"
 
-SamtraderIndicatorSeries *samtrader_calculate_bollinger(Samrena *arena, SamrenaVector *ohlcv,
-                                                        int period, double stddev_multiplier) {
-  if (!arena || !ohlcv || period < 1) {
+SamtraderIndicatorSeries *samtrader_calculate_bollinger_columns(Samrena *arena,
+                                                                const SamtraderBarColumns *bars,
+                                                                int period,
+                                                                double stddev_multiplier) {
+  if (!arena || !bars || period < 1) {
     return NULL;
   }
 
-  size_t data_size = samrena_vector_size(ohlcv);
+  size_t data_size = bars->count;
   if (data_size == 0) {
     return NULL;
   }
 
+  SamtraderIndicatorParams params = {.period = period, .param_double = stddev_multiplier};
   SamtraderIndicatorSeries *series =
-      samtrader_bollinger_series_create(arena, period, stddev_multiplier, data_size);
+      samtrader_indicator_series_for_bars(arena, SAMTRADER_IND_BOLLINGER, &params, bars);
   if (!series) {
     return NULL;
   }
 
-  /* Running sum for efficient SMA calculation */
-  double sum = 0.0;
-
-  for (size_t i = 0; i < data_size; i++) {
-    const SamtraderOhlcv *bar = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i);
-    if (!bar) {
-      return NULL;
-    }
-
-    sum += bar->close;
-
-    /* Remove oldest value when window is full */
-    if (i >= (size_t)period) {
-      const SamtraderOhlcv *old_bar =
-          (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i - (size_t)period);
-      if (!old_bar) {
-        return NULL;
-      }
-      sum -= old_bar->close;
-    }
-
-    bool valid = (i >= (size_t)(period - 1));
-
-    if (!valid) {
-      if (!samtrader_indicator_add_bollinger(series, bar->date, 0.0, 0.0, 0.0, false)) {
-        return NULL;
-      }
-      continue;
-    }
-
-    /* Middle band = SMA */
-    double middle = sum / (double)period;
-
-    /* Calculate standard deviation over the window */
-    double sq_sum = 0.0;
-    size_t window_start = i - (size_t)(period - 1);
-    for (size_t j = window_start; j <= i; j++) {
-      const SamtraderOhlcv *w_bar = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, j);
-      if (!w_bar) {
-        return NULL;
-      }
-      double diff = w_bar->close - middle;
-      sq_sum += diff * diff;
-    }
-    double stddev = sqrt(sq_sum / (double)period);
+  SamtraderIndicatorState *state =
+      samtrader_indicator_state_create(arena, series->type, &series->params);
+  if (!state || samtrader_indicator_state_fill(series, state, bars) < 0) {
+    return NULL;
+  }
 
-    double upper = middle + stddev_multiplier * stddev;
-    double lower = middle - stddev_multiplier * stddev;
+  return series;
+}
 
-    if (!samtrader_indicator_add_bollinger(series, bar->date, upper, middle, lower, true)) {
-      return NULL;
-    }
+SamtraderIndicatorSeries *samtrader_calculate_bollinger(Samrena *arena, SamrenaVector *ohlcv,
+                                                        int period, double stddev_multiplier) {
+  if (!arena || !ohlcv || period < 1) {
+    return NULL;
   }
 
-  return series;
+  SamtraderIndicatorParams params = {.period = period, .param_double = stddev_multiplier};
+  return samtrader_indicator_series_from_ohlcv(arena, SAMTRADER_IND_BOLLINGER, &params, ohlcv);
 }
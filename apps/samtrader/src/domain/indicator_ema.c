@@ -15,57 +15,43 @@
  */
 
 #include "samtrader/domain/indicator.h"
+#include "samtrader/domain/indicator_state.h"
 #include "samtrader/domain/ohlcv.h"
 
-SamtraderIndicatorSeries *samtrader_calculate_ema(Samrena *arena, SamrenaVector *ohlcv,
-                                                  int period) {
-  if (!arena || !ohlcv || period < 1) {
+SamtraderIndicatorSeries *samtrader_calculate_ema_columns(Samrena *arena,
+                                                          const SamtraderBarColumns *bars,
+                                                          int period) {
+  if (!arena || !bars || period < 1) {
     return NULL;
   }
 
-  size_t data_size = samrena_vector_size(ohlcv);
+  size_t data_size = bars->count;
   if (data_size == 0) {
     return NULL;
   }
 
+  SamtraderIndicatorParams params = {.period = period};
   SamtraderIndicatorSeries *series =
-      samtrader_indicator_series_create(arena, SAMTRADER_IND_EMA, period, data_size);
+      samtrader_indicator_series_for_bars(arena, SAMTRADER_IND_EMA, &params, bars);
   if (!series) {
     return NULL;
   }
 
-  /* EMA multiplier: k = 2 / (period + 1) */
-  double k = 2.0 / ((double)period + 1.0);
-
-  /* Running sum for initial SMA calculation */
-  double sum = 0.0;
-  double ema_value = 0.0;
-
-  for (size_t i = 0; i < data_size; i++) {
-    const SamtraderOhlcv *bar = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i);
-    if (!bar) {
-      return NULL;
-    }
-
-    bool valid = (i >= (size_t)(period - 1));
+  SamtraderIndicatorState *state =
+      samtrader_indicator_state_create(arena, series->type, &series->params);
+  if (!state || samtrader_indicator_state_fill(series, state, bars) < 0) {
+    return NULL;
+  }
 
-    if (i < (size_t)(period - 1)) {
-      /* Warmup period: accumulate sum for initial SMA */
-      sum += bar->close;
-      ema_value = 0.0;
-    } else if (i == (size_t)(period - 1)) {
-      /* First valid value: use SMA as initial EMA */
-      sum += bar->close;
-      ema_value = sum / (double)period;
-    } else {
-      /* Subsequent values: apply EMA formula */
-      ema_value = (bar->close * k) + (ema_value * (1.0 - k));
-    }
+  return series;
+}
 
-    if (!samtrader_indicator_add_simple(series, bar->date, ema_value, valid)) {
-      return NULL;
-    }
+SamtraderIndicatorSeries *samtrader_calculate_ema(Samrena *arena, SamrenaVector *ohlcv,
+                                                  int period) {
+  if (!arena || !ohlcv || period < 1) {
+    return NULL;
   }
 
-  return series;
+  SamtraderIndicatorParams params = {.period = period};
+  return samtrader_indicator_series_from_ohlcv(arena, SAMTRADER_IND_EMA, &params, ohlcv);
 }
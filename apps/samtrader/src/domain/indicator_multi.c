@@ -0,0 +1,373 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "samtrader/domain/indicator.h"
+#include "samtrader/domain/ohlcv.h"
+
+/*
+ * Fused multi-period kernels. The bar loop is outermost and the periods
+ * are the inner lanes, so each column is read once for every period. The
+ * per-period arithmetic is that of indicator_state.c operation for
+ * operation; only the data it reads from changes (the column itself rather
+ * than a per-state ring buffer), so results are bit-identical.
+ */
+
+/* Validate periods, returning the largest, or 0 if any is below 1 */
+static int max_period(const int *periods, size_t count) {
+  int max = 0;
+  for (size_t j = 0; j < count; j++) {
+    if (periods[j] < 1)
+      return 0;
+    if (periods[j] > max)
+      max = periods[j];
+  }
+  return max;
+}
+
+/* Create one series per lane over the bars; lanes share the bars' dates */
+static SamtraderIndicatorSeries **create_lanes(Samrena *arena, SamtraderIndicatorType type,
+                                               const int *periods, const int *param2s,
+                                               size_t count, const SamtraderBarColumns *bars) {
+  SamtraderIndicatorSeries **series = SAMRENA_PUSH_ARRAY(arena, SamtraderIndicatorSeries *, count);
+  if (!series)
+    return NULL;
+
+  for (size_t j = 0; j < count; j++) {
+    SamtraderIndicatorParams params = {.period = periods[j],
+                                       .param2 = param2s ? param2s[j] : 0};
+    series[j] = samtrader_indicator_series_for_bars(arena, type, &params, bars);
+    if (!series[j])
+      return NULL;
+  }
+  return series;
+}
+
+/*
+ * Gather the date and close columns of a row vector (plus high and low when
+ * `ranges` is set) for the vector wrappers; the kernels read nothing else,
+ * so open and volume are left NULL.
+ */
+static SamtraderBarColumns *gather_columns(Samrena *arena, const SamrenaVector *ohlcv,
+                                           bool ranges) {
+  size_t count = samrena_vector_size(ohlcv);
+  SamtraderBarColumns *bars = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderBarColumns);
+  if (!bars || count == 0)
+    return bars;
+
+  bars->date = SAMRENA_PUSH_ARRAY(arena, time_t, count);
+  bars->close = SAMRENA_PUSH_ARRAY(arena, double, count);
+  if (ranges) {
+    bars->high = SAMRENA_PUSH_ARRAY(arena, double, count);
+    bars->low = SAMRENA_PUSH_ARRAY(arena, double, count);
+  }
+  if (!bars->date || !bars->close || (ranges && (!bars->high || !bars->low)))
+    return NULL;
+
+  for (size_t i = 0; i < count; i++) {
+    const SamtraderOhlcv *bar = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i);
+    bars->date[i] = bar->date;
+    bars->close[i] = bar->close;
+    if (ranges) {
+      bars->high[i] = bar->high;
+      bars->low[i] = bar->low;
+    }
+  }
+  bars->count = count;
+  return bars;
+}
+
+/*============================================================================
+ * SMA
+ *============================================================================*/
+
+SamtraderIndicatorSeries **samtrader_calculate_sma_multi_columns(Samrena *arena,
+                                                                 const SamtraderBarColumns *bars,
+                                                                 const int *periods,
+                                                                 size_t count) {
+  if (!arena || !bars || !periods || count == 0 || max_period(periods, count) == 0) {
+    return NULL;
+  }
+
+  size_t data_size = bars->count;
+  if (data_size == 0) {
+    return NULL;
+  }
+
+  double **out = SAMRENA_PUSH_ARRAY(arena, double *, count);
+  double *sums = SAMRENA_PUSH_ARRAY_ZERO(arena, double, count);
+  if (!out || !sums) {
+    return NULL;
+  }
+  SamtraderIndicatorSeries **series =
+      create_lanes(arena, SAMTRADER_IND_SMA, periods, NULL, count, bars);
+  if (!series) {
+    return NULL;
+  }
+  for (size_t j = 0; j < count; j++) {
+    out[j] = series[j]->columns[SAMTRADER_COLUMN_VALUE];
+    series[j]->valid_from = (size_t)periods[j] - 1;
+  }
+
+  const double *close = bars->close;
+  for (size_t i = 0; i < data_size; i++) {
+    double x = close[i];
+    for (size_t j = 0; j < count; j++) {
+      size_t period = (size_t)periods[j];
+      /* Same add-then-evict order as the state's window sum */
+      sums[j] += x;
+      if (i >= period) {
+        sums[j] -= close[i - period];
+      }
+      out[j][i] = (i >= period - 1) ? (sums[j] / (double)period) : 0.0;
+    }
+  }
+
+  return series;
+}
+
+SamtraderIndicatorSeries **samtrader_calculate_sma_multi(Samrena *arena, SamrenaVector *ohlcv,
+                                                         const int *periods, size_t count) {
+  if (!arena || !ohlcv) {
+    return NULL;
+  }
+
+  return samtrader_calculate_sma_multi_columns(arena, gather_columns(arena, ohlcv, false), periods,
+                                               count);
+}
+
+/*============================================================================
+ * EMA
+ *============================================================================*/
+
+SamtraderIndicatorSeries **samtrader_calculate_ema_multi_columns(Samrena *arena,
+                                                                 const SamtraderBarColumns *bars,
+                                                                 const int *periods,
+                                                                 size_t count) {
+  if (!arena || !bars || !periods || count == 0 || max_period(periods, count) == 0) {
+    return NULL;
+  }
+
+  size_t data_size = bars->count;
+  if (data_size == 0) {
+    return NULL;
+  }
+
+  /* One EMA recurrence per lane: multiplier, seed sum and current value */
+  double **out = SAMRENA_PUSH_ARRAY(arena, double *, count);
+  double *k = SAMRENA_PUSH_ARRAY(arena, double, count);
+  double *sums = SAMRENA_PUSH_ARRAY_ZERO(arena, double, count);
+  double *values = SAMRENA_PUSH_ARRAY_ZERO(arena, double, count);
+  if (!out || !k || !sums || !values) {
+    return NULL;
+  }
+  SamtraderIndicatorSeries **series =
+      create_lanes(arena, SAMTRADER_IND_EMA, periods, NULL, count, bars);
+  if (!series) {
+    return NULL;
+  }
+  for (size_t j = 0; j < count; j++) {
+    out[j] = series[j]->columns[SAMTRADER_COLUMN_VALUE];
+    series[j]->valid_from = (size_t)periods[j] - 1;
+    k[j] = 2.0 / ((double)periods[j] + 1.0);
+  }
+
+  const double *close = bars->close;
+  for (size_t i = 0; i < data_size; i++) {
+    double x = close[i];
+    for (size_t j = 0; j < count; j++) {
+      size_t period = (size_t)periods[j];
+      /* Seeded with the SMA of the first `period` closes */
+      if (i < period - 1) {
+        sums[j] += x;
+      } else if (i == period - 1) {
+        sums[j] += x;
+        values[j] = sums[j] / (double)period;
+      } else {
+        values[j] = (x * k[j]) + (values[j] * (1.0 - k[j]));
+      }
+      out[j][i] = values[j];
+    }
+  }
+
+  return series;
+}
+
+SamtraderIndicatorSeries **samtrader_calculate_ema_multi(Samrena *arena, SamrenaVector *ohlcv,
+                                                         const int *periods, size_t count) {
+  if (!arena || !ohlcv) {
+    return NULL;
+  }
+
+  return samtrader_calculate_ema_multi_columns(arena, gather_columns(arena, ohlcv, false), periods,
+                                               count);
+}
+
+/*============================================================================
+ * Stochastic
+ *============================================================================*/
+
+/*
+ * Monotonic deque of bar numbers over the longest %K window. Its entries
+ * are the window's suffix extremes (each strictly beats every later bar),
+ * so the extreme of any shorter window ending at the same bar is its first
+ * entry inside that window.
+ */
+typedef struct {
+  size_t *items;
+  size_t capacity;
+  size_t head;
+  size_t size;
+} ExtremeDeque;
+
+static size_t extreme_at(const ExtremeDeque *dq, size_t pos) {
+  return dq->items[(dq->head + pos) % dq->capacity];
+}
+
+/* Add bar n to a sliding max over values, or min when `min` is set */
+static void extreme_slide(ExtremeDeque *dq, const double *values, size_t n, bool min) {
+  size_t cap = dq->capacity;
+  if (n >= cap) {
+    while (dq->size > 0 && extreme_at(dq, 0) <= n - cap) {
+      dq->head = (dq->head + 1) % cap;
+      dq->size--;
+    }
+  }
+  double value = values[n];
+  while (dq->size > 0) {
+    double back = values[extreme_at(dq, dq->size - 1)];
+    if (min ? back < value : back > value)
+      break;
+    dq->size--;
+  }
+  dq->items[(dq->head + dq->size) % cap] = n;
+  dq->size++;
+}
+
+/* Bar holding the extreme of the window starting at bar `first` */
+static size_t extreme_from(const ExtremeDeque *dq, size_t first) {
+  size_t lo = 0;
+  size_t hi = dq->size - 1; /* the newest bar is always inside the window */
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (extreme_at(dq, mid) < first)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return extreme_at(dq, lo);
+}
+
+SamtraderIndicatorSeries **
+samtrader_calculate_stochastic_multi_columns(Samrena *arena, const SamtraderBarColumns *bars,
+                                             const int *k_periods, const int *d_periods,
+                                             size_t count) {
+  if (!arena || !bars || !k_periods || !d_periods || count == 0) {
+    return NULL;
+  }
+  int window = max_period(k_periods, count);
+  if (window == 0 || max_period(d_periods, count) == 0) {
+    return NULL;
+  }
+
+  size_t data_size = bars->count;
+  if (data_size == 0) {
+    return NULL;
+  }
+
+  /* Per-lane %D state: ring of the last d_period %K values and their sum */
+  double **k_rings = SAMRENA_PUSH_ARRAY(arena, double *, count);
+  double *k_sums = SAMRENA_PUSH_ARRAY_ZERO(arena, double, count);
+  size_t *k_counts = SAMRENA_PUSH_ARRAY_ZERO(arena, size_t, count);
+  ExtremeDeque max_high = {.items = SAMRENA_PUSH_ARRAY(arena, size_t, (uint64_t)window),
+                           .capacity = (size_t)window};
+  ExtremeDeque min_low = {.items = SAMRENA_PUSH_ARRAY(arena, size_t, (uint64_t)window),
+                          .capacity = (size_t)window};
+  if (!k_rings || !k_sums || !k_counts || !max_high.items || !min_low.items) {
+    return NULL;
+  }
+  for (size_t j = 0; j < count; j++) {
+    k_rings[j] = SAMRENA_PUSH_ARRAY_ZERO(arena, double, (uint64_t)d_periods[j]);
+    if (!k_rings[j]) {
+      return NULL;
+    }
+  }
+  SamtraderIndicatorSeries **series =
+      create_lanes(arena, SAMTRADER_IND_STOCHASTIC, k_periods, d_periods, count, bars);
+  if (!series) {
+    return NULL;
+  }
+  for (size_t j = 0; j < count; j++) {
+    series[j]->valid_from = (size_t)k_periods[j] - 1 + (size_t)d_periods[j] - 1;
+  }
+
+  const double *high = bars->high;
+  const double *low = bars->low;
+  for (size_t i = 0; i < data_size; i++) {
+    extreme_slide(&max_high, high, i, false);
+    extreme_slide(&min_low, low, i, true);
+
+    for (size_t j = 0; j < count; j++) {
+      size_t k_period = (size_t)k_periods[j];
+      size_t d_period = (size_t)d_periods[j];
+      double *k_column = series[j]->columns[SAMTRADER_COLUMN_STOCHASTIC_K];
+      double *d_column = series[j]->columns[SAMTRADER_COLUMN_STOCHASTIC_D];
+      if (i < k_period - 1) {
+        continue; /* columns start zeroed */
+      }
+
+      size_t first = i + 1 - k_period;
+      double highest_high = high[extreme_from(&max_high, first)];
+      double lowest_low = low[extreme_from(&min_low, first)];
+
+      /* %K = 100 * (close - lowest_low) / (highest_high - lowest_low) */
+      double k_value;
+      double range = highest_high - lowest_low;
+      if (range == 0.0) {
+        k_value = 50.0;
+      } else {
+        k_value = 100.0 * (bars->close[i] - lowest_low) / range;
+      }
+
+      /* Update %D running SMA via circular buffer */
+      size_t k_count = k_counts[j];
+      size_t buf_idx = k_count % d_period;
+      if (k_count >= d_period) {
+        k_sums[j] -= k_rings[j][buf_idx];
+      }
+      k_rings[j][buf_idx] = k_value;
+      k_sums[j] += k_value;
+      k_counts[j] = ++k_count;
+
+      k_column[i] = k_value;
+      d_column[i] = (k_count >= d_period) ? (k_sums[j] / (double)d_period) : 0.0;
+    }
+  }
+
+  return series;
+}
+
+SamtraderIndicatorSeries **samtrader_calculate_stochastic_multi(Samrena *arena,
+                                                                SamrenaVector *ohlcv,
+                                                                const int *k_periods,
+                                                                const int *d_periods,
+                                                                size_t count) {
+  if (!arena || !ohlcv) {
+    return NULL;
+  }
+
+  return samtrader_calculate_stochastic_multi_columns(arena, gather_columns(arena, ohlcv, true),
+                                                      k_periods, d_periods, count);
+}
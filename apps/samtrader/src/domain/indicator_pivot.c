@@ -15,60 +15,41 @@
  */
 
 #include "samtrader/domain/indicator.h"
+#include "samtrader/domain/indicator_state.h"
 #include "samtrader/domain/ohlcv.h"
 
-SamtraderIndicatorSeries *samtrader_calculate_pivot(Samrena *arena, SamrenaVector *ohlcv) {
-  if (!arena || !ohlcv) {
+SamtraderIndicatorSeries *samtrader_calculate_pivot_columns(Samrena *arena,
+                                                            const SamtraderBarColumns *bars) {
+  if (!arena || !bars) {
     return NULL;
   }
 
-  size_t data_size = samrena_vector_size(ohlcv);
+  size_t data_size = bars->count;
   if (data_size == 0) {
     return NULL;
   }
 
-  SamtraderIndicatorSeries *series = samtrader_pivot_series_create(arena, data_size);
+  SamtraderIndicatorParams params = {0};
+  SamtraderIndicatorSeries *series =
+      samtrader_indicator_series_for_bars(arena, SAMTRADER_IND_PIVOT, &params, bars);
   if (!series) {
     return NULL;
   }
 
-  for (size_t i = 0; i < data_size; i++) {
-    const SamtraderOhlcv *bar = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i);
-    if (!bar) {
-      return NULL;
-    }
-
-    if (i == 0) {
-      /* First bar: no previous day's data available */
-      if (!samtrader_indicator_add_pivot(series, bar->date, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
-                                         false)) {
-        return NULL;
-      }
-      continue;
-    }
-
-    /* Calculate pivot points from previous bar's high, low, close */
-    const SamtraderOhlcv *prev = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i - 1);
-    if (!prev) {
-      return NULL;
-    }
-
-    double h = prev->high;
-    double l = prev->low;
-    double c = prev->close;
+  SamtraderIndicatorState *state =
+      samtrader_indicator_state_create(arena, series->type, &series->params);
+  if (!state || samtrader_indicator_state_fill(series, state, bars) < 0) {
+    return NULL;
+  }
 
-    double pivot = (h + l + c) / 3.0;
-    double r1 = (2.0 * pivot) - l;
-    double r2 = pivot + (h - l);
-    double r3 = h + 2.0 * (pivot - l);
-    double s1 = (2.0 * pivot) - h;
-    double s2 = pivot - (h - l);
-    double s3 = l - 2.0 * (h - pivot);
+  return series;
+}
 
-    if (!samtrader_indicator_add_pivot(series, bar->date, pivot, r1, r2, r3, s1, s2, s3, true)) {
-      return NULL;
-    }
+SamtraderIndicatorSeries *samtrader_calculate_pivot(Samrena *arena, SamrenaVector *ohlcv) {
+  if (!arena || !ohlcv) {
+    return NULL;
   }
 
-  return series;
+  SamtraderIndicatorParams params = {0};
+  return samtrader_indicator_series_from_ohlcv(arena, SAMTRADER_IND_PIVOT, &params, ohlcv);
 }
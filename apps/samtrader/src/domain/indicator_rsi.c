@@ -15,93 +15,43 @@
  */
 
 #include "samtrader/domain/indicator.h"
+#include "samtrader/domain/indicator_state.h"
 #include "samtrader/domain/ohlcv.h"
 
-SamtraderIndicatorSeries *samtrader_calculate_rsi(Samrena *arena, SamrenaVector *ohlcv,
-                                                  int period) {
-  if (!arena || !ohlcv || period < 1) {
+SamtraderIndicatorSeries *samtrader_calculate_rsi_columns(Samrena *arena,
+                                                          const SamtraderBarColumns *bars,
+                                                          int period) {
+  if (!arena || !bars || period < 1) {
     return NULL;
   }
 
-  size_t data_size = samrena_vector_size(ohlcv);
+  size_t data_size = bars->count;
   if (data_size == 0) {
     return NULL;
   }
 
+  SamtraderIndicatorParams params = {.period = period};
   SamtraderIndicatorSeries *series =
-      samtrader_indicator_series_create(arena, SAMTRADER_IND_RSI, period, data_size);
+      samtrader_indicator_series_for_bars(arena, SAMTRADER_IND_RSI, &params, bars);
   if (!series) {
     return NULL;
   }
 
-  /* We need at least (period + 1) bars to compute the first RSI value,
-   * since we need `period` price changes (starting from bar index 1). */
-
-  double avg_gain = 0.0;
-  double avg_loss = 0.0;
-  double prev_close = 0.0;
-
-  for (size_t i = 0; i < data_size; i++) {
-    const SamtraderOhlcv *bar = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i);
-    if (!bar) {
-      return NULL;
-    }
-
-    if (i == 0) {
-      /* First bar: no price change yet, always invalid */
-      prev_close = bar->close;
-      if (!samtrader_indicator_add_simple(series, bar->date, 0.0, false)) {
-        return NULL;
-      }
-      continue;
-    }
-
-    double change = bar->close - prev_close;
-    double gain = change > 0.0 ? change : 0.0;
-    double loss = change < 0.0 ? -change : 0.0;
-    prev_close = bar->close;
-
-    if (i < (size_t)period) {
-      /* Warmup: accumulate gains and losses for initial average */
-      avg_gain += gain;
-      avg_loss += loss;
-      if (!samtrader_indicator_add_simple(series, bar->date, 0.0, false)) {
-        return NULL;
-      }
-    } else if (i == (size_t)period) {
-      /* First valid RSI: use simple average of gains and losses */
-      avg_gain = (avg_gain + gain) / (double)period;
-      avg_loss = (avg_loss + loss) / (double)period;
-
-      double rsi;
-      if (avg_loss == 0.0) {
-        rsi = (avg_gain == 0.0) ? 50.0 : 100.0;
-      } else {
-        double rs = avg_gain / avg_loss;
-        rsi = 100.0 - (100.0 / (1.0 + rs));
-      }
-
-      if (!samtrader_indicator_add_simple(series, bar->date, rsi, true)) {
-        return NULL;
-      }
-    } else {
-      /* Subsequent values: Wilder's smoothing */
-      avg_gain = ((avg_gain * (double)(period - 1)) + gain) / (double)period;
-      avg_loss = ((avg_loss * (double)(period - 1)) + loss) / (double)period;
+  SamtraderIndicatorState *state =
+      samtrader_indicator_state_create(arena, series->type, &series->params);
+  if (!state || samtrader_indicator_state_fill(series, state, bars) < 0) {
+    return NULL;
+  }
 
-      double rsi;
-      if (avg_loss == 0.0) {
-        rsi = (avg_gain == 0.0) ? 50.0 : 100.0;
-      } else {
-        double rs = avg_gain / avg_loss;
-        rsi = 100.0 - (100.0 / (1.0 + rs));
-      }
+  return series;
+}
 
-      if (!samtrader_indicator_add_simple(series, bar->date, rsi, true)) {
-        return NULL;
-      }
-    }
+SamtraderIndicatorSeries *samtrader_calculate_rsi(Samrena *arena, SamrenaVector *ohlcv,
+                                                  int period) {
+  if (!arena || !ohlcv || period < 1) {
+    return NULL;
   }
 
-  return series;
+  SamtraderIndicatorParams params = {.period = period};
+  return samtrader_indicator_series_from_ohlcv(arena, SAMTRADER_IND_RSI, &params, ohlcv);
 }
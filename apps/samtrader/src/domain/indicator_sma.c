@@ -15,54 +15,43 @@
  */
 
 #include "samtrader/domain/indicator.h"
+#include "samtrader/domain/indicator_state.h"
 #include "samtrader/domain/ohlcv.h"
 
-SamtraderIndicatorSeries *samtrader_calculate_sma(Samrena *arena, SamrenaVector *ohlcv,
-                                                  int period) {
-  if (!arena || !ohlcv || period < 1) {
+SamtraderIndicatorSeries *samtrader_calculate_sma_columns(Samrena *arena,
+                                                          const SamtraderBarColumns *bars,
+                                                          int period) {
+  if (!arena || !bars || period < 1) {
     return NULL;
   }
 
-  size_t data_size = samrena_vector_size(ohlcv);
+  size_t data_size = bars->count;
   if (data_size == 0) {
     return NULL;
   }
 
+  SamtraderIndicatorParams params = {.period = period};
   SamtraderIndicatorSeries *series =
-      samtrader_indicator_series_create(arena, SAMTRADER_IND_SMA, period, data_size);
+      samtrader_indicator_series_for_bars(arena, SAMTRADER_IND_SMA, &params, bars);
   if (!series) {
     return NULL;
   }
 
-  /* Running sum for efficient calculation */
-  double sum = 0.0;
-
-  for (size_t i = 0; i < data_size; i++) {
-    const SamtraderOhlcv *bar = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i);
-    if (!bar) {
-      return NULL;
-    }
-
-    sum += bar->close;
-
-    /* Remove oldest value when window is full */
-    if (i >= (size_t)period) {
-      const SamtraderOhlcv *old_bar =
-          (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i - (size_t)period);
-      if (!old_bar) {
-        return NULL;
-      }
-      sum -= old_bar->close;
-    }
+  SamtraderIndicatorState *state =
+      samtrader_indicator_state_create(arena, series->type, &series->params);
+  if (!state || samtrader_indicator_state_fill(series, state, bars) < 0) {
+    return NULL;
+  }
 
-    /* Calculate SMA value */
-    bool valid = (i >= (size_t)(period - 1));
-    double sma_value = valid ? (sum / (double)period) : 0.0;
+  return series;
+}
 
-    if (!samtrader_indicator_add_simple(series, bar->date, sma_value, valid)) {
-      return NULL;
-    }
+SamtraderIndicatorSeries *samtrader_calculate_sma(Samrena *arena, SamrenaVector *ohlcv,
+                                                  int period) {
+  if (!arena || !ohlcv || period < 1) {
+    return NULL;
   }
 
-  return series;
+  SamtraderIndicatorParams params = {.period = period};
+  return samtrader_indicator_series_from_ohlcv(arena, SAMTRADER_IND_SMA, &params, ohlcv);
 }
@@ -0,0 +1,633 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "samtrader/domain/indicator_state.h"
+
+#include <math.h>
+#include <string.h>
+
+/*============================================================================
+ * Per-indicator state
+ *============================================================================*/
+
+/* EMA seeded with the SMA of its first `period` inputs */
+typedef struct {
+  double k;     /* multiplier 2 / (period + 1) */
+  double sum;   /* inputs seen during the seed window */
+  double value; /* current EMA (0 until seeded) */
+} EmaState;
+
+/* Monotonic deque of bar numbers whose values are kept in a ring of the same capacity */
+typedef struct {
+  size_t *items;
+  size_t capacity;
+  size_t head;
+  size_t size;
+} IndexDeque;
+
+struct SamtraderIndicatorState {
+  SamtraderIndicatorType type;
+  SamtraderIndicatorParams params;
+  size_t count; /* bars pushed so far */
+
+  /* Ring buffers, allocated once at creation and indexed by bar number % size */
+  double *window; /* last `period` closes (SMA, WMA, Bollinger) or highs (Stochastic) */
+  double *lows;   /* last `period` lows (Stochastic) */
+  double *k_ring; /* last `param2` %K values (Stochastic) */
+  IndexDeque max_high;
+  IndexDeque min_low;
+
+  /* Scalar state, cleared by samtrader_indicator_state_reset */
+  union {
+    struct {
+      double sum;          /* sum of the window */
+      double weighted_sum; /* WMA numerator: newest weighted period, oldest 1 */
+    } window;
+    EmaState ema;
+    struct {
+      double prev_close;
+      double avg_gain;
+      double avg_loss;
+    } rsi;
+    struct {
+      EmaState fast;
+      EmaState slow;
+      EmaState signal;
+      size_t line_count; /* MACD line values produced so far */
+    } macd;
+    struct {
+      double k_sum;
+      size_t k_count; /* %K values produced so far */
+    } stochastic;
+    struct {
+      double prev_close;
+      double tr_sum;
+      double atr;
+    } atr;
+    struct {
+      double high;
+      double low;
+      double close;
+    } pivot;
+  } u;
+};
+
+static void ema_init(EmaState *ema, int period) {
+  memset(ema, 0, sizeof(*ema));
+  ema->k = 2.0 / ((double)period + 1.0);
+}
+
+/* Advance an EMA by input x; n is the number of inputs before this one */
+static void ema_step(EmaState *ema, double x, size_t n, int period) {
+  if (n < (size_t)(period - 1)) {
+    ema->sum += x;
+  } else if (n == (size_t)(period - 1)) {
+    ema->sum += x;
+    ema->value = ema->sum / (double)period;
+  } else {
+    ema->value = (x * ema->k) + (ema->value * (1.0 - ema->k));
+  }
+}
+
+static void deque_clear(IndexDeque *dq) {
+  dq->head = 0;
+  dq->size = 0;
+}
+
+static size_t deque_front(const IndexDeque *dq) { return dq->items[dq->head]; }
+
+static size_t deque_back(const IndexDeque *dq) {
+  return dq->items[(dq->head + dq->size - 1) % dq->capacity];
+}
+
+static void deque_pop_front(IndexDeque *dq) {
+  dq->head = (dq->head + 1) % dq->capacity;
+  dq->size--;
+}
+
+static void deque_push_back(IndexDeque *dq, size_t bar) {
+  dq->items[(dq->head + dq->size) % dq->capacity] = bar;
+  dq->size++;
+}
+
+/* Add bar n (value at ring[n % capacity]) to a sliding max, or min when `min` is set */
+static void deque_slide(IndexDeque *dq, const double *ring, size_t n, bool min) {
+  size_t cap = dq->capacity;
+  if (n >= cap) {
+    while (dq->size > 0 && deque_front(dq) <= n - cap)
+      deque_pop_front(dq);
+  }
+  double value = ring[n % cap];
+  while (dq->size > 0) {
+    double back = ring[deque_back(dq) % cap];
+    if (min ? back < value : back > value)
+      break;
+    dq->size--;
+  }
+  deque_push_back(dq, n);
+}
+
+/*============================================================================
+ * Creation
+ *============================================================================*/
+
+static double *push_ring(Samrena *arena, int size) {
+  return SAMRENA_PUSH_ARRAY_ZERO(arena, double, (uint64_t)size);
+}
+
+static bool deque_init(Samrena *arena, IndexDeque *dq, int capacity) {
+  dq->items = SAMRENA_PUSH_ARRAY_ZERO(arena, size_t, (uint64_t)capacity);
+  dq->capacity = (size_t)capacity;
+  deque_clear(dq);
+  return dq->items != NULL;
+}
+
+SamtraderIndicatorState *samtrader_indicator_state_create(Samrena *arena,
+                                                          SamtraderIndicatorType type,
+                                                          const SamtraderIndicatorParams *params) {
+  if (!arena || !params) {
+    return NULL;
+  }
+
+  int period = params->period;
+  switch (type) {
+    case SAMTRADER_IND_SMA:
+    case SAMTRADER_IND_EMA:
+    case SAMTRADER_IND_WMA:
+    case SAMTRADER_IND_RSI:
+    case SAMTRADER_IND_BOLLINGER:
+    case SAMTRADER_IND_ATR:
+      if (period < 1)
+        return NULL;
+      break;
+    case SAMTRADER_IND_MACD:
+      if (period < 1 || params->param2 < 1 || params->param3 < 1)
+        return NULL;
+      break;
+    case SAMTRADER_IND_STOCHASTIC:
+      if (period < 1 || params->param2 < 1)
+        return NULL;
+      break;
+    case SAMTRADER_IND_PIVOT:
+      break;
+    default:
+      /* Unsupported indicator type */
+      return NULL;
+  }
+
+  SamtraderIndicatorState *state = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderIndicatorState);
+  if (!state) {
+    return NULL;
+  }
+  state->type = type;
+  state->params = *params;
+
+  switch (type) {
+    case SAMTRADER_IND_SMA:
+    case SAMTRADER_IND_WMA:
+    case SAMTRADER_IND_BOLLINGER:
+      state->window = push_ring(arena, period);
+      if (!state->window)
+        return NULL;
+      break;
+    case SAMTRADER_IND_STOCHASTIC:
+      state->window = push_ring(arena, period);
+      state->lows = push_ring(arena, period);
+      state->k_ring = push_ring(arena, params->param2);
+      if (!state->window || !state->lows || !state->k_ring ||
+          !deque_init(arena, &state->max_high, period) ||
+          !deque_init(arena, &state->min_low, period))
+        return NULL;
+      break;
+    default:
+      break;
+  }
+
+  samtrader_indicator_state_reset(state);
+  return state;
+}
+
+void samtrader_indicator_state_reset(SamtraderIndicatorState *state) {
+  if (!state) {
+    return;
+  }
+
+  state->count = 0;
+  memset(&state->u, 0, sizeof(state->u));
+  if (state->max_high.items)
+    deque_clear(&state->max_high);
+  if (state->min_low.items)
+    deque_clear(&state->min_low);
+
+  switch (state->type) {
+    case SAMTRADER_IND_EMA:
+      ema_init(&state->u.ema, state->params.period);
+      break;
+    case SAMTRADER_IND_MACD:
+      ema_init(&state->u.macd.fast, state->params.period);
+      ema_init(&state->u.macd.slow, state->params.param2);
+      ema_init(&state->u.macd.signal, state->params.param3);
+      break;
+    default:
+      break;
+  }
+}
+
+size_t samtrader_indicator_state_count(const SamtraderIndicatorState *state) {
+  return state ? state->count : 0;
+}
+
+/*============================================================================
+ * Per-bar updates
+ *
+ * Each step mirrors the arithmetic of the original batch loop operation for
+ * operation, so results do not depend on which path produced them. n is
+ * the number of bars pushed before the current one.
+ *============================================================================*/
+
+static double rsi_from_averages(double avg_gain, double avg_loss) {
+  if (avg_loss == 0.0) {
+    return (avg_gain == 0.0) ? 50.0 : 100.0;
+  }
+  double rs = avg_gain / avg_loss;
+  return 100.0 - (100.0 / (1.0 + rs));
+}
+
+/* Add close to the window sum, evicting the close that falls out of it */
+static void window_slide(SamtraderIndicatorState *state, double close, size_t n) {
+  size_t period = (size_t)state->params.period;
+  size_t slot = n % period;
+  state->u.window.sum += close;
+  if (n >= period) {
+    state->u.window.sum -= state->window[slot];
+  }
+  state->window[slot] = close;
+}
+
+static void push_sma(SamtraderIndicatorState *state, const SamtraderOhlcv *bar, size_t n,
+                     SamtraderIndicatorValue *out) {
+  int period = state->params.period;
+  window_slide(state, bar->close, n);
+  out->valid = (n >= (size_t)(period - 1));
+  out->data.simple.value = out->valid ? (state->u.window.sum / (double)period) : 0.0;
+}
+
+static void push_ema(SamtraderIndicatorState *state, const SamtraderOhlcv *bar, size_t n,
+                     SamtraderIndicatorValue *out) {
+  int period = state->params.period;
+  ema_step(&state->u.ema, bar->close, n, period);
+  out->valid = (n >= (size_t)(period - 1));
+  out->data.simple.value = state->u.ema.value;
+}
+
+/*
+ * Running numerator: once the window is full, every older close loses one
+ * weight and the oldest drops out, so numerator += period * close - sum of
+ * the previous window.
+ */
+static void push_wma(SamtraderIndicatorState *state, const SamtraderOhlcv *bar, size_t n,
+                     SamtraderIndicatorValue *out) {
+  size_t period = (size_t)state->params.period;
+  size_t slot = n % period;
+  double close = bar->close;
+  if (n < period) {
+    state->u.window.weighted_sum += close * (double)(n + 1);
+    state->u.window.sum += close;
+  } else {
+    state->u.window.weighted_sum += close * (double)period - state->u.window.sum;
+    state->u.window.sum += close - state->window[slot];
+  }
+  state->window[slot] = close;
+
+  /* Weight divisor: sum of weights 1 + 2 + ... + n = n*(n+1)/2 */
+  double weight_sum = (double)period * ((double)period + 1.0) / 2.0;
+  out->valid = (n >= period - 1);
+  out->data.simple.value = out->valid ? (state->u.window.weighted_sum / weight_sum) : 0.0;
+}
+
+static void push_rsi(SamtraderIndicatorState *state, const SamtraderOhlcv *bar, size_t n,
+                     SamtraderIndicatorValue *out) {
+  int period = state->params.period;
+  if (n == 0) {
+    /* First bar: no price change yet, always invalid */
+    state->u.rsi.prev_close = bar->close;
+    return;
+  }
+
+  double change = bar->close - state->u.rsi.prev_close;
+  double gain = change > 0.0 ? change : 0.0;
+  double loss = change < 0.0 ? -change : 0.0;
+  state->u.rsi.prev_close = bar->close;
+
+  if (n < (size_t)period) {
+    /* Warmup: accumulate gains and losses for initial average */
+    state->u.rsi.avg_gain += gain;
+    state->u.rsi.avg_loss += loss;
+    return;
+  }
+  if (n == (size_t)period) {
+    /* First valid RSI: use simple average of gains and losses */
+    state->u.rsi.avg_gain = (state->u.rsi.avg_gain + gain) / (double)period;
+    state->u.rsi.avg_loss = (state->u.rsi.avg_loss + loss) / (double)period;
+  } else {
+    /* Subsequent values: Wilder's smoothing */
+    state->u.rsi.avg_gain =
+        ((state->u.rsi.avg_gain * (double)(period - 1)) + gain) / (double)period;
+    state->u.rsi.avg_loss =
+        ((state->u.rsi.avg_loss * (double)(period - 1)) + loss) / (double)period;
+  }
+  out->valid = true;
+  out->data.simple.value = rsi_from_averages(state->u.rsi.avg_gain, state->u.rsi.avg_loss);
+}
+
+static void push_macd(SamtraderIndicatorState *state, const SamtraderOhlcv *bar, size_t n,
+                      SamtraderIndicatorValue *out) {
+  int fast_period = state->params.period;
+  int slow_period = state->params.param2;
+  int signal_period = state->params.param3;
+  ema_step(&state->u.macd.fast, bar->close, n, fast_period);
+  ema_step(&state->u.macd.slow, bar->close, n, slow_period);
+
+  /* MACD line requires both EMAs to be valid */
+  int max_period = fast_period > slow_period ? fast_period : slow_period;
+  if (n < (size_t)(max_period - 1)) {
+    return;
+  }
+
+  double macd_line = state->u.macd.fast.value - state->u.macd.slow.value;
+  size_t line_index = state->u.macd.line_count++;
+  ema_step(&state->u.macd.signal, macd_line, line_index, signal_period);
+
+  out->data.macd.line = macd_line;
+  if (line_index < (size_t)(signal_period - 1)) {
+    /* Signal line still accumulating its initial SMA */
+    return;
+  }
+  out->valid = true;
+  out->data.macd.signal = state->u.macd.signal.value;
+  out->data.macd.histogram = macd_line - state->u.macd.signal.value;
+}
+
+static void push_stochastic(SamtraderIndicatorState *state, const SamtraderOhlcv *bar, size_t n,
+                            SamtraderIndicatorValue *out) {
+  int k_period = state->params.period;
+  int d_period = state->params.param2;
+
+  /* Sliding highest high / lowest low over the last k_period bars */
+  state->window[n % (size_t)k_period] = bar->high;
+  state->lows[n % (size_t)k_period] = bar->low;
+  deque_slide(&state->max_high, state->window, n, false);
+  deque_slide(&state->min_low, state->lows, n, true);
+
+  if (n < (size_t)(k_period - 1)) {
+    return;
+  }
+
+  double highest_high = state->window[deque_front(&state->max_high) % (size_t)k_period];
+  double lowest_low = state->lows[deque_front(&state->min_low) % (size_t)k_period];
+
+  /* %K = 100 * (close - lowest_low) / (highest_high - lowest_low) */
+  double k_value;
+  double range = highest_high - lowest_low;
+  if (range == 0.0) {
+    k_value = 50.0;
+  } else {
+    k_value = 100.0 * (bar->close - lowest_low) / range;
+  }
+
+  /* Update %D running SMA via circular buffer */
+  size_t k_count = state->u.stochastic.k_count;
+  size_t buf_idx = k_count % (size_t)d_period;
+  if (k_count >= (size_t)d_period) {
+    state->u.stochastic.k_sum -= state->k_ring[buf_idx];
+  }
+  state->k_ring[buf_idx] = k_value;
+  state->u.stochastic.k_sum += k_value;
+  state->u.stochastic.k_count = ++k_count;
+
+  out->valid = (k_count >= (size_t)d_period);
+  out->data.stochastic.k = k_value;
+  out->data.stochastic.d = out->valid ? (state->u.stochastic.k_sum / (double)d_period) : 0.0;
+}
+
+static void push_bollinger(SamtraderIndicatorState *state, const SamtraderOhlcv *bar, size_t n,
+                           SamtraderIndicatorValue *out) {
+  size_t period = (size_t)state->params.period;
+  window_slide(state, bar->close, n);
+  if (n < period - 1) {
+    return;
+  }
+
+  /* Middle band = SMA */
+  double middle = state->u.window.sum / (double)period;
+
+  /* Standard deviation over the window, oldest close first */
+  double sq_sum = 0.0;
+  size_t oldest = (n + 1) % period;
+  for (size_t j = 0; j < period; j++) {
+    double diff = state->window[(oldest + j) % period] - middle;
+    sq_sum += diff * diff;
+  }
+  double stddev = sqrt(sq_sum / (double)period);
+
+  double multiplier = state->params.param_double;
+  out->valid = true;
+  out->data.bollinger.upper = middle + multiplier * stddev;
+  out->data.bollinger.middle = middle;
+  out->data.bollinger.lower = middle - multiplier * stddev;
+}
+
+static void push_atr(SamtraderIndicatorState *state, const SamtraderOhlcv *bar, size_t n,
+                     SamtraderIndicatorValue *out) {
+  int period = state->params.period;
+
+  /* First bar: TR = high - low (no previous close available) */
+  double tr = bar->high - bar->low;
+  if (n > 0) {
+    double high_prev = fabs(bar->high - state->u.atr.prev_close);
+    double low_prev = fabs(bar->low - state->u.atr.prev_close);
+    if (high_prev > tr) {
+      tr = high_prev;
+    }
+    if (low_prev > tr) {
+      tr = low_prev;
+    }
+  }
+  state->u.atr.prev_close = bar->close;
+
+  if (n < (size_t)(period - 1)) {
+    /* Warmup: accumulate true range values */
+    state->u.atr.tr_sum += tr;
+    return;
+  }
+  if (n == (size_t)(period - 1)) {
+    /* First valid ATR: simple average of first `period` true ranges */
+    state->u.atr.tr_sum += tr;
+    state->u.atr.atr = state->u.atr.tr_sum / (double)period;
+  } else {
+    /* Subsequent values: Wilder's smoothing */
+    state->u.atr.atr = ((state->u.atr.atr * (double)(period - 1)) + tr) / (double)period;
+  }
+  out->valid = true;
+  out->data.simple.value = state->u.atr.atr;
+}
+
+static void push_pivot(SamtraderIndicatorState *state, const SamtraderOhlcv *bar, size_t n,
+                       SamtraderIndicatorValue *out) {
+  /* Levels come from the previous bar; the first bar has none */
+  if (n > 0) {
+    double h = state->u.pivot.high;
+    double l = state->u.pivot.low;
+    double c = state->u.pivot.close;
+
+    double pivot = (h + l + c) / 3.0;
+    out->valid = true;
+    out->data.pivot.pivot = pivot;
+    out->data.pivot.r1 = (2.0 * pivot) - l;
+    out->data.pivot.r2 = pivot + (h - l);
+    out->data.pivot.r3 = h + 2.0 * (pivot - l);
+    out->data.pivot.s1 = (2.0 * pivot) - h;
+    out->data.pivot.s2 = pivot - (h - l);
+    out->data.pivot.s3 = l - 2.0 * (h - pivot);
+  }
+  state->u.pivot.high = bar->high;
+  state->u.pivot.low = bar->low;
+  state->u.pivot.close = bar->close;
+}
+
+SamtraderIndicatorValue samtrader_indicator_state_push(SamtraderIndicatorState *state,
+                                                       const SamtraderOhlcv *bar) {
+  SamtraderIndicatorValue out = {0};
+  if (!state || !bar) {
+    return out;
+  }
+
+  out.date = bar->date;
+  out.type = state->type;
+  size_t n = state->count++;
+
+  switch (state->type) {
+    case SAMTRADER_IND_SMA:
+      push_sma(state, bar, n, &out);
+      break;
+    case SAMTRADER_IND_EMA:
+      push_ema(state, bar, n, &out);
+      break;
+    case SAMTRADER_IND_WMA:
+      push_wma(state, bar, n, &out);
+      break;
+    case SAMTRADER_IND_RSI:
+      push_rsi(state, bar, n, &out);
+      break;
+    case SAMTRADER_IND_MACD:
+      push_macd(state, bar, n, &out);
+      break;
+    case SAMTRADER_IND_STOCHASTIC:
+      push_stochastic(state, bar, n, &out);
+      break;
+    case SAMTRADER_IND_BOLLINGER:
+      push_bollinger(state, bar, n, &out);
+      break;
+    case SAMTRADER_IND_ATR:
+      push_atr(state, bar, n, &out);
+      break;
+    case SAMTRADER_IND_PIVOT:
+      push_pivot(state, bar, n, &out);
+      break;
+    default:
+      break;
+  }
+
+  return out;
+}
+
+int samtrader_indicator_state_fill(SamtraderIndicatorSeries *series,
+                                   SamtraderIndicatorState *state,
+                                   const SamtraderBarColumns *bars) {
+  if (!series || !state || !bars || series->size != bars->count ||
+      series->capacity < bars->count) {
+    return -1;
+  }
+
+  size_t valid_from = bars->count;
+  for (size_t i = 0; i < bars->count; i++) {
+    SamtraderOhlcv bar = {.date = bars->date[i],
+                          .open = bars->open[i],
+                          .high = bars->high[i],
+                          .low = bars->low[i],
+                          .close = bars->close[i],
+                          .volume = bars->volume[i]};
+    SamtraderIndicatorValue value = samtrader_indicator_state_push(state, &bar);
+    if (value.valid && valid_from == bars->count) {
+      valid_from = i;
+    }
+
+    /* The value struct's doubles are the series' columns, in order */
+    double fields[SAMTRADER_INDICATOR_MAX_COLUMNS];
+    memcpy(fields, &value.data, series->column_count * sizeof(double));
+    for (size_t c = 0; c < series->column_count; c++) {
+      series->columns[c][i] = fields[c];
+    }
+  }
+  series->valid_from = valid_from;
+  return 0;
+}
+
+SamtraderIndicatorSeries *
+samtrader_indicator_series_from_ohlcv(Samrena *arena, SamtraderIndicatorType type,
+                                      const SamtraderIndicatorParams *params,
+                                      const SamrenaVector *ohlcv) {
+  if (!arena || !params || !ohlcv) {
+    return NULL;
+  }
+
+  size_t count = samrena_vector_size(ohlcv);
+  if (count == 0) {
+    return NULL;
+  }
+
+  SamtraderIndicatorSeries *series =
+      samtrader_indicator_series_create(arena, type, params->period, count);
+  if (!series) {
+    return NULL;
+  }
+  series->params = *params;
+
+  SamtraderIndicatorState *state = samtrader_indicator_state_create(arena, type, params);
+  if (!state) {
+    return NULL;
+  }
+
+  time_t *dates = (time_t *)series->dates;
+  size_t valid_from = count;
+  for (size_t i = 0; i < count; i++) {
+    const SamtraderOhlcv *bar = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i);
+    SamtraderIndicatorValue value = samtrader_indicator_state_push(state, bar);
+    if (value.valid && valid_from == count) {
+      valid_from = i;
+    }
+
+    double fields[SAMTRADER_INDICATOR_MAX_COLUMNS];
+    memcpy(fields, &value.data, series->column_count * sizeof(double));
+    for (size_t c = 0; c < series->column_count; c++) {
+      series->columns[c][i] = fields[c];
+    }
+    dates[i] = bar->date;
+  }
+  series->size = count;
+  series->valid_from = valid_from;
+  return series;
+}
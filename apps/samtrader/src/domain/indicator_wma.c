@@ -15,58 +15,43 @@
  */
 
 #include "samtrader/domain/indicator.h"
+#include "samtrader/domain/indicator_state.h"
 #include "samtrader/domain/ohlcv.h"
 
-SamtraderIndicatorSeries *samtrader_calculate_wma(Samrena *arena, SamrenaVector *ohlcv,
-                                                  int period) {
-  if (!arena || !ohlcv || period < 1) {
+SamtraderIndicatorSeries *samtrader_calculate_wma_columns(Samrena *arena,
+                                                          const SamtraderBarColumns *bars,
+                                                          int period) {
+  if (!arena || !bars || period < 1) {
     return NULL;
   }
 
-  size_t data_size = samrena_vector_size(ohlcv);
+  size_t data_size = bars->count;
   if (data_size == 0) {
     return NULL;
   }
 
+  SamtraderIndicatorParams params = {.period = period};
   SamtraderIndicatorSeries *series =
-      samtrader_indicator_series_create(arena, SAMTRADER_IND_WMA, period, data_size);
+      samtrader_indicator_series_for_bars(arena, SAMTRADER_IND_WMA, &params, bars);
   if (!series) {
     return NULL;
   }
 
-  /* Weight divisor: sum of weights 1 + 2 + ... + n = n*(n+1)/2 */
-  double weight_sum = (double)period * ((double)period + 1.0) / 2.0;
-
-  for (size_t i = 0; i < data_size; i++) {
-    const SamtraderOhlcv *bar = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i);
-    if (!bar) {
-      return NULL;
-    }
-
-    bool valid = (i >= (size_t)(period - 1));
-    double wma_value = 0.0;
+  SamtraderIndicatorState *state =
+      samtrader_indicator_state_create(arena, series->type, &series->params);
+  if (!state || samtrader_indicator_state_fill(series, state, bars) < 0) {
+    return NULL;
+  }
 
-    if (valid) {
-      /* Calculate weighted sum */
-      double weighted_sum = 0.0;
-      for (int j = 0; j < period; j++) {
-        const SamtraderOhlcv *window_bar =
-            (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv,
-                                                            i - (size_t)(period - 1) + (size_t)j);
-        if (!window_bar) {
-          return NULL;
-        }
-        /* Weight: oldest has weight 1, newest has weight 'period' */
-        double weight = (double)(j + 1);
-        weighted_sum += window_bar->close * weight;
-      }
-      wma_value = weighted_sum / weight_sum;
-    }
+  return series;
+}
 
-    if (!samtrader_indicator_add_simple(series, bar->date, wma_value, valid)) {
-      return NULL;
-    }
+SamtraderIndicatorSeries *samtrader_calculate_wma(Samrena *arena, SamrenaVector *ohlcv,
+                                                  int period) {
+  if (!arena || !ohlcv || period < 1) {
+    return NULL;
   }
 
-  return series;
+  SamtraderIndicatorParams params = {.period = period};
+  return samtrader_indicator_series_from_ohlcv(arena, SAMTRADER_IND_WMA, &params, ohlcv);
 }
@@ -20,185 +20,263 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <samdata/samhashmap.h>
+
 #include "samtrader/domain/portfolio.h"
 
-SamtraderMetrics *samtrader_metrics_calculate(Samrena *arena, const SamrenaVector *closed_trades,
-                                              const SamrenaVector *equity_curve,
-                                              double risk_free_rate) {
-  if (!arena) {
-    return NULL;
+#define TRADING_DAYS_PER_YEAR 252.0
+#define SECONDS_PER_DAY 86400
+
+static int64_t utc_day(time_t date) {
+  int64_t t = (int64_t)date;
+  return t / SECONDS_PER_DAY - (t % SECONDS_PER_DAY < 0);
+}
+
+/* Points per trading day, rounded: 1 for daily bars, ~390 for US minute bars */
+static double bars_per_day(size_t num_points, size_t days) {
+  double per_day = round((double)num_points / (double)days);
+  return per_day > 1.0 ? per_day : 1.0;
+}
+
+double samtrader_metrics_bars_per_year(const SamrenaVector *equity_curve) {
+  size_t num_points = equity_curve ? samrena_vector_size(equity_curve) : 0;
+  if (num_points == 0) {
+    return TRADING_DAYS_PER_YEAR;
+  }
+  const SamtraderEquityPoint *points = (const SamtraderEquityPoint *)equity_curve->data;
+  size_t days = 0;
+  int64_t prev_day = 0;
+  for (size_t i = 0; i < num_points; i++) {
+    int64_t day = utc_day(points[i].date);
+    if (i == 0 || day != prev_day) {
+      days++;
+      prev_day = day;
+    }
   }
+  return TRADING_DAYS_PER_YEAR * bars_per_day(num_points, days);
+}
 
-  SamtraderMetrics *metrics = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderMetrics);
-  if (!metrics) {
-    return NULL;
+double samtrader_metrics_bars_per_year_of_dates(const time_t *dates, size_t count) {
+  if (!dates || count == 0) {
+    return TRADING_DAYS_PER_YEAR;
+  }
+  size_t days = 0;
+  int64_t prev_day = 0;
+  for (size_t i = 0; i < count; i++) {
+    int64_t day = utc_day(dates[i]);
+    if (i == 0 || day != prev_day) {
+      days++;
+      prev_day = day;
+    }
   }
+  return TRADING_DAYS_PER_YEAR * bars_per_day(count, days);
+}
 
-  /* ===== Trade Statistics ===== */
-  size_t num_trades = closed_trades ? samrena_vector_size(closed_trades) : 0;
-  metrics->total_trades = (int)num_trades;
-
-  if (num_trades > 0) {
-    double sum_wins = 0.0;
-    double sum_losses = 0.0;
-    double total_duration = 0.0;
-    metrics->largest_win = 0.0;
-    metrics->largest_loss = 0.0;
-
-    for (size_t i = 0; i < num_trades; i++) {
-      const SamtraderClosedTrade *trade =
-          (const SamtraderClosedTrade *)samrena_vector_at_const(closed_trades, i);
-
-      double duration = difftime(trade->exit_date, trade->entry_date) / 86400.0;
-      total_duration += duration;
-
-      if (trade->pnl > 0.0) {
-        metrics->winning_trades++;
-        sum_wins += trade->pnl;
-        if (trade->pnl > metrics->largest_win) {
-          metrics->largest_win = trade->pnl;
-        }
-      } else {
-        metrics->losing_trades++;
-        sum_losses += trade->pnl;
-        if (trade->pnl < metrics->largest_loss) {
-          metrics->largest_loss = trade->pnl;
-        }
+void samtrader_metrics_accumulator_init(SamtraderMetricsAccumulator *acc, double bars_per_year,
+                                        double risk_free_rate) {
+  if (!acc) {
+    return;
+  }
+  memset(acc, 0, sizeof(*acc));
+  acc->bars_per_year = bars_per_year > 0.0 ? bars_per_year : TRADING_DAYS_PER_YEAR;
+  acc->risk_free_per_bar = risk_free_rate / acc->bars_per_year;
+}
+
+void samtrader_metrics_accumulator_add_equity(SamtraderMetricsAccumulator *acc, double equity) {
+  if (!acc) {
+    return;
+  }
+
+  size_t i = acc->points++;
+  if (i == 0) {
+    acc->first_equity = equity;
+    acc->last_equity = equity;
+    acc->peak = equity;
+    return;
+  }
+
+  /* Per-bar return (daily return for daily bars) */
+  double prev = acc->last_equity;
+  double ret = prev > 0.0 ? (equity - prev) / prev : 0.0;
+  acc->last_equity = equity;
+
+  double delta = ret - acc->return_mean;
+  acc->return_mean += delta / (double)i;
+  acc->return_m2 += delta * (ret - acc->return_mean);
+
+  double excess = ret - acc->risk_free_per_bar;
+  if (excess < 0.0) {
+    acc->downside_sq += excess * excess;
+  }
+
+  /* Max drawdown and max drawdown duration */
+  if (equity >= acc->peak) {
+    /* New peak - record duration of the drawdown that just ended */
+    if (acc->in_drawdown) {
+      size_t dur = i - acc->drawdown_start;
+      if (dur > acc->max_drawdown_bars) {
+        acc->max_drawdown_bars = dur;
       }
+      acc->in_drawdown = false;
     }
+    acc->peak = equity;
+    acc->drawdown_start = i;
+  } else if (!acc->in_drawdown) {
+    acc->in_drawdown = true;
+    acc->drawdown_start = i - 1; /* Drawdown started at the peak */
+  }
+
+  if (acc->peak > 0.0) {
+    double dd = (acc->peak - equity) / acc->peak;
+    if (dd > acc->max_drawdown) {
+      acc->max_drawdown = dd;
+    }
+  }
+}
+
+void samtrader_metrics_accumulator_add_trade(SamtraderMetricsAccumulator *acc,
+                                             const SamtraderClosedTrade *trade) {
+  if (!acc || !trade) {
+    return;
+  }
+
+  acc->total_trades++;
+  acc->total_duration += difftime(trade->exit_date, trade->entry_date) / 86400.0;
+
+  if (trade->pnl > 0.0) {
+    acc->winning_trades++;
+    acc->sum_wins += trade->pnl;
+    if (trade->pnl > acc->largest_win) {
+      acc->largest_win = trade->pnl;
+    }
+  } else {
+    acc->losing_trades++;
+    acc->sum_losses += trade->pnl;
+    if (trade->pnl < acc->largest_loss) {
+      acc->largest_loss = trade->pnl;
+    }
+  }
+}
 
-    metrics->win_rate = (double)metrics->winning_trades / (double)metrics->total_trades;
-    metrics->average_trade_duration = total_duration / (double)num_trades;
+void samtrader_metrics_accumulator_finish(const SamtraderMetricsAccumulator *acc,
+                                          SamtraderMetrics *out) {
+  if (!acc || !out) {
+    return;
+  }
+  memset(out, 0, sizeof(*out));
 
-    if (metrics->winning_trades > 0) {
-      metrics->average_win = sum_wins / (double)metrics->winning_trades;
+  /* ===== Trade Statistics ===== */
+  out->total_trades = acc->total_trades;
+  if (acc->total_trades > 0) {
+    out->winning_trades = acc->winning_trades;
+    out->losing_trades = acc->losing_trades;
+    out->largest_win = acc->largest_win;
+    out->largest_loss = acc->largest_loss;
+    out->win_rate = (double)acc->winning_trades / (double)acc->total_trades;
+    out->average_trade_duration = acc->total_duration / (double)acc->total_trades;
+
+    if (acc->winning_trades > 0) {
+      out->average_win = acc->sum_wins / (double)acc->winning_trades;
     }
-    if (metrics->losing_trades > 0) {
-      metrics->average_loss = sum_losses / (double)metrics->losing_trades;
+    if (acc->losing_trades > 0) {
+      out->average_loss = acc->sum_losses / (double)acc->losing_trades;
     }
 
-    if (sum_losses < 0.0) {
-      metrics->profit_factor = sum_wins / (-sum_losses);
+    if (acc->sum_losses < 0.0) {
+      out->profit_factor = acc->sum_wins / (-acc->sum_losses);
     } else {
       /* All winning or zero-loss trades */
-      metrics->profit_factor = (sum_wins > 0.0) ? INFINITY : 0.0;
+      out->profit_factor = (acc->sum_wins > 0.0) ? INFINITY : 0.0;
     }
   }
 
   /* ===== Return & Risk Metrics from Equity Curve ===== */
-  size_t num_points = equity_curve ? samrena_vector_size(equity_curve) : 0;
+  if (acc->points < 2) {
+    return;
+  }
 
-  if (num_points >= 2) {
-    const SamtraderEquityPoint *first =
-        (const SamtraderEquityPoint *)samrena_vector_at_const(equity_curve, 0);
-    const SamtraderEquityPoint *last =
-        (const SamtraderEquityPoint *)samrena_vector_at_const(equity_curve, num_points - 1);
+  if (acc->first_equity > 0.0) {
+    out->total_return = (acc->last_equity - acc->first_equity) / acc->first_equity;
+  }
 
-    double initial_equity = first->equity;
-    double final_equity = last->equity;
+  double bars_per_year = acc->bars_per_year;
+  size_t periods = acc->points - 1;
+  if (out->total_return > -1.0) {
+    out->annualized_return = pow(1.0 + out->total_return, bars_per_year / periods) - 1.0;
+  }
 
-    if (initial_equity > 0.0) {
-      metrics->total_return = (final_equity - initial_equity) / initial_equity;
-    }
+  double stddev = sqrt(acc->return_m2 / (double)periods);
+  double downside_dev = sqrt(acc->downside_sq / (double)periods);
+  double excess_mean = acc->return_mean - acc->risk_free_per_bar;
 
-    size_t trading_days = num_points - 1;
-    if (trading_days > 0 && metrics->total_return > -1.0) {
-      metrics->annualized_return = pow(1.0 + metrics->total_return, 252.0 / trading_days) - 1.0;
-    }
+  if (stddev > 0.0) {
+    out->sharpe_ratio = excess_mean / stddev * sqrt(bars_per_year);
+  }
+  if (downside_dev > 0.0) {
+    out->sortino_ratio = excess_mean / downside_dev * sqrt(bars_per_year);
+  }
 
-    /* Compute daily returns */
-    double *daily_returns = (double *)samrena_push(arena, trading_days * sizeof(double));
-    if (!daily_returns) {
-      return NULL;
+  /* Include the final drawdown period (if we never recovered) */
+  size_t max_dd_bars = acc->max_drawdown_bars;
+  if (acc->in_drawdown) {
+    size_t final_dur = periods - acc->drawdown_start;
+    if (final_dur > max_dd_bars) {
+      max_dd_bars = final_dur;
     }
+  }
 
-    double sum_returns = 0.0;
-    for (size_t i = 0; i < trading_days; i++) {
-      const SamtraderEquityPoint *prev =
-          (const SamtraderEquityPoint *)samrena_vector_at_const(equity_curve, i);
-      const SamtraderEquityPoint *curr =
-          (const SamtraderEquityPoint *)samrena_vector_at_const(equity_curve, i + 1);
-      if (prev->equity > 0.0) {
-        daily_returns[i] = (curr->equity - prev->equity) / prev->equity;
-      } else {
-        daily_returns[i] = 0.0;
-      }
-      sum_returns += daily_returns[i];
-    }
+  out->max_drawdown = acc->max_drawdown;
+  out->max_drawdown_duration = (double)max_dd_bars / (bars_per_year / TRADING_DAYS_PER_YEAR);
+}
 
-    double mean_return = sum_returns / (double)trading_days;
-    double risk_free_daily = risk_free_rate / 252.0;
+SamtraderMetrics *samtrader_metrics_calculate(Samrena *arena, const SamrenaVector *closed_trades,
+                                              const SamrenaVector *equity_curve,
+                                              double risk_free_rate) {
+  if (!arena) {
+    return NULL;
+  }
 
-    /* Stddev of daily returns */
-    double sum_sq = 0.0;
-    double sum_downside_sq = 0.0;
-    for (size_t i = 0; i < trading_days; i++) {
-      double diff = daily_returns[i] - mean_return;
-      sum_sq += diff * diff;
+  SamtraderMetrics *metrics = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderMetrics);
+  if (!metrics) {
+    return NULL;
+  }
 
-      double excess = daily_returns[i] - risk_free_daily;
-      if (excess < 0.0) {
-        sum_downside_sq += excess * excess;
-      }
-    }
+  SamtraderMetricsAccumulator acc;
+  samtrader_metrics_accumulator_init(&acc, samtrader_metrics_bars_per_year(equity_curve),
+                                     risk_free_rate);
 
-    double stddev = sqrt(sum_sq / (double)trading_days);
-    double downside_dev = sqrt(sum_downside_sq / (double)trading_days);
+  size_t num_trades = closed_trades ? samrena_vector_size(closed_trades) : 0;
+  const SamtraderClosedTrade *trades =
+      num_trades > 0 ? (const SamtraderClosedTrade *)closed_trades->data : NULL;
+  for (size_t i = 0; i < num_trades; i++) {
+    samtrader_metrics_accumulator_add_trade(&acc, &trades[i]);
+  }
 
-    if (stddev > 0.0) {
-      metrics->sharpe_ratio = (mean_return - risk_free_daily) / stddev * sqrt(252.0);
-    }
-    if (downside_dev > 0.0) {
-      metrics->sortino_ratio = (mean_return - risk_free_daily) / downside_dev * sqrt(252.0);
-    }
+  size_t num_points = equity_curve ? samrena_vector_size(equity_curve) : 0;
+  const SamtraderEquityPoint *points =
+      num_points > 0 ? (const SamtraderEquityPoint *)equity_curve->data : NULL;
+  for (size_t i = 0; i < num_points; i++) {
+    samtrader_metrics_accumulator_add_equity(&acc, points[i].equity);
+  }
 
-    /* Max drawdown and max drawdown duration */
-    double peak = first->equity;
-    double max_dd = 0.0;
-    size_t dd_start = 0;
-    size_t max_dd_dur = 0;
-    bool in_drawdown = false;
-
-    for (size_t i = 1; i < num_points; i++) {
-      const SamtraderEquityPoint *pt =
-          (const SamtraderEquityPoint *)samrena_vector_at_const(equity_curve, i);
-
-      if (pt->equity >= peak) {
-        /* New peak - record duration of the drawdown that just ended */
-        if (in_drawdown) {
-          size_t dur = i - dd_start;
-          if (dur > max_dd_dur) {
-            max_dd_dur = dur;
-          }
-          in_drawdown = false;
-        }
-        peak = pt->equity;
-        dd_start = i;
-      } else if (!in_drawdown) {
-        in_drawdown = true;
-        dd_start = i - 1; /* Drawdown started at the peak */
-      }
+  samtrader_metrics_accumulator_finish(&acc, metrics);
+  return metrics;
+}
 
-      if (peak > 0.0) {
-        double dd = (peak - pt->equity) / peak;
-        if (dd > max_dd) {
-          max_dd = dd;
-        }
-      }
-    }
-    /* Check the final drawdown period (if we never recovered) */
-    if (in_drawdown) {
-      size_t final_dur = (num_points - 1) - dd_start;
-      if (final_dur > max_dd_dur) {
-        max_dd_dur = final_dur;
-      }
+/* code -> size_t* position in codes; the first occurrence wins */
+static SamHashMap *build_code_index(Samrena *arena, const char **codes, size_t code_count) {
+  SamHashMap *index = samhashmap_create(code_count * 2 + 1, arena);
+  size_t *positions = SAMRENA_PUSH_ARRAY(arena, size_t, code_count);
+  if (!index || !positions) {
+    return NULL;
+  }
+  for (size_t i = code_count; i-- > 0;) {
+    positions[i] = i;
+    if (!samhashmap_put(index, codes[i], &positions[i])) {
+      return NULL;
     }
-
-    metrics->max_drawdown = max_dd;
-    metrics->max_drawdown_duration = (double)max_dd_dur;
   }
-
-  return metrics;
+  return index;
 }
 
 SamtraderCodeResult *samtrader_metrics_compute_per_code(Samrena *arena,
@@ -221,20 +299,28 @@ SamtraderCodeResult *samtrader_metrics_compute_per_code(Samrena *arena,
 
   size_t num_trades = closed_trades ? samrena_vector_size(closed_trades) : 0;
 
+  /* Built only if some trade's symbol id does not line up with codes */
+  SamHashMap *code_index = NULL;
+
   for (size_t t = 0; t < num_trades; t++) {
     const SamtraderClosedTrade *trade =
         (const SamtraderClosedTrade *)samrena_vector_at_const(closed_trades, t);
+    if (!trade->code) {
+      continue;
+    }
 
-    /* Find matching code index */
-    size_t ci = code_count; /* sentinel = not found */
-    for (size_t i = 0; i < code_count; i++) {
-      if (strcmp(trade->code, codes[i]) == 0) {
-        ci = i;
-        break;
+    /* A backtest interns codes in universe order, so symbol id s is codes[s - 1] */
+    size_t ci = (size_t)trade->symbol - 1;
+    if (trade->symbol == SAMTRADER_SYMBOL_NONE || ci >= code_count ||
+        (trade->code != codes[ci] && strcmp(trade->code, codes[ci]) != 0)) {
+      if (!code_index && !(code_index = build_code_index(arena, codes, code_count))) {
+        return NULL;
       }
-    }
-    if (ci == code_count) {
-      continue; /* trade for unknown code, skip */
+      const size_t *found = (const size_t *)samhashmap_get(code_index, trade->code);
+      if (!found) {
+        continue; /* trade for unknown code, skip */
+      }
+      ci = *found;
     }
 
     SamtraderCodeResult *r = &results[ci];
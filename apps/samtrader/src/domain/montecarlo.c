@@ -0,0 +1,307 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "samtrader/domain/montecarlo.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <samdata/samrng.h>
+
+#include "samtrader/domain/metrics.h"
+#include "samtrader/domain/portfolio.h"
+
+/* Samples per worker task; fixed so chunk k always draws stream k */
+#define MONTECARLO_CHUNK 1024
+
+static const double PERCENTILE_LEVELS[SAMTRADER_MONTECARLO_LEVELS] = {1.0,  5.0,  25.0, 50.0,
+                                                                      75.0, 95.0, 99.0};
+
+bool samtrader_montecarlo_method_parse(const char *name, SamtraderMonteCarloMethod *out) {
+  if (!name || !out) {
+    return false;
+  }
+  if (strcmp(name, "trades") == 0) {
+    *out = SAMTRADER_MONTECARLO_TRADES;
+  } else if (strcmp(name, "returns") == 0) {
+    *out = SAMTRADER_MONTECARLO_RETURNS;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+const char *samtrader_montecarlo_method_name(SamtraderMonteCarloMethod method) {
+  switch (method) {
+    case SAMTRADER_MONTECARLO_TRADES:
+      return "trades";
+    case SAMTRADER_MONTECARLO_RETURNS:
+      return "returns";
+  }
+  return "unknown";
+}
+
+typedef struct {
+  const SamtraderMonteCarloConfig *config;
+  const double *values;   /* Trade PnLs or per-bar returns */
+  size_t value_count;     /* Entries in values */
+  size_t block_length;    /* Returns method block length */
+  double initial_equity;  /* Path starting equity */
+  double periods_per_year;
+  double risk_free_per_period;
+  double *total_return; /* One slot per sample */
+  double *sharpe_ratio;
+  double *max_drawdown;
+} MonteCarloJob;
+
+/* Streaming per-path state: equity, peak and Welford moments of the period returns */
+typedef struct {
+  double equity;
+  double peak;
+  double max_drawdown;
+  size_t count;
+  double mean;
+  double m2;
+} PathStats;
+
+/* Uniform index in [0, n); modulo bias is negligible for n far below 2^64 */
+static size_t draw_index(SamRng *rng, size_t n) { return (size_t)(samrng_uint64(rng) % n); }
+
+/* Apply one period's return; returns false once the path is ruined */
+static bool path_step(PathStats *path, double ret, double next_equity) {
+  path->count++;
+  double delta = ret - path->mean;
+  path->mean += delta / (double)path->count;
+  path->m2 += delta * (ret - path->mean);
+
+  if (next_equity <= 0.0) {
+    path->equity = 0.0;
+    path->max_drawdown = 1.0;
+    return false;
+  }
+  path->equity = next_equity;
+  if (next_equity > path->peak) {
+    path->peak = next_equity;
+  } else {
+    double dd = (path->peak - next_equity) / path->peak;
+    if (dd > path->max_drawdown) {
+      path->max_drawdown = dd;
+    }
+  }
+  return true;
+}
+
+static void sample_trades(const MonteCarloJob *job, SamRng *rng, PathStats *path) {
+  for (size_t i = 0; i < job->value_count; i++) {
+    double pnl = job->values[draw_index(rng, job->value_count)];
+    if (!path_step(path, pnl / path->equity, path->equity + pnl)) {
+      return;
+    }
+  }
+}
+
+static void sample_returns(const MonteCarloJob *job, SamRng *rng, PathStats *path) {
+  size_t n = job->value_count;
+  size_t drawn = 0;
+  while (drawn < n) {
+    size_t start = draw_index(rng, n);
+    for (size_t j = 0; j < job->block_length && drawn < n; j++, drawn++) {
+      double ret = job->values[(start + j) % n];
+      if (!path_step(path, ret, path->equity * (1.0 + ret))) {
+        return;
+      }
+    }
+  }
+}
+
+static int run_chunk(void *ctx, size_t index, Samrena *arena) {
+  const MonteCarloJob *job = (const MonteCarloJob *)ctx;
+  size_t begin = index * MONTECARLO_CHUNK;
+  size_t end = begin + MONTECARLO_CHUNK;
+  if (end > job->config->samples) {
+    end = job->config->samples;
+  }
+
+  SamrenaScratch scratch = samrena_scratch_begin(arena);
+  SamRng *rng = samrng_create(arena, job->config->seed);
+  if (!rng) {
+    samrena_scratch_end(scratch);
+    return -1;
+  }
+  for (size_t k = 0; k < index; k++) {
+    samrng_jump(rng);
+  }
+
+  for (size_t s = begin; s < end; s++) {
+    PathStats path = {.equity = job->initial_equity, .peak = job->initial_equity};
+    if (job->config->method == SAMTRADER_MONTECARLO_TRADES) {
+      sample_trades(job, rng, &path);
+    } else {
+      sample_returns(job, rng, &path);
+    }
+
+    double stddev = path.count > 0 ? sqrt(path.m2 / (double)path.count) : 0.0;
+    job->total_return[s] = (path.equity - job->initial_equity) / job->initial_equity;
+    job->sharpe_ratio[s] = stddev > 0.0 ? (path.mean - job->risk_free_per_period) / stddev *
+                                              sqrt(job->periods_per_year)
+                                        : 0.0;
+    job->max_drawdown[s] = path.max_drawdown;
+  }
+
+  samrena_scratch_end(scratch);
+  return 0;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+/* Sort values and read the given percentiles off them by linear interpolation */
+static void percentiles(double *values, size_t count, double *out) {
+  qsort(values, count, sizeof(double), compare_doubles);
+  for (size_t i = 0; i < SAMTRADER_MONTECARLO_LEVELS; i++) {
+    double pos = PERCENTILE_LEVELS[i] / 100.0 * (double)(count - 1);
+    size_t lo = (size_t)pos;
+    size_t hi = lo + 1 < count ? lo + 1 : lo;
+    double frac = pos - (double)lo;
+    out[i] = values[lo] + (values[hi] - values[lo]) * frac;
+  }
+}
+
+SamtraderMonteCarloResult *samtrader_montecarlo_run(Samrena *arena, SamtraderWorkerPool *pool,
+                                                    const SamtraderMonteCarloConfig *config,
+                                                    const SamrenaVector *closed_trades,
+                                                    const SamrenaVector *equity_curve) {
+  if (!arena || !pool || !config || config->samples == 0 || !equity_curve) {
+    return NULL;
+  }
+  size_t num_points = samrena_vector_size(equity_curve);
+  if (num_points < 2) {
+    return NULL;
+  }
+  const SamtraderEquityPoint *points = (const SamtraderEquityPoint *)equity_curve->data;
+  size_t periods = num_points - 1;
+  double initial_equity = points[0].equity;
+  if (initial_equity <= 0.0) {
+    return NULL;
+  }
+  double bars_per_year = samtrader_metrics_bars_per_year(equity_curve);
+
+  SamtraderMonteCarloResult *result = SAMRENA_PUSH_TYPE(arena, SamtraderMonteCarloResult);
+  if (!result) {
+    return NULL;
+  }
+  memset(result, 0, sizeof(*result));
+  result->method = config->method;
+  result->samples = config->samples;
+  memcpy(result->levels, PERCENTILE_LEVELS, sizeof(PERCENTILE_LEVELS));
+
+  MonteCarloJob job = {.config = config, .initial_equity = initial_equity};
+
+  SamrenaScratch scratch = samrena_scratch_begin(arena);
+  double *values = NULL;
+  if (config->method == SAMTRADER_MONTECARLO_TRADES) {
+    size_t trade_count = closed_trades ? samrena_vector_size(closed_trades) : 0;
+    if (trade_count == 0) {
+      samrena_scratch_end(scratch);
+      return NULL;
+    }
+    const SamtraderClosedTrade *trades = (const SamtraderClosedTrade *)closed_trades->data;
+    values = SAMRENA_PUSH_ARRAY(arena, double, trade_count);
+    if (values) {
+      for (size_t i = 0; i < trade_count; i++) {
+        values[i] = trades[i].pnl;
+      }
+    }
+    job.value_count = trade_count;
+    job.periods_per_year = (double)trade_count * bars_per_year / (double)periods;
+  } else {
+    values = SAMRENA_PUSH_ARRAY(arena, double, periods);
+    if (values) {
+      for (size_t i = 0; i < periods; i++) {
+        double prev = points[i].equity;
+        values[i] = prev > 0.0 ? (points[i + 1].equity - prev) / prev : 0.0;
+      }
+    }
+    size_t block = config->block_length;
+    if (block == 0) {
+      block = (size_t)llround(cbrt((double)periods));
+    }
+    if (block < 1) {
+      block = 1;
+    }
+    if (block > periods) {
+      block = periods;
+    }
+    job.value_count = periods;
+    job.block_length = block;
+    job.periods_per_year = bars_per_year;
+    result->block_length = block;
+  }
+  result->sample_length = job.value_count;
+  job.values = values;
+  job.risk_free_per_period = config->risk_free_rate / job.periods_per_year;
+
+  job.total_return = SAMRENA_PUSH_ARRAY(arena, double, config->samples);
+  job.sharpe_ratio = SAMRENA_PUSH_ARRAY(arena, double, config->samples);
+  job.max_drawdown = SAMRENA_PUSH_ARRAY(arena, double, config->samples);
+  if (!values || !job.total_return || !job.sharpe_ratio || !job.max_drawdown) {
+    samrena_scratch_end(scratch);
+    return NULL;
+  }
+
+  size_t chunks = (config->samples + MONTECARLO_CHUNK - 1) / MONTECARLO_CHUNK;
+  if (samtrader_worker_pool_run(pool, chunks, run_chunk, &job) != 0) {
+    samrena_scratch_end(scratch);
+    return NULL;
+  }
+
+  size_t losses = 0;
+  for (size_t s = 0; s < config->samples; s++) {
+    if (job.total_return[s] < 0.0) {
+      losses++;
+    }
+  }
+  result->probability_of_loss = (double)losses / (double)config->samples;
+
+  percentiles(job.total_return, config->samples, result->total_return);
+  percentiles(job.sharpe_ratio, config->samples, result->sharpe_ratio);
+  percentiles(job.max_drawdown, config->samples, result->max_drawdown);
+
+  samrena_scratch_end(scratch);
+  return result;
+}
+
+void samtrader_montecarlo_print(const SamtraderMonteCarloResult *result) {
+  if (!result) {
+    printf("Monte Carlo: NULL\n");
+    return;
+  }
+
+  printf("\n=== Monte Carlo (%s, %zu samples) ===\n",
+         samtrader_montecarlo_method_name(result->method), result->samples);
+  printf("Percentile   Total Return   Sharpe Ratio   Max Drawdown\n");
+  for (size_t i = 0; i < SAMTRADER_MONTECARLO_LEVELS; i++) {
+    printf("%9.0f%%   %11.2f%%   %12.4f   %11.2f%%\n", result->levels[i],
+           result->total_return[i] * 100.0, result->sharpe_ratio[i],
+           result->max_drawdown[i] * 100.0);
+  }
+  printf("Probability of Loss: %.2f%%\n", result->probability_of_loss * 100.0);
+}
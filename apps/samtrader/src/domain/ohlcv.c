@@ -92,3 +92,139 @@ double samtrader_ohlcv_true_range(const SamtraderOhlcv *ohlcv, double prev_close
 
   return max_val;
 }
+
+static const char *arena_strdup(Samrena *arena, const char *src) {
+  size_t len = strlen(src) + 1;
+  char *copy = (char *)samrena_push(arena, len);
+  if (!copy) {
+    return NULL;
+  }
+  memcpy(copy, src, len);
+  return copy;
+}
+
+static void *push_column(Samrena *arena, size_t count, size_t element_size) {
+  return samrena_push_aligned(arena, (uint64_t)(count * element_size),
+                              SAMTRADER_BAR_COLUMN_ALIGNMENT);
+}
+
+SamtraderBarColumns *samtrader_bar_columns_create(Samrena *arena, const char *code,
+                                                  const char *exchange, size_t count) {
+  if (!arena) {
+    return NULL;
+  }
+
+  SamtraderBarColumns *bars = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderBarColumns);
+  if (!bars) {
+    return NULL;
+  }
+
+  if (code && !(bars->code = arena_strdup(arena, code))) {
+    return NULL;
+  }
+  if (exchange && !(bars->exchange = arena_strdup(arena, exchange))) {
+    return NULL;
+  }
+
+  bars->count = count;
+  if (count == 0) {
+    return bars;
+  }
+
+  bars->date = (time_t *)push_column(arena, count, sizeof(time_t));
+  bars->open = (double *)push_column(arena, count, sizeof(double));
+  bars->high = (double *)push_column(arena, count, sizeof(double));
+  bars->low = (double *)push_column(arena, count, sizeof(double));
+  bars->close = (double *)push_column(arena, count, sizeof(double));
+  bars->volume = (int64_t *)push_column(arena, count, sizeof(int64_t));
+  if (!bars->date || !bars->open || !bars->high || !bars->low || !bars->close || !bars->volume) {
+    return NULL;
+  }
+
+  return bars;
+}
+
+SamtraderBarColumns *samtrader_bar_columns_from_ohlcv(Samrena *arena, const SamrenaVector *ohlcv) {
+  if (!arena || !ohlcv) {
+    return NULL;
+  }
+
+  size_t count = samrena_vector_size(ohlcv);
+  const SamtraderOhlcv *rows = (const SamtraderOhlcv *)ohlcv->data;
+  const char *code = count > 0 ? rows[0].code : NULL;
+  const char *exchange = count > 0 ? rows[0].exchange : NULL;
+
+  SamtraderBarColumns *bars = samtrader_bar_columns_create(arena, code, exchange, count);
+  if (!bars) {
+    return NULL;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    bars->date[i] = rows[i].date;
+    bars->open[i] = rows[i].open;
+    bars->high[i] = rows[i].high;
+    bars->low[i] = rows[i].low;
+    bars->close[i] = rows[i].close;
+    bars->volume[i] = rows[i].volume;
+  }
+
+  return bars;
+}
+
+SamrenaVector *samtrader_ohlcv_from_bar_columns(Samrena *arena, const SamtraderBarColumns *bars) {
+  if (!arena || !bars) {
+    return NULL;
+  }
+
+  SamrenaVector *ohlcv = samtrader_ohlcv_vector_create(arena, bars->count > 0 ? bars->count : 1);
+  if (!ohlcv) {
+    return NULL;
+  }
+
+  for (size_t i = 0; i < bars->count; i++) {
+    SamtraderOhlcv bar = {.code = bars->code,
+                          .exchange = bars->exchange,
+                          .date = bars->date[i],
+                          .open = bars->open[i],
+                          .high = bars->high[i],
+                          .low = bars->low[i],
+                          .close = bars->close[i],
+                          .volume = bars->volume[i]};
+    if (!samrena_vector_push(ohlcv, &bar)) {
+      return NULL;
+    }
+  }
+
+  return ohlcv;
+}
+
+/* One multiply-rotate round per 64-bit word, finished with a murmur-style avalanche */
+static uint64_t hash_words(uint64_t h, const void *column, size_t count) {
+  const unsigned char *bytes = (const unsigned char *)column;
+  for (size_t i = 0; i < count; i++) {
+    uint64_t word;
+    memcpy(&word, bytes + i * sizeof(word), sizeof(word));
+    h ^= word * 0x9e3779b97f4a7c15ULL;
+    h = ((h << 31) | (h >> 33)) * 0xc2b2ae3d27d4eb4fULL;
+  }
+  return h;
+}
+
+uint64_t samtrader_bar_columns_hash(const SamtraderBarColumns *bars) {
+  size_t count = bars ? bars->count : 0;
+  uint64_t h = 0x6a09e667f3bcc909ULL ^ (uint64_t)count;
+  if (count > 0) {
+    h = hash_words(h, bars->date, count);
+    h = hash_words(h, bars->open, count);
+    h = hash_words(h, bars->high, count);
+    h = hash_words(h, bars->low, count);
+    h = hash_words(h, bars->close, count);
+    h = hash_words(h, bars->volume, count);
+  }
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
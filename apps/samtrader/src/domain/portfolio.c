@@ -16,8 +16,17 @@
 
 #include "samtrader/domain/portfolio.h"
 
+#include <math.h>
 #include <string.h>
 
+/* Where a symbol's position lives; reused every time the symbol is traded */
+typedef struct {
+  SamtraderPosition position;
+  size_t open_index; /* index in open_symbols, or SLOT_FLAT */
+} PositionSlot;
+
+#define SLOT_FLAT SIZE_MAX
+
 SamtraderPortfolio *samtrader_portfolio_create(Samrena *arena, double initial_capital) {
   if (!arena) {
     return NULL;
@@ -28,8 +37,26 @@ SamtraderPortfolio *samtrader_portfolio_create(Samrena *arena, double initial_ca
     return NULL;
   }
 
-  portfolio->positions = samhashmap_create(16, arena);
-  if (!portfolio->positions) {
+  portfolio->arena = arena;
+  portfolio->symbols = samtrader_symbol_table_create(arena, 16);
+  portfolio->exchanges = samtrader_symbol_table_create(arena, 4);
+  if (!portfolio->symbols || !portfolio->exchanges) {
+    return NULL;
+  }
+
+  /* Slot 0 belongs to SAMTRADER_SYMBOL_NONE and is never used */
+  portfolio->slots = samrena_vector_init(arena, sizeof(PositionSlot *), 17);
+  PositionSlot *none = NULL;
+  if (!portfolio->slots || !samrena_vector_push(portfolio->slots, &none)) {
+    return NULL;
+  }
+
+  portfolio->open_symbols = samrena_vector_init(arena, sizeof(SamtraderSymbolId), 16);
+  portfolio->exit_below = samrena_vector_init(arena, sizeof(double), 16);
+  portfolio->exit_above = samrena_vector_init(arena, sizeof(double), 16);
+  portfolio->exit_stop = samrena_vector_init(arena, sizeof(double), 16);
+  if (!portfolio->open_symbols || !portfolio->exit_below || !portfolio->exit_above ||
+      !portfolio->exit_stop) {
     return NULL;
   }
 
@@ -49,40 +76,124 @@ SamtraderPortfolio *samtrader_portfolio_create(Samrena *arena, double initial_ca
   return portfolio;
 }
 
+static PositionSlot *slot_at(const SamtraderPortfolio *portfolio, SamtraderSymbolId symbol) {
+  if (symbol == SAMTRADER_SYMBOL_NONE || symbol >= samrena_vector_size(portfolio->slots)) {
+    return NULL;
+  }
+  return *(PositionSlot *const *)samrena_vector_at_const(portfolio->slots, symbol);
+}
+
+/* Fold stop loss and take profit into the two prices that bound a position's
+ * holding range, matching samtrader_position_should_stop_loss/take_profit */
+static void exit_levels(const SamtraderPosition *position, double *below, double *above,
+                        double *stop) {
+  double stop_loss = position->stop_loss;
+  double target = position->take_profit;
+  if (position->quantity > 0) {
+    *below = stop_loss != 0.0 ? stop_loss : -INFINITY;
+    *above = target != 0.0 ? target : INFINITY;
+    *stop = *below;
+  } else {
+    *below = target != 0.0 ? target : -INFINITY;
+    *above = stop_loss != 0.0 ? stop_loss : INFINITY;
+    *stop = *above;
+  }
+}
+
+SamtraderSymbolId samtrader_portfolio_intern(SamtraderPortfolio *portfolio, const char *code) {
+  if (!portfolio || !code) {
+    return SAMTRADER_SYMBOL_NONE;
+  }
+
+  SamtraderSymbolId symbol = samtrader_symbol_intern(portfolio->symbols, code);
+  if (symbol == SAMTRADER_SYMBOL_NONE) {
+    return SAMTRADER_SYMBOL_NONE;
+  }
+
+  /* New ids are handed out consecutively, so at most one slot is missing */
+  if (symbol == samrena_vector_size(portfolio->slots)) {
+    PositionSlot *slot = SAMRENA_PUSH_TYPE_ZERO(portfolio->arena, PositionSlot);
+    if (!slot || !samrena_vector_push(portfolio->slots, &slot)) {
+      return SAMTRADER_SYMBOL_NONE;
+    }
+    slot->open_index = SLOT_FLAT;
+  }
+
+  return symbol;
+}
+
 bool samtrader_portfolio_add_position(SamtraderPortfolio *portfolio, Samrena *arena,
                                       const SamtraderPosition *position) {
   if (!portfolio || !arena || !position || !position->code) {
     return false;
   }
 
-  SamtraderPosition *pos = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderPosition);
-  if (!pos) {
+  SamtraderSymbolId symbol = samtrader_portfolio_intern(portfolio, position->code);
+  PositionSlot *slot = slot_at(portfolio, symbol);
+  if (!slot) {
     return false;
   }
 
-  *pos = *position;
-
-  /* Copy code string into arena */
-  size_t code_len = strlen(position->code) + 1;
-  char *code_copy = (char *)samrena_push(arena, code_len);
-  if (!code_copy) {
-    return false;
+  const char *exchange = NULL;
+  if (position->exchange) {
+    SamtraderSymbolId exchange_id =
+        samtrader_symbol_intern(portfolio->exchanges, position->exchange);
+    exchange = samtrader_symbol_name(portfolio->exchanges, exchange_id);
+    if (!exchange) {
+      return false;
+    }
   }
-  memcpy(code_copy, position->code, code_len);
-  pos->code = code_copy;
 
-  /* Copy exchange string into arena if set */
-  if (position->exchange) {
-    size_t exchange_len = strlen(position->exchange) + 1;
-    char *exchange_copy = (char *)samrena_push(arena, exchange_len);
-    if (!exchange_copy) {
+  double below;
+  double above;
+  double stop;
+  exit_levels(position, &below, &above, &stop);
+
+  if (slot->open_index == SLOT_FLAT) {
+    size_t open_count = samrena_vector_size(portfolio->open_symbols);
+    if (!samrena_vector_push(portfolio->open_symbols, &symbol)) {
+      return false;
+    }
+    if (!samrena_vector_push(portfolio->exit_below, &below)) {
+      samrena_vector_pop(portfolio->open_symbols);
+      return false;
+    }
+    if (!samrena_vector_push(portfolio->exit_above, &above)) {
+      samrena_vector_pop(portfolio->exit_below);
+      samrena_vector_pop(portfolio->open_symbols);
       return false;
     }
-    memcpy(exchange_copy, position->exchange, exchange_len);
-    pos->exchange = exchange_copy;
+    if (!samrena_vector_push(portfolio->exit_stop, &stop)) {
+      samrena_vector_pop(portfolio->exit_above);
+      samrena_vector_pop(portfolio->exit_below);
+      samrena_vector_pop(portfolio->open_symbols);
+      return false;
+    }
+    slot->open_index = open_count;
+  } else {
+    ((double *)portfolio->exit_below->data)[slot->open_index] = below;
+    ((double *)portfolio->exit_above->data)[slot->open_index] = above;
+    ((double *)portfolio->exit_stop->data)[slot->open_index] = stop;
   }
 
-  return samhashmap_put(portfolio->positions, pos->code, pos);
+  slot->position = *position;
+  slot->position.code = samtrader_symbol_name(portfolio->symbols, symbol);
+  slot->position.exchange = exchange;
+  slot->position.symbol = symbol;
+  return true;
+}
+
+SamtraderPosition *samtrader_portfolio_position_at(const SamtraderPortfolio *portfolio,
+                                                   SamtraderSymbolId symbol) {
+  if (!portfolio) {
+    return NULL;
+  }
+
+  PositionSlot *slot = slot_at(portfolio, symbol);
+  if (!slot || slot->open_index == SLOT_FLAT) {
+    return NULL;
+  }
+  return &slot->position;
 }
 
 SamtraderPosition *samtrader_portfolio_get_position(const SamtraderPortfolio *portfolio,
@@ -91,15 +202,43 @@ SamtraderPosition *samtrader_portfolio_get_position(const SamtraderPortfolio *po
     return NULL;
   }
 
-  return (SamtraderPosition *)samhashmap_get(portfolio->positions, code);
+  return samtrader_portfolio_position_at(portfolio,
+                                         samtrader_symbol_find(portfolio->symbols, code));
 }
 
 bool samtrader_portfolio_has_position(const SamtraderPortfolio *portfolio, const char *code) {
-  if (!portfolio || !code) {
+  return samtrader_portfolio_get_position(portfolio, code) != NULL;
+}
+
+bool samtrader_portfolio_close_position(SamtraderPortfolio *portfolio, SamtraderSymbolId symbol) {
+  if (!portfolio) {
     return false;
   }
 
-  return samhashmap_contains(portfolio->positions, code);
+  PositionSlot *slot = slot_at(portfolio, symbol);
+  if (!slot || slot->open_index == SLOT_FLAT) {
+    return false;
+  }
+
+  /* Move the last open symbol (and its exit levels) into the vacated place */
+  SamtraderSymbolId *open = (SamtraderSymbolId *)portfolio->open_symbols->data;
+  double *below = (double *)portfolio->exit_below->data;
+  double *above = (double *)portfolio->exit_above->data;
+  double *stop = (double *)portfolio->exit_stop->data;
+  size_t last = samrena_vector_size(portfolio->open_symbols) - 1;
+  if (slot->open_index != last) {
+    open[slot->open_index] = open[last];
+    below[slot->open_index] = below[last];
+    above[slot->open_index] = above[last];
+    stop[slot->open_index] = stop[last];
+    slot_at(portfolio, open[last])->open_index = slot->open_index;
+  }
+  samrena_vector_pop(portfolio->open_symbols);
+  samrena_vector_pop(portfolio->exit_below);
+  samrena_vector_pop(portfolio->exit_above);
+  samrena_vector_pop(portfolio->exit_stop);
+  slot->open_index = SLOT_FLAT;
+  return true;
 }
 
 bool samtrader_portfolio_remove_position(SamtraderPortfolio *portfolio, const char *code) {
@@ -107,7 +246,8 @@ bool samtrader_portfolio_remove_position(SamtraderPortfolio *portfolio, const ch
     return false;
   }
 
-  return samhashmap_remove(portfolio->positions, code);
+  return samtrader_portfolio_close_position(portfolio,
+                                            samtrader_symbol_find(portfolio->symbols, code));
 }
 
 size_t samtrader_portfolio_position_count(const SamtraderPortfolio *portfolio) {
@@ -115,7 +255,7 @@ size_t samtrader_portfolio_position_count(const SamtraderPortfolio *portfolio) {
     return 0;
   }
 
-  return samhashmap_size(portfolio->positions);
+  return samrena_vector_size(portfolio->open_symbols);
 }
 
 bool samtrader_portfolio_record_trade(SamtraderPortfolio *portfolio, Samrena *arena,
@@ -126,26 +266,28 @@ bool samtrader_portfolio_record_trade(SamtraderPortfolio *portfolio, Samrena *ar
 
   SamtraderClosedTrade record = *trade;
 
-  /* Copy code string into arena if set */
-  if (trade->code) {
-    size_t code_len = strlen(trade->code) + 1;
-    char *code_copy = (char *)samrena_push(arena, code_len);
-    if (!code_copy) {
-      return false;
+  /* Point at interned strings instead of copying them for every trade */
+  const char *code = samtrader_symbol_name(portfolio->symbols, trade->symbol);
+  if (!code || (trade->code && trade->code != code && strcmp(code, trade->code) != 0)) {
+    record.symbol = SAMTRADER_SYMBOL_NONE;
+    record.code = NULL;
+    if (trade->code) {
+      record.symbol = samtrader_portfolio_intern(portfolio, trade->code);
+      record.code = samtrader_symbol_name(portfolio->symbols, record.symbol);
+      if (!record.code) {
+        return false;
+      }
     }
-    memcpy(code_copy, trade->code, code_len);
-    record.code = code_copy;
+  } else {
+    record.code = code;
   }
 
-  /* Copy exchange string into arena if set */
   if (trade->exchange) {
-    size_t exchange_len = strlen(trade->exchange) + 1;
-    char *exchange_copy = (char *)samrena_push(arena, exchange_len);
-    if (!exchange_copy) {
+    SamtraderSymbolId exchange_id = samtrader_symbol_intern(portfolio->exchanges, trade->exchange);
+    record.exchange = samtrader_symbol_name(portfolio->exchanges, exchange_id);
+    if (!record.exchange) {
       return false;
     }
-    memcpy(exchange_copy, trade->exchange, exchange_len);
-    record.exchange = exchange_copy;
   }
 
   return samrena_vector_push(portfolio->closed_trades, &record) != NULL;
@@ -162,32 +304,159 @@ bool samtrader_portfolio_record_equity(SamtraderPortfolio *portfolio, Samrena *a
   return samrena_vector_push(portfolio->equity_curve, &point) != NULL;
 }
 
-typedef struct {
-  double total_value;
-  const SamHashMap *price_map;
-} EquityIterCtx;
+double samtrader_portfolio_total_equity(const SamtraderPortfolio *portfolio,
+                                        const SamHashMap *price_map) {
+  if (!portfolio || !price_map) {
+    return -1.0;
+  }
 
-static void equity_position_iterator(const char *key, void *value, void *user_data) {
-  (void)key;
-  EquityIterCtx *ctx = (EquityIterCtx *)user_data;
-  SamtraderPosition *pos = (SamtraderPosition *)value;
+  double total_value = 0.0;
+  size_t open_count = samrena_vector_size(portfolio->open_symbols);
+  const SamtraderSymbolId *open = (const SamtraderSymbolId *)portfolio->open_symbols->data;
+  for (size_t i = 0; i < open_count; i++) {
+    const SamtraderPosition *pos = samtrader_portfolio_position_at(portfolio, open[i]);
+    double *price = (double *)samhashmap_get(price_map, pos->code);
+    if (price) {
+      int64_t abs_qty = pos->quantity >= 0 ? pos->quantity : -pos->quantity;
+      total_value += (double)abs_qty * (*price);
+    }
+  }
+
+  return portfolio->cash + total_value;
+}
 
-  double *price = (double *)samhashmap_get(ctx->price_map, pos->code);
-  if (price) {
-    int64_t abs_qty = pos->quantity >= 0 ? pos->quantity : -pos->quantity;
-    ctx->total_value += (double)abs_qty * (*price);
+size_t samtrader_portfolio_find_triggers(const SamtraderPortfolio *portfolio,
+                                         const double *open_prices, size_t *hits) {
+  if (!portfolio || !open_prices || !hits) {
+    return 0;
+  }
+
+  size_t open_count = samrena_vector_size(portfolio->open_symbols);
+  const double *below = (const double *)portfolio->exit_below->data;
+  const double *above = (const double *)portfolio->exit_above->data;
+
+  /* Branch-free compaction: every index is written, only hits advance */
+  size_t hit_count = 0;
+  for (size_t i = 0; i < open_count; i++) {
+    double price = open_prices[i];
+    hits[hit_count] = i;
+    hit_count += (size_t)((price <= below[i]) | (price >= above[i]));
   }
+  return hit_count;
 }
 
-double samtrader_portfolio_total_equity(const SamtraderPortfolio *portfolio,
-                                        const SamHashMap *price_map) {
-  if (!portfolio || !price_map) {
-    return -1.0;
+size_t samtrader_portfolio_find_triggers_ohlc(const SamtraderPortfolio *portfolio,
+                                              const double *open, const double *high,
+                                              const double *low, size_t *hits, double *fills) {
+  if (!portfolio || !open || !high || !low || !hits || !fills) {
+    return 0;
+  }
+
+  size_t open_count = samrena_vector_size(portfolio->open_symbols);
+  const double *below = (const double *)portfolio->exit_below->data;
+  const double *above = (const double *)portfolio->exit_above->data;
+  const double *stop = (const double *)portfolio->exit_stop->data;
+
+  /* Selects rather than branches, so the pass stays a straight line per position */
+  size_t hit_count = 0;
+  for (size_t i = 0; i < open_count; i++) {
+    int gapped = (open[i] <= below[i]) | (open[i] >= above[i]);
+    int reached_below = low[i] <= below[i];
+    int reached_above = high[i] >= above[i];
+    double touched = reached_below & reached_above ? stop[i] : reached_below ? below[i] : above[i];
+    hits[hit_count] = i;
+    fills[hit_count] = gapped ? open[i] : touched;
+    hit_count += (size_t)(gapped | reached_below | reached_above);
+  }
+  return hit_count;
+}
+
+static double *unset_prices(Samrena *arena, size_t count) {
+  double *prices = SAMRENA_PUSH_ARRAY(arena, double, count);
+  if (prices) {
+    for (size_t i = 0; i < count; i++) {
+      prices[i] = NAN;
+    }
+  }
+  return prices;
+}
+
+SamtraderPriceTable *samtrader_price_table_create(Samrena *arena,
+                                                  const SamtraderSymbolTable *symbols) {
+  if (!arena || !symbols) {
+    return NULL;
+  }
+
+  SamtraderPriceTable *table = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderPriceTable);
+  if (!table) {
+    return NULL;
+  }
+
+  table->symbols = symbols;
+  table->count = samtrader_symbol_table_count(symbols) + 1;
+  table->prices = unset_prices(arena, table->count);
+  if (!table->prices) {
+    return NULL;
   }
 
-  EquityIterCtx ctx = {.total_value = 0.0, .price_map = price_map};
+  return table;
+}
+
+SamtraderPriceTable *samtrader_price_table_create_ohlc(Samrena *arena,
+                                                       const SamtraderSymbolTable *symbols) {
+  SamtraderPriceTable *table = samtrader_price_table_create(arena, symbols);
+  if (!table) {
+    return NULL;
+  }
 
-  samhashmap_foreach(portfolio->positions, equity_position_iterator, &ctx);
+  table->open = unset_prices(arena, table->count);
+  table->high = unset_prices(arena, table->count);
+  table->low = unset_prices(arena, table->count);
+  if (!table->open || !table->high || !table->low) {
+    return NULL;
+  }
+
+  return table;
+}
+
+bool samtrader_price_table_get_symbol(const SamtraderPriceTable *table, SamtraderSymbolId symbol,
+                                      double *out) {
+  if (!table || symbol == SAMTRADER_SYMBOL_NONE || symbol >= table->count ||
+      isnan(table->prices[symbol])) {
+    return false;
+  }
+
+  if (out) {
+    *out = table->prices[symbol];
+  }
+  return true;
+}
+
+bool samtrader_price_table_get(const SamtraderPriceTable *table, const char *code, double *out) {
+  if (!table || !code) {
+    return false;
+  }
+
+  return samtrader_price_table_get_symbol(table, samtrader_symbol_find(table->symbols, code), out);
+}
+
+double samtrader_portfolio_total_equity_at(const SamtraderPortfolio *portfolio,
+                                           const SamtraderPriceTable *prices) {
+  if (!portfolio || !prices || prices->symbols != portfolio->symbols) {
+    return -1.0;
+  }
+
+  double total_value = 0.0;
+  size_t open_count = samrena_vector_size(portfolio->open_symbols);
+  const SamtraderSymbolId *open = (const SamtraderSymbolId *)portfolio->open_symbols->data;
+  for (size_t i = 0; i < open_count; i++) {
+    double price;
+    if (samtrader_price_table_get_symbol(prices, open[i], &price)) {
+      const SamtraderPosition *pos = samtrader_portfolio_position_at(portfolio, open[i]);
+      int64_t abs_qty = pos->quantity >= 0 ? pos->quantity : -pos->quantity;
+      total_value += (double)abs_qty * price;
+    }
+  }
 
-  return portfolio->cash + ctx.total_value;
+  return portfolio->cash + total_value;
 }
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "samtrader/domain/resample.h"
+
+#include <stdlib.h>
+
+bool samtrader_bar_interval_parse(const char *text, int64_t *seconds) {
+  if (!text || !seconds) {
+    return false;
+  }
+
+  char *unit = NULL;
+  long long count = strtoll(text, &unit, 10);
+  if (unit == text || count <= 0 || unit[0] == '\0' || unit[1] != '\0') {
+    return false;
+  }
+
+  int64_t scale;
+  switch (unit[0]) {
+    case 'm':
+      scale = 60;
+      break;
+    case 'h':
+      scale = 3600;
+      break;
+    case 'd':
+      scale = SAMTRADER_SECONDS_PER_DAY;
+      break;
+    default:
+      return false;
+  }
+
+  if (count > INT64_MAX / scale) {
+    return false;
+  }
+  *seconds = (int64_t)count * scale;
+  return true;
+}
+
+/* Start of the period-wide bucket holding date (floor, also before 1970) */
+static time_t bucket_start(time_t date, int64_t period) {
+  int64_t t = (int64_t)date;
+  int64_t r = t % period;
+  return (time_t)(r < 0 ? t - r - period : t - r);
+}
+
+void samtrader_resampler_init(SamtraderResampler *resampler, int64_t period) {
+  if (!resampler) {
+    return;
+  }
+  *resampler = (SamtraderResampler){.period = period > 0 ? period : 1};
+}
+
+bool samtrader_resampler_push(SamtraderResampler *resampler, const SamtraderOhlcv *bar,
+                              SamtraderOhlcv *out) {
+  if (!resampler || !bar) {
+    return false;
+  }
+
+  time_t start = bucket_start(bar->date, resampler->period);
+  SamtraderOhlcv *agg = &resampler->bar;
+  if (resampler->pending && agg->date == start) {
+    if (bar->high > agg->high)
+      agg->high = bar->high;
+    if (bar->low < agg->low)
+      agg->low = bar->low;
+    agg->close = bar->close;
+    agg->volume += bar->volume;
+    return false;
+  }
+
+  bool emitted = false;
+  if (resampler->pending && out) {
+    *out = *agg;
+    emitted = true;
+  }
+  *agg = *bar;
+  agg->date = start;
+  resampler->pending = true;
+  return emitted;
+}
+
+bool samtrader_resampler_flush(SamtraderResampler *resampler, SamtraderOhlcv *out) {
+  if (!resampler || !resampler->pending) {
+    return false;
+  }
+
+  resampler->pending = false;
+  if (!out) {
+    return false;
+  }
+  *out = resampler->bar;
+  return true;
+}
+
+SamrenaVector *samtrader_ohlcv_resample(Samrena *arena, const SamrenaVector *ohlcv,
+                                        int64_t period) {
+  if (!arena || !ohlcv || period <= 0) {
+    return NULL;
+  }
+
+  size_t count = samrena_vector_size(ohlcv);
+  const SamtraderOhlcv *bars = (const SamtraderOhlcv *)ohlcv->data;
+
+  /* Size the output from the span covered so it is allocated once */
+  uint64_t capacity = 1;
+  if (count > 0) {
+    int64_t span = ((int64_t)bars[count - 1].date - (int64_t)bars[0].date) / period + 2;
+    capacity = span > 0 && (uint64_t)span < count ? (uint64_t)span : count;
+  }
+  SamrenaVector *out = samtrader_ohlcv_vector_create(arena, capacity);
+  if (!out) {
+    return NULL;
+  }
+
+  SamtraderResampler resampler;
+  samtrader_resampler_init(&resampler, period);
+  SamtraderOhlcv bar;
+  for (size_t i = 0; i < count; i++) {
+    if (samtrader_resampler_push(&resampler, &bars[i], &bar) && !samrena_vector_push(out, &bar)) {
+      return NULL;
+    }
+  }
+  if (samtrader_resampler_flush(&resampler, &bar) && !samrena_vector_push(out, &bar)) {
+    return NULL;
+  }
+
+  return out;
+}
+
+SamtraderBarColumns *samtrader_bar_columns_resample(Samrena *arena, const SamtraderBarColumns *bars,
+                                                    int64_t period) {
+  if (!arena || !bars || period <= 0) {
+    return NULL;
+  }
+
+  size_t buckets = 0;
+  for (size_t i = 0; i < bars->count; i++) {
+    if (i == 0 || bucket_start(bars->date[i], period) != bucket_start(bars->date[i - 1], period)) {
+      buckets++;
+    }
+  }
+
+  SamtraderBarColumns *out =
+      samtrader_bar_columns_create(arena, bars->code, bars->exchange, buckets);
+  if (!out) {
+    return NULL;
+  }
+
+  SamtraderResampler resampler;
+  samtrader_resampler_init(&resampler, period);
+  SamtraderOhlcv bar;
+  size_t n = 0;
+  for (size_t i = 0; i <= bars->count; i++) {
+    bool emitted;
+    if (i < bars->count) {
+      SamtraderOhlcv in = {.date = bars->date[i],
+                           .open = bars->open[i],
+                           .high = bars->high[i],
+                           .low = bars->low[i],
+                           .close = bars->close[i],
+                           .volume = bars->volume[i]};
+      emitted = samtrader_resampler_push(&resampler, &in, &bar);
+    } else {
+      emitted = samtrader_resampler_flush(&resampler, &bar);
+    }
+    if (emitted) {
+      out->date[n] = bar.date;
+      out->open[n] = bar.open;
+      out->high[n] = bar.high;
+      out->low[n] = bar.low;
+      out->close[n] = bar.close;
+      out->volume[n] = bar.volume;
+      n++;
+    }
+  }
+
+  return out;
+}
@@ -72,78 +72,73 @@ int samtrader_operand_indicator_key(char *buf, size_t buf_size, const SamtraderO
   return -1;
 }
 
-/*============================================================================
- * Operand Resolution
- *============================================================================*/
-
-static bool resolve_indicator(const SamtraderOperand *op, const SamHashMap *indicators,
-                              size_t index, double *out) {
-  char key[64];
-  if (samtrader_operand_indicator_key(key, sizeof(key), op) < 0) {
-    return false;
-  }
-
-  SamtraderIndicatorSeries *series = (SamtraderIndicatorSeries *)samhashmap_get(indicators, key);
-  if (!series) {
-    return false;
-  }
-
-  const SamtraderIndicatorValue *val = samtrader_indicator_series_at(series, index);
-  if (!val || !val->valid) {
-    return false;
+int samtrader_operand_indicator_column(const SamtraderOperand *operand) {
+  if (!operand || operand->type != SAMTRADER_OPERAND_INDICATOR) {
+    return -1;
   }
 
-  switch (op->indicator.indicator_type) {
+  switch (operand->indicator.indicator_type) {
     case SAMTRADER_IND_BOLLINGER:
-      switch (op->indicator.param3) {
+      switch (operand->indicator.param3) {
         case SAMTRADER_BOLLINGER_UPPER:
-          *out = val->data.bollinger.upper;
-          return true;
+          return SAMTRADER_COLUMN_BOLLINGER_UPPER;
         case SAMTRADER_BOLLINGER_MIDDLE:
-          *out = val->data.bollinger.middle;
-          return true;
+          return SAMTRADER_COLUMN_BOLLINGER_MIDDLE;
         case SAMTRADER_BOLLINGER_LOWER:
-          *out = val->data.bollinger.lower;
-          return true;
+          return SAMTRADER_COLUMN_BOLLINGER_LOWER;
         default:
-          return false;
+          return -1;
       }
     case SAMTRADER_IND_MACD:
-      *out = val->data.macd.line;
-      return true;
+      return SAMTRADER_COLUMN_MACD_LINE;
     case SAMTRADER_IND_STOCHASTIC:
-      *out = val->data.stochastic.k;
-      return true;
+      return SAMTRADER_COLUMN_STOCHASTIC_K;
     case SAMTRADER_IND_PIVOT:
-      switch (op->indicator.param2) {
+      switch (operand->indicator.param2) {
         case SAMTRADER_PIVOT_PIVOT:
-          *out = val->data.pivot.pivot;
-          return true;
+          return SAMTRADER_COLUMN_PIVOT;
         case SAMTRADER_PIVOT_R1:
-          *out = val->data.pivot.r1;
-          return true;
+          return SAMTRADER_COLUMN_PIVOT_R1;
         case SAMTRADER_PIVOT_R2:
-          *out = val->data.pivot.r2;
-          return true;
+          return SAMTRADER_COLUMN_PIVOT_R2;
         case SAMTRADER_PIVOT_R3:
-          *out = val->data.pivot.r3;
-          return true;
+          return SAMTRADER_COLUMN_PIVOT_R3;
         case SAMTRADER_PIVOT_S1:
-          *out = val->data.pivot.s1;
-          return true;
+          return SAMTRADER_COLUMN_PIVOT_S1;
         case SAMTRADER_PIVOT_S2:
-          *out = val->data.pivot.s2;
-          return true;
+          return SAMTRADER_COLUMN_PIVOT_S2;
         case SAMTRADER_PIVOT_S3:
-          *out = val->data.pivot.s3;
-          return true;
+          return SAMTRADER_COLUMN_PIVOT_S3;
         default:
-          return false;
+          return -1;
       }
     default:
-      *out = val->data.simple.value;
-      return true;
+      return SAMTRADER_COLUMN_VALUE;
+  }
+}
+
+/*============================================================================
+ * Operand Resolution
+ *============================================================================*/
+
+static bool resolve_indicator(const SamtraderOperand *op, const SamHashMap *indicators,
+                              size_t index, double *out) {
+  char key[64];
+  if (samtrader_operand_indicator_key(key, sizeof(key), op) < 0) {
+    return false;
   }
+
+  SamtraderIndicatorSeries *series = (SamtraderIndicatorSeries *)samhashmap_get(indicators, key);
+  int column = samtrader_operand_indicator_column(op);
+  if (!series || column < 0 || (size_t)column >= series->column_count) {
+    return false;
+  }
+  if (index >= series->size || index < series->valid_from) {
+    return false;
+  }
+
+  *out = series->columns[column][index];
+  return true;
 }
 
 static bool resolve_operand(const SamtraderOperand *op, const SamrenaVector *ohlcv,
@@ -0,0 +1,754 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "samtrader/domain/rule_program.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "samtrader/domain/indicator.h"
+#include "samtrader/domain/ohlcv.h"
+
+#define EQUALS_TOLERANCE 1e-9
+#define INDICATOR_KEY_BUF_SIZE 64
+
+/*============================================================================
+ * Program Representation
+ *============================================================================*/
+
+typedef enum {
+  SLOT_NONE,     /* Operand can never be resolved (missing series, bad selector) */
+  SLOT_CONSTANT, /* Literal value */
+  SLOT_PRICE,    /* double price column */
+  SLOT_VOLUME,   /* int64_t volume column */
+  SLOT_INDICATOR /* double indicator column, valid from valid_from onwards */
+} SlotKind;
+
+typedef struct {
+  SlotKind kind;
+  double constant;
+  const void *column; /* Element 0 of the operand's column */
+  size_t count;       /* Number of elements */
+  size_t valid_from;  /* First valid indicator element */
+} OperandSlot;
+
+typedef enum {
+  OP_FALSE,
+  OP_ABOVE,
+  OP_BELOW,
+  OP_EQUALS,
+  OP_BETWEEN,
+  OP_CROSS_ABOVE,
+  OP_CROSS_BELOW,
+  OP_AND,
+  OP_OR,
+  OP_NOT,
+  OP_CONSECUTIVE,
+  OP_ANY_OF
+} RuleOp;
+
+/*
+ * Operand meaning depends on op:
+ *   comparisons:        a = left slot, b = right slot
+ *   AND / OR:           a = first entry in child table, b = child count
+ *   NOT / temporal:     a = child instruction
+ */
+typedef struct {
+  RuleOp op;
+  uint32_t a;
+  uint32_t b;
+  int lookback;
+  double threshold;
+} RuleInstr;
+
+struct SamtraderRuleProgram {
+  RuleInstr *instrs;
+  uint32_t *children;
+  OperandSlot *slots;
+  uint32_t instr_count;
+  uint32_t child_count;
+  uint32_t slot_count;
+  uint32_t root;
+  size_t bar_count; /* OHLCV bars of the code compiled against */
+};
+
+/*============================================================================
+ * Compilation
+ *============================================================================*/
+
+typedef struct {
+  SamtraderRuleProgram *program;
+  const SamtraderCodeData *code_data;
+  const SamtraderOperand **slot_sources; /* Operand each slot was built from (for dedup) */
+} CompileCtx;
+
+static void count_rule(const SamtraderRule *rule, uint32_t *instrs, uint32_t *children) {
+  (*instrs)++;
+  if (!rule)
+    return;
+  switch (rule->type) {
+    case SAMTRADER_RULE_AND:
+    case SAMTRADER_RULE_OR:
+      if (rule->children) {
+        for (size_t i = 0; rule->children[i] != NULL; i++) {
+          (*children)++;
+          count_rule(rule->children[i], instrs, children);
+        }
+      }
+      break;
+    case SAMTRADER_RULE_NOT:
+    case SAMTRADER_RULE_CONSECUTIVE:
+    case SAMTRADER_RULE_ANY_OF:
+      if (rule->child)
+        count_rule(rule->child, instrs, children);
+      break;
+    default:
+      break;
+  }
+}
+
+static OperandSlot bind_operand(const SamtraderOperand *op, const SamtraderCodeData *code_data) {
+  OperandSlot slot = {.kind = SLOT_NONE};
+  const SamtraderBarColumns *bars = code_data->bars;
+
+  switch (op->type) {
+    case SAMTRADER_OPERAND_CONSTANT:
+      slot.kind = SLOT_CONSTANT;
+      slot.constant = op->constant;
+      return slot;
+
+    case SAMTRADER_OPERAND_PRICE_OPEN:
+    case SAMTRADER_OPERAND_PRICE_HIGH:
+    case SAMTRADER_OPERAND_PRICE_LOW:
+    case SAMTRADER_OPERAND_PRICE_CLOSE:
+    case SAMTRADER_OPERAND_VOLUME:
+      if (!bars)
+        return slot;
+      slot.kind = op->type == SAMTRADER_OPERAND_VOLUME ? SLOT_VOLUME : SLOT_PRICE;
+      switch (op->type) {
+        case SAMTRADER_OPERAND_PRICE_OPEN:
+          slot.column = bars->open;
+          break;
+        case SAMTRADER_OPERAND_PRICE_HIGH:
+          slot.column = bars->high;
+          break;
+        case SAMTRADER_OPERAND_PRICE_LOW:
+          slot.column = bars->low;
+          break;
+        case SAMTRADER_OPERAND_PRICE_CLOSE:
+          slot.column = bars->close;
+          break;
+        default:
+          slot.column = bars->volume;
+          break;
+      }
+      slot.count = bars->count;
+      return slot;
+
+    case SAMTRADER_OPERAND_INDICATOR: {
+      if (!code_data->indicators)
+        return slot;
+      char key[INDICATOR_KEY_BUF_SIZE];
+      if (samtrader_operand_indicator_key(key, sizeof(key), op) < 0)
+        return slot;
+      const SamtraderIndicatorSeries *series =
+          (const SamtraderIndicatorSeries *)samhashmap_get(code_data->indicators, key);
+      int column = samtrader_operand_indicator_column(op);
+      if (!series || column < 0 || (size_t)column >= series->column_count)
+        return slot;
+      slot.kind = SLOT_INDICATOR;
+      slot.column = series->columns[column];
+      slot.count = series->size;
+      slot.valid_from = series->valid_from;
+      return slot;
+    }
+  }
+
+  return slot;
+}
+
+static bool operands_equal(const SamtraderOperand *a, const SamtraderOperand *b) {
+  if (a->type != b->type)
+    return false;
+  switch (a->type) {
+    case SAMTRADER_OPERAND_CONSTANT:
+      return memcmp(&a->constant, &b->constant, sizeof(double)) == 0;
+    case SAMTRADER_OPERAND_INDICATOR:
+      return a->indicator.indicator_type == b->indicator.indicator_type &&
+             a->indicator.period == b->indicator.period &&
+             a->indicator.param2 == b->indicator.param2 &&
+             a->indicator.param3 == b->indicator.param3;
+    default:
+      return true;
+  }
+}
+
+static uint32_t intern_slot(CompileCtx *ctx, const SamtraderOperand *op) {
+  SamtraderRuleProgram *p = ctx->program;
+  for (uint32_t i = 0; i < p->slot_count; i++) {
+    if (operands_equal(ctx->slot_sources[i], op))
+      return i;
+  }
+  p->slots[p->slot_count] = bind_operand(op, ctx->code_data);
+  ctx->slot_sources[p->slot_count] = op;
+  return p->slot_count++;
+}
+
+static bool instrs_equal(const SamtraderRuleProgram *p, const RuleInstr *x, const RuleInstr *y) {
+  if (x->op != y->op || x->b != y->b || x->lookback != y->lookback ||
+      memcmp(&x->threshold, &y->threshold, sizeof(double)) != 0)
+    return false;
+  if (x->op == OP_AND || x->op == OP_OR)
+    return x->a == y->a ||
+           memcmp(&p->children[x->a], &p->children[y->a], x->b * sizeof(uint32_t)) == 0;
+  return x->a == y->a;
+}
+
+/*
+ * Return the index of an instruction identical to instr, appending it if
+ * there is none. Children are always interned before their parent, so
+ * identical subtrees end up with identical operands and compare equal
+ * without recursing.
+ */
+static uint32_t intern_instr(CompileCtx *ctx, const RuleInstr *instr) {
+  SamtraderRuleProgram *p = ctx->program;
+  for (uint32_t i = 0; i < p->instr_count; i++) {
+    if (instrs_equal(p, &p->instrs[i], instr))
+      return i;
+  }
+  p->instrs[p->instr_count] = *instr;
+  return p->instr_count++;
+}
+
+static uint32_t emit_rule(CompileCtx *ctx, const SamtraderRule *rule) {
+  SamtraderRuleProgram *p = ctx->program;
+  RuleInstr instr = {.op = OP_FALSE};
+
+  if (!rule)
+    return intern_instr(ctx, &instr);
+
+  switch (rule->type) {
+    case SAMTRADER_RULE_ABOVE:
+    case SAMTRADER_RULE_BELOW:
+    case SAMTRADER_RULE_EQUALS:
+    case SAMTRADER_RULE_BETWEEN:
+    case SAMTRADER_RULE_CROSS_ABOVE:
+    case SAMTRADER_RULE_CROSS_BELOW: {
+      static const RuleOp comparison_ops[] = {
+          [SAMTRADER_RULE_CROSS_ABOVE] = OP_CROSS_ABOVE,
+          [SAMTRADER_RULE_CROSS_BELOW] = OP_CROSS_BELOW,
+          [SAMTRADER_RULE_ABOVE] = OP_ABOVE,
+          [SAMTRADER_RULE_BELOW] = OP_BELOW,
+          [SAMTRADER_RULE_BETWEEN] = OP_BETWEEN,
+          [SAMTRADER_RULE_EQUALS] = OP_EQUALS,
+      };
+      instr.op = comparison_ops[rule->type];
+      instr.a = intern_slot(ctx, &rule->left);
+      instr.b = intern_slot(ctx, &rule->right);
+      /* Only BETWEEN reads the threshold; keep it out of other ops' identity */
+      if (rule->type == SAMTRADER_RULE_BETWEEN)
+        instr.threshold = rule->threshold;
+      break;
+    }
+
+    case SAMTRADER_RULE_AND:
+    case SAMTRADER_RULE_OR: {
+      if (!rule->children)
+        break;
+      size_t n = 0;
+      while (rule->children[n] != NULL)
+        n++;
+      /* Reserve the child table entries first so they stay contiguous */
+      uint32_t first = p->child_count;
+      p->child_count += (uint32_t)n;
+      for (size_t i = 0; i < n; i++) {
+        uint32_t child = emit_rule(ctx, rule->children[i]);
+        p->children[first + i] = child;
+      }
+      instr.op = rule->type == SAMTRADER_RULE_AND ? OP_AND : OP_OR;
+      instr.a = first;
+      instr.b = (uint32_t)n;
+      break;
+    }
+
+    case SAMTRADER_RULE_NOT:
+      if (!rule->child)
+        break;
+      instr.op = OP_NOT;
+      instr.a = emit_rule(ctx, rule->child);
+      break;
+
+    case SAMTRADER_RULE_CONSECUTIVE:
+    case SAMTRADER_RULE_ANY_OF:
+      if (!rule->child || rule->lookback <= 0)
+        break;
+      instr.op = rule->type == SAMTRADER_RULE_CONSECUTIVE ? OP_CONSECUTIVE : OP_ANY_OF;
+      instr.a = emit_rule(ctx, rule->child);
+      instr.lookback = rule->lookback;
+      break;
+  }
+
+  return intern_instr(ctx, &instr);
+}
+
+/*
+ * Compile count rules into one program with shared instruction, child and
+ * slot tables. roots[i] receives the instruction of rules[i]; the
+ * program's own root is that of the last rule.
+ */
+static SamtraderRuleProgram *compile_rules(Samrena *arena, const SamtraderRule *const *rules,
+                                           size_t count, const SamtraderCodeData *code_data,
+                                           uint32_t *roots) {
+  SamtraderRuleProgram *program = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderRuleProgram);
+  if (!program)
+    return NULL;
+
+  /* No price data: the tree walk rejects every evaluation, so does the program */
+  uint32_t max_instrs = 0;
+  uint32_t max_children = 0;
+  for (size_t i = 0; i < count; i++)
+    count_rule(code_data->bars ? rules[i] : NULL, &max_instrs, &max_children);
+  uint32_t max_slots = max_instrs * 2;
+
+  program->instrs = SAMRENA_PUSH_ARRAY_ZERO(arena, RuleInstr, max_instrs);
+  program->children = max_children > 0 ? SAMRENA_PUSH_ARRAY(arena, uint32_t, max_children) : NULL;
+  program->slots = SAMRENA_PUSH_ARRAY_ZERO(arena, OperandSlot, max_slots);
+  const SamtraderOperand **sources = SAMRENA_PUSH_ARRAY(arena, const SamtraderOperand *, max_slots);
+  if (!program->instrs || !program->slots || !sources || (max_children > 0 && !program->children))
+    return NULL;
+
+  CompileCtx ctx = {.program = program, .code_data = code_data, .slot_sources = sources};
+  for (size_t i = 0; i < count; i++)
+    roots[i] = emit_rule(&ctx, code_data->bars ? rules[i] : NULL);
+  program->root = roots[count - 1];
+  program->bar_count = code_data->bars ? code_data->bars->count : 0;
+  return program;
+}
+
+SamtraderRuleProgram *samtrader_rule_compile(Samrena *arena, const SamtraderRule *rule,
+                                             const SamtraderCodeData *code_data) {
+  if (!arena || !code_data)
+    return NULL;
+  uint32_t root;
+  return compile_rules(arena, &rule, 1, code_data, &root);
+}
+
+/*============================================================================
+ * Evaluation
+ *============================================================================*/
+
+static inline bool resolve_slot(const OperandSlot *slot, size_t index, double *out) {
+  switch (slot->kind) {
+    case SLOT_CONSTANT:
+      *out = slot->constant;
+      return true;
+    case SLOT_PRICE:
+      if (index >= slot->count)
+        return false;
+      *out = ((const double *)slot->column)[index];
+      return true;
+    case SLOT_VOLUME:
+      if (index >= slot->count)
+        return false;
+      *out = (double)((const int64_t *)slot->column)[index];
+      return true;
+    case SLOT_INDICATOR: {
+      if (index >= slot->count || index < slot->valid_from)
+        return false;
+      *out = ((const double *)slot->column)[index];
+      return true;
+    }
+    case SLOT_NONE:
+      return false;
+  }
+  return false;
+}
+
+static bool eval_instr(const SamtraderRuleProgram *p, uint32_t idx, size_t index) {
+  const RuleInstr *instr = &p->instrs[idx];
+  const OperandSlot *left = &p->slots[instr->a];
+  const OperandSlot *right = &p->slots[instr->b];
+  double l, r;
+
+  switch (instr->op) {
+    case OP_FALSE:
+      return false;
+
+    case OP_ABOVE:
+      return resolve_slot(left, index, &l) && resolve_slot(right, index, &r) && l > r;
+
+    case OP_BELOW:
+      return resolve_slot(left, index, &l) && resolve_slot(right, index, &r) && l < r;
+
+    case OP_EQUALS:
+      return resolve_slot(left, index, &l) && resolve_slot(right, index, &r) &&
+             fabs(l - r) <= EQUALS_TOLERANCE;
+
+    case OP_BETWEEN:
+      return resolve_slot(left, index, &l) && resolve_slot(right, index, &r) && l >= r &&
+             l <= instr->threshold;
+
+    case OP_CROSS_ABOVE:
+    case OP_CROSS_BELOW: {
+      if (index == 0)
+        return false;
+      double pl, pr;
+      if (!resolve_slot(left, index, &l) || !resolve_slot(right, index, &r) ||
+          !resolve_slot(left, index - 1, &pl) || !resolve_slot(right, index - 1, &pr))
+        return false;
+      if (instr->op == OP_CROSS_ABOVE)
+        return pl <= pr && l > r;
+      return pl >= pr && l < r;
+    }
+
+    case OP_AND:
+      for (uint32_t i = 0; i < instr->b; i++) {
+        if (!eval_instr(p, p->children[instr->a + i], index))
+          return false;
+      }
+      return true;
+
+    case OP_OR:
+      for (uint32_t i = 0; i < instr->b; i++) {
+        if (eval_instr(p, p->children[instr->a + i], index))
+          return true;
+      }
+      return false;
+
+    case OP_NOT:
+      return !eval_instr(p, instr->a, index);
+
+    case OP_CONSECUTIVE:
+    case OP_ANY_OF: {
+      size_t span = (size_t)(instr->lookback - 1);
+      if (index < span)
+        return false;
+      bool want = instr->op == OP_ANY_OF;
+      for (size_t i = index - span; i <= index; i++) {
+        if (eval_instr(p, instr->a, i) == want)
+          return want;
+      }
+      return !want;
+    }
+  }
+
+  return false;
+}
+
+bool samtrader_rule_program_evaluate(const SamtraderRuleProgram *program, size_t index) {
+  if (!program || program->instr_count == 0)
+    return false;
+  return eval_instr(program, program->root, index);
+}
+
+size_t samtrader_rule_program_size(const SamtraderRuleProgram *program) {
+  return program ? program->instr_count : 0;
+}
+
+/*============================================================================
+ * Whole-Series Evaluation
+ *============================================================================*/
+
+#define SIGNAL_WORD_BITS 64
+
+/* Pack cond, evaluated with i = each bar index, into 64-bar words of out */
+#define PACK_SIGNALS(out, bars, cond)                                                              \
+  for (size_t word_ = 0, base_ = 0; base_ < (bars); word_++, base_ += SIGNAL_WORD_BITS) {         \
+    size_t end_ = (bars) - base_ < SIGNAL_WORD_BITS ? (bars) - base_ : SIGNAL_WORD_BITS;           \
+    uint64_t bits_ = 0;                                                                            \
+    for (size_t k_ = 0; k_ < end_; k_++) {                                                         \
+      size_t i = base_ + k_;                                                                       \
+      bits_ |= (uint64_t)(cond) << k_;                                                             \
+    }                                                                                              \
+    (out)[word_] = bits_;                                                                          \
+  }
+
+static inline bool signal_bit(const uint64_t *bits, size_t index) {
+  return ((bits[index / SIGNAL_WORD_BITS] >> (index % SIGNAL_WORD_BITS)) & 1u) != 0;
+}
+
+/*
+ * An operand's value at every bar. Bars where the operand does not resolve
+ * hold NaN, which fails every comparison just as an unresolved operand
+ * fails it in eval_instr().
+ */
+static double *slot_column(Samrena *arena, const OperandSlot *slot, size_t bars) {
+  double *column = SAMRENA_PUSH_ARRAY(arena, double, bars);
+  if (!column)
+    return NULL;
+  size_t n = slot->kind == SLOT_CONSTANT ? bars : slot->count < bars ? slot->count : bars;
+
+  /* One loop per kind so each stays branch-free */
+  switch (slot->kind) {
+    case SLOT_CONSTANT:
+      for (size_t i = 0; i < n; i++)
+        column[i] = slot->constant;
+      break;
+    case SLOT_PRICE:
+      if (n > 0)
+        memcpy(column, slot->column, n * sizeof(double));
+      break;
+    case SLOT_VOLUME: {
+      const int64_t *volume = (const int64_t *)slot->column;
+      for (size_t i = 0; i < n; i++)
+        column[i] = (double)volume[i];
+      break;
+    }
+    case SLOT_INDICATOR: {
+      size_t first = slot->valid_from < n ? slot->valid_from : n;
+      for (size_t i = 0; i < first; i++)
+        column[i] = NAN;
+      if (n > first)
+        memcpy(column + first, (const double *)slot->column + first, (n - first) * sizeof(double));
+      break;
+    }
+    case SLOT_NONE:
+      n = 0;
+      break;
+  }
+  for (size_t i = n; i < bars; i++)
+    column[i] = NAN;
+  return column;
+}
+
+static void compare_columns(uint64_t *out, const RuleInstr *instr, const double *l,
+                            const double *r, size_t bars) {
+  double threshold = instr->threshold;
+  switch (instr->op) {
+    case OP_ABOVE:
+      PACK_SIGNALS(out, bars, l[i] > r[i]);
+      break;
+    case OP_BELOW:
+      PACK_SIGNALS(out, bars, l[i] < r[i]);
+      break;
+    case OP_EQUALS:
+      PACK_SIGNALS(out, bars, fabs(l[i] - r[i]) <= EQUALS_TOLERANCE);
+      break;
+    case OP_BETWEEN:
+      PACK_SIGNALS(out, bars, l[i] >= r[i] && l[i] <= threshold);
+      break;
+    case OP_CROSS_ABOVE:
+      PACK_SIGNALS(out, bars, i > 0 && l[i - 1] <= r[i - 1] && l[i] > r[i]);
+      break;
+    case OP_CROSS_BELOW:
+      PACK_SIGNALS(out, bars, i > 0 && l[i - 1] >= r[i - 1] && l[i] < r[i]);
+      break;
+    default:
+      break;
+  }
+}
+
+/* CONSECUTIVE: the child held on each of the last lookback bars (one run-length pass) */
+static void consecutive_signals(uint64_t *out, const uint64_t *child, size_t lookback,
+                                size_t bars) {
+  size_t run = 0;
+  for (size_t i = 0; i < bars; i++) {
+    run = signal_bit(child, i) ? run + 1 : 0;
+    if (run >= lookback)
+      out[i / SIGNAL_WORD_BITS] |= (uint64_t)1 << (i % SIGNAL_WORD_BITS);
+  }
+}
+
+/* ANY_OF: the child held on any of the last lookback bars, from bar lookback - 1 on */
+static void any_of_signals(uint64_t *out, const uint64_t *child, size_t lookback, size_t bars) {
+  size_t since = SIZE_MAX; /* Bars since the child last held */
+  for (size_t i = 0; i < bars; i++) {
+    if (signal_bit(child, i))
+      since = 0;
+    else if (since != SIZE_MAX)
+      since++;
+    if (i + 1 >= lookback && since < lookback)
+      out[i / SIGNAL_WORD_BITS] |= (uint64_t)1 << (i % SIGNAL_WORD_BITS);
+  }
+}
+
+/*
+ * Evaluate instructions [0, instr_count) at every bar into one bitset of
+ * words each, allocated on arena (callers wrap this in a scratch frame).
+ * Children precede their parents, so one forward walk evaluates every
+ * shared node exactly once.
+ */
+static uint64_t *series_bitsets(Samrena *arena, const SamtraderRuleProgram *program,
+                                uint32_t instr_count, size_t words) {
+  size_t bars = program->bar_count;
+  uint64_t *bitsets = SAMRENA_PUSH_ARRAY_ZERO(arena, uint64_t, words * instr_count);
+  double **columns = SAMRENA_PUSH_ARRAY_ZERO(arena, double *, program->slot_count);
+  if (!bitsets || (program->slot_count > 0 && !columns))
+    return NULL;
+  for (uint32_t s = 0; s < program->slot_count; s++) {
+    columns[s] = slot_column(arena, &program->slots[s], bars);
+    if (!columns[s])
+      return NULL;
+  }
+
+  uint64_t tail_mask = bars % SIGNAL_WORD_BITS == 0
+                           ? ~(uint64_t)0
+                           : ((uint64_t)1 << (bars % SIGNAL_WORD_BITS)) - 1;
+
+  for (uint32_t idx = 0; idx < instr_count; idx++) {
+    const RuleInstr *instr = &program->instrs[idx];
+    uint64_t *bits = bitsets + (size_t)idx * words;
+
+    switch (instr->op) {
+      case OP_FALSE:
+        break;
+
+      case OP_ABOVE:
+      case OP_BELOW:
+      case OP_EQUALS:
+      case OP_BETWEEN:
+      case OP_CROSS_ABOVE:
+      case OP_CROSS_BELOW:
+        compare_columns(bits, instr, columns[instr->a], columns[instr->b], bars);
+        break;
+
+      case OP_AND:
+        memset(bits, 0xff, words * sizeof(uint64_t));
+        bits[words - 1] = tail_mask;
+        for (uint32_t c = 0; c < instr->b; c++) {
+          const uint64_t *child = bitsets + (size_t)program->children[instr->a + c] * words;
+          for (size_t w = 0; w < words; w++)
+            bits[w] &= child[w];
+        }
+        break;
+
+      case OP_OR:
+        for (uint32_t c = 0; c < instr->b; c++) {
+          const uint64_t *child = bitsets + (size_t)program->children[instr->a + c] * words;
+          for (size_t w = 0; w < words; w++)
+            bits[w] |= child[w];
+        }
+        break;
+
+      case OP_NOT: {
+        const uint64_t *child = bitsets + (size_t)instr->a * words;
+        for (size_t w = 0; w < words; w++)
+          bits[w] = ~child[w];
+        bits[words - 1] &= tail_mask;
+        break;
+      }
+
+      case OP_CONSECUTIVE:
+        consecutive_signals(bits, bitsets + (size_t)instr->a * words, (size_t)instr->lookback,
+                            bars);
+        break;
+
+      case OP_ANY_OF:
+        any_of_signals(bits, bitsets + (size_t)instr->a * words, (size_t)instr->lookback, bars);
+        break;
+    }
+  }
+  return bitsets;
+}
+
+int samtrader_rule_program_signals(Samrena *arena, const SamtraderRuleProgram *program,
+                                   SamtraderRuleSignals *out) {
+  if (!arena || !program || !out)
+    return -1;
+
+  size_t bars = program->bar_count;
+  size_t words = (bars + SIGNAL_WORD_BITS - 1) / SIGNAL_WORD_BITS;
+  out->bits = NULL;
+  out->bar_count = 0;
+  if (words == 0 || program->instr_count == 0)
+    return 0;
+
+  uint64_t *result = SAMRENA_PUSH_ARRAY(arena, uint64_t, words);
+  if (!result)
+    return -1;
+
+  /* Nothing past the root can feed it */
+  SamrenaScratch scratch = samrena_scratch_begin(arena);
+  uint64_t *bitsets = series_bitsets(arena, program, program->root + 1, words);
+  if (!bitsets) {
+    samrena_scratch_end(scratch);
+    return -1;
+  }
+  memcpy(result, bitsets + (size_t)program->root * words, words * sizeof(uint64_t));
+  samrena_scratch_end(scratch);
+
+  out->bits = result;
+  out->bar_count = bars;
+  return 0;
+}
+
+/*============================================================================
+ * Strategy Compilation
+ *============================================================================*/
+
+int samtrader_strategy_compile(Samrena *arena, const SamtraderStrategy *strategy,
+                               const SamtraderCodeData *code_data, SamtraderStrategyProgram *out) {
+  if (!arena || !strategy || !code_data || !out)
+    return -1;
+
+  memset(out, 0, sizeof(*out));
+
+  /* All four rules share one program, so common subrules compile once */
+  const SamtraderRule *rules[] = {strategy->entry_long, strategy->exit_long,
+                                  strategy->entry_short, strategy->exit_short};
+  SamtraderRuleProgram **programs[] = {&out->entry_long, &out->exit_long, &out->entry_short,
+                                       &out->exit_short};
+  SamtraderRuleSignals *signals[] = {&out->entry_long_signals, &out->exit_long_signals,
+                                     &out->entry_short_signals, &out->exit_short_signals};
+  uint32_t roots[4];
+  SamtraderRuleProgram *shared = compile_rules(arena, rules, 4, code_data, roots);
+  if (!shared)
+    return -1;
+
+  size_t bars = shared->bar_count;
+  size_t words = (bars + SIGNAL_WORD_BITS - 1) / SIGNAL_WORD_BITS;
+  uint32_t evaluated = 0;
+  for (size_t i = 0; i < 4; i++) {
+    /* Long rules are always compiled; short rules only when set */
+    if (i >= 2 && !rules[i])
+      continue;
+    /* Each rule gets a view of the shared tables rooted at its own instruction */
+    SamtraderRuleProgram *view = SAMRENA_PUSH_TYPE(arena, SamtraderRuleProgram);
+    if (!view)
+      return -1;
+    *view = *shared;
+    view->root = roots[i];
+    *programs[i] = view;
+    if (roots[i] >= evaluated)
+      evaluated = roots[i] + 1;
+
+    if (words > 0) {
+      signals[i]->bits = SAMRENA_PUSH_ARRAY(arena, uint64_t, words);
+      if (!signals[i]->bits)
+        return -1;
+      signals[i]->bar_count = bars;
+    }
+  }
+  if (words == 0)
+    return 0;
+
+  /* One whole-series pass over the shared instructions serves every rule */
+  SamrenaScratch scratch = samrena_scratch_begin(arena);
+  uint64_t *bitsets = series_bitsets(arena, shared, evaluated, words);
+  if (!bitsets) {
+    samrena_scratch_end(scratch);
+    return -1;
+  }
+  for (size_t i = 0; i < 4; i++) {
+    if (*programs[i])
+      memcpy((uint64_t *)signals[i]->bits, bitsets + (size_t)roots[i] * words,
+             words * sizeof(uint64_t));
+  }
+  samrena_scratch_end(scratch);
+  return 0;
+}
@@ -0,0 +1,272 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "samtrader/domain/sweep.h"
+
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "samtrader/domain/rule_program.h"
+
+/* Tolerance when counting range values, so 0.1..0.3:0.1 yields 3 values */
+#define SWEEP_COUNT_EPSILON 1e-9
+
+/* Enough for "%.15g" of any double */
+#define SWEEP_VALUE_BUF_SIZE 32
+
+/* --- Template parsing --- */
+
+static const char *skip_space(const char *p) {
+  while (*p && isspace((unsigned char)*p))
+    p++;
+  return p;
+}
+
+/* Parse "name" at p into name_out; returns pointer past the name or NULL */
+static const char *parse_name(const char *p, char *name_out) {
+  p = skip_space(p);
+  if (!isalpha((unsigned char)*p) && *p != '_')
+    return NULL;
+  size_t len = 0;
+  while (isalnum((unsigned char)*p) || *p == '_') {
+    if (len + 1 >= SAMTRADER_SWEEP_NAME_MAX)
+      return NULL;
+    name_out[len++] = *p++;
+  }
+  name_out[len] = '\0';
+  return skip_space(p);
+}
+
+/* Parse exactly len characters at p as a number (surrounding spaces allowed) */
+static int parse_number(const char *p, size_t len, double *out) {
+  char buf[SWEEP_VALUE_BUF_SIZE];
+  if (len == 0 || len >= sizeof(buf))
+    return -1;
+
+  /* Parse a bounded copy: strtod would read "5..50" as "5." then ".50" */
+  memcpy(buf, p, len);
+  buf[len] = '\0';
+  char *end = NULL;
+  *out = strtod(buf, &end);
+  if (end == buf || *skip_space(end) != '\0' || !isfinite(*out))
+    return -1;
+  return 0;
+}
+
+/* Parse "start..end[:step]"; returns a pointer to the closing brace or NULL */
+static const char *parse_range(const char *p, SamtraderSweepParam *param) {
+  const char *close = strchr(p, '}');
+  const char *dots = strstr(p, "..");
+  if (!close || !dots || dots > close)
+    return NULL;
+  if (parse_number(p, (size_t)(dots - p), &param->start) < 0)
+    return NULL;
+
+  const char *end = dots + 2;
+  const char *colon = memchr(end, ':', (size_t)(close - end));
+  const char *end_stop = colon ? colon : close;
+  if (parse_number(end, (size_t)(end_stop - end), &param->end) < 0)
+    return NULL;
+
+  param->step = 1.0;
+  if (colon && parse_number(colon + 1, (size_t)(close - colon - 1), &param->step) < 0)
+    return NULL;
+  if (param->step <= 0.0 || param->end < param->start)
+    return NULL;
+
+  double span = (param->end - param->start) / param->step;
+  if (span >= (double)SAMTRADER_SWEEP_MAX_VARIANTS)
+    return NULL;
+  param->count = (size_t)floor(span + SWEEP_COUNT_EPSILON) + 1;
+  return close;
+}
+
+static int find_param(const SamtraderSweepGrid *grid, const char *name) {
+  for (size_t i = 0; i < grid->param_count; i++) {
+    if (strcmp(grid->params[i].name, name) == 0)
+      return (int)i;
+  }
+  return -1;
+}
+
+static int add_param(SamtraderSweepGrid *grid, const SamtraderSweepParam *param) {
+  int existing = find_param(grid, param->name);
+  if (existing >= 0) {
+    const SamtraderSweepParam *prev = &grid->params[existing];
+    if (prev->start != param->start || prev->end != param->end || prev->step != param->step)
+      return -1;
+    return 0;
+  }
+  if (grid->param_count >= SAMTRADER_SWEEP_MAX_PARAMS)
+    return -1;
+  if (grid->variant_count > SAMTRADER_SWEEP_MAX_VARIANTS / param->count)
+    return -1;
+
+  grid->params[grid->param_count++] = *param;
+  grid->variant_count *= param->count;
+  return 0;
+}
+
+void samtrader_sweep_grid_init(SamtraderSweepGrid *grid) {
+  if (!grid)
+    return;
+  memset(grid, 0, sizeof(*grid));
+  grid->variant_count = 1;
+}
+
+int samtrader_sweep_grid_scan(SamtraderSweepGrid *grid, const char *text) {
+  if (!grid)
+    return -1;
+  if (!text)
+    return 0;
+
+  const char *p = text;
+  while ((p = strstr(p, "${")) != NULL) {
+    SamtraderSweepParam param = {0};
+    p = parse_name(p + 2, param.name);
+    if (!p)
+      return -1;
+    if (*p == '=') {
+      p = parse_range(p + 1, &param);
+      if (!p || *p != '}')
+        return -1;
+      if (add_param(grid, &param) < 0)
+        return -1;
+    } else if (*p != '}') {
+      return -1;
+    }
+    p++;
+  }
+  return 0;
+}
+
+double samtrader_sweep_param_value(const SamtraderSweepParam *param, size_t i) {
+  return param->start + (double)i * param->step;
+}
+
+int samtrader_sweep_variant_values(const SamtraderSweepGrid *grid, size_t variant,
+                                   double *values) {
+  if (!grid || !values || variant >= grid->variant_count)
+    return -1;
+
+  /* Mixed-radix decode, last parameter fastest */
+  for (size_t i = grid->param_count; i-- > 0;) {
+    const SamtraderSweepParam *param = &grid->params[i];
+    values[i] = samtrader_sweep_param_value(param, variant % param->count);
+    variant /= param->count;
+  }
+  return 0;
+}
+
+char *samtrader_sweep_expand(Samrena *arena, const SamtraderSweepGrid *grid, const char *text,
+                             size_t variant) {
+  if (!arena || !grid || !text)
+    return NULL;
+
+  double values[SAMTRADER_SWEEP_MAX_PARAMS];
+  if (samtrader_sweep_variant_values(grid, variant, values) < 0)
+    return NULL;
+
+  /* Each placeholder is at least 3 chars and expands to < SWEEP_VALUE_BUF_SIZE */
+  size_t text_len = strlen(text);
+  size_t cap = text_len + (text_len / 3 + 1) * SWEEP_VALUE_BUF_SIZE + 1;
+  char *out = (char *)samrena_push(arena, cap);
+  if (!out)
+    return NULL;
+
+  size_t len = 0;
+  const char *p = text;
+  const char *open;
+  while ((open = strstr(p, "${")) != NULL) {
+    memcpy(out + len, p, (size_t)(open - p));
+    len += (size_t)(open - p);
+
+    char name[SAMTRADER_SWEEP_NAME_MAX];
+    const char *q = parse_name(open + 2, name);
+    if (!q)
+      return NULL;
+    const char *close = strchr(q, '}');
+    if (!close)
+      return NULL;
+    int idx = find_param(grid, name);
+    if (idx < 0)
+      return NULL;
+
+    len += (size_t)snprintf(out + len, cap - len, "%.15g", values[idx]);
+    p = close + 1;
+  }
+  size_t rest = strlen(p);
+  memcpy(out + len, p, rest + 1);
+  return out;
+}
+
+/* --- Parallel execution --- */
+
+typedef struct {
+  const SamtraderSweepRun *run;
+  SamtraderMetrics *results;
+  double bars_per_year; /* Of the timeline, shared by every variant */
+} SweepTaskCtx;
+
+static int run_variant(const SweepTaskCtx *ctx, size_t index, Samrena *arena) {
+  const SamtraderSweepRun *run = ctx->run;
+  SamtraderMetrics *results = ctx->results;
+  const SamtraderStrategy *strategy = &run->strategies[index];
+  size_t code_count = run->timeline->code_count;
+
+  SamtraderStrategyProgram *programs =
+      SAMRENA_PUSH_ARRAY_ZERO(arena, SamtraderStrategyProgram, code_count);
+  if (!programs)
+    return -1;
+  for (size_t c = 0; c < code_count; c++) {
+    if (samtrader_strategy_compile(arena, strategy, run->code_data[c], &programs[c]) < 0)
+      return -1;
+  }
+
+  /* Only the metrics are kept, so stream them out of the run instead of storing its curve */
+  SamtraderMetricsAccumulator acc;
+  samtrader_metrics_accumulator_init(&acc, ctx->bars_per_year, run->risk_free_rate);
+  if (!samtrader_backtest_run_streaming(arena, run->config, strategy, run->code_data, programs,
+                                        run->timeline, &acc))
+    return -1;
+
+  samtrader_metrics_accumulator_finish(&acc, &results[index]);
+  return 0;
+}
+
+static int run_variant_task(void *ctx, size_t index, Samrena *arena) {
+  /* Nothing outlives the variant; rewinding keeps the worker's pages committed for the next */
+  SamrenaScratch frame = samrena_scratch_begin(arena);
+  int rc = run_variant((const SweepTaskCtx *)ctx, index, arena);
+  samrena_scratch_end(frame);
+  return rc;
+}
+
+int samtrader_sweep_run(SamtraderWorkerPool *pool, const SamtraderSweepRun *run,
+                        SamtraderMetrics *results) {
+  if (!pool || !run || !results || !run->strategies || !run->code_data || !run->timeline ||
+      !run->config)
+    return -1;
+
+  SweepTaskCtx ctx = {.run = run,
+                      .results = results,
+                      .bars_per_year = samtrader_metrics_bars_per_year_of_dates(
+                          (const time_t *)run->timeline->dates->data, run->timeline->date_count)};
+  return samtrader_worker_pool_run(pool, run->strategy_count, run_variant_task, &ctx);
+}
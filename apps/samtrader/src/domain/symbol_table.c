@@ -0,0 +1,114 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "samtrader/domain/symbol_table.h"
+
+#include <string.h>
+
+#include <samdata/samhashmap.h>
+#include <samvector.h>
+
+struct SamtraderSymbolTable {
+  Samrena *arena;
+  SamHashMap *ids;      /* name -> SamtraderSymbolId* */
+  SamrenaVector *names; /* const char* by id; slot 0 (SAMTRADER_SYMBOL_NONE) is NULL */
+};
+
+SamtraderSymbolTable *samtrader_symbol_table_create(Samrena *arena, size_t capacity) {
+  if (!arena) {
+    return NULL;
+  }
+
+  SamtraderSymbolTable *table = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderSymbolTable);
+  if (!table) {
+    return NULL;
+  }
+
+  table->arena = arena;
+  table->ids = samhashmap_create(capacity * 2 + 1, arena);
+  table->names = samrena_vector_init(arena, sizeof(const char *), capacity + 1);
+  if (!table->ids || !table->names) {
+    return NULL;
+  }
+
+  const char *none = NULL;
+  if (!samrena_vector_push(table->names, &none)) {
+    return NULL;
+  }
+
+  return table;
+}
+
+SamtraderSymbolId samtrader_symbol_intern(SamtraderSymbolTable *table, const char *name) {
+  if (!table || !name) {
+    return SAMTRADER_SYMBOL_NONE;
+  }
+
+  const SamtraderSymbolId *existing = (const SamtraderSymbolId *)samhashmap_get(table->ids, name);
+  if (existing) {
+    return *existing;
+  }
+
+  size_t next = samrena_vector_size(table->names);
+  if (next > UINT32_MAX) {
+    return SAMTRADER_SYMBOL_NONE;
+  }
+
+  size_t len = strlen(name) + 1;
+  char *copy = (char *)samrena_push(table->arena, len);
+  SamtraderSymbolId *id = SAMRENA_PUSH_TYPE(table->arena, SamtraderSymbolId);
+  if (!copy || !id) {
+    return SAMTRADER_SYMBOL_NONE;
+  }
+  memcpy(copy, name, len);
+  *id = (SamtraderSymbolId)next;
+
+  const char *interned = copy;
+  if (!samrena_vector_push(table->names, &interned)) {
+    return SAMTRADER_SYMBOL_NONE;
+  }
+  if (!samhashmap_put(table->ids, copy, id)) {
+    samrena_vector_pop(table->names);
+    return SAMTRADER_SYMBOL_NONE;
+  }
+
+  return *id;
+}
+
+SamtraderSymbolId samtrader_symbol_find(const SamtraderSymbolTable *table, const char *name) {
+  if (!table || !name) {
+    return SAMTRADER_SYMBOL_NONE;
+  }
+
+  const SamtraderSymbolId *id = (const SamtraderSymbolId *)samhashmap_get(table->ids, name);
+  return id ? *id : SAMTRADER_SYMBOL_NONE;
+}
+
+const char *samtrader_symbol_name(const SamtraderSymbolTable *table, SamtraderSymbolId id) {
+  if (!table || id == SAMTRADER_SYMBOL_NONE || id >= samrena_vector_size(table->names)) {
+    return NULL;
+  }
+
+  return *(const char *const *)samrena_vector_at_const(table->names, id);
+}
+
+size_t samtrader_symbol_table_count(const SamtraderSymbolTable *table) {
+  if (!table) {
+    return 0;
+  }
+
+  return samrena_vector_size(table->names) - 1;
+}
@@ -208,13 +208,23 @@ int samtrader_universe_validate(SamtraderUniverse *universe, SamtraderDataPort *
   size_t write_idx = 0;
 
   for (size_t read_idx = 0; read_idx < universe->count; read_idx++) {
-    SamrenaVector *result = data_port->fetch_ohlcv(data_port, universe->codes[read_idx],
-                                                   universe->exchange, start_date, end_date);
+    size_t bars = 0;
+    if (data_port->fetch_summary) {
+      /* Count-only query: no bars cross the wire */
+      SamtraderOhlcvSummary summary;
+      if (data_port->fetch_summary(data_port, universe->codes[read_idx], universe->exchange,
+                                   start_date, end_date, &summary) == 0) {
+        bars = summary.bar_count;
+      }
+    } else {
+      SamrenaVector *result = data_port->fetch_ohlcv(data_port, universe->codes[read_idx],
+                                                     universe->exchange, start_date, end_date);
+      bars = result ? samrena_vector_size(result) : 0;
+    }
 
-    if (result && samrena_vector_size(result) >= SAMTRADER_MIN_OHLCV_BARS) {
+    if (bars >= SAMTRADER_MIN_OHLCV_BARS) {
       universe->codes[write_idx++] = universe->codes[read_idx];
     } else {
-      size_t bars = result ? samrena_vector_size(result) : 0;
       fprintf(stderr, "Warning: skipping %s.%s (%zu bars, minimum %d required)\n",
               universe->codes[read_idx], universe->exchange, bars, SAMTRADER_MIN_OHLCV_BARS);
     }
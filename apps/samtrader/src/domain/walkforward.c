@@ -0,0 +1,180 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "samtrader/domain/walkforward.h"
+
+#include <math.h>
+
+#include "samtrader/domain/backtest.h"
+#include "samtrader/domain/portfolio.h"
+#include "samtrader/domain/rule_program.h"
+
+size_t samtrader_walkforward_window_count(const SamtraderWalkForwardConfig *config,
+                                          size_t date_count) {
+  if (!config || config->in_sample == 0 || config->out_of_sample == 0 ||
+      date_count <= config->in_sample)
+    return 0;
+  size_t tested = date_count - config->in_sample;
+  return (tested + config->out_of_sample - 1) / config->out_of_sample;
+}
+
+/* Date ranges of window w (out-of-sample windows tile the timeline) */
+static void window_bounds(const SamtraderWalkForwardConfig *config, size_t date_count, size_t w,
+                          SamtraderWalkForwardWindow *window) {
+  size_t oos_begin = config->in_sample + w * config->out_of_sample;
+  size_t oos_end = oos_begin + config->out_of_sample;
+  window->in_sample_begin = config->anchored ? 0 : oos_begin - config->in_sample;
+  window->in_sample_end = oos_begin;
+  window->out_of_sample_begin = oos_begin;
+  window->out_of_sample_end = oos_end < date_count ? oos_end : date_count;
+}
+
+/* Highest Sharpe ratio wins; ties (and NaNs) keep the earlier variant, as the sweep does */
+static size_t best_variant(const SamtraderMetrics *results, size_t count) {
+  size_t best = 0;
+  for (size_t v = 1; v < count; v++) {
+    if (results[v].sharpe_ratio > results[best].sharpe_ratio)
+      best = v;
+  }
+  return best;
+}
+
+/*
+ * Backtest one strategy over a timeline view in scratch, starting from
+ * initial_capital and closing whatever is still open on its last date, so
+ * the trades account for all of the equity handed to the next window. The
+ * metrics go to out; trades and equity points are appended to the
+ * stitched result. Returns the ending equity, or NAN.
+ */
+static double run_out_of_sample(Samrena *scratch, const SamtraderSweepRun *run,
+                                const SamtraderStrategy *strategy,
+                                const SamtraderTimeline *view, double initial_capital,
+                                SamtraderWalkForwardResult *result, SamtraderMetrics *out) {
+  size_t code_count = view->code_count;
+  SamtraderStrategyProgram *programs =
+      SAMRENA_PUSH_ARRAY_ZERO(scratch, SamtraderStrategyProgram, code_count);
+  if (!programs)
+    return NAN;
+  for (size_t c = 0; c < code_count; c++) {
+    if (samtrader_strategy_compile(scratch, strategy, run->code_data[c], &programs[c]) < 0)
+      return NAN;
+  }
+
+  SamtraderBacktestConfig config = *run->config;
+  config.initial_capital = initial_capital;
+  config.close_at_end = true;
+  SamtraderPortfolio *portfolio =
+      samtrader_backtest_run(scratch, &config, strategy, run->code_data, programs, view);
+  if (!portfolio)
+    return NAN;
+
+  SamtraderMetrics *metrics = samtrader_metrics_calculate(
+      scratch, portfolio->closed_trades, portfolio->equity_curve, run->risk_free_rate);
+  if (!metrics)
+    return NAN;
+  *out = *metrics;
+
+  /* Trade strings are interned in the scratch portfolio; repoint them at the
+   * code data. A backtest interns codes in universe order, so symbol id s is
+   * code_data[s - 1], in every window alike. */
+  for (size_t i = 0; i < samrena_vector_size(portfolio->closed_trades); i++) {
+    SamtraderClosedTrade trade =
+        *(const SamtraderClosedTrade *)samrena_vector_at_const(portfolio->closed_trades, i);
+    size_t c = (size_t)trade.symbol - 1;
+    if (trade.symbol == SAMTRADER_SYMBOL_NONE || c >= code_count)
+      return NAN;
+    trade.code = run->code_data[c]->code;
+    trade.exchange = run->code_data[c]->exchange;
+    if (!samrena_vector_push(result->trades, &trade))
+      return NAN;
+  }
+  size_t points = samrena_vector_size(portfolio->equity_curve);
+  for (size_t i = 0; i < points; i++) {
+    if (!samrena_vector_push(result->equity_curve,
+                             samrena_vector_at_const(portfolio->equity_curve, i)))
+      return NAN;
+  }
+
+  if (points == 0)
+    return initial_capital;
+  const SamtraderEquityPoint *last =
+      (const SamtraderEquityPoint *)samrena_vector_at_const(portfolio->equity_curve, points - 1);
+  return last->equity;
+}
+
+/* Optimise every variant in-sample, in parallel, then trade the winner on the
+ * following unseen dates. Returns the ending equity, or NAN on error. */
+static double run_window(Samrena *scratch, SamtraderWorkerPool *pool, const SamtraderSweepRun *run,
+                         SamtraderWalkForwardWindow *window, SamtraderMetrics *results,
+                         double equity, SamtraderWalkForwardResult *result) {
+  SamtraderSweepRun in_sample = *run;
+  in_sample.timeline = samtrader_timeline_window(scratch, run->timeline, window->in_sample_begin,
+                                                 window->in_sample_end);
+  if (!in_sample.timeline || samtrader_sweep_run(pool, &in_sample, results) < 0)
+    return NAN;
+  window->best_variant = best_variant(results, run->strategy_count);
+  window->in_sample = results[window->best_variant];
+
+  const SamtraderTimeline *oos = samtrader_timeline_window(
+      scratch, run->timeline, window->out_of_sample_begin, window->out_of_sample_end);
+  if (!oos)
+    return NAN;
+  return run_out_of_sample(scratch, run, &run->strategies[window->best_variant], oos, equity,
+                           result, &window->out_of_sample);
+}
+
+SamtraderWalkForwardResult *samtrader_walkforward_run(Samrena *arena, SamtraderWorkerPool *pool,
+                                                      const SamtraderSweepRun *run,
+                                                      const SamtraderWalkForwardConfig *config) {
+  if (!arena || !pool || !run || !config || !run->strategies || run->strategy_count == 0 ||
+      !run->code_data || !run->timeline || !run->config)
+    return NULL;
+
+  size_t date_count = run->timeline->date_count;
+  size_t window_count = samtrader_walkforward_window_count(config, date_count);
+  if (window_count == 0)
+    return NULL;
+
+  SamtraderWalkForwardResult *result = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderWalkForwardResult);
+  SamtraderWalkForwardWindow *windows =
+      SAMRENA_PUSH_ARRAY_ZERO(arena, SamtraderWalkForwardWindow, window_count);
+  SamtraderMetrics *results = SAMRENA_PUSH_ARRAY_ZERO(arena, SamtraderMetrics, run->strategy_count);
+  if (!result || !windows || !results)
+    return NULL;
+  result->windows = windows;
+  result->window_count = window_count;
+  result->equity_curve =
+      samrena_vector_init(arena, sizeof(SamtraderEquityPoint), date_count - config->in_sample);
+  result->trades = samrena_vector_init(arena, sizeof(SamtraderClosedTrade), 64);
+  if (!result->equity_curve || !result->trades)
+    return NULL;
+
+  /* Timeline views and out-of-sample runs are transient; one window at a time */
+  Samrena *scratch = samrena_create_default();
+  if (!scratch)
+    return NULL;
+
+  double equity = run->config->initial_capital;
+  for (size_t w = 0; w < window_count && !isnan(equity); w++) {
+    window_bounds(config, date_count, w, &windows[w]);
+    SamrenaScratch frame = samrena_scratch_begin(scratch);
+    equity = run_window(scratch, pool, run, &windows[w], results, equity, result);
+    samrena_scratch_end(frame);
+  }
+
+  samrena_destroy(scratch);
+  return isnan(equity) ? NULL : result;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "samtrader/domain/worker_pool.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+struct SamtraderWorkerPool {
+  size_t worker_count;
+  Samrena **arenas;
+};
+
+typedef struct {
+  SamtraderWorkerTaskFn fn;
+  void *ctx;
+  size_t task_count;
+  atomic_size_t next;
+  atomic_int failed;
+} PoolJob;
+
+typedef struct {
+  PoolJob *job;
+  Samrena *arena;
+} WorkerArg;
+
+static void run_tasks(PoolJob *job, Samrena *arena) {
+  while (!atomic_load_explicit(&job->failed, memory_order_relaxed)) {
+    size_t index = atomic_fetch_add_explicit(&job->next, 1, memory_order_relaxed);
+    if (index >= job->task_count)
+      return;
+    if (job->fn(job->ctx, index, arena) < 0)
+      atomic_store_explicit(&job->failed, 1, memory_order_relaxed);
+  }
+}
+
+static void *worker_main(void *arg) {
+  WorkerArg *worker = (WorkerArg *)arg;
+  run_tasks(worker->job, worker->arena);
+  return NULL;
+}
+
+SamtraderWorkerPool *samtrader_worker_pool_create(int jobs) {
+  if (jobs < 1)
+    jobs = 1;
+  if (jobs > SAMTRADER_MAX_WORKERS)
+    jobs = SAMTRADER_MAX_WORKERS;
+
+  SamtraderWorkerPool *pool = calloc(1, sizeof(SamtraderWorkerPool));
+  if (!pool)
+    return NULL;
+  pool->arenas = calloc((size_t)jobs, sizeof(Samrena *));
+  if (!pool->arenas) {
+    free(pool);
+    return NULL;
+  }
+
+  for (int i = 0; i < jobs; i++) {
+    pool->arenas[i] = samrena_create_default();
+    if (!pool->arenas[i]) {
+      samtrader_worker_pool_destroy(pool);
+      return NULL;
+    }
+    pool->worker_count++;
+  }
+  return pool;
+}
+
+size_t samtrader_worker_pool_size(const SamtraderWorkerPool *pool) {
+  return pool ? pool->worker_count : 0;
+}
+
+int samtrader_worker_pool_run(SamtraderWorkerPool *pool, size_t task_count,
+                              SamtraderWorkerTaskFn fn, void *ctx) {
+  if (!pool || !fn)
+    return -1;
+  if (task_count == 0)
+    return 0;
+
+  PoolJob job = {.fn = fn, .ctx = ctx, .task_count = task_count};
+  atomic_init(&job.next, 0);
+  atomic_init(&job.failed, 0);
+
+  size_t workers = pool->worker_count < task_count ? pool->worker_count : task_count;
+  if (workers <= 1) {
+    run_tasks(&job, pool->arenas[0]);
+    return atomic_load(&job.failed) ? -1 : 0;
+  }
+
+  pthread_t threads[SAMTRADER_MAX_WORKERS];
+  WorkerArg args[SAMTRADER_MAX_WORKERS];
+  size_t started = 0;
+
+  /* Worker 0 is the calling thread; the rest are spawned */
+  for (size_t i = 1; i < workers; i++) {
+    args[i].job = &job;
+    args[i].arena = pool->arenas[i];
+    if (pthread_create(&threads[i], NULL, worker_main, &args[i]) != 0)
+      break;
+    started = i;
+  }
+
+  run_tasks(&job, pool->arenas[0]);
+
+  for (size_t i = 1; i <= started; i++)
+    pthread_join(threads[i], NULL);
+
+  return atomic_load(&job.failed) ? -1 : 0;
+}
+
+void samtrader_worker_pool_destroy(SamtraderWorkerPool *pool) {
+  if (!pool)
+    return;
+  for (size_t i = 0; i < pool->worker_count; i++)
+    samrena_destroy(pool->arenas[i]);
+  free(pool->arenas);
+  free(pool);
+}
@@ -21,12 +21,16 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <unistd.h>
 
 #include <samdata/samhashmap.h>
 #include <samrena.h>
 #include <samvector.h>
 
+#include <samtrader/adapters/csv_export_adapter.h>
 #include <samtrader/adapters/file_config_adapter.h>
+#include <samtrader/adapters/indicator_cache_adapter.h>
+#include <samtrader/adapters/mmap_cache_adapter.h>
 #include <samtrader/adapters/postgres_adapter.h>
 #include <samtrader/adapters/typst_report_adapter.h>
 #include <samtrader/domain/backtest.h>
@@ -34,14 +38,22 @@
 #include <samtrader/domain/execution.h>
 #include <samtrader/domain/indicator.h>
 #include <samtrader/domain/metrics.h>
+#include <samtrader/domain/montecarlo.h>
 #include <samtrader/domain/ohlcv.h>
 #include <samtrader/domain/portfolio.h>
 #include <samtrader/domain/position.h>
+#include <samtrader/domain/resample.h>
 #include <samtrader/domain/rule.h>
+#include <samtrader/domain/rule_program.h>
 #include <samtrader/domain/strategy.h>
+#include <samtrader/domain/sweep.h>
 #include <samtrader/domain/universe.h>
+#include <samtrader/domain/walkforward.h>
+#include <samtrader/domain/worker_pool.h>
 #include <samtrader/ports/config_port.h>
 #include <samtrader/ports/data_port.h>
+#include <samtrader/ports/export_port.h>
+#include <samtrader/ports/indicator_cache_port.h>
 #include <samtrader/ports/report_port.h>
 #include <samtrader/samtrader.h>
 
@@ -53,7 +65,6 @@
 #define EXIT_INSUFFICIENT_DATA 5
 
 #define INDICATOR_KEY_BUF_SIZE 64
-#define DATE_KEY_BUF_SIZE 32
 #define MIN_OHLCV_BARS 30
 
 typedef struct {
@@ -62,9 +73,19 @@ typedef struct {
   const char *output_path;   /* -o / --output */
   const char *exchange;      /* --exchange */
   const char *code;          /* --code */
+  int jobs;                  /* -j / --jobs (0 = command default) */
 } CliArgs;
 
-typedef enum { CMD_BACKTEST, CMD_LIST_SYMBOLS, CMD_VALIDATE, CMD_INFO, CMD_HELP } Command;
+typedef enum {
+  CMD_BACKTEST,
+  CMD_SWEEP,
+  CMD_WALKFORWARD,
+  CMD_CACHE_BUILD,
+  CMD_LIST_SYMBOLS,
+  CMD_VALIDATE,
+  CMD_INFO,
+  CMD_HELP
+} Command;
 
 static void print_usage(const char *prog) {
   fprintf(stderr,
@@ -74,6 +95,11 @@ static void print_usage(const char *prog) {
           "\n"
           "Commands:\n"
           "  backtest       Run a backtest\n"
+          "  sweep          Backtest every combination of ${name=start..end:step}\n"
+          "                 parameters in the strategy rules and write a CSV\n"
+          "  walkforward    Optimise sweep parameters on rolling in-sample windows and\n"
+          "                 trade the winners on the following out-of-sample windows\n"
+          "  cache build    Snapshot the configured codes into a local cache file\n"
           "  list-symbols   List available symbols\n"
           "  validate       Validate a strategy file\n"
           "  info           Show data range for a symbol (or all codes in config)\n"
@@ -81,9 +107,12 @@ static void print_usage(const char *prog) {
           "Options:\n"
           "  -c, --config <path>     Config file path (required for backtest)\n"
           "  -s, --strategy <path>   Strategy file path\n"
-          "  -o, --output <path>     Output report path\n"
+          "  -o, --output <path>     Output report path (CSV path for sweep and walkforward,\n"
+          "                          cache file path for cache build)\n"
           "      --exchange <name>   Exchange name\n"
           "      --code <symbol>     Symbol code\n"
+          "  -j, --jobs <n>          Worker threads (backtest default 1, sweep and walkforward\n"
+          "                          default all cores)\n"
           "  -h, --help              Show this help message\n",
           prog);
 }
@@ -91,6 +120,12 @@ static void print_usage(const char *prog) {
 static int parse_command(const char *arg) {
   if (strcmp(arg, "backtest") == 0)
     return CMD_BACKTEST;
+  if (strcmp(arg, "sweep") == 0)
+    return CMD_SWEEP;
+  if (strcmp(arg, "walkforward") == 0)
+    return CMD_WALKFORWARD;
+  if (strcmp(arg, "cache") == 0)
+    return CMD_CACHE_BUILD;
   if (strcmp(arg, "list-symbols") == 0)
     return CMD_LIST_SYMBOLS;
   if (strcmp(arg, "validate") == 0)
@@ -108,6 +143,7 @@ static int parse_args(int argc, char *argv[], Command *cmd, CliArgs *args) {
                                                {"output", required_argument, NULL, 'o'},
                                                {"exchange", required_argument, NULL, 'E'},
                                                {"code", required_argument, NULL, 'C'},
+                                               {"jobs", required_argument, NULL, 'j'},
                                                {"help", no_argument, NULL, 'h'},
                                                {NULL, 0, NULL, 0}};
 
@@ -131,11 +167,22 @@ static int parse_args(int argc, char *argv[], Command *cmd, CliArgs *args) {
     return -1; /* signal: help printed, exit 0 */
   }
 
+  /* 'cache' takes an action word; 'build' is the only one so far */
+  int first_flag = 2;
+  if (*cmd == CMD_CACHE_BUILD) {
+    if (argc < 3 || strcmp(argv[2], "build") != 0) {
+      fprintf(stderr, "Error: unknown cache action (expected 'cache build')\n\n");
+      print_usage(argv[0]);
+      return EXIT_GENERAL_ERROR;
+    }
+    first_flag = 3;
+  }
+
   /* Reset getopt and parse flags from argv[1] onward.
-     We shift optind to 2 so getopt skips argv[0] and the subcommand. */
-  optind = 2;
+     We shift optind past argv[0] and the subcommand so getopt skips them. */
+  optind = first_flag;
   int opt;
-  while ((opt = getopt_long(argc, argv, "c:s:o:h", long_options, NULL)) != -1) {
+  while ((opt = getopt_long(argc, argv, "c:s:o:j:h", long_options, NULL)) != -1) {
     switch (opt) {
       case 'c':
         args->config_path = optarg;
@@ -152,6 +199,16 @@ static int parse_args(int argc, char *argv[], Command *cmd, CliArgs *args) {
       case 'C':
         args->code = optarg;
         break;
+      case 'j': {
+        char *end = NULL;
+        long jobs = strtol(optarg, &end, 10);
+        if (!end || *end != '\0' || jobs < 1 || jobs > SAMTRADER_MAX_WORKERS) {
+          fprintf(stderr, "Error: --jobs must be between 1 and %d\n", SAMTRADER_MAX_WORKERS);
+          return EXIT_GENERAL_ERROR;
+        }
+        args->jobs = (int)jobs;
+        break;
+      }
       case 'h':
         print_usage(argv[0]);
         return -1;
@@ -172,6 +229,28 @@ static int validate_args(Command cmd, const CliArgs *args) {
         return EXIT_CONFIG_ERROR;
       }
       break;
+    case CMD_SWEEP:
+      if (!args->config_path) {
+        fprintf(stderr, "Error: sweep requires -c/--config\n");
+        return EXIT_CONFIG_ERROR;
+      }
+      break;
+    case CMD_WALKFORWARD:
+      if (!args->config_path) {
+        fprintf(stderr, "Error: walkforward requires -c/--config\n");
+        return EXIT_CONFIG_ERROR;
+      }
+      break;
+    case CMD_CACHE_BUILD:
+      if (!args->config_path) {
+        fprintf(stderr, "Error: cache build requires -c/--config\n");
+        return EXIT_CONFIG_ERROR;
+      }
+      if (!args->output_path) {
+        fprintf(stderr, "Error: cache build requires -o/--output\n");
+        return EXIT_GENERAL_ERROR;
+      }
+      break;
     case CMD_LIST_SYMBOLS:
       if (!args->exchange) {
         fprintf(stderr, "Error: list-symbols requires --exchange\n");
@@ -204,18 +283,26 @@ static int validate_args(Command cmd, const CliArgs *args) {
  * Helper Functions
  *============================================================================*/
 
+/* Days from 1970-01-01 to the given proleptic Gregorian date */
+static int64_t days_from_civil(int year, int month, int day) {
+  year -= month <= 2;
+  int64_t era = (year >= 0 ? year : year - 399) / 400;
+  int64_t yoe = year - era * 400;
+  int64_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+/* Parse YYYY-MM-DD as midnight UTC, matching how bar dates are stored */
 static time_t parse_date(const char *date_str) {
   if (!date_str)
     return (time_t)-1;
   int year, month, day;
   if (sscanf(date_str, "%d-%d-%d", &year, &month, &day) != 3)
     return (time_t)-1;
-  struct tm tm_val = {0};
-  tm_val.tm_year = year - 1900;
-  tm_val.tm_mon = month - 1;
-  tm_val.tm_mday = day;
-  tm_val.tm_isdst = -1;
-  return mktime(&tm_val);
+  if (month < 1 || month > 12 || day < 1 || day > 31)
+    return (time_t)-1;
+  return (time_t)(days_from_civil(year, month, day) * SAMTRADER_SECONDS_PER_DAY);
 }
 
 static void collect_from_operand(const SamtraderOperand *op, SamHashMap *seen_keys,
@@ -295,9 +382,18 @@ static SamHashMap *build_price_map(Samrena *arena, const SamtraderOhlcv *bar) {
   return price_map;
 }
 
-static int load_strategy_from_config(SamtraderConfigPort *config, Samrena *arena,
-                                     SamtraderStrategy *strategy) {
-  memset(strategy, 0, sizeof(*strategy));
+/* Strategy settings plus the unparsed rule text (which may be a sweep template) */
+typedef struct {
+  SamtraderStrategy base; /* everything except the rules */
+  const char *entry_long;
+  const char *exit_long;
+  const char *entry_short;
+  const char *exit_short;
+} StrategyText;
+
+static int read_strategy_text(SamtraderConfigPort *config, StrategyText *text) {
+  memset(text, 0, sizeof(*text));
+  SamtraderStrategy *strategy = &text->base;
 
   strategy->name = config->get_string(config, "strategy", "name");
   if (!strategy->name)
@@ -307,35 +403,25 @@ static int load_strategy_from_config(SamtraderConfigPort *config, Samrena *arena
   if (!strategy->description)
     strategy->description = "";
 
-  const char *entry_long_str = config->get_string(config, "strategy", "entry_long");
-  if (!entry_long_str || entry_long_str[0] == '\0') {
+  text->entry_long = config->get_string(config, "strategy", "entry_long");
+  if (!text->entry_long || text->entry_long[0] == '\0') {
     fprintf(stderr, "Error: strategy requires entry_long rule\n");
     return EXIT_INVALID_STRATEGY;
   }
-  strategy->entry_long = samtrader_rule_parse(arena, entry_long_str);
-  if (!strategy->entry_long) {
-    fprintf(stderr, "Error: failed to parse entry_long rule: %s\n", entry_long_str);
-    return EXIT_INVALID_STRATEGY;
-  }
 
-  const char *exit_long_str = config->get_string(config, "strategy", "exit_long");
-  if (!exit_long_str || exit_long_str[0] == '\0') {
+  text->exit_long = config->get_string(config, "strategy", "exit_long");
+  if (!text->exit_long || text->exit_long[0] == '\0') {
     fprintf(stderr, "Error: strategy requires exit_long rule\n");
     return EXIT_INVALID_STRATEGY;
   }
-  strategy->exit_long = samtrader_rule_parse(arena, exit_long_str);
-  if (!strategy->exit_long) {
-    fprintf(stderr, "Error: failed to parse exit_long rule: %s\n", exit_long_str);
-    return EXIT_INVALID_STRATEGY;
-  }
 
-  const char *entry_short_str = config->get_string(config, "strategy", "entry_short");
-  if (entry_short_str && entry_short_str[0] != '\0')
-    strategy->entry_short = samtrader_rule_parse(arena, entry_short_str);
+  text->entry_short = config->get_string(config, "strategy", "entry_short");
+  if (text->entry_short && text->entry_short[0] == '\0')
+    text->entry_short = NULL;
 
-  const char *exit_short_str = config->get_string(config, "strategy", "exit_short");
-  if (exit_short_str && exit_short_str[0] != '\0')
-    strategy->exit_short = samtrader_rule_parse(arena, exit_short_str);
+  text->exit_short = config->get_string(config, "strategy", "exit_short");
+  if (text->exit_short && text->exit_short[0] == '\0')
+    text->exit_short = NULL;
 
   strategy->position_size = config->get_double(config, "strategy", "position_size", 0.25);
   strategy->stop_loss_pct = config->get_double(config, "strategy", "stop_loss", 0.0);
@@ -345,6 +431,55 @@ static int load_strategy_from_config(SamtraderConfigPort *config, Samrena *arena
   return 0;
 }
 
+static int parse_strategy_text(Samrena *arena, const StrategyText *text,
+                               SamtraderStrategy *strategy) {
+  *strategy = text->base;
+
+  strategy->entry_long = samtrader_rule_parse(arena, text->entry_long);
+  if (!strategy->entry_long) {
+    fprintf(stderr, "Error: failed to parse entry_long rule: %s\n", text->entry_long);
+    return EXIT_INVALID_STRATEGY;
+  }
+
+  strategy->exit_long = samtrader_rule_parse(arena, text->exit_long);
+  if (!strategy->exit_long) {
+    fprintf(stderr, "Error: failed to parse exit_long rule: %s\n", text->exit_long);
+    return EXIT_INVALID_STRATEGY;
+  }
+
+  if (text->entry_short)
+    strategy->entry_short = samtrader_rule_parse(arena, text->entry_short);
+  if (text->exit_short)
+    strategy->exit_short = samtrader_rule_parse(arena, text->exit_short);
+
+  return 0;
+}
+
+static int load_strategy_text(const CliArgs *args, SamtraderConfigPort *config, Samrena *arena,
+                              StrategyText *text) {
+  if (!args->strategy_path)
+    return read_strategy_text(config, text);
+
+  SamtraderConfigPort *strategy_config =
+      samtrader_file_config_adapter_create(arena, args->strategy_path);
+  if (!strategy_config) {
+    fprintf(stderr, "Error: failed to load strategy file: %s\n", args->strategy_path);
+    return EXIT_INVALID_STRATEGY;
+  }
+  int rc = read_strategy_text(strategy_config, text);
+  strategy_config->close(strategy_config);
+  return rc;
+}
+
+static int load_strategy_from_config(SamtraderConfigPort *config, Samrena *arena,
+                                     SamtraderStrategy *strategy) {
+  StrategyText text;
+  int rc = read_strategy_text(config, &text);
+  if (rc != 0)
+    return rc;
+  return parse_strategy_text(arena, &text, strategy);
+}
+
 static int load_strategy_from_file(const char *strategy_path, Samrena *arena,
                                    SamtraderStrategy *strategy) {
   SamtraderConfigPort *config = samtrader_file_config_adapter_create(arena, strategy_path);
@@ -357,36 +492,26 @@ static int load_strategy_from_file(const char *strategy_path, Samrena *arena,
   return rc;
 }
 
-/*============================================================================
- * Command Implementations
- *============================================================================*/
-
-static int cmd_backtest(const CliArgs *args) {
-  int rc = EXIT_SUCCESS;
-  Samrena *arena = samrena_create_default();
-  if (!arena) {
-    fprintf(stderr, "Error: failed to create memory arena\n");
-    return EXIT_GENERAL_ERROR;
-  }
-
-  SamtraderConfigPort *config = NULL;
-  SamtraderDataPort *data = NULL;
-  SamtraderReportPort *report = NULL;
-
-  /* Load config */
-  config = samtrader_file_config_adapter_create(arena, args->config_path);
-  if (!config) {
-    fprintf(stderr, "Error: failed to load config: %s\n", args->config_path);
-    rc = EXIT_CONFIG_ERROR;
-    goto cleanup;
-  }
-
-  /* Read backtest parameters */
+/* Backtest parameters shared by the backtest and sweep commands */
+typedef struct {
+  const char *conninfo;   /* [database] conninfo, NULL when only a cache is configured */
+  const char *cache_path; /* [database] cache, read instead of the database when set */
+  const char *indicator_cache;  /* [database] indicator_cache directory, NULL for none */
+  size_t indicator_cache_bytes; /* [database] indicator_cache_mb, 0 for no cap */
+  const char *exchange;
+  SamtraderUniverse *universe;
+  SamtraderBacktestConfig backtest;
+  double risk_free_rate;
+  int64_t bar_interval; /* [backtest] bar_interval in seconds, 0 to keep the stored bars */
+} RunSettings;
+
+static int read_run_settings(const CliArgs *args, SamtraderConfigPort *config, Samrena *arena,
+                             RunSettings *settings) {
   const char *conninfo = config->get_string(config, "database", "conninfo");
-  if (!conninfo) {
+  const char *cache_path = config->get_string(config, "database", "cache");
+  if (!conninfo && !cache_path) {
     fprintf(stderr, "Error: missing [database] conninfo in config\n");
-    rc = EXIT_CONFIG_ERROR;
-    goto cleanup;
+    return EXIT_CONFIG_ERROR;
   }
 
   /* Resolve code(s) - CLI --code overrides config; 'codes' wins over 'code' */
@@ -397,8 +522,7 @@ static int cmd_backtest(const CliArgs *args) {
       args->exchange ? args->exchange : config->get_string(config, "backtest", "exchange");
   if (!exchange) {
     fprintf(stderr, "Error: backtest requires exchange\n");
-    rc = EXIT_CONFIG_ERROR;
-    goto cleanup;
+    return EXIT_CONFIG_ERROR;
   }
 
   const char *effective_codes;
@@ -412,15 +536,13 @@ static int cmd_backtest(const CliArgs *args) {
     effective_codes = code_single; /* Legacy single code */
   } else {
     fprintf(stderr, "Error: backtest requires code or codes\n");
-    rc = EXIT_CONFIG_ERROR;
-    goto cleanup;
+    return EXIT_CONFIG_ERROR;
   }
 
   SamtraderUniverse *universe = samtrader_universe_parse(arena, effective_codes, exchange);
   if (!universe) {
     fprintf(stderr, "Error: failed to parse codes\n");
-    rc = EXIT_CONFIG_ERROR;
-    goto cleanup;
+    return EXIT_CONFIG_ERROR;
   }
 
   const char *start_str = config->get_string(config, "backtest", "start_date");
@@ -429,16 +551,186 @@ static int cmd_backtest(const CliArgs *args) {
   time_t end_date = parse_date(end_str);
   if (start_date == (time_t)-1 || end_date == (time_t)-1) {
     fprintf(stderr, "Error: invalid start_date or end_date (expected YYYY-MM-DD)\n");
+    return EXIT_CONFIG_ERROR;
+  }
+
+  /* Policies and flags the config leaves unset keep their zero defaults */
+  SamtraderBacktestConfig *bt = &settings->backtest;
+  *bt = (SamtraderBacktestConfig){0};
+  bt->start_date = start_date;
+  /* end_date names a whole day, so intraday bars after midnight are included */
+  bt->end_date = end_date + SAMTRADER_SECONDS_PER_DAY - 1;
+  bt->initial_capital = config->get_double(config, "backtest", "initial_capital", 100000.0);
+  bt->commission_per_trade = config->get_double(config, "backtest", "commission_per_trade", 0.0);
+  bt->commission_pct = config->get_double(config, "backtest", "commission_pct", 0.0);
+  bt->slippage_pct = config->get_double(config, "backtest", "slippage_pct", 0.0);
+  bt->allow_shorting = config->get_bool(config, "backtest", "allow_shorting", false);
+
+  const char *fill_policy = config->get_string(config, "backtest", "fill_policy");
+  if (fill_policy && !samtrader_fill_policy_parse(fill_policy, &bt->fill_policy)) {
+    fprintf(stderr, "Error: invalid fill_policy '%s' (expected same_bar_close or next_bar_open)\n",
+            fill_policy);
+    return EXIT_CONFIG_ERROR;
+  }
+  const char *trigger_policy = config->get_string(config, "backtest", "trigger_policy");
+  if (trigger_policy && !samtrader_trigger_policy_parse(trigger_policy, &bt->trigger_policy)) {
+    fprintf(stderr, "Error: invalid trigger_policy '%s' (expected close or worst_case)\n",
+            trigger_policy);
+    return EXIT_CONFIG_ERROR;
+  }
+  settings->risk_free_rate = config->get_double(config, "backtest", "risk_free_rate", 0.05);
+
+  settings->bar_interval = 0;
+  const char *bar_interval = config->get_string(config, "backtest", "bar_interval");
+  if (bar_interval && !samtrader_bar_interval_parse(bar_interval, &settings->bar_interval)) {
+    fprintf(stderr, "Error: invalid bar_interval '%s' (expected e.g. 5m, 1h or 1d)\n",
+            bar_interval);
+    return EXIT_CONFIG_ERROR;
+  }
+
+  int indicator_cache_mb = config->get_int(config, "database", "indicator_cache_mb", 512);
+  if (indicator_cache_mb < 0) {
+    fprintf(stderr, "Error: [database] indicator_cache_mb must not be negative\n");
+    return EXIT_CONFIG_ERROR;
+  }
+
+  settings->conninfo = conninfo;
+  settings->cache_path = cache_path;
+  settings->indicator_cache = config->get_string(config, "database", "indicator_cache");
+  settings->indicator_cache_bytes = (size_t)indicator_cache_mb * 1024 * 1024;
+  settings->exchange = exchange;
+  settings->universe = universe;
+  return 0;
+}
+
+/* [montecarlo] settings; samples = 0 (the default) leaves resampling off */
+static int read_montecarlo_settings(SamtraderConfigPort *config, double risk_free_rate,
+                                    SamtraderMonteCarloConfig *mc) {
+  int samples = config->get_int(config, "montecarlo", "samples", 0);
+  int block_length = config->get_int(config, "montecarlo", "block_length", 0);
+  if (samples < 0 || block_length < 0) {
+    fprintf(stderr, "Error: [montecarlo] samples and block_length must not be negative\n");
+    return EXIT_CONFIG_ERROR;
+  }
+  mc->method = SAMTRADER_MONTECARLO_TRADES;
+  const char *method = config->get_string(config, "montecarlo", "method");
+  if (method && !samtrader_montecarlo_method_parse(method, &mc->method)) {
+    fprintf(stderr, "Error: invalid montecarlo method '%s' (expected trades or returns)\n",
+            method);
+    return EXIT_CONFIG_ERROR;
+  }
+  mc->samples = (size_t)samples;
+  mc->block_length = (size_t)block_length;
+  mc->seed = (uint64_t)config->get_int(config, "montecarlo", "seed", 1);
+  mc->risk_free_rate = risk_free_rate;
+  return 0;
+}
+
+/* Open the configured cache file, or connect to the database when there is none */
+static SamtraderDataPort *open_data_port(Samrena *arena, const char *conninfo,
+                                         const char *cache_path) {
+  if (cache_path) {
+    SamtraderDataPort *data = samtrader_mmap_cache_adapter_create(arena, cache_path);
+    if (!data)
+      fprintf(stderr, "Error: failed to open cache file: %s\n", cache_path);
+    return data;
+  }
+  SamtraderDataPort *data = samtrader_postgres_adapter_create(arena, conninfo);
+  if (!data)
+    fprintf(stderr, "Error: failed to connect to database\n");
+  return data;
+}
+
+/* Open the configured indicator cache; without one, every series is computed */
+static SamtraderIndicatorCachePort *open_indicator_cache(Samrena *arena,
+                                                         const RunSettings *settings) {
+  if (!settings->indicator_cache)
+    return NULL;
+  SamtraderIndicatorCachePort *cache = samtrader_indicator_cache_adapter_create(
+      arena, settings->indicator_cache, settings->indicator_cache_bytes);
+  if (!cache)
+    fprintf(stderr, "Warning: failed to open indicator cache %s; computing all indicators\n",
+            settings->indicator_cache);
+  return cache;
+}
+
+static void print_indicator_cache_stats(SamtraderIndicatorCachePort *cache) {
+  SamtraderIndicatorCacheStats stats;
+  if (cache && samtrader_indicator_cache_stats(cache, &stats) == 0)
+    printf("Indicator cache: %zu hits, %zu computed\n", stats.hits, stats.misses);
+}
+
+/* Validate the universe against the data source and load every code's bars */
+static int load_universe_data(Samrena *arena, SamtraderDataPort *data, RunSettings *settings,
+                              SamtraderCodeData ***out) {
+  SamtraderUniverse *universe = settings->universe;
+  time_t start_date = settings->backtest.start_date;
+  time_t end_date = settings->backtest.end_date;
+
+  printf("Loading universe (%zu codes)...\n", universe->count);
+
+  SamtraderCodeData **code_data_arr = NULL;
+  int valid_count =
+      samtrader_load_universe_data(arena, data, universe, start_date, end_date, &code_data_arr);
+  if (valid_count < 0) {
+    fprintf(stderr, "Error: failed to load universe data\n");
+    return EXIT_DB_ERROR;
+  }
+  if (valid_count == 0) {
+    fprintf(stderr, "Error: no valid codes in universe\n");
+    return EXIT_INSUFFICIENT_DATA;
+  }
+
+  for (size_t c = 0; c < universe->count; c++) {
+    if (settings->bar_interval > 0 &&
+        samtrader_code_data_resample(arena, code_data_arr[c], settings->bar_interval) != 0) {
+      fprintf(stderr, "Error: failed to resample %s\n", universe->codes[c]);
+      return EXIT_GENERAL_ERROR;
+    }
+    printf("  Validated %s: %zu bars\n", universe->codes[c], code_data_arr[c]->bar_count);
+  }
+
+  *out = code_data_arr;
+  return 0;
+}
+
+/*============================================================================
+ * Command Implementations
+ *============================================================================*/
+
+static int cmd_backtest(const CliArgs *args) {
+  int rc = EXIT_SUCCESS;
+  Samrena *arena = samrena_create_default();
+  if (!arena) {
+    fprintf(stderr, "Error: failed to create memory arena\n");
+    return EXIT_GENERAL_ERROR;
+  }
+
+  SamtraderConfigPort *config = NULL;
+  SamtraderDataPort *data = NULL;
+  SamtraderReportPort *report = NULL;
+  SamtraderWorkerPool *pool = NULL;
+  SamtraderIndicatorCachePort *indicator_cache = NULL;
+
+  /* Load config */
+  config = samtrader_file_config_adapter_create(arena, args->config_path);
+  if (!config) {
+    fprintf(stderr, "Error: failed to load config: %s\n", args->config_path);
     rc = EXIT_CONFIG_ERROR;
     goto cleanup;
   }
 
-  double initial_capital = config->get_double(config, "backtest", "initial_capital", 100000.0);
-  double commission_flat = config->get_double(config, "backtest", "commission_per_trade", 0.0);
-  double commission_pct = config->get_double(config, "backtest", "commission_pct", 0.0);
-  double slippage_pct = config->get_double(config, "backtest", "slippage_pct", 0.0);
-  bool allow_shorting = config->get_bool(config, "backtest", "allow_shorting", false);
-  double risk_free_rate = config->get_double(config, "backtest", "risk_free_rate", 0.05);
+  RunSettings settings;
+  rc = read_run_settings(args, config, arena, &settings);
+  if (rc != 0)
+    goto cleanup;
+  SamtraderUniverse *universe = settings.universe;
+  const char *exchange = settings.exchange;
+
+  SamtraderMonteCarloConfig montecarlo;
+  rc = read_montecarlo_settings(config, settings.risk_free_rate, &montecarlo);
+  if (rc != 0)
+    goto cleanup;
 
   /* Load strategy */
   SamtraderStrategy strategy;
@@ -451,156 +743,66 @@ static int cmd_backtest(const CliArgs *args) {
     goto cleanup;
 
   /* Connect to database */
-  data = samtrader_postgres_adapter_create(arena, conninfo);
+  data = open_data_port(arena, settings.conninfo, settings.cache_path);
   if (!data) {
-    fprintf(stderr, "Error: failed to connect to database\n");
     rc = EXIT_DB_ERROR;
     goto cleanup;
   }
 
-  /* Validate universe against data source */
-  int valid_count = samtrader_universe_validate(universe, data, start_date, end_date);
-  if (valid_count < 0) {
-    fprintf(stderr, "Error: no valid codes in universe\n");
-    rc = EXIT_INSUFFICIENT_DATA;
+  /* Validate the universe and load per-code data */
+  SamtraderCodeData **code_data_arr = NULL;
+  rc = load_universe_data(arena, data, &settings, &code_data_arr);
+  if (rc != 0)
     goto cleanup;
-  }
 
-  /* Load per-code data, compute indicators, build date indices */
-  printf("Loading universe (%zu codes)...\n", universe->count);
+  SamtraderStrategyProgram *programs =
+      SAMRENA_PUSH_ARRAY_ZERO(arena, SamtraderStrategyProgram, universe->count);
 
-  SamtraderCodeData **code_data_arr =
-      SAMRENA_PUSH_ARRAY_ZERO(arena, SamtraderCodeData *, universe->count);
-  SamHashMap **date_indices = SAMRENA_PUSH_ARRAY_ZERO(arena, SamHashMap *, universe->count);
+  /* Compute indicators on the worker pool; series stay in the worker arenas */
+  pool = samtrader_worker_pool_create(args->jobs > 0 ? args->jobs : 1);
+  if (!pool) {
+    fprintf(stderr, "Error: failed to create worker pool\n");
+    rc = EXIT_GENERAL_ERROR;
+    goto cleanup;
+  }
+  indicator_cache = open_indicator_cache(arena, &settings);
+  if (samtrader_code_data_compute_indicators_parallel(pool, code_data_arr, universe->count,
+                                                      &strategy, 1, indicator_cache) < 0) {
+    fprintf(stderr, "Error: failed to compute indicators\n");
+    rc = EXIT_GENERAL_ERROR;
+    goto cleanup;
+  }
+  print_indicator_cache_stats(indicator_cache);
 
   for (size_t c = 0; c < universe->count; c++) {
-    code_data_arr[c] =
-        samtrader_load_code_data(arena, data, universe->codes[c], exchange, start_date, end_date);
-    if (!code_data_arr[c]) {
-      fprintf(stderr, "Error: failed to load data for %s\n", universe->codes[c]);
-      rc = EXIT_DB_ERROR;
-      goto cleanup;
-    }
-    printf("  Validated %s: %zu bars\n", universe->codes[c],
-           samrena_vector_size(code_data_arr[c]->ohlcv));
-    if (samtrader_code_data_compute_indicators(arena, code_data_arr[c], &strategy) < 0) {
-      fprintf(stderr, "Error: failed to compute indicators for %s\n", universe->codes[c]);
-      rc = EXIT_GENERAL_ERROR;
-      goto cleanup;
-    }
-    date_indices[c] = samtrader_build_date_index(arena, code_data_arr[c]->ohlcv);
-    if (!date_indices[c]) {
-      fprintf(stderr, "Error: failed to build date index for %s\n", universe->codes[c]);
+    if (samtrader_strategy_compile(arena, &strategy, code_data_arr[c], &programs[c]) < 0) {
+      fprintf(stderr, "Error: failed to compile strategy rules for %s\n", universe->codes[c]);
       rc = EXIT_GENERAL_ERROR;
       goto cleanup;
     }
   }
 
-  /* Build unified date timeline */
-  SamrenaVector *timeline = samtrader_build_date_timeline(arena, code_data_arr, universe->count);
-  if (!timeline || samrena_vector_size(timeline) == 0) {
+  /* Build unified date timeline aligned to each code's bars */
+  SamtraderTimeline *timeline = samtrader_timeline_build(arena, code_data_arr, universe->count);
+  if (!timeline || timeline->date_count == 0) {
     fprintf(stderr, "Error: empty date timeline\n");
     rc = EXIT_INSUFFICIENT_DATA;
     goto cleanup;
   }
-  printf("Timeline: %zu trading days\n", samrena_vector_size(timeline));
+  printf("Timeline: %zu trading days\n", timeline->date_count);
 
-  /* Create portfolio */
-  SamtraderPortfolio *portfolio = samtrader_portfolio_create(arena, initial_capital);
+  /* Run the simulation over the unified timeline */
+  SamtraderPortfolio *portfolio = samtrader_backtest_run(arena, &settings.backtest, &strategy,
+                                                         code_data_arr, programs, timeline);
   if (!portfolio) {
-    fprintf(stderr, "Error: failed to create portfolio\n");
+    fprintf(stderr, "Error: failed to run backtest\n");
     rc = EXIT_GENERAL_ERROR;
     goto cleanup;
   }
 
-  /* Main backtest loop - iterate unified timeline */
-  for (size_t t = 0; t < samrena_vector_size(timeline); t++) {
-    time_t date = *(const time_t *)samrena_vector_at_const(timeline, t);
-
-    /* Build composite price_map from all codes with bars on this date */
-    SamHashMap *price_map = samhashmap_create(universe->count * 2, arena);
-    if (!price_map)
-      continue;
-
-    char date_key[DATE_KEY_BUF_SIZE];
-    snprintf(date_key, sizeof(date_key), "%ld", (long)date);
-
-    for (size_t c = 0; c < universe->count; c++) {
-      size_t *bar_idx = (size_t *)samhashmap_get(date_indices[c], date_key);
-      if (!bar_idx)
-        continue;
-      const SamtraderOhlcv *bar =
-          (const SamtraderOhlcv *)samrena_vector_at_const(code_data_arr[c]->ohlcv, *bar_idx);
-      double *price = SAMRENA_PUSH_TYPE(arena, double);
-      if (!price)
-        continue;
-      *price = bar->close;
-      samhashmap_put(price_map, code_data_arr[c]->code, price);
-    }
-
-    /* Check stop loss / take profit triggers across all positions */
-    samtrader_execution_check_triggers(portfolio, arena, price_map, date, commission_flat,
-                                       commission_pct, slippage_pct);
-
-    /* For each code with data on this date */
-    for (size_t c = 0; c < universe->count; c++) {
-      size_t *bar_idx = (size_t *)samhashmap_get(date_indices[c], date_key);
-      if (!bar_idx)
-        continue;
-
-      const SamtraderOhlcv *bar =
-          (const SamtraderOhlcv *)samrena_vector_at_const(code_data_arr[c]->ohlcv, *bar_idx);
-      const char *code = code_data_arr[c]->code;
-
-      /* Evaluate exit rules for existing positions */
-      if (samtrader_portfolio_has_position(portfolio, code)) {
-        SamtraderPosition *pos = samtrader_portfolio_get_position(portfolio, code);
-        bool should_exit = false;
-        if (pos && samtrader_position_is_long(pos)) {
-          should_exit = samtrader_rule_evaluate(strategy.exit_long, code_data_arr[c]->ohlcv,
-                                                code_data_arr[c]->indicators, *bar_idx);
-        } else if (pos && samtrader_position_is_short(pos) && strategy.exit_short) {
-          should_exit = samtrader_rule_evaluate(strategy.exit_short, code_data_arr[c]->ohlcv,
-                                                code_data_arr[c]->indicators, *bar_idx);
-        }
-        if (should_exit) {
-          samtrader_execution_exit_position(portfolio, arena, code, bar->close, date,
-                                            commission_flat, commission_pct, slippage_pct);
-        }
-      }
-
-      /* Evaluate entry rules (max_positions enforced globally) */
-      if (!samtrader_portfolio_has_position(portfolio, code)) {
-        bool enter_long = samtrader_rule_evaluate(strategy.entry_long, code_data_arr[c]->ohlcv,
-                                                  code_data_arr[c]->indicators, *bar_idx);
-        bool enter_short =
-            allow_shorting && strategy.entry_short
-                ? samtrader_rule_evaluate(strategy.entry_short, code_data_arr[c]->ohlcv,
-                                          code_data_arr[c]->indicators, *bar_idx)
-                : false;
-
-        if (enter_long) {
-          samtrader_execution_enter_long(portfolio, arena, code, exchange, bar->close, date,
-                                         strategy.position_size, strategy.stop_loss_pct,
-                                         strategy.take_profit_pct, strategy.max_positions,
-                                         commission_flat, commission_pct, slippage_pct);
-        } else if (enter_short) {
-          samtrader_execution_enter_short(portfolio, arena, code, exchange, bar->close, date,
-                                          strategy.position_size, strategy.stop_loss_pct,
-                                          strategy.take_profit_pct, strategy.max_positions,
-                                          commission_flat, commission_pct, slippage_pct);
-        }
-      }
-    }
-
-    /* Record equity (cash + all position market values) */
-    double equity = samtrader_portfolio_total_equity(portfolio, price_map);
-    samtrader_portfolio_record_equity(portfolio, arena, date, equity);
-  }
-
   /* Calculate metrics */
-  SamtraderMetrics *metrics = samtrader_metrics_calculate(arena, portfolio->closed_trades,
-                                                          portfolio->equity_curve, risk_free_rate);
+  SamtraderMetrics *metrics = samtrader_metrics_calculate(
+      arena, portfolio->closed_trades, portfolio->equity_curve, settings.risk_free_rate);
   if (!metrics) {
     fprintf(stderr, "Error: failed to calculate metrics\n");
     rc = EXIT_GENERAL_ERROR;
@@ -633,6 +835,16 @@ static int cmd_backtest(const CliArgs *args) {
   result->equity_curve = portfolio->equity_curve;
   result->trades = portfolio->closed_trades;
 
+  /* Resample the run for confidence intervals (runs alongside the indicator series) */
+  if (montecarlo.samples > 0) {
+    result->montecarlo = samtrader_montecarlo_run(arena, pool, &montecarlo,
+                                                  portfolio->closed_trades,
+                                                  portfolio->equity_curve);
+    if (!result->montecarlo) {
+      fprintf(stderr, "Warning: Monte Carlo skipped (not enough trades or bars)\n");
+    }
+  }
+
   /* Compute per-code metrics (before report generation) */
   SamtraderCodeResult *code_results = NULL;
   if (universe->count > 1) {
@@ -645,6 +857,10 @@ static int cmd_backtest(const CliArgs *args) {
   const char *template_path = config->get_string(config, "report", "template_path");
   report = samtrader_typst_adapter_create(arena, template_path);
   if (report) {
+    int chart_points = config->get_int(config, "report", "chart_points", 200);
+    if (chart_points > 0) {
+      samtrader_typst_adapter_set_chart_points(report, (size_t)chart_points);
+    }
     if (report->write_multi && universe->count > 1 && code_results) {
       SamtraderMultiCodeResult multi = {.aggregate = *result,
                                         .code_results = code_results,
@@ -658,6 +874,9 @@ static int cmd_backtest(const CliArgs *args) {
 
   /* Print metrics summary */
   samtrader_metrics_print(metrics);
+  if (result->montecarlo) {
+    samtrader_montecarlo_print(result->montecarlo);
+  }
 
   /* Print per-code metrics to console */
   if (code_results && universe->count > 1) {
@@ -677,6 +896,358 @@ static int cmd_backtest(const CliArgs *args) {
 cleanup:
   if (report)
     report->close(report);
+  if (indicator_cache)
+    indicator_cache->close(indicator_cache);
+  if (data)
+    data->close(data);
+  if (config)
+    config->close(config);
+  samtrader_worker_pool_destroy(pool);
+  samrena_destroy(arena);
+  return rc;
+}
+
+/* Inputs shared by the sweep and walkforward commands, loaded once for every variant */
+typedef struct {
+  SamtraderConfigPort *config;
+  SamtraderDataPort *data;
+  SamtraderIndicatorCachePort *indicator_cache;
+  SamtraderWorkerPool *indicator_pool;
+  SamtraderWorkerPool *sim_pool;
+  RunSettings settings;
+  SamtraderSweepGrid grid;
+  SamtraderSweepRun run;
+} SweepSession;
+
+/* Read the config and expand the strategy template into one strategy per variant */
+static int sweep_session_open(const CliArgs *args, Samrena *arena, SweepSession *session) {
+  memset(session, 0, sizeof(*session));
+
+  session->config = samtrader_file_config_adapter_create(arena, args->config_path);
+  if (!session->config) {
+    fprintf(stderr, "Error: failed to load config: %s\n", args->config_path);
+    return EXIT_CONFIG_ERROR;
+  }
+
+  RunSettings *settings = &session->settings;
+  int rc = read_run_settings(args, session->config, arena, settings);
+  if (rc != 0)
+    return rc;
+
+  StrategyText text;
+  rc = load_strategy_text(args, session->config, arena, &text);
+  if (rc != 0)
+    return rc;
+
+  SamtraderSweepGrid *grid = &session->grid;
+  samtrader_sweep_grid_init(grid);
+  const char *const *rule_texts[] = {&text.entry_long, &text.exit_long, &text.entry_short,
+                                     &text.exit_short};
+  size_t rule_count = sizeof(rule_texts) / sizeof(rule_texts[0]);
+  for (size_t r = 0; r < rule_count; r++) {
+    if (samtrader_sweep_grid_scan(grid, *rule_texts[r]) < 0) {
+      fprintf(stderr, "Error: invalid sweep parameter in rule: %s\n", *rule_texts[r]);
+      return EXIT_INVALID_STRATEGY;
+    }
+  }
+
+  SamtraderStrategy *strategies =
+      SAMRENA_PUSH_ARRAY_ZERO(arena, SamtraderStrategy, grid->variant_count);
+  if (!strategies) {
+    fprintf(stderr, "Error: failed to allocate %zu sweep variants\n", grid->variant_count);
+    return EXIT_GENERAL_ERROR;
+  }
+
+  for (size_t v = 0; v < grid->variant_count; v++) {
+    StrategyText variant = text;
+    const char **variant_texts[] = {&variant.entry_long, &variant.exit_long,
+                                    &variant.entry_short, &variant.exit_short};
+    for (size_t r = 0; r < rule_count; r++) {
+      if (!*variant_texts[r])
+        continue;
+      *variant_texts[r] = samtrader_sweep_expand(arena, grid, *variant_texts[r], v);
+      if (!*variant_texts[r]) {
+        fprintf(stderr, "Error: unknown or malformed sweep parameter in rule: %s\n",
+                *rule_texts[r]);
+        return EXIT_INVALID_STRATEGY;
+      }
+    }
+    rc = parse_strategy_text(arena, &variant, &strategies[v]);
+    if (rc != 0)
+      return rc;
+  }
+
+  session->run = (SamtraderSweepRun){.strategies = strategies,
+                                     .strategy_count = grid->variant_count,
+                                     .config = &settings->backtest,
+                                     .risk_free_rate = settings->risk_free_rate};
+  return 0;
+}
+
+/* Load the universe, compute every variant's indicators and build the timeline */
+static int sweep_session_load(const CliArgs *args, Samrena *arena, SweepSession *session) {
+  RunSettings *settings = &session->settings;
+  session->data = open_data_port(arena, settings->conninfo, settings->cache_path);
+  if (!session->data)
+    return EXIT_DB_ERROR;
+
+  SamtraderCodeData **code_data_arr = NULL;
+  int rc = load_universe_data(arena, session->data, settings, &code_data_arr);
+  if (rc != 0)
+    return rc;
+  size_t code_count = settings->universe->count;
+
+  int jobs = args->jobs;
+  if (jobs <= 0) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    jobs = cpus > 0 ? (int)(cpus < SAMTRADER_MAX_WORKERS ? cpus : SAMTRADER_MAX_WORKERS) : 1;
+  }
+
+  /* Indicator series are keyed, so variants sharing a parameter share the series */
+  session->indicator_pool = samtrader_worker_pool_create(jobs);
+  session->sim_pool = samtrader_worker_pool_create(jobs);
+  if (!session->indicator_pool || !session->sim_pool) {
+    fprintf(stderr, "Error: failed to create worker pool\n");
+    return EXIT_GENERAL_ERROR;
+  }
+  session->indicator_cache = open_indicator_cache(arena, settings);
+  if (samtrader_code_data_compute_indicators_parallel(
+          session->indicator_pool, code_data_arr, code_count, session->run.strategies,
+          session->run.strategy_count, session->indicator_cache) < 0) {
+    fprintf(stderr, "Error: failed to compute indicators\n");
+    return EXIT_GENERAL_ERROR;
+  }
+  print_indicator_cache_stats(session->indicator_cache);
+
+  SamtraderTimeline *timeline = samtrader_timeline_build(arena, code_data_arr, code_count);
+  if (!timeline || timeline->date_count == 0) {
+    fprintf(stderr, "Error: empty date timeline\n");
+    return EXIT_INSUFFICIENT_DATA;
+  }
+  printf("Timeline: %zu trading days\n", timeline->date_count);
+
+  session->run.code_data = code_data_arr;
+  session->run.timeline = timeline;
+  return 0;
+}
+
+static void sweep_session_close(SweepSession *session) {
+  if (session->indicator_cache)
+    session->indicator_cache->close(session->indicator_cache);
+  if (session->data)
+    session->data->close(session->data);
+  if (session->config)
+    session->config->close(session->config);
+  samtrader_worker_pool_destroy(session->sim_pool);
+  samtrader_worker_pool_destroy(session->indicator_pool);
+}
+
+/* Print a variant's parameters as ": a=1, b=2" */
+static void print_variant_values(const SamtraderSweepGrid *grid, size_t variant) {
+  double values[SAMTRADER_SWEEP_MAX_PARAMS];
+  samtrader_sweep_variant_values(grid, variant, values);
+  for (size_t i = 0; i < grid->param_count; i++)
+    printf("%s %s=%g", i == 0 ? ":" : ",", grid->params[i].name, values[i]);
+}
+
+static int cmd_sweep(const CliArgs *args) {
+  Samrena *arena = samrena_create_default();
+  if (!arena) {
+    fprintf(stderr, "Error: failed to create memory arena\n");
+    return EXIT_GENERAL_ERROR;
+  }
+
+  SweepSession session;
+  int rc = sweep_session_open(args, arena, &session);
+  if (rc != 0)
+    goto cleanup;
+  const SamtraderSweepGrid *grid = &session.grid;
+  printf("Sweep: %zu parameters, %zu variants\n", grid->param_count, grid->variant_count);
+
+  SamtraderMetrics *results = SAMRENA_PUSH_ARRAY_ZERO(arena, SamtraderMetrics, grid->variant_count);
+  if (!results) {
+    fprintf(stderr, "Error: failed to allocate %zu sweep variants\n", grid->variant_count);
+    rc = EXIT_GENERAL_ERROR;
+    goto cleanup;
+  }
+
+  rc = sweep_session_load(args, arena, &session);
+  if (rc != 0)
+    goto cleanup;
+
+  printf("Running %zu variants on %zu workers...\n", grid->variant_count,
+         samtrader_worker_pool_size(session.sim_pool));
+  if (samtrader_sweep_run(session.sim_pool, &session.run, results) < 0) {
+    fprintf(stderr, "Error: sweep backtest failed\n");
+    rc = EXIT_GENERAL_ERROR;
+    goto cleanup;
+  }
+
+  const char *output_path = args->output_path ? args->output_path : "sweep_results.csv";
+  SamtraderExportPort *export = samtrader_csv_export_adapter_create(arena);
+  bool written = export && export->write_sweep(export, output_path, grid, results);
+  if (export)
+    export->close(export);
+  if (!written) {
+    fprintf(stderr, "Error: failed to write sweep results: %s\n", output_path);
+    rc = EXIT_GENERAL_ERROR;
+    goto cleanup;
+  }
+  printf("Results written to: %s\n", output_path);
+
+  size_t best = 0;
+  for (size_t v = 1; v < grid->variant_count; v++) {
+    if (results[v].sharpe_ratio > results[best].sharpe_ratio)
+      best = v;
+  }
+  printf("Best Sharpe ratio: %.4f (variant %zu", results[best].sharpe_ratio, best);
+  print_variant_values(grid, best);
+  printf(")\n");
+
+cleanup:
+  sweep_session_close(&session);
+  samrena_destroy(arena);
+  return rc;
+}
+
+static int cmd_walkforward(const CliArgs *args) {
+  Samrena *arena = samrena_create_default();
+  if (!arena) {
+    fprintf(stderr, "Error: failed to create memory arena\n");
+    return EXIT_GENERAL_ERROR;
+  }
+
+  SweepSession session;
+  int rc = sweep_session_open(args, arena, &session);
+  if (rc != 0)
+    goto cleanup;
+  const SamtraderSweepGrid *grid = &session.grid;
+
+  SamtraderConfigPort *config = session.config;
+  int in_sample = config->get_int(config, "walkforward", "in_sample", 0);
+  int out_of_sample = config->get_int(config, "walkforward", "out_of_sample", 0);
+  if (in_sample <= 0 || out_of_sample <= 0) {
+    fprintf(stderr, "Error: walkforward requires positive [walkforward] in_sample and "
+                    "out_of_sample\n");
+    rc = EXIT_CONFIG_ERROR;
+    goto cleanup;
+  }
+  SamtraderWalkForwardConfig wf = {
+      .in_sample = (size_t)in_sample,
+      .out_of_sample = (size_t)out_of_sample,
+      .anchored = config->get_bool(config, "walkforward", "anchored", false)};
+  printf("Walk-forward: %zu variants, %d in-sample / %d out-of-sample dates%s\n",
+         grid->variant_count, in_sample, out_of_sample, wf.anchored ? " (anchored)" : "");
+
+  rc = sweep_session_load(args, arena, &session);
+  if (rc != 0)
+    goto cleanup;
+
+  const SamtraderTimeline *timeline = session.run.timeline;
+  size_t window_count = samtrader_walkforward_window_count(&wf, timeline->date_count);
+  if (window_count == 0) {
+    fprintf(stderr, "Error: timeline of %zu dates is too short for one walk-forward window\n",
+            timeline->date_count);
+    rc = EXIT_INSUFFICIENT_DATA;
+    goto cleanup;
+  }
+
+  printf("Running %zu windows on %zu workers...\n", window_count,
+         samtrader_worker_pool_size(session.sim_pool));
+  SamtraderWalkForwardResult *result =
+      samtrader_walkforward_run(arena, session.sim_pool, &session.run, &wf);
+  if (!result) {
+    fprintf(stderr, "Error: walk-forward backtest failed\n");
+    rc = EXIT_GENERAL_ERROR;
+    goto cleanup;
+  }
+
+  const char *output_path = args->output_path ? args->output_path : "walkforward_results.csv";
+  SamtraderExportPort *export = samtrader_csv_export_adapter_create(arena);
+  bool written =
+      export && export->write_walkforward(export, output_path, grid, timeline, result);
+  if (export)
+    export->close(export);
+  if (!written) {
+    fprintf(stderr, "Error: failed to write walk-forward results: %s\n", output_path);
+    rc = EXIT_GENERAL_ERROR;
+    goto cleanup;
+  }
+  printf("Results written to: %s\n", output_path);
+
+  for (size_t w = 0; w < result->window_count; w++) {
+    const SamtraderWalkForwardWindow *win = &result->windows[w];
+    printf("  Window %zu: in-sample Sharpe %.4f, out-of-sample return %.2f%% (variant %zu", w,
+           win->in_sample.sharpe_ratio, win->out_of_sample.total_return * 100.0,
+           win->best_variant);
+    print_variant_values(grid, win->best_variant);
+    printf(")\n");
+  }
+
+  /* Out-of-sample performance of the stitched curve */
+  SamtraderMetrics *metrics = samtrader_metrics_calculate(
+      arena, result->trades, result->equity_curve, session.settings.risk_free_rate);
+  if (!metrics) {
+    fprintf(stderr, "Error: failed to calculate metrics\n");
+    rc = EXIT_GENERAL_ERROR;
+    goto cleanup;
+  }
+  printf("\nOut-of-sample (stitched):\n");
+  samtrader_metrics_print(metrics);
+
+cleanup:
+  sweep_session_close(&session);
+  samrena_destroy(arena);
+  return rc;
+}
+
+static int cmd_cache_build(const CliArgs *args) {
+  int rc = EXIT_SUCCESS;
+  Samrena *arena = samrena_create_default();
+  if (!arena) {
+    fprintf(stderr, "Error: failed to create memory arena\n");
+    return EXIT_GENERAL_ERROR;
+  }
+
+  SamtraderConfigPort *config = NULL;
+  SamtraderDataPort *data = NULL;
+
+  config = samtrader_file_config_adapter_create(arena, args->config_path);
+  if (!config) {
+    fprintf(stderr, "Error: failed to load config: %s\n", args->config_path);
+    rc = EXIT_CONFIG_ERROR;
+    goto cleanup;
+  }
+
+  RunSettings settings;
+  rc = read_run_settings(args, config, arena, &settings);
+  if (rc != 0)
+    goto cleanup;
+  if (!settings.conninfo) {
+    fprintf(stderr, "Error: cache build requires [database] conninfo\n");
+    rc = EXIT_CONFIG_ERROR;
+    goto cleanup;
+  }
+
+  data = samtrader_postgres_adapter_create(arena, settings.conninfo);
+  if (!data) {
+    fprintf(stderr, "Error: failed to connect to database\n");
+    rc = EXIT_DB_ERROR;
+    goto cleanup;
+  }
+
+  SamtraderUniverse *universe = settings.universe;
+  printf("Caching %zu codes on %s...\n", universe->count, settings.exchange);
+  if (samtrader_mmap_cache_build(args->output_path, data, (const char *const *)universe->codes,
+                                 universe->count, settings.exchange,
+                                 settings.backtest.start_date, settings.backtest.end_date) != 0) {
+    fprintf(stderr, "Error: failed to write cache file: %s\n", args->output_path);
+    rc = EXIT_DB_ERROR;
+    goto cleanup;
+  }
+  printf("Cache written to: %s\n", args->output_path);
+
+cleanup:
   if (data)
     data->close(data);
   if (config)
@@ -695,25 +1266,26 @@ static int cmd_list_symbols(const CliArgs *args) {
 
   SamtraderDataPort *data = NULL;
   const char *conninfo = NULL;
+  const char *cache_path = NULL;
 
   if (args->config_path) {
     SamtraderConfigPort *config = samtrader_file_config_adapter_create(arena, args->config_path);
     if (config) {
       conninfo = config->get_string(config, "database", "conninfo");
+      cache_path = config->get_string(config, "database", "cache");
       config->close(config);
     }
   }
-  if (!conninfo)
+  if (!conninfo && !cache_path)
     conninfo = getenv("SAMTRADER_DB");
-  if (!conninfo) {
+  if (!conninfo && !cache_path) {
     fprintf(stderr, "Error: no database connection (use -c config or SAMTRADER_DB env)\n");
     rc = EXIT_DB_ERROR;
     goto cleanup;
   }
 
-  data = samtrader_postgres_adapter_create(arena, conninfo);
+  data = open_data_port(arena, conninfo, cache_path);
   if (!data) {
-    fprintf(stderr, "Error: failed to connect to database\n");
     rc = EXIT_DB_ERROR;
     goto cleanup;
   }
@@ -771,31 +1343,51 @@ static int cmd_validate(const CliArgs *args) {
   return rc;
 }
 
+/* Summarise a symbol's data, by count-only query when the port has one */
+static int summarize_code(SamtraderDataPort *data, const char *code, const char *exchange,
+                          time_t start_date, time_t end_date, SamtraderOhlcvSummary *out) {
+  if (data->fetch_summary)
+    return data->fetch_summary(data, code, exchange, start_date, end_date, out);
+
+  memset(out, 0, sizeof(*out));
+  SamrenaVector *ohlcv = data->fetch_ohlcv(data, code, exchange, start_date, end_date);
+  if (!ohlcv)
+    return -1;
+  size_t count = samrena_vector_size(ohlcv);
+  if (count == 0)
+    return 0;
+  const SamtraderOhlcv *first = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, 0);
+  const SamtraderOhlcv *last = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, count - 1);
+  out->bar_count = count;
+  out->first_date = first->date;
+  out->last_date = last->date;
+  out->first_close = first->close;
+  out->last_close = last->close;
+  return 0;
+}
+
 static int print_code_info(SamtraderDataPort *data, const char *code, const char *exchange) {
   time_t epoch_start = 0;
   time_t epoch_end = (time_t)4102444800; /* 2100-01-01 */
-  SamrenaVector *ohlcv = data->fetch_ohlcv(data, code, exchange, epoch_start, epoch_end);
-  if (!ohlcv || samrena_vector_size(ohlcv) == 0) {
+  SamtraderOhlcvSummary summary;
+  if (summarize_code(data, code, exchange, epoch_start, epoch_end, &summary) != 0 ||
+      summary.bar_count == 0) {
     fprintf(stderr, "Error: no data found for %s.%s\n", code, exchange);
     return EXIT_INSUFFICIENT_DATA;
   }
 
-  size_t count = samrena_vector_size(ohlcv);
-  const SamtraderOhlcv *first = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, 0);
-  const SamtraderOhlcv *last = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, count - 1);
-
   char first_date_str[32], last_date_str[32];
   struct tm first_tm, last_tm;
-  localtime_r(&first->date, &first_tm);
-  localtime_r(&last->date, &last_tm);
+  localtime_r(&summary.first_date, &first_tm);
+  localtime_r(&summary.last_date, &last_tm);
   strftime(first_date_str, sizeof(first_date_str), "%Y-%m-%d", &first_tm);
   strftime(last_date_str, sizeof(last_date_str), "%Y-%m-%d", &last_tm);
 
   printf("Symbol: %s.%s\n", code, exchange);
   printf("Date Range: %s to %s\n", first_date_str, last_date_str);
-  printf("Total Bars: %zu\n", count);
-  printf("First Close: %.2f\n", first->close);
-  printf("Last Close: %.2f\n", last->close);
+  printf("Total Bars: %zu\n", summary.bar_count);
+  printf("First Close: %.2f\n", summary.first_close);
+  printf("Last Close: %.2f\n", summary.last_close);
 
   return EXIT_SUCCESS;
 }
@@ -811,27 +1403,28 @@ static int cmd_info(const CliArgs *args) {
   SamtraderDataPort *data = NULL;
   SamtraderConfigPort *config = NULL;
   const char *conninfo = NULL;
+  const char *cache_path = NULL;
   const char *exchange = args->exchange;
 
   if (args->config_path) {
     config = samtrader_file_config_adapter_create(arena, args->config_path);
     if (config) {
       conninfo = config->get_string(config, "database", "conninfo");
+      cache_path = config->get_string(config, "database", "cache");
       if (!exchange)
         exchange = config->get_string(config, "backtest", "exchange");
     }
   }
-  if (!conninfo)
+  if (!conninfo && !cache_path)
     conninfo = getenv("SAMTRADER_DB");
-  if (!conninfo) {
+  if (!conninfo && !cache_path) {
     fprintf(stderr, "Error: no database connection (use -c config or SAMTRADER_DB env)\n");
     rc = EXIT_DB_ERROR;
     goto cleanup;
   }
 
-  data = samtrader_postgres_adapter_create(arena, conninfo);
+  data = open_data_port(arena, conninfo, cache_path);
   if (!data) {
-    fprintf(stderr, "Error: failed to connect to database\n");
     rc = EXIT_DB_ERROR;
     goto cleanup;
   }
@@ -900,6 +1493,12 @@ int main(int argc, char *argv[]) {
   switch (cmd) {
     case CMD_BACKTEST:
       return cmd_backtest(&args);
+    case CMD_SWEEP:
+      return cmd_sweep(&args);
+    case CMD_WALKFORWARD:
+      return cmd_walkforward(&args);
+    case CMD_CACHE_BUILD:
+      return cmd_cache_build(&args);
     case CMD_LIST_SYMBOLS:
       return cmd_list_symbols(&args);
     case CMD_VALIDATE:
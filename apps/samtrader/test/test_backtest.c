@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "samtrader/domain/backtest.h"
 #include "samtrader/domain/code_data.h"
 #include "samtrader/domain/execution.h"
 #include "samtrader/domain/indicator.h"
@@ -26,6 +27,7 @@
 #include "samtrader/domain/ohlcv.h"
 #include "samtrader/domain/portfolio.h"
 #include "samtrader/domain/rule.h"
+#include "samtrader/domain/rule_program.h"
 #include "samtrader/domain/strategy.h"
 #include "samtrader/domain/universe.h"
 
@@ -617,7 +619,8 @@ static SamtraderCodeData *make_code_data(Samrena *arena, const char *code, const
     return NULL;
   cd->code = code;
   cd->exchange = exchange;
-  cd->ohlcv = make_ohlcv_for_code(arena, code, exchange, closes, count, day_offset);
+  cd->bars = samtrader_bar_columns_from_ohlcv(
+      arena, make_ohlcv_for_code(arena, code, exchange, closes, count, day_offset));
   cd->bar_count = count;
   cd->indicators = samhashmap_create(4, arena);
   return cd;
@@ -632,6 +635,13 @@ static int run_multicode_backtest_loop(Samrena *arena, SamtraderCodeData **code_
                                        SamtraderPortfolio *portfolio, const char *exchange,
                                        double commission_flat, double commission_pct,
                                        double slippage_pct, bool allow_shorting) {
+  /* The tree-walking evaluator reads bars as rows */
+  SamrenaVector **rows = SAMRENA_PUSH_ARRAY(arena, SamrenaVector *, code_count);
+  if (!rows)
+    return -1;
+  for (size_t c = 0; c < code_count; c++)
+    rows[c] = samtrader_ohlcv_from_bar_columns(arena, code_data_arr[c]->bars);
+
   for (size_t t = 0; t < samrena_vector_size(timeline); t++) {
     time_t date = *(const time_t *)samrena_vector_at_const(timeline, t);
 
@@ -647,7 +657,7 @@ static int run_multicode_backtest_loop(Samrena *arena, SamtraderCodeData **code_
       if (!bar_idx)
         continue;
       const SamtraderOhlcv *bar =
-          (const SamtraderOhlcv *)samrena_vector_at_const(code_data_arr[c]->ohlcv, *bar_idx);
+          (const SamtraderOhlcv *)samrena_vector_at_const(rows[c], *bar_idx);
       double *price = SAMRENA_PUSH_TYPE(arena, double);
       if (!price)
         continue;
@@ -664,17 +674,17 @@ static int run_multicode_backtest_loop(Samrena *arena, SamtraderCodeData **code_
         continue;
 
       const SamtraderOhlcv *bar =
-          (const SamtraderOhlcv *)samrena_vector_at_const(code_data_arr[c]->ohlcv, *bar_idx);
+          (const SamtraderOhlcv *)samrena_vector_at_const(rows[c], *bar_idx);
       const char *code = code_data_arr[c]->code;
 
       if (samtrader_portfolio_has_position(portfolio, code)) {
         SamtraderPosition *pos = samtrader_portfolio_get_position(portfolio, code);
         bool should_exit = false;
         if (pos && samtrader_position_is_long(pos)) {
-          should_exit = samtrader_rule_evaluate(strategy->exit_long, code_data_arr[c]->ohlcv,
+          should_exit = samtrader_rule_evaluate(strategy->exit_long, rows[c],
                                                 code_data_arr[c]->indicators, *bar_idx);
         } else if (pos && samtrader_position_is_short(pos) && strategy->exit_short) {
-          should_exit = samtrader_rule_evaluate(strategy->exit_short, code_data_arr[c]->ohlcv,
+          should_exit = samtrader_rule_evaluate(strategy->exit_short, rows[c],
                                                 code_data_arr[c]->indicators, *bar_idx);
         }
         if (should_exit) {
@@ -684,11 +694,11 @@ static int run_multicode_backtest_loop(Samrena *arena, SamtraderCodeData **code_
       }
 
       if (!samtrader_portfolio_has_position(portfolio, code)) {
-        bool enter_long = samtrader_rule_evaluate(strategy->entry_long, code_data_arr[c]->ohlcv,
+        bool enter_long = samtrader_rule_evaluate(strategy->entry_long, rows[c],
                                                   code_data_arr[c]->indicators, *bar_idx);
         bool enter_short =
             allow_shorting && strategy->entry_short
-                ? samtrader_rule_evaluate(strategy->entry_short, code_data_arr[c]->ohlcv,
+                ? samtrader_rule_evaluate(strategy->entry_short, rows[c],
                                           code_data_arr[c]->indicators, *bar_idx)
                 : false;
 
@@ -734,8 +744,8 @@ static int test_multicode_both_enter(void) {
 
   SamtraderCodeData *code_data_arr[] = {cd_a, cd_b};
   SamHashMap *date_indices[2];
-  date_indices[0] = samtrader_build_date_index(arena, cd_a->ohlcv);
-  date_indices[1] = samtrader_build_date_index(arena, cd_b->ohlcv);
+  date_indices[0] = samtrader_build_date_index(arena, cd_a->bars);
+  date_indices[1] = samtrader_build_date_index(arena, cd_b->bars);
   ASSERT(date_indices[0] && date_indices[1], "Failed to build date indices");
 
   SamrenaVector *timeline = samtrader_build_date_timeline(arena, code_data_arr, 2);
@@ -827,8 +837,8 @@ static int test_multicode_max_positions(void) {
 
   SamtraderCodeData *code_data_arr[] = {cd_a, cd_b};
   SamHashMap *date_indices[2];
-  date_indices[0] = samtrader_build_date_index(arena, cd_a->ohlcv);
-  date_indices[1] = samtrader_build_date_index(arena, cd_b->ohlcv);
+  date_indices[0] = samtrader_build_date_index(arena, cd_a->bars);
+  date_indices[1] = samtrader_build_date_index(arena, cd_b->bars);
 
   SamrenaVector *timeline = samtrader_build_date_timeline(arena, code_data_arr, 2);
   ASSERT(timeline != NULL, "Failed to build timeline");
@@ -893,8 +903,8 @@ static int test_multicode_disjoint_dates(void) {
 
   SamtraderCodeData *code_data_arr[] = {cd_a, cd_b};
   SamHashMap *date_indices[2];
-  date_indices[0] = samtrader_build_date_index(arena, cd_a->ohlcv);
-  date_indices[1] = samtrader_build_date_index(arena, cd_b->ohlcv);
+  date_indices[0] = samtrader_build_date_index(arena, cd_a->bars);
+  date_indices[1] = samtrader_build_date_index(arena, cd_b->bars);
 
   SamrenaVector *timeline = samtrader_build_date_timeline(arena, code_data_arr, 2);
   ASSERT(timeline != NULL, "Failed to build timeline");
@@ -997,8 +1007,8 @@ static int test_multicode_per_code_metrics(void) {
 
   SamtraderCodeData *code_data_arr[] = {cd_a, cd_b};
   SamHashMap *date_indices[2];
-  date_indices[0] = samtrader_build_date_index(arena, cd_a->ohlcv);
-  date_indices[1] = samtrader_build_date_index(arena, cd_b->ohlcv);
+  date_indices[0] = samtrader_build_date_index(arena, cd_a->bars);
+  date_indices[1] = samtrader_build_date_index(arena, cd_b->bars);
   ASSERT(date_indices[0] && date_indices[1], "Failed to build date indices");
 
   SamrenaVector *timeline = samtrader_build_date_timeline(arena, code_data_arr, 2);
@@ -1127,6 +1137,247 @@ static int test_multicode_per_code_metrics(void) {
   return 0;
 }
 
+/*============================================================================
+ * Fill and Trigger Policies (samtrader_backtest_run)
+ *============================================================================*/
+
+/* Run samtrader_backtest_run over one code whose bars are {open, high, low, close};
+ * with metrics set, run samtrader_backtest_run_streaming into it instead */
+static SamtraderPortfolio *run_one_code(Samrena *arena, const double bars[][4], size_t count,
+                                        const SamtraderStrategy *strategy,
+                                        const SamtraderBacktestConfig *config,
+                                        SamtraderMetricsAccumulator *metrics) {
+  SamrenaVector *ohlcv = samrena_vector_init(arena, sizeof(SamtraderOhlcv), count);
+  SamtraderCodeData *cd = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderCodeData);
+  if (!ohlcv || !cd)
+    return NULL;
+  for (size_t i = 0; i < count; i++) {
+    SamtraderOhlcv bar = {.code = "TEST",
+                          .exchange = "US",
+                          .date = day_time((int)i),
+                          .open = bars[i][0],
+                          .high = bars[i][1],
+                          .low = bars[i][2],
+                          .close = bars[i][3],
+                          .volume = 1000};
+    samrena_vector_push(ohlcv, &bar);
+  }
+  cd->code = "TEST";
+  cd->exchange = "US";
+  cd->bar_count = count;
+  cd->indicators = samhashmap_create(4, arena);
+  cd->bars = samtrader_bar_columns_from_ohlcv(arena, ohlcv);
+
+  SamtraderCodeData *code_data[] = {cd};
+  SamtraderTimeline *timeline = samtrader_timeline_build(arena, code_data, 1);
+  SamtraderStrategyProgram program;
+  if (!cd->bars || !timeline || samtrader_strategy_compile(arena, strategy, cd, &program) != 0)
+    return NULL;
+  if (metrics)
+    return samtrader_backtest_run_streaming(arena, config, strategy, code_data, &program,
+                                            timeline, metrics);
+  return samtrader_backtest_run(arena, config, strategy, code_data, &program, timeline);
+}
+
+static int test_fill_next_bar_open(void) {
+  printf("Testing next-bar-open fill policy...\n");
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  /* Entry: close > 95, Exit: close > 125 */
+  SamtraderOperand close_op = samtrader_operand_price(SAMTRADER_OPERAND_PRICE_CLOSE);
+  SamtraderStrategy strategy = {
+      .name = "next_open",
+      .entry_long = samtrader_rule_create_comparison(arena, SAMTRADER_RULE_ABOVE, close_op,
+                                                     samtrader_operand_constant(95.0)),
+      .exit_long = samtrader_rule_create_comparison(arena, SAMTRADER_RULE_ABOVE, close_op,
+                                                    samtrader_operand_constant(125.0)),
+      .position_size = 0.25,
+      .max_positions = 1};
+  const double bars[][4] = {{89, 91, 88, 90},     {99, 101, 98, 100},   {109, 111, 108, 110},
+                            {119, 121, 118, 120}, {129, 131, 128, 130}, {124, 126, 123, 125}};
+  SamtraderBacktestConfig config = {.initial_capital = 100000.0,
+                                    .fill_policy = SAMTRADER_FILL_NEXT_BAR_OPEN};
+
+  SamtraderPortfolio *portfolio = run_one_code(arena, bars, 6, &strategy, &config, NULL);
+  ASSERT(portfolio != NULL, "Backtest should run");
+
+  /* Trace:
+   * Bar 1: close 100 > 95 signals entry; fills at bar 2 open 109.
+   *   qty = floor(25000/109) = 229, cash = 100000 - 24961 = 75039
+   * Bar 4: close 130 > 125 signals exit, and (flat once exited) entry again.
+   * Bar 5 open 124: exit 229 @ 124 -> cash 103435, pnl 229*15 = 3435;
+   *   re-enter qty = floor(25858.75/124) = 208 @ 124.
+   */
+  ASSERT(samrena_vector_size(portfolio->closed_trades) == 1, "One closed trade");
+  const SamtraderClosedTrade *trade =
+      (const SamtraderClosedTrade *)samrena_vector_at_const(portfolio->closed_trades, 0);
+  ASSERT_DOUBLE_EQ(trade->entry_price, 109.0, "Entry at next open");
+  ASSERT_DOUBLE_EQ(trade->exit_price, 124.0, "Exit at next open");
+  ASSERT(trade->entry_date == day_time(2) && trade->exit_date == day_time(5), "Fill dates");
+  ASSERT_DOUBLE_EQ(trade->pnl, 3435.0, "Trade PnL");
+
+  SamtraderPosition *pos = samtrader_portfolio_get_position(portfolio, "TEST");
+  ASSERT(pos != NULL && pos->quantity == 208, "Re-entered at the same open");
+  ASSERT_DOUBLE_EQ(pos->entry_price, 124.0, "Re-entry price");
+
+  /* The same bars filled at the close enter at 100 and exit at 130 */
+  config.fill_policy = SAMTRADER_FILL_SAME_BAR_CLOSE;
+  portfolio = run_one_code(arena, bars, 6, &strategy, &config, NULL);
+  ASSERT(portfolio != NULL, "Backtest should run");
+  trade = (const SamtraderClosedTrade *)samrena_vector_at_const(portfolio->closed_trades, 0);
+  ASSERT(trade != NULL, "Close fills trade too");
+  ASSERT_DOUBLE_EQ(trade->entry_price, 100.0, "Entry at signal close");
+  ASSERT_DOUBLE_EQ(trade->exit_price, 130.0, "Exit at signal close");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_close_at_end(void) {
+  printf("Testing close_at_end exits open positions on the last date...\n");
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  /* Entry: close > 95, never exits by rule */
+  SamtraderOperand close_op = samtrader_operand_price(SAMTRADER_OPERAND_PRICE_CLOSE);
+  SamtraderStrategy strategy = {
+      .name = "close_at_end",
+      .entry_long = samtrader_rule_create_comparison(arena, SAMTRADER_RULE_ABOVE, close_op,
+                                                     samtrader_operand_constant(95.0)),
+      .exit_long = samtrader_rule_create_comparison(arena, SAMTRADER_RULE_ABOVE, close_op,
+                                                    samtrader_operand_constant(999.0)),
+      .position_size = 0.25,
+      .max_positions = 1};
+  const double bars[][4] = {{89, 91, 88, 90}, {99, 101, 98, 100}, {109, 111, 108, 110}};
+  SamtraderBacktestConfig config = {.initial_capital = 100000.0, .close_at_end = true};
+
+  SamtraderPortfolio *portfolio = run_one_code(arena, bars, 3, &strategy, &config, NULL);
+  ASSERT(portfolio != NULL, "Backtest should run");
+
+  /* Bar 1: enter 250 @ 100, cash 75000. Bar 2: exit 250 @ 110, pnl 2500 */
+  ASSERT(samrena_vector_size(portfolio->closed_trades) == 1, "Closing trade recorded");
+  const SamtraderClosedTrade *trade =
+      (const SamtraderClosedTrade *)samrena_vector_at_const(portfolio->closed_trades, 0);
+  ASSERT_DOUBLE_EQ(trade->exit_price, 110.0, "Exit at the last close");
+  ASSERT(trade->exit_date == day_time(2), "Exit on the last date");
+  ASSERT_DOUBLE_EQ(trade->pnl, 2500.0, "Trade PnL");
+  ASSERT(samtrader_portfolio_position_count(portfolio) == 0, "Run ends flat");
+  const SamtraderEquityPoint *last =
+      (const SamtraderEquityPoint *)samrena_vector_at_const(portfolio->equity_curve, 2);
+  ASSERT_DOUBLE_EQ(last->equity, 102500.0, "Last equity is the cash after the exit");
+
+  /* Without it the position stays open and only its value is in the equity */
+  config.close_at_end = false;
+  portfolio = run_one_code(arena, bars, 3, &strategy, &config, NULL);
+  ASSERT(portfolio != NULL, "Backtest should run");
+  ASSERT(samrena_vector_size(portfolio->closed_trades) == 0, "No closed trade");
+  ASSERT(samtrader_portfolio_position_count(portfolio) == 1, "Position left open");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_trigger_worst_case(void) {
+  printf("Testing worst-case intrabar trigger policy...\n");
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  /* Entry: close > 95, never exits by rule; SL 5%, TP 10% */
+  SamtraderOperand close_op = samtrader_operand_price(SAMTRADER_OPERAND_PRICE_CLOSE);
+  SamtraderStrategy strategy = {
+      .name = "worst_case",
+      .entry_long = samtrader_rule_create_comparison(arena, SAMTRADER_RULE_ABOVE, close_op,
+                                                     samtrader_operand_constant(95.0)),
+      .exit_long = samtrader_rule_create_comparison(arena, SAMTRADER_RULE_ABOVE, close_op,
+                                                    samtrader_operand_constant(999.0)),
+      .position_size = 0.25,
+      .stop_loss_pct = 5.0,
+      .take_profit_pct = 10.0,
+      .max_positions = 1};
+  const double bars[][4] = {{89, 91, 88, 90},   {99, 101, 98, 100}, {101, 104, 94, 102},
+                            {90, 115, 89, 100}, {100, 111, 94, 100}};
+  SamtraderBacktestConfig config = {.initial_capital = 100000.0,
+                                    .trigger_policy = SAMTRADER_TRIGGER_WORST_CASE};
+
+  SamtraderPortfolio *portfolio = run_one_code(arena, bars, 5, &strategy, &config, NULL);
+  ASSERT(portfolio != NULL, "Backtest should run");
+
+  /* Trace (each stop-out re-enters at that bar's close):
+   * Bar 1: enter @ 100, SL 95 / TP 110.
+   * Bar 2: low 94 reaches SL -> exit @ 95; re-enter @ 102, SL 96.9 / TP 112.2.
+   * Bar 3: opens at 90 below SL -> exit @ 90 (gap); re-enter @ 100, SL 95 / TP 110.
+   * Bar 4: low 94 and high 111 reach both levels -> exit @ 95 (stop first); re-enter @ 100.
+   */
+  ASSERT(samrena_vector_size(portfolio->closed_trades) == 3, "Three stop-outs");
+  const SamtraderClosedTrade *trades = (const SamtraderClosedTrade *)portfolio->closed_trades->data;
+  ASSERT_DOUBLE_EQ(trades[0].exit_price, 95.0, "Touched stop fills at the stop");
+  ASSERT_DOUBLE_EQ(trades[1].entry_price, 102.0, "Re-entry at close");
+  ASSERT_DOUBLE_EQ(trades[1].exit_price, 90.0, "Gap fills at the open");
+  ASSERT_DOUBLE_EQ(trades[2].exit_price, 95.0, "Both levels fill at the stop");
+  ASSERT(samtrader_portfolio_has_position(portfolio, "TEST"), "Holding after the last re-entry");
+
+  /* Checked against the close only, no bar closes through a level */
+  config.trigger_policy = SAMTRADER_TRIGGER_CLOSE;
+  portfolio = run_one_code(arena, bars, 5, &strategy, &config, NULL);
+  ASSERT(portfolio != NULL, "Backtest should run");
+  ASSERT(samrena_vector_size(portfolio->closed_trades) == 0, "Close checks never fire");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_streaming_metrics(void) {
+  printf("Testing streamed metrics match the recorded run...\n");
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  /* The worst-case trigger bars: three stop-outs and an open position at the end */
+  SamtraderOperand close_op = samtrader_operand_price(SAMTRADER_OPERAND_PRICE_CLOSE);
+  SamtraderStrategy strategy = {
+      .name = "streaming",
+      .entry_long = samtrader_rule_create_comparison(arena, SAMTRADER_RULE_ABOVE, close_op,
+                                                     samtrader_operand_constant(95.0)),
+      .exit_long = samtrader_rule_create_comparison(arena, SAMTRADER_RULE_ABOVE, close_op,
+                                                    samtrader_operand_constant(999.0)),
+      .position_size = 0.25,
+      .stop_loss_pct = 5.0,
+      .take_profit_pct = 10.0,
+      .max_positions = 1};
+  const double bars[][4] = {{89, 91, 88, 90},   {99, 101, 98, 100}, {101, 104, 94, 102},
+                            {90, 115, 89, 100}, {100, 111, 94, 100}};
+  SamtraderBacktestConfig config = {.initial_capital = 100000.0,
+                                    .commission_per_trade = 5.0,
+                                    .trigger_policy = SAMTRADER_TRIGGER_WORST_CASE};
+
+  SamtraderPortfolio *recorded = run_one_code(arena, bars, 5, &strategy, &config, NULL);
+  ASSERT(recorded != NULL, "Backtest should run");
+  SamtraderMetrics *expected = samtrader_metrics_calculate(arena, recorded->closed_trades,
+                                                           recorded->equity_curve, 0.05);
+  ASSERT(expected != NULL && expected->total_trades == 3, "Recorded run has three trades");
+
+  time_t dates[5];
+  for (int i = 0; i < 5; i++)
+    dates[i] = day_time(i);
+  SamtraderMetricsAccumulator acc;
+  samtrader_metrics_accumulator_init(&acc, samtrader_metrics_bars_per_year_of_dates(dates, 5),
+                                     0.05);
+  SamtraderPortfolio *streamed = run_one_code(arena, bars, 5, &strategy, &config, &acc);
+  ASSERT(streamed != NULL, "Streaming backtest should run");
+  ASSERT(samrena_vector_size(streamed->equity_curve) == 0, "No equity curve is recorded");
+
+  SamtraderMetrics metrics;
+  samtrader_metrics_accumulator_finish(&acc, &metrics);
+  ASSERT(memcmp(expected, &metrics, sizeof(metrics)) == 0, "Streamed metrics match exactly");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
 /*============================================================================
  * Main
  *============================================================================*/
@@ -1145,6 +1396,10 @@ int main(void) {
   failures += test_multicode_max_positions();
   failures += test_multicode_disjoint_dates();
   failures += test_multicode_per_code_metrics();
+  failures += test_fill_next_bar_open();
+  failures += test_close_at_end();
+  failures += test_trigger_worst_case();
+  failures += test_streaming_metrics();
 
   printf("\n=== Results: %d failures ===\n", failures);
 
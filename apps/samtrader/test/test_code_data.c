@@ -27,6 +27,7 @@
 #include "samtrader/domain/ohlcv.h"
 #include "samtrader/domain/rule.h"
 #include "samtrader/domain/strategy.h"
+#include "samtrader/domain/worker_pool.h"
 #include "samtrader/ports/data_port.h"
 
 #define ASSERT(cond, msg)                                                                          \
@@ -84,6 +85,37 @@ static SamrenaVector *mock_fetch_ohlcv(SamtraderDataPort *port, const char *code
   return NULL;
 }
 
+static int mock_batch_calls = 0;
+
+static SamrenaVector **mock_fetch_ohlcv_batch(SamtraderDataPort *port, const char *const *codes,
+                                              size_t code_count, const char *exchange,
+                                              time_t start_date, time_t end_date) {
+  MockDataPortImpl *impl = (MockDataPortImpl *)port->impl;
+  mock_batch_calls++;
+  SamrenaVector **out = SAMRENA_PUSH_ARRAY_ZERO(impl->arena, SamrenaVector *, code_count);
+  for (size_t i = 0; i < code_count; i++) {
+    out[i] = mock_fetch_ohlcv(port, codes[i], exchange, start_date, end_date);
+    if (!out[i])
+      out[i] = samtrader_ohlcv_vector_create(impl->arena, 0);
+  }
+  return out;
+}
+
+/* Columns most recently lent by mock_fetch_bars, to check they are used in place */
+static const SamtraderBarColumns *mock_lent_bars = NULL;
+
+static int mock_fetch_bars(SamtraderDataPort *port, const char *code, const char *exchange,
+                           time_t start_date, time_t end_date, SamtraderBarColumns *out) {
+  MockDataPortImpl *impl = (MockDataPortImpl *)port->impl;
+  SamrenaVector *rows = mock_fetch_ohlcv(port, code, exchange, start_date, end_date);
+  SamtraderBarColumns *bars = rows ? samtrader_bar_columns_from_ohlcv(impl->arena, rows) : NULL;
+  if (!bars)
+    return -1;
+  *out = *bars;
+  mock_lent_bars = bars;
+  return 0;
+}
+
 static void mock_close(SamtraderDataPort *port) { (void)port; }
 
 static SamtraderDataPort *create_mock_port(Samrena *arena, const char **codes, size_t *bar_counts,
@@ -249,18 +281,15 @@ static int test_timeline_gaps(void) {
   SamtraderCodeData *cd2 = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderCodeData);
   cd2->code = "BHP";
   cd2->exchange = "AU";
-  cd2->ohlcv = samtrader_ohlcv_vector_create(arena, 3);
+  cd2->bars = samtrader_bar_columns_create(arena, "BHP", "AU", 3);
   time_t bhp_days[] = {0, 2, 4};
   for (int i = 0; i < 3; i++) {
-    SamtraderOhlcv bar = {.code = "BHP",
-                          .exchange = "AU",
-                          .date = BASE_DATE + bhp_days[i] * DAY_SECONDS,
-                          .open = 50.0,
-                          .high = 55.0,
-                          .low = 45.0,
-                          .close = 52.0,
-                          .volume = 5000};
-    samrena_vector_push(cd2->ohlcv, &bar);
+    cd2->bars->date[i] = BASE_DATE + bhp_days[i] * DAY_SECONDS;
+    cd2->bars->open[i] = 50.0;
+    cd2->bars->high[i] = 55.0;
+    cd2->bars->low[i] = 45.0;
+    cd2->bars->close[i] = 52.0;
+    cd2->bars->volume[i] = 5000;
   }
   cd2->bar_count = 3;
 
@@ -312,7 +341,7 @@ static int test_timeline_one_empty_code(void) {
   SamtraderCodeData *cd2 = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderCodeData);
   cd2->code = "BHP";
   cd2->exchange = "AU";
-  cd2->ohlcv = samtrader_ohlcv_vector_create(arena, 1);
+  cd2->bars = samtrader_bar_columns_create(arena, "BHP", "AU", 0);
   cd2->bar_count = 0;
 
   SamtraderCodeData *cds[] = {cd1, cd2};
@@ -325,6 +354,158 @@ static int test_timeline_one_empty_code(void) {
   return 0;
 }
 
+/* =========================== Aligned Timeline Tests =========================== */
+
+static int test_aligned_timeline_bar_index(void) {
+  printf("Testing aligned timeline bar index with offset codes...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  /* CBA: days 0-4, BHP: days 2-6 */
+  const char *codes[] = {"CBA", "BHP"};
+  size_t bars[] = {5, 5};
+  time_t starts[] = {0, 2};
+  SamtraderDataPort *port = create_mock_port(arena, codes, bars, starts, 2);
+
+  SamtraderCodeData *cd1 = samtrader_load_code_data(arena, port, "CBA", "AU", 0, 0);
+  SamtraderCodeData *cd2 = samtrader_load_code_data(arena, port, "BHP", "AU", 0, 0);
+  ASSERT(cd1 != NULL && cd2 != NULL, "Failed to load code data");
+
+  SamtraderCodeData *cds[] = {cd1, cd2};
+  SamtraderTimeline *timeline = samtrader_timeline_build(arena, cds, 2);
+  ASSERT(timeline != NULL, "Timeline should not be NULL");
+  ASSERT(timeline->date_count == 7, "Expected 7 unique dates");
+  ASSERT(timeline->code_count == 2, "Expected 2 codes");
+  ASSERT(samrena_vector_size(timeline->dates) == 7, "Dates vector should match date_count");
+
+  for (size_t t = 0; t < timeline->date_count; t++) {
+    time_t date = *(const time_t *)samrena_vector_at_const(timeline->dates, t);
+    ASSERT(date == BASE_DATE + (time_t)(t * DAY_SECONDS), "Timeline dates should be consecutive");
+
+    const int32_t *row = timeline->bar_index + t * timeline->code_count;
+    int32_t expected_cba = t < 5 ? (int32_t)t : -1;
+    int32_t expected_bhp = t >= 2 ? (int32_t)(t - 2) : -1;
+    ASSERT(row[0] == expected_cba, "CBA bar index mismatch");
+    ASSERT(row[1] == expected_bhp, "BHP bar index mismatch");
+
+    if (row[1] >= 0) {
+      ASSERT(cd2->bars->date[row[1]] == date, "Indexed bar should fall on the timeline date");
+    }
+  }
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_aligned_timeline_empty_and_null_codes(void) {
+  printf("Testing aligned timeline with empty and NULL codes...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  const char *codes[] = {"CBA"};
+  size_t bars[] = {3};
+  SamtraderDataPort *port = create_mock_port(arena, codes, bars, NULL, 1);
+  SamtraderCodeData *cd1 = samtrader_load_code_data(arena, port, "CBA", "AU", 0, 0);
+  ASSERT(cd1 != NULL, "Failed to load CBA");
+
+  SamtraderCodeData *empty = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderCodeData);
+  empty->bars = samtrader_bar_columns_create(arena, NULL, NULL, 0);
+
+  SamtraderCodeData *cds[] = {empty, cd1, NULL};
+  SamtraderTimeline *timeline = samtrader_timeline_build(arena, cds, 3);
+  ASSERT(timeline != NULL, "Timeline should not be NULL");
+  ASSERT(timeline->date_count == 3, "Expected 3 dates from CBA only");
+
+  for (size_t t = 0; t < timeline->date_count; t++) {
+    const int32_t *row = timeline->bar_index + t * timeline->code_count;
+    ASSERT(row[0] == -1, "Empty code should have no bars");
+    ASSERT(row[1] == (int32_t)t, "CBA bar index mismatch");
+    ASSERT(row[2] == -1, "NULL code should have no bars");
+  }
+
+  ASSERT(samtrader_timeline_build(NULL, cds, 3) == NULL, "NULL arena should return NULL");
+  ASSERT(samtrader_timeline_build(arena, NULL, 3) == NULL, "NULL code_data should return NULL");
+  ASSERT(samtrader_timeline_build(arena, cds, 0) == NULL, "Zero count should return NULL");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_aligned_timeline_unsorted_rejected(void) {
+  printf("Testing aligned timeline rejects unsorted bars...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  SamtraderCodeData *cd = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderCodeData);
+  cd->code = "CBA";
+  cd->exchange = "AU";
+  cd->bars = samtrader_bar_columns_create(arena, "CBA", "AU", 3);
+  time_t days[] = {0, 2, 1};
+  for (int i = 0; i < 3; i++) {
+    cd->bars->date[i] = BASE_DATE + days[i] * DAY_SECONDS;
+    cd->bars->open[i] = 50.0;
+    cd->bars->high[i] = 55.0;
+    cd->bars->low[i] = 45.0;
+    cd->bars->close[i] = 52.0;
+    cd->bars->volume[i] = 5000;
+  }
+  cd->bar_count = 3;
+
+  SamtraderCodeData *cds[] = {cd};
+  ASSERT(samtrader_timeline_build(arena, cds, 1) == NULL, "Unsorted bars should be rejected");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_timeline_window_view(void) {
+  printf("Testing timeline window views...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  /* CBA: days 0-4, BHP: days 2-6 */
+  const char *codes[] = {"CBA", "BHP"};
+  size_t bars[] = {5, 5};
+  time_t starts[] = {0, 2};
+  SamtraderDataPort *port = create_mock_port(arena, codes, bars, starts, 2);
+  SamtraderCodeData *cds[] = {samtrader_load_code_data(arena, port, "CBA", "AU", 0, 0),
+                              samtrader_load_code_data(arena, port, "BHP", "AU", 0, 0)};
+  ASSERT(cds[0] != NULL && cds[1] != NULL, "Failed to load code data");
+  SamtraderTimeline *timeline = samtrader_timeline_build(arena, cds, 2);
+  ASSERT(timeline != NULL, "Timeline should not be NULL");
+
+  SamtraderTimeline *view = samtrader_timeline_window(arena, timeline, 3, 6);
+  ASSERT(view != NULL, "Window should succeed");
+  ASSERT(view->date_count == 3 && view->code_count == 2, "Window dimensions");
+  ASSERT(samrena_vector_size(view->dates) == 3, "Window dates vector size");
+  ASSERT(view->bar_index == timeline->bar_index + 3 * 2, "Bar index is shared, not copied");
+  ASSERT(samrena_vector_at_const(view->dates, 0) == samrena_vector_at_const(timeline->dates, 3),
+         "Dates are shared, not copied");
+
+  /* Bar indices still address the full history */
+  ASSERT(view->bar_index[0] == 3 && view->bar_index[1] == 1, "First row keeps absolute indices");
+  ASSERT(view->bar_index[2 * 2] == -1 && view->bar_index[2 * 2 + 1] == 3,
+         "Last row keeps absolute indices");
+
+  SamtraderTimeline *empty = samtrader_timeline_window(arena, timeline, 7, 7);
+  ASSERT(empty != NULL && empty->date_count == 0, "Empty window at the end");
+  ASSERT(samtrader_timeline_window(arena, timeline, 4, 3) == NULL, "Reversed range fails");
+  ASSERT(samtrader_timeline_window(arena, timeline, 0, 8) == NULL, "Range past the end fails");
+  ASSERT(samtrader_timeline_window(NULL, timeline, 0, 1) == NULL, "NULL arena fails");
+  ASSERT(samtrader_timeline_window(arena, NULL, 0, 1) == NULL, "NULL timeline fails");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
 /* =========================== Date Index Tests =========================== */
 
 static int test_date_index_basic(void) {
@@ -333,20 +514,17 @@ static int test_date_index_basic(void) {
   Samrena *arena = samrena_create_default();
   ASSERT(arena != NULL, "Failed to create arena");
 
-  SamrenaVector *ohlcv = samtrader_ohlcv_vector_create(arena, 5);
+  SamtraderBarColumns *bars = samtrader_bar_columns_create(arena, "CBA", "AU", 5);
   for (size_t i = 0; i < 5; i++) {
-    SamtraderOhlcv bar = {.code = "CBA",
-                          .exchange = "AU",
-                          .date = BASE_DATE + (time_t)(i * DAY_SECONDS),
-                          .open = 100.0,
-                          .high = 105.0,
-                          .low = 95.0,
-                          .close = 102.0,
-                          .volume = 10000};
-    samrena_vector_push(ohlcv, &bar);
+    bars->date[i] = BASE_DATE + (time_t)(i * DAY_SECONDS);
+    bars->open[i] = 100.0;
+    bars->high[i] = 105.0;
+    bars->low[i] = 95.0;
+    bars->close[i] = 102.0;
+    bars->volume[i] = 10000;
   }
 
-  SamHashMap *idx = samtrader_build_date_index(arena, ohlcv);
+  SamHashMap *idx = samtrader_build_date_index(arena, bars);
   ASSERT(idx != NULL, "Date index should not be NULL");
 
   /* Check each date maps to the correct index */
@@ -369,20 +547,17 @@ static int test_date_index_missing_date(void) {
   Samrena *arena = samrena_create_default();
   ASSERT(arena != NULL, "Failed to create arena");
 
-  SamrenaVector *ohlcv = samtrader_ohlcv_vector_create(arena, 3);
+  SamtraderBarColumns *bars = samtrader_bar_columns_create(arena, "CBA", "AU", 3);
   for (size_t i = 0; i < 3; i++) {
-    SamtraderOhlcv bar = {.code = "CBA",
-                          .exchange = "AU",
-                          .date = BASE_DATE + (time_t)(i * DAY_SECONDS),
-                          .open = 100.0,
-                          .high = 105.0,
-                          .low = 95.0,
-                          .close = 102.0,
-                          .volume = 10000};
-    samrena_vector_push(ohlcv, &bar);
+    bars->date[i] = BASE_DATE + (time_t)(i * DAY_SECONDS);
+    bars->open[i] = 100.0;
+    bars->high[i] = 105.0;
+    bars->low[i] = 95.0;
+    bars->close[i] = 102.0;
+    bars->volume[i] = 10000;
   }
 
-  SamHashMap *idx = samtrader_build_date_index(arena, ohlcv);
+  SamHashMap *idx = samtrader_build_date_index(arena, bars);
   ASSERT(idx != NULL, "Date index should not be NULL");
 
   /* Look up a date that doesn't exist */
@@ -403,7 +578,7 @@ static int test_date_index_null_params(void) {
   ASSERT(arena != NULL, "Failed to create arena");
 
   ASSERT(samtrader_build_date_index(NULL, NULL) == NULL, "NULL arena should return NULL");
-  ASSERT(samtrader_build_date_index(arena, NULL) == NULL, "NULL ohlcv should return NULL");
+  ASSERT(samtrader_build_date_index(arena, NULL) == NULL, "NULL bars should return NULL");
 
   samrena_destroy(arena);
   printf("  PASS\n");
@@ -426,7 +601,7 @@ static int test_load_code_data_basic(void) {
   ASSERT(cd != NULL, "Code data should not be NULL");
   ASSERT(strcmp(cd->code, "CBA") == 0, "Code should be CBA");
   ASSERT(strcmp(cd->exchange, "AU") == 0, "Exchange should be AU");
-  ASSERT(cd->ohlcv != NULL, "OHLCV should not be NULL");
+  ASSERT(cd->bars != NULL, "Bars should not be NULL");
   ASSERT(cd->bar_count == 50, "Bar count should be 50");
   ASSERT(cd->indicators == NULL, "Indicators should be NULL before computation");
 
@@ -477,6 +652,207 @@ static int test_load_code_data_null_params(void) {
   return 0;
 }
 
+static int test_load_code_data_batch_fallback(void) {
+  printf("Testing batch load falls back to per-code fetch...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  const char *codes[] = {"CBA", "BHP", "WBC"};
+  size_t bars[] = {50, 40, 60};
+  time_t starts[] = {0, 5, 2};
+  SamtraderDataPort *port = create_mock_port(arena, codes, bars, starts, 3);
+  ASSERT(port->fetch_ohlcv_batch == NULL, "Mock has no batch fetch");
+
+  SamtraderCodeData **cd = samtrader_load_code_data_batch(arena, port, codes, 3, "AU", 0, 0);
+  ASSERT(cd != NULL, "Batch load should succeed");
+  for (size_t i = 0; i < 3; i++) {
+    ASSERT(strcmp(cd[i]->code, codes[i]) == 0, "Entries are parallel to codes");
+    ASSERT(strcmp(cd[i]->exchange, "AU") == 0, "Exchange is set");
+    ASSERT(cd[i]->bar_count == bars[i], "Bar count matches");
+    ASSERT(cd[i]->bars != NULL && cd[i]->bars->count == bars[i], "Columns are built");
+  }
+
+  /* A failed per-code fetch fails the batch */
+  const char *with_unknown[] = {"CBA", "XYZ"};
+  ASSERT(samtrader_load_code_data_batch(arena, port, with_unknown, 2, "AU", 0, 0) == NULL,
+         "Unknown code should fail");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_load_code_data_batch_single_request(void) {
+  printf("Testing batch load uses one batch request...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  const char *codes[] = {"CBA", "BHP", "WBC", "NAB"};
+  size_t bars[] = {50, 40, 60, 0};
+  SamtraderDataPort *port = create_mock_port(arena, codes, bars, NULL, 4);
+  port->fetch_ohlcv_batch = mock_fetch_ohlcv_batch;
+
+  mock_batch_calls = 0;
+  SamtraderCodeData **cd = samtrader_load_code_data_batch(arena, port, codes, 4, "AU", 0, 0);
+  ASSERT(cd != NULL, "Batch load should succeed");
+  ASSERT(mock_batch_calls == 1, "Exactly one batch request");
+  for (size_t i = 0; i < 4; i++) {
+    SamtraderCodeData *single = samtrader_load_code_data(arena, port, codes[i], "AU", 0, 0);
+    ASSERT(strcmp(cd[i]->code, codes[i]) == 0, "Entries are parallel to codes");
+    ASSERT(cd[i]->bar_count == bars[i], "Bar count matches");
+    if (single) {
+      for (size_t j = 0; j < bars[i]; j++) {
+        ASSERT(cd[i]->bars->date[j] == single->bars->date[j] &&
+                   cd[i]->bars->close[j] == single->bars->close[j],
+               "Batch rows match single fetch");
+      }
+    }
+  }
+  ASSERT(cd[3]->bar_count == 0 && cd[3]->bars->count == 0, "Code without rows is empty");
+
+  ASSERT(samtrader_load_code_data_batch(NULL, port, codes, 4, "AU", 0, 0) == NULL, "NULL arena");
+  ASSERT(samtrader_load_code_data_batch(arena, NULL, codes, 4, "AU", 0, 0) == NULL, "NULL port");
+  ASSERT(samtrader_load_code_data_batch(arena, port, NULL, 4, "AU", 0, 0) == NULL, "NULL codes");
+  ASSERT(samtrader_load_code_data_batch(arena, port, codes, 0, "AU", 0, 0) == NULL, "No codes");
+  ASSERT(samtrader_load_code_data_batch(arena, port, codes, 4, NULL, 0, 0) == NULL,
+         "NULL exchange");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_load_code_data_borrowed(void) {
+  printf("Testing load code data borrows columnar bars...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  const char *codes[] = {"CBA", "BHP"};
+  size_t bars[] = {50, 40};
+  SamtraderDataPort *port = create_mock_port(arena, codes, bars, NULL, 2);
+  port->fetch_ohlcv_batch = mock_fetch_ohlcv_batch;
+  port->fetch_bars = mock_fetch_bars;
+
+  SamtraderCodeData *cd = samtrader_load_code_data(arena, port, "CBA", "AU", 0, 0);
+  ASSERT(cd != NULL && cd->bar_count == 50, "Borrowed load should succeed");
+  ASSERT(cd->bars->close == mock_lent_bars->close && cd->bars->date == mock_lent_bars->date,
+         "Bars should be the port's columns, not a copy");
+  ASSERT(strcmp(cd->code, "CBA") == 0 && strcmp(cd->exchange, "AU") == 0, "Code and exchange");
+  ASSERT(samtrader_load_code_data(arena, port, "NAB", "AU", 0, 0) == NULL,
+         "Unknown code should return NULL");
+
+  /* Borrowing takes precedence over the batch request */
+  mock_batch_calls = 0;
+  SamtraderCodeData **batch = samtrader_load_code_data_batch(arena, port, codes, 2, "AU", 0, 0);
+  ASSERT(batch != NULL && mock_batch_calls == 0, "Batch load should borrow per code");
+  ASSERT(batch[1]->bars->close == mock_lent_bars->close, "BHP bars should be borrowed");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+/* =========================== Universe Loading Tests =========================== */
+
+static int test_load_universe_data_filters(void) {
+  printf("Testing universe load skips codes with too few bars...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  const char *codes[] = {"CBA", "BHP", "WBC", "NAB"};
+  size_t bars[] = {50, 10, 40, 0};
+  SamtraderDataPort *port = create_mock_port(arena, codes, bars, NULL, 4);
+  port->fetch_ohlcv_batch = mock_fetch_ohlcv_batch;
+
+  const char *universe_codes[] = {"CBA", "BHP", "WBC", "NAB"};
+  SamtraderUniverse universe = {.codes = universe_codes, .count = 4, .exchange = "AU"};
+
+  mock_batch_calls = 0;
+  SamtraderCodeData **cd = NULL;
+  int loaded = samtrader_load_universe_data(arena, port, &universe, 0, 0, &cd);
+  ASSERT(loaded == 2, "Two codes have enough bars");
+  ASSERT(mock_batch_calls == 1, "Validation and loading share one batch request");
+  ASSERT(universe.count == 2, "Universe compacted to valid codes");
+  ASSERT(strcmp(universe.codes[0], "CBA") == 0 && strcmp(universe.codes[1], "WBC") == 0,
+         "Valid codes kept in order");
+  ASSERT(strcmp(cd[0]->code, "CBA") == 0 && cd[0]->bar_count == 50, "CBA loaded");
+  ASSERT(strcmp(cd[1]->code, "WBC") == 0 && cd[1]->bar_count == 40, "WBC loaded");
+  ASSERT(cd[1]->bars != NULL && cd[1]->bars->count == 40, "Columnar bars built");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_load_universe_data_borrowed(void) {
+  printf("Testing universe load with borrowed bars...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  /* NAB is unknown to the port, BHP is too short */
+  const char *codes[] = {"CBA", "BHP", "WBC"};
+  size_t bars[] = {50, 10, 40};
+  SamtraderDataPort *port = create_mock_port(arena, codes, bars, NULL, 3);
+  port->fetch_ohlcv_batch = mock_fetch_ohlcv_batch;
+  port->fetch_bars = mock_fetch_bars;
+
+  const char *universe_codes[] = {"CBA", "NAB", "BHP", "WBC"};
+  SamtraderUniverse universe = {.codes = universe_codes, .count = 4, .exchange = "AU"};
+
+  mock_batch_calls = 0;
+  SamtraderCodeData **cd = NULL;
+  ASSERT(samtrader_load_universe_data(arena, port, &universe, 0, 0, &cd) == 2, "Two valid codes");
+  ASSERT(mock_batch_calls == 0, "Borrowed bars need no batch request");
+  ASSERT(universe.count == 2 && strcmp(universe.codes[1], "WBC") == 0, "CBA and WBC remain");
+  ASSERT(cd[1]->bar_count == 40 && cd[1]->bars->close == mock_lent_bars->close,
+         "WBC bars should be borrowed");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_load_universe_data_fallback(void) {
+  printf("Testing universe load without batch fetch...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  /* The mock returns NULL for NAB, which counts as no data */
+  const char *codes[] = {"CBA", "BHP"};
+  size_t bars[] = {35, 5};
+  SamtraderDataPort *port = create_mock_port(arena, codes, bars, NULL, 2);
+
+  const char *universe_codes[] = {"NAB", "CBA", "BHP"};
+  SamtraderUniverse universe = {.codes = universe_codes, .count = 3, .exchange = "AU"};
+
+  SamtraderCodeData **cd = NULL;
+  ASSERT(samtrader_load_universe_data(arena, port, &universe, 0, 0, &cd) == 1, "One valid code");
+  ASSERT(universe.count == 1 && strcmp(universe.codes[0], "CBA") == 0, "Only CBA remains");
+  ASSERT(cd[0]->bar_count == 35, "CBA bars loaded");
+
+  /* No code with enough bars */
+  const char *short_codes[] = {"BHP"};
+  SamtraderUniverse short_universe = {.codes = short_codes, .count = 1, .exchange = "AU"};
+  ASSERT(samtrader_load_universe_data(arena, port, &short_universe, 0, 0, &cd) == 0,
+         "No valid codes returns 0");
+  ASSERT(short_universe.count == 0, "Universe emptied");
+
+  ASSERT(samtrader_load_universe_data(NULL, port, &universe, 0, 0, &cd) == -1, "NULL arena");
+  ASSERT(samtrader_load_universe_data(arena, NULL, &universe, 0, 0, &cd) == -1, "NULL port");
+  ASSERT(samtrader_load_universe_data(arena, port, NULL, 0, 0, &cd) == -1, "NULL universe");
+  ASSERT(samtrader_load_universe_data(arena, port, &universe, 0, 0, NULL) == -1, "NULL out");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
 /* =========================== Indicator Pre-computation Tests =========================== */
 
 static int test_compute_indicators(void) {
@@ -534,6 +910,91 @@ static int test_compute_indicators(void) {
   return 0;
 }
 
+static int series_values_equal(const SamtraderIndicatorSeries *a,
+                               const SamtraderIndicatorSeries *b) {
+  size_t n = samtrader_indicator_series_size(a);
+  if (n != samtrader_indicator_series_size(b))
+    return 0;
+  for (size_t i = 0; i < n; i++) {
+    SamtraderIndicatorValue va;
+    SamtraderIndicatorValue vb;
+    if (!samtrader_indicator_series_at(a, i, &va) || !samtrader_indicator_series_at(b, i, &vb))
+      return 0;
+    if (va.date != vb.date || va.valid != vb.valid)
+      return 0;
+    if (va.valid && memcmp(&va.data.simple.value, &vb.data.simple.value, sizeof(double)) != 0)
+      return 0;
+  }
+  return 1;
+}
+
+static int test_compute_indicators_parallel(void) {
+  printf("Testing parallel indicator pre-computation matches serial...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  const char *codes[] = {"CBA", "BHP", "WBC", "NAB", "ANZ", "CSL", "WES"};
+  size_t bars[] = {50, 80, 35, 120, 64, 90, 41};
+  time_t starts[] = {0, 3, 10, 0, 7, 1, 20};
+  size_t count = sizeof(codes) / sizeof(codes[0]);
+  SamtraderDataPort *port = create_mock_port(arena, codes, bars, starts, count);
+
+  SamtraderOperand sma = samtrader_operand_indicator(SAMTRADER_IND_SMA, 5);
+  SamtraderOperand ema = samtrader_operand_indicator(SAMTRADER_IND_EMA, 12);
+  SamtraderOperand rsi = samtrader_operand_indicator(SAMTRADER_IND_RSI, 14);
+  SamtraderRule *entry =
+      samtrader_rule_create_comparison(arena, SAMTRADER_RULE_CROSS_ABOVE, sma, ema);
+  SamtraderRule *exit_rule = samtrader_rule_create_comparison(arena, SAMTRADER_RULE_ABOVE, rsi,
+                                                              samtrader_operand_constant(70.0));
+  ASSERT(entry != NULL && exit_rule != NULL, "Failed to create rules");
+  SamtraderStrategy strategy = {.name = "Parallel", .entry_long = entry, .exit_long = exit_rule};
+
+  SamtraderCodeData *serial[7];
+  SamtraderCodeData *parallel[7];
+  for (size_t c = 0; c < count; c++) {
+    serial[c] = samtrader_load_code_data(arena, port, codes[c], "AU", 0, 0);
+    parallel[c] = samtrader_load_code_data(arena, port, codes[c], "AU", 0, 0);
+    ASSERT(serial[c] != NULL && parallel[c] != NULL, "Failed to load code data");
+    ASSERT(samtrader_code_data_compute_indicators(arena, serial[c], &strategy) == 0,
+           "Serial computation should succeed");
+  }
+
+  SamtraderWorkerPool *pool = samtrader_worker_pool_create(4);
+  ASSERT(pool != NULL, "Failed to create worker pool");
+  ASSERT(samtrader_worker_pool_size(pool) == 4, "Pool should have 4 workers");
+  ASSERT(samtrader_code_data_compute_indicators_parallel(pool, parallel, count, &strategy, 1,
+                                                         NULL) == 0,
+         "Parallel computation should succeed");
+
+  const char *keys[] = {"SMA_5", "EMA_12", "RSI_14"};
+  for (size_t c = 0; c < count; c++) {
+    ASSERT(parallel[c]->indicators != NULL, "Indicators map should not be NULL");
+    for (size_t k = 0; k < 3; k++) {
+      SamtraderIndicatorSeries *a =
+          (SamtraderIndicatorSeries *)samhashmap_get(serial[c]->indicators, keys[k]);
+      SamtraderIndicatorSeries *b =
+          (SamtraderIndicatorSeries *)samhashmap_get(parallel[c]->indicators, keys[k]);
+      ASSERT(a != NULL && b != NULL, "Series should exist in both maps");
+      ASSERT(series_values_equal(a, b), "Parallel series should match serial bit for bit");
+    }
+  }
+
+  /* A NULL entry fails the whole batch */
+  parallel[2] = NULL;
+  ASSERT(samtrader_code_data_compute_indicators_parallel(pool, parallel, count, &strategy, 1,
+                                                         NULL) == -1,
+         "NULL code data should fail");
+  ASSERT(samtrader_code_data_compute_indicators_parallel(NULL, serial, count, &strategy, 1,
+                                                         NULL) == -1,
+         "NULL pool should fail");
+
+  samtrader_worker_pool_destroy(pool);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
 /* =========================== Main =========================== */
 
 int main(void) {
@@ -550,6 +1011,12 @@ int main(void) {
   failures += test_timeline_null_params();
   failures += test_timeline_one_empty_code();
 
+  /* Aligned timeline tests */
+  failures += test_aligned_timeline_bar_index();
+  failures += test_aligned_timeline_empty_and_null_codes();
+  failures += test_aligned_timeline_unsorted_rejected();
+  failures += test_timeline_window_view();
+
   /* Date index tests */
   failures += test_date_index_basic();
   failures += test_date_index_missing_date();
@@ -559,9 +1026,18 @@ int main(void) {
   failures += test_load_code_data_basic();
   failures += test_load_code_data_unknown();
   failures += test_load_code_data_null_params();
+  failures += test_load_code_data_batch_fallback();
+  failures += test_load_code_data_batch_single_request();
+  failures += test_load_code_data_borrowed();
+
+  /* Universe loading tests */
+  failures += test_load_universe_data_filters();
+  failures += test_load_universe_data_borrowed();
+  failures += test_load_universe_data_fallback();
 
   /* Indicator pre-computation test */
   failures += test_compute_indicators();
+  failures += test_compute_indicators_parallel();
 
   printf("\n=== Results: %d failures ===\n", failures);
 
@@ -973,7 +973,8 @@ static SamtraderCodeData *make_code_data(Samrena *arena, const char *code, const
     return NULL;
   cd->code = code;
   cd->exchange = exchange;
-  cd->ohlcv = make_ohlcv_for_code(arena, code, exchange, closes, count, day_offset);
+  cd->bars = samtrader_bar_columns_from_ohlcv(
+      arena, make_ohlcv_for_code(arena, code, exchange, closes, count, day_offset));
   cd->bar_count = count;
   cd->indicators = samhashmap_create(4, arena);
   return cd;
@@ -1008,6 +1009,13 @@ static int run_multicode_backtest_loop(Samrena *arena, SamtraderCodeData **code_
                                        SamtraderPortfolio *portfolio, const char *exchange,
                                        double commission_flat, double commission_pct,
                                        double slippage_pct) {
+  /* The tree-walking evaluator reads bars as rows */
+  SamrenaVector **rows = SAMRENA_PUSH_ARRAY(arena, SamrenaVector *, code_count);
+  if (!rows)
+    return -1;
+  for (size_t c = 0; c < code_count; c++)
+    rows[c] = samtrader_ohlcv_from_bar_columns(arena, code_data_arr[c]->bars);
+
   for (size_t t = 0; t < samrena_vector_size(timeline); t++) {
     time_t date = *(const time_t *)samrena_vector_at_const(timeline, t);
 
@@ -1023,7 +1031,7 @@ static int run_multicode_backtest_loop(Samrena *arena, SamtraderCodeData **code_
       if (!bar_idx)
         continue;
       const SamtraderOhlcv *bar =
-          (const SamtraderOhlcv *)samrena_vector_at_const(code_data_arr[c]->ohlcv, *bar_idx);
+          (const SamtraderOhlcv *)samrena_vector_at_const(rows[c], *bar_idx);
       double *price = SAMRENA_PUSH_TYPE(arena, double);
       if (!price)
         continue;
@@ -1040,14 +1048,14 @@ static int run_multicode_backtest_loop(Samrena *arena, SamtraderCodeData **code_
         continue;
 
       const SamtraderOhlcv *bar =
-          (const SamtraderOhlcv *)samrena_vector_at_const(code_data_arr[c]->ohlcv, *bar_idx);
+          (const SamtraderOhlcv *)samrena_vector_at_const(rows[c], *bar_idx);
       const char *code = code_data_arr[c]->code;
 
       if (samtrader_portfolio_has_position(portfolio, code)) {
         SamtraderPosition *pos = samtrader_portfolio_get_position(portfolio, code);
         bool should_exit = false;
         if (pos && samtrader_position_is_long(pos)) {
-          should_exit = samtrader_rule_evaluate(strategy->exit_long, code_data_arr[c]->ohlcv,
+          should_exit = samtrader_rule_evaluate(strategy->exit_long, rows[c],
                                                 code_data_arr[c]->indicators, *bar_idx);
         }
         if (should_exit) {
@@ -1057,7 +1065,7 @@ static int run_multicode_backtest_loop(Samrena *arena, SamtraderCodeData **code_
       }
 
       if (!samtrader_portfolio_has_position(portfolio, code)) {
-        bool enter_long = samtrader_rule_evaluate(strategy->entry_long, code_data_arr[c]->ohlcv,
+        bool enter_long = samtrader_rule_evaluate(strategy->entry_long, rows[c],
                                                   code_data_arr[c]->indicators, *bar_idx);
         if (enter_long) {
           samtrader_execution_enter_long(portfolio, arena, code, exchange, bar->close, date,
@@ -1155,8 +1163,8 @@ static int test_e2e_multicode_synthetic(void) {
 
   SamtraderCodeData *code_data_arr[] = {cd_a, cd_b};
   SamHashMap *date_indices[2];
-  date_indices[0] = samtrader_build_date_index(arena, cd_a->ohlcv);
-  date_indices[1] = samtrader_build_date_index(arena, cd_b->ohlcv);
+  date_indices[0] = samtrader_build_date_index(arena, cd_a->bars);
+  date_indices[1] = samtrader_build_date_index(arena, cd_b->bars);
   ASSERT(date_indices[0] && date_indices[1], "Failed to build date indices");
 
   SamrenaVector *timeline = samtrader_build_date_timeline(arena, code_data_arr, 2);
@@ -1297,7 +1305,7 @@ static int test_e2e_backward_compat_single_code(void) {
 
   SamtraderCodeData *code_data_arr[] = {cd};
   SamHashMap *date_indices[1];
-  date_indices[0] = samtrader_build_date_index(arena_b, cd->ohlcv);
+  date_indices[0] = samtrader_build_date_index(arena_b, cd->bars);
   ASSERT(date_indices[0] != NULL, "Failed to build date index");
 
   SamrenaVector *timeline = samtrader_build_date_timeline(arena_b, code_data_arr, 1);
@@ -1435,13 +1443,12 @@ static int test_e2e_multicode_db_pipeline(void) {
     code_data_arr[c] =
         samtrader_load_code_data(arena, data, universe->codes[c], exchange, start_date, end_date);
     ASSERT(code_data_arr[c] != NULL, "Failed to load code data from DB");
-    printf("  Loaded %s: %zu bars\n", universe->codes[c],
-           samrena_vector_size(code_data_arr[c]->ohlcv));
+    printf("  Loaded %s: %zu bars\n", universe->codes[c], code_data_arr[c]->bar_count);
 
     rc = samtrader_code_data_compute_indicators(arena, code_data_arr[c], &strategy);
     ASSERT(rc == 0, "Failed to compute indicators");
 
-    date_indices[c] = samtrader_build_date_index(arena, code_data_arr[c]->ohlcv);
+    date_indices[c] = samtrader_build_date_index(arena, code_data_arr[c]->bars);
     ASSERT(date_indices[c] != NULL, "Failed to build date index");
   }
 
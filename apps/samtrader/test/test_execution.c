@@ -17,6 +17,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "samtrader/domain/execution.h"
 
@@ -758,6 +759,126 @@ static int test_trigger_no_stops_set(void) {
   return 0;
 }
 
+static int test_trigger_price_table(void) {
+  printf("Testing triggers against a price table...\n");
+
+  Samrena *arena = samrena_create_default();
+  Samrena *scratch = samrena_create_default();
+  SamtraderPortfolio *portfolio = samtrader_portfolio_create(arena, 100000.0);
+
+  /* AAPL SL at $95, BHP SL at $47.50, CBA has no price today */
+  samtrader_execution_enter_long(portfolio, arena, "AAPL", "US", 100.0, 1704067200, 0.25, 5.0, 0.0,
+                                 10, 0.0, 0.0, 0.0);
+  samtrader_execution_enter_long(portfolio, arena, "BHP", "AU", 50.0, 1704067200, 0.25, 5.0, 0.0,
+                                 10, 0.0, 0.0, 0.0);
+  samtrader_execution_enter_long(portfolio, arena, "CBA", "AU", 100.0, 1704067200, 0.25, 5.0, 0.0,
+                                 10, 0.0, 0.0, 0.0);
+
+  SamtraderPriceTable *prices = samtrader_price_table_create(arena, portfolio->symbols);
+  prices->prices[samtrader_portfolio_intern(portfolio, "AAPL")] = 93.0;
+  prices->prices[samtrader_portfolio_intern(portfolio, "BHP")] = 48.0;
+
+  int exits = samtrader_execution_check_triggers_at(portfolio, arena, scratch, prices, 1704672000,
+                                                    0.0, 0.0, 0.0);
+  ASSERT(exits == 1, "Should exit 1 position");
+  ASSERT(!samtrader_portfolio_has_position(portfolio, "AAPL"), "AAPL should be exited");
+  ASSERT(samtrader_portfolio_has_position(portfolio, "BHP"), "BHP should remain");
+  ASSERT(samtrader_portfolio_has_position(portfolio, "CBA"), "CBA without a price should remain");
+  ASSERT(samrena_allocated(scratch) == 0, "Scratch arena should be rewound");
+
+  const SamtraderClosedTrade *trade =
+      (const SamtraderClosedTrade *)samrena_vector_at_const(portfolio->closed_trades, 0);
+  ASSERT(trade != NULL, "Exit should record a trade");
+  ASSERT_DOUBLE_EQ(trade->exit_price, 93.0, "Exit at table price");
+
+  ASSERT(samtrader_execution_check_triggers_at(portfolio, arena, arena, prices, 1704672000, 0.0,
+                                               0.0, 0.0) == -1,
+         "Scratch must differ from arena");
+  ASSERT(samtrader_execution_check_triggers_at(portfolio, arena, scratch, NULL, 1704672000, 0.0,
+                                               0.0, 0.0) == -1,
+         "NULL prices should fail");
+
+  samrena_destroy(scratch);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_trigger_ohlc(void) {
+  printf("Testing intrabar triggers against a bar table...\n");
+
+  Samrena *arena = samrena_create_default();
+  Samrena *scratch = samrena_create_default();
+  SamtraderPortfolio *portfolio = samtrader_portfolio_create(arena, 100000.0);
+
+  /* All long at $100 with SL $95 and TP $110 */
+  const char *codes[] = {"GAP", "TOUCH", "BOTH", "QUIET"};
+  for (size_t i = 0; i < 4; i++) {
+    samtrader_execution_enter_long(portfolio, arena, codes[i], "US", 100.0, 1704067200, 0.1, 5.0,
+                                   10.0, 10, 0.0, 0.0, 0.0);
+  }
+
+  SamtraderPriceTable *prices = samtrader_price_table_create_ohlc(arena, portfolio->symbols);
+  ASSERT(prices != NULL && prices->open && prices->high && prices->low, "OHLC table");
+  /* open, high, low, close per code */
+  const double bars[4][4] = {{90, 97, 88, 96}, {100, 111, 99, 105}, {100, 112, 94, 101},
+                             {100, 105, 96, 104}};
+  for (size_t i = 0; i < 4; i++) {
+    SamtraderSymbolId id = samtrader_portfolio_intern(portfolio, codes[i]);
+    prices->open[id] = bars[i][0];
+    prices->high[id] = bars[i][1];
+    prices->low[id] = bars[i][2];
+    prices->prices[id] = bars[i][3];
+  }
+
+  ASSERT(samtrader_execution_check_triggers_at(portfolio, arena, scratch, prices, 1704672000, 0.0,
+                                               0.0, 0.0) == 0,
+         "No close crosses a level");
+  int exits = samtrader_execution_check_triggers_ohlc(portfolio, arena, scratch, prices,
+                                                      1704672000, 0.0, 0.0, 0.0);
+  ASSERT(exits == 3, "Gap, touch and both-touched positions exit");
+  ASSERT(samtrader_portfolio_has_position(portfolio, "QUIET"), "QUIET stays open");
+  ASSERT(samrena_allocated(scratch) == 0, "Scratch arena should be rewound");
+
+  /* Exits run in open-position order: GAP, TOUCH, BOTH */
+  const SamtraderClosedTrade *trades = (const SamtraderClosedTrade *)portfolio->closed_trades->data;
+  ASSERT(strcmp(trades[0].code, "GAP") == 0, "GAP exits first");
+  ASSERT_DOUBLE_EQ(trades[0].exit_price, 90.0, "Gap fills at the open");
+  ASSERT_DOUBLE_EQ(trades[1].exit_price, 110.0, "Touched target fills at the target");
+  ASSERT_DOUBLE_EQ(trades[2].exit_price, 95.0, "Both touched fills at the stop");
+
+  SamtraderPriceTable *close_only = samtrader_price_table_create(arena, portfolio->symbols);
+  ASSERT(samtrader_execution_check_triggers_ohlc(portfolio, arena, scratch, close_only,
+                                                 1704672000, 0.0, 0.0, 0.0) == -1,
+         "A table without open/high/low should fail");
+
+  samrena_destroy(scratch);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_policy_parse(void) {
+  printf("Testing fill and trigger policy parsing...\n");
+
+  SamtraderFillPolicy fill = SAMTRADER_FILL_SAME_BAR_CLOSE;
+  ASSERT(samtrader_fill_policy_parse("next_bar_open", &fill), "Parse next_bar_open");
+  ASSERT(fill == SAMTRADER_FILL_NEXT_BAR_OPEN, "next_bar_open value");
+  ASSERT(samtrader_fill_policy_parse("same_bar_close", &fill), "Parse same_bar_close");
+  ASSERT(fill == SAMTRADER_FILL_SAME_BAR_CLOSE, "same_bar_close value");
+  ASSERT(!samtrader_fill_policy_parse("next_bar_close", &fill), "Reject unknown fill policy");
+
+  SamtraderTriggerPolicy trigger = SAMTRADER_TRIGGER_CLOSE;
+  ASSERT(samtrader_trigger_policy_parse("worst_case", &trigger), "Parse worst_case");
+  ASSERT(trigger == SAMTRADER_TRIGGER_WORST_CASE, "worst_case value");
+  ASSERT(samtrader_trigger_policy_parse("close", &trigger), "Parse close");
+  ASSERT(trigger == SAMTRADER_TRIGGER_CLOSE, "close value");
+  ASSERT(!samtrader_trigger_policy_parse(NULL, &trigger), "Reject NULL name");
+
+  printf("  PASS\n");
+  return 0;
+}
+
 static int test_trigger_null_params(void) {
   printf("Testing trigger null params...\n");
 
@@ -901,6 +1022,9 @@ int main(void) {
   failures += test_trigger_multiple();
   failures += test_trigger_short_stop_loss();
   failures += test_trigger_no_stops_set();
+  failures += test_trigger_price_table();
+  failures += test_trigger_ohlc();
+  failures += test_policy_parse();
   failures += test_trigger_null_params();
 
   /* Round-trip */
@@ -49,7 +49,8 @@ static int test_indicator_series_create(void) {
   ASSERT(series != NULL, "Failed to create indicator series");
   ASSERT(series->type == SAMTRADER_IND_SMA, "Type mismatch");
   ASSERT(series->params.period == 20, "Period mismatch");
-  ASSERT(series->values != NULL, "Values vector not created");
+  ASSERT(series->column_count == 1, "SMA should have one column");
+  ASSERT(series->capacity == 100, "Capacity mismatch");
   ASSERT(samtrader_indicator_series_size(series) == 0, "Series should be empty");
 
   samrena_destroy(arena);
@@ -69,28 +70,34 @@ static int test_indicator_series_add_simple(void) {
   ASSERT(series != NULL, "Failed to create indicator series");
 
   for (int i = 0; i < 14; i++) {
-    SamtraderIndicatorValue *val =
-        samtrader_indicator_add_simple(series, 1704067200 + (i * 86400), 0.0, false);
-    ASSERT(val != NULL, "Failed to add warmup value");
+    ASSERT(samtrader_indicator_add_simple(series, 1704067200 + (i * 86400), 0.0, false) == 0,
+           "Failed to add warmup value");
   }
 
   for (int i = 14; i < 30; i++) {
     double rsi_value = 50.0 + (i - 14) * 2.0;
-    SamtraderIndicatorValue *val =
-        samtrader_indicator_add_simple(series, 1704067200 + (i * 86400), rsi_value, true);
-    ASSERT(val != NULL, "Failed to add value");
+    ASSERT(samtrader_indicator_add_simple(series, 1704067200 + (i * 86400), rsi_value, true) == 0,
+           "Failed to add value");
   }
 
   ASSERT(samtrader_indicator_series_size(series) == 30, "Series size should be 30");
 
-  const SamtraderIndicatorValue *val = samtrader_indicator_series_at(series, 0);
-  ASSERT(val != NULL, "Failed to get first value");
-  ASSERT(val->valid == false, "First value should be invalid (warmup)");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(series, 0, &val), "Failed to get first value");
+  ASSERT(val.valid == false, "First value should be invalid (warmup)");
 
-  val = samtrader_indicator_series_at(series, 14);
-  ASSERT(val != NULL, "Failed to get value at index 14");
-  ASSERT(val->valid == true, "Value at index 14 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 50.0, "Value at index 14");
+  ASSERT(samtrader_indicator_series_at(series, 14, &val), "Failed to get value at index 14");
+  ASSERT(val.valid == true, "Value at index 14 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 50.0, "Value at index 14");
+  ASSERT(val.date == 1704067200 + (14 * 86400), "Date at index 14");
+  ASSERT(series->valid_from == 14, "Values should be valid from index 14");
+  ASSERT_DOUBLE_EQ(series->columns[SAMTRADER_COLUMN_VALUE][29], 50.0 + 15 * 2.0,
+                   "Column holds the value");
+  ASSERT(!samtrader_indicator_series_at(series, 30, &val), "Index past the end should fail");
+
+  ASSERT(samtrader_indicator_add_simple(series, 1704067200 + (30 * 86400), 0.0, false) == -1,
+         "Invalid value after a valid one should be rejected");
+  ASSERT(samtrader_indicator_series_size(series) == 30, "Rejected value should not be added");
 
   double latest;
   bool found = samtrader_indicator_latest_simple(series, &latest);
@@ -116,13 +123,14 @@ static int test_macd_series(void) {
   ASSERT(series->params.param2 == 26, "Slow period should be 26");
   ASSERT(series->params.param3 == 9, "Signal period should be 9");
 
-  SamtraderIndicatorValue *val =
-      samtrader_indicator_add_macd(series, 1704067200, 1.5, 1.2, 0.3, true);
-  ASSERT(val != NULL, "Failed to add MACD value");
-  ASSERT(val->type == SAMTRADER_IND_MACD, "Value type should be MACD");
-  ASSERT_DOUBLE_EQ(val->data.macd.line, 1.5, "MACD line");
-  ASSERT_DOUBLE_EQ(val->data.macd.signal, 1.2, "MACD signal");
-  ASSERT_DOUBLE_EQ(val->data.macd.histogram, 0.3, "MACD histogram");
+  ASSERT(samtrader_indicator_add_macd(series, 1704067200, 1.5, 1.2, 0.3, true) == 0,
+         "Failed to add MACD value");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(series, 0, &val), "Failed to get MACD value");
+  ASSERT(val.type == SAMTRADER_IND_MACD, "Value type should be MACD");
+  ASSERT_DOUBLE_EQ(val.data.macd.line, 1.5, "MACD line");
+  ASSERT_DOUBLE_EQ(val.data.macd.signal, 1.2, "MACD signal");
+  ASSERT_DOUBLE_EQ(val.data.macd.histogram, 0.3, "MACD histogram");
 
   SamtraderMacdValue latest;
   bool found = samtrader_indicator_latest_macd(series, &latest);
@@ -148,12 +156,13 @@ static int test_bollinger_series(void) {
   ASSERT(series->params.period == 20, "Period should be 20");
   ASSERT_DOUBLE_EQ(series->params.param_double, 2.0, "Stddev multiplier");
 
-  SamtraderIndicatorValue *val =
-      samtrader_indicator_add_bollinger(series, 1704067200, 160.0, 150.0, 140.0, true);
-  ASSERT(val != NULL, "Failed to add Bollinger value");
-  ASSERT_DOUBLE_EQ(val->data.bollinger.upper, 160.0, "Bollinger upper");
-  ASSERT_DOUBLE_EQ(val->data.bollinger.middle, 150.0, "Bollinger middle");
-  ASSERT_DOUBLE_EQ(val->data.bollinger.lower, 140.0, "Bollinger lower");
+  ASSERT(samtrader_indicator_add_bollinger(series, 1704067200, 160.0, 150.0, 140.0, true) == 0,
+         "Failed to add Bollinger value");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(series, 0, &val), "Failed to get Bollinger value");
+  ASSERT_DOUBLE_EQ(val.data.bollinger.upper, 160.0, "Bollinger upper");
+  ASSERT_DOUBLE_EQ(val.data.bollinger.middle, 150.0, "Bollinger middle");
+  ASSERT_DOUBLE_EQ(val.data.bollinger.lower, 140.0, "Bollinger lower");
 
   SamtraderBollingerValue latest;
   bool found = samtrader_indicator_latest_bollinger(series, &latest);
@@ -178,11 +187,12 @@ static int test_stochastic_series(void) {
   ASSERT(series->params.period == 14, "K period should be 14");
   ASSERT(series->params.param2 == 3, "D period should be 3");
 
-  SamtraderIndicatorValue *val =
-      samtrader_indicator_add_stochastic(series, 1704067200, 75.0, 70.0, true);
-  ASSERT(val != NULL, "Failed to add Stochastic value");
-  ASSERT_DOUBLE_EQ(val->data.stochastic.k, 75.0, "Stochastic K");
-  ASSERT_DOUBLE_EQ(val->data.stochastic.d, 70.0, "Stochastic D");
+  ASSERT(samtrader_indicator_add_stochastic(series, 1704067200, 75.0, 70.0, true) == 0,
+         "Failed to add Stochastic value");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(series, 0, &val), "Failed to get Stochastic value");
+  ASSERT_DOUBLE_EQ(val.data.stochastic.k, 75.0, "Stochastic K");
+  ASSERT_DOUBLE_EQ(val.data.stochastic.d, 70.0, "Stochastic D");
 
   SamtraderStochasticValue latest;
   bool found = samtrader_indicator_latest_stochastic(series, &latest);
@@ -205,17 +215,18 @@ static int test_pivot_series(void) {
   ASSERT(series != NULL, "Failed to create Pivot series");
   ASSERT(series->type == SAMTRADER_IND_PIVOT, "Type should be PIVOT");
 
-  SamtraderIndicatorValue *val =
-      samtrader_indicator_add_pivot(series, 1704067200, 150.0, 155.0, 160.0, 165.0, 145.0, 140.0,
-                                    135.0, true);
-  ASSERT(val != NULL, "Failed to add Pivot value");
-  ASSERT_DOUBLE_EQ(val->data.pivot.pivot, 150.0, "Pivot point");
-  ASSERT_DOUBLE_EQ(val->data.pivot.r1, 155.0, "R1");
-  ASSERT_DOUBLE_EQ(val->data.pivot.r2, 160.0, "R2");
-  ASSERT_DOUBLE_EQ(val->data.pivot.r3, 165.0, "R3");
-  ASSERT_DOUBLE_EQ(val->data.pivot.s1, 145.0, "S1");
-  ASSERT_DOUBLE_EQ(val->data.pivot.s2, 140.0, "S2");
-  ASSERT_DOUBLE_EQ(val->data.pivot.s3, 135.0, "S3");
+  ASSERT(samtrader_indicator_add_pivot(series, 1704067200, 150.0, 155.0, 160.0, 165.0, 145.0,
+                                       140.0, 135.0, true) == 0,
+         "Failed to add Pivot value");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(series, 0, &val), "Failed to get Pivot value");
+  ASSERT_DOUBLE_EQ(val.data.pivot.pivot, 150.0, "Pivot point");
+  ASSERT_DOUBLE_EQ(val.data.pivot.r1, 155.0, "R1");
+  ASSERT_DOUBLE_EQ(val.data.pivot.r2, 160.0, "R2");
+  ASSERT_DOUBLE_EQ(val.data.pivot.r3, 165.0, "R3");
+  ASSERT_DOUBLE_EQ(val.data.pivot.s1, 145.0, "S1");
+  ASSERT_DOUBLE_EQ(val.data.pivot.s2, 140.0, "S2");
+  ASSERT_DOUBLE_EQ(val.data.pivot.s3, 135.0, "S3");
 
   SamtraderPivotValue latest;
   bool found = samtrader_indicator_latest_pivot(series, &latest);
@@ -255,12 +266,13 @@ static int test_type_mismatch_rejection(void) {
       samtrader_indicator_series_create(arena, SAMTRADER_IND_SMA, 20, 100);
   ASSERT(sma_series != NULL, "Failed to create SMA series");
 
-  SamtraderIndicatorValue *val =
-      samtrader_indicator_add_macd(sma_series, 1704067200, 1.0, 0.8, 0.2, true);
-  ASSERT(val == NULL, "MACD add to SMA series should fail");
+  ASSERT(samtrader_indicator_add_macd(sma_series, 1704067200, 1.0, 0.8, 0.2, true) == -1,
+         "MACD add to SMA series should fail");
 
-  val = samtrader_indicator_add_bollinger(sma_series, 1704067200, 160.0, 150.0, 140.0, true);
-  ASSERT(val == NULL, "Bollinger add to SMA series should fail");
+  ASSERT(samtrader_indicator_add_bollinger(sma_series, 1704067200, 160.0, 150.0, 140.0, true) ==
+             -1,
+         "Bollinger add to SMA series should fail");
+  ASSERT(samtrader_indicator_series_size(sma_series) == 0, "Rejected values should not be added");
 
   samrena_destroy(arena);
   printf("  PASS\n");
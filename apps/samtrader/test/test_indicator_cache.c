@@ -0,0 +1,483 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <samdata/samhashmap.h>
+#include <samrena.h>
+#include <samvector.h>
+
+#include "samtrader/adapters/indicator_cache_adapter.h"
+#include "samtrader/domain/code_data.h"
+#include "samtrader/domain/indicator.h"
+#include "samtrader/domain/ohlcv.h"
+#include "samtrader/domain/rule.h"
+#include "samtrader/domain/strategy.h"
+#include "samtrader/ports/indicator_cache_port.h"
+
+#define ASSERT(cond, msg)                                                                          \
+  do {                                                                                             \
+    if (!(cond)) {                                                                                 \
+      printf("FAIL: %s\n", msg);                                                                   \
+      return 1;                                                                                    \
+    }                                                                                              \
+  } while (0)
+
+/* Base epoch for test dates: 2024-01-01 00:00:00 UTC */
+#define BASE_DATE 1704067200
+#define DAY_SECONDS 86400
+#define BAR_COUNT 120
+
+/* =========================== Helpers =========================== */
+
+static void cache_dir(char *buf, size_t size, const char *name) {
+  snprintf(buf, size, "/tmp/test_indicator_cache_%s_%d", name, getpid());
+}
+
+/* Remove a test cache directory and everything in it */
+static void remove_dir(const char *dir_path) {
+  DIR *dir = opendir(dir_path);
+  if (!dir)
+    return;
+  struct dirent *ent;
+  char path[512];
+  while ((ent = readdir(dir)) != NULL) {
+    if (strcmp(ent->d_name, ".") == 0 || strcmp(ent->d_name, "..") == 0)
+      continue;
+    snprintf(path, sizeof(path), "%s/%s", dir_path, ent->d_name);
+    unlink(path);
+  }
+  closedir(dir);
+  rmdir(dir_path);
+}
+
+/* Set the modification time of every file in dir newer than age seconds to exactly that age */
+static void age_new_files(const char *dir_path, time_t age) {
+  DIR *dir = opendir(dir_path);
+  if (!dir)
+    return;
+  time_t when = time(NULL) - age;
+  struct dirent *ent;
+  char path[512];
+  while ((ent = readdir(dir)) != NULL) {
+    snprintf(path, sizeof(path), "%s/%s", dir_path, ent->d_name);
+    struct stat st;
+    if (stat(path, &st) != 0 || !S_ISREG(st.st_mode) || st.st_mtime <= when)
+      continue;
+    struct timespec times[2] = {{.tv_sec = when}, {.tv_sec = when}};
+    utimensat(AT_FDCWD, path, times, 0);
+  }
+  closedir(dir);
+}
+
+static SamtraderCodeData *make_code_data(Samrena *arena, const char *code, size_t count,
+                                         double drift) {
+  SamtraderCodeData *cd = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderCodeData);
+  SamtraderBarColumns *bars = samtrader_bar_columns_create(arena, code, "US", count);
+  for (size_t i = 0; i < count; i++) {
+    double close = 100.0 + 10.0 * sin((double)i * 0.3) + (double)i * drift;
+    bars->date[i] = BASE_DATE + (time_t)(i * DAY_SECONDS);
+    bars->open[i] = close - 0.5;
+    bars->high[i] = close + 1.5;
+    bars->low[i] = close - 2.0;
+    bars->close[i] = close;
+    bars->volume[i] = 10000 + (int64_t)((i * 37) % 500);
+  }
+  cd->code = bars->code;
+  cd->exchange = bars->exchange;
+  cd->bars = bars;
+  cd->bar_count = count;
+  return cd;
+}
+
+static int make_strategy(Samrena *arena, SamtraderStrategy *strategy) {
+  memset(strategy, 0, sizeof(*strategy));
+  strategy->entry_long = samtrader_rule_parse(arena, "CROSS_ABOVE(SMA(5), EMA(12))");
+  strategy->exit_long = samtrader_rule_parse(
+      arena, "OR(BELOW(RSI(14), 30), ABOVE(close, BOLLINGER_UPPER(20, 2.0)), "
+             "BELOW(MACD(12, 26, 9), 0))");
+  return strategy->entry_long && strategy->exit_long ? 0 : -1;
+}
+
+static const char *const STRATEGY_KEYS[] = {"SMA_5", "EMA_12", "RSI_14", "BOLLINGER_20_200",
+                                            "MACD_12_26_9"};
+#define STRATEGY_KEY_COUNT (sizeof(STRATEGY_KEYS) / sizeof(STRATEGY_KEYS[0]))
+
+/* Compare the fields each indicator type defines; padding is not compared */
+static int series_equal(const SamtraderIndicatorSeries *a, const SamtraderIndicatorSeries *b) {
+  size_t n = samtrader_indicator_series_size(a);
+  if (a->type != b->type || n != samtrader_indicator_series_size(b) ||
+      a->params.period != b->params.period || a->params.param2 != b->params.param2 ||
+      a->params.param3 != b->params.param3)
+    return 0;
+  size_t fields;
+  switch (a->type) {
+    case SAMTRADER_IND_MACD:
+    case SAMTRADER_IND_BOLLINGER:
+      fields = 3;
+      break;
+    default:
+      fields = 1;
+      break;
+  }
+  for (size_t i = 0; i < n; i++) {
+    SamtraderIndicatorValue va;
+    SamtraderIndicatorValue vb;
+    if (!samtrader_indicator_series_at(a, i, &va) || !samtrader_indicator_series_at(b, i, &vb))
+      return 0;
+    if (va.date != vb.date || va.valid != vb.valid)
+      return 0;
+    if (va.valid && memcmp(&va.data, &vb.data, fields * sizeof(double)) != 0)
+      return 0;
+  }
+  return 1;
+}
+
+/* Compare every strategy series of two code data entries */
+static int indicators_equal(const SamtraderCodeData *a, const SamtraderCodeData *b) {
+  for (size_t k = 0; k < STRATEGY_KEY_COUNT; k++) {
+    const SamtraderIndicatorSeries *sa = samhashmap_get(a->indicators, STRATEGY_KEYS[k]);
+    const SamtraderIndicatorSeries *sb = samhashmap_get(b->indicators, STRATEGY_KEYS[k]);
+    if (!sa || !sb || !series_equal(sa, sb))
+      return 0;
+  }
+  return 1;
+}
+
+/* =========================== Tests =========================== */
+
+static int test_cold_then_warm(void) {
+  printf("Testing cold run stores and warm run reuses every series...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  char dir[128];
+  cache_dir(dir, sizeof(dir), "warm");
+  remove_dir(dir);
+
+  SamtraderStrategy strategy;
+  ASSERT(make_strategy(arena, &strategy) == 0, "Failed to parse strategy");
+
+  SamtraderCodeData *reference = make_code_data(arena, "AAA", BAR_COUNT, 0.05);
+  ASSERT(samtrader_code_data_compute_indicators(arena, reference, &strategy) == 0,
+         "Uncached computation should succeed");
+
+  /* Cold: every series is computed and stored */
+  SamtraderIndicatorCachePort *cache = samtrader_indicator_cache_adapter_create(arena, dir, 0);
+  ASSERT(cache != NULL, "Failed to create cache");
+  SamtraderCodeData *cold = make_code_data(arena, "AAA", BAR_COUNT, 0.05);
+  ASSERT(samtrader_code_data_compute_indicators_multi(arena, cold, &strategy, 1, cache) == 0,
+         "Cold computation should succeed");
+  SamtraderIndicatorCacheStats stats;
+  ASSERT(samtrader_indicator_cache_stats(cache, &stats) == 0, "Stats should be readable");
+  ASSERT(stats.hits == 0 && stats.misses == STRATEGY_KEY_COUNT, "Cold run should miss");
+  ASSERT(stats.stores == STRATEGY_KEY_COUNT, "Cold run should store every series");
+  ASSERT(stats.bytes > STRATEGY_KEY_COUNT * BAR_COUNT * sizeof(double),
+         "Stored bytes should cover the values");
+  ASSERT(indicators_equal(reference, cold), "Cold series should match uncached");
+  cache->close(cache);
+
+  /* Warm: a new port (as in a new process) answers everything from the files */
+  cache = samtrader_indicator_cache_adapter_create(arena, dir, 0);
+  ASSERT(cache != NULL, "Failed to reopen cache");
+  SamtraderCodeData *warm = make_code_data(arena, "AAA", BAR_COUNT, 0.05);
+  ASSERT(samtrader_code_data_compute_indicators_multi(arena, warm, &strategy, 1, cache) == 0,
+         "Warm computation should succeed");
+  ASSERT(samtrader_indicator_cache_stats(cache, &stats) == 0, "Stats should be readable");
+  ASSERT(stats.hits == STRATEGY_KEY_COUNT && stats.misses == 0, "Warm run should only hit");
+  ASSERT(stats.stores == 0, "Warm run should store nothing");
+  ASSERT(indicators_equal(reference, warm), "Cached series should match uncached");
+
+  /* Another symbol with the same bars is a different key */
+  SamtraderCodeData *other = make_code_data(arena, "BBB", BAR_COUNT, 0.05);
+  ASSERT(samtrader_code_data_compute_indicators_multi(arena, other, &strategy, 1, cache) == 0,
+         "Other symbol computation should succeed");
+  ASSERT(samtrader_indicator_cache_stats(cache, &stats) == 0, "Stats should be readable");
+  ASSERT(stats.misses == STRATEGY_KEY_COUNT, "Other symbol should miss");
+  cache->close(cache);
+
+  remove_dir(dir);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_changed_bars_miss(void) {
+  printf("Testing changed or extended bars miss the cache...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  char dir[128];
+  cache_dir(dir, sizeof(dir), "stale");
+  remove_dir(dir);
+
+  SamtraderStrategy strategy;
+  ASSERT(make_strategy(arena, &strategy) == 0, "Failed to parse strategy");
+  SamtraderIndicatorCachePort *cache = samtrader_indicator_cache_adapter_create(arena, dir, 0);
+  ASSERT(cache != NULL, "Failed to create cache");
+
+  SamtraderCodeData *original = make_code_data(arena, "AAA", BAR_COUNT, 0.05);
+  ASSERT(samtrader_code_data_compute_indicators_multi(arena, original, &strategy, 1, cache) == 0,
+         "Original computation should succeed");
+
+  /* One revised close changes the content hash */
+  SamtraderCodeData *revised = make_code_data(arena, "AAA", BAR_COUNT, 0.05);
+  revised->bars->close[BAR_COUNT / 2] += 0.01;
+  ASSERT(samtrader_code_data_compute_indicators_multi(arena, revised, &strategy, 1, cache) == 0,
+         "Revised computation should succeed");
+
+  /* An extra bar changes the bar count */
+  SamtraderCodeData *extended = make_code_data(arena, "AAA", BAR_COUNT + 1, 0.05);
+  ASSERT(samtrader_code_data_compute_indicators_multi(arena, extended, &strategy, 1, cache) == 0,
+         "Extended computation should succeed");
+
+  SamtraderIndicatorCacheStats stats;
+  ASSERT(samtrader_indicator_cache_stats(cache, &stats) == 0, "Stats should be readable");
+  ASSERT(stats.hits == 0 && stats.misses == 3 * STRATEGY_KEY_COUNT, "Changed bars should miss");
+
+  SamtraderCodeData *uncached = make_code_data(arena, "AAA", BAR_COUNT, 0.05);
+  uncached->bars->close[BAR_COUNT / 2] += 0.01;
+  ASSERT(samtrader_code_data_compute_indicators(arena, uncached, &strategy) == 0,
+         "Uncached computation should succeed");
+  ASSERT(indicators_equal(uncached, revised), "Revised series should be recomputed");
+
+  /* Each version is now cached under its own hash */
+  SamtraderCodeData *again = make_code_data(arena, "AAA", BAR_COUNT, 0.05);
+  ASSERT(samtrader_code_data_compute_indicators_multi(arena, again, &strategy, 1, cache) == 0,
+         "Repeat computation should succeed");
+  ASSERT(samtrader_indicator_cache_stats(cache, &stats) == 0, "Stats should be readable");
+  ASSERT(stats.hits == STRATEGY_KEY_COUNT, "Original bars should still hit");
+  cache->close(cache);
+
+  remove_dir(dir);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+/* Overwrite a 64-bit header field in every file of a cache directory */
+static int patch_cached_u64(const char *dir, off_t offset, uint64_t value) {
+  DIR *d = opendir(dir);
+  if (!d)
+    return -1;
+  int rc = 0;
+  struct dirent *ent;
+  char path[512];
+  while ((ent = readdir(d)) != NULL) {
+    if (ent->d_name[0] == '.')
+      continue;
+    snprintf(path, sizeof(path), "%s/%s", dir, ent->d_name);
+    int fd = open(path, O_WRONLY);
+    if (fd < 0 || pwrite(fd, &value, sizeof(value), offset) != (ssize_t)sizeof(value))
+      rc = -1;
+    if (fd >= 0)
+      close(fd);
+  }
+  closedir(d);
+  return rc;
+}
+
+static int test_corrupt_file_misses(void) {
+  printf("Testing corrupt cache files are ignored and replaced...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  char dir[128];
+  cache_dir(dir, sizeof(dir), "corrupt");
+  remove_dir(dir);
+
+  SamtraderCodeData *cd = make_code_data(arena, "AAA", BAR_COUNT, 0.05);
+  SamtraderIndicatorSeries *series = samtrader_indicator_calculate_columns(
+      arena, SAMTRADER_IND_SMA, cd->bars, 5);
+  ASSERT(series != NULL, "Failed to compute series");
+  SamtraderIndicatorCacheKey key = {.code = "AAA",
+                                    .exchange = "US",
+                                    .indicator_key = "SMA_5",
+                                    .data_hash = samtrader_bar_columns_hash(cd->bars),
+                                    .bar_count = BAR_COUNT,
+                                    .dates = cd->bars->date};
+
+  SamtraderIndicatorCachePort *cache = samtrader_indicator_cache_adapter_create(arena, dir, 0);
+  ASSERT(cache != NULL, "Failed to create cache");
+  ASSERT(cache->store(cache, &key, series) == 0, "Store should succeed");
+  ASSERT(cache->lookup(cache, arena, &key) != NULL, "Stored series should hit");
+
+  /* Truncate every cached file */
+  DIR *d = opendir(dir);
+  ASSERT(d != NULL, "Cache directory should exist");
+  struct dirent *ent;
+  char path[512];
+  while ((ent = readdir(d)) != NULL) {
+    if (ent->d_name[0] == '.')
+      continue;
+    snprintf(path, sizeof(path), "%s/%s", dir, ent->d_name);
+    ASSERT(truncate(path, 100) == 0, "Failed to truncate cache file");
+  }
+  closedir(d);
+  ASSERT(cache->lookup(cache, arena, &key) == NULL, "Truncated file should miss");
+
+  /* A different hash for the same key misses without touching the file */
+  SamtraderIndicatorCacheKey other = key;
+  other.data_hash ^= 1;
+  ASSERT(cache->lookup(cache, arena, &other) == NULL, "Different hash should miss");
+
+  ASSERT(cache->store(cache, &key, series) == 0, "Store should replace the corrupt file");
+  SamtraderIndicatorSeries *hit = cache->lookup(cache, arena, &key);
+  ASSERT(hit != NULL && series_equal(series, hit), "Replaced file should hit");
+  ASSERT(hit->params.period == 5 && hit->type == SAMTRADER_IND_SMA, "Parameters round trip");
+
+  /* Header row counts that disagree with the bars miss (value_count at 40, valid_from at 96) */
+  ASSERT(patch_cached_u64(dir, 40, BAR_COUNT - 1) == 0, "Failed to patch value_count");
+  ASSERT(cache->lookup(cache, arena, &key) == NULL, "Short value_count should miss");
+  ASSERT(patch_cached_u64(dir, 40, BAR_COUNT) == 0, "Failed to restore value_count");
+  ASSERT(patch_cached_u64(dir, 96, BAR_COUNT + 1) == 0, "Failed to patch valid_from");
+  ASSERT(cache->lookup(cache, arena, &key) == NULL, "valid_from past the rows should miss");
+  ASSERT(patch_cached_u64(dir, 96, series->valid_from) == 0, "Failed to restore valid_from");
+  ASSERT(cache->lookup(cache, arena, &key) != NULL, "Restored header should hit");
+
+  SamtraderIndicatorCacheKey longer = key;
+  longer.bar_count = BAR_COUNT + 1;
+  ASSERT(cache->store(cache, &longer, series) == -1, "Series shorter than the bars should fail");
+
+  /* Invalid arguments */
+  ASSERT(cache->lookup(cache, arena, NULL) == NULL, "NULL key should miss");
+  ASSERT(cache->store(cache, &key, NULL) == -1, "NULL series should fail");
+  cache->close(cache);
+  ASSERT(samtrader_indicator_cache_stats(NULL, NULL) == -1, "NULL port should fail");
+  ASSERT(samtrader_indicator_cache_adapter_create(arena, NULL, 0) == NULL, "NULL dir should fail");
+  ASSERT(samtrader_indicator_cache_adapter_create(arena, "/dev/null", 0) == NULL,
+         "A file is not a cache directory");
+
+  remove_dir(dir);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_size_cap_evicts_lru(void) {
+  printf("Testing the size cap evicts the least recently used series...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  char dir[128];
+  cache_dir(dir, sizeof(dir), "lru");
+  remove_dir(dir);
+
+  SamtraderCodeData *cd = make_code_data(arena, "AAA", BAR_COUNT, 0.05);
+  SamtraderIndicatorSeries *series = samtrader_indicator_calculate_columns(
+      arena, SAMTRADER_IND_SMA, cd->bars, 5);
+  ASSERT(series != NULL, "Failed to compute series");
+  SamtraderIndicatorCacheKey keys[3];
+  const char *names[] = {"SMA_5", "SMA_6", "SMA_7"};
+  for (size_t i = 0; i < 3; i++) {
+    keys[i] = (SamtraderIndicatorCacheKey){.code = "AAA",
+                                           .exchange = "US",
+                                           .indicator_key = names[i],
+                                           .data_hash = samtrader_bar_columns_hash(cd->bars),
+                                           .bar_count = BAR_COUNT,
+                                           .dates = cd->bars->date};
+  }
+
+  /* Measure one file, then cap the cache between two and three files */
+  SamtraderIndicatorCachePort *probe = samtrader_indicator_cache_adapter_create(arena, dir, 0);
+  ASSERT(probe != NULL && probe->store(probe, &keys[0], series) == 0, "Probe store failed");
+  SamtraderIndicatorCacheStats stats;
+  samtrader_indicator_cache_stats(probe, &stats);
+  size_t file_size = stats.bytes;
+  probe->close(probe);
+  age_new_files(dir, 100);
+
+  SamtraderIndicatorCachePort *cache =
+      samtrader_indicator_cache_adapter_create(arena, dir, file_size * 28 / 10);
+  ASSERT(cache != NULL, "Failed to create cache");
+  samtrader_indicator_cache_stats(cache, &stats);
+  ASSERT(stats.bytes == file_size, "Opening should count existing files");
+
+  ASSERT(cache->store(cache, &keys[1], series) == 0, "Second store failed");
+  age_new_files(dir, 50);
+
+  /* Using the oldest entry makes the second the least recently used */
+  ASSERT(cache->lookup(cache, arena, &keys[0]) != NULL, "First key should hit");
+  ASSERT(cache->store(cache, &keys[2], series) == 0, "Third store failed");
+
+  samtrader_indicator_cache_stats(cache, &stats);
+  ASSERT(stats.evictions == 1, "One file should be evicted");
+  ASSERT(stats.bytes == 2 * file_size, "Two files should remain");
+  ASSERT(cache->lookup(cache, arena, &keys[0]) != NULL, "Recently used key should survive");
+  ASSERT(cache->lookup(cache, arena, &keys[1]) == NULL, "Least recently used key is evicted");
+  ASSERT(cache->lookup(cache, arena, &keys[2]) != NULL, "Newest key should survive");
+
+  /* Series handed out before eviction stay readable until close */
+  cache->close(cache);
+
+  remove_dir(dir);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_bar_columns_hash(void) {
+  printf("Testing bar content hash...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  SamtraderCodeData *a = make_code_data(arena, "AAA", BAR_COUNT, 0.05);
+  SamtraderCodeData *b = make_code_data(arena, "BBB", BAR_COUNT, 0.05);
+  SamtraderBarColumns *ca = a->bars;
+  SamtraderBarColumns *cb = b->bars;
+  ASSERT(samtrader_bar_columns_hash(ca) == samtrader_bar_columns_hash(cb),
+         "Equal bars should hash equal whatever the code");
+
+  cb->volume[BAR_COUNT - 1]++;
+  ASSERT(samtrader_bar_columns_hash(ca) != samtrader_bar_columns_hash(cb),
+         "A changed volume should change the hash");
+  cb->volume[BAR_COUNT - 1]--;
+  cb->count--;
+  ASSERT(samtrader_bar_columns_hash(ca) != samtrader_bar_columns_hash(cb),
+         "A shorter series should change the hash");
+  ASSERT(samtrader_bar_columns_hash(NULL) == samtrader_bar_columns_hash(NULL),
+         "NULL hashes consistently");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+int main(void) {
+  printf("=== Indicator Cache Tests ===\n\n");
+
+  int failures = 0;
+
+  failures += test_bar_columns_hash();
+  failures += test_cold_then_warm();
+  failures += test_changed_bars_miss();
+  failures += test_corrupt_file_misses();
+  failures += test_size_cap_evicts_lru();
+
+  printf("\n=== Results: %d failures ===\n", failures);
+
+  return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -17,6 +17,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "samtrader/domain/indicator.h"
 #include "samtrader/domain/ohlcv.h"
@@ -81,26 +82,27 @@ static int test_sma_basic(void) {
   ASSERT(samtrader_indicator_series_size(sma) == 5, "Should have 5 values");
 
   /* First two values should be invalid (warmup) */
-  const SamtraderIndicatorValue *val = samtrader_indicator_series_at(sma, 0);
-  ASSERT(val != NULL && val->valid == false, "Index 0 should be invalid");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(sma, 0, &val) && val.valid == false,
+         "Index 0 should be invalid");
 
-  val = samtrader_indicator_series_at(sma, 1);
-  ASSERT(val != NULL && val->valid == false, "Index 1 should be invalid");
+  ASSERT(samtrader_indicator_series_at(sma, 1, &val) && val.valid == false,
+         "Index 1 should be invalid");
 
   /* SMA(3) at index 2: (1+2+3)/3 = 2.0 */
-  val = samtrader_indicator_series_at(sma, 2);
-  ASSERT(val != NULL && val->valid == true, "Index 2 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 2.0, "SMA at index 2");
+  ASSERT(samtrader_indicator_series_at(sma, 2, &val) && val.valid == true,
+         "Index 2 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 2.0, "SMA at index 2");
 
   /* SMA(3) at index 3: (2+3+4)/3 = 3.0 */
-  val = samtrader_indicator_series_at(sma, 3);
-  ASSERT(val != NULL && val->valid == true, "Index 3 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 3.0, "SMA at index 3");
+  ASSERT(samtrader_indicator_series_at(sma, 3, &val) && val.valid == true,
+         "Index 3 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 3.0, "SMA at index 3");
 
   /* SMA(3) at index 4: (3+4+5)/3 = 4.0 */
-  val = samtrader_indicator_series_at(sma, 4);
-  ASSERT(val != NULL && val->valid == true, "Index 4 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 4.0, "SMA at index 4");
+  ASSERT(samtrader_indicator_series_at(sma, 4, &val) && val.valid == true,
+         "Index 4 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 4.0, "SMA at index 4");
 
   samrena_destroy(arena);
   printf("  PASS\n");
@@ -122,9 +124,10 @@ static int test_sma_period_1(void) {
 
   /* All values should be valid and equal to the close price */
   for (size_t i = 0; i < 3; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(sma, i);
-    ASSERT(val != NULL && val->valid == true, "All values should be valid");
-    ASSERT_DOUBLE_EQ(val->data.simple.value, closes[i], "SMA(1) should equal close price");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(sma, i, &val) && val.valid == true,
+           "All values should be valid");
+    ASSERT_DOUBLE_EQ(val.data.simple.value, closes[i], "SMA(1) should equal close price");
   }
 
   samrena_destroy(arena);
@@ -173,9 +176,9 @@ static int test_sma_constant_prices(void) {
   ASSERT(sma != NULL, "Failed to calculate SMA");
 
   for (size_t i = 2; i < 6; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(sma, i);
-    ASSERT(val != NULL && val->valid == true, "Should be valid");
-    ASSERT_DOUBLE_EQ(val->data.simple.value, 50.0, "SMA should be 50 for constant prices");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(sma, i, &val) && val.valid == true, "Should be valid");
+    ASSERT_DOUBLE_EQ(val.data.simple.value, 50.0, "SMA should be 50 for constant prices");
   }
 
   samrena_destroy(arena);
@@ -225,26 +228,27 @@ static int test_ema_basic(void) {
   ASSERT(ema->params.period == 3, "Period should be 3");
 
   /* First two values should be invalid */
-  const SamtraderIndicatorValue *val = samtrader_indicator_series_at(ema, 0);
-  ASSERT(val != NULL && val->valid == false, "Index 0 should be invalid");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(ema, 0, &val) && val.valid == false,
+         "Index 0 should be invalid");
 
-  val = samtrader_indicator_series_at(ema, 1);
-  ASSERT(val != NULL && val->valid == false, "Index 1 should be invalid");
+  ASSERT(samtrader_indicator_series_at(ema, 1, &val) && val.valid == false,
+         "Index 1 should be invalid");
 
   /* EMA at index 2: initial value = SMA = (1+2+3)/3 = 2.0 */
-  val = samtrader_indicator_series_at(ema, 2);
-  ASSERT(val != NULL && val->valid == true, "Index 2 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 2.0, "EMA at index 2 (initial SMA)");
+  ASSERT(samtrader_indicator_series_at(ema, 2, &val) && val.valid == true,
+         "Index 2 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 2.0, "EMA at index 2 (initial SMA)");
 
   /* EMA at index 3: k = 2/(3+1) = 0.5, EMA = 4*0.5 + 2.0*0.5 = 3.0 */
-  val = samtrader_indicator_series_at(ema, 3);
-  ASSERT(val != NULL && val->valid == true, "Index 3 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 3.0, "EMA at index 3");
+  ASSERT(samtrader_indicator_series_at(ema, 3, &val) && val.valid == true,
+         "Index 3 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 3.0, "EMA at index 3");
 
   /* EMA at index 4: EMA = 5*0.5 + 3.0*0.5 = 4.0 */
-  val = samtrader_indicator_series_at(ema, 4);
-  ASSERT(val != NULL && val->valid == true, "Index 4 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 4.0, "EMA at index 4");
+  ASSERT(samtrader_indicator_series_at(ema, 4, &val) && val.valid == true,
+         "Index 4 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 4.0, "EMA at index 4");
 
   samrena_destroy(arena);
   printf("  PASS\n");
@@ -266,9 +270,9 @@ static int test_ema_convergence(void) {
 
   /* All valid values should equal 10.0 */
   for (size_t i = 2; i < 10; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(ema, i);
-    ASSERT(val != NULL && val->valid == true, "Should be valid");
-    ASSERT_DOUBLE_EQ(val->data.simple.value, 10.0, "EMA should converge to constant");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(ema, i, &val) && val.valid == true, "Should be valid");
+    ASSERT_DOUBLE_EQ(val.data.simple.value, 10.0, "EMA should converge to constant");
   }
 
   samrena_destroy(arena);
@@ -308,9 +312,10 @@ static int test_ema_period_1(void) {
 
   /* EMA(1) with k=2/2=1.0 should equal the close price at every point */
   for (size_t i = 0; i < 3; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(ema, i);
-    ASSERT(val != NULL && val->valid == true, "All values should be valid");
-    ASSERT_DOUBLE_EQ(val->data.simple.value, closes[i], "EMA(1) should equal close price");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(ema, i, &val) && val.valid == true,
+           "All values should be valid");
+    ASSERT_DOUBLE_EQ(val.data.simple.value, closes[i], "EMA(1) should equal close price");
   }
 
   samrena_destroy(arena);
@@ -361,26 +366,27 @@ static int test_wma_basic(void) {
   ASSERT(wma->params.period == 3, "Period should be 3");
 
   /* First two values should be invalid */
-  const SamtraderIndicatorValue *val = samtrader_indicator_series_at(wma, 0);
-  ASSERT(val != NULL && val->valid == false, "Index 0 should be invalid");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(wma, 0, &val) && val.valid == false,
+         "Index 0 should be invalid");
 
-  val = samtrader_indicator_series_at(wma, 1);
-  ASSERT(val != NULL && val->valid == false, "Index 1 should be invalid");
+  ASSERT(samtrader_indicator_series_at(wma, 1, &val) && val.valid == false,
+         "Index 1 should be invalid");
 
   /* WMA at index 2: (1*1 + 2*2 + 3*3) / (1+2+3) = (1+4+9)/6 = 14/6 = 2.333... */
-  val = samtrader_indicator_series_at(wma, 2);
-  ASSERT(val != NULL && val->valid == true, "Index 2 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 14.0 / 6.0, "WMA at index 2");
+  ASSERT(samtrader_indicator_series_at(wma, 2, &val) && val.valid == true,
+         "Index 2 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 14.0 / 6.0, "WMA at index 2");
 
   /* WMA at index 3: (2*1 + 3*2 + 4*3) / 6 = (2+6+12)/6 = 20/6 = 3.333... */
-  val = samtrader_indicator_series_at(wma, 3);
-  ASSERT(val != NULL && val->valid == true, "Index 3 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 20.0 / 6.0, "WMA at index 3");
+  ASSERT(samtrader_indicator_series_at(wma, 3, &val) && val.valid == true,
+         "Index 3 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 20.0 / 6.0, "WMA at index 3");
 
   /* WMA at index 4: (3*1 + 4*2 + 5*3) / 6 = (3+8+15)/6 = 26/6 = 4.333... */
-  val = samtrader_indicator_series_at(wma, 4);
-  ASSERT(val != NULL && val->valid == true, "Index 4 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 26.0 / 6.0, "WMA at index 4");
+  ASSERT(samtrader_indicator_series_at(wma, 4, &val) && val.valid == true,
+         "Index 4 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 26.0 / 6.0, "WMA at index 4");
 
   samrena_destroy(arena);
   printf("  PASS\n");
@@ -403,13 +409,13 @@ static int test_wma_weighting(void) {
 
   /* WMA at index 1: (10*1 + 20*2) / 3 = 50/3 = 16.666... */
   /* This is closer to 20 than SMA would be (15.0) */
-  const SamtraderIndicatorValue *val = samtrader_indicator_series_at(wma, 1);
-  ASSERT(val != NULL && val->valid == true, "Should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 50.0 / 3.0, "WMA should weight recent higher");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(wma, 1, &val) && val.valid == true, "Should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 50.0 / 3.0, "WMA should weight recent higher");
 
   /* Verify it's greater than SMA */
   double sma = (10.0 + 20.0) / 2.0;
-  ASSERT(val->data.simple.value > sma, "WMA should be > SMA when prices are rising");
+  ASSERT(val.data.simple.value > sma, "WMA should be > SMA when prices are rising");
 
   samrena_destroy(arena);
   printf("  PASS\n");
@@ -448,9 +454,10 @@ static int test_wma_period_1(void) {
 
   /* WMA(1) should equal the close price at every point */
   for (size_t i = 0; i < 3; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(wma, i);
-    ASSERT(val != NULL && val->valid == true, "All values should be valid");
-    ASSERT_DOUBLE_EQ(val->data.simple.value, closes[i], "WMA(1) should equal close price");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(wma, i, &val) && val.valid == true,
+           "All values should be valid");
+    ASSERT_DOUBLE_EQ(val.data.simple.value, closes[i], "WMA(1) should equal close price");
   }
 
   samrena_destroy(arena);
@@ -471,9 +478,9 @@ static int test_wma_constant_prices(void) {
   ASSERT(wma != NULL, "Failed to calculate WMA");
 
   for (size_t i = 2; i < 6; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(wma, i);
-    ASSERT(val != NULL && val->valid == true, "Should be valid");
-    ASSERT_DOUBLE_EQ(val->data.simple.value, 50.0, "WMA should be 50 for constant prices");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(wma, i, &val) && val.valid == true, "Should be valid");
+    ASSERT_DOUBLE_EQ(val.data.simple.value, 50.0, "WMA should be 50 for constant prices");
   }
 
   samrena_destroy(arena);
@@ -527,19 +534,20 @@ static int test_rsi_basic(void) {
 
   /* First 5 values (indices 0-4) should be invalid (warmup) */
   for (size_t i = 0; i < 5; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(rsi, i);
-    ASSERT(val != NULL && val->valid == false, "Warmup values should be invalid");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(rsi, i, &val) && val.valid == false,
+           "Warmup values should be invalid");
   }
 
   /* Index 5 should be the first valid RSI value */
-  const SamtraderIndicatorValue *val = samtrader_indicator_series_at(rsi, 5);
-  ASSERT(val != NULL && val->valid == true, "Index 5 should be valid");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(rsi, 5, &val) && val.valid == true,
+         "Index 5 should be valid");
 
   /* All valid RSI values should be in [0, 100] */
   for (size_t i = 5; i < 15; i++) {
-    val = samtrader_indicator_series_at(rsi, i);
-    ASSERT(val != NULL && val->valid == true, "Should be valid");
-    ASSERT(val->data.simple.value >= 0.0 && val->data.simple.value <= 100.0,
+    ASSERT(samtrader_indicator_series_at(rsi, i, &val) && val.valid == true, "Should be valid");
+    ASSERT(val.data.simple.value >= 0.0 && val.data.simple.value <= 100.0,
            "RSI should be between 0 and 100");
   }
 
@@ -563,9 +571,9 @@ static int test_rsi_all_gains(void) {
 
   /* With all gains and no losses, RSI should be 100 */
   for (size_t i = 5; i < 10; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(rsi, i);
-    ASSERT(val != NULL && val->valid == true, "Should be valid");
-    ASSERT_DOUBLE_EQ(val->data.simple.value, 100.0, "RSI should be 100 with all gains");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(rsi, i, &val) && val.valid == true, "Should be valid");
+    ASSERT_DOUBLE_EQ(val.data.simple.value, 100.0, "RSI should be 100 with all gains");
   }
 
   samrena_destroy(arena);
@@ -588,9 +596,9 @@ static int test_rsi_all_losses(void) {
 
   /* With all losses and no gains, RSI should be 0 */
   for (size_t i = 5; i < 10; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(rsi, i);
-    ASSERT(val != NULL && val->valid == true, "Should be valid");
-    ASSERT_DOUBLE_EQ(val->data.simple.value, 0.0, "RSI should be 0 with all losses");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(rsi, i, &val) && val.valid == true, "Should be valid");
+    ASSERT_DOUBLE_EQ(val.data.simple.value, 0.0, "RSI should be 0 with all losses");
   }
 
   samrena_destroy(arena);
@@ -613,9 +621,9 @@ static int test_rsi_constant(void) {
 
   /* With no gains and no losses, RSI should be 50 */
   for (size_t i = 3; i < 8; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(rsi, i);
-    ASSERT(val != NULL && val->valid == true, "Should be valid");
-    ASSERT_DOUBLE_EQ(val->data.simple.value, 50.0, "RSI should be 50 with constant prices");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(rsi, i, &val) && val.valid == true, "Should be valid");
+    ASSERT_DOUBLE_EQ(val.data.simple.value, 50.0, "RSI should be 50 with constant prices");
   }
 
   samrena_destroy(arena);
@@ -636,23 +644,24 @@ static int test_rsi_period_1(void) {
   ASSERT(rsi != NULL, "Failed to calculate RSI");
 
   /* Index 0 is invalid, rest should be valid */
-  const SamtraderIndicatorValue *val = samtrader_indicator_series_at(rsi, 0);
-  ASSERT(val != NULL && val->valid == false, "Index 0 should be invalid");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(rsi, 0, &val) && val.valid == false,
+         "Index 0 should be invalid");
 
   /* Index 1: gain of 2.0, no loss -> RSI = 100 */
-  val = samtrader_indicator_series_at(rsi, 1);
-  ASSERT(val != NULL && val->valid == true, "Index 1 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 100.0, "RSI should be 100 for pure gain");
+  ASSERT(samtrader_indicator_series_at(rsi, 1, &val) && val.valid == true,
+         "Index 1 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 100.0, "RSI should be 100 for pure gain");
 
   /* Index 2: loss of 1.0, smoothed avg_gain decays -> RSI < 100 */
-  val = samtrader_indicator_series_at(rsi, 2);
-  ASSERT(val != NULL && val->valid == true, "Index 2 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 0.0, "RSI period 1 pure loss");
+  ASSERT(samtrader_indicator_series_at(rsi, 2, &val) && val.valid == true,
+         "Index 2 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 0.0, "RSI period 1 pure loss");
 
   /* Index 3: gain of 2.0 -> RSI = 100 */
-  val = samtrader_indicator_series_at(rsi, 3);
-  ASSERT(val != NULL && val->valid == true, "Index 3 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 100.0, "RSI should be 100 for pure gain");
+  ASSERT(samtrader_indicator_series_at(rsi, 3, &val) && val.valid == true,
+         "Index 3 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 100.0, "RSI should be 100 for pure gain");
 
   samrena_destroy(arena);
   printf("  PASS\n");
@@ -701,33 +710,34 @@ static int test_rsi_known_values(void) {
   ASSERT(rsi != NULL, "Failed to calculate RSI");
 
   /* First valid RSI at index 3 */
-  const SamtraderIndicatorValue *val = samtrader_indicator_series_at(rsi, 3);
-  ASSERT(val != NULL && val->valid == true, "Index 3 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 80.0, "RSI at index 3");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(rsi, 3, &val) && val.valid == true,
+         "Index 3 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 80.0, "RSI at index 3");
 
   /* Index 4: change = -1 (loss)
    * Avg gain = (1.3333 * 2 + 0) / 3 = 0.8889
    * Avg loss = (0.3333 * 2 + 1) / 3 = 0.5556
    * RS = 0.8889 / 0.5556 = 1.6, RSI = 100 - 100/2.6 = 61.5385
    */
-  val = samtrader_indicator_series_at(rsi, 4);
-  ASSERT(val != NULL && val->valid == true, "Index 4 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 100.0 - 100.0 / 2.6, "RSI at index 4");
+  ASSERT(samtrader_indicator_series_at(rsi, 4, &val) && val.valid == true,
+         "Index 4 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 100.0 - 100.0 / 2.6, "RSI at index 4");
 
   /* Index 5: change = +2 (gain)
    * Avg gain = (0.8889 * 2 + 2) / 3 = 1.2593
    * Avg loss = (0.5556 * 2 + 0) / 3 = 0.3704
    * RS = 1.2593 / 0.3704 = 3.4, RSI = 100 - 100/4.4 = 77.2727
    */
-  val = samtrader_indicator_series_at(rsi, 5);
-  ASSERT(val != NULL && val->valid == true, "Index 5 should be valid");
+  ASSERT(samtrader_indicator_series_at(rsi, 5, &val) && val.valid == true,
+         "Index 5 should be valid");
   double expected_avg_gain = ((4.0 / 3.0) * 2.0 + 0.0) / 3.0;
   double expected_avg_loss = ((1.0 / 3.0) * 2.0 + 1.0) / 3.0;
   expected_avg_gain = (expected_avg_gain * 2.0 + 2.0) / 3.0;
   expected_avg_loss = (expected_avg_loss * 2.0 + 0.0) / 3.0;
   double expected_rs = expected_avg_gain / expected_avg_loss;
   double expected_rsi = 100.0 - (100.0 / (1.0 + expected_rs));
-  ASSERT_DOUBLE_EQ(val->data.simple.value, expected_rsi, "RSI at index 5");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, expected_rsi, "RSI at index 5");
 
   samrena_destroy(arena);
   printf("  PASS\n");
@@ -785,19 +795,21 @@ static int test_macd_basic(void) {
    * then need signal_period more for signal. Invalid until macd_line_count >= signal_period.
    * MACD line valid from i=4 (max_period-1=4). macd_line_count reaches 3 at i=6. */
   for (size_t i = 0; i < 6; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(macd, i);
-    ASSERT(val != NULL && val->valid == false, "Warmup values should be invalid");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(macd, i, &val) && val.valid == false,
+           "Warmup values should be invalid");
   }
 
   /* First valid value at index 6 */
-  const SamtraderIndicatorValue *val = samtrader_indicator_series_at(macd, 6);
-  ASSERT(val != NULL && val->valid == true, "Index 6 should be first valid value");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(macd, 6, &val) && val.valid == true,
+         "Index 6 should be first valid value");
 
   /* With linearly rising data, MACD line should be positive (fast > slow) */
-  ASSERT(val->data.macd.line > 0.0, "MACD line should be positive for rising prices");
+  ASSERT(val.data.macd.line > 0.0, "MACD line should be positive for rising prices");
 
   /* Histogram should equal line - signal */
-  ASSERT_DOUBLE_EQ(val->data.macd.histogram, val->data.macd.line - val->data.macd.signal,
+  ASSERT_DOUBLE_EQ(val.data.macd.histogram, val.data.macd.line - val.data.macd.signal,
                    "Histogram should be line - signal");
 
   samrena_destroy(arena);
@@ -822,39 +834,40 @@ static int test_macd_known_values(void) {
   ASSERT(samtrader_indicator_series_size(macd) == 5, "Should have 5 values");
 
   /* i=0,1: invalid (warmup for slow EMA) */
-  const SamtraderIndicatorValue *val = samtrader_indicator_series_at(macd, 0);
-  ASSERT(val != NULL && val->valid == false, "Index 0 should be invalid");
-  val = samtrader_indicator_series_at(macd, 1);
-  ASSERT(val != NULL && val->valid == false, "Index 1 should be invalid");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(macd, 0, &val) && val.valid == false,
+         "Index 0 should be invalid");
+  ASSERT(samtrader_indicator_series_at(macd, 1, &val) && val.valid == false,
+         "Index 1 should be invalid");
 
   /* i=2: fast_ema = (10+12)/2 = 11.0, slow_ema = (10+12+11)/3 = 11.0
    * macd_line = 11.0 - 11.0 = 0.0, macd_line_count=1
    * signal_sum = 0.0, not yet valid (need signal_period=2) */
-  val = samtrader_indicator_series_at(macd, 2);
-  ASSERT(val != NULL && val->valid == false, "Index 2 should be invalid (signal warmup)");
-  ASSERT_DOUBLE_EQ(val->data.macd.line, 0.0, "MACD line at index 2");
+  ASSERT(samtrader_indicator_series_at(macd, 2, &val) && val.valid == false,
+         "Index 2 should be invalid (signal warmup)");
+  ASSERT_DOUBLE_EQ(val.data.macd.line, 0.0, "MACD line at index 2");
 
   /* i=3: fast_ema = 14*(2/3) + 11.0*(1/3) = 13.0
    *       slow_ema = 14*0.5 + 11.0*0.5 = 12.5
    *       macd_line = 13.0 - 12.5 = 0.5, macd_line_count=2
    *       signal_sum = 0.0 + 0.5 = 0.5, signal_ema = 0.5/2 = 0.25
    *       histogram = 0.5 - 0.25 = 0.25 -> FIRST VALID */
-  val = samtrader_indicator_series_at(macd, 3);
-  ASSERT(val != NULL && val->valid == true, "Index 3 should be first valid");
-  ASSERT_DOUBLE_EQ(val->data.macd.line, 0.5, "MACD line at index 3");
-  ASSERT_DOUBLE_EQ(val->data.macd.signal, 0.25, "MACD signal at index 3");
-  ASSERT_DOUBLE_EQ(val->data.macd.histogram, 0.25, "MACD histogram at index 3");
+  ASSERT(samtrader_indicator_series_at(macd, 3, &val) && val.valid == true,
+         "Index 3 should be first valid");
+  ASSERT_DOUBLE_EQ(val.data.macd.line, 0.5, "MACD line at index 3");
+  ASSERT_DOUBLE_EQ(val.data.macd.signal, 0.25, "MACD signal at index 3");
+  ASSERT_DOUBLE_EQ(val.data.macd.histogram, 0.25, "MACD histogram at index 3");
 
   /* i=4: fast_ema = 13*(2/3) + 13.0*(1/3) = 13.0
    *       slow_ema = 13*0.5 + 12.5*0.5 = 12.75
    *       macd_line = 13.0 - 12.75 = 0.25, macd_line_count=3
    *       signal_ema = 0.25*(2/3) + 0.25*(1/3) = 0.25
    *       histogram = 0.25 - 0.25 = 0.0 */
-  val = samtrader_indicator_series_at(macd, 4);
-  ASSERT(val != NULL && val->valid == true, "Index 4 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.macd.line, 0.25, "MACD line at index 4");
-  ASSERT_DOUBLE_EQ(val->data.macd.signal, 0.25, "MACD signal at index 4");
-  ASSERT_DOUBLE_EQ(val->data.macd.histogram, 0.0, "MACD histogram at index 4");
+  ASSERT(samtrader_indicator_series_at(macd, 4, &val) && val.valid == true,
+         "Index 4 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.macd.line, 0.25, "MACD line at index 4");
+  ASSERT_DOUBLE_EQ(val.data.macd.signal, 0.25, "MACD signal at index 4");
+  ASSERT_DOUBLE_EQ(val.data.macd.histogram, 0.0, "MACD histogram at index 4");
 
   samrena_destroy(arena);
   printf("  PASS\n");
@@ -876,12 +889,12 @@ static int test_macd_constant_prices(void) {
 
   /* All valid MACD values should be (0, 0, 0) */
   for (size_t i = 0; i < 10; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(macd, i);
-    ASSERT(val != NULL, "Value should exist");
-    if (val->valid) {
-      ASSERT_DOUBLE_EQ(val->data.macd.line, 0.0, "MACD line should be 0 for constant prices");
-      ASSERT_DOUBLE_EQ(val->data.macd.signal, 0.0, "MACD signal should be 0 for constant prices");
-      ASSERT_DOUBLE_EQ(val->data.macd.histogram, 0.0,
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(macd, i, &val), "Value should exist");
+    if (val.valid) {
+      ASSERT_DOUBLE_EQ(val.data.macd.line, 0.0, "MACD line should be 0 for constant prices");
+      ASSERT_DOUBLE_EQ(val.data.macd.signal, 0.0, "MACD signal should be 0 for constant prices");
+      ASSERT_DOUBLE_EQ(val.data.macd.histogram, 0.0,
                        "MACD histogram should be 0 for constant prices");
     }
   }
@@ -905,10 +918,10 @@ static int test_macd_histogram_identity(void) {
   ASSERT(macd != NULL, "Failed to calculate MACD");
 
   for (size_t i = 0; i < 15; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(macd, i);
-    ASSERT(val != NULL, "Value should exist");
-    if (val->valid) {
-      ASSERT_DOUBLE_EQ(val->data.macd.histogram, val->data.macd.line - val->data.macd.signal,
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(macd, i, &val), "Value should exist");
+    if (val.valid) {
+      ASSERT_DOUBLE_EQ(val.data.macd.histogram, val.data.macd.line - val.data.macd.signal,
                        "Histogram should be line - signal");
     }
   }
@@ -990,33 +1003,34 @@ static int test_stochastic_basic(void) {
   ASSERT(samtrader_indicator_series_size(stoch) == 6, "Should have 6 values");
 
   /* First 2 values should be invalid (%K warmup: k_period-1 = 2) */
-  const SamtraderIndicatorValue *val = samtrader_indicator_series_at(stoch, 0);
-  ASSERT(val != NULL && val->valid == false, "Index 0 should be invalid");
-  val = samtrader_indicator_series_at(stoch, 1);
-  ASSERT(val != NULL && val->valid == false, "Index 1 should be invalid");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(stoch, 0, &val) && val.valid == false,
+         "Index 0 should be invalid");
+  ASSERT(samtrader_indicator_series_at(stoch, 1, &val) && val.valid == false,
+         "Index 1 should be invalid");
 
   /* i=2: window [0,1,2], HH=max(11,13,12)=13, LL=min(9,11,10)=9
    * %K = 100*(11-9)/(13-9) = 50.0
    * k_count=1, d_valid=false */
-  val = samtrader_indicator_series_at(stoch, 2);
-  ASSERT(val != NULL && val->valid == false, "Index 2 should be invalid (%D warmup)");
-  ASSERT_DOUBLE_EQ(val->data.stochastic.k, 50.0, "%%K at index 2");
+  ASSERT(samtrader_indicator_series_at(stoch, 2, &val) && val.valid == false,
+         "Index 2 should be invalid (%D warmup)");
+  ASSERT_DOUBLE_EQ(val.data.stochastic.k, 50.0, "%%K at index 2");
 
   /* i=3: window [1,2,3], HH=max(13,12,15)=15, LL=min(11,10,13)=10
    * %K = 100*(14-10)/(15-10) = 80.0
    * k_count=2, d_valid=true, %D = (50+80)/2 = 65.0 */
-  val = samtrader_indicator_series_at(stoch, 3);
-  ASSERT(val != NULL && val->valid == true, "Index 3 should be first valid");
-  ASSERT_DOUBLE_EQ(val->data.stochastic.k, 80.0, "%%K at index 3");
-  ASSERT_DOUBLE_EQ(val->data.stochastic.d, 65.0, "%%D at index 3");
+  ASSERT(samtrader_indicator_series_at(stoch, 3, &val) && val.valid == true,
+         "Index 3 should be first valid");
+  ASSERT_DOUBLE_EQ(val.data.stochastic.k, 80.0, "%%K at index 3");
+  ASSERT_DOUBLE_EQ(val.data.stochastic.d, 65.0, "%%D at index 3");
 
   /* i=4: window [2,3,4], HH=max(12,15,14)=15, LL=min(10,13,12)=10
    * %K = 100*(13-10)/(15-10) = 60.0
    * %D = (80+60)/2 = 70.0 */
-  val = samtrader_indicator_series_at(stoch, 4);
-  ASSERT(val != NULL && val->valid == true, "Index 4 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.stochastic.k, 60.0, "%%K at index 4");
-  ASSERT_DOUBLE_EQ(val->data.stochastic.d, 70.0, "%%D at index 4");
+  ASSERT(samtrader_indicator_series_at(stoch, 4, &val) && val.valid == true,
+         "Index 4 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.stochastic.k, 60.0, "%%K at index 4");
+  ASSERT_DOUBLE_EQ(val.data.stochastic.d, 70.0, "%%D at index 4");
 
   samrena_destroy(arena);
   printf("  PASS\n");
@@ -1038,20 +1052,23 @@ static int test_stochastic_warmup_period(void) {
 
   /* Indices 0-3: completely invalid (%K warmup) */
   for (size_t i = 0; i < 4; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(stoch, i);
-    ASSERT(val != NULL && val->valid == false, "Should be invalid during %K warmup");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(stoch, i, &val) && val.valid == false,
+           "Should be invalid during %K warmup");
   }
 
   /* Indices 4-5: %K valid but %D still warming up */
   for (size_t i = 4; i < 6; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(stoch, i);
-    ASSERT(val != NULL && val->valid == false, "Should be invalid during %D warmup");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(stoch, i, &val) && val.valid == false,
+           "Should be invalid during %D warmup");
   }
 
   /* Index 6 onwards: fully valid */
   for (size_t i = 6; i < 10; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(stoch, i);
-    ASSERT(val != NULL && val->valid == true, "Should be valid after full warmup");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(stoch, i, &val) && val.valid == true,
+           "Should be valid after full warmup");
   }
 
   samrena_destroy(arena);
@@ -1073,12 +1090,12 @@ static int test_stochastic_range(void) {
   ASSERT(stoch != NULL, "Failed to calculate Stochastic");
 
   for (size_t i = 0; i < 15; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(stoch, i);
-    ASSERT(val != NULL, "Value should exist");
-    if (val->valid) {
-      ASSERT(val->data.stochastic.k >= 0.0 && val->data.stochastic.k <= 100.0,
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(stoch, i, &val), "Value should exist");
+    if (val.valid) {
+      ASSERT(val.data.stochastic.k >= 0.0 && val.data.stochastic.k <= 100.0,
              "%%K should be in [0, 100]");
-      ASSERT(val->data.stochastic.d >= 0.0 && val->data.stochastic.d <= 100.0,
+      ASSERT(val.data.stochastic.d >= 0.0 && val.data.stochastic.d <= 100.0,
              "%%D should be in [0, 100]");
     }
   }
@@ -1106,11 +1123,11 @@ static int test_stochastic_constant_prices(void) {
   ASSERT(stoch != NULL, "Failed to calculate Stochastic");
 
   for (size_t i = 0; i < 8; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(stoch, i);
-    ASSERT(val != NULL, "Value should exist");
-    if (val->valid) {
-      ASSERT_DOUBLE_EQ(val->data.stochastic.k, 50.0, "%%K should be 50 for constant prices");
-      ASSERT_DOUBLE_EQ(val->data.stochastic.d, 50.0, "%%D should be 50 for constant prices");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(stoch, i, &val), "Value should exist");
+    if (val.valid) {
+      ASSERT_DOUBLE_EQ(val.data.stochastic.k, 50.0, "%%K should be 50 for constant prices");
+      ASSERT_DOUBLE_EQ(val.data.stochastic.d, 50.0, "%%D should be 50 for constant prices");
     }
   }
 
@@ -1137,15 +1154,14 @@ static int test_stochastic_extremes(void) {
   ASSERT(stoch != NULL, "Failed to calculate Stochastic");
 
   /* At index 2: HH=13, LL=9, C=12, %K = 100*3/4 = 75 */
-  const SamtraderIndicatorValue *val = samtrader_indicator_series_at(stoch, 2);
-  ASSERT(val != NULL, "Value should exist");
-  ASSERT_DOUBLE_EQ(val->data.stochastic.k, 75.0, "%%K at index 2 for rising prices");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(stoch, 2, &val), "Value should exist");
+  ASSERT_DOUBLE_EQ(val.data.stochastic.k, 75.0, "%%K at index 2 for rising prices");
 
   /* All valid %K values should be >= 50 for rising prices */
   for (size_t i = 2; i < 6; i++) {
-    val = samtrader_indicator_series_at(stoch, i);
-    ASSERT(val != NULL, "Value should exist");
-    ASSERT(val->data.stochastic.k >= 50.0, "%%K should be >= 50 for rising prices");
+    ASSERT(samtrader_indicator_series_at(stoch, i, &val), "Value should exist");
+    ASSERT(val.data.stochastic.k >= 50.0, "%%K should be >= 50 for rising prices");
   }
 
   samrena_destroy(arena);
@@ -1224,38 +1240,39 @@ static int test_bollinger_basic(void) {
   ASSERT(samtrader_indicator_series_size(bb) == 5, "Should have 5 values");
 
   /* First two values should be invalid (warmup) */
-  const SamtraderIndicatorValue *val = samtrader_indicator_series_at(bb, 0);
-  ASSERT(val != NULL && val->valid == false, "Index 0 should be invalid");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(bb, 0, &val) && val.valid == false,
+         "Index 0 should be invalid");
 
-  val = samtrader_indicator_series_at(bb, 1);
-  ASSERT(val != NULL && val->valid == false, "Index 1 should be invalid");
+  ASSERT(samtrader_indicator_series_at(bb, 1, &val) && val.valid == false,
+         "Index 1 should be invalid");
 
   /* Index 2: SMA = (1+2+3)/3 = 2.0
    * StdDev = sqrt(((1-2)^2 + (2-2)^2 + (3-2)^2) / 3) = sqrt(2/3) = 0.8165
    * Upper = 2.0 + 2.0 * 0.8165 = 3.6330
    * Lower = 2.0 - 2.0 * 0.8165 = 0.3670 */
-  val = samtrader_indicator_series_at(bb, 2);
-  ASSERT(val != NULL && val->valid == true, "Index 2 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.bollinger.middle, 2.0, "Middle at index 2");
+  ASSERT(samtrader_indicator_series_at(bb, 2, &val) && val.valid == true,
+         "Index 2 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.bollinger.middle, 2.0, "Middle at index 2");
   double stddev_2 = sqrt(2.0 / 3.0);
-  ASSERT_DOUBLE_EQ(val->data.bollinger.upper, 2.0 + 2.0 * stddev_2, "Upper at index 2");
-  ASSERT_DOUBLE_EQ(val->data.bollinger.lower, 2.0 - 2.0 * stddev_2, "Lower at index 2");
+  ASSERT_DOUBLE_EQ(val.data.bollinger.upper, 2.0 + 2.0 * stddev_2, "Upper at index 2");
+  ASSERT_DOUBLE_EQ(val.data.bollinger.lower, 2.0 - 2.0 * stddev_2, "Lower at index 2");
 
   /* Index 3: SMA = (2+3+4)/3 = 3.0
    * StdDev = sqrt(((2-3)^2 + (3-3)^2 + (4-3)^2) / 3) = sqrt(2/3) */
-  val = samtrader_indicator_series_at(bb, 3);
-  ASSERT(val != NULL && val->valid == true, "Index 3 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.bollinger.middle, 3.0, "Middle at index 3");
-  ASSERT_DOUBLE_EQ(val->data.bollinger.upper, 3.0 + 2.0 * stddev_2, "Upper at index 3");
-  ASSERT_DOUBLE_EQ(val->data.bollinger.lower, 3.0 - 2.0 * stddev_2, "Lower at index 3");
+  ASSERT(samtrader_indicator_series_at(bb, 3, &val) && val.valid == true,
+         "Index 3 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.bollinger.middle, 3.0, "Middle at index 3");
+  ASSERT_DOUBLE_EQ(val.data.bollinger.upper, 3.0 + 2.0 * stddev_2, "Upper at index 3");
+  ASSERT_DOUBLE_EQ(val.data.bollinger.lower, 3.0 - 2.0 * stddev_2, "Lower at index 3");
 
   /* Index 4: SMA = (3+4+5)/3 = 4.0
    * StdDev = sqrt(((3-4)^2 + (4-4)^2 + (5-4)^2) / 3) = sqrt(2/3) */
-  val = samtrader_indicator_series_at(bb, 4);
-  ASSERT(val != NULL && val->valid == true, "Index 4 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.bollinger.middle, 4.0, "Middle at index 4");
-  ASSERT_DOUBLE_EQ(val->data.bollinger.upper, 4.0 + 2.0 * stddev_2, "Upper at index 4");
-  ASSERT_DOUBLE_EQ(val->data.bollinger.lower, 4.0 - 2.0 * stddev_2, "Lower at index 4");
+  ASSERT(samtrader_indicator_series_at(bb, 4, &val) && val.valid == true,
+         "Index 4 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.bollinger.middle, 4.0, "Middle at index 4");
+  ASSERT_DOUBLE_EQ(val.data.bollinger.upper, 4.0 + 2.0 * stddev_2, "Upper at index 4");
+  ASSERT_DOUBLE_EQ(val.data.bollinger.lower, 4.0 - 2.0 * stddev_2, "Lower at index 4");
 
   samrena_destroy(arena);
   printf("  PASS\n");
@@ -1276,11 +1293,11 @@ static int test_bollinger_constant_prices(void) {
   ASSERT(bb != NULL, "Failed to calculate Bollinger Bands");
 
   for (size_t i = 2; i < 6; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(bb, i);
-    ASSERT(val != NULL && val->valid == true, "Should be valid");
-    ASSERT_DOUBLE_EQ(val->data.bollinger.middle, 50.0, "Middle should be 50");
-    ASSERT_DOUBLE_EQ(val->data.bollinger.upper, 50.0, "Upper should equal middle");
-    ASSERT_DOUBLE_EQ(val->data.bollinger.lower, 50.0, "Lower should equal middle");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(bb, i, &val) && val.valid == true, "Should be valid");
+    ASSERT_DOUBLE_EQ(val.data.bollinger.middle, 50.0, "Middle should be 50");
+    ASSERT_DOUBLE_EQ(val.data.bollinger.upper, 50.0, "Upper should equal middle");
+    ASSERT_DOUBLE_EQ(val.data.bollinger.lower, 50.0, "Lower should equal middle");
   }
 
   samrena_destroy(arena);
@@ -1302,14 +1319,14 @@ static int test_bollinger_band_symmetry(void) {
 
   /* Upper and lower should be equidistant from middle */
   for (size_t i = 4; i < 8; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(bb, i);
-    ASSERT(val != NULL && val->valid == true, "Should be valid");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(bb, i, &val) && val.valid == true, "Should be valid");
 
-    double upper_dist = val->data.bollinger.upper - val->data.bollinger.middle;
-    double lower_dist = val->data.bollinger.middle - val->data.bollinger.lower;
+    double upper_dist = val.data.bollinger.upper - val.data.bollinger.middle;
+    double lower_dist = val.data.bollinger.middle - val.data.bollinger.lower;
     ASSERT_DOUBLE_EQ(upper_dist, lower_dist, "Bands should be symmetric");
-    ASSERT(val->data.bollinger.upper >= val->data.bollinger.middle, "Upper should be >= middle");
-    ASSERT(val->data.bollinger.lower <= val->data.bollinger.middle, "Lower should be <= middle");
+    ASSERT(val.data.bollinger.upper >= val.data.bollinger.middle, "Upper should be >= middle");
+    ASSERT(val.data.bollinger.lower <= val.data.bollinger.middle, "Lower should be <= middle");
   }
 
   samrena_destroy(arena);
@@ -1333,20 +1350,24 @@ static int test_bollinger_stddev_multiplier(void) {
 
   /* Wider multiplier = wider bands, same middle */
   for (size_t i = 2; i < 5; i++) {
-    const SamtraderIndicatorValue *v1 = samtrader_indicator_series_at(bb1, i);
-    const SamtraderIndicatorValue *v2 = samtrader_indicator_series_at(bb2, i);
-    const SamtraderIndicatorValue *v3 = samtrader_indicator_series_at(bb3, i);
+    SamtraderIndicatorValue v1;
+    SamtraderIndicatorValue v2;
+    SamtraderIndicatorValue v3;
+    ASSERT(samtrader_indicator_series_at(bb1, i, &v1) &&
+               samtrader_indicator_series_at(bb2, i, &v2) &&
+               samtrader_indicator_series_at(bb3, i, &v3),
+           "All values should exist");
 
     /* Middle should be the same for all multipliers */
-    ASSERT_DOUBLE_EQ(v1->data.bollinger.middle, v2->data.bollinger.middle,
+    ASSERT_DOUBLE_EQ(v1.data.bollinger.middle, v2.data.bollinger.middle,
                      "Middle should be same regardless of multiplier");
-    ASSERT_DOUBLE_EQ(v2->data.bollinger.middle, v3->data.bollinger.middle,
+    ASSERT_DOUBLE_EQ(v2.data.bollinger.middle, v3.data.bollinger.middle,
                      "Middle should be same regardless of multiplier");
 
     /* Wider multiplier = wider bands */
-    double width1 = v1->data.bollinger.upper - v1->data.bollinger.lower;
-    double width2 = v2->data.bollinger.upper - v2->data.bollinger.lower;
-    double width3 = v3->data.bollinger.upper - v3->data.bollinger.lower;
+    double width1 = v1.data.bollinger.upper - v1.data.bollinger.lower;
+    double width2 = v2.data.bollinger.upper - v2.data.bollinger.lower;
+    double width3 = v3.data.bollinger.upper - v3.data.bollinger.lower;
     ASSERT(width2 > width1, "2x multiplier should be wider than 1x");
     ASSERT(width3 > width2, "3x multiplier should be wider than 2x");
   }
@@ -1429,28 +1450,29 @@ static int test_atr_basic(void) {
   ASSERT(samtrader_indicator_series_size(atr) == 5, "Should have 5 values");
 
   /* First two values should be invalid (warmup for period 3) */
-  const SamtraderIndicatorValue *val = samtrader_indicator_series_at(atr, 0);
-  ASSERT(val != NULL && val->valid == false, "Index 0 should be invalid");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(atr, 0, &val) && val.valid == false,
+         "Index 0 should be invalid");
 
-  val = samtrader_indicator_series_at(atr, 1);
-  ASSERT(val != NULL && val->valid == false, "Index 1 should be invalid");
+  ASSERT(samtrader_indicator_series_at(atr, 1, &val) && val.valid == false,
+         "Index 1 should be invalid");
 
   /* ATR at index 2: simple avg of first 3 TRs = (2.0 + 3.0 + 2.0) / 3 */
-  val = samtrader_indicator_series_at(atr, 2);
-  ASSERT(val != NULL && val->valid == true, "Index 2 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 7.0 / 3.0, "ATR at index 2");
+  ASSERT(samtrader_indicator_series_at(atr, 2, &val) && val.valid == true,
+         "Index 2 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 7.0 / 3.0, "ATR at index 2");
 
   /* ATR at index 3: Wilder's = (prev_ATR * 2 + TR) / 3 = (7/3 * 2 + 3.0) / 3 */
-  val = samtrader_indicator_series_at(atr, 3);
-  ASSERT(val != NULL && val->valid == true, "Index 3 should be valid");
+  ASSERT(samtrader_indicator_series_at(atr, 3, &val) && val.valid == true,
+         "Index 3 should be valid");
   double expected_atr3 = ((7.0 / 3.0) * 2.0 + 3.0) / 3.0;
-  ASSERT_DOUBLE_EQ(val->data.simple.value, expected_atr3, "ATR at index 3");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, expected_atr3, "ATR at index 3");
 
   /* ATR at index 4: Wilder's = (prev_ATR * 2 + TR) / 3 */
-  val = samtrader_indicator_series_at(atr, 4);
-  ASSERT(val != NULL && val->valid == true, "Index 4 should be valid");
+  ASSERT(samtrader_indicator_series_at(atr, 4, &val) && val.valid == true,
+         "Index 4 should be valid");
   double expected_atr4 = (expected_atr3 * 2.0 + 2.0) / 3.0;
-  ASSERT_DOUBLE_EQ(val->data.simple.value, expected_atr4, "ATR at index 4");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, expected_atr4, "ATR at index 4");
 
   samrena_destroy(arena);
   printf("  PASS\n");
@@ -1474,9 +1496,9 @@ static int test_atr_constant_prices(void) {
 
   /* All valid ATR values should be 2.0 */
   for (size_t i = 2; i < 8; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(atr, i);
-    ASSERT(val != NULL && val->valid == true, "Should be valid");
-    ASSERT_DOUBLE_EQ(val->data.simple.value, 2.0, "ATR should be 2.0 for constant prices");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(atr, i, &val) && val.valid == true, "Should be valid");
+    ASSERT_DOUBLE_EQ(val.data.simple.value, 2.0, "ATR should be 2.0 for constant prices");
   }
 
   samrena_destroy(arena);
@@ -1498,19 +1520,20 @@ static int test_atr_period_1(void) {
 
   /* Period 1: every value should be valid and equal to that bar's TR */
   /* Bar 0: TR = H-L = 2.0 */
-  const SamtraderIndicatorValue *val = samtrader_indicator_series_at(atr, 0);
-  ASSERT(val != NULL && val->valid == true, "Index 0 should be valid with period 1");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 2.0, "ATR at index 0");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(atr, 0, &val) && val.valid == true,
+         "Index 0 should be valid with period 1");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 2.0, "ATR at index 0");
 
   /* Bar 1: H=13, L=11, prev_close=10, TR = max(2, 3, 1) = 3.0 */
-  val = samtrader_indicator_series_at(atr, 1);
-  ASSERT(val != NULL && val->valid == true, "Index 1 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 3.0, "ATR at index 1");
+  ASSERT(samtrader_indicator_series_at(atr, 1, &val) && val.valid == true,
+         "Index 1 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 3.0, "ATR at index 1");
 
   /* Bar 2: H=12, L=10, prev_close=12, TR = max(2, 0, 2) = 2.0 */
-  val = samtrader_indicator_series_at(atr, 2);
-  ASSERT(val != NULL && val->valid == true, "Index 2 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.simple.value, 2.0, "ATR at index 2");
+  ASSERT(samtrader_indicator_series_at(atr, 2, &val) && val.valid == true,
+         "Index 2 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.simple.value, 2.0, "ATR at index 2");
 
   samrena_destroy(arena);
   printf("  PASS\n");
@@ -1530,9 +1553,9 @@ static int test_atr_always_positive(void) {
   ASSERT(atr != NULL, "Failed to calculate ATR");
 
   for (size_t i = 4; i < 10; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(atr, i);
-    ASSERT(val != NULL && val->valid == true, "Should be valid");
-    ASSERT(val->data.simple.value > 0.0, "ATR should always be positive");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(atr, i, &val) && val.valid == true, "Should be valid");
+    ASSERT(val.data.simple.value > 0.0, "ATR should always be positive");
   }
 
   samrena_destroy(arena);
@@ -1608,8 +1631,9 @@ static int test_pivot_basic(void) {
   ASSERT(samtrader_indicator_series_size(pivot) == 5, "Should have 5 values");
 
   /* First value should be invalid (no previous bar) */
-  const SamtraderIndicatorValue *val = samtrader_indicator_series_at(pivot, 0);
-  ASSERT(val != NULL && val->valid == false, "Index 0 should be invalid");
+  SamtraderIndicatorValue val;
+  ASSERT(samtrader_indicator_series_at(pivot, 0, &val) && val.valid == false,
+         "Index 0 should be invalid");
 
   /* Index 1: from bar 0 (H=11, L=9, C=10)
    * pivot = (11+9+10)/3 = 10.0
@@ -1620,15 +1644,15 @@ static int test_pivot_basic(void) {
    * s2 = 10 - (11-9) = 8.0
    * s3 = 9 - 2*(11-10) = 7.0
    */
-  val = samtrader_indicator_series_at(pivot, 1);
-  ASSERT(val != NULL && val->valid == true, "Index 1 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.pivot.pivot, 10.0, "Pivot at index 1");
-  ASSERT_DOUBLE_EQ(val->data.pivot.r1, 11.0, "R1 at index 1");
-  ASSERT_DOUBLE_EQ(val->data.pivot.r2, 12.0, "R2 at index 1");
-  ASSERT_DOUBLE_EQ(val->data.pivot.r3, 13.0, "R3 at index 1");
-  ASSERT_DOUBLE_EQ(val->data.pivot.s1, 9.0, "S1 at index 1");
-  ASSERT_DOUBLE_EQ(val->data.pivot.s2, 8.0, "S2 at index 1");
-  ASSERT_DOUBLE_EQ(val->data.pivot.s3, 7.0, "S3 at index 1");
+  ASSERT(samtrader_indicator_series_at(pivot, 1, &val) && val.valid == true,
+         "Index 1 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.pivot.pivot, 10.0, "Pivot at index 1");
+  ASSERT_DOUBLE_EQ(val.data.pivot.r1, 11.0, "R1 at index 1");
+  ASSERT_DOUBLE_EQ(val.data.pivot.r2, 12.0, "R2 at index 1");
+  ASSERT_DOUBLE_EQ(val.data.pivot.r3, 13.0, "R3 at index 1");
+  ASSERT_DOUBLE_EQ(val.data.pivot.s1, 9.0, "S1 at index 1");
+  ASSERT_DOUBLE_EQ(val.data.pivot.s2, 8.0, "S2 at index 1");
+  ASSERT_DOUBLE_EQ(val.data.pivot.s3, 7.0, "S3 at index 1");
 
   /* Index 2: from bar 1 (H=13, L=11, C=12)
    * pivot = (13+11+12)/3 = 12.0
@@ -1639,15 +1663,15 @@ static int test_pivot_basic(void) {
    * s2 = 12 - (13-11) = 10.0
    * s3 = 11 - 2*(13-12) = 9.0
    */
-  val = samtrader_indicator_series_at(pivot, 2);
-  ASSERT(val != NULL && val->valid == true, "Index 2 should be valid");
-  ASSERT_DOUBLE_EQ(val->data.pivot.pivot, 12.0, "Pivot at index 2");
-  ASSERT_DOUBLE_EQ(val->data.pivot.r1, 13.0, "R1 at index 2");
-  ASSERT_DOUBLE_EQ(val->data.pivot.r2, 14.0, "R2 at index 2");
-  ASSERT_DOUBLE_EQ(val->data.pivot.r3, 15.0, "R3 at index 2");
-  ASSERT_DOUBLE_EQ(val->data.pivot.s1, 11.0, "S1 at index 2");
-  ASSERT_DOUBLE_EQ(val->data.pivot.s2, 10.0, "S2 at index 2");
-  ASSERT_DOUBLE_EQ(val->data.pivot.s3, 9.0, "S3 at index 2");
+  ASSERT(samtrader_indicator_series_at(pivot, 2, &val) && val.valid == true,
+         "Index 2 should be valid");
+  ASSERT_DOUBLE_EQ(val.data.pivot.pivot, 12.0, "Pivot at index 2");
+  ASSERT_DOUBLE_EQ(val.data.pivot.r1, 13.0, "R1 at index 2");
+  ASSERT_DOUBLE_EQ(val.data.pivot.r2, 14.0, "R2 at index 2");
+  ASSERT_DOUBLE_EQ(val.data.pivot.r3, 15.0, "R3 at index 2");
+  ASSERT_DOUBLE_EQ(val.data.pivot.s1, 11.0, "S1 at index 2");
+  ASSERT_DOUBLE_EQ(val.data.pivot.s2, 10.0, "S2 at index 2");
+  ASSERT_DOUBLE_EQ(val.data.pivot.s3, 9.0, "S3 at index 2");
 
   samrena_destroy(arena);
   printf("  PASS\n");
@@ -1668,14 +1692,14 @@ static int test_pivot_level_ordering(void) {
 
   /* For all valid values, S3 < S2 < S1 < Pivot < R1 < R2 < R3 */
   for (size_t i = 1; i < 8; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(pivot, i);
-    ASSERT(val != NULL && val->valid == true, "Should be valid");
-    ASSERT(val->data.pivot.s3 < val->data.pivot.s2, "S3 < S2");
-    ASSERT(val->data.pivot.s2 < val->data.pivot.s1, "S2 < S1");
-    ASSERT(val->data.pivot.s1 < val->data.pivot.pivot, "S1 < Pivot");
-    ASSERT(val->data.pivot.pivot < val->data.pivot.r1, "Pivot < R1");
-    ASSERT(val->data.pivot.r1 < val->data.pivot.r2, "R1 < R2");
-    ASSERT(val->data.pivot.r2 < val->data.pivot.r3, "R2 < R3");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(pivot, i, &val) && val.valid == true, "Should be valid");
+    ASSERT(val.data.pivot.s3 < val.data.pivot.s2, "S3 < S2");
+    ASSERT(val.data.pivot.s2 < val.data.pivot.s1, "S2 < S1");
+    ASSERT(val.data.pivot.s1 < val.data.pivot.pivot, "S1 < Pivot");
+    ASSERT(val.data.pivot.pivot < val.data.pivot.r1, "Pivot < R1");
+    ASSERT(val.data.pivot.r1 < val.data.pivot.r2, "R1 < R2");
+    ASSERT(val.data.pivot.r2 < val.data.pivot.r3, "R2 < R3");
   }
 
   samrena_destroy(arena);
@@ -1705,15 +1729,15 @@ static int test_pivot_constant_prices(void) {
   ASSERT(pivot != NULL, "Failed to calculate Pivot Points");
 
   for (size_t i = 1; i < 5; i++) {
-    const SamtraderIndicatorValue *val = samtrader_indicator_series_at(pivot, i);
-    ASSERT(val != NULL && val->valid == true, "Should be valid");
-    ASSERT_DOUBLE_EQ(val->data.pivot.pivot, 50.0, "Pivot should be 50");
-    ASSERT_DOUBLE_EQ(val->data.pivot.r1, 51.0, "R1 should be 51");
-    ASSERT_DOUBLE_EQ(val->data.pivot.r2, 52.0, "R2 should be 52");
-    ASSERT_DOUBLE_EQ(val->data.pivot.r3, 53.0, "R3 should be 53");
-    ASSERT_DOUBLE_EQ(val->data.pivot.s1, 49.0, "S1 should be 49");
-    ASSERT_DOUBLE_EQ(val->data.pivot.s2, 48.0, "S2 should be 48");
-    ASSERT_DOUBLE_EQ(val->data.pivot.s3, 47.0, "S3 should be 47");
+    SamtraderIndicatorValue val;
+    ASSERT(samtrader_indicator_series_at(pivot, i, &val) && val.valid == true, "Should be valid");
+    ASSERT_DOUBLE_EQ(val.data.pivot.pivot, 50.0, "Pivot should be 50");
+    ASSERT_DOUBLE_EQ(val.data.pivot.r1, 51.0, "R1 should be 51");
+    ASSERT_DOUBLE_EQ(val.data.pivot.r2, 52.0, "R2 should be 52");
+    ASSERT_DOUBLE_EQ(val.data.pivot.r3, 53.0, "R3 should be 53");
+    ASSERT_DOUBLE_EQ(val.data.pivot.s1, 49.0, "S1 should be 49");
+    ASSERT_DOUBLE_EQ(val.data.pivot.s2, 48.0, "S2 should be 48");
+    ASSERT_DOUBLE_EQ(val.data.pivot.s3, 47.0, "S3 should be 47");
   }
 
   samrena_destroy(arena);
@@ -1837,6 +1861,149 @@ static int test_indicator_calculate_dispatcher(void) {
   return 0;
 }
 
+/*============================================================================
+ * Columnar Calculation Tests
+ *============================================================================*/
+
+/* Compare two series value-by-value, requiring bit-identical results */
+static bool series_identical(const SamtraderIndicatorSeries *a, const SamtraderIndicatorSeries *b) {
+  if (!a || !b || samtrader_indicator_series_size(a) != samtrader_indicator_series_size(b)) {
+    return false;
+  }
+  for (size_t i = 0; i < samtrader_indicator_series_size(a); i++) {
+    SamtraderIndicatorValue va;
+    SamtraderIndicatorValue vb;
+    if (!samtrader_indicator_series_at(a, i, &va) || !samtrader_indicator_series_at(b, i, &vb)) {
+      return false;
+    }
+    if (va.date != vb.date || va.valid != vb.valid ||
+        memcmp(&va.data, &vb.data, sizeof(va.data)) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static int test_columns_match_vector(void) {
+  printf("Testing columnar calculations match vector calculations...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  double closes[60];
+  for (int i = 0; i < 60; i++) {
+    closes[i] = 100.0 + 8.0 * sin(i * 0.4) + (i % 7) * 0.3;
+  }
+  SamrenaVector *ohlcv = create_test_ohlcv(arena, closes, 60);
+  SamtraderBarColumns *bars = samtrader_bar_columns_from_ohlcv(arena, ohlcv);
+  ASSERT(bars != NULL, "Failed to build bar columns");
+
+  ASSERT(series_identical(samtrader_calculate_sma(arena, ohlcv, 10),
+                          samtrader_calculate_sma_columns(arena, bars, 10)),
+         "SMA columns mismatch");
+  ASSERT(series_identical(samtrader_calculate_ema(arena, ohlcv, 10),
+                          samtrader_calculate_ema_columns(arena, bars, 10)),
+         "EMA columns mismatch");
+  ASSERT(series_identical(samtrader_calculate_wma(arena, ohlcv, 10),
+                          samtrader_calculate_wma_columns(arena, bars, 10)),
+         "WMA columns mismatch");
+  ASSERT(series_identical(samtrader_calculate_rsi(arena, ohlcv, 14),
+                          samtrader_calculate_rsi_columns(arena, bars, 14)),
+         "RSI columns mismatch");
+  ASSERT(series_identical(samtrader_calculate_macd(arena, ohlcv, 12, 26, 9),
+                          samtrader_calculate_macd_columns(arena, bars, 12, 26, 9)),
+         "MACD columns mismatch");
+  ASSERT(series_identical(samtrader_calculate_stochastic(arena, ohlcv, 14, 3),
+                          samtrader_calculate_stochastic_columns(arena, bars, 14, 3)),
+         "Stochastic columns mismatch");
+  ASSERT(series_identical(samtrader_calculate_bollinger(arena, ohlcv, 20, 2.0),
+                          samtrader_calculate_bollinger_columns(arena, bars, 20, 2.0)),
+         "Bollinger columns mismatch");
+  ASSERT(series_identical(samtrader_calculate_atr(arena, ohlcv, 14),
+                          samtrader_calculate_atr_columns(arena, bars, 14)),
+         "ATR columns mismatch");
+  ASSERT(series_identical(samtrader_calculate_pivot(arena, ohlcv),
+                          samtrader_calculate_pivot_columns(arena, bars)),
+         "Pivot columns mismatch");
+  ASSERT(series_identical(samtrader_indicator_calculate(arena, SAMTRADER_IND_SMA, ohlcv, 5),
+                          samtrader_indicator_calculate_columns(arena, SAMTRADER_IND_SMA, bars, 5)),
+         "Columnar dispatcher mismatch");
+
+  ASSERT(samtrader_calculate_sma_columns(arena, NULL, 5) == NULL, "NULL columns should fail");
+  ASSERT(samtrader_indicator_calculate_columns(arena, SAMTRADER_IND_ROC, bars, 5) == NULL,
+         "Unsupported columnar type should return NULL");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+/*============================================================================
+ * Multi-Period Calculation Tests
+ *============================================================================*/
+
+static int test_multi_period_match_single(void) {
+  printf("Testing multi-period calculations match single-period calculations...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  double closes[300];
+  for (int i = 0; i < 300; i++) {
+    closes[i] = 100.0 + 15.0 * sin(i * 0.07) + 4.0 * sin(i * 0.9) + (i % 11) * 0.25;
+  }
+  SamrenaVector *ohlcv = create_test_ohlcv(arena, closes, 300);
+  SamtraderBarColumns *bars = samtrader_bar_columns_from_ohlcv(arena, ohlcv);
+  ASSERT(bars != NULL, "Failed to build bar columns");
+
+  /* Unsorted, repeated, period 1 and a period longer than the data */
+  int periods[] = {20, 5, 1, 200, 5, 63, 64, 65, 400};
+  size_t count = sizeof(periods) / sizeof(periods[0]);
+
+  SamtraderIndicatorSeries **sma = samtrader_calculate_sma_multi(arena, ohlcv, periods, count);
+  SamtraderIndicatorSeries **ema = samtrader_calculate_ema_multi_columns(arena, bars, periods,
+                                                                         count);
+  ASSERT(sma != NULL && ema != NULL, "Multi-period SMA/EMA should succeed");
+  for (size_t j = 0; j < count; j++) {
+    ASSERT(sma[j]->type == SAMTRADER_IND_SMA && sma[j]->params.period == periods[j],
+           "SMA lane parameters");
+    ASSERT(series_identical(sma[j], samtrader_calculate_sma_columns(arena, bars, periods[j])),
+           "SMA lane mismatch");
+    ASSERT(ema[j]->type == SAMTRADER_IND_EMA && ema[j]->params.period == periods[j],
+           "EMA lane parameters");
+    ASSERT(series_identical(ema[j], samtrader_calculate_ema_columns(arena, bars, periods[j])),
+           "EMA lane mismatch");
+  }
+
+  int k_periods[] = {14, 5, 1, 50, 14, 301};
+  int d_periods[] = {3, 3, 1, 10, 7, 3};
+  size_t pairs = sizeof(k_periods) / sizeof(k_periods[0]);
+  SamtraderIndicatorSeries **stoch =
+      samtrader_calculate_stochastic_multi(arena, ohlcv, k_periods, d_periods, pairs);
+  ASSERT(stoch != NULL, "Multi-period Stochastic should succeed");
+  for (size_t j = 0; j < pairs; j++) {
+    ASSERT(stoch[j]->params.period == k_periods[j] && stoch[j]->params.param2 == d_periods[j],
+           "Stochastic lane parameters");
+    ASSERT(series_identical(stoch[j], samtrader_calculate_stochastic_columns(
+                                          arena, bars, k_periods[j], d_periods[j])),
+           "Stochastic lane mismatch");
+  }
+
+  int bad[] = {10, 0};
+  ASSERT(samtrader_calculate_sma_multi(arena, ohlcv, bad, 2) == NULL,
+         "Period 0 should fail");
+  ASSERT(samtrader_calculate_ema_multi(arena, ohlcv, periods, 0) == NULL,
+         "Empty period list should fail");
+  ASSERT(samtrader_calculate_stochastic_multi(arena, ohlcv, k_periods, bad, 2) == NULL,
+         "%D period 0 should fail");
+  ASSERT(samtrader_calculate_sma_multi_columns(arena, NULL, periods, count) == NULL,
+         "NULL columns should fail");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
 /*============================================================================
  * Comparison Tests (SMA vs EMA vs WMA)
  *============================================================================*/
@@ -1858,19 +2025,21 @@ static int test_moving_averages_comparison(void) {
   ASSERT(sma != NULL && ema != NULL && wma != NULL, "All calculations should succeed");
 
   /* Check last value - with rising prices, EMA and WMA should lead SMA */
-  const SamtraderIndicatorValue *sma_val = samtrader_indicator_series_at(sma, 9);
-  const SamtraderIndicatorValue *ema_val = samtrader_indicator_series_at(ema, 9);
-  const SamtraderIndicatorValue *wma_val = samtrader_indicator_series_at(wma, 9);
-
-  ASSERT(sma_val && ema_val && wma_val, "All values should exist");
+  SamtraderIndicatorValue sma_val;
+  SamtraderIndicatorValue ema_val;
+  SamtraderIndicatorValue wma_val;
+  ASSERT(samtrader_indicator_series_at(sma, 9, &sma_val) &&
+             samtrader_indicator_series_at(ema, 9, &ema_val) &&
+             samtrader_indicator_series_at(wma, 9, &wma_val),
+         "All values should exist");
 
   /* SMA(5) at last: (6+7+8+9+10)/5 = 8.0 */
-  ASSERT_DOUBLE_EQ(sma_val->data.simple.value, 8.0, "SMA at last index");
+  ASSERT_DOUBLE_EQ(sma_val.data.simple.value, 8.0, "SMA at last index");
 
   /* EMA and WMA should be >= SMA for rising prices */
-  ASSERT(ema_val->data.simple.value >= sma_val->data.simple.value - 0.0001,
+  ASSERT(ema_val.data.simple.value >= sma_val.data.simple.value - 0.0001,
          "EMA should be >= SMA for rising prices");
-  ASSERT(wma_val->data.simple.value >= sma_val->data.simple.value - 0.0001,
+  ASSERT(wma_val.data.simple.value >= sma_val.data.simple.value - 0.0001,
          "WMA should be >= SMA for rising prices");
 
   samrena_destroy(arena);
@@ -1958,6 +2127,12 @@ int main(void) {
   /* Dispatcher test */
   failures += test_indicator_calculate_dispatcher();
 
+  /* Columnar calculation test */
+  failures += test_columns_match_vector();
+
+  /* Multi-period calculation test */
+  failures += test_multi_period_match_single();
+
   /* Comparison test */
   failures += test_moving_averages_comparison();
 
@@ -0,0 +1,290 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "samtrader/domain/indicator.h"
+#include "samtrader/domain/indicator_state.h"
+#include "samtrader/domain/ohlcv.h"
+
+#define ASSERT(cond, msg)                                                                          \
+  do {                                                                                             \
+    if (!(cond)) {                                                                                 \
+      printf("FAIL: %s\n", msg);                                                                   \
+      return 1;                                                                                    \
+    }                                                                                              \
+  } while (0)
+
+#define ASSERT_DOUBLE_EQ(a, b, msg)                                                                \
+  do {                                                                                             \
+    if (fabs((a) - (b)) > 0.0001) {                                                                \
+      printf("FAIL: %s (expected %f, got %f)\n", msg, (b), (a));                                   \
+      return 1;                                                                                    \
+    }                                                                                              \
+  } while (0)
+
+#define BAR_COUNT 400
+
+/* Deterministic random walk with flat bars mixed in (zero high-low range) */
+static SamrenaVector *create_walk_ohlcv(Samrena *arena, size_t count) {
+  SamrenaVector *vec = samtrader_ohlcv_vector_create(arena, count);
+  if (!vec) {
+    return NULL;
+  }
+
+  unsigned int seed = 12345;
+  double price = 100.0;
+  for (size_t i = 0; i < count; i++) {
+    seed = seed * 1103515245u + 12345u;
+    double step = (double)((seed >> 8) % 2001) / 1000.0 - 1.0;
+    price *= 1.0 + step * 0.02;
+    double high = price * (1.0 + (double)((seed >> 3) % 100) / 5000.0);
+    double low = price * (1.0 - (double)((seed >> 5) % 100) / 5000.0);
+    if (i % 37 == 0) {
+      high = low = price;
+    }
+    SamtraderOhlcv bar = {.code = "TEST",
+                          .exchange = "US",
+                          .date = (time_t)(1704067200 + i * 86400),
+                          .open = price,
+                          .high = high,
+                          .low = low,
+                          .close = price,
+                          .volume = 1000000};
+    samrena_vector_push(vec, &bar);
+  }
+  return vec;
+}
+
+/* Push every bar through a fresh state and compare bitwise with the batch series */
+static int stream_matches_series(Samrena *arena, SamrenaVector *ohlcv,
+                                 const SamtraderIndicatorSeries *series) {
+  SamtraderIndicatorState *state =
+      samtrader_indicator_state_create(arena, series->type, &series->params);
+  if (!state) {
+    return 0;
+  }
+  for (size_t i = 0; i < samrena_vector_size(ohlcv); i++) {
+    const SamtraderOhlcv *bar = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i);
+    SamtraderIndicatorValue value = samtrader_indicator_state_push(state, bar);
+    SamtraderIndicatorValue expected;
+    if (!samtrader_indicator_series_at(series, i, &expected)) {
+      return 0;
+    }
+    if (value.valid != expected.valid || value.date != expected.date ||
+        value.type != expected.type ||
+        memcmp(&value.data, &expected.data, sizeof(value.data)) != 0) {
+      printf("  mismatch at bar %zu\n", i);
+      return 0;
+    }
+  }
+  return samtrader_indicator_state_count(state) == samrena_vector_size(ohlcv);
+}
+
+/*============================================================================
+ * Streaming vs Batch Tests
+ *============================================================================*/
+
+static int test_stream_matches_batch(void) {
+  printf("Testing streaming state matches batch series...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  SamrenaVector *ohlcv = create_walk_ohlcv(arena, BAR_COUNT);
+  ASSERT(ohlcv != NULL, "Failed to create OHLCV data");
+
+  int periods[] = {1, 2, 14, 50};
+  for (size_t p = 0; p < sizeof(periods) / sizeof(periods[0]); p++) {
+    int n = periods[p];
+    ASSERT(stream_matches_series(arena, ohlcv, samtrader_calculate_sma(arena, ohlcv, n)), "SMA");
+    ASSERT(stream_matches_series(arena, ohlcv, samtrader_calculate_ema(arena, ohlcv, n)), "EMA");
+    ASSERT(stream_matches_series(arena, ohlcv, samtrader_calculate_wma(arena, ohlcv, n)), "WMA");
+    ASSERT(stream_matches_series(arena, ohlcv, samtrader_calculate_rsi(arena, ohlcv, n)), "RSI");
+    ASSERT(stream_matches_series(arena, ohlcv, samtrader_calculate_atr(arena, ohlcv, n)), "ATR");
+    ASSERT(stream_matches_series(arena, ohlcv, samtrader_calculate_bollinger(arena, ohlcv, n, 2.0)),
+           "Bollinger");
+    ASSERT(stream_matches_series(arena, ohlcv, samtrader_calculate_stochastic(arena, ohlcv, n, 3)),
+           "Stochastic");
+    ASSERT(stream_matches_series(arena, ohlcv, samtrader_calculate_macd(arena, ohlcv, n, 26, 9)),
+           "MACD");
+  }
+  ASSERT(stream_matches_series(arena, ohlcv, samtrader_calculate_pivot(arena, ohlcv)), "Pivot");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_wma_running_numerator(void) {
+  printf("Testing WMA running numerator against direct weighting...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  SamrenaVector *ohlcv = create_walk_ohlcv(arena, BAR_COUNT);
+  ASSERT(ohlcv != NULL, "Failed to create OHLCV data");
+
+  int period = 10;
+  SamtraderIndicatorSeries *wma = samtrader_calculate_wma(arena, ohlcv, period);
+  ASSERT(wma != NULL, "Failed to calculate WMA");
+
+  double weight_sum = (double)period * ((double)period + 1.0) / 2.0;
+  for (size_t i = (size_t)(period - 1); i < BAR_COUNT; i++) {
+    double weighted = 0.0;
+    for (int j = 0; j < period; j++) {
+      const SamtraderOhlcv *bar =
+          (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i - (size_t)(period - 1 - j));
+      weighted += bar->close * (double)(j + 1);
+    }
+    SamtraderIndicatorValue v;
+    ASSERT(samtrader_indicator_series_at(wma, i, &v) && v.valid,
+           "WMA should be valid after warmup");
+    ASSERT_DOUBLE_EQ(v.data.simple.value, weighted / weight_sum, "WMA value");
+  }
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_stochastic_window_extremes(void) {
+  printf("Testing stochastic sliding high/low against window scan...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  SamrenaVector *ohlcv = create_walk_ohlcv(arena, BAR_COUNT);
+  ASSERT(ohlcv != NULL, "Failed to create OHLCV data");
+
+  int k_period = 9;
+  SamtraderIndicatorParams params = {.period = k_period, .param2 = 1};
+  SamtraderIndicatorState *state =
+      samtrader_indicator_state_create(arena, SAMTRADER_IND_STOCHASTIC, &params);
+  ASSERT(state != NULL, "Failed to create state");
+
+  for (size_t i = 0; i < BAR_COUNT; i++) {
+    const SamtraderOhlcv *bar = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i);
+    SamtraderIndicatorValue v = samtrader_indicator_state_push(state, bar);
+    if (i < (size_t)(k_period - 1)) {
+      ASSERT(!v.valid, "Stochastic should be invalid during warmup");
+      continue;
+    }
+    double hh = bar->high;
+    double ll = bar->low;
+    for (size_t j = i + 1 - (size_t)k_period; j < i; j++) {
+      const SamtraderOhlcv *w = (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, j);
+      hh = w->high > hh ? w->high : hh;
+      ll = w->low < ll ? w->low : ll;
+    }
+    double expected = hh == ll ? 50.0 : 100.0 * (bar->close - ll) / (hh - ll);
+    ASSERT(v.valid, "Stochastic should be valid after warmup");
+    ASSERT_DOUBLE_EQ(v.data.stochastic.k, expected, "%K value");
+  }
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+/*============================================================================
+ * State Lifecycle Tests
+ *============================================================================*/
+
+static int test_state_reset(void) {
+  printf("Testing streaming state reset...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  SamrenaVector *ohlcv = create_walk_ohlcv(arena, 60);
+  ASSERT(ohlcv != NULL, "Failed to create OHLCV data");
+
+  SamtraderIndicatorParams params = {.period = 12, .param2 = 26, .param3 = 9};
+  SamtraderIndicatorState *state =
+      samtrader_indicator_state_create(arena, SAMTRADER_IND_MACD, &params);
+  ASSERT(state != NULL, "Failed to create state");
+
+  SamtraderIndicatorValue first[60];
+  for (size_t i = 0; i < 60; i++) {
+    first[i] = samtrader_indicator_state_push(
+        state, (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i));
+  }
+  ASSERT(samtrader_indicator_state_count(state) == 60, "Count should be 60");
+
+  samtrader_indicator_state_reset(state);
+  ASSERT(samtrader_indicator_state_count(state) == 0, "Count should be 0 after reset");
+  for (size_t i = 0; i < 60; i++) {
+    SamtraderIndicatorValue v = samtrader_indicator_state_push(
+        state, (const SamtraderOhlcv *)samrena_vector_at_const(ohlcv, i));
+    ASSERT(v.valid == first[i].valid &&
+               memcmp(&v.data, &first[i].data, sizeof(v.data)) == 0,
+           "Replay after reset should match");
+  }
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_state_invalid_params(void) {
+  printf("Testing streaming state invalid parameters...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  SamtraderIndicatorParams zero = {0};
+  SamtraderIndicatorParams sma = {.period = 5};
+  ASSERT(samtrader_indicator_state_create(NULL, SAMTRADER_IND_SMA, &sma) == NULL, "NULL arena");
+  ASSERT(samtrader_indicator_state_create(arena, SAMTRADER_IND_SMA, NULL) == NULL, "NULL params");
+  ASSERT(samtrader_indicator_state_create(arena, SAMTRADER_IND_SMA, &zero) == NULL,
+         "Zero period");
+  ASSERT(samtrader_indicator_state_create(arena, SAMTRADER_IND_MACD, &sma) == NULL,
+         "MACD needs slow and signal periods");
+  ASSERT(samtrader_indicator_state_create(arena, SAMTRADER_IND_STOCHASTIC, &sma) == NULL,
+         "Stochastic needs a %D period");
+  ASSERT(samtrader_indicator_state_create(arena, SAMTRADER_IND_OBV, &sma) == NULL,
+         "Unsupported type");
+  ASSERT(samtrader_indicator_state_create(arena, SAMTRADER_IND_PIVOT, &zero) != NULL,
+         "Pivot has no parameters");
+
+  SamtraderIndicatorValue v = samtrader_indicator_state_push(NULL, NULL);
+  ASSERT(!v.valid, "Push to NULL state is invalid");
+  ASSERT(samtrader_indicator_state_count(NULL) == 0, "NULL state count is 0");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void) {
+  printf("=== Streaming Indicator State Tests ===\n\n");
+
+  int failures = 0;
+
+  failures += test_stream_matches_batch();
+  failures += test_wma_running_numerator();
+  failures += test_stochastic_window_extremes();
+  failures += test_state_reset();
+  failures += test_state_invalid_params();
+
+  printf("\n=== Results: %d failures ===\n", failures);
+
+  return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
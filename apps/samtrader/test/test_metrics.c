@@ -17,6 +17,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "samtrader/domain/metrics.h"
 #include "samtrader/domain/portfolio.h"
@@ -577,6 +578,82 @@ static int test_print_null(void) {
   return 0;
 }
 
+/* ========== Streaming Accumulator Tests ========== */
+
+static int test_accumulator_matches_calculate(void) {
+  printf("Testing accumulator matches batch calculation...\n");
+  Samrena *arena = samrena_create_default();
+  SamrenaVector *trades = samrena_vector_init(arena, sizeof(SamtraderClosedTrade), 8);
+  SamrenaVector *equity = samrena_vector_init(arena, sizeof(SamtraderEquityPoint), 16);
+
+  /* Drawdowns that recover and one that never does, with trades of both signs */
+  double equities[] = {100.0, 104.0, 101.0, 97.0, 106.0, 111.0, 108.0, 112.0, 103.0, 99.0};
+  double pnls[] = {4.0, -3.0, 9.0, -0.5, -8.0};
+  for (int i = 0; i < 10; i++) {
+    SamtraderEquityPoint pt = {.date = day_time(i), .equity = equities[i]};
+    samrena_vector_push(equity, &pt);
+  }
+  for (int i = 0; i < 5; i++) {
+    SamtraderClosedTrade t = {.code = "AAA",
+                              .exchange = "US",
+                              .quantity = 10,
+                              .entry_date = day_time(2 * i),
+                              .exit_date = day_time(2 * i + 1 + i % 2),
+                              .pnl = pnls[i]};
+    samrena_vector_push(trades, &t);
+  }
+
+  SamtraderMetrics *expected = samtrader_metrics_calculate(arena, trades, equity, 0.03);
+
+  /* Feed trades as they would close, between equity points */
+  SamtraderMetricsAccumulator acc;
+  time_t dates[10];
+  for (int i = 0; i < 10; i++)
+    dates[i] = day_time(i);
+  samtrader_metrics_accumulator_init(&acc, samtrader_metrics_bars_per_year_of_dates(dates, 10),
+                                     0.03);
+  for (int i = 0; i < 10; i++) {
+    if (i % 2 == 1) {
+      samtrader_metrics_accumulator_add_trade(
+          &acc, (const SamtraderClosedTrade *)samrena_vector_at_const(trades, (size_t)i / 2));
+    }
+    samtrader_metrics_accumulator_add_equity(&acc, equities[i]);
+  }
+  SamtraderMetrics streamed;
+  samtrader_metrics_accumulator_finish(&acc, &streamed);
+
+  ASSERT(memcmp(expected, &streamed, sizeof(streamed)) == 0, "Streamed metrics match exactly");
+  ASSERT(streamed.max_drawdown_duration > 0.0, "Unrecovered drawdown counted");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_bars_per_year_of_dates(void) {
+  printf("Testing bars per year from dates...\n");
+  Samrena *arena = samrena_create_default();
+  SamrenaVector *equity = samrena_vector_init(arena, sizeof(SamtraderEquityPoint), 32);
+
+  /* Three days of seven hourly bars */
+  time_t dates[21];
+  for (int i = 0; i < 21; i++) {
+    dates[i] = day_time(i / 7) + 14 * 3600 + (i % 7) * 3600;
+    SamtraderEquityPoint pt = {.date = dates[i], .equity = 100.0};
+    samrena_vector_push(equity, &pt);
+  }
+
+  ASSERT_DOUBLE_EQ(samtrader_metrics_bars_per_year_of_dates(dates, 21), 252.0 * 7.0,
+                   "Hourly bars annualise by 7 bars a day");
+  ASSERT_DOUBLE_EQ(samtrader_metrics_bars_per_year_of_dates(dates, 21),
+                   samtrader_metrics_bars_per_year(equity), "Dates and curve agree");
+  ASSERT_DOUBLE_EQ(samtrader_metrics_bars_per_year_of_dates(NULL, 0), 252.0, "Empty is daily");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
 int main(void) {
   printf("=== Metrics Tests ===\n\n");
 
@@ -617,6 +694,10 @@ int main(void) {
   failures += test_flat_equity_curve();
   failures += test_print_null();
 
+  /* Streaming accumulator */
+  failures += test_accumulator_matches_calculate();
+  failures += test_bars_per_year_of_dates();
+
   printf("\n=== Results: %d failures ===\n", failures);
 
   return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
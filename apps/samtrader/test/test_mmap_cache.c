@@ -0,0 +1,366 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <samrena.h>
+#include <samvector.h>
+
+#include "samtrader/adapters/mmap_cache_adapter.h"
+#include "samtrader/domain/ohlcv.h"
+#include "samtrader/ports/data_port.h"
+
+#define ASSERT(cond, msg)                                                                          \
+  do {                                                                                             \
+    if (!(cond)) {                                                                                 \
+      printf("FAIL: %s\n", msg);                                                                   \
+      return 1;                                                                                    \
+    }                                                                                              \
+  } while (0)
+
+/* Base epoch for test dates: 2024-01-01 00:00:00 UTC */
+#define BASE_DATE 1704067200
+#define DAY_SECONDS 86400
+
+/* =========================== Mock Data Port =========================== */
+
+/* Serves bar_count daily bars per code, starting at BASE_DATE, ignoring the date range */
+typedef struct {
+  const char **codes;
+  size_t *bar_counts;
+  size_t num_codes;
+} MockDataPortImpl;
+
+static SamrenaVector *mock_fetch_ohlcv(SamtraderDataPort *port, const char *code,
+                                       const char *exchange, time_t start_date, time_t end_date) {
+  (void)start_date;
+  (void)end_date;
+  MockDataPortImpl *impl = (MockDataPortImpl *)port->impl;
+
+  for (size_t i = 0; i < impl->num_codes; i++) {
+    if (strcmp(impl->codes[i], code) != 0)
+      continue;
+    SamrenaVector *vec = samtrader_ohlcv_vector_create(port->arena, impl->bar_counts[i]);
+    if (!vec)
+      return NULL;
+    for (size_t j = 0; j < impl->bar_counts[i]; j++) {
+      SamtraderOhlcv bar = {.code = code,
+                            .exchange = exchange,
+                            .date = BASE_DATE + (time_t)(j * DAY_SECONDS),
+                            .open = 100.0 + (double)j,
+                            .high = 105.0 + (double)j,
+                            .low = 95.0 + (double)j,
+                            .close = 102.0 + (double)j,
+                            .volume = 10000 + (int64_t)j * 100};
+      samrena_vector_push(vec, &bar);
+    }
+    return vec;
+  }
+  return NULL;
+}
+
+static void mock_close(SamtraderDataPort *port) { (void)port; }
+
+static SamtraderDataPort *create_mock_port(Samrena *arena, const char **codes, size_t *bar_counts,
+                                           size_t num_codes) {
+  SamtraderDataPort *port = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderDataPort);
+  MockDataPortImpl *impl = SAMRENA_PUSH_TYPE_ZERO(arena, MockDataPortImpl);
+  impl->codes = codes;
+  impl->bar_counts = bar_counts;
+  impl->num_codes = num_codes;
+  port->impl = impl;
+  port->arena = arena;
+  port->fetch_ohlcv = mock_fetch_ohlcv;
+  port->close = mock_close;
+  return port;
+}
+
+static void cache_path(char *buf, size_t size, const char *name) {
+  snprintf(buf, size, "/tmp/test_mmap_cache_%s_%d.bin", name, getpid());
+}
+
+/* Build a cache of CBA (5 bars), BHP (40 bars) and an empty WBC on AU */
+static int build_test_cache(Samrena *arena, const char *path) {
+  static const char *codes[] = {"CBA", "BHP", "WBC"};
+  static size_t bars[] = {5, 40, 0};
+  SamtraderDataPort *source = create_mock_port(arena, codes, bars, 3);
+  return samtrader_mmap_cache_build(path, source, codes, 3, "AU", 0, BASE_DATE + 100 * DAY_SECONDS);
+}
+
+/* =========================== Tests =========================== */
+
+static int test_build_and_fetch(void) {
+  printf("Testing cache build and fetch round trip...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  char path[128];
+  cache_path(path, sizeof(path), "roundtrip");
+  ASSERT(build_test_cache(arena, path) == 0, "Cache build should succeed");
+
+  SamtraderDataPort *port = samtrader_mmap_cache_adapter_create(arena, path);
+  ASSERT(port != NULL, "Failed to open cache");
+  ASSERT(port->fetch_ohlcv_batch != NULL, "Cache should support batch fetch");
+
+  SamrenaVector *bhp = port->fetch_ohlcv(port, "BHP", "AU", 0, BASE_DATE + 100 * DAY_SECONDS);
+  ASSERT(bhp != NULL, "BHP fetch should succeed");
+  ASSERT(samrena_vector_size(bhp) == 40, "BHP should have 40 bars");
+  const SamtraderOhlcv *bar = (const SamtraderOhlcv *)samrena_vector_at_const(bhp, 7);
+  ASSERT(bar->date == BASE_DATE + 7 * DAY_SECONDS, "Bar 7 date mismatch");
+  ASSERT(bar->open == 107.0 && bar->high == 112.0, "Bar 7 open/high mismatch");
+  ASSERT(bar->low == 102.0 && bar->close == 109.0, "Bar 7 low/close mismatch");
+  ASSERT(bar->volume == 10700, "Bar 7 volume mismatch");
+
+  SamrenaVector *wbc = port->fetch_ohlcv(port, "WBC", "AU", 0, BASE_DATE + 100 * DAY_SECONDS);
+  ASSERT(wbc != NULL && samrena_vector_size(wbc) == 0, "WBC should be cached with no bars");
+
+  port->close(port);
+
+  /* Fetched bars, names included, outlive the mapping */
+  ASSERT(strcmp(bar->code, "BHP") == 0, "Bar code should survive close");
+  ASSERT(strcmp(bar->exchange, "AU") == 0, "Bar exchange should survive close");
+
+  unlink(path);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_fetch_date_range(void) {
+  printf("Testing cache fetch date range bounds...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  char path[128];
+  cache_path(path, sizeof(path), "range");
+  ASSERT(build_test_cache(arena, path) == 0, "Cache build should succeed");
+  SamtraderDataPort *port = samtrader_mmap_cache_adapter_create(arena, path);
+  ASSERT(port != NULL, "Failed to open cache");
+
+  /* Both ends inclusive */
+  SamrenaVector *mid = port->fetch_ohlcv(port, "BHP", "AU", BASE_DATE + 10 * DAY_SECONDS,
+                                         BASE_DATE + 19 * DAY_SECONDS);
+  ASSERT(mid != NULL && samrena_vector_size(mid) == 10, "Expected bars 10..19");
+  const SamtraderOhlcv *first = (const SamtraderOhlcv *)samrena_vector_at_const(mid, 0);
+  ASSERT(first->date == BASE_DATE + 10 * DAY_SECONDS, "First bar should be day 10");
+
+  /* Range between bars and past the end */
+  SamrenaVector *between = port->fetch_ohlcv(port, "BHP", "AU", BASE_DATE + DAY_SECONDS / 2,
+                                             BASE_DATE + DAY_SECONDS / 2 + 1);
+  ASSERT(between != NULL && samrena_vector_size(between) == 0, "No bar between days");
+  SamrenaVector *after = port->fetch_ohlcv(port, "CBA", "AU", BASE_DATE + 50 * DAY_SECONDS,
+                                           BASE_DATE + 60 * DAY_SECONDS);
+  ASSERT(after != NULL && samrena_vector_size(after) == 0, "No bar after the last");
+
+  /* Unknown symbol or exchange yields no rows, as with the database */
+  SamrenaVector *unknown = port->fetch_ohlcv(port, "NAB", "AU", 0, BASE_DATE + DAY_SECONDS);
+  ASSERT(unknown != NULL && samrena_vector_size(unknown) == 0, "Unknown code has no bars");
+  SamrenaVector *other = port->fetch_ohlcv(port, "BHP", "US", 0, BASE_DATE + DAY_SECONDS);
+  ASSERT(other != NULL && samrena_vector_size(other) == 0, "Other exchange has no bars");
+
+  port->close(port);
+  unlink(path);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_view_zero_copy(void) {
+  printf("Testing cache zero-copy view...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  char path[128];
+  cache_path(path, sizeof(path), "view");
+  ASSERT(build_test_cache(arena, path) == 0, "Cache build should succeed");
+  SamtraderDataPort *port = samtrader_mmap_cache_adapter_create(arena, path);
+  ASSERT(port != NULL, "Failed to open cache");
+
+  SamtraderBarColumns view;
+  ASSERT(samtrader_mmap_cache_view(port, "CBA", "AU", BASE_DATE + DAY_SECONDS,
+                                   BASE_DATE + 3 * DAY_SECONDS, &view) == 0,
+         "View should succeed");
+  ASSERT(view.count == 3, "Expected 3 bars in view");
+  ASSERT(strcmp(view.code, "CBA") == 0, "View code mismatch");
+  ASSERT(view.date[0] == BASE_DATE + DAY_SECONDS, "View first date mismatch");
+  ASSERT(view.close[2] == 105.0, "View close mismatch");
+  ASSERT(view.volume[1] == 10200, "View volume mismatch");
+
+  /* fetch_bars lends the same mapped columns */
+  SamtraderBarColumns lent;
+  ASSERT(port->fetch_bars != NULL, "Cache should support borrowed bars");
+  ASSERT(port->fetch_bars(port, "CBA", "AU", BASE_DATE + DAY_SECONDS, BASE_DATE + 3 * DAY_SECONDS,
+                          &lent) == 0,
+         "fetch_bars should succeed");
+  ASSERT(lent.count == 3 && lent.close == view.close, "fetch_bars should not copy");
+
+  ASSERT(samtrader_mmap_cache_view(port, "NAB", "AU", 0, BASE_DATE, &view) == -1,
+         "View of unknown code should fail");
+
+  /* Views are only for cache ports */
+  const char *codes[] = {"CBA"};
+  size_t bars[] = {5};
+  SamtraderDataPort *mock = create_mock_port(arena, codes, bars, 1);
+  ASSERT(samtrader_mmap_cache_view(mock, "CBA", "AU", 0, BASE_DATE, &view) == -1,
+         "View of non-cache port should fail");
+
+  port->close(port);
+  unlink(path);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_fetch_summary(void) {
+  printf("Testing cache fetch summary...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  char path[128];
+  cache_path(path, sizeof(path), "summary");
+  ASSERT(build_test_cache(arena, path) == 0, "Cache build should succeed");
+  SamtraderDataPort *port = samtrader_mmap_cache_adapter_create(arena, path);
+  ASSERT(port != NULL && port->fetch_summary != NULL, "Cache should support summaries");
+
+  SamtraderOhlcvSummary summary;
+  ASSERT(port->fetch_summary(port, "BHP", "AU", BASE_DATE + 5 * DAY_SECONDS,
+                             BASE_DATE + 100 * DAY_SECONDS, &summary) == 0,
+         "Summary should succeed");
+  ASSERT(summary.bar_count == 35, "Expected bars 5..39");
+  ASSERT(summary.first_date == BASE_DATE + 5 * DAY_SECONDS, "First date mismatch");
+  ASSERT(summary.last_date == BASE_DATE + 39 * DAY_SECONDS, "Last date mismatch");
+  ASSERT(summary.first_close == 107.0 && summary.last_close == 141.0, "Close mismatch");
+
+  ASSERT(port->fetch_summary(port, "NAB", "AU", 0, BASE_DATE, &summary) == 0,
+         "Unknown code summary should succeed");
+  ASSERT(summary.bar_count == 0, "Unknown code has no bars");
+
+  port->close(port);
+  unlink(path);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_list_symbols(void) {
+  printf("Testing cache list symbols...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  char path[128];
+  cache_path(path, sizeof(path), "list");
+  ASSERT(build_test_cache(arena, path) == 0, "Cache build should succeed");
+  SamtraderDataPort *port = samtrader_mmap_cache_adapter_create(arena, path);
+  ASSERT(port != NULL, "Failed to open cache");
+
+  SamrenaVector *symbols = port->list_symbols(port, "AU");
+  ASSERT(symbols != NULL && samrena_vector_size(symbols) == 3, "Expected 3 AU symbols");
+  const char *const *first = (const char *const *)samrena_vector_at_const(symbols, 0);
+  ASSERT(strcmp(*first, "BHP") == 0, "Symbols should be sorted");
+
+  SamrenaVector *none = port->list_symbols(port, "US");
+  ASSERT(none != NULL && samrena_vector_size(none) == 0, "Expected no US symbols");
+
+  port->close(port);
+  unlink(path);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_build_rejects_invalid(void) {
+  printf("Testing cache build rejects invalid input...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  char path[128];
+  cache_path(path, sizeof(path), "invalid");
+
+  const char *codes[] = {"CBA", "CBA"};
+  size_t bars[] = {5, 5};
+  SamtraderDataPort *source = create_mock_port(arena, codes, bars, 2);
+  ASSERT(samtrader_mmap_cache_build(path, source, codes, 2, "AU", 0, BASE_DATE) == -1,
+         "Duplicate codes should be rejected");
+  ASSERT(access(path, F_OK) != 0, "No file should be written on failure");
+
+  const char *long_codes[] = {"THIS_CODE_IS_FAR_TOO_LONG_TO_FIT"};
+  ASSERT(samtrader_mmap_cache_build(path, source, long_codes, 1, "AU", 0, BASE_DATE) == -1,
+         "Overlong code should be rejected");
+  ASSERT(samtrader_mmap_cache_build(NULL, source, codes, 1, "AU", 0, BASE_DATE) == -1,
+         "NULL path should be rejected");
+  ASSERT(samtrader_mmap_cache_build(path, source, codes, 0, "AU", 0, BASE_DATE) == -1,
+         "Empty code list should be rejected");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_open_rejects_invalid(void) {
+  printf("Testing cache open rejects invalid files...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  char path[128];
+  cache_path(path, sizeof(path), "corrupt");
+
+  ASSERT(samtrader_mmap_cache_adapter_create(arena, path) == NULL, "Missing file should fail");
+
+  FILE *fp = fopen(path, "wb");
+  ASSERT(fp != NULL, "Failed to create file");
+  char junk[256];
+  memset(junk, 'x', sizeof(junk));
+  fwrite(junk, 1, sizeof(junk), fp);
+  fclose(fp);
+  ASSERT(samtrader_mmap_cache_adapter_create(arena, path) == NULL, "Bad magic should fail");
+
+  /* A valid cache cut short fails the size check */
+  ASSERT(build_test_cache(arena, path) == 0, "Cache build should succeed");
+  ASSERT(truncate(path, 200) == 0, "Failed to truncate cache");
+  ASSERT(samtrader_mmap_cache_adapter_create(arena, path) == NULL, "Truncated file should fail");
+
+  ASSERT(samtrader_mmap_cache_adapter_create(NULL, path) == NULL, "NULL arena should fail");
+
+  unlink(path);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+/* =========================== Main =========================== */
+
+int main(void) {
+  printf("=== Memory-Mapped Cache Tests ===\n\n");
+
+  int failures = 0;
+
+  failures += test_build_and_fetch();
+  failures += test_fetch_date_range();
+  failures += test_view_zero_copy();
+  failures += test_fetch_summary();
+  failures += test_list_symbols();
+  failures += test_build_rejects_invalid();
+  failures += test_open_rejects_invalid();
+
+  printf("\n=== Results: %d failures ===\n", failures);
+
+  return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
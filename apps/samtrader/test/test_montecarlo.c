@@ -0,0 +1,274 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <samrena.h>
+#include <samvector.h>
+
+#include "samtrader/domain/montecarlo.h"
+#include "samtrader/domain/portfolio.h"
+#include "samtrader/domain/worker_pool.h"
+
+#define ASSERT(cond, msg)                                                                          \
+  do {                                                                                             \
+    if (!(cond)) {                                                                                 \
+      printf("FAIL: %s\n", msg);                                                                   \
+      return 1;                                                                                    \
+    }                                                                                              \
+  } while (0)
+
+#define ASSERT_DOUBLE_EQ(a, b, tol, msg) ASSERT(fabs((a) - (b)) < (tol), msg)
+
+#define BASE_DATE 1704067200
+#define DAY_SECONDS 86400
+#define INITIAL_EQUITY 10000.0
+
+/*============================================================================
+ * Test Helpers
+ *============================================================================*/
+
+/** Daily equity curve compounding the given per-bar returns, cycled over bars points. */
+static SamrenaVector *make_curve(Samrena *arena, const double *returns, size_t return_count,
+                                 size_t bars) {
+  SamrenaVector *curve = samrena_vector_init(arena, sizeof(SamtraderEquityPoint), bars);
+  double equity = INITIAL_EQUITY;
+  for (size_t i = 0; i < bars; i++) {
+    if (i > 0)
+      equity *= 1.0 + returns[(i - 1) % return_count];
+    SamtraderEquityPoint pt = {.date = BASE_DATE + (time_t)(i * DAY_SECONDS), .equity = equity};
+    samrena_vector_push(curve, &pt);
+  }
+  return curve;
+}
+
+/** Closed trades with the given PnLs, cycled over count trades. */
+static SamrenaVector *make_trades(Samrena *arena, const double *pnls, size_t pnl_count,
+                                  size_t count) {
+  SamrenaVector *trades = samrena_vector_init(arena, sizeof(SamtraderClosedTrade), count);
+  for (size_t i = 0; i < count; i++) {
+    SamtraderClosedTrade t = {.code = "AAA",
+                              .exchange = "US",
+                              .quantity = 10,
+                              .entry_price = 100.0,
+                              .exit_price = 100.0,
+                              .entry_date = BASE_DATE,
+                              .exit_date = BASE_DATE + DAY_SECONDS,
+                              .pnl = pnls[i % pnl_count]};
+    samrena_vector_push(trades, &t);
+  }
+  return trades;
+}
+
+static int is_ascending(const double *values) {
+  for (size_t i = 1; i < SAMTRADER_MONTECARLO_LEVELS; i++) {
+    if (values[i] < values[i - 1])
+      return 0;
+  }
+  return 1;
+}
+
+/*============================================================================
+ * Tests
+ *============================================================================*/
+
+static int test_method_parse(void) {
+  printf("Testing samtrader_montecarlo_method_parse...\n");
+
+  SamtraderMonteCarloMethod method = SAMTRADER_MONTECARLO_TRADES;
+  ASSERT(samtrader_montecarlo_method_parse("returns", &method), "returns parses");
+  ASSERT(method == SAMTRADER_MONTECARLO_RETURNS, "returns method");
+  ASSERT(samtrader_montecarlo_method_parse("trades", &method), "trades parses");
+  ASSERT(method == SAMTRADER_MONTECARLO_TRADES, "trades method");
+  ASSERT(!samtrader_montecarlo_method_parse("blocks", &method), "unknown name rejected");
+  ASSERT(!samtrader_montecarlo_method_parse(NULL, &method), "NULL name rejected");
+  ASSERT(strcmp(samtrader_montecarlo_method_name(SAMTRADER_MONTECARLO_RETURNS), "returns") == 0,
+         "returns name");
+
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_invalid_input(void) {
+  printf("Testing invalid Monte Carlo input...\n");
+
+  Samrena *arena = samrena_create_default();
+  SamtraderWorkerPool *pool = samtrader_worker_pool_create(1);
+  double ret = 0.01;
+  SamrenaVector *curve = make_curve(arena, &ret, 1, 10);
+  SamrenaVector *empty = samrena_vector_init(arena, sizeof(SamtraderClosedTrade), 1);
+
+  SamtraderMonteCarloConfig mc = {.method = SAMTRADER_MONTECARLO_TRADES, .samples = 100};
+  ASSERT(samtrader_montecarlo_run(arena, pool, &mc, empty, curve) == NULL,
+         "Trades method needs trades");
+  mc.method = SAMTRADER_MONTECARLO_RETURNS;
+  ASSERT(samtrader_montecarlo_run(arena, pool, &mc, empty, curve) != NULL,
+         "Returns method does not need trades");
+  mc.samples = 0;
+  ASSERT(samtrader_montecarlo_run(arena, pool, &mc, empty, curve) == NULL, "Zero samples");
+  mc.samples = 100;
+  SamrenaVector *short_curve = make_curve(arena, &ret, 1, 1);
+  ASSERT(samtrader_montecarlo_run(arena, pool, &mc, empty, short_curve) == NULL,
+         "One equity point");
+
+  samtrader_worker_pool_destroy(pool);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_constant_trades(void) {
+  printf("Testing trade resampling of identical trades...\n");
+
+  Samrena *arena = samrena_create_default();
+  SamtraderWorkerPool *pool = samtrader_worker_pool_create(2);
+  double ret = 0.001;
+  SamrenaVector *curve = make_curve(arena, &ret, 1, 100);
+  double pnl = 50.0;
+  SamrenaVector *trades = make_trades(arena, &pnl, 1, 20);
+
+  SamtraderMonteCarloConfig mc = {
+      .method = SAMTRADER_MONTECARLO_TRADES, .samples = 500, .seed = 7, .risk_free_rate = 0.0};
+  SamtraderMonteCarloResult *r = samtrader_montecarlo_run(arena, pool, &mc, trades, curve);
+  ASSERT(r != NULL, "Run succeeds");
+  ASSERT(r->samples == 500 && r->sample_length == 20, "Sample shape");
+
+  /* Every path is the same 20 trades, so every percentile equals the one path */
+  for (size_t i = 0; i < SAMTRADER_MONTECARLO_LEVELS; i++) {
+    ASSERT_DOUBLE_EQ(r->total_return[i], 20.0 * pnl / INITIAL_EQUITY, 1e-12, "Total return");
+    ASSERT_DOUBLE_EQ(r->max_drawdown[i], 0.0, 1e-12, "No drawdown");
+    ASSERT_DOUBLE_EQ(r->sharpe_ratio[i], r->sharpe_ratio[0], 1e-12, "Equal Sharpe ratios");
+  }
+  ASSERT(r->sharpe_ratio[0] > 0.0, "Shrinking trade returns still have positive Sharpe");
+  ASSERT_DOUBLE_EQ(r->probability_of_loss, 0.0, 1e-12, "No losing paths");
+
+  samtrader_worker_pool_destroy(pool);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_constant_returns(void) {
+  printf("Testing block bootstrap of constant returns...\n");
+
+  Samrena *arena = samrena_create_default();
+  SamtraderWorkerPool *pool = samtrader_worker_pool_create(2);
+  /* Doubling equity keeps every point, and so every bar return, exact */
+  double ret = 1.0;
+  SamrenaVector *curve = make_curve(arena, &ret, 1, 28);
+
+  SamtraderMonteCarloConfig mc = {.method = SAMTRADER_MONTECARLO_RETURNS, .samples = 300};
+  SamtraderMonteCarloResult *r = samtrader_montecarlo_run(arena, pool, &mc, NULL, curve);
+  ASSERT(r != NULL, "Run succeeds");
+  ASSERT(r->sample_length == 27, "Paths span every bar return");
+  ASSERT(r->block_length == 3, "Default block length is the cube root of the bars");
+
+  double expected = pow(2.0, 27.0) - 1.0;
+  for (size_t i = 0; i < SAMTRADER_MONTECARLO_LEVELS; i++) {
+    ASSERT_DOUBLE_EQ(r->total_return[i], expected, 1e-6, "Compounded total return");
+    ASSERT_DOUBLE_EQ(r->max_drawdown[i], 0.0, 1e-12, "No drawdown");
+    ASSERT_DOUBLE_EQ(r->sharpe_ratio[i], 0.0, 1e-12, "Zero volatility gives zero Sharpe");
+  }
+
+  samtrader_worker_pool_destroy(pool);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_worker_count_independent(void) {
+  printf("Testing results do not depend on the worker count...\n");
+
+  Samrena *arena = samrena_create_default();
+  SamtraderWorkerPool *serial = samtrader_worker_pool_create(1);
+  SamtraderWorkerPool *parallel = samtrader_worker_pool_create(4);
+  double returns[] = {0.012, -0.008, 0.004, -0.015, 0.02, 0.001, -0.0145};
+  SamrenaVector *curve = make_curve(arena, returns, 7, 300);
+  double pnls[] = {420.0, -310.0, 95.0, -220.0, 310.0, -245.0};
+  SamrenaVector *trades = make_trades(arena, pnls, 6, 40);
+
+  SamtraderMonteCarloMethod methods[] = {SAMTRADER_MONTECARLO_TRADES,
+                                         SAMTRADER_MONTECARLO_RETURNS};
+  for (size_t m = 0; m < 2; m++) {
+    /* More than one chunk of samples, so several jumped streams are used */
+    SamtraderMonteCarloConfig mc = {
+        .method = methods[m], .samples = 5000, .block_length = 5, .seed = 99};
+    SamtraderMonteCarloResult *a = samtrader_montecarlo_run(arena, serial, &mc, trades, curve);
+    SamtraderMonteCarloResult *b = samtrader_montecarlo_run(arena, parallel, &mc, trades, curve);
+    ASSERT(a != NULL && b != NULL, "Runs succeed");
+    ASSERT(memcmp(a, b, sizeof(*a)) == 0, "Serial and parallel runs match exactly");
+
+    ASSERT(is_ascending(a->total_return), "Total return percentiles ascend");
+    ASSERT(is_ascending(a->sharpe_ratio), "Sharpe percentiles ascend");
+    ASSERT(is_ascending(a->max_drawdown), "Drawdown percentiles ascend");
+    ASSERT(a->total_return[0] < a->total_return[6], "Resampling spreads total returns");
+    ASSERT(a->max_drawdown[6] > 0.0, "Some paths draw down");
+    ASSERT(a->probability_of_loss > 0.0 && a->probability_of_loss < 1.0, "Mixed outcomes");
+
+    mc.seed = 100;
+    SamtraderMonteCarloResult *c = samtrader_montecarlo_run(arena, parallel, &mc, trades, curve);
+    ASSERT(c != NULL && memcmp(a, c, sizeof(*a)) != 0, "Different seeds differ");
+  }
+
+  samtrader_worker_pool_destroy(parallel);
+  samtrader_worker_pool_destroy(serial);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_ruin(void) {
+  printf("Testing paths that lose all equity...\n");
+
+  Samrena *arena = samrena_create_default();
+  SamtraderWorkerPool *pool = samtrader_worker_pool_create(2);
+  double ret = 0.001;
+  SamrenaVector *curve = make_curve(arena, &ret, 1, 50);
+  double pnls[] = {100.0, 100.0, 100.0, -6000.0};
+  SamrenaVector *trades = make_trades(arena, pnls, 4, 8);
+
+  SamtraderMonteCarloConfig mc = {.method = SAMTRADER_MONTECARLO_TRADES, .samples = 2000};
+  SamtraderMonteCarloResult *r = samtrader_montecarlo_run(arena, pool, &mc, trades, curve);
+  ASSERT(r != NULL, "Run succeeds");
+  ASSERT_DOUBLE_EQ(r->total_return[0], -1.0, 1e-12, "Worst paths lose everything");
+  ASSERT_DOUBLE_EQ(r->max_drawdown[6], 1.0, 1e-12, "Ruin is a 100% drawdown");
+  ASSERT(r->total_return[6] > 0.0, "Best paths avoid the large losses");
+
+  samtrader_worker_pool_destroy(pool);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+int main(void) {
+  printf("=== Monte Carlo Tests ===\n\n");
+
+  int failures = 0;
+
+  failures += test_method_parse();
+  failures += test_invalid_input();
+  failures += test_constant_trades();
+  failures += test_constant_returns();
+  failures += test_worker_count_independent();
+  failures += test_ruin();
+
+  printf("\n=== Results: %d failures ===\n", failures);
+
+  return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -151,6 +151,88 @@ static int test_ohlcv_vector(void) {
   return 0;
 }
 
+static int test_bar_columns_from_ohlcv(void) {
+  printf("Testing samtrader_bar_columns_from_ohlcv...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  SamrenaVector *vec = samtrader_ohlcv_vector_create(arena, 3);
+  ASSERT(vec != NULL, "Failed to create OHLCV vector");
+  for (int i = 0; i < 3; i++) {
+    SamtraderOhlcv bar = {.code = "AAPL",
+                          .exchange = "US",
+                          .date = 1704067200 + i * 86400,
+                          .open = 150.0 + i,
+                          .high = 155.0 + i,
+                          .low = 149.0 + i,
+                          .close = 153.0 + i,
+                          .volume = 1000000 + i};
+    samrena_vector_push(vec, &bar);
+  }
+
+  SamtraderBarColumns *bars = samtrader_bar_columns_from_ohlcv(arena, vec);
+  ASSERT(bars != NULL, "Failed to build bar columns");
+  ASSERT(bars->count == 3, "Column count should be 3");
+  ASSERT(strcmp(bars->code, "AAPL") == 0, "Code should be stored once");
+  ASSERT(strcmp(bars->exchange, "US") == 0, "Exchange should be stored once");
+
+  ASSERT((uintptr_t)bars->date % SAMTRADER_BAR_COLUMN_ALIGNMENT == 0, "date column alignment");
+  ASSERT((uintptr_t)bars->open % SAMTRADER_BAR_COLUMN_ALIGNMENT == 0, "open column alignment");
+  ASSERT((uintptr_t)bars->high % SAMTRADER_BAR_COLUMN_ALIGNMENT == 0, "high column alignment");
+  ASSERT((uintptr_t)bars->low % SAMTRADER_BAR_COLUMN_ALIGNMENT == 0, "low column alignment");
+  ASSERT((uintptr_t)bars->close % SAMTRADER_BAR_COLUMN_ALIGNMENT == 0, "close column alignment");
+  ASSERT((uintptr_t)bars->volume % SAMTRADER_BAR_COLUMN_ALIGNMENT == 0, "volume column alignment");
+
+  for (size_t i = 0; i < 3; i++) {
+    const SamtraderOhlcv *row = (const SamtraderOhlcv *)samrena_vector_at_const(vec, i);
+    ASSERT(bars->date[i] == row->date, "Date column mismatch");
+    ASSERT_DOUBLE_EQ(bars->open[i], row->open, "Open column mismatch");
+    ASSERT_DOUBLE_EQ(bars->high[i], row->high, "High column mismatch");
+    ASSERT_DOUBLE_EQ(bars->low[i], row->low, "Low column mismatch");
+    ASSERT_DOUBLE_EQ(bars->close[i], row->close, "Close column mismatch");
+    ASSERT(bars->volume[i] == row->volume, "Volume column mismatch");
+  }
+
+  /* Rows rebuilt on demand match the originals and share the stored code */
+  SamrenaVector *rows = samtrader_ohlcv_from_bar_columns(arena, bars);
+  ASSERT(rows != NULL && samrena_vector_size(rows) == 3, "Rows should round-trip");
+  for (size_t i = 0; i < 3; i++) {
+    const SamtraderOhlcv *a = (const SamtraderOhlcv *)samrena_vector_at_const(vec, i);
+    const SamtraderOhlcv *b = (const SamtraderOhlcv *)samrena_vector_at_const(rows, i);
+    ASSERT(a->date == b->date && a->close == b->close && a->volume == b->volume,
+           "Round-tripped row mismatch");
+    ASSERT(b->code == bars->code && b->exchange == bars->exchange,
+           "Rows should reference the stored code and exchange");
+  }
+  ASSERT(samtrader_ohlcv_from_bar_columns(arena, NULL) == NULL, "NULL bars should fail");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_bar_columns_empty_and_null(void) {
+  printf("Testing samtrader_bar_columns empty and NULL inputs...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  SamrenaVector *vec = samtrader_ohlcv_vector_create(arena, 1);
+  SamtraderBarColumns *bars = samtrader_bar_columns_from_ohlcv(arena, vec);
+  ASSERT(bars != NULL, "Empty vector should produce an empty store");
+  ASSERT(bars->count == 0, "Empty store should have no bars");
+  ASSERT(bars->close == NULL, "Empty store should have no columns");
+
+  ASSERT(samtrader_bar_columns_from_ohlcv(NULL, vec) == NULL, "NULL arena should fail");
+  ASSERT(samtrader_bar_columns_from_ohlcv(arena, NULL) == NULL, "NULL vector should fail");
+  ASSERT(samtrader_bar_columns_create(NULL, "AAPL", "US", 4) == NULL, "NULL arena should fail");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
 int main(void) {
   printf("=== OHLCV Data Structures Tests ===\n\n");
 
@@ -160,6 +242,8 @@ int main(void) {
   failures += test_ohlcv_typical_price();
   failures += test_ohlcv_true_range();
   failures += test_ohlcv_vector();
+  failures += test_bar_columns_from_ohlcv();
+  failures += test_bar_columns_empty_and_null();
 
   printf("\n=== Results: %d failures ===\n", failures);
 
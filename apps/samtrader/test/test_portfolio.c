@@ -334,6 +334,151 @@ static int test_portfolio_total_equity(void) {
   return 0;
 }
 
+static int test_find_triggers(void) {
+  printf("Testing samtrader_portfolio_find_triggers...\n");
+
+  Samrena *arena = samrena_create_default();
+  SamtraderPortfolio *portfolio = samtrader_portfolio_create(arena, 100000.0);
+
+  /* Long with SL 90 / TP 120, short with SL 55 / TP 40, long with no levels */
+  SamtraderPosition lng = {.code = "AAPL", .quantity = 10, .stop_loss = 90.0, .take_profit = 120.0};
+  SamtraderPosition sht = {.code = "BHP", .quantity = -10, .stop_loss = 55.0, .take_profit = 40.0};
+  SamtraderPosition bare = {.code = "CBA", .quantity = 10};
+  samtrader_portfolio_add_position(portfolio, arena, &lng);
+  samtrader_portfolio_add_position(portfolio, arena, &sht);
+  samtrader_portfolio_add_position(portfolio, arena, &bare);
+
+  size_t hits[3];
+  double quiet[] = {100.0, 50.0, 1.0};
+  ASSERT(samtrader_portfolio_find_triggers(portfolio, quiet, hits) == 0, "Nothing in range fires");
+
+  /* Levels are inclusive, as in samtrader_position_should_stop_loss */
+  double at_levels[] = {90.0, 40.0, 1e9};
+  ASSERT(samtrader_portfolio_find_triggers(portfolio, at_levels, hits) == 2, "Both levels fire");
+  ASSERT(hits[0] == 0 && hits[1] == 1, "Hits in open order");
+
+  double mixed[] = {NAN, 55.0, 0.0};
+  ASSERT(samtrader_portfolio_find_triggers(portfolio, mixed, hits) == 1, "Short stop fires");
+  ASSERT(hits[0] == 1, "Short is the hit; unpriced long never fires");
+
+  /* Closing AAPL moves CBA into index 0 along with its (absent) levels */
+  samtrader_portfolio_remove_position(portfolio, "AAPL");
+  double after_close[] = {0.0, 60.0};
+  ASSERT(samtrader_portfolio_find_triggers(portfolio, after_close, hits) == 1,
+         "Levels follow the swap-removed position");
+  ASSERT(hits[0] == 1, "Short still at index 1");
+
+  /* Re-adding an open position replaces its levels */
+  SamtraderPosition moved = {.code = "BHP", .quantity = -10, .stop_loss = 70.0};
+  samtrader_portfolio_add_position(portfolio, arena, &moved);
+  ASSERT(samtrader_portfolio_find_triggers(portfolio, after_close, hits) == 0,
+         "Replaced stop no longer fires at 60");
+
+  ASSERT(samtrader_portfolio_find_triggers(NULL, quiet, hits) == 0, "NULL portfolio");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_find_triggers_ohlc(void) {
+  printf("Testing samtrader_portfolio_find_triggers_ohlc...\n");
+
+  Samrena *arena = samrena_create_default();
+  SamtraderPortfolio *portfolio = samtrader_portfolio_create(arena, 100000.0);
+
+  /* Long SL 90 / TP 120 and short SL 55 / TP 40 */
+  SamtraderPosition lng = {.code = "AAPL", .quantity = 10, .stop_loss = 90.0, .take_profit = 120.0};
+  SamtraderPosition sht = {.code = "BHP", .quantity = -10, .stop_loss = 55.0, .take_profit = 40.0};
+  samtrader_portfolio_add_position(portfolio, arena, &lng);
+  samtrader_portfolio_add_position(portfolio, arena, &sht);
+
+  size_t hits[2];
+  double fills[2];
+
+  double open[] = {100.0, 50.0}, high[] = {119.0, 54.0}, low[] = {91.0, 41.0};
+  ASSERT(samtrader_portfolio_find_triggers_ohlc(portfolio, open, high, low, hits, fills) == 0,
+         "Ranges inside the levels do not fire");
+
+  /* Long reaches both levels (stop wins); short gaps up through its stop */
+  double both_open[] = {100.0, 58.0}, both_high[] = {125.0, 60.0}, both_low[] = {85.0, 57.0};
+  ASSERT(samtrader_portfolio_find_triggers_ohlc(portfolio, both_open, both_high, both_low, hits,
+                                                fills) == 2,
+         "Both fire");
+  ASSERT_DOUBLE_EQ(fills[0], 90.0, "Long fills at its stop");
+  ASSERT_DOUBLE_EQ(fills[1], 58.0, "Short fills at the gapped open");
+
+  /* Long touches its target only; short has no bar */
+  double t_open[] = {110.0, NAN}, t_high[] = {121.0, NAN}, t_low[] = {105.0, NAN};
+  ASSERT(samtrader_portfolio_find_triggers_ohlc(portfolio, t_open, t_high, t_low, hits, fills) == 1,
+         "Only the long fires");
+  ASSERT(hits[0] == 0, "Long hit");
+  ASSERT_DOUBLE_EQ(fills[0], 120.0, "Long fills at its target");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_price_table(void) {
+  printf("Testing samtrader_price_table...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  SamtraderPortfolio *portfolio = samtrader_portfolio_create(arena, 50000.0);
+  ASSERT(portfolio != NULL, "Failed to create portfolio");
+  SamtraderSymbolId aapl = samtrader_portfolio_intern(portfolio, "AAPL");
+  SamtraderSymbolId bhp = samtrader_portfolio_intern(portfolio, "BHP");
+  SamtraderSymbolId cba = samtrader_portfolio_intern(portfolio, "CBA");
+  ASSERT(aapl == 1 && bhp == 2 && cba == 3, "Codes interned in order get ids 1, 2, 3");
+  ASSERT(samtrader_portfolio_intern(portfolio, "BHP") == bhp, "Re-interning returns the same id");
+
+  SamtraderPriceTable *prices = samtrader_price_table_create(arena, portfolio->symbols);
+  ASSERT(prices != NULL, "Failed to create price table");
+  ASSERT(prices->count == 4, "Price table should have a slot per id plus the none slot");
+
+  double price = 0.0;
+  ASSERT(!samtrader_price_table_get(prices, "AAPL", &price), "New slots have no price");
+  ASSERT(!samtrader_price_table_get(prices, "MSFT", &price), "Unknown code has no price");
+  ASSERT(!samtrader_price_table_get_symbol(prices, SAMTRADER_SYMBOL_NONE, &price),
+         "The none id has no price");
+
+  prices->prices[bhp] = 50.0;
+  ASSERT(samtrader_price_table_get(prices, "BHP", &price), "BHP should have a price");
+  ASSERT_DOUBLE_EQ(price, 50.0, "BHP price");
+  ASSERT(samtrader_price_table_get_symbol(prices, bhp, &price), "BHP id should have a price");
+
+  SamtraderPosition pos1 = {
+      .code = "AAPL", .exchange = "US", .quantity = 100, .entry_price = 150.0, .entry_date = 0};
+  SamtraderPosition pos2 = {
+      .code = "BHP", .exchange = "AU", .quantity = -200, .entry_price = 45.0, .entry_date = 0};
+  samtrader_portfolio_add_position(portfolio, arena, &pos1);
+  samtrader_portfolio_add_position(portfolio, arena, &pos2);
+  ASSERT(samtrader_portfolio_position_at(portfolio, aapl) != NULL, "AAPL open by id");
+  ASSERT(samtrader_portfolio_position_at(portfolio, cba) == NULL, "CBA not open");
+
+  /* AAPL has no price this step, so only BHP counts: 50000 + 200 * 50 */
+  ASSERT_DOUBLE_EQ(samtrader_portfolio_total_equity_at(portfolio, prices), 60000.0,
+                   "Equity without AAPL price");
+
+  prices->prices[aapl] = 160.0;
+  ASSERT_DOUBLE_EQ(samtrader_portfolio_total_equity_at(portfolio, prices), 76000.0,
+                   "Equity with all prices");
+  ASSERT_DOUBLE_EQ(samtrader_portfolio_total_equity_at(NULL, prices), -1.0,
+                   "NULL portfolio should return -1.0");
+
+  SamtraderPortfolio *other = samtrader_portfolio_create(arena, 50000.0);
+  ASSERT_DOUBLE_EQ(samtrader_portfolio_total_equity_at(other, prices), -1.0,
+                   "A table over another portfolio's symbols should return -1.0");
+  ASSERT(samtrader_price_table_create(NULL, portfolio->symbols) == NULL,
+         "NULL arena should fail");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
 static int test_portfolio_null_params(void) {
   printf("Testing portfolio NULL parameter handling...\n");
 
@@ -400,6 +545,9 @@ int main(void) {
   failures += test_portfolio_record_trade();
   failures += test_portfolio_record_equity();
   failures += test_portfolio_total_equity();
+  failures += test_find_triggers();
+  failures += test_find_triggers_ohlc();
+  failures += test_price_table();
   failures += test_portfolio_null_params();
 
   printf("\n=== Results: %d failures ===\n", failures);
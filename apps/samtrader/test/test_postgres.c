@@ -16,10 +16,14 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 #include <samrena.h>
+#include <samvector.h>
 
 #include "samtrader/adapters/postgres_adapter.h"
+#include "samtrader/domain/ohlcv.h"
 #include "samtrader/ports/data_port.h"
 
 #define ASSERT(cond, msg)                                                                          \
@@ -85,6 +89,8 @@ static int test_port_interface_populated(void) {
   ASSERT(port != NULL, "Failed to create postgres adapter with live DB");
 
   ASSERT(port->fetch_ohlcv != NULL, "fetch_ohlcv function pointer should be set");
+  ASSERT(port->fetch_ohlcv_batch != NULL, "fetch_ohlcv_batch function pointer should be set");
+  ASSERT(port->fetch_summary != NULL, "fetch_summary function pointer should be set");
   ASSERT(port->list_symbols != NULL, "list_symbols function pointer should be set");
   ASSERT(port->close != NULL, "close function pointer should be set");
 
@@ -94,6 +100,110 @@ static int test_port_interface_populated(void) {
   return 0;
 }
 
+static int test_fetch_batch_matches_single(void) {
+  printf("Testing batch fetch matches per-symbol fetch (live DB)...\n");
+
+  const char *conninfo = getenv("SAMTRADER_TEST_PG_CONNINFO");
+  if (conninfo == NULL) {
+    printf("  SKIP (SAMTRADER_TEST_PG_CONNINFO not set)\n");
+    return 0;
+  }
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  SamtraderDataPort *port = samtrader_postgres_adapter_create(arena, conninfo);
+  ASSERT(port != NULL, "Failed to create postgres adapter with live DB");
+
+  const char *exchange = getenv("SAMTRADER_TEST_PG_EXCHANGE");
+  if (!exchange)
+    exchange = "AU";
+  SamrenaVector *symbols = port->list_symbols(port, exchange);
+  ASSERT(symbols != NULL, "list_symbols should succeed");
+
+  /* A handful of real symbols plus one that has no rows */
+  const char *codes[4];
+  size_t count = 0;
+  for (size_t i = 0; i < samrena_vector_size(symbols) && count < 3; i++)
+    codes[count++] = *(const char *const *)samrena_vector_at_const(symbols, i);
+  codes[count++] = "NO_SUCH_CODE";
+
+  time_t start = 946684800; /* 2000-01-01 */
+  time_t end = time(NULL);
+  SamrenaVector **batch = port->fetch_ohlcv_batch(port, codes, count, exchange, start, end);
+  ASSERT(batch != NULL, "Batch fetch should succeed");
+
+  for (size_t i = 0; i < count; i++) {
+    SamrenaVector *single = port->fetch_ohlcv(port, codes[i], exchange, start, end);
+    ASSERT(single != NULL, "Single fetch should succeed");
+    ASSERT(samrena_vector_size(batch[i]) == samrena_vector_size(single), "Row counts match");
+    for (size_t j = 0; j < samrena_vector_size(single); j++) {
+      const SamtraderOhlcv *a = samrena_vector_at_const(batch[i], j);
+      const SamtraderOhlcv *b = samrena_vector_at_const(single, j);
+      ASSERT(a->date == b->date && a->open == b->open && a->high == b->high &&
+                 a->low == b->low && a->close == b->close && a->volume == b->volume,
+             "Batch rows match single fetch");
+      ASSERT(strcmp(a->code, codes[i]) == 0, "Rows carry their code");
+    }
+  }
+  ASSERT(samrena_vector_size(batch[count - 1]) == 0, "Unknown code yields an empty vector");
+
+  port->close(port);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_fetch_summary_matches_fetch(void) {
+  printf("Testing summary matches fetched bars (live DB)...\n");
+
+  const char *conninfo = getenv("SAMTRADER_TEST_PG_CONNINFO");
+  if (conninfo == NULL) {
+    printf("  SKIP (SAMTRADER_TEST_PG_CONNINFO not set)\n");
+    return 0;
+  }
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  SamtraderDataPort *port = samtrader_postgres_adapter_create(arena, conninfo);
+  ASSERT(port != NULL, "Failed to create postgres adapter with live DB");
+
+  const char *exchange = getenv("SAMTRADER_TEST_PG_EXCHANGE");
+  if (!exchange)
+    exchange = "AU";
+  SamrenaVector *symbols = port->list_symbols(port, exchange);
+  ASSERT(symbols != NULL, "list_symbols should succeed");
+
+  time_t start = 946684800; /* 2000-01-01 */
+  time_t end = time(NULL);
+  SamtraderOhlcvSummary summary;
+  if (samrena_vector_size(symbols) > 0) {
+    const char *code = *(const char *const *)samrena_vector_at_const(symbols, 0);
+    SamrenaVector *bars = port->fetch_ohlcv(port, code, exchange, start, end);
+    ASSERT(bars != NULL, "Fetch should succeed");
+    ASSERT(port->fetch_summary(port, code, exchange, start, end, &summary) == 0,
+           "Summary should succeed");
+    size_t n = samrena_vector_size(bars);
+    ASSERT(summary.bar_count == n, "Summary count matches fetched rows");
+    if (n > 0) {
+      const SamtraderOhlcv *first = samrena_vector_at_const(bars, 0);
+      const SamtraderOhlcv *last = samrena_vector_at_const(bars, n - 1);
+      ASSERT(summary.first_date == first->date && summary.last_date == last->date,
+             "Summary dates match fetched rows");
+      ASSERT(summary.first_close == first->close && summary.last_close == last->close,
+             "Summary closes match fetched rows");
+    }
+  }
+
+  ASSERT(port->fetch_summary(port, "NO_SUCH_CODE", exchange, start, end, &summary) == 0,
+         "Summary of unknown code should succeed");
+  ASSERT(summary.bar_count == 0, "Unknown code has no bars");
+
+  port->close(port);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
 int main(void) {
   printf("=== PostgreSQL Adapter Tests ===\n\n");
 
@@ -103,6 +213,8 @@ int main(void) {
   failures += test_create_null_conninfo();
   failures += test_create_invalid_conninfo();
   failures += test_port_interface_populated();
+  failures += test_fetch_batch_matches_single();
+  failures += test_fetch_summary_matches_fetch();
 
   printf("\n=== Results: %d failures ===\n", failures);
 
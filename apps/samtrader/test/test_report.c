@@ -1108,6 +1108,71 @@ static int test_large_equity_curve_downsampling(void) {
   return 0;
 }
 
+/* Helper: count the vertices of a polyline and check for one at the given y */
+static size_t polyline_vertices(const char *polyline, int want_y, bool *found) {
+  const char *pos = strstr(polyline, "points='") + strlen("points='");
+  size_t count = 0;
+  *found = false;
+  int x, y, used;
+  while (*pos != '\'' && sscanf(pos, "%d,%d %n", &x, &y, &used) == 2) {
+    if (y == want_y) {
+      *found = true;
+    }
+    count++;
+    pos += used;
+  }
+  return count;
+}
+
+static int test_chart_decimation_keeps_extremes(void) {
+  printf("Testing chart decimation keeps peaks and troughs...\n");
+  Samrena *arena = samrena_create_default();
+  SamtraderReportPort *port = samtrader_typst_adapter_create(arena, NULL);
+  samtrader_typst_adapter_set_chart_points(port, 50);
+  samtrader_typst_adapter_set_chart_points(NULL, 50);
+  SamtraderBacktestResult result = make_result(arena);
+  SamtraderStrategy strategy = make_strategy();
+  const char *path = temp_path("decimate");
+
+  /* Flat curve with a one-bar spike and a one-bar crash that stride sampling skips */
+  result.equity_curve = samrena_vector_init(arena, sizeof(SamtraderEquityPoint), 10000);
+  for (int i = 0; i < 10000; i++) {
+    SamtraderEquityPoint pt;
+    pt.date = day_time(0) + (time_t)i * 3600;
+    pt.equity = i == 5003 ? 20000.0 : (i == 7001 ? 5000.0 : 10000.0);
+    samrena_vector_push(result.equity_curve, &pt);
+  }
+
+  bool ok = port->write(port, &result, &strategy, path);
+  ASSERT(ok, "write should succeed");
+  char *content = read_file(path);
+  ASSERT(content != NULL, "Output should be readable");
+
+  /* Plot area spans y = 15 (top) to y = 210 (bottom) */
+  const char *equity_line = strstr(content, "<polyline");
+  ASSERT(equity_line != NULL, "Should have an equity polyline");
+  bool found = false;
+  size_t count = polyline_vertices(equity_line, 15, &found);
+  ASSERT(count == 50, "Equity curve should be decimated to the point budget");
+  ASSERT(found, "Equity spike should survive decimation");
+  polyline_vertices(equity_line, 210, &found);
+  ASSERT(found, "Equity crash should survive decimation");
+
+  const char *drawdown_line = strstr(equity_line + 1, "<polyline");
+  ASSERT(drawdown_line != NULL, "Should have a drawdown polyline");
+  count = polyline_vertices(drawdown_line, 210, &found);
+  ASSERT(count == 50, "Drawdown curve should be decimated to the point budget");
+  ASSERT(found, "Deepest drawdown should survive decimation");
+  ASSERT(strstr(content, "-75.0%") != NULL, "Drawdown scale should use the full curve");
+
+  free(content);
+  unlink(path);
+  port->close(port);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
 /* ========== Main ========== */
 
 int main(void) {
@@ -1159,6 +1224,7 @@ int main(void) {
 
   /* Large datasets */
   failures += test_large_equity_curve_downsampling();
+  failures += test_chart_decimation_keeps_extremes();
 
   printf("\n=== Results: %d failures ===\n", failures);
   return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
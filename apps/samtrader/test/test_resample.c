@@ -0,0 +1,218 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "samtrader/domain/resample.h"
+
+#define ASSERT(cond, msg)                                                                          \
+  do {                                                                                             \
+    if (!(cond)) {                                                                                 \
+      printf("FAIL: %s\n", msg);                                                                   \
+      return 1;                                                                                    \
+    }                                                                                              \
+  } while (0)
+
+#define ASSERT_DOUBLE_EQ(a, b, msg)                                                                \
+  do {                                                                                             \
+    if (fabs((a) - (b)) > 0.0001) {                                                                \
+      printf("FAIL: %s (expected %f, got %f)\n", msg, (b), (a));                                   \
+      return 1;                                                                                    \
+    }                                                                                              \
+  } while (0)
+
+/* 2024-01-02 00:00:00 UTC */
+#define DAY0 1704153600
+
+static SamtraderOhlcv make_bar(time_t date, double open, double high, double low, double close,
+                               int64_t volume) {
+  return (SamtraderOhlcv){.code = "BHP",
+                          .exchange = "AU",
+                          .date = date,
+                          .open = open,
+                          .high = high,
+                          .low = low,
+                          .close = close,
+                          .volume = volume};
+}
+
+static int test_bar_interval_parse(void) {
+  printf("Testing samtrader_bar_interval_parse...\n");
+
+  int64_t seconds = 0;
+  ASSERT(samtrader_bar_interval_parse("1m", &seconds) && seconds == 60, "1m should be 60s");
+  ASSERT(samtrader_bar_interval_parse("5m", &seconds) && seconds == 300, "5m should be 300s");
+  ASSERT(samtrader_bar_interval_parse("4h", &seconds) && seconds == 14400, "4h should be 14400s");
+  ASSERT(samtrader_bar_interval_parse("1d", &seconds) && seconds == SAMTRADER_SECONDS_PER_DAY,
+         "1d should be one day");
+
+  seconds = 42;
+  ASSERT(!samtrader_bar_interval_parse("", &seconds), "Empty text should fail");
+  ASSERT(!samtrader_bar_interval_parse("5", &seconds), "Missing unit should fail");
+  ASSERT(!samtrader_bar_interval_parse("m", &seconds), "Missing count should fail");
+  ASSERT(!samtrader_bar_interval_parse("0m", &seconds), "Zero count should fail");
+  ASSERT(!samtrader_bar_interval_parse("-5m", &seconds), "Negative count should fail");
+  ASSERT(!samtrader_bar_interval_parse("5w", &seconds), "Unknown unit should fail");
+  ASSERT(!samtrader_bar_interval_parse("5mm", &seconds), "Trailing text should fail");
+  ASSERT(!samtrader_bar_interval_parse(NULL, &seconds), "NULL text should fail");
+  ASSERT(seconds == 42, "Failed parse should leave seconds untouched");
+
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_resampler_aggregates_buckets(void) {
+  printf("Testing samtrader_resampler_push aggregation...\n");
+
+  SamtraderResampler resampler;
+  samtrader_resampler_init(&resampler, 300);
+  SamtraderOhlcv out;
+
+  /* Three 1-minute bars in the 00:00 bucket, starting one minute in */
+  SamtraderOhlcv b1 = make_bar(DAY0 + 60, 10.0, 11.0, 9.5, 10.5, 100);
+  SamtraderOhlcv b2 = make_bar(DAY0 + 120, 10.5, 12.0, 10.0, 11.5, 200);
+  SamtraderOhlcv b3 = make_bar(DAY0 + 240, 11.5, 11.8, 9.0, 9.2, 300);
+  ASSERT(!samtrader_resampler_push(&resampler, &b1, &out), "First bar should not emit");
+  ASSERT(!samtrader_resampler_push(&resampler, &b2, &out), "Same bucket should not emit");
+  ASSERT(!samtrader_resampler_push(&resampler, &b3, &out), "Same bucket should not emit");
+
+  /* The 00:05 bar closes the first bucket */
+  SamtraderOhlcv b4 = make_bar(DAY0 + 300, 9.3, 9.4, 9.1, 9.35, 50);
+  ASSERT(samtrader_resampler_push(&resampler, &b4, &out), "New bucket should emit");
+  ASSERT(out.date == DAY0, "Bucket should be stamped with its start");
+  ASSERT_DOUBLE_EQ(out.open, 10.0, "Open should be the first open");
+  ASSERT_DOUBLE_EQ(out.high, 12.0, "High should be the highest high");
+  ASSERT_DOUBLE_EQ(out.low, 9.0, "Low should be the lowest low");
+  ASSERT_DOUBLE_EQ(out.close, 9.2, "Close should be the last close");
+  ASSERT(out.volume == 600, "Volume should be summed");
+  ASSERT(strcmp(out.code, "BHP") == 0, "Code should carry through");
+
+  ASSERT(samtrader_resampler_flush(&resampler, &out), "Flush should emit the open bucket");
+  ASSERT(out.date == DAY0 + 300, "Flushed bucket start");
+  ASSERT_DOUBLE_EQ(out.close, 9.35, "Flushed bucket close");
+  ASSERT(!samtrader_resampler_flush(&resampler, &out), "Second flush should emit nothing");
+
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_resampler_before_epoch(void) {
+  printf("Testing samtrader_resampler_push before 1970...\n");
+
+  SamtraderResampler resampler;
+  samtrader_resampler_init(&resampler, 3600);
+  SamtraderOhlcv out;
+
+  /* 1969-12-31 23:30 belongs to the 23:00 bucket, not the 00:00 one */
+  SamtraderOhlcv before = make_bar(-1800, 1.0, 2.0, 0.5, 1.5, 10);
+  SamtraderOhlcv after = make_bar(0, 1.5, 1.6, 1.4, 1.45, 20);
+  ASSERT(!samtrader_resampler_push(&resampler, &before, &out), "First bar should not emit");
+  ASSERT(samtrader_resampler_push(&resampler, &after, &out), "Midnight should start a bucket");
+  ASSERT(out.date == -3600, "Negative times should floor to the bucket start");
+  ASSERT(out.volume == 10, "Earlier bucket volume");
+
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_ohlcv_resample_vector(void) {
+  printf("Testing samtrader_ohlcv_resample...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  /* Two days of hourly bars, with a gap on the second day */
+  SamrenaVector *hourly = samtrader_ohlcv_vector_create(arena, 16);
+  ASSERT(hourly != NULL, "Failed to create vector");
+  for (int h = 0; h < 6; h++) {
+    SamtraderOhlcv bar = make_bar(DAY0 + h * 3600, 100.0 + h, 101.0 + h, 99.0 + h, 100.5 + h, 10);
+    ASSERT(samrena_vector_push(hourly, &bar), "Failed to push bar");
+  }
+  for (int h = 2; h < 4; h++) {
+    SamtraderOhlcv bar =
+        make_bar(DAY0 + SAMTRADER_SECONDS_PER_DAY + h * 3600, 90.0, 95.0, 85.0, 92.0, 5);
+    ASSERT(samrena_vector_push(hourly, &bar), "Failed to push bar");
+  }
+
+  SamrenaVector *daily = samtrader_ohlcv_resample(arena, hourly, SAMTRADER_SECONDS_PER_DAY);
+  ASSERT(daily != NULL, "Resample should succeed");
+  ASSERT(samrena_vector_size(daily) == 2, "Two days should give two bars");
+
+  const SamtraderOhlcv *bars = (const SamtraderOhlcv *)daily->data;
+  ASSERT(bars[0].date == DAY0, "Day one starts at midnight");
+  ASSERT_DOUBLE_EQ(bars[0].open, 100.0, "Day one open");
+  ASSERT_DOUBLE_EQ(bars[0].high, 106.0, "Day one high");
+  ASSERT_DOUBLE_EQ(bars[0].low, 99.0, "Day one low");
+  ASSERT_DOUBLE_EQ(bars[0].close, 105.5, "Day one close");
+  ASSERT(bars[0].volume == 60, "Day one volume");
+  ASSERT(bars[1].date == DAY0 + SAMTRADER_SECONDS_PER_DAY, "Day two starts at midnight");
+  ASSERT(bars[1].volume == 10, "Day two volume");
+
+  /* Resampling to the source interval keeps every bar */
+  SamrenaVector *same = samtrader_ohlcv_resample(arena, hourly, 3600);
+  ASSERT(same != NULL && samrena_vector_size(same) == 8, "Same interval should keep bars");
+
+  SamrenaVector *empty = samtrader_ohlcv_vector_create(arena, 1);
+  SamrenaVector *none = samtrader_ohlcv_resample(arena, empty, 3600);
+  ASSERT(none != NULL && samrena_vector_size(none) == 0, "Empty input gives empty output");
+
+  ASSERT(samtrader_ohlcv_resample(arena, hourly, 0) == NULL, "Zero period should fail");
+  ASSERT(samtrader_ohlcv_resample(NULL, hourly, 3600) == NULL, "NULL arena should fail");
+  ASSERT(samtrader_ohlcv_resample(arena, NULL, 3600) == NULL, "NULL vector should fail");
+
+  /* The columnar resample matches the row resample exactly */
+  SamtraderBarColumns *hourly_bars = samtrader_bar_columns_from_ohlcv(arena, hourly);
+  SamtraderBarColumns *daily_bars =
+      samtrader_bar_columns_resample(arena, hourly_bars, SAMTRADER_SECONDS_PER_DAY);
+  ASSERT(daily_bars != NULL && daily_bars->count == 2, "Columnar resample should give two bars");
+  ASSERT(strcmp(daily_bars->code, hourly_bars->code) == 0, "Code should carry over");
+  for (size_t i = 0; i < 2; i++) {
+    ASSERT(daily_bars->date[i] == bars[i].date, "Columnar date mismatch");
+    ASSERT_DOUBLE_EQ(daily_bars->open[i], bars[i].open, "Columnar open mismatch");
+    ASSERT_DOUBLE_EQ(daily_bars->high[i], bars[i].high, "Columnar high mismatch");
+    ASSERT_DOUBLE_EQ(daily_bars->low[i], bars[i].low, "Columnar low mismatch");
+    ASSERT_DOUBLE_EQ(daily_bars->close[i], bars[i].close, "Columnar close mismatch");
+    ASSERT(daily_bars->volume[i] == bars[i].volume, "Columnar volume mismatch");
+  }
+  SamtraderBarColumns *no_bars = samtrader_bar_columns_create(arena, NULL, NULL, 0);
+  SamtraderBarColumns *no_days = samtrader_bar_columns_resample(arena, no_bars, 3600);
+  ASSERT(no_days != NULL && no_days->count == 0, "Empty store gives empty output");
+  ASSERT(samtrader_bar_columns_resample(arena, hourly_bars, 0) == NULL,
+         "Zero period should fail");
+  ASSERT(samtrader_bar_columns_resample(arena, NULL, 3600) == NULL, "NULL bars should fail");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+int main(void) {
+  printf("=== Resampling Tests ===\n\n");
+
+  int failures = 0;
+
+  failures += test_bar_interval_parse();
+  failures += test_resampler_aggregates_buckets();
+  failures += test_resampler_before_epoch();
+  failures += test_ohlcv_resample_vector();
+
+  printf("\n=== Results: %d failures ===\n", failures);
+
+  return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
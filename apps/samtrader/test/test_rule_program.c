@@ -0,0 +1,516 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <samdata/samhashmap.h>
+#include <samrena.h>
+#include <samvector.h>
+
+#include "samtrader/domain/code_data.h"
+#include "samtrader/domain/ohlcv.h"
+#include "samtrader/domain/rule.h"
+#include "samtrader/domain/rule_program.h"
+#include "samtrader/domain/strategy.h"
+
+#define ASSERT(cond, msg)                                                                          \
+  do {                                                                                             \
+    if (!(cond)) {                                                                                 \
+      printf("FAIL: %s\n", msg);                                                                   \
+      return 1;                                                                                    \
+    }                                                                                              \
+  } while (0)
+
+#define BASE_DATE 1704067200
+#define DAY_SECONDS 86400
+#define BAR_COUNT 120
+
+/*============================================================================
+ * Test Helpers
+ *============================================================================*/
+
+/**
+ * Build `count` bars of one code. A 21-bar price cycle over a slow uptrend
+ * and a volume sawtooth of its own make every comparison and crossing
+ * rule flip many times, so the compiled and tree-walking evaluators are
+ * compared on both outcomes.
+ */
+static SamtraderCodeData *make_code_data(Samrena *arena, size_t count) {
+  SamtraderCodeData *cd = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderCodeData);
+  SamtraderBarColumns *bars = samtrader_bar_columns_create(arena, "TEST", "US", count);
+  for (size_t i = 0; i < count; i++) {
+    double close = 100.0 + 10.0 * sin((double)i * 0.3) + (double)i * 0.05;
+    bars->date[i] = BASE_DATE + (time_t)(i * DAY_SECONDS);
+    bars->open[i] = close - 0.5;
+    bars->high[i] = close + 1.5;
+    bars->low[i] = close - 2.0;
+    bars->close[i] = close;
+    bars->volume[i] = 10000 + (int64_t)((i * 37) % 500);
+  }
+  cd->code = bars->code;
+  cd->exchange = bars->exchange;
+  cd->bars = bars;
+  cd->bar_count = count;
+  return cd;
+}
+
+/**
+ * Compare the compiled program against the tree-walking evaluator at every
+ * bar index (and one past the end), and its whole-series signals at every
+ * bar. Returns the number of mismatches.
+ */
+static int count_mismatches(Samrena *arena, const SamtraderRule *rule,
+                            const SamtraderCodeData *cd) {
+  SamtraderRuleProgram *program = samtrader_rule_compile(arena, rule, cd);
+  SamtraderRuleSignals signals;
+  if (!program || samtrader_rule_program_signals(arena, program, &signals) < 0)
+    return -1;
+  /* The tree-walking evaluator reads bars as rows */
+  SamrenaVector *rows = samtrader_ohlcv_from_bar_columns(arena, cd->bars);
+  int mismatches = 0;
+  size_t n = cd->bar_count;
+  for (size_t i = 0; i <= n; i++) {
+    bool expected = samtrader_rule_evaluate(rule, rows, cd->indicators, i);
+    if (samtrader_rule_program_evaluate(program, i) != expected)
+      mismatches++;
+    if (i < n && samtrader_rule_signals_test(&signals, i) != expected)
+      mismatches++;
+  }
+  return mismatches;
+}
+
+/**
+ * Compute a rule's indicators and check program/tree equivalence.
+ * Returns the number of bars where the rule fired, or -1 on mismatch.
+ */
+static int check_rule(Samrena *arena, const SamtraderRule *rule) {
+  if (!rule)
+    return -1;
+  SamtraderCodeData *cd = make_code_data(arena, BAR_COUNT);
+  SamtraderStrategy strategy = {.entry_long = (SamtraderRule *)rule,
+                                .exit_long = (SamtraderRule *)rule};
+  if (samtrader_code_data_compute_indicators(arena, cd, &strategy) < 0)
+    return -1;
+  if (count_mismatches(arena, rule, cd) != 0)
+    return -1;
+
+  SamrenaVector *rows = samtrader_ohlcv_from_bar_columns(arena, cd->bars);
+  int fired = 0;
+  for (size_t i = 0; i < BAR_COUNT; i++) {
+    if (samtrader_rule_evaluate(rule, rows, cd->indicators, i))
+      fired++;
+  }
+  return fired;
+}
+
+/** Parse a rule and run check_rule() on it in a fresh arena. */
+static int check_rule_text(const char *text) {
+  Samrena *arena = samrena_create_default();
+  int result = check_rule(arena, samtrader_rule_parse(arena, text));
+  samrena_destroy(arena);
+  return result;
+}
+
+/*============================================================================
+ * Equivalence Tests
+ *============================================================================*/
+
+static int test_comparison_rules(void) {
+  printf("Testing compiled comparison rules match tree evaluation...\n");
+
+  static const char *rules[] = {
+      "ABOVE(close, SMA(20))",
+      "BELOW(close, EMA(10))",
+      "ABOVE(open, 100)",
+      "BELOW(high, 105.5)",
+      "ABOVE(low, 100)",
+      "ABOVE(volume, 10200)",
+      "EQUALS(close, close)",
+      "BETWEEN(RSI(14), 30, 70)",
+      "CROSS_ABOVE(close, SMA(10))",
+      "CROSS_BELOW(EMA(5), SMA(20))",
+      "ABOVE(ATR(14), 2.5)",
+  };
+
+  for (size_t i = 0; i < sizeof(rules) / sizeof(rules[0]); i++) {
+    int fired = check_rule_text(rules[i]);
+    if (fired < 0)
+      printf("  rule: %s\n", rules[i]);
+    ASSERT(fired >= 0, "Compiled comparison rule diverged from tree evaluation");
+  }
+
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_multi_value_indicators(void) {
+  printf("Testing compiled multi-value indicator operands...\n");
+
+  static const char *rules[] = {
+      "ABOVE(close, BOLLINGER_UPPER(20, 2.0))",
+      "BELOW(close, BOLLINGER_LOWER(20, 2.0))",
+      "CROSS_ABOVE(close, BOLLINGER_MIDDLE(20, 2.0))",
+      "ABOVE(MACD(12, 26, 9), 0)",
+      "ABOVE(close, PIVOT)",
+      "ABOVE(close, PIVOT_R1)",
+      "BELOW(close, PIVOT_S1)",
+      "BELOW(close, PIVOT_S3)",
+  };
+
+  for (size_t i = 0; i < sizeof(rules) / sizeof(rules[0]); i++) {
+    int fired = check_rule_text(rules[i]);
+    if (fired < 0)
+      printf("  rule: %s\n", rules[i]);
+    ASSERT(fired >= 0, "Compiled multi-value rule diverged from tree evaluation");
+  }
+
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_unparsed_indicator_operands(void) {
+  printf("Testing compiled WMA and stochastic operands...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  SamtraderOperand low = samtrader_operand_price(SAMTRADER_OPERAND_PRICE_LOW);
+  SamtraderOperand wma = samtrader_operand_indicator(SAMTRADER_IND_WMA, 5);
+  SamtraderOperand stoch = samtrader_operand_indicator_multi(SAMTRADER_IND_STOCHASTIC, 14, 3, 0);
+  SamtraderOperand eighty = samtrader_operand_constant(80.0);
+
+  SamtraderRule *wma_rule = samtrader_rule_create_comparison(arena, SAMTRADER_RULE_CROSS_ABOVE,
+                                                             low, wma);
+  ASSERT(check_rule(arena, wma_rule) >= 0, "WMA rule diverged from tree evaluation");
+
+  SamtraderRule *stoch_rule =
+      samtrader_rule_create_comparison(arena, SAMTRADER_RULE_ABOVE, stoch, eighty);
+  ASSERT(check_rule(arena, stoch_rule) >= 0, "Stochastic rule diverged from tree evaluation");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_composite_and_temporal_rules(void) {
+  printf("Testing compiled composite and temporal rules...\n");
+
+  static const char *rules[] = {
+      "AND(ABOVE(close, SMA(20)), BELOW(RSI(14), 70))",
+      "OR(CROSS_ABOVE(close, SMA(10)), CROSS_BELOW(close, EMA(10)))",
+      "NOT(ABOVE(close, SMA(20)))",
+      "CONSECUTIVE(ABOVE(close, SMA(5)), 3)",
+      "ANY_OF(CROSS_ABOVE(close, SMA(20)), 10)",
+      "ANY_OF(AND(ABOVE(close, SMA(20)), BELOW(RSI(14), 70)), 5)",
+      "AND(NOT(OR(ABOVE(close, 120), BELOW(close, 80))), CONSECUTIVE(ABOVE(EMA(5), EMA(20)), 2))",
+      "OR(AND(ABOVE(close, SMA(5)), ABOVE(close, SMA(5))), NOT(BELOW(volume, 10100)))",
+  };
+
+  for (size_t i = 0; i < sizeof(rules) / sizeof(rules[0]); i++) {
+    int fired = check_rule_text(rules[i]);
+    if (fired < 0)
+      printf("  rule: %s\n", rules[i]);
+    ASSERT(fired >= 0, "Compiled composite rule diverged from tree evaluation");
+  }
+
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_rules_fire(void) {
+  printf("Testing compiled rules fire on oscillating data...\n");
+
+  /* Guard against an equivalence check where both sides are always false */
+  ASSERT(check_rule_text("CROSS_ABOVE(close, SMA(10))") > 0, "Crossover should fire");
+  ASSERT(check_rule_text("ANY_OF(CROSS_ABOVE(close, SMA(20)), 10)") > 0, "ANY_OF should fire");
+  ASSERT(check_rule_text("ABOVE(close, BOLLINGER_MIDDLE(20, 2.0))") > 0, "Bollinger should fire");
+
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_signals_word_boundaries(void) {
+  printf("Testing whole-series signals across word boundaries and long lookbacks...\n");
+
+  static const char *rules[] = {
+      "ABOVE(close, SMA(5))",
+      "NOT(ABOVE(close, SMA(5)))",
+      "CROSS_ABOVE(close, SMA(10))",
+      "CONSECUTIVE(ABOVE(close, SMA(5)), 40)",
+      "ANY_OF(CROSS_BELOW(close, SMA(10)), 70)",
+      "AND(ANY_OF(CROSS_ABOVE(close, SMA(5)), 64), NOT(CONSECUTIVE(BELOW(RSI(14), 50), 65)))",
+  };
+  static const size_t sizes[] = {1, 63, 64, 65, 128, 130};
+
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    Samrena *arena = samrena_create_default();
+    ASSERT(arena != NULL, "Failed to create arena");
+    SamtraderCodeData *cd = make_code_data(arena, sizes[s]);
+    for (size_t i = 0; i < sizeof(rules) / sizeof(rules[0]); i++) {
+      SamtraderRule *rule = samtrader_rule_parse(arena, rules[i]);
+      ASSERT(rule != NULL, "Failed to parse rule");
+      SamtraderStrategy strategy = {.entry_long = rule, .exit_long = rule};
+      ASSERT(samtrader_code_data_compute_indicators(arena, cd, &strategy) == 0,
+             "Failed to compute indicators");
+      int mismatches = count_mismatches(arena, rule, cd);
+      if (mismatches != 0)
+        printf("  rule: %s, bars: %zu\n", rules[i], sizes[s]);
+      ASSERT(mismatches == 0, "Signals diverged from tree evaluation");
+    }
+    samrena_destroy(arena);
+  }
+
+  /* No bars: empty signals read false */
+  Samrena *arena = samrena_create_default();
+  SamtraderCodeData *cd = make_code_data(arena, 0);
+  SamtraderRuleProgram *program =
+      samtrader_rule_compile(arena, samtrader_rule_parse(arena, "ABOVE(close, 0)"), cd);
+  SamtraderRuleSignals signals;
+  ASSERT(samtrader_rule_program_signals(arena, program, &signals) == 0, "Empty series is valid");
+  ASSERT(signals.bar_count == 0 && !samtrader_rule_signals_test(&signals, 0),
+         "Empty signals should read false");
+  ASSERT(samtrader_rule_program_signals(arena, NULL, &signals) == -1, "NULL program should fail");
+  samrena_destroy(arena);
+
+  printf("  PASS\n");
+  return 0;
+}
+
+/*============================================================================
+ * Edge Case Tests
+ *============================================================================*/
+
+static int test_missing_indicator(void) {
+  printf("Testing compiled rule with missing indicator series...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  SamtraderCodeData *cd = make_code_data(arena, BAR_COUNT);
+  SamtraderRule *computed = samtrader_rule_parse(arena, "ABOVE(close, SMA(10))");
+  SamtraderStrategy strategy = {.entry_long = computed, .exit_long = computed};
+  ASSERT(samtrader_code_data_compute_indicators(arena, cd, &strategy) == 0,
+         "Failed to compute indicators");
+
+  /* SMA(50) was never computed; NOT() exposes the always-false operand */
+  SamtraderRule *missing = samtrader_rule_parse(arena, "NOT(ABOVE(close, SMA(50)))");
+  ASSERT(missing != NULL, "Failed to parse rule");
+  ASSERT(count_mismatches(arena, missing, cd) == 0, "Missing indicator should match tree");
+
+  SamtraderRuleProgram *program = samtrader_rule_compile(arena, missing, cd);
+  ASSERT(program != NULL, "Compile should succeed with missing indicator");
+  ASSERT(samtrader_rule_program_evaluate(program, 60), "NOT(missing) should be true");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_null_indicator_map(void) {
+  printf("Testing compiled rule with NULL indicator map...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  SamtraderCodeData *cd = make_code_data(arena, BAR_COUNT);
+  SamtraderRule *rule = samtrader_rule_parse(arena, "OR(ABOVE(close, SMA(10)), ABOVE(close, 0))");
+  ASSERT(rule != NULL, "Failed to parse rule");
+  ASSERT(cd->indicators == NULL, "Indicators should not be computed");
+  ASSERT(count_mismatches(arena, rule, cd) == 0, "NULL indicator map should match tree");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_null_and_invalid_rules(void) {
+  printf("Testing compiled NULL and invalid rules...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  SamtraderCodeData *cd = make_code_data(arena, BAR_COUNT);
+
+  ASSERT(samtrader_rule_compile(NULL, NULL, cd) == NULL, "NULL arena should fail");
+  ASSERT(samtrader_rule_compile(arena, NULL, NULL) == NULL, "NULL code data should fail");
+  ASSERT(!samtrader_rule_program_evaluate(NULL, 0), "NULL program should evaluate false");
+
+  SamtraderRuleProgram *null_rule = samtrader_rule_compile(arena, NULL, cd);
+  ASSERT(null_rule != NULL, "NULL rule should compile");
+  ASSERT(!samtrader_rule_program_evaluate(null_rule, 10), "NULL rule should evaluate false");
+
+  /* Lookback 0 and NULL children are rejected by the evaluator, not the compiler */
+  SamtraderOperand close = samtrader_operand_price(SAMTRADER_OPERAND_PRICE_CLOSE);
+  SamtraderOperand zero = samtrader_operand_constant(0.0);
+  SamtraderRule *above = samtrader_rule_create_comparison(arena, SAMTRADER_RULE_ABOVE, close, zero);
+  ASSERT(above != NULL, "Failed to create comparison rule");
+  SamtraderRule bad_temporal = {.type = SAMTRADER_RULE_CONSECUTIVE, .child = above, .lookback = 0};
+  ASSERT(count_mismatches(arena, &bad_temporal, cd) == 0, "Zero lookback should match tree");
+
+  SamtraderRule no_children = {.type = SAMTRADER_RULE_AND, .children = NULL};
+  ASSERT(count_mismatches(arena, &no_children, cd) == 0, "NULL children should match tree");
+
+  SamtraderRule *empty[] = {NULL};
+  SamtraderRule empty_and = {.type = SAMTRADER_RULE_AND, .children = empty};
+  SamtraderRule empty_or = {.type = SAMTRADER_RULE_OR, .children = empty};
+  ASSERT(count_mismatches(arena, &empty_and, cd) == 0, "Empty AND should match tree");
+  ASSERT(count_mismatches(arena, &empty_or, cd) == 0, "Empty OR should match tree");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_strategy_compile(void) {
+  printf("Testing strategy compilation...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  SamtraderCodeData *cd = make_code_data(arena, BAR_COUNT);
+  SamtraderStrategy strategy = {
+      .entry_long = samtrader_rule_parse(arena, "CROSS_ABOVE(close, SMA(10))"),
+      .exit_long = samtrader_rule_parse(arena, "CROSS_BELOW(close, SMA(10))"),
+      .entry_short = NULL,
+      .exit_short = samtrader_rule_parse(arena, "ABOVE(close, EMA(5))"),
+  };
+  ASSERT(samtrader_code_data_compute_indicators(arena, cd, &strategy) == 0,
+         "Failed to compute indicators");
+
+  SamtraderStrategyProgram programs;
+  ASSERT(samtrader_strategy_compile(arena, &strategy, cd, &programs) == 0,
+         "Strategy compile should succeed");
+  ASSERT(programs.entry_long != NULL, "entry_long should be compiled");
+  ASSERT(programs.exit_long != NULL, "exit_long should be compiled");
+  ASSERT(programs.entry_short == NULL, "entry_short should stay NULL");
+  ASSERT(programs.exit_short != NULL, "exit_short should be compiled");
+
+  SamrenaVector *rows = samtrader_ohlcv_from_bar_columns(arena, cd->bars);
+  for (size_t i = 0; i < BAR_COUNT; i++) {
+    ASSERT(samtrader_rule_program_evaluate(programs.entry_long, i) ==
+               samtrader_rule_evaluate(strategy.entry_long, rows, cd->indicators, i),
+           "entry_long program should match tree");
+    ASSERT(samtrader_rule_program_evaluate(programs.exit_short, i) ==
+               samtrader_rule_evaluate(strategy.exit_short, rows, cd->indicators, i),
+           "exit_short program should match tree");
+    ASSERT(samtrader_rule_signals_test(&programs.entry_long_signals, i) ==
+               samtrader_rule_program_evaluate(programs.entry_long, i),
+           "entry_long signals should match program");
+    ASSERT(samtrader_rule_signals_test(&programs.exit_long_signals, i) ==
+               samtrader_rule_program_evaluate(programs.exit_long, i),
+           "exit_long signals should match program");
+    ASSERT(!samtrader_rule_signals_test(&programs.entry_short_signals, i),
+           "Absent entry_short should never signal");
+  }
+
+  ASSERT(samtrader_strategy_compile(arena, NULL, cd, &programs) == -1,
+         "NULL strategy should fail");
+  ASSERT(samtrader_strategy_compile(arena, &strategy, cd, NULL) == -1, "NULL output should fail");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_shared_subrules(void) {
+  printf("Testing common subrules compile once...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+  SamtraderCodeData *cd = make_code_data(arena, BAR_COUNT);
+
+  /* Within one rule: the repeated comparison is one instruction under the AND */
+  SamtraderRule *repeated =
+      samtrader_rule_parse(arena, "AND(ABOVE(close, SMA(5)), OR(ABOVE(close, SMA(5)), "
+                                  "NOT(ABOVE(close, SMA(5)))))");
+  ASSERT(repeated != NULL, "Failed to parse rule");
+  SamtraderStrategy single = {.entry_long = repeated, .exit_long = repeated};
+  ASSERT(samtrader_code_data_compute_indicators(arena, cd, &single) == 0,
+         "Failed to compute indicators");
+  SamtraderRuleProgram *program = samtrader_rule_compile(arena, repeated, cd);
+  ASSERT(samtrader_rule_program_size(program) == 4, "Repeated comparison should be shared");
+  ASSERT(count_mismatches(arena, repeated, cd) == 0, "Shared rule diverged from tree");
+
+  /* Across rules: entry and exit share the crossover and the trend filter */
+  SamtraderStrategy strategy = {
+      .entry_long = samtrader_rule_parse(
+          arena, "AND(CROSS_ABOVE(SMA(5), SMA(20)), ABOVE(close, EMA(10)))"),
+      .exit_long = samtrader_rule_parse(
+          arena, "OR(CROSS_BELOW(SMA(5), SMA(20)), NOT(ABOVE(close, EMA(10))))"),
+      .entry_short = samtrader_rule_parse(
+          arena, "AND(CROSS_BELOW(SMA(5), SMA(20)), NOT(ABOVE(close, EMA(10))))"),
+      .exit_short = samtrader_rule_parse(arena, "CROSS_ABOVE(SMA(5), SMA(20))"),
+  };
+  ASSERT(samtrader_code_data_compute_indicators(arena, cd, &strategy) == 0,
+         "Failed to compute indicators");
+
+  SamtraderStrategyProgram programs;
+  ASSERT(samtrader_strategy_compile(arena, &strategy, cd, &programs) == 0,
+         "Strategy compile should succeed");
+  /* CROSS_ABOVE, ABOVE, AND, CROSS_BELOW, NOT, OR, AND: exit_short adds nothing */
+  ASSERT(samtrader_rule_program_size(programs.entry_long) == 7,
+         "Strategy rules should share subrules");
+  ASSERT(samtrader_rule_program_size(programs.exit_short) == 7, "Programs share one table");
+
+  const SamtraderRule *rules[] = {strategy.entry_long, strategy.exit_long, strategy.entry_short,
+                                  strategy.exit_short};
+  const SamtraderRuleProgram *compiled[] = {programs.entry_long, programs.exit_long,
+                                            programs.entry_short, programs.exit_short};
+  const SamtraderRuleSignals *signals[] = {&programs.entry_long_signals,
+                                           &programs.exit_long_signals,
+                                           &programs.entry_short_signals,
+                                           &programs.exit_short_signals};
+  SamrenaVector *rows = samtrader_ohlcv_from_bar_columns(arena, cd->bars);
+  for (size_t r = 0; r < 4; r++) {
+    for (size_t i = 0; i < BAR_COUNT; i++) {
+      bool expected = samtrader_rule_evaluate(rules[r], rows, cd->indicators, i);
+      ASSERT(samtrader_rule_program_evaluate(compiled[r], i) == expected,
+             "Shared program should match tree");
+      ASSERT(samtrader_rule_signals_test(signals[r], i) == expected,
+             "Shared signals should match tree");
+    }
+  }
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+int main(void) {
+  printf("=== Rule Program Tests ===\n\n");
+
+  int failures = 0;
+
+  failures += test_comparison_rules();
+  failures += test_multi_value_indicators();
+  failures += test_unparsed_indicator_operands();
+  failures += test_composite_and_temporal_rules();
+  failures += test_rules_fire();
+  failures += test_signals_word_boundaries();
+
+  failures += test_missing_indicator();
+  failures += test_null_indicator_map();
+  failures += test_null_and_invalid_rules();
+  failures += test_strategy_compile();
+  failures += test_shared_subrules();
+
+  printf("\n=== Results: %d failures ===\n", failures);
+
+  return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
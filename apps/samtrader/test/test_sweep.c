@@ -0,0 +1,365 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <samdata/samhashmap.h>
+#include <samrena.h>
+#include <samvector.h>
+
+#include "samtrader/adapters/csv_export_adapter.h"
+#include "samtrader/domain/backtest.h"
+#include "samtrader/domain/code_data.h"
+#include "samtrader/domain/metrics.h"
+#include "samtrader/domain/ohlcv.h"
+#include "samtrader/domain/rule.h"
+#include "samtrader/domain/rule_program.h"
+#include "samtrader/domain/strategy.h"
+#include "samtrader/domain/sweep.h"
+#include "samtrader/domain/worker_pool.h"
+
+#define ASSERT(cond, msg)                                                                          \
+  do {                                                                                             \
+    if (!(cond)) {                                                                                 \
+      printf("FAIL: %s\n", msg);                                                                   \
+      return 1;                                                                                    \
+    }                                                                                              \
+  } while (0)
+
+#define BASE_DATE 1704067200
+#define DAY_SECONDS 86400
+#define BAR_COUNT 250
+#define TWO_PI 6.283185307179586
+
+/*============================================================================
+ * Test Helpers
+ *============================================================================*/
+
+/**
+ * Build code data cycling every `period` bars, starting offset_days after
+ * BASE_DATE. Codes with different periods favour different SMA pairs, and
+ * their staggered calendars leave dates where some codes have no bar.
+ */
+static SamtraderCodeData *make_code_data(Samrena *arena, const char *code, double period,
+                                         size_t offset_days) {
+  SamtraderCodeData *cd = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderCodeData);
+  SamtraderBarColumns *bars = samtrader_bar_columns_create(arena, code, "US", BAR_COUNT);
+  for (size_t i = 0; i < BAR_COUNT; i++) {
+    double close = 100.0 + 10.0 * sin((double)i * TWO_PI / period) + (double)i * 0.02;
+    bars->date[i] = BASE_DATE + (time_t)((i + offset_days) * DAY_SECONDS);
+    bars->open[i] = close - 0.5;
+    bars->high[i] = close + 1.5;
+    bars->low[i] = close - 2.0;
+    bars->close[i] = close;
+    bars->volume[i] = 10000;
+  }
+  cd->code = bars->code;
+  cd->exchange = bars->exchange;
+  cd->bars = bars;
+  cd->bar_count = BAR_COUNT;
+  return cd;
+}
+
+/** Expand and parse the two template rules for one variant, with a 5% stop loss. */
+static int make_variant(Samrena *arena, const SamtraderSweepGrid *grid, const char *entry,
+                        const char *exit_rule, size_t variant, SamtraderStrategy *out) {
+  const char *entry_text = samtrader_sweep_expand(arena, grid, entry, variant);
+  const char *exit_text = samtrader_sweep_expand(arena, grid, exit_rule, variant);
+  if (!entry_text || !exit_text)
+    return -1;
+  memset(out, 0, sizeof(*out));
+  out->name = "Sweep";
+  out->entry_long = samtrader_rule_parse(arena, entry_text);
+  out->exit_long = samtrader_rule_parse(arena, exit_text);
+  out->position_size = 0.5;
+  out->stop_loss_pct = 5.0;
+  out->max_positions = 2;
+  return out->entry_long && out->exit_long ? 0 : -1;
+}
+
+/*============================================================================
+ * Template Tests
+ *============================================================================*/
+
+static int test_grid_single_param(void) {
+  printf("Testing single parameter grid...\n");
+  Samrena *arena = samrena_create_default();
+
+  SamtraderSweepGrid grid;
+  samtrader_sweep_grid_init(&grid);
+  ASSERT(grid.variant_count == 1, "Empty grid has one variant");
+  ASSERT(samtrader_sweep_grid_scan(&grid, "CROSS_ABOVE(SMA(${fast=5..50:5}), SMA(60))") == 0,
+         "Scan should succeed");
+  ASSERT(grid.param_count == 1, "One parameter");
+  ASSERT(strcmp(grid.params[0].name, "fast") == 0, "Parameter name");
+  ASSERT(grid.params[0].count == 10, "5..50:5 has 10 values");
+  ASSERT(grid.variant_count == 10, "10 variants");
+
+  char *text = samtrader_sweep_expand(arena, &grid, "CROSS_ABOVE(SMA(${fast=5..50:5}), SMA(60))",
+                                      3);
+  ASSERT(text && strcmp(text, "CROSS_ABOVE(SMA(20), SMA(60))") == 0, "Variant 3 is fast=20");
+
+  text = samtrader_sweep_expand(arena, &grid, "no placeholders", 0);
+  ASSERT(text && strcmp(text, "no placeholders") == 0, "Plain text is copied");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_grid_multi_param_and_references(void) {
+  printf("Testing multi-parameter grid with references...\n");
+  Samrena *arena = samrena_create_default();
+
+  const char *entry = "CROSS_ABOVE(SMA(${fast=5..15:5}), SMA(${slow=20..40:10}))";
+  const char *exit_rule = "CROSS_BELOW(SMA(${fast}), SMA(${ slow }))";
+
+  SamtraderSweepGrid grid;
+  samtrader_sweep_grid_init(&grid);
+  ASSERT(samtrader_sweep_grid_scan(&grid, entry) == 0, "Scan entry");
+  ASSERT(samtrader_sweep_grid_scan(&grid, exit_rule) == 0, "Scan exit (references only)");
+  ASSERT(samtrader_sweep_grid_scan(&grid, NULL) == 0, "NULL text is ignored");
+  ASSERT(grid.param_count == 2, "Two parameters");
+  ASSERT(grid.variant_count == 9, "3 x 3 variants");
+
+  /* Last parameter varies fastest: variant 4 = (fast[1], slow[1]) */
+  double values[SAMTRADER_SWEEP_MAX_PARAMS];
+  ASSERT(samtrader_sweep_variant_values(&grid, 4, values) == 0, "Decode variant 4");
+  ASSERT(values[0] == 10.0 && values[1] == 30.0, "Variant 4 is fast=10 slow=30");
+  ASSERT(samtrader_sweep_variant_values(&grid, 2, values) == 0, "Decode variant 2");
+  ASSERT(values[0] == 5.0 && values[1] == 40.0, "Variant 2 is fast=5 slow=40");
+  ASSERT(samtrader_sweep_variant_values(&grid, 9, values) == -1, "Variant 9 out of range");
+
+  char *text = samtrader_sweep_expand(arena, &grid, exit_rule, 4);
+  ASSERT(text && strcmp(text, "CROSS_BELOW(SMA(10), SMA(30))") == 0, "References expand");
+
+  /* Same definition twice is allowed */
+  ASSERT(samtrader_sweep_grid_scan(&grid, "${fast=5..15:5}") == 0, "Identical redefinition");
+  ASSERT(grid.param_count == 2 && grid.variant_count == 9, "Redefinition adds nothing");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_grid_fractional_and_default_step(void) {
+  printf("Testing fractional and default steps...\n");
+  Samrena *arena = samrena_create_default();
+
+  SamtraderSweepGrid grid;
+  samtrader_sweep_grid_init(&grid);
+  ASSERT(samtrader_sweep_grid_scan(&grid, "ABOVE(RSI(14), ${level=0.1..0.3:0.1})") == 0,
+         "Fractional scan");
+  ASSERT(grid.params[0].count == 3, "0.1..0.3:0.1 has 3 values despite rounding");
+  ASSERT(samtrader_sweep_grid_scan(&grid, "SMA(${p=10..13})") == 0, "Default step scan");
+  ASSERT(grid.params[1].count == 4, "10..13 has 4 values");
+  ASSERT(grid.variant_count == 12, "3 x 4 variants");
+
+  char *text = samtrader_sweep_expand(arena, &grid, "${level} ${p}", 11);
+  ASSERT(text && strcmp(text, "0.3 13") == 0, "Last variant expands to range ends");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_grid_errors(void) {
+  printf("Testing grid errors...\n");
+  Samrena *arena = samrena_create_default();
+  SamtraderSweepGrid grid;
+
+  const char *bad[] = {"SMA(${fast=5..50:5)",  "SMA(${fast=50..5})",  "SMA(${fast=5..50:0})",
+                       "SMA(${fast=5..50:-1})", "SMA(${=5..50})",      "SMA(${fast=5})",
+                       "SMA(${fast=x..50})",    "SMA(${fast 5..50})", "SMA(${fast=5..50:5"};
+  for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+    samtrader_sweep_grid_init(&grid);
+    ASSERT(samtrader_sweep_grid_scan(&grid, bad[i]) == -1, "Malformed definition rejected");
+  }
+
+  /* Conflicting redefinition */
+  samtrader_sweep_grid_init(&grid);
+  ASSERT(samtrader_sweep_grid_scan(&grid, "${a=1..3}") == 0, "First definition");
+  ASSERT(samtrader_sweep_grid_scan(&grid, "${a=1..4}") == -1, "Conflicting definition rejected");
+
+  /* Unknown reference fails at expansion */
+  ASSERT(samtrader_sweep_grid_scan(&grid, "${b}") == 0, "References are not checked at scan");
+  ASSERT(samtrader_sweep_expand(arena, &grid, "${b}", 0) == NULL, "Unknown reference");
+  ASSERT(samtrader_sweep_expand(arena, &grid, "${a", 0) == NULL, "Unterminated placeholder");
+  ASSERT(samtrader_sweep_expand(arena, &grid, "${a}", 3) == NULL, "Variant out of range");
+
+  /* Variant limit */
+  samtrader_sweep_grid_init(&grid);
+  ASSERT(samtrader_sweep_grid_scan(&grid, "${a=1..1000} ${b=1..1000}") == 0, "1e6 variants ok");
+  ASSERT(samtrader_sweep_grid_scan(&grid, "${c=1..2}") == -1, "Beyond variant limit rejected");
+
+  ASSERT(samtrader_sweep_grid_scan(NULL, "x") == -1, "NULL grid");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+/*============================================================================
+ * Sweep Execution Tests
+ *============================================================================*/
+
+static int test_sweep_run_matches_serial(void) {
+  printf("Testing parallel sweep matches serial backtests...\n");
+  Samrena *arena = samrena_create_default();
+
+  const char *entry = "CROSS_ABOVE(SMA(${fast=3..9:3}), SMA(${slow=15..25:5}))";
+  const char *exit_rule = "CROSS_BELOW(SMA(${fast}), SMA(${slow}))";
+  SamtraderSweepGrid grid;
+  samtrader_sweep_grid_init(&grid);
+  ASSERT(samtrader_sweep_grid_scan(&grid, entry) == 0, "Scan entry");
+  ASSERT(samtrader_sweep_grid_scan(&grid, exit_rule) == 0, "Scan exit");
+  ASSERT(grid.variant_count == 9, "9 variants");
+
+  SamtraderStrategy strategies[9];
+  for (size_t v = 0; v < grid.variant_count; v++)
+    ASSERT(make_variant(arena, &grid, entry, exit_rule, v, &strategies[v]) == 0, "Variant");
+
+  SamtraderCodeData *code_data[3] = {make_code_data(arena, "AAA", 42.0, 0),
+                                     make_code_data(arena, "BBB", 24.0, 5),
+                                     make_code_data(arena, "CCC", 60.0, 11)};
+  SamtraderWorkerPool *indicator_pool = samtrader_worker_pool_create(2);
+  SamtraderWorkerPool *sim_pool = samtrader_worker_pool_create(4);
+  ASSERT(indicator_pool && sim_pool, "Create pools");
+  ASSERT(samtrader_code_data_compute_indicators_parallel(indicator_pool, code_data, 3, strategies,
+                                                         grid.variant_count, NULL) == 0,
+         "Compute union of indicators");
+
+  /* fast in {3,6,9} and slow in {15,20,25}: six distinct series shared by nine variants */
+  ASSERT(samhashmap_size(code_data[0]->indicators) == 6, "Indicator series are deduplicated");
+
+  SamtraderTimeline *timeline = samtrader_timeline_build(arena, code_data, 3);
+  ASSERT(timeline != NULL, "Build timeline");
+
+  SamtraderBacktestConfig config = {.initial_capital = 100000.0,
+                                    .commission_per_trade = 5.0,
+                                    .commission_pct = 0.1,
+                                    .slippage_pct = 0.05};
+  SamtraderMetrics results[9];
+  SamtraderSweepRun run = {.strategies = strategies,
+                           .strategy_count = grid.variant_count,
+                           .code_data = code_data,
+                           .timeline = timeline,
+                           .config = &config,
+                           .risk_free_rate = 0.05};
+  ASSERT(samtrader_sweep_run(sim_pool, &run, results) == 0, "Sweep should succeed");
+
+  int total_trades = 0;
+  for (size_t v = 0; v < grid.variant_count; v++) {
+    SamtraderStrategyProgram programs[3];
+    for (size_t c = 0; c < 3; c++)
+      ASSERT(samtrader_strategy_compile(arena, &strategies[v], code_data[c], &programs[c]) == 0,
+             "Compile variant");
+    SamtraderPortfolio *portfolio =
+        samtrader_backtest_run(arena, &config, &strategies[v], code_data, programs, timeline);
+    ASSERT(portfolio != NULL, "Serial backtest");
+    SamtraderMetrics *expected = samtrader_metrics_calculate(arena, portfolio->closed_trades,
+                                                             portfolio->equity_curve, 0.05);
+    ASSERT(expected != NULL, "Serial metrics");
+    ASSERT(memcmp(expected, &results[v], sizeof(SamtraderMetrics)) == 0,
+           "Parallel variant metrics match serial run");
+    total_trades += results[v].total_trades;
+  }
+  ASSERT(total_trades > 0, "Sweep should produce trades");
+  size_t distinct = 0;
+  for (size_t v = 0; v < grid.variant_count; v++) {
+    size_t u = 0;
+    while (u < v && results[u].total_return != results[v].total_return)
+      u++;
+    distinct += u == v;
+  }
+  ASSERT(distinct > grid.variant_count / 2, "Variants should trade differently");
+
+  ASSERT(samtrader_sweep_run(NULL, &run, results) == -1, "NULL pool");
+  ASSERT(samtrader_sweep_run(sim_pool, NULL, results) == -1, "NULL run");
+
+  samtrader_worker_pool_destroy(sim_pool);
+  samtrader_worker_pool_destroy(indicator_pool);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_sweep_write_csv(void) {
+  printf("Testing sweep CSV output...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Create arena");
+  SamtraderExportPort *export = samtrader_csv_export_adapter_create(arena);
+  ASSERT(export != NULL, "Create CSV export adapter");
+
+  SamtraderSweepGrid grid;
+  samtrader_sweep_grid_init(&grid);
+  ASSERT(samtrader_sweep_grid_scan(&grid, "${fast=5..10:5} ${level=0.5..1.0:0.5}") == 0,
+         "Scan");
+  SamtraderMetrics results[4];
+  memset(results, 0, sizeof(results));
+  results[3].total_trades = 7;
+  results[3].sharpe_ratio = 1.25;
+
+  const char *path = "/tmp/samtrader_test_sweep.csv";
+  ASSERT(export->write_sweep(export, path, &grid, results), "Write CSV");
+
+  FILE *fp = fopen(path, "r");
+  ASSERT(fp != NULL, "Open CSV");
+  char line[1024];
+  ASSERT(fgets(line, sizeof(line), fp) != NULL, "Header line");
+  ASSERT(strncmp(line, "variant,fast,level,total_return,", 32) == 0, "Header columns");
+  int rows = 0;
+  char last[1024] = {0};
+  while (fgets(line, sizeof(line), fp)) {
+    rows++;
+    strcpy(last, line);
+  }
+  fclose(fp);
+  remove(path);
+  ASSERT(rows == 4, "One row per variant");
+  ASSERT(strncmp(last, "3,10,1,0,0,1.25,", 16) == 0, "Last row holds params and metrics");
+
+  ASSERT(!export->write_sweep(export, "/nonexistent-dir/out.csv", &grid, results),
+         "Unwritable path fails");
+  ASSERT(!export->write_sweep(export, NULL, &grid, results), "NULL path fails");
+
+  export->close(export);
+  samrena_destroy(arena);
+
+  printf("  PASS\n");
+  return 0;
+}
+
+int main(void) {
+  printf("=== Parameter Sweep Tests ===\n\n");
+
+  int failures = 0;
+
+  failures += test_grid_single_param();
+  failures += test_grid_multi_param_and_references();
+  failures += test_grid_fractional_and_default_step();
+  failures += test_grid_errors();
+  failures += test_sweep_run_matches_serial();
+  failures += test_sweep_write_csv();
+
+  printf("\n=== Results: %d failures ===\n", failures);
+
+  return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "samtrader/domain/symbol_table.h"
+
+#define ASSERT(cond, msg)                                                                          \
+  do {                                                                                             \
+    if (!(cond)) {                                                                                 \
+      printf("FAIL: %s\n", msg);                                                                   \
+      return 1;                                                                                    \
+    }                                                                                              \
+  } while (0)
+
+static int test_intern_assigns_dense_ids(void) {
+  printf("Testing samtrader_symbol_intern dense ids...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  SamtraderSymbolTable *table = samtrader_symbol_table_create(arena, 2);
+  ASSERT(table != NULL, "Failed to create table");
+  ASSERT(samtrader_symbol_table_count(table) == 0, "New table should be empty");
+
+  ASSERT(samtrader_symbol_intern(table, "AAPL") == 1, "First symbol gets id 1");
+  ASSERT(samtrader_symbol_intern(table, "BHP") == 2, "Second symbol gets id 2");
+  ASSERT(samtrader_symbol_intern(table, "AAPL") == 1, "Re-interning returns the same id");
+
+  /* Grow past the initial capacity */
+  char name[16];
+  for (int i = 0; i < 100; i++) {
+    snprintf(name, sizeof(name), "SYM%d", i);
+    ASSERT(samtrader_symbol_intern(table, name) == (SamtraderSymbolId)(i + 3),
+           "Ids stay dense past capacity");
+  }
+  ASSERT(samtrader_symbol_table_count(table) == 102, "Count should be 102");
+  ASSERT(strcmp(samtrader_symbol_name(table, 52), "SYM49") == 0, "Name of id 52");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_intern_copies_name(void) {
+  printf("Testing samtrader_symbol_intern copies names...\n");
+
+  Samrena *arena = samrena_create_default();
+  SamtraderSymbolTable *table = samtrader_symbol_table_create(arena, 4);
+
+  char buf[8] = "CBA";
+  SamtraderSymbolId id = samtrader_symbol_intern(table, buf);
+  strcpy(buf, "XXX");
+
+  const char *name = samtrader_symbol_name(table, id);
+  ASSERT(name != NULL && strcmp(name, "CBA") == 0, "Interned name should be a copy");
+  ASSERT(name != buf, "Interned name should not alias the caller's buffer");
+  ASSERT(samtrader_symbol_find(table, "CBA") == id, "Find by original name");
+  ASSERT(samtrader_symbol_find(table, "XXX") == SAMTRADER_SYMBOL_NONE, "Buffer edit not interned");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_find_does_not_intern(void) {
+  printf("Testing samtrader_symbol_find...\n");
+
+  Samrena *arena = samrena_create_default();
+  SamtraderSymbolTable *table = samtrader_symbol_table_create(arena, 4);
+
+  ASSERT(samtrader_symbol_find(table, "AAPL") == SAMTRADER_SYMBOL_NONE, "Unknown symbol");
+  ASSERT(samtrader_symbol_table_count(table) == 0, "Find should not intern");
+  SamtraderSymbolId id = samtrader_symbol_intern(table, "AAPL");
+  ASSERT(samtrader_symbol_find(table, "AAPL") == id, "Find after intern");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_null_and_unknown(void) {
+  printf("Testing symbol table null and unknown ids...\n");
+
+  Samrena *arena = samrena_create_default();
+  SamtraderSymbolTable *table = samtrader_symbol_table_create(arena, 4);
+  samtrader_symbol_intern(table, "AAPL");
+
+  ASSERT(samtrader_symbol_table_create(NULL, 4) == NULL, "NULL arena should fail");
+  ASSERT(samtrader_symbol_intern(NULL, "AAPL") == SAMTRADER_SYMBOL_NONE, "NULL table intern");
+  ASSERT(samtrader_symbol_intern(table, NULL) == SAMTRADER_SYMBOL_NONE, "NULL name intern");
+  ASSERT(samtrader_symbol_find(NULL, "AAPL") == SAMTRADER_SYMBOL_NONE, "NULL table find");
+  ASSERT(samtrader_symbol_name(table, SAMTRADER_SYMBOL_NONE) == NULL, "None id has no name");
+  ASSERT(samtrader_symbol_name(table, 2) == NULL, "Out-of-range id has no name");
+  ASSERT(samtrader_symbol_name(NULL, 1) == NULL, "NULL table name");
+  ASSERT(samtrader_symbol_table_count(NULL) == 0, "NULL table count");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+int main(void) {
+  printf("=== Symbol Table Tests ===\n\n");
+
+  int failures = 0;
+
+  failures += test_intern_assigns_dense_ids();
+  failures += test_intern_copies_name();
+  failures += test_find_does_not_intern();
+  failures += test_null_and_unknown();
+
+  printf("\n=== Results: %d failures ===\n", failures);
+
+  return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
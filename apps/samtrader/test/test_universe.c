@@ -92,6 +92,32 @@ static SamrenaVector *mock_fetch_ohlcv(SamtraderDataPort *port, const char *code
   return NULL;
 }
 
+static int mock_fetch_calls = 0;
+
+static int mock_fetch_summary(SamtraderDataPort *port, const char *code, const char *exchange,
+                              time_t start_date, time_t end_date, SamtraderOhlcvSummary *out) {
+  (void)exchange;
+  (void)start_date;
+  (void)end_date;
+
+  MockDataPortImpl *impl = (MockDataPortImpl *)port->impl;
+  memset(out, 0, sizeof(*out));
+  for (size_t i = 0; i < impl->num_codes; i++) {
+    if (strcmp(impl->codes[i], code) == 0) {
+      out->bar_count = impl->bar_counts[i];
+      return 0;
+    }
+  }
+  return 0;
+}
+
+static SamrenaVector *mock_fetch_ohlcv_counted(SamtraderDataPort *port, const char *code,
+                                               const char *exchange, time_t start_date,
+                                               time_t end_date) {
+  mock_fetch_calls++;
+  return mock_fetch_ohlcv(port, code, exchange, start_date, end_date);
+}
+
 static void mock_close(SamtraderDataPort *port) { (void)port; }
 
 static SamtraderDataPort *create_mock_port(Samrena *arena, const char **codes, size_t *bar_counts,
@@ -385,6 +411,32 @@ static int test_validate_null_params(void) {
   return 0;
 }
 
+static int test_validate_uses_summary(void) {
+  printf("Testing universe validate uses count-only summary...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Failed to create arena");
+
+  SamtraderUniverse *u = samtrader_universe_parse(arena, "CBA,BHP,WBC", "AU");
+  ASSERT(u != NULL, "Parse failed");
+
+  const char *mock_codes[] = {"CBA", "BHP", "WBC"};
+  size_t mock_bars[] = {50, 10, 40};
+  SamtraderDataPort *port = create_mock_port(arena, mock_codes, mock_bars, 3);
+  port->fetch_ohlcv = mock_fetch_ohlcv_counted;
+  port->fetch_summary = mock_fetch_summary;
+
+  mock_fetch_calls = 0;
+  int result = samtrader_universe_validate(u, port, 1704067200, 1709337600);
+  ASSERT(result == 2, "2 codes should be valid");
+  ASSERT(strcmp(u->codes[1], "WBC") == 0, "BHP should be removed");
+  ASSERT(mock_fetch_calls == 0, "No bars should be fetched");
+
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
 /* =========================== Main =========================== */
 
 int main(void) {
@@ -411,6 +463,7 @@ int main(void) {
   failures += test_validate_all_insufficient();
   failures += test_validate_null_fetch();
   failures += test_validate_null_params();
+  failures += test_validate_uses_summary();
 
   printf("\n=== Results: %d failures ===\n", failures);
 
@@ -0,0 +1,415 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <samrena.h>
+#include <samvector.h>
+
+#include "samtrader/adapters/csv_export_adapter.h"
+#include "samtrader/domain/backtest.h"
+#include "samtrader/domain/code_data.h"
+#include "samtrader/domain/metrics.h"
+#include "samtrader/domain/ohlcv.h"
+#include "samtrader/domain/portfolio.h"
+#include "samtrader/domain/rule.h"
+#include "samtrader/domain/rule_program.h"
+#include "samtrader/domain/strategy.h"
+#include "samtrader/domain/sweep.h"
+#include "samtrader/domain/walkforward.h"
+#include "samtrader/domain/worker_pool.h"
+
+#define ASSERT(cond, msg)                                                                          \
+  do {                                                                                             \
+    if (!(cond)) {                                                                                 \
+      printf("FAIL: %s\n", msg);                                                                   \
+      return 1;                                                                                    \
+    }                                                                                              \
+  } while (0)
+
+#define BASE_DATE 1704067200
+#define DAY_SECONDS 86400
+#define BAR_COUNT 250
+#define VARIANTS 9
+#define REGIME_SHIFT 120
+#define TWO_PI 6.283185307179586
+
+/*============================================================================
+ * Test Helpers
+ *============================================================================*/
+
+/**
+ * Build code data with two regimes. Until REGIME_SHIFT a 60-bar cycle
+ * carries a 5-bar ripple that whipsaws the fastest SMA pairs; after it a
+ * clean 16-bar cycle leaves the slow pairs lagging. The pair with the best
+ * in-sample Sharpe ratio therefore changes from window to window.
+ */
+static SamtraderCodeData *make_code_data(Samrena *arena, const char *code, size_t offset_days) {
+  SamtraderCodeData *cd = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderCodeData);
+  SamtraderBarColumns *bars = samtrader_bar_columns_create(arena, code, "US", BAR_COUNT);
+  double phase = 0.0;
+  for (size_t i = 0; i < BAR_COUNT; i++) {
+    bool early = i < REGIME_SHIFT;
+    double ripple = early ? 3.0 * sin((double)i * TWO_PI / 5.0) : 0.0;
+    double close = 100.0 + 8.0 * sin(phase) + ripple + (double)i * 0.02;
+    phase += TWO_PI / (early ? 60.0 : 16.0);
+    bars->date[i] = BASE_DATE + (time_t)((i + offset_days) * DAY_SECONDS);
+    bars->open[i] = close - 0.5;
+    bars->high[i] = close + 1.5;
+    bars->low[i] = close - 2.0;
+    bars->close[i] = close;
+    bars->volume[i] = 10000;
+  }
+  cd->code = bars->code;
+  cd->exchange = bars->exchange;
+  cd->bars = bars;
+  cd->bar_count = BAR_COUNT;
+  return cd;
+}
+
+/**
+ * Expand the two template rules for every grid variant. There is no stop
+ * loss, so exits come from the rules alone and positions are often still
+ * open when an out-of-sample window ends.
+ */
+static int make_strategies(Samrena *arena, const SamtraderSweepGrid *grid, const char *entry,
+                           const char *exit_rule, SamtraderStrategy *out) {
+  for (size_t v = 0; v < grid->variant_count; v++) {
+    const char *entry_text = samtrader_sweep_expand(arena, grid, entry, v);
+    const char *exit_text = samtrader_sweep_expand(arena, grid, exit_rule, v);
+    if (!entry_text || !exit_text)
+      return -1;
+    out[v] = (SamtraderStrategy){.name = "WalkForward",
+                                 .entry_long = samtrader_rule_parse(arena, entry_text),
+                                 .exit_long = samtrader_rule_parse(arena, exit_text),
+                                 .position_size = 0.5,
+                                 .max_positions = 2};
+    if (!out[v].entry_long || !out[v].exit_long)
+      return -1;
+  }
+  return 0;
+}
+
+/** Serial backtest of one strategy over a timeline view. */
+static SamtraderPortfolio *run_serial(Samrena *arena, const SamtraderBacktestConfig *config,
+                                      const SamtraderStrategy *strategy,
+                                      SamtraderCodeData *const *code_data,
+                                      const SamtraderTimeline *view) {
+  SamtraderStrategyProgram programs[3];
+  for (size_t c = 0; c < 3; c++) {
+    if (samtrader_strategy_compile(arena, strategy, code_data[c], &programs[c]) < 0)
+      return NULL;
+  }
+  return samtrader_backtest_run(arena, config, strategy, code_data, programs, view);
+}
+
+/** Sum of the realised PnL of a vector of SamtraderClosedTrade. */
+static double trade_pnl(const SamrenaVector *trades) {
+  double total = 0.0;
+  for (size_t i = 0; i < samrena_vector_size(trades); i++)
+    total += ((const SamtraderClosedTrade *)samrena_vector_at_const(trades, i))->pnl;
+  return total;
+}
+
+/*============================================================================
+ * Tests
+ *============================================================================*/
+
+static int test_window_count(void) {
+  printf("Testing samtrader_walkforward_window_count...\n");
+
+  SamtraderWalkForwardConfig wf = {.in_sample = 100, .out_of_sample = 40};
+  ASSERT(samtrader_walkforward_window_count(&wf, 250) == 4, "150 tested dates make 4 windows");
+  ASSERT(samtrader_walkforward_window_count(&wf, 260) == 4, "Exact fit makes 4 windows");
+  ASSERT(samtrader_walkforward_window_count(&wf, 101) == 1, "One tested date makes 1 window");
+  ASSERT(samtrader_walkforward_window_count(&wf, 100) == 0, "No tested dates");
+
+  SamtraderWalkForwardConfig bad = {.in_sample = 0, .out_of_sample = 40};
+  ASSERT(samtrader_walkforward_window_count(&bad, 250) == 0, "Zero in-sample is invalid");
+  bad = (SamtraderWalkForwardConfig){.in_sample = 100, .out_of_sample = 0};
+  ASSERT(samtrader_walkforward_window_count(&bad, 250) == 0, "Zero out-of-sample is invalid");
+  ASSERT(samtrader_walkforward_window_count(NULL, 250) == 0, "NULL config");
+
+  printf("  PASS\n");
+  return 0;
+}
+
+static int check_walkforward(bool anchored) {
+  Samrena *arena = samrena_create_default();
+
+  const char *entry = "CROSS_ABOVE(SMA(${fast=3..9:3}), SMA(${slow=15..25:5}))";
+  const char *exit_rule = "CROSS_BELOW(SMA(${fast}), SMA(${slow}))";
+  SamtraderSweepGrid grid;
+  samtrader_sweep_grid_init(&grid);
+  ASSERT(samtrader_sweep_grid_scan(&grid, entry) == 0, "Scan entry");
+  ASSERT(samtrader_sweep_grid_scan(&grid, exit_rule) == 0, "Scan exit");
+  ASSERT(grid.variant_count == VARIANTS, "9 variants");
+
+  SamtraderStrategy strategies[VARIANTS];
+  ASSERT(make_strategies(arena, &grid, entry, exit_rule, strategies) == 0, "Variants");
+
+  SamtraderCodeData *code_data[3] = {make_code_data(arena, "AAA", 0),
+                                     make_code_data(arena, "BBB", 5),
+                                     make_code_data(arena, "CCC", 11)};
+  SamtraderWorkerPool *indicator_pool = samtrader_worker_pool_create(2);
+  SamtraderWorkerPool *pool = samtrader_worker_pool_create(4);
+  ASSERT(indicator_pool && pool, "Create pools");
+  ASSERT(samtrader_code_data_compute_indicators_parallel(indicator_pool, code_data, 3, strategies,
+                                                         VARIANTS, NULL) == 0,
+         "Compute indicators once over the full history");
+  SamtraderTimeline *timeline = samtrader_timeline_build(arena, code_data, 3);
+  ASSERT(timeline != NULL, "Build timeline");
+
+  SamtraderBacktestConfig config = {.initial_capital = 100000.0,
+                                    .commission_per_trade = 5.0,
+                                    .commission_pct = 0.1,
+                                    .slippage_pct = 0.05};
+  SamtraderSweepRun run = {.strategies = strategies,
+                           .strategy_count = VARIANTS,
+                           .code_data = code_data,
+                           .timeline = timeline,
+                           .config = &config,
+                           .risk_free_rate = 0.05};
+  SamtraderWalkForwardConfig wf = {.in_sample = 80, .out_of_sample = 50, .anchored = anchored};
+  SamtraderWalkForwardResult *result = samtrader_walkforward_run(arena, pool, &run, &wf);
+  ASSERT(result != NULL, "Walk-forward should succeed");
+
+  size_t expected_windows = samtrader_walkforward_window_count(&wf, timeline->date_count);
+  ASSERT(result->window_count == expected_windows, "Window count");
+  ASSERT(samrena_vector_size(result->equity_curve) == timeline->date_count - wf.in_sample,
+         "Stitched curve covers every out-of-sample date once");
+
+  double equity = config.initial_capital;
+  size_t trade_count = 0;
+  int oos_trades = 0;
+  for (size_t w = 0; w < result->window_count; w++) {
+    const SamtraderWalkForwardWindow *win = &result->windows[w];
+    ASSERT(win->out_of_sample_begin == wf.in_sample + w * wf.out_of_sample, "Windows tile");
+    ASSERT(win->in_sample_end == win->out_of_sample_begin, "In-sample precedes out-of-sample");
+    ASSERT(win->in_sample_begin == (anchored ? 0 : win->in_sample_end - wf.in_sample),
+           "In-sample start");
+    ASSERT(win->out_of_sample_end <= timeline->date_count, "Last window ends with the timeline");
+
+    /* The winner is the best serial in-sample Sharpe over every variant */
+    SamtraderTimeline *is_view = samtrader_timeline_window(arena, timeline, win->in_sample_begin,
+                                                           win->in_sample_end);
+    size_t best = 0;
+    double best_sharpe = -INFINITY;
+    for (size_t v = 0; v < VARIANTS; v++) {
+      SamtraderPortfolio *p = run_serial(arena, &config, &strategies[v], code_data, is_view);
+      ASSERT(p != NULL, "Serial in-sample backtest");
+      SamtraderMetrics *m =
+          samtrader_metrics_calculate(arena, p->closed_trades, p->equity_curve, 0.05);
+      ASSERT(m != NULL, "Serial in-sample metrics");
+      if (v == 0 || m->sharpe_ratio > best_sharpe) {
+        best = v;
+        best_sharpe = m->sharpe_ratio;
+      }
+    }
+    ASSERT(win->best_variant == best, "Best in-sample variant");
+    ASSERT(win->in_sample.sharpe_ratio == best_sharpe, "In-sample metrics of the winner");
+
+    /* Out-of-sample continues from the previous window's ending equity */
+    SamtraderBacktestConfig oos_config = config;
+    oos_config.initial_capital = equity;
+    oos_config.close_at_end = true;
+    SamtraderTimeline *oos_view = samtrader_timeline_window(
+        arena, timeline, win->out_of_sample_begin, win->out_of_sample_end);
+    SamtraderPortfolio *p = run_serial(arena, &oos_config, &strategies[best], code_data, oos_view);
+    ASSERT(p != NULL, "Serial out-of-sample backtest");
+    SamtraderMetrics *m =
+        samtrader_metrics_calculate(arena, p->closed_trades, p->equity_curve, 0.05);
+    ASSERT(m != NULL, "Serial out-of-sample metrics");
+    ASSERT(memcmp(m, &win->out_of_sample, sizeof(*m)) == 0, "Out-of-sample metrics match");
+
+    size_t points = samrena_vector_size(p->equity_curve);
+    for (size_t i = 0; i < points; i++) {
+      const SamtraderEquityPoint *want = samrena_vector_at_const(p->equity_curve, i);
+      size_t at = win->out_of_sample_begin - wf.in_sample + i;
+      const SamtraderEquityPoint *got = samrena_vector_at_const(result->equity_curve, at);
+      ASSERT(want->date == got->date && want->equity == got->equity, "Stitched equity point");
+    }
+    equity = ((const SamtraderEquityPoint *)samrena_vector_at_const(p->equity_curve, points - 1))
+                 ->equity;
+    trade_count += samrena_vector_size(p->closed_trades);
+    oos_trades += win->out_of_sample.total_trades;
+  }
+  ASSERT(samrena_vector_size(result->trades) == trade_count, "Every out-of-sample trade kept");
+  ASSERT(oos_trades > 0, "Out-of-sample windows should trade");
+
+  /* The regime change moves the optimum, so selection really is per window */
+  size_t changes = 0;
+  for (size_t w = 1; w < result->window_count; w++)
+    changes += result->windows[w].best_variant != result->windows[w - 1].best_variant;
+  ASSERT(changes > 0, "Best variant changes between windows");
+  ASSERT(fabs(equity - (config.initial_capital + trade_pnl(result->trades))) < 1e-6,
+         "Stitched trades account for the whole equity change");
+
+  /* Trades point at the code data, not at the freed per-window portfolios */
+  for (size_t i = 0; i < trade_count; i++) {
+    const SamtraderClosedTrade *trade = samrena_vector_at_const(result->trades, i);
+    ASSERT(trade->code == code_data[trade->symbol - 1]->code, "Trade code repointed");
+  }
+
+  ASSERT(samtrader_walkforward_run(NULL, pool, &run, &wf) == NULL, "NULL arena");
+  ASSERT(samtrader_walkforward_run(arena, pool, NULL, &wf) == NULL, "NULL run");
+  SamtraderWalkForwardConfig too_long = {.in_sample = BAR_COUNT + 20, .out_of_sample = 10};
+  ASSERT(samtrader_walkforward_run(arena, pool, &run, &too_long) == NULL,
+         "No window fits the timeline");
+
+  /* CSV: one row per window, dates formatted from the timeline */
+  const char *path = "/tmp/samtrader_test_walkforward.csv";
+  SamtraderExportPort *export = samtrader_csv_export_adapter_create(arena);
+  ASSERT(export != NULL, "Create CSV export adapter");
+  ASSERT(export->write_walkforward(export, path, &grid, timeline, result), "Write CSV");
+  FILE *fp = fopen(path, "r");
+  ASSERT(fp != NULL, "Open CSV");
+  char line[1024];
+  ASSERT(fgets(line, sizeof(line), fp) != NULL, "Header line");
+  ASSERT(strncmp(line, "window,in_sample_start,in_sample_end,out_of_sample_start,"
+                       "out_of_sample_end,variant,fast,slow,in_sample_return,",
+                 110) == 0,
+         "Header columns");
+  ASSERT(fgets(line, sizeof(line), fp) != NULL, "First row");
+  ASSERT(strncmp(line, "0,2024-01-01 00:00,", 19) == 0,
+         "First row starts with the first timeline date");
+  size_t rows = 1;
+  while (fgets(line, sizeof(line), fp))
+    rows++;
+  fclose(fp);
+  remove(path);
+  ASSERT(rows == result->window_count, "One row per window");
+  ASSERT(!export->write_walkforward(export, "/nonexistent-dir/out.csv", &grid, timeline, result),
+         "Unwritable path fails");
+  export->close(export);
+
+  samtrader_worker_pool_destroy(pool);
+  samtrader_worker_pool_destroy(indicator_pool);
+  samrena_destroy(arena);
+  return 0;
+}
+
+static int test_walkforward_rolling(void) {
+  printf("Testing rolling walk-forward against serial backtests...\n");
+  if (check_walkforward(false) != 0)
+    return 1;
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_walkforward_anchored(void) {
+  printf("Testing anchored walk-forward against serial backtests...\n");
+  if (check_walkforward(true) != 0)
+    return 1;
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_walkforward_closes_at_boundary(void) {
+  printf("Testing positions open at a window boundary are closed and charged...\n");
+
+  Samrena *arena = samrena_create_default();
+  ASSERT(arena != NULL, "Create arena");
+
+  /* A steady uptrend with an entry that always holds and an exit that never
+   * fires: every out-of-sample window is still long on its last date */
+  SamtraderCodeData *cd = SAMRENA_PUSH_TYPE_ZERO(arena, SamtraderCodeData);
+  SamtraderBarColumns *bars = samtrader_bar_columns_create(arena, "AAA", "US", BAR_COUNT);
+  ASSERT(cd && bars, "Create code data");
+  for (size_t i = 0; i < BAR_COUNT; i++) {
+    double close = 100.0 + (double)i;
+    bars->date[i] = BASE_DATE + (time_t)(i * DAY_SECONDS);
+    bars->open[i] = close - 0.5;
+    bars->high[i] = close + 0.5;
+    bars->low[i] = close - 1.0;
+    bars->close[i] = close;
+    bars->volume[i] = 10000;
+  }
+  cd->code = bars->code;
+  cd->exchange = bars->exchange;
+  cd->bars = bars;
+  cd->bar_count = BAR_COUNT;
+  SamtraderCodeData *code_data[1] = {cd};
+
+  SamtraderStrategy strategy = {.name = "Hold",
+                                .entry_long = samtrader_rule_parse(arena, "ABOVE(close, 50)"),
+                                .exit_long = samtrader_rule_parse(arena, "BELOW(close, 50)"),
+                                .position_size = 0.5,
+                                .max_positions = 1};
+  ASSERT(strategy.entry_long && strategy.exit_long, "Parse rules");
+  SamtraderTimeline *timeline = samtrader_timeline_build(arena, code_data, 1);
+  ASSERT(timeline != NULL, "Build timeline");
+
+  SamtraderBacktestConfig config = {.initial_capital = 100000.0,
+                                    .commission_per_trade = 5.0,
+                                    .commission_pct = 0.1,
+                                    .slippage_pct = 0.05};
+  SamtraderSweepRun run = {.strategies = &strategy,
+                           .strategy_count = 1,
+                           .code_data = code_data,
+                           .timeline = timeline,
+                           .config = &config,
+                           .risk_free_rate = 0.05};
+  SamtraderWalkForwardConfig wf = {.in_sample = 80, .out_of_sample = 50};
+  SamtraderWorkerPool *pool = samtrader_worker_pool_create(2);
+  ASSERT(pool != NULL, "Create pool");
+  SamtraderWalkForwardResult *result = samtrader_walkforward_run(arena, pool, &run, &wf);
+  ASSERT(result != NULL, "Walk-forward should succeed");
+  ASSERT(samrena_vector_size(result->trades) == result->window_count,
+         "One trade per window, closed at its boundary");
+
+  double equity = config.initial_capital;
+  for (size_t w = 0; w < result->window_count; w++) {
+    const SamtraderWalkForwardWindow *win = &result->windows[w];
+    const SamtraderClosedTrade *trade = samrena_vector_at_const(result->trades, w);
+    ASSERT(trade->entry_date == bars->date[win->out_of_sample_begin], "Entered on the first date");
+    ASSERT(trade->exit_date == bars->date[win->out_of_sample_end - 1], "Exited on the last date");
+
+    /* The exit pays slippage and commission like any other */
+    double exit_price = bars->close[win->out_of_sample_end - 1] * (1.0 - 0.05 / 100.0);
+    ASSERT(fabs(trade->exit_price - exit_price) < 1e-9, "Exit price includes slippage");
+    ASSERT(win->out_of_sample.total_trades == 1, "Window metrics count the closing trade");
+
+    /* The window ends flat: its last equity point is cash after the exit */
+    equity += trade->pnl;
+    size_t last = win->out_of_sample_end - 1 - wf.in_sample;
+    const SamtraderEquityPoint *point = samrena_vector_at_const(result->equity_curve, last);
+    ASSERT(fabs(point->equity - equity) < 1e-6, "Window equity matches its trades");
+  }
+
+  samtrader_worker_pool_destroy(pool);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+int main(void) {
+  printf("=== Walk-Forward Tests ===\n\n");
+
+  int failures = 0;
+
+  failures += test_window_count();
+  failures += test_walkforward_rolling();
+  failures += test_walkforward_anchored();
+  failures += test_walkforward_closes_at_boundary();
+
+  printf("\n=== Results: %d failures ===\n", failures);
+
+  return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,299 @@
+/*
+ * Copyright 2025 Samuel "Lord-Windy" Brown
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <samrena.h>
+
+#include "samtrader/adapters/writer.h"
+
+#define ASSERT(cond, msg)                                                                          \
+  do {                                                                                             \
+    if (!(cond)) {                                                                                 \
+      printf("FAIL: %s\n", msg);                                                                   \
+      return 1;                                                                                    \
+    }                                                                                              \
+  } while (0)
+
+/*============================================================================
+ * Test Helpers
+ *============================================================================*/
+
+static char *temp_path(const char *suffix) {
+  static char path[256];
+  snprintf(path, sizeof(path), "/tmp/test_writer_%s_%d.txt", suffix, getpid());
+  return path;
+}
+
+/** Read a whole file into a malloc'd NUL-terminated buffer. */
+static char *read_file(const char *path, size_t *size) {
+  FILE *f = fopen(path, "r");
+  if (f == NULL) {
+    return NULL;
+  }
+  fseek(f, 0, SEEK_END);
+  long length = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  char *buf = malloc((size_t)length + 1);
+  if (buf == NULL) {
+    fclose(f);
+    return NULL;
+  }
+  *size = fread(buf, 1, (size_t)length, f);
+  buf[*size] = '\0';
+  fclose(f);
+  return buf;
+}
+
+/** Open a writer with a small caller buffer so chunk boundaries are exercised. */
+static int open_small(SamtraderWriter *writer, const char *path, char *buffer, size_t capacity) {
+  int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    return -1;
+  }
+  samtrader_writer_init(writer, fd, buffer, capacity);
+  return 0;
+}
+
+/*============================================================================
+ * Tests
+ *============================================================================*/
+
+static int test_open_and_close(void) {
+  printf("Testing open, append and close...\n");
+  Samrena *arena = samrena_create_default();
+  const char *path = temp_path("open");
+
+  SamtraderWriter writer;
+  ASSERT(samtrader_writer_open(&writer, arena, path), "open should succeed");
+  samtrader_writer_puts(&writer, "hello ");
+  samtrader_writer_write(&writer, "world!", 5);
+  samtrader_writer_printf(&writer, " %d-%s\n", 42, "x");
+  ASSERT(samtrader_writer_close(&writer), "close should succeed");
+
+  size_t size = 0;
+  char *content = read_file(path, &size);
+  ASSERT(content != NULL, "output should be readable");
+  ASSERT(strcmp(content, "hello world 42-x\n") == 0, "output should match appends");
+
+  SamtraderWriter bad;
+  ASSERT(!samtrader_writer_open(&bad, arena, "/nonexistent/dir/file.txt"),
+         "open should fail for an unwritable path");
+  ASSERT(!samtrader_writer_open(&bad, NULL, path), "open should fail without an arena");
+
+  free(content);
+  unlink(path);
+  samrena_destroy(arena);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_chunked_output(void) {
+  printf("Testing output larger than the buffer...\n");
+  const char *path = temp_path("chunks");
+  char buffer[16];
+  SamtraderWriter writer;
+  ASSERT(open_small(&writer, path, buffer, sizeof(buffer)) == 0, "open should succeed");
+
+  /* Small appends, a printf longer than the buffer and a raw write longer than it */
+  char expected[512];
+  size_t len = 0;
+  for (int i = 0; i < 20; i++) {
+    samtrader_writer_int(&writer, i);
+    samtrader_writer_puts(&writer, ",");
+    len += (size_t)snprintf(expected + len, sizeof(expected) - len, "%d,", i);
+  }
+  samtrader_writer_printf(&writer, "[%s|%040d]", "long", 7);
+  len += (size_t)snprintf(expected + len, sizeof(expected) - len, "[%s|%040d]", "long", 7);
+  const char *block = "abcdefghijklmnopqrstuvwxyz0123456789";
+  samtrader_writer_puts(&writer, block);
+  len += (size_t)snprintf(expected + len, sizeof(expected) - len, "%s", block);
+  ASSERT(samtrader_writer_close(&writer), "close should succeed");
+
+  size_t size = 0;
+  char *content = read_file(path, &size);
+  ASSERT(content != NULL, "output should be readable");
+  ASSERT(size == len && memcmp(content, expected, len) == 0, "output should be in order");
+
+  free(content);
+  unlink(path);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_int_format(void) {
+  printf("Testing integer formatting...\n");
+  const char *path = temp_path("int");
+  char buffer[64];
+  SamtraderWriter writer;
+  ASSERT(open_small(&writer, path, buffer, sizeof(buffer)) == 0, "open should succeed");
+
+  const long long values[] = {0, 7, -7, 1234567890123LL, LLONG_MAX, LLONG_MIN};
+  char expected[256];
+  size_t len = 0;
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    samtrader_writer_int(&writer, values[i]);
+    samtrader_writer_puts(&writer, " ");
+    len += (size_t)snprintf(expected + len, sizeof(expected) - len, "%lld ", values[i]);
+  }
+  ASSERT(samtrader_writer_close(&writer), "close should succeed");
+
+  size_t size = 0;
+  char *content = read_file(path, &size);
+  ASSERT(content != NULL && strcmp(content, expected) == 0, "integers should match printf");
+
+  free(content);
+  unlink(path);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_fixed_matches_printf(void) {
+  printf("Testing fixed-precision formatting against printf...\n");
+  const char *path = temp_path("fixed");
+  char buffer[4096];
+  SamtraderWriter writer;
+  ASSERT(open_small(&writer, path, buffer, sizeof(buffer)) == 0, "open should succeed");
+
+  /* Values away from exact halfway cases, where both round the same way */
+  const double values[] = {0.0,     1.0,      -1.0,     0.004,    123.456,     -98765.4321,
+                           1e-7,    99.999,   -0.5001,  1e12 / 3, 12345678.91, 3.14159265,
+                           1e20,    -2.5e17,  7.0 / 3.0};
+  char expected[4096];
+  size_t len = 0;
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    for (int d = 0; d <= 4; d++) {
+      samtrader_writer_fixed(&writer, values[i], d);
+      samtrader_writer_puts(&writer, " ");
+      len += (size_t)snprintf(expected + len, sizeof(expected) - len, "%.*f ", d, values[i]);
+    }
+  }
+  ASSERT(samtrader_writer_close(&writer), "close should succeed");
+
+  size_t size = 0;
+  char *content = read_file(path, &size);
+  ASSERT(content != NULL && strcmp(content, expected) == 0, "decimals should match printf");
+
+  free(content);
+  unlink(path);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_fixed_edge_cases(void) {
+  printf("Testing fixed-precision edge cases...\n");
+  const char *path = temp_path("fixed_edge");
+  char buffer[256];
+  SamtraderWriter writer;
+  ASSERT(open_small(&writer, path, buffer, sizeof(buffer)) == 0, "open should succeed");
+
+  samtrader_writer_fixed(&writer, -0.001, 2); /* Rounds to zero: no sign */
+  samtrader_writer_puts(&writer, "|");
+  samtrader_writer_fixed(&writer, 2.5, 0); /* Exact halves round to even */
+  samtrader_writer_puts(&writer, "|");
+  samtrader_writer_fixed(&writer, 9.995, 1);
+  samtrader_writer_puts(&writer, "|");
+  samtrader_writer_fixed(&writer, 1.0 / 0.0, 2);
+  ASSERT(samtrader_writer_close(&writer), "close should succeed");
+
+  size_t size = 0;
+  char *content = read_file(path, &size);
+  ASSERT(content != NULL, "output should be readable");
+  ASSERT(strcmp(content, "0.00|2|10.0|inf") == 0, "edge cases should format as documented");
+
+  free(content);
+  unlink(path);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_fixed_ties_match_printf(void) {
+  printf("Testing fixed-precision halfway cases against printf...\n");
+  const char *path = temp_path("fixed_ties");
+  char buffer[4096];
+  SamtraderWriter writer;
+  ASSERT(open_small(&writer, path, buffer, sizeof(buffer)) == 0, "open should succeed");
+
+  /*
+   * Exact binary halves (0.125, 2.5, ...) round to even. The others only
+   * look halfway in decimal, or land on a half once scaled, and round by
+   * which side of it their exact value lies.
+   */
+  const double values[] = {0.125, 0.375, 0.625, 2.5,   3.5,   -2.5,  -1.125,
+                           0.5,   1.5,   1.25,  1.0625, 0.135, 0.145,  1.005,
+                           2.675, 1.115, 1e6 + 0.5, 4503599627370495.5};
+  char expected[4096];
+  size_t len = 0;
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    for (int d = 0; d <= 4; d++) {
+      samtrader_writer_fixed(&writer, values[i], d);
+      samtrader_writer_puts(&writer, " ");
+      len += (size_t)snprintf(expected + len, sizeof(expected) - len, "%.*f ", d, values[i]);
+    }
+  }
+  ASSERT(samtrader_writer_close(&writer), "close should succeed");
+
+  size_t size = 0;
+  char *content = read_file(path, &size);
+  ASSERT(content != NULL && strcmp(content, expected) == 0, "halfway cases should match printf");
+  ASSERT(strstr(content, "0.12 ") != NULL, "0.125 at two decimals should give 0.12");
+
+  free(content);
+  unlink(path);
+  printf("  PASS\n");
+  return 0;
+}
+
+static int test_sticky_failure(void) {
+  printf("Testing failed writes are reported on close...\n");
+  int fds[2];
+  ASSERT(pipe(fds) == 0, "pipe should open");
+  close(fds[1]);
+
+  /* Write to a read-only descriptor */
+  char buffer[8];
+  SamtraderWriter writer;
+  samtrader_writer_init(&writer, fds[0], buffer, sizeof(buffer));
+  samtrader_writer_puts(&writer, "more than eight bytes");
+  samtrader_writer_puts(&writer, "x");
+  ASSERT(!samtrader_writer_flush(&writer), "flush should report the failure");
+  ASSERT(!samtrader_writer_close(&writer), "close should report the failure");
+  ASSERT(writer.fd == -1, "close should release the descriptor");
+  printf("  PASS\n");
+  return 0;
+}
+
+int main(void) {
+  int failures = 0;
+
+  printf("=== Buffered Writer Tests ===\n\n");
+
+  failures += test_open_and_close();
+  failures += test_chunked_output();
+  failures += test_int_format();
+  failures += test_fixed_matches_printf();
+  failures += test_fixed_edge_cases();
+  failures += test_fixed_ties_match_printf();
+  failures += test_sticky_failure();
+
+  printf("\n=== Results: %d failures ===\n", failures);
+  return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -34,6 +34,9 @@ void samrng_destroy(SamRng *rng);
 
 void samrng_seed(SamRng *rng, uint64_t seed);
 
+// Advance the stream by 2^128 draws; successive jumps give non-overlapping substreams.
+void samrng_jump(SamRng *rng);
+
 uint32_t samrng_uint32(SamRng *rng);
 
 uint64_t samrng_uint64(SamRng *rng);
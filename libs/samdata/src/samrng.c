@@ -81,6 +81,36 @@ void samrng_seed(SamRng *rng, uint64_t seed) {
   rng->has_spare_normal = false;
 }
 
+void samrng_jump(SamRng *rng) {
+  if (!rng)
+    return;
+
+  static const uint64_t jump[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                  0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+
+  uint64_t s0 = 0;
+  uint64_t s1 = 0;
+  uint64_t s2 = 0;
+  uint64_t s3 = 0;
+  for (size_t i = 0; i < sizeof(jump) / sizeof(jump[0]); i++) {
+    for (int b = 0; b < 64; b++) {
+      if (jump[i] & ((uint64_t)1 << b)) {
+        s0 ^= rng->state[0];
+        s1 ^= rng->state[1];
+        s2 ^= rng->state[2];
+        s3 ^= rng->state[3];
+      }
+      xoshiro256ss_next(rng);
+    }
+  }
+
+  rng->state[0] = s0;
+  rng->state[1] = s1;
+  rng->state[2] = s2;
+  rng->state[3] = s3;
+  rng->has_spare_normal = false;
+}
+
 uint32_t samrng_uint32(SamRng *rng) {
   if (!rng)
     return 0;
@@ -166,6 +166,27 @@ static void test_samrng_normal_distribution(void) {
   printf("PASS: Normal distribution test\n");
 }
 
+static void test_samrng_jump(void) {
+  Samrena *arena = samrena_create_default();
+  SamRng *base = samrng_create(arena, 7);
+  SamRng *a = samrng_create(arena, 7);
+  SamRng *b = samrng_create(arena, 7);
+
+  samrng_jump(a);
+  samrng_jump(b);
+  int differs = 0;
+  for (int i = 0; i < 10; i++) {
+    uint64_t va = samrng_uint64(a);
+    assert(va == samrng_uint64(b));
+    if (va != samrng_uint64(base))
+      differs = 1;
+  }
+  assert(differs);
+
+  samrena_destroy(arena);
+  printf("PASS: Jump test\n");
+}
+
 int main(void) {
   printf("Running SamRng tests...\n");
 
@@ -176,6 +197,7 @@ int main(void) {
   test_samrng_neural_network_functions();
   test_samrng_fill_functions();
   test_samrng_normal_distribution();
+  test_samrng_jump();
 
   printf("All SamRng tests passed!\n");
   return 0;
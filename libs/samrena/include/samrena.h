@@ -129,6 +129,15 @@ typedef struct {
   bool is_contiguous;
 } SamrenaInfo;
 
+// Position in an arena returned by samrena_mark()
+typedef uint64_t SamrenaMark;
+
+// Temporary allocation scope opened by samrena_scratch_begin()
+typedef struct {
+  Samrena *arena;
+  SamrenaMark mark;
+} SamrenaScratch;
+
 // =============================================================================
 // CONFIGURATION HELPERS
 // =============================================================================
@@ -189,6 +198,20 @@ SamrenaError samrena_reserve_with_growth(Samrena *arena, uint64_t immediate_size
 bool samrena_can_allocate(Samrena *arena, uint64_t size);
 bool samrena_reset_if_supported(Samrena *arena);
 
+// =============================================================================
+// SCRATCH API - Mark / Rewind for Transient Allocations
+// =============================================================================
+
+// Rewinding releases everything pushed since the mark, including growth of
+// vectors created before it, so keep long-lived data out of the scope (or use
+// a dedicated arena for scratch work). Committed pages are kept for reuse.
+SamrenaMark samrena_mark(Samrena *arena);
+SamrenaError samrena_rewind(Samrena *arena, SamrenaMark mark);
+
+// Scoped form of mark/rewind: every scratch_begin needs a matching scratch_end
+SamrenaScratch samrena_scratch_begin(Samrena *arena);
+void samrena_scratch_end(SamrenaScratch scratch);
+
 // =============================================================================
 // ERROR HANDLING API
 // =============================================================================
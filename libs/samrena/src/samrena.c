@@ -33,7 +33,8 @@
 #include <unistd.h>
 #endif
 
-static SamrenaError last_error = SAMRENA_SUCCESS;
+// Per-thread so that threads working in their own arenas do not race on it
+static _Thread_local SamrenaError last_error = SAMRENA_SUCCESS;
 
 // =============================================================================
 // Error Handling
@@ -532,3 +533,47 @@ bool samrena_reset_if_supported(Samrena *arena) {
   ctx->allocated_size = 0;
   return true;
 }
+
+// =============================================================================
+// Scratch API
+// =============================================================================
+
+SamrenaMark samrena_mark(Samrena *arena) {
+  if (!arena) {
+    samrena_set_error(SAMRENA_ERROR_NULL_POINTER);
+    return 0;
+  }
+
+  return arena->vctx.allocated_size;
+}
+
+SamrenaError samrena_rewind(Samrena *arena, SamrenaMark mark) {
+  if (!arena) {
+    samrena_set_error(SAMRENA_ERROR_NULL_POINTER);
+    return SAMRENA_ERROR_NULL_POINTER;
+  }
+
+  VirtualContext *ctx = &arena->vctx;
+
+  // A mark past the current top was taken before an earlier rewind or reset
+  if (mark > ctx->allocated_size) {
+    samrena_set_error(SAMRENA_ERROR_INVALID_PARAMETER);
+    return SAMRENA_ERROR_INVALID_PARAMETER;
+  }
+
+  // Pages stay committed: the next scope reuses them without faulting
+  ctx->allocated_size = mark;
+  samrena_set_error(SAMRENA_SUCCESS);
+  return SAMRENA_SUCCESS;
+}
+
+SamrenaScratch samrena_scratch_begin(Samrena *arena) {
+  SamrenaScratch scratch = {.arena = arena, .mark = samrena_mark(arena)};
+  return scratch;
+}
+
+void samrena_scratch_end(SamrenaScratch scratch) {
+  if (scratch.arena) {
+    samrena_rewind(scratch.arena, scratch.mark);
+  }
+}
@@ -382,6 +382,60 @@ void test_resize_array_alignment() {
 }
 */
 
+void test_mark_rewind() {
+  Samrena *samrena = samrena_create_default();
+  assert(samrena != NULL);
+
+  int32_t *kept = samrena_push(samrena, 16 * sizeof(int32_t));
+  assert(kept != NULL);
+  kept[0] = 42;
+  uint64_t before = samrena_allocated(samrena);
+
+  SamrenaMark mark = samrena_mark(samrena);
+  assert(mark == before);
+  void *first = samrena_push(samrena, 4096);
+  assert(first != NULL);
+  assert(samrena_allocated(samrena) > before);
+
+  assert(samrena_rewind(samrena, mark) == SAMRENA_SUCCESS);
+  assert(samrena_allocated(samrena) == before);
+  assert(kept[0] == 42);
+
+  // The released space is handed out again
+  void *second = samrena_push(samrena, 4096);
+  assert(second == first);
+
+  // A mark above the current top is rejected and leaves the arena alone
+  uint64_t top = samrena_allocated(samrena);
+  assert(samrena_rewind(samrena, top + 1) == SAMRENA_ERROR_INVALID_PARAMETER);
+  assert(samrena_allocated(samrena) == top);
+  assert(samrena_rewind(NULL, 0) == SAMRENA_ERROR_NULL_POINTER);
+
+  samrena_destroy(samrena);
+}
+
+void test_scratch_scope() {
+  Samrena *samrena = samrena_create_default();
+  assert(samrena != NULL);
+
+  uint64_t base = samrena_allocated(samrena);
+  for (int step = 0; step < 1000; step++) {
+    SamrenaScratch outer = samrena_scratch_begin(samrena);
+    double *prices = SAMRENA_PUSH_ARRAY(samrena, double, 256);
+    assert(prices != NULL);
+
+    SamrenaScratch inner = samrena_scratch_begin(samrena);
+    assert(samrena_push(samrena, 1024) != NULL);
+    samrena_scratch_end(inner);
+    assert(samrena_allocated(samrena) == outer.mark + 256 * sizeof(double));
+
+    samrena_scratch_end(outer);
+    assert(samrena_allocated(samrena) == base);
+  }
+
+  samrena_destroy(samrena);
+}
+
 int main(int argc, char **argv) {
 
   printf("START SAMRENA TESTING\n");
@@ -402,6 +456,8 @@ int main(int argc, char **argv) {
   test_data_alignment();
   test_large_allocation();
   test_minimal_allocation();
+  test_mark_rewind();
+  test_scratch_scope();
 
   // Resize array tests disabled - samrena_resize_array function was removed
   // test_resize_array_basic();